@@ -93,5 +93,27 @@ cpp2::ErrorCode GraphClient::execute(folly::StringPiece stmt,
     return resp.get_error_code();
 }
 
+
+cpp2::ErrorCode GraphClient::bulkInsert(const cpp2::BulkInsertRequest& req,
+                                        cpp2::ExecutionResponse& resp) {
+    if (!client_) {
+        LOG(ERROR) << "Disconnected from the server";
+        return cpp2::ErrorCode::E_DISCONNECTED;
+    }
+
+    try {
+        client_->sync_bulkInsert(resp, sessionId_, req);
+    } catch (const std::exception& ex) {
+        LOG(ERROR) << "Thrift rpc call failed: " << ex.what();
+        return cpp2::ErrorCode::E_RPC_FAILURE;
+    }
+
+    auto* msg = resp.get_error_msg();
+    if (msg != nullptr) {
+        LOG(WARNING) << *msg;
+    }
+    return resp.get_error_code();
+}
+
 }  // namespace graph
 }  // namespace nebula
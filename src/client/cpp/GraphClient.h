@@ -26,6 +26,9 @@ public:
     cpp2::ErrorCode execute(folly::StringPiece stmt,
                             cpp2::ExecutionResponse& resp);
 
+    cpp2::ErrorCode bulkInsert(const cpp2::BulkInsertRequest& req,
+                               cpp2::ExecutionResponse& resp);
+
 private:
     std::unique_ptr<cpp2::GraphServiceAsyncClient> client_;
     const std::string addr_;
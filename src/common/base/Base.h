@@ -162,6 +162,7 @@ constexpr char _SRC[]   = "_src";
 constexpr char _TYPE[]  = "_type";
 constexpr char _RANK[]  = "_rank";
 constexpr char _DST[]   = "_dst";
+constexpr char _DEGREE[] = "_degree";
 
 #define ID_HASH(id, numShards) \
     ((static_cast<uint64_t>(id)) % numShards + 1)
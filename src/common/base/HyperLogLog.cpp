@@ -0,0 +1,63 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/HyperLogLog.h"
+#include "base/MurmurHash2.h"
+
+namespace nebula {
+
+HyperLogLog::HyperLogLog() : registers_(1UL << kBits, '\0') {}
+
+void HyperLogLog::add(folly::StringPiece value) {
+    uint64_t hash = MurmurHash2()(value.data(), value.size());
+    // The high bits choose the register, the others count the leading zeros
+    auto index = hash >> (64 - kBits);
+    auto rest = hash << kBits;
+    uint8_t rank = rest == 0 ? 64 - kBits + 1 : __builtin_clzll(rest) + 1;
+    if (rank > static_cast<uint8_t>(registers_[index])) {
+        registers_[index] = static_cast<char>(rank);
+    }
+}
+
+void HyperLogLog::merge(const HyperLogLog &other) {
+    for (auto i = 0UL; i < registers_.size(); i++) {
+        if (static_cast<uint8_t>(other.registers_[i]) > static_cast<uint8_t>(registers_[i])) {
+            registers_[i] = other.registers_[i];
+        }
+    }
+}
+
+int64_t HyperLogLog::estimate() const {
+    double m = registers_.size();
+    double sum = 0;
+    auto zeros = 0UL;
+    for (auto c : registers_) {
+        auto rank = static_cast<uint8_t>(c);
+        sum += std::ldexp(1.0, -rank);
+        if (rank == 0) {
+            zeros++;
+        }
+    }
+    double alpha = 0.7213 / (1 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+    // Linear counting is more accurate for the small cardinalities
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * std::log(m / zeros);
+    }
+    return std::llround(estimate);
+}
+
+// static
+StatusOr<HyperLogLog> HyperLogLog::deserialize(folly::StringPiece data) {
+    HyperLogLog hll;
+    if (data.size() != hll.registers_.size()) {
+        return Status::Error("Bad size of the HyperLogLog registers: %lu", data.size());
+    }
+    hll.registers_ = data.str();
+    return hll;
+}
+
+}   // namespace nebula
@@ -0,0 +1,44 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_BASE_HYPERLOGLOG_H_
+#define COMMON_BASE_HYPERLOGLOG_H_
+
+#include "base/Base.h"
+#include "base/StatusOr.h"
+
+namespace nebula {
+
+/**
+ * Estimate the distinct values with HyperLogLog, in 1K bytes with about 3% error.
+ * The sketches built separately could be merged, e.g. those of different partitions.
+ * */
+class HyperLogLog final {
+public:
+    HyperLogLog();
+
+    void add(folly::StringPiece value);
+
+    void merge(const HyperLogLog &other);
+
+    int64_t estimate() const;
+
+    const std::string& serialize() const {
+        return registers_;
+    }
+
+    static StatusOr<HyperLogLog> deserialize(folly::StringPiece data);
+
+private:
+    static constexpr uint32_t kBits = 10;
+
+    // The max position of the first 1 bit of the hash seen, for each register
+    std::string registers_;
+};
+
+}   // namespace nebula
+
+#endif  // COMMON_BASE_HYPERLOGLOG_H_
@@ -0,0 +1,53 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "base/HyperLogLog.h"
+
+namespace nebula {
+
+static void expectNear(int64_t expected, int64_t actual) {
+    EXPECT_NEAR(expected, actual, expected * 0.1) << "Expected " << expected;
+}
+
+TEST(HyperLogLog, Estimate) {
+    HyperLogLog hll;
+    EXPECT_EQ(0, hll.estimate());
+    for (auto i = 0; i < 100; i++) {
+        hll.add(folly::to<std::string>(i));
+    }
+    expectNear(100, hll.estimate());
+    // The duplicates are not counted
+    for (auto i = 0; i < 100000; i++) {
+        hll.add(folly::to<std::string>(i % 50000));
+    }
+    expectNear(50000, hll.estimate());
+}
+
+TEST(HyperLogLog, Merge) {
+    HyperLogLog hll1;
+    HyperLogLog hll2;
+    for (auto i = 0; i < 20000; i++) {
+        hll1.add(folly::stringPrintf("vertex_%d", i));
+        hll2.add(folly::stringPrintf("vertex_%d", i + 10000));
+    }
+    hll1.merge(hll2);
+    expectNear(30000, hll1.estimate());
+}
+
+TEST(HyperLogLog, Serialize) {
+    HyperLogLog hll;
+    for (auto i = 0; i < 1000; i++) {
+        hll.add(folly::to<std::string>(i));
+    }
+    auto result = HyperLogLog::deserialize(hll.serialize());
+    ASSERT_TRUE(result.ok());
+    EXPECT_EQ(hll.estimate(), result.value().estimate());
+    EXPECT_FALSE(HyperLogLog::deserialize("bad").ok());
+}
+
+}  // namespace nebula
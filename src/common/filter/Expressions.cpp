@@ -610,6 +610,10 @@ std::string UUIDExpression::toString() const {
 
 OptVariantType UUIDExpression::eval(Getters &getters) const {
     UNUSED(getters);
+     VertexID id;
+     if (context_->getUUID(*field_, id)) {
+        return id;
+     }
      auto client = context_->storageClient();
      auto space = context_->space();
      auto uuidResult = client->getUUID(space, *field_).get();
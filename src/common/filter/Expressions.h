@@ -169,6 +169,20 @@ public:
         return space_;
     }
 
+    // The ids of uuid() resolved in batch ahead
+    void addUUIDs(const std::unordered_map<std::string, VertexID> &uuids) {
+        uuids_.insert(uuids.begin(), uuids.end());
+    }
+
+    bool getUUID(const std::string &name, VertexID &id) const {
+        auto it = uuids_.find(name);
+        if (it == uuids_.end()) {
+            return false;
+        }
+        id = it->second;
+        return true;
+    }
+
     void print() const;
 
     bool isOverAllEdge() const { return overAll_; }
@@ -189,6 +203,7 @@ private:
     bool                                      overAll_{false};
     GraphSpaceID                              space_;
     nebula::storage::StorageClient            *storageClient_{nullptr};
+    std::unordered_map<std::string, VertexID> uuids_;
 };
 
 
@@ -782,6 +797,10 @@ public:
         field_.reset(field);
     }
 
+    const std::string* field() const {
+        return field_.get();
+    }
+
     std::string toString() const override;
 
     OptVariantType eval(Getters &getters) const override;
@@ -97,5 +97,77 @@ bool HdfsCommandHelper::checkHadoopPath() {
     return std::getenv("HADOOP_HOME") != nullptr;
 }
 
+StatusOr<std::vector<HdfsFile>> HdfsCommandHelper::listFiles(const std::string& hdfsHost,
+                                                             int32_t hdfsPort,
+                                                             const std::string& hdfsPath) {
+    auto result = ls(hdfsHost, hdfsPort, hdfsPath);
+    if (!result.ok()) {
+        return result.status();
+    }
+
+    // The lines of files are like:
+    // -rw-r--r--   3 user group       1024 2020-01-01 00:00 hdfs://host:port/path/1.sst
+    std::vector<HdfsFile> files;
+    std::vector<folly::StringPiece> lines;
+    folly::split("\n", result.value(), lines, true);
+    for (auto& line : lines) {
+        if (!line.startsWith("-")) {
+            // Directories and the summary line
+            continue;
+        }
+        std::vector<folly::StringPiece> fields;
+        folly::split(" ", line, fields, true);
+        if (fields.size() < 8) {
+            return Status::Error("Unexpected output of hadoop fs -ls: %s",
+                                 line.str().c_str());
+        }
+        HdfsFile file;
+        try {
+            file.size = folly::to<int64_t>(fields[4]);
+        } catch (const std::exception& e) {
+            return Status::Error("Unexpected output of hadoop fs -ls: %s",
+                                 line.str().c_str());
+        }
+        auto path = fields[7];
+        auto pos = path.rfind('/');
+        file.name = (pos == folly::StringPiece::npos ? path : path.subpiece(pos + 1)).str();
+        files.emplace_back(std::move(file));
+    }
+    return files;
+}
+
+StatusOr<uint32_t> HdfsCommandHelper::checksum(const std::string& hdfsHost,
+                                               int32_t hdfsPort,
+                                               const std::string& hdfsPath) {
+    auto command = folly::stringPrintf(
+        "hadoop fs -Ddfs.checksum.combine.mode=COMPOSITE_CRC -checksum hdfs://%s:%d%s",
+        hdfsHost.c_str(), hdfsPort, hdfsPath.c_str());
+    LOG(INFO) << "Start Running HDFS Command: [" << command << "]";
+    auto resultStatus = ProcessUtils::runCommand(command.c_str());
+    if (!resultStatus.ok()) {
+        LOG(INFO) << "HDFS Command Failed. " << resultStatus.status().toString();
+        return resultStatus.status();
+    }
+
+    auto result = std::move(resultStatus).value();
+    if (folly::StringPiece(result).startsWith("ERR")) {
+        LOG(INFO) << "HDFS Command Failed. " << result;
+        return Status::Error(result);
+    }
+
+    // The output is like `<path>\tCOMPOSITE-CRC32C\t<hex>', the hadoop releases
+    // without composite CRC print the MD5 of CRCs instead, which can't be verified
+    std::vector<folly::StringPiece> fields;
+    folly::split("\t", folly::trimWhitespace(result), fields, true);
+    if (fields.size() != 3 || fields[1] != "COMPOSITE-CRC32C") {
+        return Status::NotSupported("No composite CRC32C: %s", result.c_str());
+    }
+    try {
+        return static_cast<uint32_t>(std::stoul(fields[2].str(), nullptr, 16));
+    } catch (const std::exception& e) {
+        return Status::Error("Unexpected checksum: %s", result.c_str());
+    }
+}
+
 }   // namespace hdfs
 }   // namespace nebula
@@ -28,6 +28,16 @@ public:
                          const std::string& hdfsPath) override;
 
     bool checkHadoopPath() override;
+
+    // Parse the output of `hadoop fs -ls'
+    StatusOr<std::vector<HdfsFile>> listFiles(const std::string& hdfsHost,
+                                              int32_t hdfsPort,
+                                              const std::string& hdfsPath) override;
+
+    // The composite CRC32C of HDFS, which is independent of the block size
+    StatusOr<uint32_t> checksum(const std::string& hdfsHost,
+                                int32_t hdfsPort,
+                                const std::string& hdfsPath) override;
 };
 
 }   // namespace hdfs
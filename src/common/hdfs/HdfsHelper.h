@@ -13,6 +13,12 @@
 namespace nebula {
 namespace hdfs {
 
+struct HdfsFile {
+    // The name of the file in its directory
+    std::string name;
+    int64_t     size;
+};
+
 class HdfsHelper {
 public:
     virtual ~HdfsHelper() = default;
@@ -36,6 +42,58 @@ public:
     }
 
     virtual bool checkHadoopPath() = 0;
+
+    /**
+     * List the regular files right under the directory.
+     * Returns NotSupported if the helper could not list files, then the directory
+     * should be copied as a whole with copyToLocal().
+     * */
+    virtual StatusOr<std::vector<HdfsFile>> listFiles(const std::string& hdfsHost,
+                                                      int32_t hdfsPort,
+                                                      const std::string& hdfsPath) {
+        UNUSED(hdfsHost);
+        UNUSED(hdfsPort);
+        UNUSED(hdfsPath);
+        return Status::NotSupported("List files not supported");
+    }
+
+    // Whether copyRangeToLocal() is supported
+    virtual bool supportRangeCopy() const {
+        return false;
+    }
+
+    /**
+     * Copy the bytes [offset, offset + length) of the file to the same position
+     * of the local file, which should exist already.
+     * */
+    virtual Status copyRangeToLocal(const std::string& hdfsHost,
+                                    int32_t hdfsPort,
+                                    const std::string& hdfsPath,
+                                    int64_t offset,
+                                    int64_t length,
+                                    const std::string& localPath) {
+        UNUSED(hdfsHost);
+        UNUSED(hdfsPort);
+        UNUSED(hdfsPath);
+        UNUSED(offset);
+        UNUSED(length);
+        UNUSED(localPath);
+        return Status::NotSupported("Range copy not supported");
+    }
+
+    /**
+     * The CRC32C of the whole file.
+     * Returns NotSupported if the checksum is not available, then the file is
+     * verified by its size only.
+     * */
+    virtual StatusOr<uint32_t> checksum(const std::string& hdfsHost,
+                                        int32_t hdfsPort,
+                                        const std::string& hdfsPath) {
+        UNUSED(hdfsHost);
+        UNUSED(hdfsPort);
+        UNUSED(hdfsPath);
+        return Status::NotSupported("Checksum not supported");
+    }
 };
 
 }   // namespace hdfs
@@ -0,0 +1,201 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "hdfs/LocalFsHelper.h"
+#include "fs/FileUtils.h"
+#include <folly/FileUtil.h>
+#include <folly/hash/Checksum.h>
+
+namespace nebula {
+namespace hdfs {
+
+using fs::FileUtils;
+using fs::FileType;
+
+static constexpr size_t kBufferSize = 1024 * 1024;
+
+StatusOr<std::string> LocalFsHelper::ls(const std::string& hdfsHost,
+                                        int32_t hdfsPort,
+                                        const std::string& hdfsPath) {
+    UNUSED(hdfsHost);
+    UNUSED(hdfsPort);
+    if (FileUtils::fileType(hdfsPath.c_str()) != FileType::DIRECTORY) {
+        return Status::Error("No such directory: %s", hdfsPath.c_str());
+    }
+    auto entries = FileUtils::listAllFilesInDir(hdfsPath.c_str());
+    auto dirs = FileUtils::listAllDirsInDir(hdfsPath.c_str());
+    entries.insert(entries.end(), dirs.begin(), dirs.end());
+    return folly::join("\n", entries);
+}
+
+StatusOr<std::string> LocalFsHelper::copyToLocal(const std::string& hdfsHost,
+                                                 int32_t hdfsPort,
+                                                 const std::string& hdfsPath,
+                                                 const std::string& localPath) {
+    UNUSED(hdfsHost);
+    UNUSED(hdfsPort);
+    auto target = localPath;
+    if (FileUtils::fileType(localPath.c_str()) == FileType::DIRECTORY) {
+        target = FileUtils::joinPath(localPath, FileUtils::basename(hdfsPath.c_str()));
+    }
+    if (FileUtils::exist(target)) {
+        return Status::Error("copyToLocal: `%s': File exists", target.c_str());
+    }
+
+    auto type = FileUtils::fileType(hdfsPath.c_str());
+    Status status;
+    if (type == FileType::DIRECTORY) {
+        status = copyDir(hdfsPath, target);
+    } else if (type == FileType::REGULAR) {
+        status = copyFile(hdfsPath, target);
+    } else {
+        status = Status::Error("copyToLocal: `%s': No such file or directory",
+                               hdfsPath.c_str());
+    }
+    if (!status.ok()) {
+        return status;
+    }
+    return "";
+}
+
+StatusOr<bool> LocalFsHelper::exist(const std::string& hdfsHost,
+                                    int32_t hdfsPort,
+                                    const std::string& hdfsPath) {
+    UNUSED(hdfsHost);
+    UNUSED(hdfsPort);
+    return FileUtils::exist(hdfsPath);
+}
+
+StatusOr<std::vector<HdfsFile>> LocalFsHelper::listFiles(const std::string& hdfsHost,
+                                                         int32_t hdfsPort,
+                                                         const std::string& hdfsPath) {
+    UNUSED(hdfsHost);
+    UNUSED(hdfsPort);
+    if (FileUtils::fileType(hdfsPath.c_str()) != FileType::DIRECTORY) {
+        return Status::Error("No such directory: %s", hdfsPath.c_str());
+    }
+    std::vector<HdfsFile> files;
+    for (auto& name : FileUtils::listAllFilesInDir(hdfsPath.c_str())) {
+        auto path = FileUtils::joinPath(hdfsPath, name);
+        HdfsFile file;
+        file.name = std::move(name);
+        file.size = FileUtils::fileSize(path.c_str());
+        files.emplace_back(std::move(file));
+    }
+    return files;
+}
+
+Status LocalFsHelper::copyRangeToLocal(const std::string& hdfsHost,
+                                       int32_t hdfsPort,
+                                       const std::string& hdfsPath,
+                                       int64_t offset,
+                                       int64_t length,
+                                       const std::string& localPath) {
+    UNUSED(hdfsHost);
+    UNUSED(hdfsPort);
+    return copyRange(hdfsPath, offset, length, localPath);
+}
+
+StatusOr<uint32_t> LocalFsHelper::checksum(const std::string& hdfsHost,
+                                           int32_t hdfsPort,
+                                           const std::string& hdfsPath) {
+    UNUSED(hdfsHost);
+    UNUSED(hdfsPort);
+    return fileChecksum(hdfsPath);
+}
+
+StatusOr<uint32_t> LocalFsHelper::fileChecksum(const std::string& path) {
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Status::Error("Failed to open %s: %s", path.c_str(), ::strerror(errno));
+    }
+    SCOPE_EXIT {
+        ::close(fd);
+    };
+
+    auto buffer = std::make_unique<uint8_t[]>(kBufferSize);
+    // folly::crc32c() leaves out the final inversion, so that it could be chained
+    uint32_t crc = ~0U;
+    while (true) {
+        auto read = folly::readFull(fd, buffer.get(), kBufferSize);
+        if (read < 0) {
+            return Status::Error("Failed to read %s: %s", path.c_str(), ::strerror(errno));
+        }
+        if (read == 0) {
+            break;
+        }
+        crc = folly::crc32c(buffer.get(), read, crc);
+    }
+    return ~crc;
+}
+
+Status LocalFsHelper::copyFile(const std::string& src, const std::string& dst) {
+    auto size = FileUtils::fileSize(src.c_str());
+    auto fd = ::open(dst.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        return Status::Error("Failed to create %s: %s", dst.c_str(), ::strerror(errno));
+    }
+    ::close(fd);
+    return copyRange(src, 0, size, dst);
+}
+
+Status LocalFsHelper::copyRange(const std::string& src,
+                                int64_t offset,
+                                int64_t length,
+                                const std::string& dst) {
+    auto srcFd = ::open(src.c_str(), O_RDONLY);
+    if (srcFd < 0) {
+        return Status::Error("Failed to open %s: %s", src.c_str(), ::strerror(errno));
+    }
+    SCOPE_EXIT {
+        ::close(srcFd);
+    };
+    auto dstFd = ::open(dst.c_str(), O_WRONLY);
+    if (dstFd < 0) {
+        return Status::Error("Failed to open %s: %s", dst.c_str(), ::strerror(errno));
+    }
+    SCOPE_EXIT {
+        ::close(dstFd);
+    };
+
+    auto buffer = std::make_unique<char[]>(kBufferSize);
+    while (length > 0) {
+        auto size = std::min(static_cast<int64_t>(kBufferSize), length);
+        auto read = folly::preadFull(srcFd, buffer.get(), size, offset);
+        if (read != size) {
+            return Status::Error("Failed to read %s at %ld", src.c_str(), offset);
+        }
+        if (folly::pwriteFull(dstFd, buffer.get(), size, offset) != size) {
+            return Status::Error("Failed to write %s at %ld: %s",
+                                 dst.c_str(), offset, ::strerror(errno));
+        }
+        offset += size;
+        length -= size;
+    }
+    return Status::OK();
+}
+
+Status LocalFsHelper::copyDir(const std::string& src, const std::string& dst) {
+    if (!FileUtils::makeDir(dst)) {
+        return Status::Error("Failed to create %s", dst.c_str());
+    }
+    for (auto& name : FileUtils::listAllFilesInDir(src.c_str())) {
+        auto status = copyFile(FileUtils::joinPath(src, name), FileUtils::joinPath(dst, name));
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    for (auto& name : FileUtils::listAllDirsInDir(src.c_str())) {
+        auto status = copyDir(FileUtils::joinPath(src, name), FileUtils::joinPath(dst, name));
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
+}   // namespace hdfs
+}   // namespace nebula
@@ -0,0 +1,75 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef COMMON_LOCALFSHELPER_H
+#define COMMON_LOCALFSHELPER_H
+
+#include "hdfs/HdfsHelper.h"
+
+namespace nebula {
+namespace hdfs {
+
+/**
+ * Take the local file system as HDFS, the host and port are ignored.
+ * It supports all the operations natively, so it could stand in for HDFS in tests.
+ * */
+class LocalFsHelper : public HdfsHelper {
+public:
+    StatusOr<std::string> ls(const std::string& hdfsHost,
+                             int32_t hdfsPort,
+                             const std::string& hdfsPath) override;
+
+    // Copy a file or a directory like `hadoop fs -copyToLocal'
+    StatusOr<std::string> copyToLocal(const std::string& hdfsHost,
+                                      int32_t hdfsPort,
+                                      const std::string& hdfsPath,
+                                      const std::string& localPath) override;
+
+    StatusOr<bool> exist(const std::string& hdfsHost,
+                         int32_t hdfsPort,
+                         const std::string& hdfsPath) override;
+
+    bool checkHadoopPath() override {
+        return true;
+    }
+
+    StatusOr<std::vector<HdfsFile>> listFiles(const std::string& hdfsHost,
+                                              int32_t hdfsPort,
+                                              const std::string& hdfsPath) override;
+
+    bool supportRangeCopy() const override {
+        return true;
+    }
+
+    Status copyRangeToLocal(const std::string& hdfsHost,
+                            int32_t hdfsPort,
+                            const std::string& hdfsPath,
+                            int64_t offset,
+                            int64_t length,
+                            const std::string& localPath) override;
+
+    StatusOr<uint32_t> checksum(const std::string& hdfsHost,
+                                int32_t hdfsPort,
+                                const std::string& hdfsPath) override;
+
+    // The CRC32C of the local file
+    static StatusOr<uint32_t> fileChecksum(const std::string& path);
+
+private:
+    static Status copyRange(const std::string& src,
+                            int64_t offset,
+                            int64_t length,
+                            const std::string& dst);
+
+    static Status copyFile(const std::string& src, const std::string& dst);
+
+    static Status copyDir(const std::string& src, const std::string& dst);
+};
+
+}   // namespace hdfs
+}   // namespace nebula
+
+#endif  // COMMON_LOCALFSHELPER_H
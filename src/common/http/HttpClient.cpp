@@ -5,38 +5,490 @@
  */
 
 #include "http/HttpClient.h"
-#include "process/ProcessUtils.h"
+#include <folly/IPAddress.h>
+#include <folly/SocketAddress.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/io/async/HHWheelTimer.h>
+#include <folly/io/async/SSLContext.h>
+#include <openssl/x509v3.h>
+#include <proxygen/lib/http/HTTPConnector.h>
+#include <proxygen/lib/http/session/HTTPTransaction.h>
+#include <proxygen/lib/http/session/HTTPUpstreamSession.h>
+#include <proxygen/lib/utils/URL.h>
+
+DEFINE_int32(http_client_io_threads, 2, "Number of IO threads of the http client");
+DEFINE_int32(http_client_connect_timeout_ms, 3000, "Timeout of connecting in the http client");
+DEFINE_string(http_client_ca_file, "",
+              "The CA certificates to verify the https servers, the system ones if empty");
 
 namespace nebula {
 namespace http {
 
-StatusOr<std::string> HttpClient::get(const std::string& path, const std::string& options) {
-    auto command = folly::stringPrintf("/usr/bin/curl %s \"%s\"", options.c_str(), path.c_str());
-    LOG(INFO) << "HTTP Start Get Command: " << command;
-    auto result = nebula::ProcessUtils::runCommand(command.c_str());
-
-    if (result.ok()) {
-        LOG(INFO) << "HTTP Get Finished: " << command << " : " << result.value();
-        return result;
-    } else {
-        LOG(INFO) << "HTTP Get Failed: " << command << " : " << result.status().toString();
-        return Status::Error(folly::stringPrintf("Http Get Failed: %s", path.c_str()));
-    }
-}
-
-StatusOr<std::string> HttpClient::post(const std::string& path, const std::string& header) {
-    auto command = folly::stringPrintf("/usr/bin/curl -X POST %s \"%s\"",
-                                       header.c_str(),
-                                       path.c_str());
-    LOG(INFO) << "HTTP Start Post Command: " << command;
-    auto result = nebula::ProcessUtils::runCommand(command.c_str());
-    if (result.ok()) {
-        LOG(INFO) << "HTTP Post Finished: " << command << " : " << result.value();
-        return result;
-    } else {
-        LOG(INFO) << "HTTP Post Failed: " << command << " : " << result.status().toString();
-        return Status::Error(folly::stringPrintf("Http Post Failed: %s", path.c_str()));
+// The idle connections are closed after this, unless reused
+static constexpr std::chrono::milliseconds kIdleTimeout{30000};
+// For the requests without timeout, which may take hours, e.g. downloading
+static constexpr std::chrono::milliseconds kNoTimeout{7L * 24 * 3600 * 1000};
+static constexpr size_t kMaxIdlePerHost = 8;
+
+/**
+ * The connections opened in an IO thread, only accessed in the thread.
+ * A connection is removed once proxygen destroys it, e.g. closed by the peer.
+ * */
+class HttpClient::ConnectionPool final : public proxygen::HTTPSessionBase::InfoCallback {
+public:
+    explicit ConnectionPool(folly::EventBase* evb)
+        : evb_(evb)
+        , timer_(folly::HHWheelTimer::newTimer(
+              evb,
+              std::chrono::milliseconds(folly::HHWheelTimer::DEFAULT_TICK_INTERVAL),
+              folly::AsyncTimeout::InternalEnum::NORMAL,
+              kIdleTimeout)) {}
+
+    folly::EventBase* evb() const {
+        return evb_;
+    }
+
+    folly::HHWheelTimer* timer() const {
+        return timer_.get();
+    }
+
+    // The TLS context to connect the host, which verifies the certificate of the host
+    // the same way as curl. Throws if the CA certificates could not be loaded.
+    std::shared_ptr<folly::SSLContext> sslContext(const std::string& host) {
+        auto& ctx = sslContexts_[host];
+        if (ctx == nullptr) {
+            auto newCtx = std::make_shared<folly::SSLContext>();
+            newCtx->setVerificationOption(folly::SSLContext::SSLVerifyPeerEnum::VERIFY);
+            if (FLAGS_http_client_ca_file.empty()) {
+                SSL_CTX_set_default_verify_paths(newCtx->getSSLCtx());
+            } else {
+                newCtx->loadTrustedCertificates(FLAGS_http_client_ca_file.c_str());
+            }
+            auto* param = SSL_CTX_get0_param(newCtx->getSSLCtx());
+            if (folly::IPAddress::validate(host)) {
+                X509_VERIFY_PARAM_set1_ip_asc(param, host.c_str());
+            } else {
+                X509_VERIFY_PARAM_set1_host(param, host.c_str(), host.size());
+            }
+            ctx = std::move(newCtx);
+        }
+        return ctx;
+    }
+
+    // Take an idle connection to the host, nullptr if none
+    proxygen::HTTPUpstreamSession* take(const std::string& host) {
+        auto it = idle_.find(host);
+        if (it == idle_.end()) {
+            return nullptr;
+        }
+        while (!it->second.empty()) {
+            auto* session = it->second.back();
+            it->second.pop_back();
+            if (session->isReusable()) {
+                return session;
+            }
+            session->closeWhenIdle();
+        }
+        return nullptr;
+    }
+
+    void track(proxygen::HTTPUpstreamSession* session) {
+        session->setInfoCallback(this);
+        live_.emplace(session, session);
+    }
+
+    // Give back the connection after a request on it has finished
+    void release(const std::string& host, proxygen::HTTPUpstreamSession* session) {
+        if (live_.count(session) == 0) {
+            // Destroyed already
+            return;
+        }
+        auto& sessions = idle_[host];
+        if (session->isReusable() && sessions.size() < kMaxIdlePerHost) {
+            sessions.emplace_back(session);
+        } else {
+            session->closeWhenIdle();
+        }
+    }
+
+    void closeAll() {
+        std::vector<proxygen::HTTPUpstreamSession*> sessions;
+        for (auto& pair : live_) {
+            pair.second->setInfoCallback(nullptr);
+            sessions.emplace_back(pair.second);
+        }
+        live_.clear();
+        idle_.clear();
+        for (auto* session : sessions) {
+            session->dropConnection();
+        }
+    }
+
+private:
+    void onDestroy(const proxygen::HTTPSessionBase& session) override {
+        auto it = live_.find(&session);
+        if (it == live_.end()) {
+            return;
+        }
+        for (auto& pair : idle_) {
+            auto& sessions = pair.second;
+            sessions.erase(std::remove(sessions.begin(), sessions.end(), it->second),
+                           sessions.end());
+        }
+        live_.erase(it);
+    }
+
+private:
+    folly::EventBase                                                           *evb_{nullptr};
+    folly::HHWheelTimer::UniquePtr                                              timer_;
+    std::unordered_map<const proxygen::HTTPSessionBase*,
+                       proxygen::HTTPUpstreamSession*>                          live_;
+    std::unordered_map<std::string,
+                       std::vector<proxygen::HTTPUpstreamSession*>>             idle_;
+    std::unordered_map<std::string, std::shared_ptr<folly::SSLContext>>         sslContexts_;
+};
+
+/**
+ * A request runs in an IO thread, and deletes itself when finished.
+ * If a reused connection turns out closed before the request has left the client,
+ * the request is sent once again on a new connection. Once the whole request has
+ * been written, it is never repeated, since the peer may have processed it.
+ * */
+class HttpClient::Request final : public proxygen::HTTPConnector::Callback,
+                                  public proxygen::HTTPTransactionHandler,
+                                  public proxygen::HTTPTransactionTransportCallback {
+public:
+    Request(proxygen::HTTPMethod method,
+            proxygen::URL url,
+            folly::SocketAddress addr,
+            HttpHeaders headers,
+            std::string body,
+            int64_t timeoutMs)
+        : method_(method)
+        , url_(std::move(url))
+        , addr_(std::move(addr))
+        , headers_(std::move(headers))
+        , body_(std::move(body))
+        , timeout_(timeoutMs > 0 ? std::chrono::milliseconds(timeoutMs) : kNoTimeout) {
+        host_ = url_.getHostAndPort();
+        // The connections of http and https to the same host are not shared
+        poolKey_ = url_.getScheme() + "://" + host_;
+    }
+
+    folly::SemiFuture<StatusOr<HttpResponse>> getSemiFuture() {
+        return promise_.getSemiFuture();
+    }
+
+    void start(std::shared_ptr<ConnectionPool> pool) {
+        pool_ = std::move(pool);
+        auto* session = pool_->take(poolKey_);
+        if (session != nullptr) {
+            send(session, true);
+        } else {
+            connect();
+        }
+    }
+
+private:
+    void connect() {
+        connector_ = std::make_unique<proxygen::HTTPConnector>(this, pool_->timer());
+        auto timeout = std::chrono::milliseconds(FLAGS_http_client_connect_timeout_ms);
+        if (!url_.isSecure()) {
+            connector_->connect(pool_->evb(), addr_, timeout);
+            return;
+        }
+        std::shared_ptr<folly::SSLContext> ctx;
+        try {
+            ctx = pool_->sslContext(url_.getHost());
+        } catch (const std::exception& e) {
+            finish(Status::Error("Failed to init TLS for %s: %s", host_.c_str(), e.what()));
+            destroyLater();
+            return;
+        }
+        connector_->connectSSL(pool_->evb(),
+                               addr_,
+                               ctx,
+                               nullptr,
+                               timeout,
+                               folly::AsyncSocket::emptyOptionMap,
+                               folly::AsyncSocket::anyAddress(),
+                               url_.getHost());
+    }
+
+    void send(proxygen::HTTPUpstreamSession* session, bool reused) {
+        session_ = session;
+        reused_ = reused;
+        flushed_ = false;
+        auto* txn = session->newTransaction(this);
+        if (txn == nullptr) {
+            session->closeWhenIdle();
+            if (reused) {
+                connect();
+                return;
+            }
+            finish(Status::Error("Failed to send to %s", host_.c_str()));
+            destroyLater();
+            return;
+        }
+        txn->setIdleTimeout(timeout_);
+        txn->setTransportCallback(this);
+
+        proxygen::HTTPMessage msg;
+        msg.setMethod(method_);
+        msg.setHTTPVersion(1, 1);
+        msg.setURL(url_.makeRelativeURL());
+        auto& headers = msg.getHeaders();
+        headers.set(proxygen::HTTP_HEADER_HOST, host_);
+        for (auto& header : headers_) {
+            headers.add(header.first, header.second);
+        }
+        if (method_ == proxygen::HTTPMethod::POST) {
+            headers.set(proxygen::HTTP_HEADER_CONTENT_LENGTH, folly::to<std::string>(body_.size()));
+        }
+        txn->sendHeaders(msg);
+        if (!body_.empty()) {
+            txn->sendBody(folly::IOBuf::copyBuffer(body_));
+        }
+        txn->sendEOM();
+    }
+
+    void finish(StatusOr<HttpResponse> result) {
+        if (finished_) {
+            return;
+        }
+        finished_ = true;
+        if (!result.ok()) {
+            LOG(ERROR) << "Http " << proxygen::methodToString(method_) << " "
+                       << url_.getUrl() << " failed: " << result.status();
+        }
+        promise_.setValue(std::move(result));
+    }
+
+    // Delete the request out of the callbacks of proxygen
+    void destroyLater() {
+        pool_->evb()->runInLoop([this] { delete this; });
+    }
+
+    void connectSuccess(proxygen::HTTPUpstreamSession* session) override {
+        pool_->track(session);
+        send(session, false);
+    }
+
+    void connectError(const folly::AsyncSocketException& ex) override {
+        finish(Status::Error("Failed to connect %s: %s", host_.c_str(), ex.what()));
+        destroyLater();
+    }
+
+    void setTransaction(proxygen::HTTPTransaction*) noexcept override {
+    }
+
+    void detachTransaction() noexcept override {
+        if (retry_) {
+            retry_ = false;
+            VLOG(1) << "The connection to " << host_ << " was closed, retry on a new one";
+            connect();
+            return;
+        }
+        if (!finished_) {
+            finish(Status::Error("Request to %s aborted", host_.c_str()));
+        }
+        // The session still counts the transaction now
+        auto pool = pool_;
+        auto* session = session_;
+        pool->evb()->runInLoop([pool, host = poolKey_, session] {
+            pool->release(host, session);
+        });
+        delete this;
+    }
+
+    void onHeadersComplete(std::unique_ptr<proxygen::HTTPMessage> msg) noexcept override {
+        responded_ = true;
+        response_.code = msg->getStatusCode();
+    }
+
+    void onBody(std::unique_ptr<folly::IOBuf> chain) noexcept override {
+        for (auto range : *chain) {
+            response_.body.append(reinterpret_cast<const char*>(range.data()), range.size());
+        }
+    }
+
+    void onTrailers(std::unique_ptr<proxygen::HTTPHeaders>) noexcept override {
+    }
+
+    void onEOM() noexcept override {
+        VLOG(2) << "Http " << proxygen::methodToString(method_) << " " << url_.getUrl()
+                << " finished: " << response_.code;
+        finish(std::move(response_));
+    }
+
+    void onUpgrade(proxygen::UpgradeProtocol) noexcept override {
+    }
+
+    void onError(const proxygen::HTTPException& error) noexcept override {
+        // Only when the peer could not have got the whole request, e.g. an admin op
+        // must not run twice because the peer restarted while processing it
+        if (reused_ && !flushed_ && !responded_ && !finished_) {
+            retry_ = true;
+            return;
+        }
+        finish(Status::Error("Request to %s failed: %s", host_.c_str(), error.what()));
+    }
+
+    void onEgressPaused() noexcept override {
+    }
+
+    void onEgressResumed() noexcept override {
+    }
+
+    void lastByteFlushed() noexcept override {
+        flushed_ = true;
+    }
+
+    void firstHeaderByteFlushed() noexcept override {
+    }
+
+    void firstByteFlushed() noexcept override {
+    }
+
+    void lastByteAcked(std::chrono::milliseconds) noexcept override {
+    }
+
+    void headerBytesGenerated(proxygen::HTTPHeaderSize&) noexcept override {
+    }
+
+    void headerBytesReceived(const proxygen::HTTPHeaderSize&) noexcept override {
+    }
+
+    void bodyBytesGenerated(size_t) noexcept override {
+    }
+
+    void bodyBytesReceived(size_t) noexcept override {
+    }
+
+private:
+    proxygen::HTTPMethod                                method_;
+    proxygen::URL                                       url_;
+    folly::SocketAddress                                addr_;
+    HttpHeaders                                         headers_;
+    std::string                                         body_;
+    std::chrono::milliseconds                           timeout_;
+    std::string                                         host_;
+    std::string                                         poolKey_;
+
+    std::shared_ptr<ConnectionPool>                     pool_;
+    std::unique_ptr<proxygen::HTTPConnector>            connector_;
+    proxygen::HTTPUpstreamSession                      *session_{nullptr};
+    bool                                                reused_{false};
+    bool                                                retry_{false};
+    // The whole request has been written to the connection
+    bool                                                flushed_{false};
+    bool                                                responded_{false};
+    bool                                                finished_{false};
+    HttpResponse                                        response_;
+    folly::Promise<StatusOr<HttpResponse>>              promise_;
+};
+
+HttpClient::HttpClient(size_t ioThreads) {
+    ioPool_ = std::make_unique<folly::IOThreadPoolExecutor>(
+        ioThreads, std::make_shared<folly::NamedThreadFactory>("http-client"));
+}
+
+HttpClient::~HttpClient() {
+    std::unordered_map<folly::EventBase*, std::shared_ptr<ConnectionPool>> pools;
+    {
+        std::lock_guard<std::mutex> guard(poolsLock_);
+        pools.swap(pools_);
+    }
+    for (auto& pair : pools) {
+        auto pool = std::move(pair.second);
+        pair.first->runInEventBaseThreadAndWait([pool = std::move(pool)] () mutable {
+            pool->closeAll();
+            pool.reset();
+        });
+    }
+    ioPool_->join();
+}
+
+// static
+HttpClient& HttpClient::instance() {
+    // Never destroyed, so it could be used until the process exits
+    static auto* client = new HttpClient(FLAGS_http_client_io_threads);
+    return *client;
+}
+
+std::shared_ptr<HttpClient::ConnectionPool> HttpClient::poolOf(folly::EventBase* evb) {
+    std::lock_guard<std::mutex> guard(poolsLock_);
+    auto& pool = pools_[evb];
+    if (pool == nullptr) {
+        pool = std::make_shared<ConnectionPool>(evb);
+    }
+    return pool;
+}
+
+folly::SemiFuture<StatusOr<HttpResponse>>
+HttpClient::request(proxygen::HTTPMethod method,
+                    const std::string& url,
+                    const HttpHeaders& headers,
+                    std::string body,
+                    int64_t timeoutMs) {
+    proxygen::URL parsed(url);
+    if (!parsed.isValid() || !parsed.hasHost()) {
+        return folly::makeSemiFuture<StatusOr<HttpResponse>>(
+            Status::Error("Invalid url: %s", url.c_str()));
+    }
+    if (parsed.getScheme() != "http" && parsed.getScheme() != "https") {
+        return folly::makeSemiFuture<StatusOr<HttpResponse>>(
+            Status::NotSupported("Not http or https: %s", url.c_str()));
+    }
+    folly::SocketAddress addr;
+    try {
+        addr.setFromHostPort(parsed.getHost(), parsed.getPort());
+    } catch (const std::exception& e) {
+        return folly::makeSemiFuture<StatusOr<HttpResponse>>(
+            Status::Error("Failed to resolve %s: %s", parsed.getHost().c_str(), e.what()));
+    }
+
+    auto* req = new Request(method, std::move(parsed), std::move(addr),
+                            headers, std::move(body), timeoutMs);
+    auto future = req->getSemiFuture();
+    auto* evb = ioPool_->getEventBase();
+    evb->runInEventBaseThread([this, evb, req] {
+        req->start(poolOf(evb));
+    });
+    return future;
+}
+
+folly::SemiFuture<StatusOr<HttpResponse>>
+HttpClient::asyncGet(const std::string& url, int64_t timeoutMs) {
+    return request(proxygen::HTTPMethod::GET, url, {}, "", timeoutMs);
+}
+
+folly::SemiFuture<StatusOr<HttpResponse>>
+HttpClient::asyncPost(const std::string& url,
+                      const HttpHeaders& headers,
+                      std::string body,
+                      int64_t timeoutMs) {
+    return request(proxygen::HTTPMethod::POST, url, headers, std::move(body), timeoutMs);
+}
+
+// static
+StatusOr<std::string> HttpClient::get(const std::string& url) {
+    auto result = instance().asyncGet(url).get();
+    if (!result.ok()) {
+        return result.status();
+    }
+    return std::move(result).value().body;
+}
+
+// static
+StatusOr<std::string> HttpClient::post(const std::string& url,
+                                       const HttpHeaders& headers,
+                                       const std::string& body) {
+    auto result = instance().asyncPost(url, headers, body).get();
+    if (!result.ok()) {
+        return result.status();
     }
+    return std::move(result).value().body;
 }
 
 }   // namespace http
@@ -9,23 +9,85 @@
 
 #include "base/Base.h"
 #include "base/StatusOr.h"
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
+#include <proxygen/lib/http/HTTPMethod.h>
+
+DECLARE_int32(http_client_io_threads);
+DECLARE_int32(http_client_connect_timeout_ms);
+DECLARE_string(http_client_ca_file);
 
 namespace nebula {
 namespace http {
 
-class HttpClient {
+using HttpHeaders = std::vector<std::pair<std::string, std::string>>;
+
+struct HttpResponse {
+    int32_t                     code{0};
+    std::string                 body;
+};
+
+/**
+ * An asynchronous HTTP/1.1 client running in process, on proxygen.
+ * Both http and https are supported, the certificate of an https server is verified
+ * against http_client_ca_file, or the CA certificates of the system if not given.
+ *
+ * The requests run in the IO threads of the client. The connections are kept alive,
+ * and reused by the later requests to the same host from the same IO thread.
+ * A request fails if the connection could not be established in
+ * http_client_connect_timeout_ms, or if nothing is received for timeoutMs,
+ * where 0 means no timeout.
+ *
+ * The response is returned whatever the status code is, it is up to the caller
+ * to check the code.
+ * */
+class HttpClient final {
 public:
-    HttpClient() = delete;
+    explicit HttpClient(size_t ioThreads);
+
+    ~HttpClient();
 
-    ~HttpClient() = default;
+    // The client shared by the whole process, with http_client_io_threads IO threads
+    static HttpClient& instance();
 
-    static StatusOr<std::string> get(const std::string& path, const std::string& options = "-G");
+    folly::SemiFuture<StatusOr<HttpResponse>> asyncGet(const std::string& url,
+                                                       int64_t timeoutMs = 0);
 
-    static StatusOr<std::string> post(const std::string& path, const std::string& header);
+    folly::SemiFuture<StatusOr<HttpResponse>> asyncPost(const std::string& url,
+                                                        const HttpHeaders& headers,
+                                                        std::string body,
+                                                        int64_t timeoutMs = 0);
+
+    /**
+     * Blocking versions on the shared client, which return the body.
+     * They must not be called in the IO threads of the client.
+     * */
+    static StatusOr<std::string> get(const std::string& url);
+
+    static StatusOr<std::string> post(const std::string& url,
+                                      const HttpHeaders& headers,
+                                      const std::string& body = "");
+
+private:
+    class ConnectionPool;
+    class Request;
+
+    folly::SemiFuture<StatusOr<HttpResponse>> request(proxygen::HTTPMethod method,
+                                                      const std::string& url,
+                                                      const HttpHeaders& headers,
+                                                      std::string body,
+                                                      int64_t timeoutMs);
+
+    // The connections of the IO thread running evb
+    std::shared_ptr<ConnectionPool> poolOf(folly::EventBase* evb);
+
+private:
+    std::unique_ptr<folly::IOThreadPoolExecutor>                            ioPool_;
+    std::mutex                                                              poolsLock_;
+    std::unordered_map<folly::EventBase*, std::shared_ptr<ConnectionPool>>  pools_;
 };
 
 }   // namespace http
 }   // namespace nebula
 
 #endif  // COMMON_HTTPCLIENT_H
-
@@ -6,10 +6,17 @@
 
 #include "http/HttpClient.h"
 
+#include <folly/ScopeGuard.h>
+#include <folly/synchronization/Baton.h>
 #include <gtest/gtest.h>
+#include <openssl/pem.h>
+#include <openssl/x509v3.h>
+#include <proxygen/httpserver/HTTPServer.h>
 #include <proxygen/httpserver/RequestHandler.h>
+#include <proxygen/httpserver/RequestHandlerFactory.h>
 #include <proxygen/httpserver/ResponseBuilder.h>
 
+#include "fs/TempDir.h"
 #include "webservice/Common.h"
 #include "webservice/Router.h"
 #include "webservice/WebService.h"
@@ -47,6 +54,195 @@ public:
                    << proxygen::getErrorString(error);
     }
 };
+
+// Respond with the client address, the value of the header "Name" and the body
+class EchoHandler : public proxygen::RequestHandler {
+public:
+    explicit EchoHandler(int32_t delayMs = 0) : delayMs_(delayMs) {}
+
+    void onRequest(std::unique_ptr<proxygen::HTTPMessage> headers) noexcept override {
+        peer_ = headers->getClientAddress().describe();
+        name_ = headers->getHeaders().getSingleOrEmpty("Name");
+    }
+
+    void onBody(std::unique_ptr<folly::IOBuf> body) noexcept override {
+        body_.append(body->moveToFbString().toStdString());
+    }
+
+    void onEOM() noexcept override {
+        if (delayMs_ > 0) {
+            usleep(delayMs_ * 1000);
+        }
+        proxygen::ResponseBuilder(downstream_)
+            .status(WebServiceUtils::to(HttpStatusCode::OK),
+                    WebServiceUtils::toString(HttpStatusCode::OK))
+            .body(folly::stringPrintf("%s %s %s", peer_.c_str(), name_.c_str(), body_.c_str()))
+            .sendWithEOM();
+    }
+
+    void onUpgrade(proxygen::UpgradeProtocol) noexcept override {
+    }
+
+    void requestComplete() noexcept override {
+        delete this;
+    }
+
+    void onError(proxygen::ProxygenError) noexcept override {
+        delete this;
+    }
+
+private:
+    int32_t         delayMs_{0};
+    std::string     peer_;
+    std::string     name_;
+    std::string     body_;
+};
+
+// Count the requests, and drop the connection without any response
+class AbortHandler : public proxygen::RequestHandler {
+public:
+    static std::atomic<int32_t> count;
+
+    void onRequest(std::unique_ptr<proxygen::HTTPMessage>) noexcept override {
+    }
+
+    void onBody(std::unique_ptr<folly::IOBuf>) noexcept override {
+    }
+
+    void onEOM() noexcept override {
+        ++count;
+        downstream_->sendAbort();
+    }
+
+    void onUpgrade(proxygen::UpgradeProtocol) noexcept override {
+    }
+
+    void requestComplete() noexcept override {
+        delete this;
+    }
+
+    void onError(proxygen::ProxygenError) noexcept override {
+        delete this;
+    }
+};
+
+std::atomic<int32_t> AbortHandler::count{0};
+
+class EchoHandlerFactory : public proxygen::RequestHandlerFactory {
+public:
+    void onServerStart(folly::EventBase*) noexcept override {
+    }
+
+    void onServerStop() noexcept override {
+    }
+
+    proxygen::RequestHandler* onRequest(proxygen::RequestHandler*,
+                                        proxygen::HTTPMessage*) noexcept override {
+        return new EchoHandler();
+    }
+};
+
+// An https server of EchoHandler on 127.0.0.1, with a self-signed certificate
+class HttpsServer final {
+public:
+    HttpsServer() : dir_("/tmp/HttpClientTest.XXXXXX") {
+        certPath_ = folly::stringPrintf("%s/cert.pem", dir_.path());
+        auto keyPath = folly::stringPrintf("%s/key.pem", dir_.path());
+        writeCertificate(certPath_, keyPath);
+
+        wangle::SSLContextConfig ssl;
+        ssl.setCertificate(certPath_, keyPath, "");
+        ssl.isDefault = true;
+        std::vector<proxygen::HTTPServer::IPConfig> ips = {
+            {folly::SocketAddress("127.0.0.1", 0, true), proxygen::HTTPServer::Protocol::HTTP},
+        };
+        ips[0].sslConfigs.emplace_back(std::move(ssl));
+
+        proxygen::HTTPServerOptions options;
+        options.threads = 1;
+        options.handlerFactories =
+            proxygen::RequestHandlerChain().addThen<EchoHandlerFactory>().build();
+        server_ = std::make_unique<proxygen::HTTPServer>(std::move(options));
+        server_->bind(ips);
+
+        folly::Baton<> started;
+        thread_ = std::thread([this, &started] {
+            server_->start([&started] { started.post(); },
+                           [&started] (std::exception_ptr) {
+                               LOG(ERROR) << "Failed to start the https server";
+                               started.post();
+                           });
+        });
+        started.wait();
+        CHECK_EQ(1UL, server_->addresses().size());
+        port_ = server_->addresses()[0].address.getPort();
+    }
+
+    ~HttpsServer() {
+        server_->stop();
+        thread_.join();
+    }
+
+    std::string url(const std::string& path) const {
+        return folly::stringPrintf("https://127.0.0.1:%d%s", port_, path.c_str());
+    }
+
+    const std::string& certPath() const {
+        return certPath_;
+    }
+
+private:
+    static void writeCertificate(const std::string& certPath, const std::string& keyPath) {
+        auto* key = EVP_PKEY_new();
+        auto* rsa = RSA_new();
+        auto* e = BN_new();
+        BN_set_word(e, RSA_F4);
+        CHECK_EQ(1, RSA_generate_key_ex(rsa, 2048, e, nullptr));
+        BN_free(e);
+        EVP_PKEY_assign_RSA(key, rsa);
+
+        auto* cert = X509_new();
+        X509_set_version(cert, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+        X509_gmtime_adj(X509_get_notBefore(cert), 0);
+        X509_gmtime_adj(X509_get_notAfter(cert), 3600);
+        X509_set_pubkey(cert, key);
+        auto* name = X509_get_subject_name(cert);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                                   reinterpret_cast<const unsigned char*>("127.0.0.1"),
+                                   -1, -1, 0);
+        X509_set_issuer_name(cert, name);
+        X509V3_CTX ctx;
+        X509V3_set_ctx_nodb(&ctx);
+        X509V3_set_ctx(&ctx, cert, cert, nullptr, nullptr, 0);
+        char constraints[] = "critical,CA:TRUE";
+        char altName[] = "IP:127.0.0.1";
+        for (auto& ext : {std::make_pair(NID_basic_constraints, constraints),
+                          std::make_pair(NID_subject_alt_name, altName)}) {
+            auto* extension = X509V3_EXT_conf_nid(nullptr, &ctx, ext.first, ext.second);
+            CHECK_NOTNULL(extension);
+            X509_add_ext(cert, extension, -1);
+            X509_EXTENSION_free(extension);
+        }
+        CHECK_LT(0, X509_sign(cert, key, EVP_sha256()));
+
+        auto* file = fopen(certPath.c_str(), "w");
+        PEM_write_X509(file, cert);
+        fclose(file);
+        file = fopen(keyPath.c_str(), "w");
+        PEM_write_PrivateKey(file, key, nullptr, nullptr, 0, nullptr, nullptr);
+        fclose(file);
+        X509_free(cert);
+        EVP_PKEY_free(key);
+    }
+
+    fs::TempDir                                 dir_;
+    std::string                                 certPath_;
+    std::unique_ptr<proxygen::HTTPServer>       server_;
+    std::thread                                 thread_;
+    int32_t                                     port_{0};
+};
+
 class HttpClientTestEnv : public ::testing::Environment {
 public:
     void SetUp() override {
@@ -57,6 +253,10 @@ public:
 
         auto& router = webSvc_->router();
         router.get("/path").handler([](auto&&) { return new HttpClientHandler(); });
+        router.get("/echo").handler([](auto&&) { return new EchoHandler(); });
+        router.post("/echo").handler([](auto&&) { return new EchoHandler(); });
+        router.get("/slow").handler([](auto&&) { return new EchoHandler(1000); });
+        router.post("/abort").handler([](auto&&) { return new AbortHandler(); });
 
         auto status = webSvc_->start();
         ASSERT_TRUE(status.ok()) << status;
@@ -88,6 +288,119 @@ TEST(HttpClient, get) {
     }
 }
 
+static std::string url(const std::string& path) {
+    return folly::stringPrintf("http://%s:%d%s", FLAGS_ws_ip.c_str(),
+                               FLAGS_ws_http_port, path.c_str());
+}
+
+TEST(HttpClient, post) {
+    auto result = HttpClient::post(url("/echo"), {{"Name", "nebula"}}, "graph");
+    ASSERT_TRUE(result.ok()) << result.status();
+    std::vector<std::string> words;
+    folly::split(" ", result.value(), words);
+    ASSERT_EQ(3, words.size());
+    EXPECT_EQ("nebula", words[1]);
+    EXPECT_EQ("graph", words[2]);
+}
+
+TEST(HttpClient, ReuseConnection) {
+    HttpClient client(1);
+    std::string peer;
+    for (auto i = 0; i < 3; i++) {
+        auto result = client.asyncGet(url("/echo")).get();
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_EQ(200, result.value().code);
+        auto current = result.value().body.substr(0, result.value().body.find(' '));
+        if (i > 0) {
+            // From the same local port
+            ASSERT_EQ(peer, current);
+        }
+        peer = current;
+    }
+}
+
+TEST(HttpClient, ConcurrentRequests) {
+    HttpClient client(2);
+    std::vector<folly::SemiFuture<StatusOr<HttpResponse>>> futures;
+    for (auto i = 0; i < 50; i++) {
+        auto body = folly::to<std::string>(i);
+        futures.emplace_back(client.asyncPost(url("/echo"), {{"Name", "p"}}, body));
+    }
+    for (auto i = 0; i < 50; i++) {
+        auto result = std::move(futures[i]).get();
+        ASSERT_TRUE(result.ok()) << result.status();
+        auto expected = folly::stringPrintf(" p %d", i);
+        ASSERT_TRUE(folly::StringPiece(result.value().body).endsWith(expected));
+    }
+}
+
+TEST(HttpClient, Failures) {
+    HttpClient client(1);
+    {
+        auto result = client.asyncGet(url("/slow"), 100).get();
+        ASSERT_FALSE(result.ok());
+    }
+    {
+        // Nobody listens on the port
+        auto result = client.asyncGet(folly::stringPrintf("http://%s:1/path",
+                                                          FLAGS_ws_ip.c_str())).get();
+        ASSERT_FALSE(result.ok());
+    }
+    {
+        auto result = client.asyncGet("not a url").get();
+        ASSERT_FALSE(result.ok());
+    }
+    {
+        auto result = client.asyncGet(url("/path")).get();
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_EQ("HttpClientHandler successfully", result.value().body);
+    }
+}
+
+TEST(HttpClient, NoRetryAfterSent) {
+    HttpClient client(1);
+    auto result = client.asyncGet(url("/echo")).get();
+    ASSERT_TRUE(result.ok()) << result.status();
+    // The request is sent on the reused connection, and the peer has got it,
+    // so it must not be sent again when the connection is dropped
+    AbortHandler::count = 0;
+    result = client.asyncPost(url("/abort"), {}, "admin").get();
+    ASSERT_FALSE(result.ok());
+    ASSERT_EQ(1, AbortHandler::count);
+}
+
+TEST(HttpClient, Https) {
+    HttpsServer server;
+    auto caFile = FLAGS_http_client_ca_file;
+    SCOPE_EXIT {
+        FLAGS_http_client_ca_file = caFile;
+    };
+    {
+        // Not trusted by the system
+        HttpClient client(1);
+        auto result = client.asyncGet(server.url("/echo")).get();
+        ASSERT_FALSE(result.ok());
+    }
+    FLAGS_http_client_ca_file = server.certPath();
+    {
+        HttpClient client(1);
+        for (auto i = 0; i < 3; i++) {
+            auto result = client.asyncPost(server.url("/echo"), {{"Name", "tls"}}, "graph").get();
+            ASSERT_TRUE(result.ok()) << result.status();
+            ASSERT_EQ(200, result.value().code);
+            ASSERT_TRUE(folly::StringPiece(result.value().body).endsWith(" tls graph"));
+        }
+    }
+    {
+        // The certificate is not for the host
+        HttpClient client(1);
+        auto badHost = server.url("/echo");
+        badHost.replace(badHost.find("127.0.0.1"), 9, "localhost");
+        auto result = client.asyncGet(badHost).get();
+        ASSERT_FALSE(result.ok());
+    }
+}
+
 }   // namespace http
 }   // namespace nebula
 
@@ -144,7 +144,12 @@ bool PermissionManager::canWriteRole(session::Session *session,
 
 // static
 bool PermissionManager::canWriteData(session::Session *session) {
-    if (session->space() == -1) {
+    return canWriteData(session, session->space());
+}
+
+// static
+bool PermissionManager::canWriteData(session::Session *session, GraphSpaceID spaceId) {
+    if (spaceId == -1) {
         LOG(ERROR) << "The space name is not set";
         return false;
     }
@@ -152,7 +157,7 @@ bool PermissionManager::canWriteData(session::Session *session) {
         return true;
     }
     bool havePermission = false;
-    switch (session->roleWithSpace(session->space())) {
+    switch (session->roleWithSpace(spaceId)) {
         case session::Role::GOD :
         case session::Role::ADMIN :
         case session::Role::DBA :
@@ -31,6 +31,7 @@ public:
                              GraphSpaceID spaceId,
                              const std::string& targetUser);
     static bool canWriteData(session::Session *session);
+    static bool canWriteData(session::Session *session, GraphSpaceID spaceId);
     static bool canShow(session::Session *session,
                         ShowSentence::ShowType type,
                         GraphSpaceID targetSpace = -1);
@@ -55,5 +55,20 @@ void GenericThreadPool::purgeTimerTask(uint64_t id) {
     pool_[idx]->purgeTimerTask(id);
 }
 
+void GenericThreadPool::purgeWheelTask(uint64_t id) {
+    auto idx = (id >> GenericWorker::TIMER_ID_BITS);
+    id = (id & GenericWorker::TIMER_ID_MASK);
+    pool_[idx]->purgeWheelTask(id);
+}
+
+size_t GenericThreadPool::pickWheelWorker() {
+    for (auto i = 0UL; i < nrThreads_; i++) {
+        if (pool_[i]->inWorkerThread()) {
+            return i;
+        }
+    }
+    return nextThread_++ % nrThreads_;
+}
+
 }   // namespace thread
 }   // namespace nebula
@@ -120,6 +120,37 @@ public:
      */
     void purgeTimerTask(uint64_t id);
 
+    /**
+     * To add a oneshot task into the timer wheel of a worker.
+     * If called from a task of this pool, the current worker is chosen.
+     * @ms      milliseconds from now when the task get executed
+     * @task    a callable object
+     * @args    variadic arguments
+     * @return  ID of the added task, unique for this pool
+     */
+    template <typename F, typename...Args>
+    uint64_t addWheelTask(size_t, F&&, Args&&...);
+
+    /**
+     * To add a repeated task into the timer wheel of a worker.
+     * @ms      interval in milliseconds
+     * @task    a callable object
+     * @args    variadic arguments
+     * @return  ID of the added task, unique for this pool
+     */
+    template <typename F, typename...Args>
+    uint64_t addRepeatWheelTask(size_t, F&&, Args&&...);
+
+    /**
+     * To purge a task from the timer wheel.
+     * @id      ID returned by `addWheelTask' or `addRepeatWheelTask'
+     */
+    void purgeWheelTask(uint64_t id);
+
+private:
+    // The worker of the calling thread if it is in this pool, otherwise the next one
+    size_t pickWheelWorker();
+
 private:
     size_t                                          nrThreads_{0};
     std::atomic<size_t>                             nextThread_{0};
@@ -186,6 +217,26 @@ uint64_t GenericThreadPool::addRepeatTask(size_t ms, F &&f, Args &&...args) {
     return ((idx << GenericWorker::TIMER_ID_BITS) | id);
 }
 
+
+template <typename F, typename...Args>
+uint64_t GenericThreadPool::addWheelTask(size_t ms, F &&f, Args &&...args) {
+    auto idx = pickWheelWorker();
+    auto id = pool_[idx]->addWheelTask(ms,
+                                       std::forward<F>(f),
+                                       std::forward<Args>(args)...);
+    return ((idx << GenericWorker::TIMER_ID_BITS) | id);
+}
+
+
+template <typename F, typename...Args>
+uint64_t GenericThreadPool::addRepeatWheelTask(size_t ms, F &&f, Args &&...args) {
+    auto idx = nextThread_++ % nrThreads_;
+    auto id = pool_[idx]->addRepeatWheelTask(ms,
+                                             std::forward<F>(f),
+                                             std::forward<Args>(args)...);
+    return ((idx << GenericWorker::TIMER_ID_BITS) | id);
+}
+
 }   // namespace thread
 }   // namespace nebula
 
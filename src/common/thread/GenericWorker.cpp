@@ -12,11 +12,20 @@
 namespace nebula {
 namespace thread {
 
+namespace {
+// The worker running in the current thread
+thread_local GenericWorker *currentWorker = nullptr;
+}   // namespace
+
 GenericWorker::GenericWorker() = default;
 
 GenericWorker::~GenericWorker() {
     stop();
     wait();
+    if (wheelTicker_ != nullptr) {
+        event_free(wheelTicker_);
+        wheelTicker_ = nullptr;
+    }
     if (notifier_ != nullptr) {
         event_free(notifier_);
         notifier_ = nullptr;
@@ -58,6 +67,15 @@ bool GenericWorker::start(std::string name) {
     DCHECK(notifier_ != nullptr);
     event_add(notifier_, nullptr);
 
+    // Create the ticker of the timer wheel, which is added once there are wheel tasks
+    wheelStart_ = std::chrono::steady_clock::now();
+    wheel_ = std::make_unique<TimerWheel>(0);
+    auto tick = [] (int, int16_t, void *arg) {
+        reinterpret_cast<GenericWorker*>(arg)->onWheelTick();
+    };
+    wheelTicker_ = event_new(evbase_, -1, EV_PERSIST, tick, this);
+    DCHECK(wheelTicker_ != nullptr);
+
     // Launch a new thread to run the event loop
     thread_ = std::make_unique<NamedThread>(name_, &GenericWorker::loop, this);
 
@@ -86,7 +104,13 @@ bool GenericWorker::wait() {
 }
 
 void GenericWorker::loop() {
+    currentWorker = this;
     event_base_dispatch(evbase_);
+    currentWorker = nullptr;
+}
+
+bool GenericWorker::inWorkerThread() const {
+    return currentWorker == this;
 }
 
 void GenericWorker::notify() {
@@ -152,6 +176,7 @@ void GenericWorker::onNotify() {
             purgeTimerInternal(id);
         }
     }
+    drainWheelTasks();
 }
 
 GenericWorker::Timer::Timer(std::function<void(void)> cb) {
@@ -180,6 +205,105 @@ void GenericWorker::purgeTimerInternal(uint64_t id) {
     }
 }
 
+uint64_t GenericWorker::addWheelTimer(size_t delay,
+                                      size_t interval,
+                                      std::function<void(void)> cb) {
+    WheelTask task;
+    task.id_ = (nextWheelTaskId_++ & TIMER_ID_MASK);
+    task.delayMSec_ = delay;
+    task.intervalMSec_ = interval;
+    task.callback_ = std::move(cb);
+    auto id = task.id_;
+    if (inWorkerThread()) {
+        // Called from a task of this worker, e.g. a wheel task rescheduling itself
+        addWheelTaskInternal(std::move(task));
+        return id;
+    }
+    auto ticking = false;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        pendingWheelTasks_.emplace_back(std::move(task));
+        ticking = wheelTicking_;
+    }
+    if (!ticking) {
+        notify();
+    }
+    return id;
+}
+
+void GenericWorker::purgeWheelTask(uint64_t id) {
+    if (inWorkerThread()) {
+        // The task might still be pending
+        drainWheelTasks();
+        wheel_->cancel(id);
+        return;
+    }
+    auto ticking = false;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        purgingWheelTasks_.emplace_back(id);
+        ticking = wheelTicking_;
+    }
+    if (!ticking) {
+        notify();
+    }
+}
+
+void GenericWorker::drainWheelTasks() {
+    decltype(pendingWheelTasks_) newcomings;
+    decltype(purgingWheelTasks_) purgings;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        newcomings.swap(pendingWheelTasks_);
+        purgings.swap(purgingWheelTasks_);
+    }
+    for (auto &task : newcomings) {
+        addWheelTaskInternal(std::move(task));
+    }
+    for (auto id : purgings) {
+        wheel_->cancel(id);
+    }
+}
+
+void GenericWorker::addWheelTaskInternal(WheelTask task) {
+    if (wheel_->empty()) {
+        // Catch up with the clock after being idle, which fires nothing
+        wheel_->advanceTo(currentTick());
+    }
+    // The wheel might be behind the clock by a tick or more, and it should never fire
+    // before the task is due, so one more tick is added.
+    auto delay = currentTick() - wheel_->now() + task.delayMSec_ / WHEEL_TICK_MSEC + 1;
+    auto interval = (task.intervalMSec_ + WHEEL_TICK_MSEC - 1) / WHEEL_TICK_MSEC;
+    wheel_->add(task.id_, delay, interval, std::move(task.callback_));
+    if (!wheelTicking_) {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            wheelTicking_ = true;
+        }
+        struct timeval tv;
+        tv.tv_sec = 0;
+        tv.tv_usec = WHEEL_TICK_MSEC * 1000;
+        evtimer_add(wheelTicker_, &tv);
+    }
+}
+
+void GenericWorker::onWheelTick() {
+    drainWheelTasks();
+    wheel_->advanceTo(currentTick());
+    std::lock_guard<std::mutex> guard(lock_);
+    if (wheel_->empty() && pendingWheelTasks_.empty() && purgingWheelTasks_.empty()) {
+        // Stop ticking until there are new wheel tasks
+        wheelTicking_ = false;
+        evtimer_del(wheelTicker_);
+    }
+}
+
+uint64_t GenericWorker::currentTick() const {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - wheelStart_);
+    return elapsed.count() / WHEEL_TICK_MSEC;
+}
+
 }   // namespace thread
 }   // namespace nebula
 
@@ -11,6 +11,7 @@
 #include <folly/Unit.h>
 #include "cpp/helpers.h"
 #include "thread/NamedThread.h"
+#include "thread/TimerWheel.h"
 
 /**
  * GenericWorker implements a event-based task executor that executes tasks asynchronously
@@ -21,6 +22,10 @@
  *
  * Please NOTE that, as the name indicates, this a worker thread for the general purpose,
  * but not for the performance critical situation.
+ *
+ * For a large number of timers, e.g. one or more for each partition, there are the wheel
+ * tasks, which are kept in a TimerWheel and driven by a single libevent timer ticking every
+ * `WHEEL_TICK_MSEC' milliseconds, rather than one libevent timer for each.
  */
 
 struct event;
@@ -131,6 +136,39 @@ public:
     template <typename F, typename...Args>
     uint64_t addTimerTask(size_t, size_t, F&&, Args&&...);
 
+    /**
+     * To add a oneshot task into the timer wheel, which will be executed after a while.
+     * Unlike `addDelayTask', there is no future to wait upon, and the task is executed
+     * in the first tick after it is due, i.e. no more than `WHEEL_TICK_MSEC' late.
+     * @ms      milliseconds from now when the task get executed
+     * @task    a callable object
+     * @args    variadic arguments
+     * @return  ID of the added task, unique for this worker
+     */
+    template <typename F, typename...Args>
+    uint64_t addWheelTask(size_t ms, F &&task, Args &&...args);
+
+    /**
+     * To add a repeated task into the timer wheel, which will be executed in each period.
+     * @ms      interval in milliseconds
+     * @task    a callable object
+     * @args    variadic arguments
+     * @return  ID of the added task, unique for this worker
+     */
+    template <typename F, typename...Args>
+    uint64_t addRepeatWheelTask(size_t ms, F &&task, Args &&...args);
+
+    /**
+     * To purge a task from the timer wheel.
+     * @id      ID returned by `addWheelTask' or `addRepeatWheelTask'
+     */
+    void purgeWheelTask(uint64_t id);
+
+    /**
+     * Whether the caller is running in the thread of this worker.
+     */
+    bool inWorkerThread() const;
+
 private:
     void purgeTimerInternal(uint64_t id);
 
@@ -146,10 +184,23 @@ private:
         GenericWorker                          *owner_{nullptr};
     };
 
+    struct WheelTask {
+        uint64_t                                id_;
+        uint64_t                                delayMSec_;
+        uint64_t                                intervalMSec_;
+        std::function<void(void)>               callback_;
+    };
+
 private:
     void loop();
     void notify();
     void onNotify();
+    uint64_t addWheelTimer(size_t delay, size_t interval, std::function<void(void)> cb);
+    // Move the wheel tasks added or purged by other threads into the wheel
+    void drainWheelTasks();
+    void addWheelTaskInternal(WheelTask task);
+    void onWheelTick();
+    uint64_t currentTick() const;
     uint64_t nextTimerId() {
         // !NOTE! `lock_' must be hold
         return (nextTimerId_++ & TIMER_ID_MASK);
@@ -158,6 +209,7 @@ private:
 private:
     static constexpr uint64_t TIMER_ID_BITS     = 6 * 8;
     static constexpr uint64_t TIMER_ID_MASK     = ((~0x0UL) >> (64 - TIMER_ID_BITS));
+    static constexpr uint64_t WHEEL_TICK_MSEC   = 10;
     std::string                                 name_;
     std::atomic<bool>                           stopped_{true};
     volatile uint64_t                           nextTimerId_{0};
@@ -170,6 +222,16 @@ private:
     std::vector<TimerPtr>                       pendingTimers_;
     std::vector<uint64_t>                       purgingingTimers_;
     std::unordered_map<uint64_t, TimerPtr>      activeTimers_;
+    std::atomic<uint64_t>                       nextWheelTaskId_{0};
+    std::chrono::steady_clock::time_point       wheelStart_;
+    std::unique_ptr<TimerWheel>                 wheel_;
+    struct event                               *wheelTicker_ = nullptr;
+    // Whether the ticker is on, so that the wheel tasks added by other threads will be
+    // picked up in the next tick without a notification.
+    // !NOTE! Only changed by the worker thread, with `lock_' hold
+    bool                                        wheelTicking_{false};
+    std::vector<WheelTask>                      pendingWheelTasks_;
+    std::vector<uint64_t>                       purgingWheelTasks_;
     std::unique_ptr<NamedThread>                thread_;
 };
 
@@ -289,6 +351,22 @@ uint64_t GenericWorker::addTimerTask(size_t delay,
     return id;
 }
 
+
+template <typename F, typename...Args>
+uint64_t GenericWorker::addWheelTask(size_t ms, F &&f, Args &&...args) {
+    return addWheelTimer(ms,
+                         0,
+                         std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+}
+
+
+template <typename F, typename...Args>
+uint64_t GenericWorker::addRepeatWheelTask(size_t ms, F &&f, Args &&...args) {
+    return addWheelTimer(ms,
+                         ms,
+                         std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+}
+
 }   // namespace thread
 }   // namespace nebula
 
@@ -0,0 +1,144 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "thread/TimerWheel.h"
+
+namespace nebula {
+namespace thread {
+
+TimerWheel::TimerWheel(uint64_t now) : now_(now) {
+}
+
+TimerWheel::~TimerWheel() = default;
+
+void TimerWheel::add(uint64_t id, uint64_t delay, uint64_t interval, Callback cb) {
+    auto node = std::make_unique<Node>();
+    node->id_ = id;
+    node->expire_ = now_ + std::max(delay, 1UL);
+    node->interval_ = interval;
+    node->callback_ = std::move(cb);
+    schedule(node.get());
+    auto result = nodes_.emplace(id, std::move(node));
+    DCHECK(result.second) << "Duplicate timer " << id;
+}
+
+bool TimerWheel::cancel(uint64_t id) {
+    auto iter = nodes_.find(id);
+    if (iter == nodes_.end()) {
+        return false;
+    }
+    auto *node = iter->second.get();
+    if (node == running_) {
+        // It will be released once the callback returns
+        node->cancelled_ = true;
+        return true;
+    }
+    unlink(node);
+    nodes_.erase(iter);
+    return true;
+}
+
+size_t TimerWheel::advanceTo(uint64_t tick) {
+    auto fired = 0UL;
+    while (now_ < tick) {
+        if (nodes_.empty()) {
+            // Nothing to fire, just jump there
+            now_ = tick;
+            break;
+        }
+        now_++;
+        // Move the timers down from the highest level first, since they might
+        // land in the slot of a lower level to be moved down in this tick too.
+        if ((now_ & ((1UL << (LEVEL_BITS * LEVELS)) - 1)) == 0) {
+            cascade(&overflow_);
+        }
+        for (auto level = LEVELS - 1; level > 0; level--) {
+            auto shift = LEVEL_BITS * level;
+            if ((now_ & ((1UL << shift) - 1)) != 0) {
+                continue;
+            }
+            cascade(&slots_[level][(now_ >> shift) & SLOT_MASK]);
+        }
+        fired += fire(&slots_[0][now_ & SLOT_MASK]);
+    }
+    return fired;
+}
+
+void TimerWheel::link(Link *head, Link *node) {
+    node->prev_ = head->prev_;
+    node->next_ = head;
+    head->prev_->next_ = node;
+    head->prev_ = node;
+}
+
+void TimerWheel::unlink(Link *node) {
+    node->prev_->next_ = node->next_;
+    node->next_->prev_ = node->prev_;
+    node->prev_ = node->next_ = node;
+}
+
+void TimerWheel::splice(Link *from, Link *to) {
+    DCHECK(to->empty());
+    if (from->empty()) {
+        return;
+    }
+    to->next_ = from->next_;
+    to->prev_ = from->prev_;
+    to->next_->prev_ = to;
+    to->prev_->next_ = to;
+    from->prev_ = from->next_ = from;
+}
+
+void TimerWheel::schedule(Node *node) {
+    DCHECK_GE(node->expire_, now_);
+    // The lowest level whose upper one shares the same slot with now
+    for (auto level = 0UL; level < LEVELS; level++) {
+        auto shift = LEVEL_BITS * (level + 1);
+        if ((node->expire_ >> shift) == (now_ >> shift)) {
+            auto idx = (node->expire_ >> (LEVEL_BITS * level)) & SLOT_MASK;
+            link(&slots_[level][idx], node);
+            return;
+        }
+    }
+    link(&overflow_, node);
+}
+
+void TimerWheel::cascade(Link *slot) {
+    Link pending;
+    splice(slot, &pending);
+    while (!pending.empty()) {
+        auto *node = static_cast<Node*>(pending.next_);
+        unlink(node);
+        schedule(node);
+    }
+}
+
+size_t TimerWheel::fire(Link *slot) {
+    auto fired = 0UL;
+    Link expired;
+    splice(slot, &expired);
+    // The callbacks might cancel the timers in `expired', which just unlinks them.
+    while (!expired.empty()) {
+        auto *node = static_cast<Node*>(expired.next_);
+        unlink(node);
+        DCHECK_EQ(node->expire_, now_);
+        running_ = node;
+        node->callback_();
+        running_ = nullptr;
+        fired++;
+        if (node->interval_ == 0 || node->cancelled_) {
+            nodes_.erase(node->id_);
+            continue;
+        }
+        node->expire_ = now_ + node->interval_;
+        schedule(node);
+    }
+    return fired;
+}
+
+}   // namespace thread
+}   // namespace nebula
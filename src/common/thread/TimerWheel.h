@@ -0,0 +1,117 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+#ifndef COMMON_THREAD_TIMERWHEEL_H_
+#define COMMON_THREAD_TIMERWHEEL_H_
+
+#include "base/Base.h"
+#include "cpp/helpers.h"
+
+/**
+ * TimerWheel is a hierarchical timing wheel, which keeps a large number of timers
+ * with O(1) insertion and cancellation.
+ *
+ * The time is measured in ticks. There are four levels of 256 slots each, a timer
+ * due in the current 256 ticks lives in a slot of the lowest level, one due in the
+ * current 65536 ticks lives in the second level, and so on. When the clock reaches
+ * the start of a slot of a higher level, its timers are moved down, which happens
+ * at most once per level for each timer. All the timers in a slot of the lowest
+ * level fire in a batch.
+ *
+ * TimerWheel is not thread safe, it is meant to be driven by a single thread,
+ * e.g. the one of a GenericWorker.
+ */
+
+namespace nebula {
+namespace thread {
+
+class TimerWheel final : public nebula::cpp::NonCopyable, public nebula::cpp::NonMovable {
+public:
+    using Callback = std::function<void()>;
+
+    explicit TimerWheel(uint64_t now = 0);
+    ~TimerWheel();
+
+    /**
+     * To add a timer.
+     * @id          a unique ID to cancel the timer with
+     * @delay       ticks from now when the timer fires, at least one
+     * @interval    ticks between the subsequent fires, zero for a oneshot timer
+     * @cb          the callback, which is free to add or cancel timers
+     */
+    void add(uint64_t id, uint64_t delay, uint64_t interval, Callback cb);
+
+    /**
+     * To cancel a timer, returns false if there is no such timer.
+     * Cancelling a timer from its own callback stops the repeating.
+     */
+    bool cancel(uint64_t id);
+
+    /**
+     * To move the clock forward to `tick', firing all the timers due meanwhile.
+     * Returns the number of the fired callbacks.
+     */
+    size_t advanceTo(uint64_t tick);
+
+    uint64_t now() const {
+        return now_;
+    }
+
+    size_t size() const {
+        return nodes_.size();
+    }
+
+    bool empty() const {
+        return nodes_.empty();
+    }
+
+private:
+    struct Link {
+        Link() : prev_(this), next_(this) {}
+        bool empty() const {
+            return next_ == this;
+        }
+        Link                                   *prev_;
+        Link                                   *next_;
+    };
+
+    struct Node : public Link {
+        uint64_t                                id_;
+        uint64_t                                expire_;
+        uint64_t                                interval_;
+        Callback                                callback_;
+        bool                                    cancelled_{false};
+    };
+
+    static void link(Link *head, Link *node);
+    static void unlink(Link *node);
+    // Move all the nodes of `from' to the empty list `to'
+    static void splice(Link *from, Link *to);
+
+    // Put the node into the slot according to its expiration
+    void schedule(Node *node);
+    // Reschedule all the nodes of a slot of a higher level
+    void cascade(Link *slot);
+    size_t fire(Link *slot);
+
+private:
+    static constexpr uint64_t LEVEL_BITS        = 8;
+    static constexpr uint64_t LEVEL_SLOTS       = 1UL << LEVEL_BITS;
+    static constexpr uint64_t SLOT_MASK         = LEVEL_SLOTS - 1;
+    static constexpr uint64_t LEVELS            = 4;
+
+    uint64_t                                    now_;
+    Link                                        slots_[LEVELS][LEVEL_SLOTS];
+    // Timers beyond the range of the highest level
+    Link                                        overflow_;
+    std::unordered_map<uint64_t, std::unique_ptr<Node>> nodes_;
+    // The timer whose callback is running
+    Node                                       *running_{nullptr};
+};
+
+}   // namespace thread
+}   // namespace nebula
+
+#endif  // COMMON_THREAD_TIMERWHEEL_H_
@@ -6,6 +6,7 @@
 
 #include "base/Base.h"
 #include <gtest/gtest.h>
+#include <folly/synchronization/Baton.h>
 #include "thread/GenericThreadPool.h"
 #include "time/Duration.h"
 
@@ -144,5 +145,44 @@ TEST(GenericThreadPool, purgeRepeatTask) {
     }
 }
 
+TEST(GenericThreadPool, addWheelTask) {
+    GenericThreadPool pool;
+    ASSERT_TRUE(pool.start(4));
+    {
+        folly::Baton<> baton;
+        auto counter = 0UL;
+        std::set<pid_t> threads;
+        // Rescheduled from a worker, the task stays on the same one
+        std::function<void()> cb = [&] () {
+            threads.emplace(gettid());
+            if (++counter == 5) {
+                baton.post();
+                return;
+            }
+            pool.addWheelTask(10, cb);
+        };
+        pool.addWheelTask(10, cb);
+        baton.wait();
+        ASSERT_EQ(5, counter);
+        ASSERT_EQ(1, threads.size());
+    }
+}
+
+TEST(GenericThreadPool, purgeWheelTask) {
+    GenericThreadPool pool;
+    ASSERT_TRUE(pool.start(4));
+    for (auto i = 0; i < 8; i++) {
+        auto counter = 0UL;
+        auto cb = [&] () {
+            counter++;
+        };
+        auto id = pool.addRepeatWheelTask(50, cb);
+        ::usleep(130 * 1000);
+        pool.purgeWheelTask(id);
+        ::usleep(60 * 1000);
+        ASSERT_EQ(2, counter) << "i: " << i << ", id: " << id;
+    }
+}
+
 }   // namespace thread
 }   // namespace nebula
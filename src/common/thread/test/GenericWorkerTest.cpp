@@ -6,6 +6,7 @@
 
 #include "base/Base.h"
 #include <gtest/gtest.h>
+#include <folly/synchronization/Baton.h>
 #include "thread/GenericWorker.h"
 #include "time/Duration.h"
 
@@ -144,5 +145,78 @@ TEST(GenericWorker, purgeRepeatTask) {
     }
 }
 
+TEST(GenericWorker, addWheelTask) {
+    GenericWorker worker;
+    ASSERT_TRUE(worker.start());
+    {
+        folly::Baton<> baton;
+        size_t elapsed = 0;
+        time::Duration clock;
+        worker.addWheelTask(50, [&] () {
+            elapsed = clock.elapsedInUSec() / 1000;
+            baton.post();
+        });
+        baton.wait();
+        // Never early, and no more than a tick late
+        ASSERT_GE(elapsed, 50);
+        ASSERT_LE(elapsed, 50 + 10 + 10);
+    }
+    // Rescheduling from the worker thread
+    {
+        folly::Baton<> baton;
+        auto counter = 0UL;
+        std::function<void()> cb = [&] () {
+            if (++counter == 3) {
+                baton.post();
+                return;
+            }
+            worker.addWheelTask(20, cb);
+        };
+        time::Duration clock;
+        worker.addWheelTask(20, cb);
+        baton.wait();
+        ASSERT_GE(clock.elapsedInUSec() / 1000, 60);
+        ASSERT_EQ(3, counter);
+    }
+}
+
+TEST(GenericWorker, addRepeatWheelTask) {
+    GenericWorker worker;
+    ASSERT_TRUE(worker.start());
+    {
+        auto counter = 0UL;
+        auto cb = [&] () {
+            counter++;
+        };
+        worker.addRepeatWheelTask(50, cb);
+        ::usleep(185 * 1000);
+        ASSERT_EQ(3, counter);
+    }
+}
+
+TEST(GenericWorker, purgeWheelTask) {
+    GenericWorker worker;
+    ASSERT_TRUE(worker.start());
+    {
+        auto counter = 0UL;
+        auto cb = [&] () {
+            counter++;
+        };
+        auto id = worker.addRepeatWheelTask(50, cb);
+        ::usleep(130 * 1000);
+        worker.purgeWheelTask(id);
+        ::usleep(60 * 1000);
+        ASSERT_EQ(2, counter);
+    }
+    // Purge a oneshot task before it is due
+    {
+        auto counter = 0UL;
+        auto id = worker.addWheelTask(50, [&] () { counter++; });
+        worker.purgeWheelTask(id);
+        ::usleep(80 * 1000);
+        ASSERT_EQ(0, counter);
+    }
+}
+
 }   // namespace thread
 }   // namespace nebula
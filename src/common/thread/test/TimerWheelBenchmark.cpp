@@ -0,0 +1,93 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <folly/Benchmark.h>
+#include <folly/synchronization/Baton.h>
+#include "thread/GenericThreadPool.h"
+
+/**
+ * Compare the libevent timers and the timer wheel of GenericThreadPool, with one timer
+ * for each of 10k partitions, like the status polling of raft.
+ * */
+
+using nebula::thread::GenericThreadPool;
+
+static constexpr size_t kParts = 10000;
+static constexpr size_t kThreads = 4;
+static std::unique_ptr<GenericThreadPool> pool;
+
+// Wait until all the workers have handled the tasks added so far
+static void drain() {
+    std::vector<folly::SemiFuture<folly::Unit>> futures;
+    for (auto i = 0UL; i < kThreads; i++) {
+        futures.emplace_back(pool->addTask([] {}));
+    }
+    for (auto &future : futures) {
+        std::move(future).get();
+    }
+}
+
+void addAndPurge(size_t iters, bool wheel) {
+    std::vector<uint64_t> ids(kParts);
+    for (auto iter = 0UL; iter < iters; iter++) {
+        for (auto i = 0UL; i < kParts; i++) {
+            if (wheel) {
+                ids[i] = pool->addRepeatWheelTask(1000, [] {});
+            } else {
+                ids[i] = pool->addRepeatTask(1000, [] {});
+            }
+        }
+        for (auto i = 0UL; i < kParts; i++) {
+            if (wheel) {
+                pool->purgeWheelTask(ids[i]);
+            } else {
+                pool->purgeTimerTask(ids[i]);
+            }
+        }
+        drain();
+    }
+}
+
+// Both include the delay of 20ms, the difference is the overhead of the timers
+void fire(size_t iters, bool wheel) {
+    for (auto iter = 0UL; iter < iters; iter++) {
+        std::atomic<size_t> fired{0};
+        folly::Baton<> baton;
+        auto cb = [&] {
+            if (++fired == kParts) {
+                baton.post();
+            }
+        };
+        for (auto i = 0UL; i < kParts; i++) {
+            if (wheel) {
+                pool->addWheelTask(20, cb);
+            } else {
+                pool->addDelayTask(20, cb);
+            }
+        }
+        baton.wait();
+    }
+}
+
+BENCHMARK_NAMED_PARAM(addAndPurge, libevent_10k_parts, false)
+BENCHMARK_RELATIVE_NAMED_PARAM(addAndPurge, wheel_10k_parts, true)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(fire, libevent_10k_parts, false)
+BENCHMARK_RELATIVE_NAMED_PARAM(fire, wheel_10k_parts, true)
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+
+    pool = std::make_unique<GenericThreadPool>();
+    CHECK(pool->start(kThreads, "timer-bm"));
+    folly::runBenchmarks();
+    pool->stop();
+    pool->wait();
+    return 0;
+}
@@ -0,0 +1,134 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "thread/TimerWheel.h"
+
+namespace nebula {
+namespace thread {
+
+TEST(TimerWheel, FireOnTime) {
+    TimerWheel wheel;
+    std::vector<uint64_t> delays = {1, 2, 255, 256, 257, 300, 65535, 65536, 65537,
+                                    100000, (1UL << 24) - 1, (1UL << 24) + 3};
+    std::unordered_map<uint64_t, uint64_t> fired;
+    for (auto i = 0UL; i < delays.size(); i++) {
+        wheel.add(i, delays[i], 0, [&wheel, &fired, i] {
+            fired.emplace(i, wheel.now());
+        });
+    }
+    ASSERT_EQ(delays.size(), wheel.size());
+    ASSERT_EQ(0, wheel.advanceTo(0));
+
+    // Advance tick by tick
+    uint64_t last = delays.back();
+    for (auto tick = 1UL; tick <= last; tick++) {
+        wheel.advanceTo(tick);
+    }
+    ASSERT_TRUE(wheel.empty());
+    ASSERT_EQ(delays.size(), fired.size());
+    for (auto i = 0UL; i < delays.size(); i++) {
+        EXPECT_EQ(delays[i], fired[i]) << "Timer " << i;
+    }
+}
+
+TEST(TimerWheel, FireInBatch) {
+    TimerWheel wheel(1000);
+    auto count = 0UL;
+    for (auto i = 0UL; i < 10000; i++) {
+        wheel.add(i, i % 500 + 1, 0, [&count] {
+            count++;
+        });
+    }
+    ASSERT_EQ(0, wheel.advanceTo(1000));
+    // Jump over several ticks at once
+    ASSERT_EQ(200 * 20, wheel.advanceTo(1200));
+    ASSERT_EQ(200 * 20, count);
+    ASSERT_EQ(300 * 20, wheel.advanceTo(2000));
+    ASSERT_EQ(10000, count);
+    ASSERT_TRUE(wheel.empty());
+    // Nothing to fire, the clock just moves on
+    ASSERT_EQ(0, wheel.advanceTo(1UL << 40));
+    ASSERT_EQ(1UL << 40, wheel.now());
+}
+
+TEST(TimerWheel, Overflow) {
+    // Start right before the range of the highest level wraps around
+    auto start = (1UL << 32) - 10;
+    TimerWheel wheel(start);
+    std::vector<uint64_t> fired;
+    wheel.add(0, 5, 0, [&] { fired.emplace_back(wheel.now()); });
+    wheel.add(1, 20, 0, [&] { fired.emplace_back(wheel.now()); });
+    wheel.add(2, 300, 0, [&] { fired.emplace_back(wheel.now()); });
+    for (auto tick = start + 1; tick <= start + 300; tick++) {
+        wheel.advanceTo(tick);
+    }
+    ASSERT_EQ((std::vector<uint64_t>{start + 5, start + 20, start + 300}), fired);
+}
+
+TEST(TimerWheel, Repeat) {
+    TimerWheel wheel;
+    std::vector<uint64_t> fired;
+    wheel.add(1, 5, 100, [&] { fired.emplace_back(wheel.now()); });
+    wheel.advanceTo(400);
+    ASSERT_EQ((std::vector<uint64_t>{5, 105, 205, 305}), fired);
+    ASSERT_EQ(1, wheel.size());
+    ASSERT_TRUE(wheel.cancel(1));
+    ASSERT_FALSE(wheel.cancel(1));
+    wheel.advanceTo(1000);
+    ASSERT_EQ(4, fired.size());
+    ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, Cancel) {
+    TimerWheel wheel;
+    auto count = 0UL;
+    for (auto i = 0UL; i < 100; i++) {
+        wheel.add(i, 10 + i * 1000, 0, [&count] { count++; });
+    }
+    // Cancel every other timer, from all levels
+    for (auto i = 0UL; i < 100; i += 2) {
+        ASSERT_TRUE(wheel.cancel(i));
+    }
+    ASSERT_FALSE(wheel.cancel(1000));
+    ASSERT_EQ(50, wheel.size());
+    for (auto tick = 1UL; tick <= 100 * 1000; tick++) {
+        wheel.advanceTo(tick);
+    }
+    ASSERT_EQ(50, count);
+    ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, ModifyInCallback) {
+    TimerWheel wheel;
+    std::vector<std::string> fired;
+    // A repeated timer cancelling itself
+    auto repeats = 0;
+    wheel.add(1, 1, 1, [&] {
+        if (++repeats == 3) {
+            wheel.cancel(1);
+        }
+    });
+    // A timer cancelling another one due in the same tick
+    wheel.add(2, 5, 0, [&] {
+        fired.emplace_back("2");
+        wheel.cancel(3);
+    });
+    wheel.add(3, 5, 0, [&] { fired.emplace_back("3"); });
+    // A timer adding a new one
+    wheel.add(4, 6, 0, [&] {
+        fired.emplace_back("4");
+        wheel.add(5, 1, 0, [&] { fired.emplace_back("5"); });
+    });
+    wheel.advanceTo(100);
+    ASSERT_EQ(3, repeats);
+    ASSERT_EQ((std::vector<std::string>{"2", "4", "5"}), fired);
+    ASSERT_TRUE(wheel.empty());
+}
+
+}   // namespace thread
+}   // namespace nebula
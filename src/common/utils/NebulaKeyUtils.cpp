@@ -44,6 +44,17 @@ std::string NebulaKeyUtils::edgeKey(PartitionID partId,
     return key;
 }
 
+// static
+std::string NebulaKeyUtils::degreeKey(PartitionID partId, VertexID vId, EdgeType type) {
+    int32_t item = (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kDegree);
+    std::string key;
+    key.reserve(kDegreeLen);
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
+       .append(reinterpret_cast<const char*>(&vId), sizeof(VertexID))
+       .append(reinterpret_cast<const char*>(&type), sizeof(EdgeType));
+    return key;
+}
+
 // static
 std::string NebulaKeyUtils::systemCommitKey(PartitionID partId) {
     int32_t item = (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kSystem);
@@ -223,6 +234,41 @@ std::string NebulaKeyUtils::edgePrefix(PartitionID partId, VertexID vId) {
     return key;
 }
 
+// static
+std::string NebulaKeyUtils::vertexRangeEnd(PartitionID partId, VertexID vId) {
+    // Every key of the vertex is at most kEdgeLen bytes, so a suffix of 0xFF
+    // longer than the rest of the key is greater than all of them.
+    auto key = vertexPrefix(partId, vId);
+    key.append(kEdgeLen - key.size() + 1, '\xFF');
+    return key;
+}
+
+// static
+std::string NebulaKeyUtils::dataRangeEnd(PartitionID partId) {
+    auto key = prefix(partId);
+    key.append(kEdgeLen - key.size() + 1, '\xFF');
+    return key;
+}
+
+// static
+std::string NebulaKeyUtils::degreePrefix(PartitionID partId, VertexID vId) {
+    int32_t item = (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kDegree);
+    std::string key;
+    key.reserve(sizeof(PartitionID) + sizeof(VertexID));
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
+       .append(reinterpret_cast<const char*>(&vId), sizeof(VertexID));
+    return key;
+}
+
+// static
+std::string NebulaKeyUtils::degreePrefix(PartitionID partId) {
+    int32_t item = (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kDegree);
+    std::string key;
+    key.reserve(sizeof(PartitionID));
+    key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+    return key;
+}
+
 // static
 std::string NebulaKeyUtils::systemPrefix() {
     int8_t type = static_cast<uint32_t>(NebulaKeyType::kSystem);
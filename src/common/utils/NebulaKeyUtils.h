@@ -22,6 +22,9 @@ namespace nebula {
  * EdgeKeyUtils:
  * type(1) + partId(3) + srcId(8) + edgeType(4) + edgeRank(8) + dstId(8) + version(8)
  *
+ * DegreeKeyUtils:
+ * type(1) + partId(3) + vertexId(8) + edgeType(4)
+ *
  * */
 
 enum class NebulaKeyType : uint32_t {
@@ -29,6 +32,7 @@ enum class NebulaKeyType : uint32_t {
     kIndex             = 0x00000002,
     kUUID              = 0x00000003,
     kSystem            = 0x00000004,
+    kDegree            = 0x00000005,
 };
 
 enum class NebulaSystemKeyType : uint32_t {
@@ -62,6 +66,12 @@ public:
                                EdgeType type, EdgeRanking rank,
                                VertexID dstId, EdgeVersion ev);
 
+    /**
+     * Generate the degree counter key of the vertex for the edgeType,
+     * the direction is told by the sign of the edgeType.
+     * */
+    static std::string degreeKey(PartitionID partId, VertexID vId, EdgeType type);
+
     static std::string systemCommitKey(PartitionID partId);
 
     static std::string systemPartKey(PartitionID partId);
@@ -98,12 +108,31 @@ public:
 
     static std::string edgePrefix(PartitionID partId, VertexID vId);
 
+    /**
+     * The range [vertexPrefix(partId, vId), vertexRangeEnd(partId, vId)) covers
+     * all tags and edges (including all versions) of the vertex.
+     * */
+    static std::string vertexRangeEnd(PartitionID partId, VertexID vId);
+
+    /**
+     * The range [prefix(partId), dataRangeEnd(partId)) covers all tags and edges
+     * of the part.
+     * */
+    static std::string dataRangeEnd(PartitionID partId);
+
     static std::string edgePrefix(PartitionID partId,
                                   VertexID srcId,
                                   EdgeType type,
                                   EdgeRanking rank,
                                   VertexID dstId);
 
+    /**
+     * Prefix for all degree counters of the vertex
+     * */
+    static std::string degreePrefix(PartitionID partId, VertexID vId);
+
+    static std::string degreePrefix(PartitionID partId);
+
     static std::string systemPrefix();
 
     static std::string prefix(PartitionID partId, VertexID src, EdgeType type,
@@ -166,6 +195,21 @@ public:
         return etype & kTagEdgeMask;
     }
 
+    static bool isDegree(const folly::StringPiece& rawKey) {
+        if (rawKey.size() != kDegreeLen) {
+            return false;
+        }
+        constexpr int32_t len = static_cast<int32_t>(sizeof(NebulaKeyType));
+        auto type = readInt<uint32_t>(rawKey.data(), len) & kTypeMask;
+        return static_cast<uint32_t>(NebulaKeyType::kDegree) == type;
+    }
+
+    static EdgeType getDegreeEdgeType(const folly::StringPiece& rawKey) {
+        CHECK_EQ(rawKey.size(), kDegreeLen);
+        auto offset = sizeof(PartitionID) + sizeof(VertexID);
+        return readInt<EdgeType>(rawKey.data() + offset, sizeof(EdgeType));
+    }
+
     static bool isSystemCommit(const folly::StringPiece& rawKey) {
         if (rawKey.size() != kSystemLen) {
             return false;
@@ -503,6 +547,9 @@ private:
                                       + sizeof(EdgeType) + sizeof(VertexID)
                                       + sizeof(EdgeRanking) + sizeof(EdgeVersion);
 
+    static constexpr int32_t kDegreeLen = sizeof(PartitionID) + sizeof(VertexID)
+                                        + sizeof(EdgeType);
+
     static constexpr int32_t kVertexIndexLen = sizeof(PartitionID) + sizeof(IndexID)
                                                + sizeof(VertexID);
 
@@ -41,6 +41,40 @@ TEST(NebulaKeyUtilsTest, SimpleTest) {
     ASSERT_TRUE(NebulaKeyUtils::isUUIDKey(uuidKey));
 }
 
+TEST(NebulaKeyUtilsTest, VertexRangeTest) {
+    PartitionID partId = 15;
+    VertexID vId = 1001L;
+    auto start = NebulaKeyUtils::vertexPrefix(partId, vId);
+    auto end = NebulaKeyUtils::vertexRangeEnd(partId, vId);
+
+    auto inRange = [&] (const std::string& key) {
+        return start <= key && key < end;
+    };
+    EXPECT_TRUE(inRange(NebulaKeyUtils::vertexKey(partId, vId, 1, 0)));
+    EXPECT_TRUE(inRange(NebulaKeyUtils::vertexKey(partId, vId, 0x7FFFFFFF, -1)));
+    EXPECT_TRUE(inRange(NebulaKeyUtils::edgeKey(partId, vId, 101, 0, -1L, -1L)));
+    EXPECT_TRUE(inRange(NebulaKeyUtils::edgeKey(partId, vId, -1, -1L, -1L, -1L)));
+    EXPECT_FALSE(inRange(NebulaKeyUtils::vertexKey(partId, vId + 1, 1, 0)));
+    EXPECT_FALSE(inRange(NebulaKeyUtils::edgeKey(partId, vId - 1, 101, 0, vId, 0)));
+    EXPECT_FALSE(inRange(NebulaKeyUtils::edgeKey(partId + 1, vId, 101, 0, vId, 0)));
+}
+
+TEST(NebulaKeyUtilsTest, DataRangeTest) {
+    PartitionID partId = 15;
+    auto start = NebulaKeyUtils::prefix(partId);
+    auto end = NebulaKeyUtils::dataRangeEnd(partId);
+
+    auto inRange = [&] (const std::string& key) {
+        return start <= key && key < end;
+    };
+    EXPECT_TRUE(inRange(NebulaKeyUtils::vertexKey(partId, 0, 1, 0)));
+    EXPECT_TRUE(inRange(NebulaKeyUtils::vertexKey(partId, -1L, 0x7FFFFFFF, -1)));
+    EXPECT_TRUE(inRange(NebulaKeyUtils::edgeKey(partId, -1L, -1, -1L, -1L, -1L)));
+    EXPECT_FALSE(inRange(NebulaKeyUtils::vertexKey(partId + 1, 0, 1, 0)));
+    EXPECT_FALSE(inRange(NebulaKeyUtils::indexPrefix(partId, 1)));
+    EXPECT_FALSE(inRange(NebulaKeyUtils::degreePrefix(partId)));
+}
+
 template<class T>
 VariantType getVal(T v) {
     return v;
@@ -16,6 +16,8 @@
 #include <thrift/lib/cpp2/server/ThriftServer.h>
 #include "graph/GraphService.h"
 #include "graph/GraphFlags.h"
+#include "graph/GraphHttpStorageStatsHandler.h"
+#include "webservice/Router.h"
 #include "webservice/WebService.h"
 
 using nebula::Status;
@@ -98,6 +100,9 @@ int main(int argc, char *argv[]) {
 
     LOG(INFO) << "Starting Graph HTTP Service";
     auto webSvc = std::make_unique<nebula::WebService>();
+    webSvc->router().get("/storage_stats").handler([](nebula::web::PathParams&&) {
+        return new nebula::graph::GraphHttpStorageStatsHandler();
+    });
     status = webSvc->start();
     if (!status.ok()) {
         return EXIT_FAILURE;
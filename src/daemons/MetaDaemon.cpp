@@ -17,7 +17,6 @@
 #include "process/ProcessUtils.h"
 #include "hdfs/HdfsHelper.h"
 #include "hdfs/HdfsCommandHelper.h"
-#include "thread/GenericThreadPool.h"
 #include "kvstore/PartManager.h"
 #include "meta/ClusterIdMan.h"
 #include "kvstore/NebulaStore.h"
@@ -40,7 +39,6 @@ DEFINE_string(meta_server_addrs,
               "If empty, it means it's a single node");
 DEFINE_string(local_ip, "", "Local ip specified for NetworkUtils::getLocalIP");
 DEFINE_int32(num_io_threads, 16, "Number of IO threads");
-DEFINE_int32(meta_http_thread_num, 3, "Number of meta daemon's http thread");
 DEFINE_int32(num_worker_threads, 32, "Number of workers");
 
 DEFINE_string(pid_file, "pids/nebula-metad.pid", "File to hold the process id");
@@ -136,18 +134,17 @@ std::unique_ptr<nebula::kvstore::KVStore> initKV(std::vector<nebula::HostAddr> p
 
 Status initWebService(nebula::WebService* svc,
                       nebula::kvstore::KVStore* kvstore,
-                      nebula::hdfs::HdfsCommandHelper* helper,
-                      nebula::thread::GenericThreadPool* pool) {
+                      nebula::hdfs::HdfsCommandHelper* helper) {
     LOG(INFO) << "Starting Meta HTTP Service";
     auto& router = svc->router();
-    router.get("/download-dispatch").handler([kvstore, helper, pool](PathParams&&) {
+    router.get("/download-dispatch").handler([kvstore, helper](PathParams&&) {
         auto handler = new nebula::meta::MetaHttpDownloadHandler();
-        handler->init(kvstore, helper, pool);
+        handler->init(kvstore, helper);
         return handler;
     });
-    router.get("/ingest-dispatch").handler([kvstore, pool](PathParams&&) {
+    router.get("/ingest-dispatch").handler([kvstore](PathParams&&) {
         auto handler = new nebula::meta::MetaHttpIngestHandler();
-        handler->init(kvstore, pool);
+        handler->init(kvstore);
         return handler;
     });
     router.get("/replace").handler([kvstore](PathParams &&) {
@@ -222,11 +219,9 @@ int main(int argc, char *argv[]) {
 
     LOG(INFO) << "Start http service";
     auto helper = std::make_unique<nebula::hdfs::HdfsCommandHelper>();
-    auto pool = std::make_unique<nebula::thread::GenericThreadPool>();
-    pool->start(FLAGS_meta_http_thread_num, "http thread pool");
 
     auto webSvc = std::make_unique<nebula::WebService>();
-    status = initWebService(webSvc.get(), gKVStore.get(), helper.get(), pool.get());
+    status = initWebService(webSvc.get(), gKVStore.get(), helper.get());
     if (!status.ok()) {
         LOG(ERROR) << "Init web service failed: " << status;
         return EXIT_FAILURE;
@@ -21,6 +21,22 @@ enum class ResultType {
 };
 
 
+// The encodings of a row, RowReader reads all of them
+enum class RowFormat : uint8_t {
+    // The fields are written one after another, integers and string lengths as varints,
+    // with the offset of every 16 fields in the header
+    V1 = 1,
+    // Every field takes an 8-byte slot at a fixed offset, a string slot holds the offset
+    // and the length of the string in the tail, and the header has a null bitmap
+    V2 = 2,
+};
+
+// The bit in the first byte of a row telling it is in RowFormat::V2
+constexpr uint8_t kRowFormatV2Flag = 0x08;
+// The size of a field in RowFormat::V2
+constexpr int32_t kRowSlotSize = 8;
+
+
 using FieldValue = boost::variant<bool, int64_t, float, double, std::string>;
 #define VALUE_TYPE_BOOL 0
 #define VALUE_TYPE_INT 1
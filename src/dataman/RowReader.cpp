@@ -220,6 +220,10 @@ bool RowReader::processHeader(folly::StringPiece row) {
 
     DCHECK(!!schema_) << "A schema must be provided";
 
+    if (*it & kRowFormatV2Flag) {
+        return processHeaderV2(row);
+    }
+
     // The last three bits indicate the number of bytes for offsets
     // The first three bits indicate the number of bytes for the
     // schena version. If the number is zero, no schema version
@@ -260,6 +264,23 @@ bool RowReader::processHeader(folly::StringPiece row) {
 }
 
 
+bool RowReader::processHeaderV2(folly::StringPiece row) {
+    format_ = RowFormat::V2;
+    int32_t verBytes = *reinterpret_cast<const uint8_t*>(row.begin()) >> 5;
+    int64_t numFields = schema_->getNumFields();
+    int32_t bitmapBytes = (numFields + 7) >> 3;
+    // The slots are aligned to 8 bytes
+    headerLen_ = (1 + verBytes + bitmapBytes + kRowSlotSize - 1) / kRowSlotSize * kRowSlotSize;
+    if (headerLen_ + numFields * kRowSlotSize > static_cast<int64_t>(row.size())) {
+        // Data is too short
+        LOG(ERROR) << "Row data is too short";
+        return false;
+    }
+    nullBitmap_.reset(row.begin() + 1 + verBytes, bitmapBytes);
+    return true;
+}
+
+
 int32_t RowReader::numFields() const noexcept {
     return schema_->getNumFields();
 }
@@ -274,6 +295,9 @@ int64_t RowReader::skipToNext(int64_t index, int64_t offset) const noexcept {
     const cpp2::ValueType& vType = schema_->getFieldType(index);
     CHECK(vType != CommonConstants::kInvalidValueType())
         << "No schema for the index " << index;
+    if (format_ == RowFormat::V2) {
+        return offset + kRowSlotSize;
+    }
     if (offsets_[index + 1] >= 0) {
         return offsets_[index + 1];
     }
@@ -344,6 +368,9 @@ int64_t RowReader::skipToField(int64_t index) const noexcept {
         // Index is out of range
         return static_cast<int64_t>(ResultType::E_INDEX_OUT_OF_RANGE);
     }
+    if (format_ == RowFormat::V2) {
+        return index * kRowSlotSize;
+    }
 
     int64_t base = index >> 4;
     const auto& blockOffset = blockOffsets_[base];
@@ -372,7 +399,7 @@ int32_t RowReader::readFloat(int64_t offset, float& v) const noexcept {
 
     memcpy(reinterpret_cast<char*>(&v), &(data_[offset]), sizeof(float));
 
-    return sizeof(float);
+    return fixedSize(sizeof(float));
 }
 
 
@@ -383,12 +410,26 @@ int32_t RowReader::readDouble(int64_t offset, double& v) const noexcept {
 
     memcpy(reinterpret_cast<char*>(&v), &(data_[offset]), sizeof(double));
 
-    return sizeof(double);
+    return fixedSize(sizeof(double));
 }
 
 
 int32_t RowReader::readString(int64_t offset, folly::StringPiece& v)
         const noexcept {
+    if (format_ == RowFormat::V2) {
+        if (offset + kRowSlotSize > static_cast<int64_t>(data_.size())) {
+            return static_cast<int32_t>(ResultType::E_DATA_INVALID);
+        }
+        uint32_t slot[2];
+        memcpy(reinterpret_cast<char*>(slot), &(data_[offset]), sizeof(slot));
+        // The strings follow the slots
+        int64_t strOffset = schema_->getNumFields() * kRowSlotSize + slot[0];
+        if (strOffset + slot[1] > static_cast<int64_t>(data_.size())) {
+            return static_cast<int32_t>(ResultType::E_DATA_INVALID);
+        }
+        v = data_.subpiece(strOffset, slot[1]);
+        return kRowSlotSize;
+    }
     int64_t strLen;
     int32_t intLen = readInteger(offset, strLen);
     CHECK_GT(intLen, 0) << "Invalid string length";
@@ -409,7 +450,7 @@ int32_t RowReader::readInt64(int64_t offset, int64_t& v) const noexcept {
     // VID is stored in Little Endian
     memcpy(reinterpret_cast<char*>(&v), &(data_[offset]), sizeof(int64_t));
 
-    return sizeof(int64_t);
+    return fixedSize(sizeof(int64_t));
 }
 
 
@@ -423,7 +464,7 @@ ResultType RowReader::getBool(int64_t index, int64_t& offset, bool& v)
     switch (schema_->getFieldType(index).get_type()) {
         case cpp2::SupportedType::BOOL: {
             v = intToBool(data_[offset]);
-            offset++;
+            offset += fixedSize(1);
             break;
         }
         case cpp2::SupportedType::INT:
@@ -578,6 +619,22 @@ ResultType RowReader::getVid(int64_t index, int64_t& offset, int64_t& v)
 }
 
 
+bool RowReader::isNull(const folly::StringPiece name) const noexcept {
+    int64_t index = schema_->getFieldIndex(name);
+    return index >= 0 && isNull(index);
+}
+
+
+bool RowReader::isNull(int64_t index) const noexcept {
+    if (format_ != RowFormat::V2
+            || index < 0
+            || index >= static_cast<int64_t>(schema_->getNumFields())) {
+        return false;
+    }
+    return nullBitmap_[index >> 3] & (1 << (index & 0x07));
+}
+
+
 RowReader::Iterator RowReader::begin() const noexcept {
     return Iterator(this, schema_->getNumFields(), 0);
 }
@@ -254,6 +254,15 @@ public:
     SchemaVer schemaVer() const noexcept;
     int32_t numFields() const noexcept;
 
+    RowFormat format() const noexcept {
+        return format_;
+    }
+
+    // Only the rows in RowFormat::V2 have nulls, the getters return the default
+    // values of the null fields
+    bool isNull(const folly::StringPiece name) const noexcept;
+    bool isNull(int64_t index) const noexcept;
+
     Iterator begin() const noexcept;
     Iterator end() const noexcept;
 
@@ -346,6 +355,9 @@ private:
     std::shared_ptr<const meta::SchemaProviderIf> schema_;
 
     folly::StringPiece data_;
+    RowFormat format_ = RowFormat::V1;
+    // The null bitmap in RowFormat::V2
+    folly::StringPiece nullBitmap_;
     int32_t headerLen_ = 0;
     int32_t numBytesForOffset_ = 0;
     // Block offet value is composed by two integers. The first one is
@@ -363,6 +375,14 @@ private:
     // Returns false when the row data is invalid
     bool processHeader(folly::StringPiece row);
 
+    // Process the header of RowFormat::V2, which has no offsets but the null bitmap
+    bool processHeaderV2(folly::StringPiece row);
+
+    // The number of bytes the fixed-size value of the given size takes
+    int32_t fixedSize(int32_t size) const noexcept {
+        return format_ == RowFormat::V2 ? kRowSlotSize : size;
+    }
+
     // Process the block offsets (each block contains certain number of fields)
     // Returns false when the row data is invalid
     bool processBlockOffsets(folly::StringPiece row, int32_t verBytes);
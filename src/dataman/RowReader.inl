@@ -60,6 +60,15 @@ RowReader::getInt(int64_t index, T& v) const noexcept {
 template<typename T>
 typename std::enable_if<std::is_integral<T>::value, int32_t>::type
 RowReader::readInteger(int64_t offset, T& v) const noexcept {
+    if (format_ == RowFormat::V2) {
+        if (offset + kRowSlotSize > static_cast<int64_t>(data_.size())) {
+            return static_cast<int32_t>(ResultType::E_DATA_INVALID);
+        }
+        int64_t val;
+        memcpy(reinterpret_cast<char*>(&val), &(data_[offset]), sizeof(int64_t));
+        v = static_cast<T>(val);
+        return kRowSlotSize;
+    }
     const uint8_t* start = reinterpret_cast<const uint8_t*>(&(data_[offset]));
     folly::ByteRange range(start, data_.size() - offset);
 
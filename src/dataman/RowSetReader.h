@@ -26,6 +26,12 @@ public:
 
         Iterator& operator++() noexcept;
 
+        // The encoded row with its length ahead, which could be copied
+        // into another row set of the same schema as is
+        folly::StringPiece encoded() const noexcept {
+            return data_.subpiece(offset_, len_);
+        }
+
         operator bool() const noexcept;
         bool operator==(const Iterator& rhs);
 
@@ -38,8 +38,8 @@ void RowSetWriter::addRow(const std::string& data) {
     data_.append(data);
 }
 
-void RowSetWriter::addAll(const std::string& data) {
-    data_.append(data);
+void RowSetWriter::addAll(folly::StringPiece data) {
+    data_.append(data.data(), data.size());
 }
 }  // namespace nebula
 
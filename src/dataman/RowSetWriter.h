@@ -42,7 +42,7 @@ public:
     // Append the encoded row data
     void addRow(const std::string& data);
     // Copy existed rows
-    void addAll(const std::string& data);
+    void addAll(folly::StringPiece data);
 
 private:
     std::shared_ptr<const meta::SchemaProviderIf> schema_;
@@ -38,9 +38,20 @@ StatusOr<std::string> RowUpdater::encode() const noexcept {
 }
 
 Status RowUpdater::encodeTo(std::string& encoded) const noexcept {
-    RowWriter writer(schema_);
+    // Keep the format of the original row
+    RowWriter writer(schema_, reader_ ? reader_->format() : RowWriter::defaultFormat());
     auto it = schema_->begin();
     while (static_cast<bool>(it)) {
+        if (reader_ && reader_->isNull(it->getName())) {
+            auto name = it->getName();
+            auto hash = SpookyHashV2::Hash64(name, strlen(name), 0);
+            if (updatedFields_.find(hash) == updatedFields_.end()) {
+                // Keep the field null
+                writer << RowWriter::Skip(1);
+                ++it;
+                continue;
+            }
+        }
         Status ret = Status::OK();
         switch (it->getType().get_type()) {
             case cpp2::SupportedType::BOOL: {
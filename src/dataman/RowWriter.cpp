@@ -7,14 +7,19 @@
 #include "base/Base.h"
 #include "dataman/RowWriter.h"
 
+DEFINE_int32(row_format_version, 1,
+             "The format of the rows written, 1 or 2. Both are readable, so only turn to 2 "
+             "when all the graphd and storaged are able to read it");
+
 namespace nebula {
 
 using cpp2::Schema;
 using cpp2::SupportedType;
 using meta::SchemaProviderIf;
 
-RowWriter::RowWriter(std::shared_ptr<const SchemaProviderIf> schema)
-        : schema_(std::move(schema)) {
+RowWriter::RowWriter(std::shared_ptr<const SchemaProviderIf> schema, RowFormat format)
+        : schema_(std::move(schema))
+        , format_(format) {
     if (!schema_) {
         // Need to create a new schema
         schemaWriter_.reset(new SchemaWriter());
@@ -23,7 +28,16 @@ RowWriter::RowWriter(std::shared_ptr<const SchemaProviderIf> schema)
 }
 
 
+// static
+RowFormat RowWriter::defaultFormat() {
+    return FLAGS_row_format_version == 2 ? RowFormat::V2 : RowFormat::V1;
+}
+
+
 int64_t RowWriter::size() const noexcept {
+    if (format_ == RowFormat::V2) {
+        return headerSizeV2() + cord_.size() + strings_.size();
+    }
     auto offsetBytes = calcOccupiedBytes(cord_.size());
     SchemaVer verBytes = 0;
     if (schema_->getVersion() > 0) {
@@ -39,7 +53,11 @@ int64_t RowWriter::size() const noexcept {
 std::string RowWriter::encode() noexcept {
     std::string encoded;
     // Reserve enough space so resize will not happen
-    encoded.reserve(sizeof(int64_t) * blockOffsets_.size() + cord_.size() + 11);
+    if (format_ == RowFormat::V2) {
+        encoded.reserve(size() + kRowSlotSize * (schema_->getNumFields() - colNum_));
+    } else {
+        encoded.reserve(sizeof(int64_t) * blockOffsets_.size() + cord_.size() + 11);
+    }
     encodeTo(encoded);
 
     return encoded;
@@ -50,6 +68,10 @@ void RowWriter::encodeTo(std::string& encoded) noexcept {
     if (!schemaWriter_) {
         operator<<(Skip(schema_->getNumFields() - colNum_));
     }
+    if (format_ == RowFormat::V2) {
+        encodeV2To(encoded);
+        return;
+    }
 
     // Header information
     auto offsetBytes = calcOccupiedBytes(cord_.size());
@@ -75,6 +97,65 @@ void RowWriter::encodeTo(std::string& encoded) noexcept {
 }
 
 
+/**
+ * RowFormat::V2 is laid out as
+ *   header byte | schema version | null bitmap | padding | slots | strings
+ * The header byte has kRowFormatV2Flag set, and the number of bytes of the schema
+ * version in the first three bits as in V1. The slots start at a multiple of 8 from
+ * the beginning, there is one for each field, so the i-th field is at the offset i * 8
+ * from the first slot. A string slot holds two 32-bit integers, the offset of the
+ * string from the first string, and its length.
+ * */
+void RowWriter::encodeV2To(std::string& encoded) noexcept {
+    auto start = encoded.size();
+    char header = kRowFormatV2Flag;
+    SchemaVer ver = schema_->getVersion();
+    if (ver > 0) {
+        auto verBytes = calcOccupiedBytes(ver);
+        header |= verBytes << 5;
+        encoded.append(&header, 1);
+        // Schema version is stored in Little Endian
+        encoded.append(reinterpret_cast<char*>(&ver), verBytes);
+    } else {
+        encoded.append(&header, 1);
+    }
+
+    std::string bitmap((schema_->getNumFields() + 7) >> 3, '\0');
+    for (size_t i = 0; i < nulls_.size(); i++) {
+        if (nulls_[i]) {
+            bitmap[i >> 3] |= 1 << (i & 0x07);
+        }
+    }
+    encoded.append(bitmap);
+    encoded.append(headerSizeV2() - (encoded.size() - start), '\0');
+
+    cord_.appendTo(encoded);
+    encoded.append(strings_);
+}
+
+
+int64_t RowWriter::headerSizeV2() const noexcept {
+    int64_t size = 1 + ((schema_->getNumFields() + 7) >> 3);
+    if (schema_->getVersion() > 0) {
+        size += calcOccupiedBytes(schema_->getVersion());
+    }
+    // Align the slots to 8 bytes
+    return (size + kRowSlotSize - 1) / kRowSlotSize * kRowSlotSize;
+}
+
+
+void RowWriter::writeString(folly::StringPiece v) {
+    if (format_ == RowFormat::V1) {
+        writeInt(v.size());
+        cord_.write(v.data(), v.size());
+        return;
+    }
+    uint32_t slot[2] = {static_cast<uint32_t>(strings_.size()), static_cast<uint32_t>(v.size())};
+    cord_.write(reinterpret_cast<const char*>(slot), sizeof(slot));
+    strings_.append(v.data(), v.size());
+}
+
+
 Schema RowWriter::moveSchema() {
     if (schemaWriter_) {
         return schemaWriter_->moveSchema();
@@ -105,12 +186,12 @@ RowWriter& RowWriter::operator<<(bool v) noexcept {
 
     switch (type->get_type()) {
         case SupportedType::BOOL:
-            cord_ << v;
+            writeFixed(v);
             break;
         default:
             LOG(ERROR) << "Incompatible value type \"bool\"";
             // Output a default value
-            cord_ << false;
+            writeFixed(false);
             break;
     }
 
@@ -124,14 +205,14 @@ RowWriter& RowWriter::operator<<(float v) noexcept {
 
     switch (type->get_type()) {
         case SupportedType::FLOAT:
-            cord_ << v;
+            writeFixed(v);
             break;
         case SupportedType::DOUBLE:
-            cord_ << static_cast<double>(v);
+            writeFixed(static_cast<double>(v));
             break;
         default:
             LOG(ERROR) << "Incompatible value type \"float\"";
-            cord_ << static_cast<float>(0.0);
+            writeFixed(static_cast<float>(0.0));
             break;
     }
 
@@ -145,14 +226,14 @@ RowWriter& RowWriter::operator<<(double v) noexcept {
 
     switch (type->get_type()) {
         case SupportedType::FLOAT:
-            cord_ << static_cast<float>(v);
+            writeFixed(static_cast<float>(v));
             break;
         case SupportedType::DOUBLE:
-            cord_ << v;
+            writeFixed(v);
             break;
         default:
             LOG(ERROR) << "Incompatible value type \"double\"";
-            cord_ << static_cast<double>(0.0);
+            writeFixed(static_cast<double>(0.0));
             break;
     }
 
@@ -170,8 +251,7 @@ RowWriter& RowWriter::operator<<(folly::StringPiece v) noexcept {
 
     switch (type->get_type()) {
         case SupportedType::STRING: {
-            writeInt(v.size());
-            cord_.write(v.data(), v.size());
+            writeString(v);
             break;
         }
         default: {
@@ -219,10 +299,14 @@ RowWriter& RowWriter::operator<<(Skip&& skip) noexcept {
 
     int32_t skipTo = std::min(colNum_ + skip.toSkip_,
                               static_cast<int64_t>(schema_->getNumFields()));
+    if (format_ == RowFormat::V2) {
+        nulls_.resize(skipTo, false);
+        std::fill(nulls_.begin() + colNum_, nulls_.end(), true);
+    }
     for (int i = colNum_; i < skipTo; i++) {
         switch (schema_->getFieldType(i).get_type()) {
             case SupportedType::BOOL: {
-                cord_ << false;
+                writeFixed(false);
                 break;
             }
             case SupportedType::INT:
@@ -231,11 +315,11 @@ RowWriter& RowWriter::operator<<(Skip&& skip) noexcept {
                 break;
             }
             case SupportedType::FLOAT: {
-                cord_ << static_cast<float>(0.0);
+                writeFixed(static_cast<float>(0.0));
                 break;
             }
             case SupportedType::DOUBLE: {
-                cord_ << static_cast<double>(0.0);
+                writeFixed(static_cast<double>(0.0));
                 break;
             }
             case SupportedType::STRING: {
@@ -243,7 +327,7 @@ RowWriter& RowWriter::operator<<(Skip&& skip) noexcept {
                 break;
             }
             case SupportedType::VID: {
-                cord_ << static_cast<uint64_t>(0);
+                writeFixed(static_cast<uint64_t>(0));
                 break;
             }
             default: {
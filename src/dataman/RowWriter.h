@@ -9,6 +9,7 @@
 
 #include "base/Base.h"
 #include "base/ICord.h"
+#include "dataman/DataCommon.h"
 #include "dataman/SchemaWriter.h"
 
 namespace nebula {
@@ -54,7 +55,7 @@ public:
     };
 
     // Skip next few columns. Default values will be written for those
-    // fields
+    // fields, and they are marked as null in RowFormat::V2
     // This cannot be used if a schema is not provided
     struct Skip {
         friend class RowWriter;
@@ -66,7 +67,15 @@ public:
 public:
     explicit RowWriter(
         std::shared_ptr<const meta::SchemaProviderIf> schema
-            = std::shared_ptr<const meta::SchemaProviderIf>());
+            = std::shared_ptr<const meta::SchemaProviderIf>(),
+        RowFormat format = defaultFormat());
+
+    // The format given by FLAGS_row_format_version
+    static RowFormat defaultFormat();
+
+    RowFormat format() const {
+        return format_;
+    }
 
     // Encode into a binary array
     std::string encode() noexcept;
@@ -107,7 +116,13 @@ public:
 private:
     std::shared_ptr<const meta::SchemaProviderIf> schema_;
     std::shared_ptr<SchemaWriter> schemaWriter_;
+    RowFormat format_;
+    // The fields, they are the fixed slots in RowFormat::V2
     ICord<> cord_;
+    // The strings in RowFormat::V2
+    std::string strings_;
+    // The null fields in RowFormat::V2
+    std::vector<bool> nulls_;
 
     int64_t colNum_ = 0;
     std::unique_ptr<ColName> colName_;
@@ -120,6 +135,16 @@ private:
     typename std::enable_if<std::is_integral<T>::value>::type
     writeInt(T v);
 
+    // Write the value as it is, or into a slot in RowFormat::V2
+    template<typename T>
+    void writeFixed(T v);
+
+    void writeString(folly::StringPiece v);
+
+    void encodeV2To(std::string& encoded) noexcept;
+
+    int64_t headerSizeV2() const noexcept;
+
     // Calculate the number of bytes occupied (ignore the leading 0s)
     int64_t calcOccupiedBytes(uint64_t v) const noexcept;
 };
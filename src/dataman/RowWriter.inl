@@ -18,7 +18,7 @@ RowWriter::operator<<(T v) noexcept {
             break;
         }
         case cpp2::SupportedType::VID: {
-            cord_ << (uint64_t)v;
+            writeFixed((uint64_t)v);
             break;
         }
         default: {
@@ -37,11 +37,29 @@ RowWriter::operator<<(T v) noexcept {
 template<typename T>
 typename std::enable_if<std::is_integral<T>::value>::type
 RowWriter::writeInt(T v) {
+    if (format_ == RowFormat::V2) {
+        writeFixed(static_cast<int64_t>(v));
+        return;
+    }
     uint8_t buf[10];
     size_t len = folly::encodeVarint(v, buf);
     DCHECK_GT(len, 0UL);
     cord_.write(reinterpret_cast<const char*>(&buf[0]), len);
 }
 
+
+template<typename T>
+void RowWriter::writeFixed(T v) {
+    if (format_ == RowFormat::V1) {
+        cord_ << v;
+        return;
+    }
+    static_assert(sizeof(T) <= kRowSlotSize, "The value does not fit in a slot");
+    char slot[kRowSlotSize] = {0};
+    // Values are stored in Little Endian
+    memcpy(slot, &v, sizeof(T));
+    cord_.write(slot, kRowSlotSize);
+}
+
 }  // namespace nebula
 
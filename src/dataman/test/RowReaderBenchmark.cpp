@@ -21,6 +21,7 @@ auto schemaAllDoubles = std::make_shared<SchemaWriter>();
 auto schemaAllVids = std::make_shared<SchemaWriter>();
 auto schemaAllTimestamps = std::make_shared<SchemaWriter>();
 auto schemaMix = std::make_shared<SchemaWriter>();
+auto schemaWide = std::make_shared<SchemaWriter>();
 
 static std::string dataAllBools;        // NOLINT
 static std::string dataAllInts;         // NOLINT
@@ -29,6 +30,8 @@ static std::string dataAllStrings;      // NOLINT
 static std::string dataAllVids;         // NOLINT
 static std::string dataAllTimestamps;	// NOLINT
 static std::string dataMix;             // NOLINT
+static std::string dataWideV1;          // NOLINT
+static std::string dataWideV2;          // NOLINT
 
 
 void prepareSchema() {
@@ -85,6 +88,13 @@ void prepareSchema() {
              .appendCol("col30", nebula::cpp2::SupportedType::INT)
              .appendCol("col31", nebula::cpp2::SupportedType::INT)
              .appendCol("col32", nebula::cpp2::SupportedType::INT);
+
+    // 128 fields, all the eighth ones are integers, and the others are strings
+    for (int i = 0; i < 128; i++) {
+        schemaWide->appendCol(folly::stringPrintf("col%03d", i),
+                              i % 8 == 0 ? nebula::cpp2::SupportedType::INT
+                                         : nebula::cpp2::SupportedType::STRING);
+    }
 }
 
 
@@ -122,6 +132,45 @@ void prepareData() {
     dataAllVids = wVids.encode();
     dataAllTimestamps = wTimestamps.encode();
     dataMix = wMix.encode();
+
+    RowWriter wWideV1(schemaWide, nebula::RowFormat::V1);
+    RowWriter wWideV2(schemaWide, nebula::RowFormat::V2);
+    for (int i = 0; i < 128; i++) {
+        if (i % 8 == 0) {
+            wWideV1 << i;
+            wWideV2 << i;
+        } else {
+            wWideV1 << "Hello World";
+            wWideV2 << "Hello World";
+        }
+    }
+    dataWideV1 = wWideV1.encode();
+    dataWideV2 = wWideV2.encode();
+}
+
+
+// Read the integers of the wide row in a random order
+void readWide(const std::string& data, int32_t iters) {
+    for (int32_t i = 0; i < iters; i++) {
+        auto reader = RowReader::getRowReader(data, schemaWide);
+        int64_t val;
+        for (int j = 0; j < 16; j++) {
+            uint32_t idx = folly::Random::rand32(0, 16) * 8;
+            reader->getInt(idx, val);
+            folly::doNotOptimizeAway(val);
+        }
+    }
+}
+
+
+// Read the last field of the wide row only
+void readWideLast(const std::string& data, int32_t iters) {
+    for (int32_t i = 0; i < iters; i++) {
+        auto reader = RowReader::getRowReader(data, schemaWide);
+        folly::StringPiece val;
+        reader->getString(127, val);
+        folly::doNotOptimizeAway(val);
+    }
 }
 
 
@@ -285,6 +334,24 @@ BENCHMARK_DRAW_LINE();
 BENCHMARK(read_mix, iters) {
     readMix(iters);
 }
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(read_wide_rand_v1, iters) {
+    readWide(dataWideV1, iters);
+}
+BENCHMARK_RELATIVE(read_wide_rand_v2, iters) {
+    readWide(dataWideV2, iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(read_wide_last_v1, iters) {
+    readWideLast(dataWideV1, iters);
+}
+BENCHMARK_RELATIVE(read_wide_last_v2, iters) {
+    readWideLast(dataWideV2, iters);
+}
 /*************************
  * End of benchmarks
  ************************/
@@ -166,6 +166,43 @@ TEST(RowUpdater, withOrigin) {
 }
 
 
+TEST(RowUpdater, keepNulls) {
+    RowWriter writer(schema, nebula::RowFormat::V2);
+    writer << 123 << RowWriter::Skip(1) << "Hello" << RowWriter::Skip(1);
+    std::string encoded(writer.encode());
+
+    auto reader = RowReader::getRowReader(encoded, schema);
+    ASSERT_TRUE(reader->isNull("col2"));
+    RowUpdater updater(std::move(reader), schema);
+    EXPECT_EQ(ResultType::SUCCEEDED,
+              updater.setString("col4", "World"));
+    auto status = updater.encode();
+    ASSERT_TRUE(status.ok());
+    encoded = std::move(status).value();
+
+    reader = RowReader::getRowReader(encoded, schema);
+    EXPECT_FALSE(reader->isNull("col1"));
+    EXPECT_TRUE(reader->isNull("col2"));
+    EXPECT_FALSE(reader->isNull("col3"));
+    EXPECT_FALSE(reader->isNull("col4"));
+    for (auto col : {"col5", "col6", "col7", "col8", "col9"}) {
+        EXPECT_TRUE(reader->isNull(col));
+    }
+
+    int64_t iVal;
+    folly::StringPiece sVal;
+    EXPECT_EQ(ResultType::SUCCEEDED,
+              reader->getInt("col1", iVal));
+    EXPECT_EQ(123, iVal);
+    EXPECT_EQ(ResultType::SUCCEEDED,
+              reader->getInt("col2", iVal));
+    EXPECT_EQ(0, iVal);
+    EXPECT_EQ(ResultType::SUCCEEDED,
+              reader->getString("col4", sVal));
+    EXPECT_EQ("World", sVal);
+}
+
+
 TEST(RowUpdater, encodeWithAllFields) {
     RowUpdater updater(schema);
 
@@ -20,6 +20,7 @@ auto schemaAllDoubles = std::make_shared<SchemaWriter>();
 auto schemaAllVids = std::make_shared<SchemaWriter>();
 auto schemaAllTimestamps = std::make_shared<SchemaWriter>();
 auto schemaMix = std::make_shared<SchemaWriter>();
+auto schemaWide = std::make_shared<SchemaWriter>();
 
 void prepareSchema() {
     for (int i = 0; i < 32; i++) {
@@ -69,6 +70,34 @@ void prepareSchema() {
              .appendCol("col30", nebula::cpp2::SupportedType::INT)
              .appendCol("col31", nebula::cpp2::SupportedType::INT)
              .appendCol("col32", nebula::cpp2::SupportedType::INT);
+
+    // 128 fields of all types
+    std::vector<nebula::cpp2::SupportedType> types = {
+        nebula::cpp2::SupportedType::BOOL,
+        nebula::cpp2::SupportedType::INT,
+        nebula::cpp2::SupportedType::STRING,
+        nebula::cpp2::SupportedType::FLOAT,
+        nebula::cpp2::SupportedType::DOUBLE,
+        nebula::cpp2::SupportedType::VID,
+        nebula::cpp2::SupportedType::TIMESTAMP,
+        nebula::cpp2::SupportedType::INT,
+    };
+    for (int i = 0; i < 128; i++) {
+        schemaWide->appendCol(folly::stringPrintf("col%03d", i), types[i % types.size()]);
+    }
+}
+
+
+void writeWide(nebula::RowFormat format, int32_t iters) {
+    for (int32_t i = 0; i < iters; i++) {
+        RowWriter writer(schemaWide, format);
+        for (int j = 0; j < 128; j += 8) {
+            writer << true << 123 << "Hello World" << 1.23f
+                   << 3.1415926 << 0xABCDABCDABCDABCD << 1551331827 << -1;
+        }
+        auto encoded = writer.encode();
+        folly::doNotOptimizeAway(encoded);
+    }
 }
 
 
@@ -162,6 +191,15 @@ BENCHMARK(mix_no_schema, iters) {
 BENCHMARK(mix_with_schema, iters) {
     writeMix(schemaMix, iters);
 }
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(wide_v1, iters) {
+    writeWide(nebula::RowFormat::V1, iters);
+}
+BENCHMARK_RELATIVE(wide_v2, iters) {
+    writeWide(nebula::RowFormat::V2, iters);
+}
 /*************************
  * End of benchmarks
  ************************/
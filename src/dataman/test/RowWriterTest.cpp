@@ -289,6 +289,158 @@ TEST(RowWriter, skip) {
     EXPECT_DOUBLE_EQ(0.0, dVal);
 }
 
+
+TEST(RowWriter, formatV2) {
+    // 40 fields of all types, with a schema version
+    auto schema = std::make_shared<SchemaWriter>(0x1234);
+    std::vector<cpp2::SupportedType> types = {
+        cpp2::SupportedType::BOOL,
+        cpp2::SupportedType::INT,
+        cpp2::SupportedType::STRING,
+        cpp2::SupportedType::FLOAT,
+        cpp2::SupportedType::DOUBLE,
+        cpp2::SupportedType::VID,
+        cpp2::SupportedType::TIMESTAMP,
+        cpp2::SupportedType::STRING,
+    };
+    for (auto i = 0; i < 40; i++) {
+        schema->appendCol(folly::stringPrintf("col%d", i), types[i % types.size()]);
+    }
+
+    RowWriter writer(schema, RowFormat::V2);
+    EXPECT_EQ(RowFormat::V2, writer.format());
+    // Skip the fourth eight fields, and implicitly the last one
+    for (auto i = 0; i < 39; i++) {
+        if (i / types.size() == 3) {
+            writer << RowWriter::Skip(1);
+            continue;
+        }
+        switch (types[i % types.size()]) {
+            case cpp2::SupportedType::BOOL:
+                writer << (i % 2 == 0);
+                break;
+            case cpp2::SupportedType::INT:
+            case cpp2::SupportedType::TIMESTAMP:
+                writer << -i * 1000;
+                break;
+            case cpp2::SupportedType::STRING:
+                writer << folly::stringPrintf("str%d", i);
+                break;
+            case cpp2::SupportedType::FLOAT:
+                writer << static_cast<float>(i + 0.5);
+                break;
+            case cpp2::SupportedType::DOUBLE:
+                writer << i + 0.25;
+                break;
+            case cpp2::SupportedType::VID:
+                writer << 0xABCDABCDABCDABCD + i;
+                break;
+            default:
+                break;
+        }
+    }
+    std::string encoded = writer.encode();
+    EXPECT_EQ(writer.size(), encoded.size());
+    // The header byte, two bytes of the version and five bytes of the null bitmap
+    EXPECT_EQ(kRowFormatV2Flag | (2 << 5), encoded[0]);
+    EXPECT_EQ(8 + 40 * kRowSlotSize + 2 * 4 + 5 * 5, encoded.size());
+    EXPECT_EQ(0x1234, RowReader::getSchemaVer(encoded));
+
+    auto reader = RowReader::getRowReader(encoded, schema);
+    EXPECT_EQ(RowFormat::V2, reader->format());
+    // Read the fields backward
+    for (auto i = 39; i >= 0; i--) {
+        bool skipped = i / types.size() == 3 || i == 39;
+        EXPECT_EQ(skipped, reader->isNull(i));
+        EXPECT_EQ(skipped, reader->isNull(folly::stringPrintf("col%d", i)));
+        switch (types[i % types.size()]) {
+            case cpp2::SupportedType::BOOL: {
+                bool v;
+                EXPECT_EQ(ResultType::SUCCEEDED, reader->getBool(i, v));
+                EXPECT_EQ(!skipped && i % 2 == 0, v);
+                break;
+            }
+            case cpp2::SupportedType::INT:
+            case cpp2::SupportedType::TIMESTAMP: {
+                int64_t v;
+                EXPECT_EQ(ResultType::SUCCEEDED, reader->getInt(i, v));
+                EXPECT_EQ(skipped ? 0 : -i * 1000, v);
+                break;
+            }
+            case cpp2::SupportedType::STRING: {
+                folly::StringPiece v;
+                EXPECT_EQ(ResultType::SUCCEEDED, reader->getString(i, v));
+                EXPECT_EQ(skipped ? "" : folly::stringPrintf("str%d", i), v.str());
+                break;
+            }
+            case cpp2::SupportedType::FLOAT: {
+                float v;
+                EXPECT_EQ(ResultType::SUCCEEDED, reader->getFloat(i, v));
+                EXPECT_FLOAT_EQ(skipped ? 0 : i + 0.5, v);
+                break;
+            }
+            case cpp2::SupportedType::DOUBLE: {
+                double v;
+                EXPECT_EQ(ResultType::SUCCEEDED, reader->getDouble(i, v));
+                EXPECT_DOUBLE_EQ(skipped ? 0 : i + 0.25, v);
+                break;
+            }
+            case cpp2::SupportedType::VID: {
+                int64_t v;
+                EXPECT_EQ(ResultType::SUCCEEDED, reader->getVid(i, v));
+                EXPECT_EQ(skipped ? 0 : static_cast<int64_t>(0xABCDABCDABCDABCD + i), v);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    // Read the fields one by one
+    auto it = reader->begin();
+    for (auto i = 0; i < 6; i++) {
+        ++it;
+    }
+    int64_t iVal;
+    EXPECT_EQ(ResultType::SUCCEEDED, it->getInt(iVal));
+    EXPECT_EQ(-6000, iVal);
+    ++it;
+    folly::StringPiece sVal;
+    EXPECT_EQ(ResultType::SUCCEEDED, it->getString(sVal));
+    EXPECT_EQ("str7", sVal);
+    ++it;
+    bool bVal;
+    EXPECT_EQ(ResultType::SUCCEEDED, it->getBool(bVal));
+    EXPECT_TRUE(bVal);
+
+    EXPECT_EQ(ResultType::E_INDEX_OUT_OF_RANGE, reader->getInt(40, iVal));
+    EXPECT_FALSE(reader->isNull(40));
+}
+
+
+TEST(RowWriter, formatV2WithoutSchema) {
+    RowWriter writer(nullptr, RowFormat::V2);
+    writer << true << 10 << "Hello World!" << 3.1415926;
+    std::string encoded = writer.encode();
+    auto schema = std::make_shared<ResultSchemaProvider>(writer.moveSchema());
+    auto reader = RowReader::getRowReader(encoded, schema);
+    EXPECT_EQ(RowFormat::V2, reader->format());
+    EXPECT_EQ(4, reader->numFields());
+
+    bool bVal;
+    int64_t iVal;
+    folly::StringPiece sVal;
+    double dVal;
+    EXPECT_EQ(ResultType::SUCCEEDED, reader->getBool(0, bVal));
+    EXPECT_TRUE(bVal);
+    EXPECT_EQ(ResultType::SUCCEEDED, reader->getInt(1, iVal));
+    EXPECT_EQ(10, iVal);
+    EXPECT_EQ(ResultType::SUCCEEDED, reader->getString(2, sVal));
+    EXPECT_EQ("Hello World!", sVal);
+    EXPECT_EQ(ResultType::SUCCEEDED, reader->getDouble(3, dVal));
+    EXPECT_DOUBLE_EQ(3.1415926, dVal);
+}
+
 }  // namespace nebula
 
 
@@ -153,7 +153,11 @@ AdminJobExecutor::toRowValue(const nebula::meta::cpp2::TaskDesc& task) {
     cpp2::RowValue ret;
     std::vector<cpp2::ColumnValue> row(5);
     row[0].set_str(folly::stringPrintf("%d-%d", task.get_job_id(), task.get_task_id()));
-    row[1].set_str(toString(task.get_host()));
+    auto dest = toString(task.get_host());
+    if (task.__isset.part_id) {
+        dest += folly::stringPrintf(" part %d", task.part_id);
+    }
+    row[1].set_str(std::move(dest));
     row[2].set_str(toString(task.get_status()));
     row[3].set_str(time2string(task.get_start_time()));
     row[4].set_str(time2string(task.get_stop_time()));
@@ -0,0 +1,374 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "graph/BulkInserter.h"
+#include "graph/GraphFlags.h"
+#include "dataman/RowWriter.h"
+#include "permission/PermissionManager.h"
+#include "storage/client/StorageClient.h"
+#include "utils/ConvertTimeType.h"
+
+namespace nebula {
+namespace graph {
+
+using nebula::cpp2::SupportedType;
+
+// static
+StatusOr<BulkRowEncoder> BulkRowEncoder::make(
+        std::shared_ptr<const meta::SchemaProviderIf> schema,
+        const std::vector<std::string> &propNames) {
+    if (propNames.size() > schema->getNumFields()) {
+        LOG(ERROR) << "Input props number " << propNames.size()
+                   << ", schema fields number " << schema->getNumFields();
+        return Status::Error("Wrong number of props");
+    }
+
+    auto numFields = schema->getNumFields();
+    BulkRowEncoder encoder(schema);
+    encoder.numProps_ = propNames.size();
+    encoder.positions_.resize(numFields, -1);
+    encoder.defaults_.resize(numFields);
+    for (auto i = 0u; i < propNames.size(); i++) {
+        auto index = schema->getFieldIndex(propNames[i]);
+        if (index < 0) {
+            LOG(ERROR) << "Unknown column `" << propNames[i] << "' in schema";
+            return Status::Error("Unknown column `%s' in schema", propNames[i].c_str());
+        }
+        if (encoder.positions_[index] >= 0) {
+            return Status::Error("Duplicate column `%s'", propNames[i].c_str());
+        }
+        encoder.positions_[index] = i;
+    }
+
+    for (auto i = 0u; i < numFields; i++) {
+        if (encoder.positions_[i] >= 0) {
+            continue;
+        }
+        auto value = schema->getDefaultValue(i);
+        if (!value.ok()) {
+            LOG(ERROR) << "Not exist default value: " << schema->getFieldName(i);
+            return Status::Error("`%s' not exist default value", schema->getFieldName(i));
+        }
+        if (schema->getFieldType(i).type == SupportedType::TIMESTAMP) {
+            // Convert the default timestamp once, rather than for every row
+            auto timestamp = ConvertTimeType::toTimestamp(value.value());
+            if (!timestamp.ok()) {
+                return timestamp.status();
+            }
+            encoder.defaults_[i] = timestamp.value();
+        } else {
+            encoder.defaults_[i] = std::move(value).value();
+        }
+    }
+    return encoder;
+}
+
+
+StatusOr<std::string>
+BulkRowEncoder::encode(const std::vector<cpp2::ColumnValue> &values) const {
+    if (values.size() != numProps_) {
+        return Status::Error("Column count doesn't match value count");
+    }
+
+    RowWriter writer(schema_);
+    for (auto i = 0u; i < positions_.size(); i++) {
+        auto position = positions_[i];
+        if (position < 0) {
+            auto &value = defaults_[i];
+            switch (value.which()) {
+                case VAR_INT64:
+                    writer << boost::get<int64_t>(value);
+                    break;
+                case VAR_DOUBLE:
+                    writer << boost::get<double>(value);
+                    break;
+                case VAR_BOOL:
+                    writer << boost::get<bool>(value);
+                    break;
+                case VAR_STR:
+                    writer << boost::get<std::string>(value);
+                    break;
+                default:
+                    return Status::Error("Unknown value type: %d", value.which());
+            }
+            continue;
+        }
+
+        auto &value = values[position];
+        auto valueType = value.getType();
+        auto schemaType = schema_->getFieldType(i).type;
+        bool matched = true;
+        switch (schemaType) {
+            case SupportedType::BOOL:
+                if (valueType == cpp2::ColumnValue::Type::bool_val) {
+                    writer << value.get_bool_val();
+                } else {
+                    matched = false;
+                }
+                break;
+            case SupportedType::INT:
+            case SupportedType::VID:
+                if (valueType == cpp2::ColumnValue::Type::integer) {
+                    writer << value.get_integer();
+                } else if (valueType == cpp2::ColumnValue::Type::id) {
+                    writer << value.get_id();
+                } else {
+                    matched = false;
+                }
+                break;
+            case SupportedType::FLOAT:
+            case SupportedType::DOUBLE:
+                if (valueType == cpp2::ColumnValue::Type::double_precision) {
+                    writer << value.get_double_precision();
+                } else if (valueType == cpp2::ColumnValue::Type::single_precision) {
+                    writer << value.get_single_precision();
+                } else {
+                    matched = false;
+                }
+                break;
+            case SupportedType::STRING:
+                if (valueType == cpp2::ColumnValue::Type::str) {
+                    writer << value.get_str();
+                } else {
+                    matched = false;
+                }
+                break;
+            case SupportedType::TIMESTAMP: {
+                VariantType v;
+                if (valueType == cpp2::ColumnValue::Type::timestamp) {
+                    v = value.get_timestamp();
+                } else if (valueType == cpp2::ColumnValue::Type::integer) {
+                    v = value.get_integer();
+                } else if (valueType == cpp2::ColumnValue::Type::str) {
+                    v = value.get_str();
+                } else {
+                    matched = false;
+                    break;
+                }
+                auto timestamp = ConvertTimeType::toTimestamp(v);
+                if (!timestamp.ok()) {
+                    return timestamp.status();
+                }
+                writer << timestamp.value();
+                break;
+            }
+            default:
+                return Status::Error("Unsupported type of column `%s'",
+                                     schema_->getFieldName(i));
+        }
+        if (!matched) {
+            LOG(ERROR) << "ValueType is wrong, schema type " << static_cast<int32_t>(schemaType)
+                       << ", input type " << static_cast<int32_t>(valueType);
+            return Status::Error("ValueType of column `%s' is wrong", schema_->getFieldName(i));
+        }
+    }
+    return writer.encode();
+}
+
+
+void BulkInserter::execute() {
+    auto status = prepare();
+    if (!status.ok()) {
+        onError(std::move(status));
+        return;
+    }
+
+    if (req_.get_is_edge()) {
+        auto edges = toEdges();
+        if (!edges.ok()) {
+            onError(edges.status());
+            return;
+        }
+        onStorageResponse(storage_->addEdges(spaceId_,
+                                             std::move(edges).value(),
+                                             req_.get_overwritable()));
+    } else {
+        auto vertices = toVertices();
+        if (!vertices.ok()) {
+            onError(vertices.status());
+            return;
+        }
+        onStorageResponse(storage_->addVertices(spaceId_,
+                                                std::move(vertices).value(),
+                                                req_.get_overwritable()));
+    }
+}
+
+
+Status BulkInserter::prepare() {
+    auto *session = rctx_->session();
+    if (req_.get_space_name() != nullptr && !req_.get_space_name()->empty()) {
+        auto spaceRet = schemaManager_->toGraphSpaceID(*req_.get_space_name());
+        if (!spaceRet.ok()) {
+            return Status::Error("Space not found for `%s'", req_.get_space_name()->c_str());
+        }
+        spaceId_ = spaceRet.value();
+    } else {
+        spaceId_ = session->space();
+        if (spaceId_ == -1) {
+            return Status::Error("Please choose a graph space with `USE spaceName' firstly");
+        }
+    }
+    if (FLAGS_enable_authorize &&
+        !permission::PermissionManager::canWriteData(session, spaceId_)) {
+        return Status::PermissionError("Permission denied");
+    }
+
+    auto &name = req_.get_name();
+    std::shared_ptr<const meta::SchemaProviderIf> schema;
+    if (req_.get_is_edge()) {
+        auto edgeRet = schemaManager_->toEdgeType(spaceId_, name);
+        if (!edgeRet.ok()) {
+            return edgeRet.status();
+        }
+        schemaId_ = edgeRet.value();
+        schema = schemaManager_->getEdgeSchema(spaceId_, schemaId_);
+    } else {
+        auto tagRet = schemaManager_->toTagID(spaceId_, name);
+        if (!tagRet.ok()) {
+            return Status::Error("No schema found for `%s'", name.c_str());
+        }
+        schemaId_ = tagRet.value();
+        schema = schemaManager_->getTagSchema(spaceId_, schemaId_);
+    }
+    if (schema == nullptr) {
+        LOG(ERROR) << "No schema found for " << name;
+        return Status::Error("No schema found for `%s'", name.c_str());
+    }
+
+    if (req_.get_rows().empty()) {
+        return Status::Error("Rows cannot be empty");
+    }
+
+    auto encoder = BulkRowEncoder::make(std::move(schema), req_.get_prop_names());
+    if (!encoder.ok()) {
+        return encoder.status();
+    }
+    encoder_ = std::make_unique<BulkRowEncoder>(std::move(encoder).value());
+    return Status::OK();
+}
+
+
+StatusOr<std::vector<storage::cpp2::Vertex>> BulkInserter::toVertices() const {
+    auto &rows = req_.get_rows();
+    std::vector<storage::cpp2::Vertex> vertices(rows.size());
+    for (auto i = 0u; i < rows.size(); i++) {
+        auto props = encoder_->encode(rows[i].get_values());
+        if (!props.ok()) {
+            return props.status();
+        }
+        std::vector<storage::cpp2::Tag> tags(1);
+        tags[0].set_tag_id(schemaId_);
+        tags[0].set_props(std::move(props).value());
+
+        auto &vertex = vertices[i];
+        vertex.set_id(rows[i].get_id());
+        vertex.set_tags(std::move(tags));
+    }
+    return vertices;
+}
+
+
+StatusOr<std::vector<storage::cpp2::Edge>> BulkInserter::toEdges() const {
+    auto &rows = req_.get_rows();
+    std::vector<storage::cpp2::Edge> edges(rows.size() * 2);   // inbound and outbound
+    auto index = 0;
+    for (auto &row : rows) {
+        if (row.get_dst() == nullptr) {
+            return Status::Error("The destination of edge `%s' is missing",
+                                 req_.get_name().c_str());
+        }
+        auto src = row.get_id();
+        auto dst = *row.get_dst();
+        auto rank = row.get_ranking() == nullptr ? 0 : *row.get_ranking();
+        auto ret = encoder_->encode(row.get_values());
+        if (!ret.ok()) {
+            return ret.status();
+        }
+        auto props = std::move(ret).value();
+        {
+            auto &out = edges[index++];
+            out.key.set_src(src);
+            out.key.set_dst(dst);
+            out.key.set_ranking(rank);
+            out.key.set_edge_type(schemaId_);
+            out.props = props;
+            out.__isset.key = true;
+            out.__isset.props = true;
+        }
+        {
+            auto &in = edges[index++];
+            in.key.set_src(dst);
+            in.key.set_dst(src);
+            in.key.set_ranking(rank);
+            in.key.set_edge_type(-schemaId_);
+            in.props = std::move(props);
+            in.__isset.key = true;
+            in.__isset.props = true;
+        }
+    }
+    return edges;
+}
+
+
+template <typename Future>
+void BulkInserter::onStorageResponse(Future &&future) {
+    auto cb = [this] (auto &&resp) {
+        // For insertion, we regard partial success as failure.
+        auto completeness = resp.completeness();
+        if (completeness != 100) {
+            const auto& failedCodes = resp.failedParts();
+            for (auto it = failedCodes.begin(); it != failedCodes.end(); it++) {
+                LOG(ERROR) << "Bulk insert failed, error " << static_cast<int32_t>(it->second)
+                           << ", part " << it->first;
+            }
+            onError(Status::Error("Insert `%s' not complete, completeness: %d",
+                                  req_.get_name().c_str(), completeness));
+            return;
+        }
+        onFinish();
+    };
+
+    auto error = [this] (auto &&e) {
+        auto msg = folly::stringPrintf("Insert `%s' exception: %s",
+                                       req_.get_name().c_str(), e.what().c_str());
+        LOG(ERROR) << msg;
+        onError(Status::Error(std::move(msg)));
+    };
+
+    std::move(future).via(rctx_->runner()).thenValue(cb).thenError(error);
+}
+
+
+void BulkInserter::onFinish() {
+    rctx_->resp().set_error_code(cpp2::ErrorCode::SUCCEEDED);
+    rctx_->resp().set_latency_in_us(rctx_->duration().elapsedInUSec());
+    if (req_.get_space_name() != nullptr && !req_.get_space_name()->empty()) {
+        rctx_->resp().set_space_name(*req_.get_space_name());
+    } else {
+        rctx_->resp().set_space_name(rctx_->session()->spaceName());
+    }
+    rctx_->finish();
+    delete this;
+}
+
+
+void BulkInserter::onError(Status status) {
+    LOG(ERROR) << "Bulk insert failed: " << status.toString();
+    if (status.isPermissionError()) {
+        rctx_->resp().set_error_code(cpp2::ErrorCode::E_BAD_PERMISSION);
+    } else {
+        rctx_->resp().set_error_code(cpp2::ErrorCode::E_EXECUTION_ERROR);
+    }
+    rctx_->resp().set_error_msg(status.toString());
+    rctx_->resp().set_latency_in_us(rctx_->duration().elapsedInUSec());
+    rctx_->finish();
+    delete this;
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,99 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_BULKINSERTER_H_
+#define GRAPH_BULKINSERTER_H_
+
+#include "base/Base.h"
+#include "base/StatusOr.h"
+#include "cpp/helpers.h"
+#include "graph/RequestContext.h"
+#include "gen-cpp2/GraphService.h"
+#include "gen-cpp2/storage_types.h"
+#include "meta/SchemaManager.h"
+
+namespace nebula {
+namespace storage {
+class StorageClient;
+}   // namespace storage
+
+namespace graph {
+
+/**
+ * Encode the typed values of a bulk insertion into rows of a schema.
+ * The prop names are checked against the schema once, then each row only
+ * has its values converted, in the order of the schema fields.
+ * */
+class BulkRowEncoder final {
+public:
+    static StatusOr<BulkRowEncoder> make(std::shared_ptr<const meta::SchemaProviderIf> schema,
+                                         const std::vector<std::string> &propNames);
+
+    StatusOr<std::string> encode(const std::vector<cpp2::ColumnValue> &values) const;
+
+private:
+    explicit BulkRowEncoder(std::shared_ptr<const meta::SchemaProviderIf> schema)
+        : schema_(std::move(schema)) {}
+
+private:
+    std::shared_ptr<const meta::SchemaProviderIf>   schema_;
+    size_t                                          numProps_{0};
+    // The position in the values of each schema field, -1 for the default value
+    std::vector<int32_t>                            positions_;
+    std::vector<VariantType>                        defaults_;
+};
+
+
+/**
+ * BulkInserter serves GraphService::bulkInsert, which inserts the vertices of a tag,
+ * or the edges of an edge type, given with typed values rather than an nGQL statement.
+ *
+ * Like an `ExecutionPlan', it deletes itself once the response is sent.
+ * */
+class BulkInserter final : public cpp::NonCopyable, public cpp::NonMovable {
+public:
+    using RequestContextPtr = std::unique_ptr<RequestContext<cpp2::ExecutionResponse>>;
+
+    BulkInserter(RequestContextPtr rctx,
+                 cpp2::BulkInsertRequest req,
+                 meta::SchemaManager *schemaManager,
+                 storage::StorageClient *storage)
+        : rctx_(std::move(rctx))
+        , req_(std::move(req))
+        , schemaManager_(schemaManager)
+        , storage_(storage) {}
+
+    void execute();
+
+private:
+    Status prepare();
+
+    StatusOr<std::vector<storage::cpp2::Vertex>> toVertices() const;
+
+    StatusOr<std::vector<storage::cpp2::Edge>> toEdges() const;
+
+    template <typename Future>
+    void onStorageResponse(Future &&future);
+
+    void onFinish();
+
+    void onError(Status status);
+
+private:
+    RequestContextPtr                               rctx_;
+    cpp2::BulkInsertRequest                         req_;
+    meta::SchemaManager                            *schemaManager_{nullptr};
+    storage::StorageClient                         *storage_{nullptr};
+    GraphSpaceID                                    spaceId_{-1};
+    // Tag id or edge type
+    int32_t                                         schemaId_{0};
+    std::unique_ptr<BulkRowEncoder>                 encoder_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif  // GRAPH_BULKINSERTER_H_
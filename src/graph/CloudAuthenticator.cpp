@@ -30,9 +30,11 @@ bool CloudAuthenticator::auth(const std::string& user, const std::string& passwo
     std::string userAndPasswd = user + ":" + password;
     std::string base64Str = encryption::Base64::encode(userAndPasswd);
 
-    std::string header = "-H \"Content-Type: application/json\"  -H \"Authorization:Nebula ";
-    header =  header + base64Str + "\"";
-    auto result = http::HttpClient::post(FLAGS_cloud_http_url, header);
+    http::HttpHeaders headers = {
+        {"Content-Type", "application/json"},
+        {"Authorization", "Nebula " + base64Str},
+    };
+    auto result = http::HttpClient::post(FLAGS_cloud_http_url, headers);
 
     if (!result.ok()) {
         LOG(ERROR) << result.status();
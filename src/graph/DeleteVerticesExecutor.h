@@ -26,7 +26,6 @@ public:
     void execute() override;
 
 private:
-    void deleteEdges(std::vector<storage::cpp2::EdgeKey>& edges);
     void deleteVertices();
 
 private:
@@ -10,7 +10,6 @@
 #include "process/ProcessUtils.h"
 #include "webservice/Common.h"
 
-#include <folly/executors/Async.h>
 #include <folly/futures/Future.h>
 #include <folly/executors/ThreadedExecutor.h>
 
@@ -81,25 +80,21 @@ void DownloadExecutor::execute() {
             hdfsHost->c_str(), hdfsPort, hdfsPath->c_str(), spaceId);
     }
 
-    auto func = [url] {
-        auto result = http::HttpClient::get(url);
-        if (result.ok() && result.value() == "SSTFile dispatch successfully") {
-            LOG(INFO) << "Download Successfully";
-            return true;
-        } else {
-            LOG(ERROR) << "Download Failed: " << result.value();
-            return false;
-        }
-    };
-    auto future = folly::async(func);
+    auto future = http::HttpClient::instance().asyncGet(url);
 
     auto *runner = ectx()->rctx()->runner();
 
-    auto cb = [this] (auto &&resp) {
-        if (!resp) {
+    auto cb = [this] (StatusOr<http::HttpResponse> &&result) {
+        if (!result.ok()) {
+            doError(Status::Error("Download Failed: %s", result.status().toString().c_str()));
+            return;
+        }
+        if (result.value().body != "SSTFile dispatch successfully") {
+            LOG(ERROR) << "Download Failed: " << result.value().body;
             doError(Status::Error("Download Failed"));
             return;
         }
+        LOG(INFO) << "Download Successfully";
         resp_ = std::make_unique<cpp2::ExecutionResponse>();
         doFinish(Executor::ProcessControl::kNext);
     };
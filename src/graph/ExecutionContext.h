@@ -14,6 +14,8 @@
 #include "meta/SchemaManager.h"
 #include "meta/ClientBasedGflagsManager.h"
 #include "graph/VariableHolder.h"
+#include "graph/MemoryTracker.h"
+#include "graph/GraphFlags.h"
 #include "meta/client/MetaClient.h"
 #include "charset/Charset.h"
 
@@ -43,6 +45,8 @@ public:
         metaClient_ = metaClient;
         variableHolder_ = std::make_unique<VariableHolder>();
         charsetInfo_ = charsetInfo;
+        memTracker_ = std::make_unique<MemoryTracker>(FLAGS_query_memory_limit_mb * 1024 * 1024,
+                                                      MemoryTracker::global());
     }
 
     ~ExecutionContext();
@@ -75,6 +79,10 @@ public:
         return charsetInfo_;
     }
 
+    MemoryTracker* memTracker() const {
+        return memTracker_.get();
+    }
+
     void addWarningMsg(std::string msg) {
         warnMsgs_.emplace_back(std::move(msg));
     }
@@ -92,6 +100,7 @@ private:
     std::unique_ptr<VariableHolder>             variableHolder_;
     CharsetInfo                                *charsetInfo_{nullptr};
     std::vector<std::string>                    warnMsgs_;
+    std::unique_ptr<MemoryTracker>              memTracker_;
 };
 
 }   // namespace graph
@@ -8,6 +8,7 @@
 #include "graph/ExecutionEngine.h"
 #include "graph/ExecutionContext.h"
 #include "graph/ExecutionPlan.h"
+#include "graph/BulkInserter.h"
 #include "storage/client/StorageClient.h"
 
 
@@ -50,5 +51,13 @@ void ExecutionEngine::execute(RequestContextPtr rctx) {
     plan->execute();
 }
 
+void ExecutionEngine::bulkInsert(RequestContextPtr rctx, cpp2::BulkInsertRequest req) {
+    auto inserter = new BulkInserter(std::move(rctx),
+                                     std::move(req),
+                                     schemaManager_.get(),
+                                     storage_.get());
+    inserter->execute();
+}
+
 }   // namespace graph
 }   // namespace nebula
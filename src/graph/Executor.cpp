@@ -6,6 +6,7 @@
 
 #include "base/Base.h"
 #include "graph/Executor.h"
+#include "storage/client/StorageClient.h"
 #include "parser/TraverseSentences.h"
 #include "parser/MutateSentences.h"
 #include "parser/MaintainSentences.h"
@@ -373,6 +374,44 @@ OptVariantType Executor::toVariantType(const cpp2::ColumnValue& value) const {
     return Status::Error("Unknown ColumnType: %d", static_cast<int32_t>(value.getType()));
 }
 
+folly::Future<Status> Executor::resolveUUIDs(const std::vector<Expression*> &exprs,
+                                             ExpressionContext *expCtx) {
+    std::unordered_set<std::string> names;
+    for (auto *expr : exprs) {
+        expr->traversal([&names] (const Expression *e) {
+            if (e->kind() == Expression::kUUID) {
+                names.emplace(*static_cast<const UUIDExpression*>(e)->field());
+            }
+        });
+    }
+    if (names.empty()) {
+        return folly::makeFuture(Status::OK());
+    }
+
+    auto spaceId = ectx()->rctx()->session()->space();
+    auto future = ectx()->getStorageClient()->getUUIDs(
+        spaceId, std::vector<std::string>(names.begin(), names.end()));
+    auto *runner = ectx()->rctx()->runner();
+    return std::move(future).via(runner)
+        .thenValue([expCtx] (auto &&resp) {
+            if (resp.completeness() != 100) {
+                for (auto &part : resp.failedParts()) {
+                    LOG(ERROR) << "Get UUID failed, error " << static_cast<int32_t>(part.second)
+                               << ", part " << part.first;
+                }
+                return Status::Error("Get UUID Failed");
+            }
+            for (auto &r : resp.responses()) {
+                expCtx->addUUIDs(r.get_ids());
+            }
+            return Status::OK();
+        })
+        .thenError([] (auto &&e) {
+            LOG(ERROR) << "Get UUID exception: " << e.what();
+            return Status::Error("Get UUID exception: %s", e.what().c_str());
+        });
+}
+
 void Executor::doError(Status status, uint32_t count) const {
     stats::Stats::addStatsValue(stats_.get(), false, duration().elapsedInUSec(), count);
     DCHECK(onError_);
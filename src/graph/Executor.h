@@ -109,6 +109,13 @@ protected:
         return Status::OK();
     }
 
+    /**
+     * Get the ids of all the uuid() in the expressions with one batched request,
+     * and keep them in expCtx, so evaluating the expressions is not blocked by RPCs.
+     */
+    folly::Future<Status> resolveUUIDs(const std::vector<Expression*> &exprs,
+                                       ExpressionContext *expCtx);
+
     void doError(Status status, uint32_t count = 1) const;
     void doFinish(ProcessControl pro, uint32_t count = 1) const;
 
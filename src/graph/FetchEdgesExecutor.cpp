@@ -127,7 +127,7 @@ Status FetchEdgesExecutor::checkEdgeProps() {
         }
         auto propName = pair.second;
         if (propName == _SRC || propName == _DST
-                || propName == _RANK || propName == _TYPE) {
+                || propName == _RANK || propName == _TYPE || propName == _DEGREE) {
             continue;
         }
         if (labelSchema_->getFieldIndex(propName) == -1) {
@@ -15,6 +15,13 @@
 
 DEFINE_bool(filter_pushdown, true, "If pushdown the filter to storage.");
 DEFINE_bool(trace_go, false, "Whether to dump the detail trace log from one go request");
+DEFINE_bool(go_streaming_expansion, false,
+            "Expand the response of each host at once in multi-step GO, "
+            "rather than waiting for all hosts of the step");
+DEFINE_int32(go_max_inflight_batches, 32,
+             "The max number of getNeighbors requests in flight for one streaming GO");
+DEFINE_bool(go_storage_traverse, false,
+            "Let storage expand the hops out of the vertices it leads in multi-step GO");
 
 namespace nebula {
 namespace graph {
@@ -30,6 +37,11 @@ GoExecutor::GoExecutor(Sentence *sentence, ExecutionContext *ectx)
 }
 
 
+GoExecutor::~GoExecutor() {
+    ectx()->memTracker()->release(charged_);
+}
+
+
 Status GoExecutor::prepare() {
     return Status::OK();
 }
@@ -74,6 +86,10 @@ Status GoExecutor::prepareClauses() {
         if (!status.ok()) {
             break;
         }
+        status = prepareTruncate();
+        if (!status.ok()) {
+            break;
+        }
         status = checkNeededProps();
         if (!status.ok()) {
             break;
@@ -127,10 +143,25 @@ void GoExecutor::execute() {
         }
         starts_ = std::vector<VertexID>(uniqID.begin(), uniqID.end());
     }
+    if (FLAGS_go_storage_traverse && steps_ > 1 && canTraverseOnStorage()) {
+        traverse_ = true;
+        streamOut();
+        return;
+    }
+    if (FLAGS_go_streaming_expansion && steps_ > 1) {
+        streamOut();
+        return;
+    }
     stepOut();
 }
 
 
+bool GoExecutor::canTraverseOnStorage() const {
+    // The steps limited or sampled are left to graph, so the truncation is done per step
+    return recordFrom_ == steps_ && fromType_ == kInstantExpr && truncates_.empty();
+}
+
+
 Status GoExecutor::prepareStep() {
     auto *clause = sentence_->stepClause();
     if (clause != nullptr) {
@@ -146,6 +177,30 @@ Status GoExecutor::prepareStep() {
 }
 
 
+Status GoExecutor::prepareTruncate() {
+    auto *clause = sentence_->truncateClause();
+    if (clause == nullptr) {
+        return Status::OK();
+    }
+    auto &counts = clause->counts();
+    if (counts.size() != steps_) {
+        return Status::SyntaxError("There should be %u numbers in %s, but got %lu",
+                                   steps_,
+                                   clause->isSample() ? "SAMPLE" : "LIMIT",
+                                   counts.size());
+    }
+    for (auto count : counts) {
+        if (count < 0) {
+            return Status::SyntaxError("Negative number in `%s'",
+                                       clause->toString().c_str());
+        }
+        truncates_.emplace_back(count);
+    }
+    sample_ = clause->isSample();
+    return Status::OK();
+}
+
+
 Status GoExecutor::prepareFrom() {
     Status status = Status::OK();
     auto *clause = sentence_->fromClause();
@@ -451,7 +506,7 @@ Status GoExecutor::checkNeededProps() {
         }
         auto propName = pair.second;
         if (propName == _SRC || propName == _DST
-                || propName == _RANK || propName == _TYPE) {
+                || propName == _RANK || propName == _TYPE || propName == _DEGREE) {
             continue;
         }
         auto es = ectx()->schemaManager()->getEdgeSchema(space, std::abs(edgeType));
@@ -519,7 +574,7 @@ void GoExecutor::setupResponse(cpp2::ExecutionResponse &resp) {
 
 void GoExecutor::stepOut() {
     auto spaceId = ectx()->rctx()->session()->space();
-    auto status = getStepOutProps();
+    auto status = getStepOutProps(isRecord());
     if (!status.ok()) {
         doError(std::move(status).status());
         return;
@@ -533,11 +588,15 @@ void GoExecutor::stepOut() {
     }
     VLOG(1) << "edge type size: " << edgeTypes_.size()
             << " return cols: " << returns.size();
+    // The edges of a supernode are truncated on the storage side, before they are scanned
+    int64_t limit = truncates_.empty() ? -1 : truncates_[curStep_ - 1];
     auto future  = ectx()->getStorageClient()->getNeighbors(spaceId,
                                                             starts_,
                                                             edgeTypes_,
                                                             filterPushdown,
-                                                            std::move(returns));
+                                                            std::move(returns),
+                                                            limit,
+                                                            sample_);
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&result) {
         auto completeness = result.completeness();
@@ -588,7 +647,11 @@ void GoExecutor::stepOut() {
     } while (0);
 
 void GoExecutor::onStepOutResponse(RpcResponse &&rpcResp) {
-    joinResp(std::move(rpcResp));
+    auto status = joinResp(std::move(rpcResp));
+    if (!status.ok()) {
+        doError(std::move(status));
+        return;
+    }
 
     // back trace each step
     CHECK_GT(records_.size(), 0);
@@ -605,8 +668,262 @@ void GoExecutor::onStepOutResponse(RpcResponse &&rpcResp) {
     }
 }
 
+void GoExecutor::streamOut() {
+    for (auto record : {false, true}) {
+        auto status = getStepOutProps(record);
+        if (!status.ok()) {
+            doError(std::move(status).status());
+            return;
+        }
+        streamProps_[record] = std::move(status).value();
+    }
+    requested_.resize(steps_ + 1);
+    stepResps_.resize(steps_ + 1);
+    std::vector<StepBatch> batches;
+    {
+        std::lock_guard<std::mutex> g(streamLock_);
+        enqueueBatches(1, std::move(starts_));
+        batches = popBatches();
+    }
+    if (batches.empty()) {
+        onStreamFinished();
+        return;
+    }
+    for (auto &batch : batches) {
+        sendBatch(std::move(batch));
+    }
+}
+
+void GoExecutor::enqueueBatches(uint32_t step, std::vector<VertexID> vertices) {
+    auto &requested = requested_[step];
+    std::vector<VertexID> frontier;
+    frontier.reserve(vertices.size());
+    for (auto vid : vertices) {
+        // The same vertex may come from the responses of different hosts
+        if (requested.emplace(vid).second) {
+            frontier.emplace_back(vid);
+        }
+    }
+    if (frontier.empty()) {
+        return;
+    }
+    auto spaceId = ectx()->rctx()->session()->space();
+    auto hosts = ectx()->getStorageClient()->groupByHost(spaceId, frontier);
+    if (!hosts.ok()) {
+        streamStatus_ = hosts.status();
+        return;
+    }
+    for (auto &host : hosts.value()) {
+        pendingBatches_.emplace_back(StepBatch{step, std::move(host.second)});
+    }
+}
+
+std::vector<GoExecutor::StepBatch> GoExecutor::popBatches() {
+    std::vector<StepBatch> batches;
+    if (!streamStatus_.ok()) {
+        pendingBatches_.clear();
+        return batches;
+    }
+    while (!pendingBatches_.empty() && inflightBatches_ < FLAGS_go_max_inflight_batches) {
+        // The latest batches first, which are of the deeper steps mostly,
+        // so that the frontier kept in memory stays small.
+        batches.emplace_back(std::move(pendingBatches_.back()));
+        pendingBatches_.pop_back();
+        inflightBatches_++;
+    }
+    return batches;
+}
+
+void GoExecutor::sendBatch(StepBatch batch) {
+    auto spaceId = ectx()->rctx()->session()->space();
+    auto step = batch.step;
+    auto record = step >= recordFrom_ && step <= steps_;
+    std::string filterPushdown = "";
+    if (FLAGS_filter_pushdown && step == steps_
+            && direction_ == OverClause::Direction::kForward) {
+        filterPushdown = whereWrapper_->filterPushdown_;
+    }
+    auto *runner = ectx()->rctx()->runner();
+    if (traverse_) {
+        // The filter is only applied on the last hop by storage
+        if (FLAGS_filter_pushdown && direction_ == OverClause::Direction::kForward) {
+            filterPushdown = whereWrapper_->filterPushdown_;
+        }
+        auto future = ectx()->getStorageClient()->traverse(spaceId,
+                                                           batch.vertices,
+                                                           edgeTypes_,
+                                                           filterPushdown,
+                                                           streamProps_[true],
+                                                           steps_ - step + 1);
+        std::move(future).via(runner).then([this, step] (folly::Try<RpcResponse> &&t) {
+            onBatchResponse(step, std::move(t));
+        });
+        return;
+    }
+    int64_t limit = truncates_.empty() ? -1 : truncates_[step - 1];
+    auto future = ectx()->getStorageClient()->getNeighbors(spaceId,
+                                                           batch.vertices,
+                                                           edgeTypes_,
+                                                           filterPushdown,
+                                                           streamProps_[record],
+                                                           limit,
+                                                           sample_);
+    std::move(future).via(runner).then([this, step] (folly::Try<RpcResponse> &&t) {
+        onBatchResponse(step, std::move(t));
+    });
+}
+
+void GoExecutor::onBatchResponse(uint32_t step, folly::Try<RpcResponse> &&result) {
+    std::vector<VertexID> dsts;
+    // step => vertices, the frontiers left by storage traverse
+    std::vector<std::pair<uint32_t, std::vector<VertexID>>> frontiers;
+    if (result.hasException()) {
+        LOG(ERROR) << "Exception when handle out-bounds/in-bounds: "
+                   << result.exception().what();
+    } else if (traverse_) {
+        for (auto &resp : result.value().responses()) {
+            if (!resp.__isset.frontiers) {
+                continue;
+            }
+            for (auto &frontier : resp.frontiers) {
+                auto stepsLeft = static_cast<uint32_t>(frontier.get_steps());
+                if (stepsLeft < 1 || stepsLeft > steps_ - step) {
+                    LOG(ERROR) << "Invalid frontier with " << stepsLeft << " steps left";
+                    continue;
+                }
+                frontiers.emplace_back(steps_ - stepsLeft + 1, std::move(frontier.vertices));
+            }
+        }
+    } else if (step < steps_) {
+        for (const auto &resp : result.value().responses()) {
+            if (!resp.__isset.vertices) {
+                continue;
+            }
+            for (const auto &vdata : resp.vertices) {
+                for (const auto &edata : vdata.edge_data) {
+                    for (const auto& edge : edata.get_edges()) {
+                        dsts.emplace_back(edge.get_dst());
+                    }
+                }
+            }
+        }
+    }
+    if (FLAGS_trace_go && result.hasValue()) {
+        for (auto &latency : result.value().hostLatency()) {
+            LOG(INFO) << "Step:" << step << ", " << std::get<0>(latency)
+                      << ", time cost " << std::get<1>(latency)
+                      << "us / " << std::get<2>(latency) << "us";
+        }
+    }
+
+    std::vector<StepBatch> batches;
+    bool finished = false;
+    {
+        std::lock_guard<std::mutex> g(streamLock_);
+        inflightBatches_--;
+        // All the rows are of the last hop when traverse
+        auto &resps = stepResps_[traverse_ ? steps_ : step];
+        if (result.hasException()) {
+            // Take it as the host failed
+            RpcResponse failed(1);
+            failed.markFailure();
+            resps.emplace_back(std::move(failed));
+        } else {
+            resps.emplace_back(std::move(result).value());
+        }
+        if (!dsts.empty()) {
+            enqueueBatches(step + 1, std::move(dsts));
+        }
+        for (auto &frontier : frontiers) {
+            enqueueBatches(frontier.first, std::move(frontier.second));
+        }
+        batches = popBatches();
+        finished = inflightBatches_ == 0 && pendingBatches_.empty();
+    }
+    for (auto &batch : batches) {
+        sendBatch(std::move(batch));
+    }
+    if (finished) {
+        onStreamFinished();
+    }
+}
+
+void GoExecutor::onStreamFinished() {
+    if (!streamStatus_.ok()) {
+        doError(std::move(streamStatus_));
+        return;
+    }
+    uint32_t from = 1;
+    if (traverse_) {
+        // The hops before the last one are expanded by storage, no records for them
+        for (; from < steps_; from++) {
+            records_.emplace_back(0);
+        }
+        dedupLastHop(stepResps_[steps_]);
+    }
+    for (curStep_ = from; curStep_ <= steps_; curStep_++) {
+        auto &resps = stepResps_[curStep_];
+        if (resps.empty()) {
+            // Should not happen, a step is requested once the previous one has dst
+            curStep_--;
+            GO_EXIT();
+        }
+        RpcResponse merged(resps.size());
+        for (auto &resp : resps) {
+            if (resp.completeness() != 100) {
+                merged.markFailure();
+            }
+            for (auto &part : resp.failedParts()) {
+                merged.failedParts().emplace(part.first, part.second);
+            }
+            for (auto &latency : resp.hostLatency()) {
+                merged.setLatency(std::get<0>(latency),
+                                  std::get<1>(latency),
+                                  std::get<2>(latency));
+            }
+            auto &all = merged.responses();
+            all.insert(all.end(),
+                       std::make_move_iterator(resp.responses().begin()),
+                       std::make_move_iterator(resp.responses().end()));
+        }
+        if (merged.completeness() == 0) {
+            doError(Status::Error("Get neighbors failed"));
+            return;
+        } else if (merged.completeness() != 100) {
+            LOG(INFO) << "Get neighbors partially failed: "  << merged.completeness() << "%";
+            warningMsg_ = "Go executor was partially performed";
+        }
+        auto status = joinResp(std::move(merged));
+        if (!status.ok()) {
+            doError(std::move(status));
+            return;
+        }
+        auto dsts = getDstIdsFromRespWithBackTrack(records_.back());
+        if (isFinalStep() || dsts.empty()) {
+            GO_EXIT();
+        }
+    }
+}
+
 #undef GO_EXIT
 
+void GoExecutor::dedupLastHop(std::vector<RpcResponse> &resps) const {
+    std::unordered_set<VertexID> srcs;
+    for (auto &resp : resps) {
+        for (auto &queryResp : resp.responses()) {
+            if (!queryResp.__isset.vertices) {
+                continue;
+            }
+            auto &vertices = queryResp.vertices;
+            vertices.erase(std::remove_if(vertices.begin(), vertices.end(),
+                                          [&srcs] (const auto &vdata) {
+                                              return !srcs.emplace(vdata.get_vertex_id()).second;
+                                          }),
+                           vertices.end());
+        }
+    }
+}
+
 void GoExecutor::maybeFinishExecution() {
     auto requireDstProps = expCtx_->hasDstTagProp();
 
@@ -837,9 +1154,9 @@ StatusOr<std::vector<cpp2::RowValue>> GoExecutor::toThriftResponse() const {
     return rows;
 }
 
-StatusOr<std::vector<storage::cpp2::PropDef>> GoExecutor::getStepOutProps() {
+StatusOr<std::vector<storage::cpp2::PropDef>> GoExecutor::getStepOutProps(bool record) {
     std::vector<storage::cpp2::PropDef> props;
-    if (!isRecord()) {
+    if (!record) {
         for (auto &e : edgeTypes_) {
             storage::cpp2::PropDef pd;
             pd.owner = storage::cpp2::PropOwner::EDGE;
@@ -1411,8 +1728,31 @@ void GoExecutor::VertexHolder::add(
     }
 }
 
-void GoExecutor::joinResp(RpcResponse &&resp) {
+Status GoExecutor::joinResp(RpcResponse &&resp) {
+    int64_t size = sizeof(RpcResponse);
+    for (auto &qresp : resp.responses()) {
+        for (auto &vdata : qresp.vertices) {
+            size += sizeof(storage::cpp2::VertexData);
+            for (auto &td : vdata.tag_data) {
+                size += sizeof(td) + td.data.size();
+            }
+            for (auto &edata : vdata.edge_data) {
+                size += sizeof(edata);
+                for (auto &edge : edata.edges) {
+                    size += sizeof(edge) + edge.props.size();
+                }
+            }
+        }
+    }
+    if (!ectx()->memTracker()->tryConsume(size)) {
+        LOG(ERROR) << "Memory limit exceeded in step " << curStep_ << ", the query takes "
+                   << ectx()->memTracker()->used() << " bytes";
+        return Status::Error("Memory limit exceeded, the result of step %u is too large",
+                             curStep_);
+    }
+    charged_ += size;
     records_.emplace_back(std::move(resp));
+    return Status::OK();
 }
 
 }   // namespace graph
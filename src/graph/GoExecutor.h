@@ -12,6 +12,8 @@
 #include "storage/client/StorageClient.h"
 
 DECLARE_bool(filter_pushdown);
+DECLARE_bool(go_streaming_expansion);
+DECLARE_bool(go_storage_traverse);
 
 namespace nebula {
 
@@ -35,6 +37,8 @@ class GoExecutor final : public TraverseExecutor {
 public:
     GoExecutor(Sentence *sentence, ExecutionContext *ectx);
 
+    ~GoExecutor();
+
     const char* name() const override {
         return "GoExecutor";
     }
@@ -65,6 +69,8 @@ private:
 
     Status prepareDistinct();
 
+    Status prepareTruncate();
+
     Status prepareOverAll();
 
     Status addToEdgeTypes(EdgeType type);
@@ -102,6 +108,43 @@ private:
      */
     void onStepOutResponse(RpcResponse &&rpcResp);
 
+    /**
+     * Streaming expansion for multiple steps: the response of each host is expanded
+     * at once, instead of waiting for all hosts of the current step.
+     * The responses are kept by step, and replayed step by step at last,
+     * so the back tracing and the results are the same as stepOut.
+     */
+    void streamOut();
+
+    struct StepBatch {
+        uint32_t                step;
+        std::vector<VertexID>   vertices;
+    };
+
+    // Put the vertices not requested in the step yet into pending batches by host.
+    // Should be called with streamLock_ held.
+    void enqueueBatches(uint32_t step, std::vector<VertexID> vertices);
+
+    // Pop the pending batches allowed by the in-flight limit.
+    // Should be called with streamLock_ held.
+    std::vector<StepBatch> popBatches();
+
+    void sendBatch(StepBatch batch);
+
+    void onBatchResponse(uint32_t step, folly::Try<RpcResponse> &&result);
+
+    void onStreamFinished();
+
+    /**
+     * Whether the hops could be expanded by storage, which is true if only the last
+     * step is recorded and no back tracing to the inputs needed.
+     */
+    bool canTraverseOnStorage() const;
+
+    // Keep only one row for each source vertex of the last hop, which may be reached
+    // both on storage and by the frontiers.
+    void dedupLastHop(std::vector<RpcResponse> &resps) const;
+
     /**
      * Callback invoked when the stepping out action reaches the dead end.
      */
@@ -112,7 +155,7 @@ private:
      */
     void onVertexProps(RpcResponse &&rpcResp);
 
-    StatusOr<std::vector<storage::cpp2::PropDef>> getStepOutProps();
+    StatusOr<std::vector<storage::cpp2::PropDef>> getStepOutProps(bool record);
     StatusOr<std::vector<storage::cpp2::PropDef>> getDstProps();
 
     void fetchVertexProps(std::vector<VertexID> ids);
@@ -213,7 +256,8 @@ private:
     };
 
     // Join the RPC response to previous data
-    void joinResp(RpcResponse &&resp);
+    // Keep the response of the current step, if the memory limit allows
+    Status joinResp(RpcResponse &&resp);
 
     std::vector<VertexID> getRoots(VertexID srcId, std::size_t record) const {
         CHECK_GT(record, 0);
@@ -236,6 +280,9 @@ private:
     uint32_t                                    recordFrom_{1};
     uint32_t                                    steps_{1};
     uint32_t                                    curStep_{1};
+    // The max edges of each edge type for one vertex in every step, by LIMIT or SAMPLE
+    std::vector<int64_t>                        truncates_;
+    bool                                        sample_{false};
     OverClause::Direction                       direction_{OverClause::Direction::kForward};
     std::vector<EdgeType>                       edgeTypes_;
     std::string                                *varname_{nullptr};
@@ -254,6 +301,19 @@ private:
     std::unique_ptr<cpp2::ExecutionResponse>    resp_;
     // Record the data of response in GO step
     std::vector<RpcResponse>                    records_;
+    // The bytes of records_ taken from the memory tracker
+    int64_t                                     charged_{0};
+    // For streaming expansion, indexed by step
+    std::mutex                                  streamLock_;
+    std::vector<std::unordered_set<VertexID>>   requested_;
+    std::vector<std::vector<RpcResponse>>       stepResps_;
+    // The props to get in the steps not recorded and recorded
+    std::vector<storage::cpp2::PropDef>         streamProps_[2];
+    std::deque<StepBatch>                       pendingBatches_;
+    int32_t                                     inflightBatches_{0};
+    Status                                      streamStatus_;
+    // Expand the steps by storage traverse in streaming expansion
+    bool                                        traverse_{false};
     // The name of Tag or Edge, index of prop in data
     using SchemaPropIndex = std::unordered_map<std::pair<std::string, std::string>, int64_t>;
     std::string                                  warningMsg_;
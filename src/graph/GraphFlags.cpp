@@ -39,3 +39,9 @@ DEFINE_string(auth_type, "password", "User login authentication type,"
                                      "cloud for cloud authentication");
 
 DEFINE_string(cloud_http_url, "", "cloud http url including ip, port, url path");
+
+DEFINE_int64(graph_memory_limit_mb, 0, "The memory all the queries could take in graphd, "
+                                       "0 means no limit");
+DEFINE_int64(query_memory_limit_mb, 0, "The memory one query could take, 0 means no limit");
+DEFINE_string(graph_spill_dir, "/tmp", "The directory to spill the sort and group by data to, "
+                                       "when the memory limit is reached");
@@ -35,4 +35,8 @@ DECLARE_string(auth_type);
 
 DECLARE_string(cloud_http_url);
 
+DECLARE_int64(graph_memory_limit_mb);
+DECLARE_int64(query_memory_limit_mb);
+DECLARE_string(graph_spill_dir);
+
 #endif  // GRAPH_GRAPHFLAGS_H_
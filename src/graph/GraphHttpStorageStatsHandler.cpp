@@ -0,0 +1,56 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "graph/GraphHttpStorageStatsHandler.h"
+#include "network/NetworkUtils.h"
+#include "storage/client/HostStats.h"
+#include <proxygen/lib/http/ProxygenErrorEnum.h>
+
+namespace nebula {
+namespace graph {
+
+using proxygen::ProxygenError;
+
+void GraphHttpStorageStatsHandler::onError(ProxygenError err) noexcept {
+    LOG(ERROR) << "Web service GraphHttpStorageStatsHandler got error: "
+               << proxygen::getErrorString(err);
+    delete this;
+}
+
+folly::dynamic GraphHttpStorageStatsHandler::getStats() const {
+    auto stats = folly::dynamic::array();
+    for (auto& host : storage::HostStats::instance().snapshot()) {
+        auto prefix = folly::stringPrintf("%s:%d.",
+                                          network::NetworkUtils::intToIPv4(host.host.first).c_str(),
+                                          host.host.second);
+        std::vector<std::pair<std::string, int64_t>> values = {
+            {"inflight", host.inflight},
+            {"latency_us", host.latencyUs},
+            {"requests", host.requests},
+            {"failures", host.failures},
+            {"hedges", host.hedges},
+            {"timeouts", host.timeouts},
+        };
+        for (auto& value : values) {
+            auto name = prefix + value.first;
+            if (!statFiltered(name)) {
+                addOneStat(stats, name, value.second);
+            }
+        }
+    }
+    return stats;
+}
+
+bool GraphHttpStorageStatsHandler::statFiltered(const std::string& stat) const {
+    if (statNames_.empty()) {
+        return false;
+    }
+    return std::find(statNames_.begin(), statNames_.end(), stat) == statNames_.end();
+}
+
+}  // namespace graph
+}  // namespace nebula
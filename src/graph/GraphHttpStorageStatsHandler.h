@@ -0,0 +1,33 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_GRAPHHTTPSTORAGESTATSHANDLER_H_
+#define GRAPH_GRAPHHTTPSTORAGESTATSHANDLER_H_
+
+#include "base/Base.h"
+#include "webservice/GetStatsHandler.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * Export the load of the storage hosts seen by the storage client, one stat for each
+ * of the host's in-flight requests, latency, requests, failures, hedges and timeouts,
+ * named like "192.168.8.5:44500.latency_us".
+ * */
+class GraphHttpStorageStatsHandler : public nebula::GetStatsHandler {
+public:
+    GraphHttpStorageStatsHandler() = default;
+    void onError(proxygen::ProxygenError err) noexcept override;
+    folly::dynamic getStats() const override;
+
+private:
+    bool statFiltered(const std::string& stat) const;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_GRAPHHTTPSTORAGESTATSHANDLER_H_
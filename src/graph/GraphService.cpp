@@ -143,6 +143,28 @@ GraphService::future_execute(int64_t sessionId, const std::string& query) {
 }
 
 
+folly::Future<cpp2::ExecutionResponse>
+GraphService::future_bulkInsert(int64_t sessionId, const cpp2::BulkInsertRequest& req) {
+    auto ctx = std::make_unique<RequestContext<cpp2::ExecutionResponse>>();
+    ctx->setRunner(getThreadManager());
+    auto future = ctx->future();
+    {
+        auto result = sessionManager_->findSession(sessionId);
+        if (!result.ok()) {
+            FLOG_ERROR("Session not found, id[%ld]", sessionId);
+            ctx->resp().set_error_code(cpp2::ErrorCode::E_SESSION_INVALID);
+            ctx->resp().set_error_msg(result.status().toString());
+            ctx->finish();
+            return future;
+        }
+        ctx->setSession(std::move(result).value());
+    }
+    executionEngine_->bulkInsert(std::move(ctx), req);
+
+    return future;
+}
+
+
 const char* GraphService::getErrorStr(cpp2::ErrorCode result) {
     switch (result) {
     case cpp2::ErrorCode::SUCCEEDED:
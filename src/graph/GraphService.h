@@ -37,6 +37,9 @@ public:
     folly::Future<cpp2::ExecutionResponse>
     future_execute(int64_t sessionId, const std::string& stmt) override;
 
+    folly::Future<cpp2::ExecutionResponse>
+    future_bulkInsert(int64_t sessionId, const cpp2::BulkInsertRequest& req) override;
+
     const char* getErrorStr(cpp2::ErrorCode result);
 
 private:
@@ -6,7 +6,7 @@
 
 #include "base/Base.h"
 #include "graph/GroupByExecutor.h"
-#include "graph/AggregateFunction.h"
+#include <folly/hash/Hash.h>
 
 namespace nebula {
 namespace graph {
@@ -17,6 +17,11 @@ GroupByExecutor::GroupByExecutor(Sentence *sentence, ExecutionContext *ectx)
 }
 
 
+GroupByExecutor::~GroupByExecutor() {
+    ectx()->memTracker()->release(charged_ + resultCharged_.second);
+}
+
+
 Status GroupByExecutor::prepare() {
     expCtx_ = std::make_unique<ExpressionContext>();
     Status status;
@@ -189,17 +194,6 @@ void GroupByExecutor::execute() {
         doError(std::move(status));
         return;
     }
-    auto ret = inputs_->getRows();
-    if (!ret.ok()) {
-        LOG(ERROR) << "Get rows failed: " << ret.status();
-        doError(std::move(ret).status());
-        return;
-    }
-    rows_ = std::move(ret).value();
-    if (rows_.empty()) {
-        onEmptyInputs();
-        return;
-    }
     schema_ = inputs_->schema();
 
     status = checkAll();
@@ -213,6 +207,10 @@ void GroupByExecutor::execute() {
         doError(std::move(status));
         return;
     }
+    if (rows_.empty()) {
+        onEmptyInputs();
+        return;
+    }
 
     status = generateOutputSchema();
     if (!status.ok()) {
@@ -234,91 +232,243 @@ void GroupByExecutor::execute() {
 
 
 Status GroupByExecutor::groupingData() {
-    using FunCols = std::vector<std::shared_ptr<AggFun>>;
-    // key : the column values of group by, val: function table of aggregated columns
-    using GroupData = std::unordered_map<ColVals, FunCols, ColsHasher>;
+    Partitions partitions;
+    auto aggregator = makeHashAggregator(&partitions);
+    if (aggregator != nullptr) {
+        auto status = inputs_->forEachRow([&] (cpp2::RowValue &&row) {
+            return aggregator->add(std::move(row));
+        });
+        if (!status.ok()) {
+            LOG(ERROR) << "Get rows failed: " << status;
+            return status;
+        }
+        status = aggregator->finish(&rows_);
+        if (!status.ok()) {
+            return status;
+        }
+        chargeResults();
+        // The spilled groups are left to AggFun
+        return aggregatePartitions(std::move(partitions), 1);
+    }
 
     GroupData data;
-    Getters getters;
-    for (auto& it : rows_) {
-        ColVals groupVals;
-        FunCols calVals;
+    auto status = inputs_->forEachRow([&] (cpp2::RowValue &&row) {
+        return aggregate(row, 0, &data, &partitions);
+    });
+    if (!status.ok()) {
+        LOG(ERROR) << "Get rows failed: " << status;
+        return status;
+    }
+    outputGroups(&data);
+    return aggregatePartitions(std::move(partitions), 1);
+}
 
-        // Firstly: group the cols
-        for (auto &col : groupCols_) {
-            cpp2::ColumnValue::Type valType = cpp2::ColumnValue::Type::__EMPTY__;
-            getters.getInputProp = [&] (const std::string & prop) -> OptVariantType {
-                auto indexIt = schemaMap_.find(prop);
-                if (indexIt == schemaMap_.end()) {
-                    LOG(ERROR) << prop <<  " is nonexistent";
-                    return Status::Error("%s is nonexistent", prop.c_str());
-                }
-                auto val = it.columns[indexIt->second];
-                valType = val.getType();
-                return toVariantType(val);
-            };
-
-            auto eval = col->expr()->eval(getters);
-            if (!eval.ok()) {
-                return eval.status();
-            }
 
-            auto cVal = toColumnValue(eval.value(), valType);
-            if (!cVal.ok()) {
-                return cVal.status();
+std::unique_ptr<HashAggregator> GroupByExecutor::makeHashAggregator(Partitions *partitions) {
+    using Kind = HashAggregator::Kind;
+    static const std::unordered_map<std::string, Kind> kinds = {
+        {"", Kind::GROUP},
+        {kCount, Kind::COUNT},
+        {kCountDist, Kind::COUNT_DISTINCT},
+        {kSum, Kind::SUM},
+        {kAvg, Kind::AVG},
+        {kMax, Kind::MAX},
+        {kMin, Kind::MIN},
+    };
+
+    std::vector<HashAggregator::KeyCol> keys;
+    for (auto *col : groupCols_) {
+        if (!col->expr()->isInputExpression()) {
+            return nullptr;
+        }
+        auto *prop = static_cast<InputPropertyExpression*>(col->expr())->prop();
+        auto index = schemaMap_[*prop];
+        keys.emplace_back();
+        keys.back().index = index;
+        keys.back().type = schema_->getFieldType(index).type;
+        if (!HashAggregator::isSupported(keys.back())) {
+            return nullptr;
+        }
+    }
+
+    std::vector<HashAggregator::AggCol> aggs;
+    for (auto *col : yieldCols_) {
+        auto kind = kinds.find(col->getFunName());
+        if (kind == kinds.end()) {
+            return nullptr;
+        }
+        aggs.emplace_back();
+        auto &agg = aggs.back();
+        agg.kind = kind->second;
+        agg.index = -1;
+        agg.type = nebula::cpp2::SupportedType::UNKNOWN;
+        agg.key = 0;
+        if (agg.kind == Kind::COUNT && col->expr()->toString() == "*") {
+            continue;
+        }
+        if (!col->expr()->isInputExpression()) {
+            return nullptr;
+        }
+        auto *prop = static_cast<InputPropertyExpression*>(col->expr())->prop();
+        agg.index = schemaMap_[*prop];
+        agg.type = schema_->getFieldType(agg.index).type;
+        if (agg.kind == Kind::GROUP) {
+            auto key = std::find_if(keys.begin(), keys.end(), [&] (auto &k) {
+                return static_cast<int64_t>(k.index) == agg.index;
+            });
+            if (key == keys.end()) {
+                return nullptr;
             }
-            groupVals.vec.emplace_back(std::move(cVal).value());
+            agg.key = key - keys.begin();
         }
+        if (!HashAggregator::isSupported(agg)) {
+            return nullptr;
+        }
+    }
 
-        auto findIt = data.find(groupVals);
+    auto spillFn = [this, partitions] (const cpp2::RowValue &row, uint64_t hash) {
+        return spill(row, hash, 0, partitions);
+    };
+    return std::make_unique<HashAggregator>(std::move(keys),
+                                            std::move(aggs),
+                                            ectx()->memTracker(),
+                                            std::move(spillFn));
+}
 
-        // Secondly: get the value of the aggregated column
 
-        // Get all aggregation function
-        if (findIt == data.end()) {
-            for (auto &col : yieldCols_) {
-                auto funPtr = funVec[col->getFunName()]();
-                calVals.emplace_back(std::move(funPtr));
+Status GroupByExecutor::aggregate(const cpp2::RowValue &row,
+                                  int32_t level,
+                                  GroupData *data,
+                                  Partitions *partitions) {
+    Getters getters;
+    ColVals groupVals;
+
+    // Firstly: group the cols
+    for (auto &col : groupCols_) {
+        cpp2::ColumnValue::Type valType = cpp2::ColumnValue::Type::__EMPTY__;
+        getters.getInputProp = [&] (const std::string & prop) -> OptVariantType {
+            auto indexIt = schemaMap_.find(prop);
+            if (indexIt == schemaMap_.end()) {
+                LOG(ERROR) << prop <<  " is nonexistent";
+                return Status::Error("%s is nonexistent", prop.c_str());
             }
-        } else {
-            calVals = findIt->second;
-        }
-
-        // Apply value
-        auto i = 0u;
-        for (auto &col : calVals) {
-            cpp2::ColumnValue::Type valType = cpp2::ColumnValue::Type::__EMPTY__;
-            getters.getInputProp = [&] (const std::string &prop) -> OptVariantType{
-                auto indexIt = schemaMap_.find(prop);
-                if (indexIt == schemaMap_.end()) {
-                    LOG(ERROR) << prop <<  " is nonexistent";
-                    return Status::Error("%s is nonexistent", prop.c_str());
-                }
-                auto val = it.columns[indexIt->second];
-                valType = val.getType();
-                return toVariantType(val);
-            };
-            auto eval = yieldCols_[i]->expr()->eval(getters);
-            if (!eval.ok()) {
-                return eval.status();
+            auto val = row.columns[indexIt->second];
+            valType = val.getType();
+            return toVariantType(val);
+        };
+
+        auto eval = col->expr()->eval(getters);
+        if (!eval.ok()) {
+            return eval.status();
+        }
+
+        auto cVal = toColumnValue(eval.value(), valType);
+        if (!cVal.ok()) {
+            return cVal.status();
+        }
+        groupVals.vec.emplace_back(std::move(cVal).value());
+    }
+
+    auto findIt = data->find(groupVals);
+
+    // Secondly: get the value of the aggregated column
+
+    // Get all aggregation function
+    if (findIt == data->end()) {
+        // A new group, put the row aside if its partition has spilled, where the group
+        // might already be, or if it is over the memory limit
+        auto hash = ColsHasher()(groupVals);
+        if (level < kMaxSpillLevel && !partitions->empty() &&
+            (*partitions)[partitionOf(hash, level)] != nullptr) {
+            return spill(row, hash, level, partitions);
+        }
+        auto size = groupSize(groupVals);
+        if (!ectx()->memTracker()->tryConsume(size)) {
+            if (level < kMaxSpillLevel) {
+                return spill(row, hash, level, partitions);
             }
+            ectx()->memTracker()->consume(size);
+        }
+        charged_ += size;
+
+        FunCols calVals;
+        for (auto &col : yieldCols_) {
+            auto funPtr = funVec[col->getFunName()]();
+            calVals.emplace_back(std::move(funPtr));
+        }
+        findIt = data->emplace(std::move(groupVals), std::move(calVals)).first;
+    }
 
-            auto cVal = toColumnValue(std::move(eval).value(), valType);
-            if (!cVal.ok()) {
-                return cVal.status();
+    // Apply value
+    auto i = 0u;
+    for (auto &col : findIt->second) {
+        cpp2::ColumnValue::Type valType = cpp2::ColumnValue::Type::__EMPTY__;
+        getters.getInputProp = [&] (const std::string &prop) -> OptVariantType{
+            auto indexIt = schemaMap_.find(prop);
+            if (indexIt == schemaMap_.end()) {
+                LOG(ERROR) << prop <<  " is nonexistent";
+                return Status::Error("%s is nonexistent", prop.c_str());
             }
-            col->apply(cVal.value());
-            i++;
+            auto val = row.columns[indexIt->second];
+            valType = val.getType();
+            return toVariantType(val);
+        };
+        auto eval = yieldCols_[i]->expr()->eval(getters);
+        if (!eval.ok()) {
+            return eval.status();
         }
 
-        if (findIt == data.end()) {
-            data.emplace(std::move(groupVals), std::move(calVals));
+        auto cVal = toColumnValue(std::move(eval).value(), valType);
+        if (!cVal.ok()) {
+            return cVal.status();
         }
+        col->apply(cVal.value());
+        i++;
     }
+    return Status::OK();
+}
+
+
+int64_t GroupByExecutor::groupSize(const ColVals &groupVals) const {
+    int64_t size = sizeof(ColVals) + yieldCols_.size() * kAggFunSize;
+    for (auto &col : groupVals.vec) {
+        size += sizeof(cpp2::ColumnValue);
+        if (col.getType() == cpp2::ColumnValue::Type::str) {
+            size += col.get_str().capacity();
+        }
+    }
+    return size;
+}
+
+
+Status GroupByExecutor::spill(const cpp2::RowValue &row,
+                              uint64_t hash,
+                              int32_t level,
+                              Partitions *partitions) {
+    if (partitions->empty()) {
+        partitions->resize(kSpillPartitions);
+    }
+    auto &partition = (*partitions)[partitionOf(hash, level)];
+    if (partition == nullptr) {
+        auto file = SpillFile::create();
+        if (!file.ok()) {
+            return file.status();
+        }
+        partition = std::move(file).value();
+    }
+    return partition->write(row);
+}
+
+
+size_t GroupByExecutor::partitionOf(uint64_t hash, int32_t level) {
+    // Split the groups differently in every level
+    return folly::hash::twang_mix64(hash + level) % kSpillPartitions;
+}
 
+
+void GroupByExecutor::outputGroups(GroupData *data) {
     // Generate result data
-    rows_.clear();
-    for (auto& item : data) {
+    for (auto& item : *data) {
         std::vector<cpp2::ColumnValue> row;
         for (auto& col : item.second) {
             row.emplace_back(col->getResult());
@@ -326,7 +476,59 @@ Status GroupByExecutor::groupingData() {
         rows_.emplace_back();
         rows_.back().set_columns(std::move(row));
     }
+    data->clear();
+    ectx()->memTracker()->release(charged_);
+    charged_ = 0;
+    chargeResults();
+}
+
+
+void GroupByExecutor::chargeResults() {
+    // The result to response is taken whatever the limit
+    int64_t size = 0;
+    for (auto i = resultCharged_.first; i < rows_.size(); i++) {
+        size += MemoryTracker::rowSize(rows_[i]);
+    }
+    ectx()->memTracker()->consume(size);
+    resultCharged_.first = rows_.size();
+    resultCharged_.second += size;
+}
 
+
+Status GroupByExecutor::aggregatePartitions(Partitions partitions, int32_t level) {
+    // Every partition has its own groups, which are all in memory if it is small enough
+    for (auto &partition : partitions) {
+        if (partition == nullptr) {
+            continue;
+        }
+        VLOG(1) << "Aggregate " << partition->rows() << " spilled rows in level " << level;
+        auto status = partition->rewind();
+        if (!status.ok()) {
+            return status;
+        }
+        GroupData data;
+        Partitions subPartitions;
+        while (true) {
+            cpp2::RowValue row;
+            auto ret = partition->read(&row);
+            if (!ret.ok()) {
+                return ret.status();
+            }
+            if (!ret.value()) {
+                break;
+            }
+            status = aggregate(row, level, &data, &subPartitions);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+        partition.reset();
+        outputGroups(&data);
+        status = aggregatePartitions(std::move(subPartitions), level + 1);
+        if (!status.ok()) {
+            return status;
+        }
+    }
     return Status::OK();
 }
 
@@ -8,15 +8,23 @@
 #define GRAPH_GROUPBYEXECUTOR_H_
 
 #include "base/Base.h"
+#include <gtest/gtest_prod.h>
 #include "graph/TraverseExecutor.h"
+#include "graph/AggregateFunction.h"
+#include "graph/SpillFile.h"
+#include "graph/HashAggregator.h"
 
 namespace nebula {
 namespace graph {
 
 class GroupByExecutor final : public TraverseExecutor {
+    FRIEND_TEST(GroupByExecutor, SpillWholeGroups);
+
 public:
     GroupByExecutor(Sentence *sentence, ExecutionContext *ectx);
 
+    ~GroupByExecutor();
+
     const char* name() const override {
         return "GroupByExecutor";
     }
@@ -28,11 +36,50 @@ public:
     void setupResponse(cpp2::ExecutionResponse &resp) override;
 
 private:
+    using FunCols = std::vector<std::shared_ptr<AggFun>>;
+    // key : the column values of group by, val: function table of aggregated columns
+    using GroupData = std::unordered_map<ColVals, FunCols, ColsHasher>;
+    // The rows of the new groups over the memory limit, split by the hash of the groups
+    using Partitions = std::vector<std::unique_ptr<SpillFile>>;
+
     Status prepareGroup();
     Status prepareYield();
     Status checkAll();
 
     Status groupingData();
+
+    /**
+     * The typed hash aggregation, if all the group keys and aggregated values are
+     * input columns of the supported types, otherwise nullptr.
+     * */
+    std::unique_ptr<HashAggregator> makeHashAggregator(Partitions *partitions);
+
+    /**
+     * Apply the row to its group. If the group is new, and the memory limit is reached
+     * or its partition has spilled, the row is spilled to its partition, which is
+     * aggregated in the next level. So a group is either in memory or on disk as a whole.
+     * */
+    Status aggregate(const cpp2::RowValue &row,
+                     int32_t level,
+                     GroupData *data,
+                     Partitions *partitions);
+
+    Status spill(const cpp2::RowValue &row,
+                 uint64_t hash,
+                 int32_t level,
+                 Partitions *partitions);
+
+    static size_t partitionOf(uint64_t hash, int32_t level);
+
+    Status aggregatePartitions(Partitions partitions, int32_t level);
+
+    // Move the results of the groups to rows_
+    void outputGroups(GroupData *data);
+
+    // Charge the rows newly added to rows_
+    void chargeResults();
+
+    int64_t groupSize(const ColVals &groupVals) const;
     Status generateOutputSchema();
 
     std::vector<std::string> getResultColumnNames() const;
@@ -41,6 +88,12 @@ private:
     void onEmptyInputs();
 
 private:
+    // The groups are always kept in memory from this level
+    static constexpr int32_t kMaxSpillLevel = 3;
+    static constexpr size_t kSpillPartitions = 16;
+    // The approximate bytes of an aggregation function
+    static constexpr int64_t kAggFunSize = 64;
+
     GroupBySentence                                           *sentence_{nullptr};
     std::vector<cpp2::RowValue>                                rows_;
     std::shared_ptr<const meta::SchemaProviderIf>              schema_{nullptr};
@@ -53,6 +106,10 @@ private:
     std::unordered_map<std::string, YieldColumn*>              aliases_;
     // input <fieldName, index>
     std::unordered_map<std::string, int64_t>                   schemaMap_;
+    // The bytes of the groups in memory taken from the memory tracker
+    int64_t                                                    charged_{0};
+    // The rows charged in rows_, and their bytes
+    std::pair<size_t, int64_t>                                 resultCharged_{0, 0};
 };
 }  // namespace graph
 }  // namespace nebula
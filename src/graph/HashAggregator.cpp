@@ -0,0 +1,476 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "graph/HashAggregator.h"
+#include <folly/hash/Hash.h>
+
+namespace nebula {
+namespace graph {
+
+using nebula::cpp2::SupportedType;
+
+size_t HashAggregator::KeyHasher::operator()(folly::StringPiece key) const {
+    return folly::hash::fnv64_buf(key.data(), key.size());
+}
+
+
+bool HashAggregator::isInt(SupportedType type) {
+    return type == SupportedType::INT
+        || type == SupportedType::VID
+        || type == SupportedType::TIMESTAMP;
+}
+
+
+bool HashAggregator::isSupported(const KeyCol &key) {
+    // The doubles are left to AggFun, since NaN never equals to itself there
+    return isInt(key.type) || key.type == SupportedType::BOOL || key.type == SupportedType::STRING;
+}
+
+
+bool HashAggregator::isSupported(const AggCol &agg) {
+    switch (agg.kind) {
+        case Kind::GROUP:
+        case Kind::COUNT:
+            return true;
+        case Kind::COUNT_DISTINCT:
+            return isInt(agg.type) || agg.type == SupportedType::BOOL
+                || agg.type == SupportedType::STRING;
+        case Kind::AVG:
+            return agg.type == SupportedType::INT || agg.type == SupportedType::DOUBLE;
+        case Kind::SUM:
+        case Kind::MAX:
+        case Kind::MIN:
+            return isInt(agg.type) || agg.type == SupportedType::DOUBLE;
+    }
+    return false;
+}
+
+
+int64_t HashAggregator::toInt(const cpp2::ColumnValue &val, SupportedType type) {
+    switch (type) {
+        case SupportedType::INT:
+            return val.get_integer();
+        case SupportedType::VID:
+            return val.get_id();
+        case SupportedType::TIMESTAMP:
+            return val.get_timestamp();
+        case SupportedType::BOOL:
+            return val.get_bool_val() ? 1 : 0;
+        default:
+            LOG(FATAL) << "Not an integer type: " << static_cast<int32_t>(type);
+    }
+    return 0;
+}
+
+
+cpp2::ColumnValue HashAggregator::fromInt(int64_t val, SupportedType type) {
+    cpp2::ColumnValue col;
+    switch (type) {
+        case SupportedType::INT:
+            col.set_integer(val);
+            break;
+        case SupportedType::VID:
+            col.set_id(val);
+            break;
+        case SupportedType::TIMESTAMP:
+            col.set_timestamp(val);
+            break;
+        default:
+            LOG(FATAL) << "Not an integer type: " << static_cast<int32_t>(type);
+    }
+    return col;
+}
+
+
+HashAggregator::HashAggregator(std::vector<KeyCol> keys,
+                               std::vector<AggCol> aggs,
+                               MemoryTracker *tracker,
+                               SpillFn spill)
+    : keys_(std::move(keys))
+    , aggs_(std::move(aggs))
+    , tracker_(tracker)
+    , spill_(std::move(spill)) {
+    intKey_ = keys_.size() == 1 && keys_[0].type != SupportedType::STRING;
+    keyVals_.resize(keys_.size());
+    states_.resize(aggs_.size());
+    batch_.reserve(kBatchSize);
+}
+
+
+HashAggregator::~HashAggregator() {
+    tracker_->release(charged_);
+}
+
+
+Status HashAggregator::add(cpp2::RowValue &&row) {
+    batch_.emplace_back(std::move(row));
+    if (batch_.size() < kBatchSize) {
+        return Status::OK();
+    }
+    return processBatch();
+}
+
+
+Status HashAggregator::processBatch() {
+    auto status = findGroups();
+    if (!status.ok()) {
+        return status;
+    }
+    for (auto i = 0UL; i < aggs_.size(); i++) {
+        auto &agg = aggs_[i];
+        auto *state = &states_[i];
+        switch (agg.kind) {
+            case Kind::GROUP:
+                break;
+            case Kind::COUNT:
+                applyCount(state);
+                break;
+            case Kind::COUNT_DISTINCT:
+                applyDistinct(agg, state);
+                break;
+            case Kind::SUM:
+            case Kind::AVG:
+            case Kind::MAX:
+            case Kind::MIN:
+                if (agg.type == SupportedType::DOUBLE) {
+                    extractDoubles(agg.index);
+                    apply(agg.kind, doubleCol_, &state->doubles, state);
+                } else {
+                    extractInts(agg.index, agg.type);
+                    apply(agg.kind, intCol_, &state->ints, state);
+                }
+                break;
+        }
+    }
+    batch_.clear();
+    return Status::OK();
+}
+
+
+Status HashAggregator::findGroups() {
+    groupIds_.resize(batch_.size());
+    if (intKey_) {
+        extractInts(keys_[0].index, keys_[0].type);
+        for (auto i = 0UL; i < batch_.size(); i++) {
+            auto key = intCol_[i];
+            auto it = intGroups_.find(key);
+            if (it != intGroups_.end()) {
+                groupIds_[i] = it->second;
+                continue;
+            }
+            auto group = newGroup(i, folly::hash::twang_mix64(key));
+            if (!group.ok()) {
+                return group.status();
+            }
+            groupIds_[i] = group.value();
+            if (groupIds_[i] != kSpilled) {
+                intGroups_.emplace(key, groupIds_[i]);
+            }
+        }
+        return Status::OK();
+    }
+
+    for (auto i = 0UL; i < batch_.size(); i++) {
+        auto key = packKey(batch_[i]);
+        auto it = packedGroups_.find(key);
+        if (it != packedGroups_.end()) {
+            groupIds_[i] = it->second;
+            continue;
+        }
+        auto group = newGroup(i, KeyHasher()(key));
+        if (!group.ok()) {
+            return group.status();
+        }
+        groupIds_[i] = group.value();
+        if (groupIds_[i] != kSpilled) {
+            packedGroups_.emplace(store(key), groupIds_[i]);
+        }
+    }
+    return Status::OK();
+}
+
+
+folly::StringPiece HashAggregator::packKey(const cpp2::RowValue &row) {
+    packed_.clear();
+    for (auto &key : keys_) {
+        auto &col = row.columns[key.index];
+        if (key.type == SupportedType::STRING) {
+            auto &str = col.get_str();
+            uint32_t len = str.size();
+            packed_.append(reinterpret_cast<const char*>(&len), sizeof(len));
+            packed_.append(str);
+        } else {
+            auto val = toInt(col, key.type);
+            packed_.append(reinterpret_cast<const char*>(&val), sizeof(val));
+        }
+    }
+    return packed_;
+}
+
+
+folly::StringPiece HashAggregator::store(folly::StringPiece key) {
+    if (key.size() > arenaLeft_) {
+        auto size = key.size() > kArenaBlockSize ? key.size() : kArenaBlockSize;
+        arena_.emplace_back(new char[size]);
+        arenaPos_ = arena_.back().get();
+        arenaLeft_ = size;
+    }
+    ::memcpy(arenaPos_, key.data(), key.size());
+    folly::StringPiece stored(arenaPos_, key.size());
+    arenaPos_ += key.size();
+    arenaLeft_ -= key.size();
+    return stored;
+}
+
+
+StatusOr<uint32_t> HashAggregator::newGroup(size_t row, uint64_t hash) {
+    auto &values = batch_[row].columns;
+    int64_t size = aggs_.size() * kAggStateSize;
+    for (auto &key : keys_) {
+        size += sizeof(cpp2::ColumnValue) + sizeof(int64_t);
+        if (key.type == SupportedType::STRING) {
+            // Both in the arena and in keyVals_
+            size += 2 * values[key.index].get_str().size();
+        }
+    }
+    // Once a group of the partition is spilled, the later new groups of it are spilled too,
+    // whether the memory is freed or not, since the group might be one of them.
+    auto part = hash % kSpillParts;
+    if (spilledParts_.test(part) || !tracker_->tryConsume(size)) {
+        spilledParts_.set(part);
+        auto status = spill_(batch_[row], hash);
+        if (!status.ok()) {
+            return status;
+        }
+        return static_cast<uint32_t>(kSpilled);
+    }
+    charged_ += size;
+
+    for (auto i = 0UL; i < keys_.size(); i++) {
+        keyVals_[i].emplace_back(values[keys_[i].index]);
+    }
+    for (auto i = 0UL; i < aggs_.size(); i++) {
+        auto &agg = aggs_[i];
+        auto &state = states_[i];
+        switch (agg.kind) {
+            case Kind::GROUP:
+                break;
+            case Kind::COUNT:
+                state.counts.emplace_back(0);
+                break;
+            case Kind::COUNT_DISTINCT:
+                if (agg.type == SupportedType::STRING) {
+                    state.strSets.emplace_back();
+                } else {
+                    state.intSets.emplace_back();
+                }
+                break;
+            case Kind::SUM:
+            case Kind::AVG:
+            case Kind::MAX:
+            case Kind::MIN:
+                if (agg.type == SupportedType::DOUBLE) {
+                    state.doubles.emplace_back(0.0);
+                } else {
+                    state.ints.emplace_back(0);
+                }
+                state.counts.emplace_back(0);
+                break;
+        }
+    }
+    return groups_++;
+}
+
+
+void HashAggregator::extractInts(int64_t index, SupportedType type) {
+    intCol_.resize(batch_.size());
+    // Switch on the type once for the whole batch
+    switch (type) {
+        case SupportedType::INT:
+            for (auto i = 0UL; i < batch_.size(); i++) {
+                intCol_[i] = batch_[i].columns[index].get_integer();
+            }
+            break;
+        case SupportedType::VID:
+            for (auto i = 0UL; i < batch_.size(); i++) {
+                intCol_[i] = batch_[i].columns[index].get_id();
+            }
+            break;
+        case SupportedType::TIMESTAMP:
+            for (auto i = 0UL; i < batch_.size(); i++) {
+                intCol_[i] = batch_[i].columns[index].get_timestamp();
+            }
+            break;
+        case SupportedType::BOOL:
+            for (auto i = 0UL; i < batch_.size(); i++) {
+                intCol_[i] = batch_[i].columns[index].get_bool_val() ? 1 : 0;
+            }
+            break;
+        default:
+            LOG(FATAL) << "Not an integer type: " << static_cast<int32_t>(type);
+    }
+}
+
+
+void HashAggregator::extractDoubles(int64_t index) {
+    doubleCol_.resize(batch_.size());
+    for (auto i = 0UL; i < batch_.size(); i++) {
+        doubleCol_[i] = batch_[i].columns[index].get_double_precision();
+    }
+}
+
+
+void HashAggregator::applyCount(AggState *state) {
+    auto *counts = state->counts.data();
+    for (auto group : groupIds_) {
+        if (group != kSpilled) {
+            counts[group]++;
+        }
+    }
+}
+
+
+void HashAggregator::applyDistinct(const AggCol &agg, AggState *state) {
+    if (agg.type == SupportedType::STRING) {
+        for (auto i = 0UL; i < batch_.size(); i++) {
+            auto group = groupIds_[i];
+            if (group != kSpilled) {
+                state->strSets[group].emplace(batch_[i].columns[agg.index].get_str());
+            }
+        }
+        return;
+    }
+    extractInts(agg.index, agg.type);
+    for (auto i = 0UL; i < batch_.size(); i++) {
+        auto group = groupIds_[i];
+        if (group != kSpilled) {
+            state->intSets[group].emplace(intCol_[i]);
+        }
+    }
+}
+
+
+template <typename T>
+void HashAggregator::apply(Kind kind,
+                           const std::vector<T> &vals,
+                           std::vector<T> *accs,
+                           AggState *state) {
+    auto *acc = accs->data();
+    auto *counts = state->counts.data();
+    auto *groups = groupIds_.data();
+    auto num = vals.size();
+    switch (kind) {
+        case Kind::SUM:
+            for (auto i = 0UL; i < num; i++) {
+                if (groups[i] != kSpilled) {
+                    acc[groups[i]] += vals[i];
+                }
+            }
+            break;
+        case Kind::AVG:
+            for (auto i = 0UL; i < num; i++) {
+                if (groups[i] != kSpilled) {
+                    acc[groups[i]] += vals[i];
+                    counts[groups[i]]++;
+                }
+            }
+            break;
+        case Kind::MAX:
+            for (auto i = 0UL; i < num; i++) {
+                auto group = groups[i];
+                if (group != kSpilled && (counts[group]++ == 0 || vals[i] > acc[group])) {
+                    acc[group] = vals[i];
+                }
+            }
+            break;
+        case Kind::MIN:
+            for (auto i = 0UL; i < num; i++) {
+                auto group = groups[i];
+                if (group != kSpilled && (counts[group]++ == 0 || vals[i] < acc[group])) {
+                    acc[group] = vals[i];
+                }
+            }
+            break;
+        default:
+            LOG(FATAL) << "Unexpected aggregation " << static_cast<int32_t>(kind);
+    }
+}
+
+
+cpp2::ColumnValue HashAggregator::result(const AggCol &agg,
+                                         const AggState &state,
+                                         uint32_t group) const {
+    cpp2::ColumnValue col;
+    switch (agg.kind) {
+        case Kind::GROUP:
+            return keyVals_[agg.key][group];
+        case Kind::COUNT:
+            col.set_integer(state.counts[group]);
+            return col;
+        case Kind::COUNT_DISTINCT:
+            if (agg.type == SupportedType::STRING) {
+                col.set_integer(state.strSets[group].size());
+            } else {
+                col.set_integer(state.intSets[group].size());
+            }
+            return col;
+        case Kind::AVG:
+            if (agg.type == SupportedType::DOUBLE) {
+                col.set_double_precision(state.doubles[group] / state.counts[group]);
+            } else {
+                col.set_double_precision(static_cast<double>(state.ints[group]) /
+                                         state.counts[group]);
+            }
+            return col;
+        case Kind::SUM:
+        case Kind::MAX:
+        case Kind::MIN:
+            if (agg.type == SupportedType::DOUBLE) {
+                col.set_double_precision(state.doubles[group]);
+                return col;
+            }
+            return fromInt(state.ints[group], agg.type);
+    }
+    return col;
+}
+
+
+Status HashAggregator::finish(std::vector<cpp2::RowValue> *rows) {
+    if (!batch_.empty()) {
+        auto status = processBatch();
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    rows->reserve(rows->size() + groups_);
+    for (auto group = 0U; group < groups_; group++) {
+        std::vector<cpp2::ColumnValue> row;
+        row.reserve(aggs_.size());
+        for (auto i = 0UL; i < aggs_.size(); i++) {
+            row.emplace_back(result(aggs_[i], states_[i], group));
+        }
+        rows->emplace_back();
+        rows->back().set_columns(std::move(row));
+    }
+
+    groups_ = 0;
+    intGroups_.clear();
+    packedGroups_.clear();
+    arena_.clear();
+    arenaPos_ = nullptr;
+    arenaLeft_ = 0;
+    keyVals_.clear();
+    keyVals_.resize(keys_.size());
+    states_.clear();
+    states_.resize(aggs_.size());
+    tracker_->release(charged_);
+    charged_ = 0;
+    return Status::OK();
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,168 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_HASHAGGREGATOR_H_
+#define GRAPH_HASHAGGREGATOR_H_
+
+#include "base/Base.h"
+#include <bitset>
+#include "base/StatusOr.h"
+#include "gen-cpp2/graph_types.h"
+#include "graph/MemoryTracker.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * The hash aggregation of GROUP BY specialized on the column types, which is used when
+ * all the group keys and the aggregated values are input columns of the supported types.
+ * Otherwise GroupByExecutor falls back to evaluate the expressions and apply AggFun
+ * on every row.
+ *
+ * The rows are processed in batches. For a batch, the groups of all the rows are found
+ * first, with the key of a single integer column used as is, and the other keys packed
+ * into bytes kept in an arena. Then every aggregated column is extracted into a typed
+ * vector, and applied to the states of the groups in a tight loop.
+ *
+ * The results are the same as those of AggFun, in type and in value.
+ * */
+class HashAggregator final {
+public:
+    enum class Kind : uint8_t {
+        GROUP,              // The value of a group key
+        COUNT,
+        COUNT_DISTINCT,
+        SUM,
+        AVG,
+        MAX,
+        MIN,
+    };
+
+    struct KeyCol {
+        size_t                                      index;
+        nebula::cpp2::SupportedType                 type;
+    };
+
+    struct AggCol {
+        Kind                                        kind;
+        // The input column, -1 for COUNT(*)
+        int64_t                                     index;
+        nebula::cpp2::SupportedType                 type;
+        // For GROUP, the position of the key
+        size_t                                      key;
+    };
+
+    // Put aside a row of a new group over the memory limit, with the hash of the group
+    using SpillFn = std::function<Status(const cpp2::RowValue &row, uint64_t hash)>;
+
+    static bool isSupported(const KeyCol &key);
+
+    static bool isSupported(const AggCol &agg);
+
+    HashAggregator(std::vector<KeyCol> keys,
+                   std::vector<AggCol> aggs,
+                   MemoryTracker *tracker,
+                   SpillFn spill);
+
+    ~HashAggregator();
+
+    Status add(cpp2::RowValue &&row);
+
+    /**
+     * Process the rows left, and append the results of all the groups to rows.
+     * The memory of the groups is released then.
+     * */
+    Status finish(std::vector<cpp2::RowValue> *rows);
+
+private:
+    struct KeyHasher {
+        size_t operator()(folly::StringPiece key) const;
+    };
+
+    // The states of an aggregated column for all the groups
+    struct AggState {
+        std::vector<int64_t>                            ints;
+        std::vector<double>                             doubles;
+        std::vector<int64_t>                            counts;
+        std::vector<std::unordered_set<int64_t>>        intSets;
+        std::vector<std::unordered_set<std::string>>    strSets;
+    };
+
+    Status processBatch();
+
+    Status findGroups();
+
+    // Add a group for the row, or spill it and return kSpilled. A group is either
+    // in memory or spilled as a whole.
+    StatusOr<uint32_t> newGroup(size_t row, uint64_t hash);
+
+    folly::StringPiece packKey(const cpp2::RowValue &row);
+
+    // Copy the key into the arena
+    folly::StringPiece store(folly::StringPiece key);
+
+    // Extract the column of the batch into intCol_ or doubleCol_
+    void extractInts(int64_t index, nebula::cpp2::SupportedType type);
+
+    void extractDoubles(int64_t index);
+
+    void applyCount(AggState *state);
+
+    void applyDistinct(const AggCol &agg, AggState *state);
+
+    template <typename T>
+    void apply(Kind kind, const std::vector<T> &vals, std::vector<T> *accs, AggState *state);
+
+    cpp2::ColumnValue result(const AggCol &agg, const AggState &state, uint32_t group) const;
+
+    static bool isInt(nebula::cpp2::SupportedType type);
+
+    static int64_t toInt(const cpp2::ColumnValue &val, nebula::cpp2::SupportedType type);
+
+    static cpp2::ColumnValue fromInt(int64_t val, nebula::cpp2::SupportedType type);
+
+private:
+    static constexpr size_t kBatchSize = 1024;
+    static constexpr uint32_t kSpilled = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t kArenaBlockSize = 64 * 1024;
+    // The approximate bytes of the state of an aggregated column
+    static constexpr int64_t kAggStateSize = 16;
+    // The partitions of the new groups by hash, to remember the ones spilled
+    static constexpr size_t kSpillParts = 64;
+
+    std::vector<KeyCol>                                         keys_;
+    std::vector<AggCol>                                         aggs_;
+    MemoryTracker                                              *tracker_{nullptr};
+    SpillFn                                                     spill_;
+
+    // Whether the key is a single integer column
+    bool                                                        intKey_{false};
+    std::unordered_map<int64_t, uint32_t>                       intGroups_;
+    std::unordered_map<folly::StringPiece, uint32_t, KeyHasher> packedGroups_;
+    std::string                                                 packed_;
+    std::vector<std::unique_ptr<char[]>>                        arena_;
+    char                                                       *arenaPos_{nullptr};
+    size_t                                                      arenaLeft_{0};
+
+    std::bitset<kSpillParts>                                    spilledParts_;
+
+    uint32_t                                                    groups_{0};
+    // The values of every key column for all the groups
+    std::vector<std::vector<cpp2::ColumnValue>>                 keyVals_;
+    std::vector<AggState>                                       states_;
+
+    std::vector<cpp2::RowValue>                                 batch_;
+    std::vector<uint32_t>                                       groupIds_;
+    std::vector<int64_t>                                        intCol_;
+    std::vector<double>                                         doubleCol_;
+
+    // The bytes of the groups taken from the memory tracker
+    int64_t                                                     charged_{0};
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_HASHAGGREGATOR_H_
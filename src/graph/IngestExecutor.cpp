@@ -9,7 +9,6 @@
 #include "process/ProcessUtils.h"
 #include "webservice/Common.h"
 
-#include <folly/executors/Async.h>
 #include <folly/futures/Future.h>
 
 namespace nebula {
@@ -65,25 +64,21 @@ void IngestExecutor::execute() {
             metaHost.c_str(), FLAGS_ws_meta_http_port, spaceId);
     }
 
-    auto func = [url] {
-        auto result = http::HttpClient::get(url);
-        if (result.ok() && result.value() == "SSTFile ingest successfully") {
-            LOG(INFO) << "Ingest Successfully";
-            return true;
-        } else {
-            LOG(ERROR) << "Ingest Failed";
-            return false;
-        }
-    };
-    auto future = folly::async(func);
+    auto future = http::HttpClient::instance().asyncGet(url);
 
     auto *runner = ectx()->rctx()->runner();
 
-    auto cb = [this] (auto &&resp) {
-        if (!resp) {
+    auto cb = [this] (StatusOr<http::HttpResponse> &&result) {
+        if (!result.ok()) {
+            doError(Status::Error("Ingest Failed: %s", result.status().toString().c_str()));
+            return;
+        }
+        if (result.value().body != "SSTFile ingest successfully") {
+            LOG(ERROR) << "Ingest Failed: " << result.value().body;
             doError(Status::Error("Ingest Failed"));
             return;
         }
+        LOG(INFO) << "Ingest Successfully";
         resp_ = std::make_unique<cpp2::ExecutionResponse>();
         doFinish(Executor::ProcessControl::kNext);
     };
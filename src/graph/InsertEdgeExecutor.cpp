@@ -93,12 +93,6 @@ Status InsertEdgeExecutor::check() {
 
 
 StatusOr<std::vector<storage::cpp2::Edge>> InsertEdgeExecutor::prepareEdges() {
-    expCtx_ = std::make_unique<ExpressionContext>();
-    expCtx_->setStorageClient(ectx()->getStorageClient());
-
-    auto space = ectx()->rctx()->session()->space();
-    expCtx_->setSpace(space);
-
     std::vector<storage::cpp2::Edge> edges(rows_.size() * 2);   // inbound and outbound
     auto index = 0;
     Getters getters;
@@ -238,6 +232,25 @@ void InsertEdgeExecutor::execute() {
         return;
     }
 
+    expCtx_->setSpace(spaceId_);
+    std::vector<Expression*> exprs;
+    for (auto *row : rows_) {
+        exprs.emplace_back(row->srcid());
+        exprs.emplace_back(row->dstid());
+        auto values = row->values();
+        exprs.insert(exprs.end(), values.begin(), values.end());
+    }
+    resolveUUIDs(exprs, expCtx_.get()).thenValue([this] (Status uuidStatus) {
+        if (!uuidStatus.ok()) {
+            doError(std::move(uuidStatus));
+            return;
+        }
+        insertEdges();
+    });
+}
+
+
+void InsertEdgeExecutor::insertEdges() {
     auto result = prepareEdges();
     if (!result.ok()) {
         LOG(ERROR) << "Insert edge failed, error " << result.status();
@@ -29,6 +29,8 @@ private:
     Status check();
     StatusOr<std::vector<storage::cpp2::Edge>> prepareEdges();
 
+    void insertEdges();
+
 private:
     using EdgeSchema = std::shared_ptr<const meta::SchemaProviderIf>;
 
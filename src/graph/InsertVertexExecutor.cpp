@@ -229,6 +229,24 @@ void InsertVertexExecutor::execute() {
         return;
     }
 
+    std::vector<Expression*> exprs;
+    for (auto *row : rows_) {
+        exprs.emplace_back(row->id());
+        auto values = row->values();
+        exprs.insert(exprs.end(), values.begin(), values.end());
+    }
+    expCtx_->setSpace(spaceId_);
+    resolveUUIDs(exprs, expCtx_.get()).thenValue([this] (Status uuidStatus) {
+        if (!uuidStatus.ok()) {
+            doError(std::move(uuidStatus));
+            return;
+        }
+        insertVertices();
+    });
+}
+
+
+void InsertVertexExecutor::insertVertices() {
     auto result = prepareVertices();
     if (!result.ok()) {
         LOG(ERROR) << "Insert vertices failed, error " << result.status().toString();
@@ -29,6 +29,8 @@ private:
     Status check();
     StatusOr<std::vector<storage::cpp2::Vertex>> prepareVertices();
 
+    void insertVertices();
+
 private:
     using TagSchema = std::shared_ptr<const meta::SchemaProviderIf>;
 
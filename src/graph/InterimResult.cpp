@@ -72,13 +72,24 @@ StatusOr<std::vector<VertexID>> InterimResult::getDistinctVIDs(const std::string
 }
 
 StatusOr<std::vector<cpp2::RowValue>> InterimResult::getRows() const {
+    std::vector<cpp2::RowValue> rows;
+    auto status = forEachRow([&rows] (cpp2::RowValue &&row) {
+        rows.emplace_back(std::move(row));
+        return Status::OK();
+    });
+    if (!status.ok()) {
+        return status;
+    }
+    return rows;
+}
+
+Status InterimResult::forEachRow(std::function<Status(cpp2::RowValue &&row)> visitor) const {
     if (!hasData()) {
         return Status::Error("Interim has no data.");
     }
     auto schema = rsReader_->schema();
     auto columnCnt = schema->getNumFields();
     VLOG(1) << "columnCnt: " << columnCnt;
-    std::vector<cpp2::RowValue> rows;
     folly::StringPiece piece;
     using nebula::cpp2::SupportedType;
     auto rowIter = rsReader_->begin();
@@ -167,11 +178,27 @@ StatusOr<std::vector<cpp2::RowValue>> InterimResult::getRows() const {
             }
             ++fieldIter;
         }
-        rows.emplace_back();
-        rows.back().set_columns(std::move(row));
+        cpp2::RowValue rowValue;
+        rowValue.set_columns(std::move(row));
+        auto status = visitor(std::move(rowValue));
+        if (!status.ok()) {
+            return status;
+        }
+        ++rowIter;
+    }
+    return Status::OK();
+}
+
+void InterimResult::forEachEncodedRow(
+        std::function<void(folly::StringPiece row)> visitor) const {
+    if (!hasData()) {
+        return;
+    }
+    auto rowIter = rsReader_->begin();
+    while (rowIter) {
+        visitor(rowIter.encoded());
         ++rowIter;
     }
-    return rows;
 }
 
 StatusOr<std::unique_ptr<InterimResult::InterimResultIndex>>
@@ -75,6 +75,22 @@ public:
 
     StatusOr<std::vector<cpp2::RowValue>> getRows() const;
 
+    /**
+     * Decode the rows one by one, without holding all of them in memory.
+     * */
+    Status forEachRow(std::function<Status(cpp2::RowValue &&row)> visitor) const;
+
+    /**
+     * Visit the encoded rows without decoding them, see RowSetReader::Iterator::encoded().
+     * Rows encoded with the same schema have the same bytes for the same values.
+     * */
+    void forEachEncodedRow(std::function<void(folly::StringPiece row)> visitor) const;
+
+    // The bytes of the encoded rows
+    size_t dataSize() const {
+        return hasData() ? rsWriter_->data().size() : 0;
+    }
+
     class InterimResultIndex;
     StatusOr<std::unique_ptr<InterimResultIndex>>
     buildIndex(const std::string &vidColumn) const;
@@ -10,6 +10,122 @@
 namespace nebula {
 namespace graph {
 
+namespace {
+
+// The value of an expression made of numeric constants only, e.g. 5, -1.5 or 3 * 60
+folly::Optional<double> numericConstant(const Expression *expr) {
+    bool constant = true;
+    expr->traversal([&constant] (const Expression *e) {
+        switch (e->kind()) {
+            case Expression::kPrimary:
+            case Expression::kUnary:
+            case Expression::kArithmetic:
+            case Expression::kTypeCasting:
+                break;
+            default:
+                constant = false;
+        }
+    });
+    if (!constant) {
+        return folly::none;
+    }
+    Getters getters;
+    auto value = expr->eval(getters);
+    if (!value.ok() || !Expression::isArithmetic(value.value())) {
+        return folly::none;
+    }
+    return Expression::asDouble(value.value());
+}
+
+// The fraction of the rows in [lower, upper] by the equi-depth histogram
+double histogramFraction(const std::vector<double> &bounds,
+                         folly::Optional<double> lower,
+                         folly::Optional<double> upper) {
+    auto buckets = bounds.size() - 1;
+    auto cdf = [&bounds, buckets] (double v) {
+        if (v <= bounds.front()) {
+            return 0.0;
+        }
+        if (v >= bounds.back()) {
+            return 1.0;
+        }
+        auto it = std::upper_bound(bounds.begin(), bounds.end(), v);
+        auto k = std::distance(bounds.begin(), it) - 1;
+        auto width = bounds[k + 1] - bounds[k];
+        auto inBucket = width > 0 ? (v - bounds[k]) / width : 0.5;
+        return (k + inBucket) / buckets;
+    };
+    auto from = lower.hasValue() ? cdf(*lower) : 0.0;
+    auto to = upper.hasValue() ? cdf(*upper) : 1.0;
+    return std::max(to - from, 0.0);
+}
+
+// Flatten the tree of the logical operator op into its operands, from left to right
+void flatten(const Expression *expr,
+             LogicalExpression::Operator op,
+             std::vector<const Expression*> *operands) {
+    if (expr->kind() == Expression::kLogical) {
+        auto* lExpr = dynamic_cast<const LogicalExpression*>(expr);
+        if (lExpr->op() == op) {
+            flatten(lExpr->left(), op, operands);
+            flatten(lExpr->right(), op, operands);
+            return;
+        }
+    }
+    operands->emplace_back(expr);
+}
+
+// The property of an IN list, i.e. an OR of equalities on the same property,
+// such as t.c1 == 1 OR t.c1 == 2, or nullptr if expr is not
+const AliasPropertyExpression* inListProp(const Expression *expr) {
+    std::vector<const Expression*> operands;
+    flatten(expr, LogicalExpression::Operator::OR, &operands);
+    const AliasPropertyExpression *prop = nullptr;
+    for (auto* operand : operands) {
+        if (operand->kind() != Expression::kRelational) {
+            return nullptr;
+        }
+        auto* rExpr = dynamic_cast<const RelationalExpression*>(operand);
+        auto* left = rExpr->left();
+        auto* right = rExpr->right();
+        if (left->kind() != Expression::kAliasProp) {
+            std::swap(left, right);
+        }
+        if (rExpr->op() != RelationalExpression::Operator::EQ ||
+            left->kind() != Expression::kAliasProp ||
+            right->kind() == Expression::kAliasProp) {
+            return nullptr;
+        }
+        auto* aExpr = dynamic_cast<const AliasPropertyExpression*>(left);
+        if (prop != nullptr && (*prop->alias() != *aExpr->alias() ||
+                                *prop->prop() != *aExpr->prop())) {
+            return nullptr;
+        }
+        prop = aExpr;
+    }
+    return prop;
+}
+
+// Encode the AND of the expressions
+std::string encodeAnd(const std::vector<const Expression*> &exprs) {
+    std::unique_ptr<Expression> result;
+    for (auto* expr : exprs) {
+        auto copy = Expression::decode(Expression::encode(const_cast<Expression*>(expr)));
+        DCHECK(copy.ok());
+        auto operand = std::move(copy).value();
+        if (result == nullptr) {
+            result = std::move(operand);
+        } else {
+            result = std::make_unique<LogicalExpression>(result.release(),
+                                                         LogicalExpression::Operator::AND,
+                                                         operand.release());
+        }
+    }
+    return Expression::encode(result.get());
+}
+
+}   // namespace
+
 LookupExecutor::LookupExecutor(Sentence *sentence, ExecutionContext *ectx)
     : TraverseExecutor(ectx, "lookup") {
     sentence_ = static_cast<LookupSentence*>(sentence);
@@ -84,9 +200,15 @@ Status LookupExecutor::prepareIndexes() {
         return Status::IndexNotFound();
     }
     for (auto& index : indexes) {
-        if (index->get_schema_name() == *from_) {
-            indexes_.emplace_back(index);
+        if (index->get_schema_name() != *from_) {
+            continue;
+        }
+        // The index being built online has not covered all the data yet
+        if (!index->get_complete()) {
+            VLOG(1) << "Skip the incomplete index " << index->get_index_name();
+            continue;
         }
+        indexes_.emplace_back(index);
     }
     if (indexes_.empty()) {
         LOG(ERROR) << "No index was found";
@@ -154,11 +276,21 @@ Status LookupExecutor::checkAliasProperty(const AliasPropertyExpression* aExpr)
 Status LookupExecutor::optimize() {
     Status status = Status::OK();
     do {
-        status = checkFilter();
+        auto *filter = sentence_->whereClause()->filter();
+        std::vector<const Expression*> branches;
+        flatten(filter, LogicalExpression::Operator::OR, &branches);
+        if (branches.size() > 1 && inListProp(filter) == nullptr) {
+            status = findIndexesToUnion(branches);
+            break;
+        }
+        status = checkFilter(filter);
         if (!status.ok()) {
             break;
         }
         status = findOptimalIndex();
+        if (status.isIndexNotFound()) {
+            status = findIndexesToIntersect(filter);
+        }
         if (!status.ok()) {
             break;
         }
@@ -176,12 +308,29 @@ Status LookupExecutor::traversalExpr(const Expression *expr, const meta::SchemaP
         case nebula::Expression::kLogical : {
             Status ret = Status::OK();
             auto* lExpr = dynamic_cast<const LogicalExpression*>(expr);
-            if (lExpr->op() == LogicalExpression::Operator::XOR ||
-                lExpr->op() == LogicalExpression::Operator::OR) {
-                return Status::SyntaxError("OR and XOR are not supported "
+            if (lExpr->op() == LogicalExpression::Operator::XOR) {
+                return Status::SyntaxError("XOR is not supported "
                                            "in lookup where clause ：%s",
                                            lExpr->toString().c_str());
             }
+            if (lExpr->op() == LogicalExpression::Operator::OR) {
+                // Only an IN list is scanned with one index, the other ORs are split
+                // into branches by optimize().
+                auto* aExpr = inListProp(lExpr);
+                if (aExpr == nullptr) {
+                    return Status::SyntaxError("Only OR of equalities on the same field is "
+                                               "supported in lookup where clause ：%s",
+                                               lExpr->toString().c_str());
+                }
+                auto st = checkAliasProperty(aExpr);
+                if (!st.ok()) {
+                    return st;
+                }
+                filters_.emplace_back(std::make_pair(*aExpr->prop(),
+                                                     RelationalExpression::Operator::EQ));
+                filterValues_.emplace_back(folly::none);
+                break;
+            }
             auto* left = lExpr->left();
             ret = traversalExpr(left, schema);
             if (!ret.ok()) {
@@ -215,6 +364,7 @@ Status LookupExecutor::traversalExpr(const Expression *expr, const meta::SchemaP
                 }
                 prop = *aExpr->prop();
                 filters_.emplace_back(std::make_pair(prop, rExpr->op()));
+                filterValues_.emplace_back(numericConstant(right));
             } else if (right->kind() == nebula::Expression::kAliasProp) {
                 auto* aExpr = dynamic_cast<const AliasPropertyExpression*>(right);
                 auto st = checkAliasProperty(aExpr);
@@ -223,6 +373,8 @@ Status LookupExecutor::traversalExpr(const Expression *expr, const meta::SchemaP
                 }
                 prop = *aExpr->prop();
                 filters_.emplace_back(std::make_pair(prop, rExpr->op()));
+                // The operator is seen from the constant side, so leave the value unknown
+                filterValues_.emplace_back(folly::none);
             } else {
                 return Status::SyntaxError("Unsupported expression ：%s",
                                            rExpr->toString().c_str());
@@ -248,7 +400,7 @@ Status LookupExecutor::traversalExpr(const Expression *expr, const meta::SchemaP
     return Status::OK();
 }
 
-Status LookupExecutor::checkFilter() {
+Status LookupExecutor::checkFilter(const Expression *filter) {
     auto *sm = ectx()->schemaManager();
     auto schema = isEdge_
                   ? sm->getEdgeSchema(spaceId_, tagOrEdge_)
@@ -257,7 +409,7 @@ Status LookupExecutor::checkFilter() {
         return Status::Error("No schema found %s", from_->c_str());
     }
 
-    auto status = traversalExpr(sentence_->whereClause()->filter(), schema.get());
+    auto status = traversalExpr(filter, schema.get());
     if (!status.ok()) {
         return status;
     }
@@ -267,6 +419,97 @@ Status LookupExecutor::checkFilter() {
     return Status::OK();
 }
 
+Status LookupExecutor::findIndexesToUnion(const std::vector<const Expression*> &branches) {
+    // Every branch is served by its own index, the rows hit by any of them are returned.
+    for (auto *branch : branches) {
+        filters_.clear();
+        filterValues_.clear();
+        auto status = checkFilter(branch);
+        if (!status.ok()) {
+            return status;
+        }
+        status = findOptimalIndex();
+        if (!status.ok()) {
+            return status;
+        }
+        storage::cpp2::IndexQueryContext context;
+        context.set_index_id(index_);
+        context.set_filter(Expression::encode(const_cast<Expression*>(branch)));
+        contexts_.emplace_back(std::move(context));
+    }
+    isUnion_ = true;
+    index_ = contexts_.front().get_index_id();
+    return Status::OK();
+}
+
+Status LookupExecutor::findIndexesToIntersect(const Expression *filter) {
+    // The conditions of the top-level AND, every one of which has its filter in filters_
+    // at the same position, as traversalExpr collects them from left to right.
+    std::vector<const Expression*> conds;
+    flatten(filter, LogicalExpression::Operator::AND, &conds);
+    if (conds.size() != filters_.size()) {
+        return Status::IndexNotFound();
+    }
+    auto allFilters = std::move(filters_);
+    auto allValues = std::move(filterValues_);
+    auto allIndexes = indexes_;
+    std::vector<bool> covered(conds.size(), false);
+    auto uncovered = conds.size();
+    // Greedily take the valid index for the most conditions not covered yet
+    while (uncovered > 0) {
+        std::shared_ptr<nebula::cpp2::IndexItem> best;
+        std::vector<size_t> bestConds;
+        for (const auto &index : allIndexes) {
+            std::vector<size_t> hits;
+            const auto &fields = index->get_fields();
+            for (auto i = 0UL; i < conds.size(); i++) {
+                auto it = std::find_if(fields.begin(), fields.end(),
+                                       [&allFilters, i] (const auto &field) {
+                                           return field.get_name() == allFilters[i].first;
+                                       });
+                if (!covered[i] && it != fields.end()) {
+                    hits.emplace_back(i);
+                }
+            }
+            if (hits.size() <= bestConds.size()) {
+                continue;
+            }
+            filters_.clear();
+            filterValues_.clear();
+            for (auto i : hits) {
+                filters_.emplace_back(allFilters[i]);
+                filterValues_.emplace_back(allValues[i]);
+            }
+            indexes_ = {index};
+            if (!findValidIndex().empty()) {
+                best = index;
+                bestConds = std::move(hits);
+            }
+        }
+        if (best == nullptr) {
+            indexes_ = std::move(allIndexes);
+            LOG(ERROR) << "No valid indexes found for all the conditions";
+            return Status::IndexNotFound();
+        }
+        std::vector<const Expression*> exprs;
+        for (auto i : bestConds) {
+            covered[i] = true;
+            exprs.emplace_back(conds[i]);
+        }
+        uncovered -= bestConds.size();
+        storage::cpp2::IndexQueryContext context;
+        context.set_index_id(best->get_index_id());
+        context.set_filter(encodeAnd(exprs));
+        contexts_.emplace_back(std::move(context));
+    }
+    indexes_ = std::move(allIndexes);
+    filters_ = std::move(allFilters);
+    filterValues_ = std::move(allValues);
+    isUnion_ = false;
+    index_ = contexts_.front().get_index_id();
+    return Status::OK();
+}
+
 Status LookupExecutor::findOptimalIndex() {
     // The rule of priority is '==' --> '< > <= >=' --> '!='
     // Step 1 : find out all valid indexes for where condition.
@@ -275,13 +518,19 @@ Status LookupExecutor::findOptimalIndex() {
         LOG(ERROR) << "No valid index found";
         return Status::IndexNotFound();
     }
-    // Step 2 : find optimal indexes for equal condition.
+    // Step 2 : with the stats of all the valid indexes, choose the one scanning fewest rows.
+    auto byStats = findIndexByStats(validIndexes);
+    if (byStats != nullptr) {
+        index_ = byStats->get_index_id();
+        return Status::OK();
+    }
+    // Step 3 : find optimal indexes for equal condition.
     auto indexesEq = findIndexForEqualScan(validIndexes);
     if (indexesEq.size() == 1) {
         index_ = indexesEq[0]->get_index_id();
         return Status::OK();
     }
-    // Step 3 : find optimal indexes for range condition.
+    // Step 4 : find optimal indexes for range condition.
     auto indexesRange = findIndexForRangeScan(indexesEq);
 
     // At this stage, all the optimizations are done.
@@ -290,6 +539,90 @@ Status LookupExecutor::findOptimalIndex() {
     return Status::OK();
 }
 
+std::shared_ptr<nebula::cpp2::IndexItem> LookupExecutor::findIndexByStats(
+    const std::vector<std::shared_ptr<nebula::cpp2::IndexItem>>& indexes) const {
+    std::shared_ptr<nebula::cpp2::IndexItem> best;
+    double bestRows = 0;
+    for (const auto& index : indexes) {
+        if (!index->__isset.stats) {
+            return nullptr;
+        }
+        auto rows = estimateScanRows(*index);
+        VLOG(2) << "Index " << index->get_index_name() << " scans about " << rows << " rows";
+        if (best == nullptr || rows < bestRows) {
+            best = index;
+            bestRows = rows;
+        }
+    }
+    return best;
+}
+
+double LookupExecutor::estimateScanRows(const nebula::cpp2::IndexItem& index) const {
+    // The scan is bounded by the equal conditions on the leading fields,
+    // then by the range conditions on the next field at most, as IndexPolicyMaker does.
+    // The conditions on different fields are taken as independent.
+    const auto& stats = index.stats;
+    double rows = stats.get_rows();
+    double scanned = rows;
+    const auto& fields = index.get_fields();
+    const auto& columns = stats.get_columns();
+    for (auto i = 0UL; i < fields.size() && i < columns.size(); i++) {
+        bool hasEq = false;
+        bool hasRange = false;
+        folly::Optional<double> lower;
+        folly::Optional<double> upper;
+        int32_t unknownBounds = 0;
+        for (auto j = 0UL; j < filters_.size(); j++) {
+            if (filters_[j].first != fields[i].get_name()) {
+                continue;
+            }
+            folly::Optional<double> value;
+            if (j < filterValues_.size()) {
+                value = filterValues_[j];
+            }
+            switch (filters_[j].second) {
+                case RelationalExpression::Operator::EQ:
+                    hasEq = true;
+                    break;
+                case RelationalExpression::Operator::GT:
+                case RelationalExpression::Operator::GE:
+                    hasRange = true;
+                    if (!value.hasValue()) {
+                        unknownBounds++;
+                    } else if (!lower.hasValue() || *value > *lower) {
+                        lower = value;
+                    }
+                    break;
+                case RelationalExpression::Operator::LT:
+                case RelationalExpression::Operator::LE:
+                    hasRange = true;
+                    if (!value.hasValue()) {
+                        unknownBounds++;
+                    } else if (!upper.hasValue() || *value < *upper) {
+                        upper = value;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (hasEq) {
+            // The ndv is of the values from the first field to this one
+            scanned = rows / std::max<int64_t>(columns[i].get_ndv(), 1);
+            continue;
+        }
+        if (hasRange) {
+            const auto& histogram = columns[i].get_histogram();
+            if (histogram.size() >= 2 && (lower.hasValue() || upper.hasValue())) {
+                scanned *= histogramFraction(histogram, lower, upper);
+            }
+            scanned *= std::pow(1.0 / 3, unknownBounds);
+        }
+        break;
+    }
+    return scanned;
+}
+
 std::vector<std::shared_ptr<nebula::cpp2::IndexItem>> LookupExecutor::findValidIndexWithStr() {
     std::vector<std::shared_ptr<nebula::cpp2::IndexItem>> validIndexes;
     // Because the string type is a variable-length field,
@@ -491,7 +824,8 @@ std::vector<std::shared_ptr<nebula::cpp2::IndexItem>> LookupExecutor::findIndexF
 void LookupExecutor::lookUp() {
     auto *sc = ectx()->getStorageClient();
     auto filter = Expression::encode(sentence_->whereClause()->filter());
-    auto future  = sc->lookUpIndex(spaceId_, index_, filter, returnCols_, isEdge_);
+    auto future  = sc->lookUpIndex(spaceId_, index_, filter, returnCols_, isEdge_,
+                                   contexts_, isUnion_);
     auto *runner = ectx()->rctx()->runner();
     auto cb = [this] (auto &&result) {
         auto completeness = result.completeness();
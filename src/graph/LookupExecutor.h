@@ -18,6 +18,8 @@ using RpcResponse = storage::StorageRpcResponse<storage::cpp2::LookUpIndexResp>;
 class LookupExecutor final : public TraverseExecutor {
     FRIEND_TEST(LookupTest, OptimizerTest);
     FRIEND_TEST(LookupTest, OptimizerWithStringFieldTest);
+    FRIEND_TEST(LookupTest, OptimizerWithStatsTest);
+    FRIEND_TEST(LookupTest, OptimizerMultiIndexTest);
 
 public:
     LookupExecutor(Sentence *sentence, ExecutionContext *ectx);
@@ -51,7 +53,13 @@ private:
 
     Status traversalExpr(const Expression *expr, const meta::SchemaProviderIf* schema);
 
-    Status checkFilter();
+    Status checkFilter(const Expression *filter);
+
+    // Scan the indexes found for the branches of the top-level OR, and union the rows
+    Status findIndexesToUnion(const std::vector<const Expression*> &branches);
+
+    // Scan the indexes covering the conditions of the top-level AND, and intersect the rows
+    Status findIndexesToIntersect(const Expression *filter);
 
     std::vector<std::shared_ptr<nebula::cpp2::IndexItem>> findValidIndexWithStr();
 
@@ -65,6 +73,12 @@ private:
     std::vector<std::shared_ptr<nebula::cpp2::IndexItem>> findIndexForRangeScan(
         const std::vector<std::shared_ptr<nebula::cpp2::IndexItem>>& indexes);
 
+    // The valid index estimated to scan the fewest rows, or nullptr if any one has no stats
+    std::shared_ptr<nebula::cpp2::IndexItem> findIndexByStats(
+        const std::vector<std::shared_ptr<nebula::cpp2::IndexItem>>& indexes) const;
+
+    double estimateScanRows(const nebula::cpp2::IndexItem& index) const;
+
     Status findOptimalIndex();
 
     void lookUp();
@@ -103,7 +117,12 @@ private:
     std::unique_ptr<cpp2::ExecutionResponse>       resp_;
     std::vector<std::string>                       returnCols_;
     std::vector<FilterItem>                        filters_;
+    // The numeric constant compared in the filter at the same position, if known
+    std::vector<folly::Optional<double>>           filterValues_;
     std::vector<std::shared_ptr<nebula::cpp2::IndexItem>> indexes_;
+    // The indexes scanned together, if no single index serves the where clause
+    std::vector<storage::cpp2::IndexQueryContext>  contexts_;
+    bool                                           isUnion_{false};
 };
 }  // namespace graph
 }  // namespace nebula
@@ -0,0 +1,77 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "graph/MemoryTracker.h"
+#include "graph/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+MemoryTracker::~MemoryTracker() {
+    auto used = used_.load();
+    if (parent_ != nullptr && used > 0) {
+        parent_->release(used);
+    }
+}
+
+// static
+MemoryTracker* MemoryTracker::global() {
+    static MemoryTracker tracker;
+    // The flag could be changed at runtime
+    tracker.setLimit(FLAGS_graph_memory_limit_mb * 1024 * 1024);
+    return &tracker;
+}
+
+bool MemoryTracker::tryConsume(int64_t bytes) {
+    auto used = used_.fetch_add(bytes) + bytes;
+    auto limit = limit_.load();
+    if (limit > 0 && used > limit) {
+        used_.fetch_sub(bytes);
+        return false;
+    }
+    if (parent_ != nullptr && !parent_->tryConsume(bytes)) {
+        used_.fetch_sub(bytes);
+        return false;
+    }
+    updatePeak(used);
+    return true;
+}
+
+void MemoryTracker::consume(int64_t bytes) {
+    updatePeak(used_.fetch_add(bytes) + bytes);
+    if (parent_ != nullptr) {
+        parent_->consume(bytes);
+    }
+}
+
+void MemoryTracker::release(int64_t bytes) {
+    used_.fetch_sub(bytes);
+    if (parent_ != nullptr) {
+        parent_->release(bytes);
+    }
+}
+
+void MemoryTracker::updatePeak(int64_t used) {
+    auto peak = peak_.load();
+    while (used > peak && !peak_.compare_exchange_weak(peak, used)) {
+    }
+}
+
+// static
+int64_t MemoryTracker::rowSize(const cpp2::RowValue &row) {
+    int64_t size = sizeof(cpp2::RowValue);
+    for (auto &col : row.get_columns()) {
+        size += sizeof(cpp2::ColumnValue);
+        if (col.getType() == cpp2::ColumnValue::Type::str) {
+            size += col.get_str().capacity();
+        }
+    }
+    return size;
+}
+
+}   // namespace graph
+}   // namespace nebula
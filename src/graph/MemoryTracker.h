@@ -0,0 +1,87 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_MEMORYTRACKER_H_
+#define GRAPH_MEMORYTRACKER_H_
+
+#include "base/Base.h"
+#include "gen-cpp2/graph_types.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * Accounts the memory taken by the executors of a query. Every query has its own
+ * tracker, whose parent is the global one of graphd, so a query is limited by both
+ * --query_memory_limit_mb and --graph_memory_limit_mb.
+ *
+ * The executors which could spill (sort and group by) call tryConsume() and write
+ * their data to disk when it fails, the others fail the query.
+ * */
+class MemoryTracker final {
+public:
+    /**
+     * limit is in bytes, 0 means no limit.
+     * */
+    explicit MemoryTracker(int64_t limit = 0, MemoryTracker *parent = nullptr)
+        : limit_(limit), parent_(parent) {}
+
+    // Release what is still taken from the parent
+    ~MemoryTracker();
+
+    /**
+     * The tracker of the whole graphd, limited by --graph_memory_limit_mb.
+     * */
+    static MemoryTracker* global();
+
+    /**
+     * Take the bytes if neither this tracker nor its ancestors is over its limit
+     * after that, otherwise nothing is taken and false is returned.
+     * */
+    bool tryConsume(int64_t bytes);
+
+    /**
+     * Take the bytes whatever the limit.
+     * */
+    void consume(int64_t bytes);
+
+    void release(int64_t bytes);
+
+    int64_t used() const {
+        return used_.load();
+    }
+
+    int64_t peak() const {
+        return peak_.load();
+    }
+
+    int64_t limit() const {
+        return limit_.load();
+    }
+
+    void setLimit(int64_t limit) {
+        limit_.store(limit);
+    }
+
+    /**
+     * The approximate bytes taken by the row in memory.
+     * */
+    static int64_t rowSize(const cpp2::RowValue &row);
+
+private:
+    void updatePeak(int64_t used);
+
+private:
+    std::atomic<int64_t>            used_{0};
+    std::atomic<int64_t>            peak_{0};
+    std::atomic<int64_t>            limit_{0};
+    MemoryTracker                  *parent_{nullptr};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif  // GRAPH_MEMORYTRACKER_H_
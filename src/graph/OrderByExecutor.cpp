@@ -77,6 +77,10 @@ Status OrderByExecutor::prepare() {
     return Status::OK();
 }
 
+OrderByExecutor::~OrderByExecutor() {
+    ectx()->memTracker()->release(charged_);
+}
+
 void OrderByExecutor::execute() {
     auto status = beforeExecute();
     if (!status.ok()) {
@@ -85,27 +89,18 @@ void OrderByExecutor::execute() {
         return;
     }
 
-    auto comparator = [this] (cpp2::RowValue& lhs, cpp2::RowValue& rhs) {
-        const auto &lhsColumns = lhs.get_columns();
-        const auto &rhsColumns = rhs.get_columns();
-        for (auto &factor : this->sortFactors_) {
-            auto fieldIndex = factor.first;
-            auto orderType = factor.second;
-            if (lhsColumns[fieldIndex] == rhsColumns[fieldIndex]) {
-                continue;
-            }
-
-            if (orderType == OrderFactor::OrderType::ASCEND) {
-                return lhsColumns[fieldIndex] < rhsColumns[fieldIndex];
-            } else if (orderType == OrderFactor::OrderType::DESCEND) {
-                return lhsColumns[fieldIndex] > rhsColumns[fieldIndex];
-            }
+    if (!runs_.empty()) {
+        status = mergeRuns();
+        if (!status.ok()) {
+            LOG(ERROR) << "Merge the spilled rows failed: " << status;
+            doError(std::move(status));
+            return;
         }
-        return false;
-    };
-
-    if (!sortFactors_.empty()) {
-        std::sort(rows_.begin(), rows_.end(), comparator);
+    } else if (!sortFactors_.empty()) {
+        std::sort(rows_.begin(), rows_.end(),
+                  [this] (const cpp2::RowValue &lhs, const cpp2::RowValue &rhs) {
+                      return less(lhs, rhs);
+                  });
     }
 
     if (onResult_) {
@@ -119,6 +114,25 @@ void OrderByExecutor::execute() {
     doFinish(Executor::ProcessControl::kNext);
 }
 
+bool OrderByExecutor::less(const cpp2::RowValue &lhs, const cpp2::RowValue &rhs) const {
+    const auto &lhsColumns = lhs.get_columns();
+    const auto &rhsColumns = rhs.get_columns();
+    for (auto &factor : sortFactors_) {
+        auto fieldIndex = factor.first;
+        auto orderType = factor.second;
+        if (lhsColumns[fieldIndex] == rhsColumns[fieldIndex]) {
+            continue;
+        }
+
+        if (orderType == OrderFactor::OrderType::ASCEND) {
+            return lhsColumns[fieldIndex] < rhsColumns[fieldIndex];
+        } else if (orderType == OrderFactor::OrderType::DESCEND) {
+            return lhsColumns[fieldIndex] > rhsColumns[fieldIndex];
+        }
+    }
+    return false;
+}
+
 Status OrderByExecutor::beforeExecute() {
     if (inputs_ == nullptr) {
         return Status::OK();
@@ -133,13 +147,6 @@ Status OrderByExecutor::beforeExecute() {
         return Status::OK();
     }
 
-    auto ret = inputs_->getRows();
-    if (!ret.ok()) {
-        LOG(ERROR) << "Get rows failed: " << ret.status();
-        doError(ret.status());
-        return std::move(ret).status();
-    }
-    rows_ = std::move(ret).value();
     auto schema = inputs_->schema();
     auto factors = sentence_->factors();
     sortFactors_.reserve(factors.size());
@@ -158,11 +165,144 @@ Status OrderByExecutor::beforeExecute() {
         auto pair = std::make_pair(schema->getFieldIndex(field), factor->orderType());
         sortFactors_.emplace_back(std::move(pair));
     }
+
+    auto *tracker = ectx()->memTracker();
+    status = inputs_->forEachRow([this, tracker] (cpp2::RowValue &&row) {
+        auto size = MemoryTracker::rowSize(row);
+        if (!tracker->tryConsume(size)) {
+            // Sort the rows in memory and put them aside as a run
+            if (!sortFactors_.empty() && !rows_.empty()) {
+                auto ret = spillRun();
+                if (!ret.ok()) {
+                    return ret;
+                }
+            }
+            if (!tracker->tryConsume(size)) {
+                tracker->consume(size);
+            }
+        }
+        charged_ += size;
+        rows_.emplace_back(std::move(row));
+        return Status::OK();
+    });
+    if (!status.ok()) {
+        LOG(ERROR) << "Get rows failed: " << status;
+        return status;
+    }
+    return Status::OK();
+}
+
+Status OrderByExecutor::spillRun() {
+    std::sort(rows_.begin(), rows_.end(),
+              [this] (const cpp2::RowValue &lhs, const cpp2::RowValue &rhs) {
+                  return less(lhs, rhs);
+              });
+    auto file = SpillFile::create();
+    if (!file.ok()) {
+        return file.status();
+    }
+    auto run = std::move(file).value();
+    for (auto &row : rows_) {
+        auto status = run->write(row);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    VLOG(1) << "Spill a run of " << rows_.size() << " rows";
+    runs_.emplace_back(std::move(run));
+    rows_.clear();
+    rows_.shrink_to_fit();
+    ectx()->memTracker()->release(charged_);
+    charged_ = 0;
+    return Status::OK();
+}
+
+Status OrderByExecutor::mergeRuns() {
+    // The rows left in memory are the last run
+    if (!rows_.empty()) {
+        auto status = spillRun();
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    // The head row of every run, the smallest one is on the top
+    std::vector<std::pair<cpp2::RowValue, size_t>> heads;
+    auto greater = [this] (const std::pair<cpp2::RowValue, size_t> &lhs,
+                           const std::pair<cpp2::RowValue, size_t> &rhs) {
+        return less(rhs.first, lhs.first);
+    };
+    auto next = [&] (size_t run) -> Status {
+        cpp2::RowValue row;
+        auto ret = runs_[run]->read(&row);
+        if (!ret.ok()) {
+            return ret.status();
+        }
+        if (ret.value()) {
+            heads.emplace_back(std::move(row), run);
+            std::push_heap(heads.begin(), heads.end(), greater);
+        }
+        return Status::OK();
+    };
+    for (auto i = 0u; i < runs_.size(); i++) {
+        auto status = runs_[i]->rewind();
+        if (!status.ok()) {
+            return status;
+        }
+        status = next(i);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    // Write to the result directly when piped, which is more compact than the rows
+    if (onResult_) {
+        sortedWriter_ = std::make_unique<RowSetWriter>(inputs_->schema());
+    }
+    std::vector<cpp2::RowValue> batch;
+    auto flush = [&] () -> Status {
+        auto status = InterimResult::getResultWriter(batch, sortedWriter_.get());
+        batch.clear();
+        return status;
+    };
+    while (!heads.empty()) {
+        std::pop_heap(heads.begin(), heads.end(), greater);
+        auto run = heads.back().second;
+        auto row = std::move(heads.back().first);
+        heads.pop_back();
+        if (sortedWriter_ != nullptr) {
+            batch.emplace_back(std::move(row));
+            if (batch.size() >= kMergeBatchSize) {
+                auto status = flush();
+                if (!status.ok()) {
+                    return status;
+                }
+            }
+        } else {
+            // The result to response is taken whatever the limit
+            auto size = MemoryTracker::rowSize(row);
+            ectx()->memTracker()->consume(size);
+            charged_ += size;
+            rows_.emplace_back(std::move(row));
+        }
+        auto status = next(run);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    runs_.clear();
+    if (!batch.empty()) {
+        return flush();
+    }
     return Status::OK();
 }
 
 StatusOr<std::unique_ptr<InterimResult>> OrderByExecutor::setupInterimResult() {
     auto result = std::make_unique<InterimResult>(std::move(colNames_));
+    if (sortedWriter_ != nullptr) {
+        result->setInterim(std::move(sortedWriter_));
+        return result;
+    }
     if (rows_.empty()) {
         return result;
     }
@@ -9,6 +9,7 @@
 
 #include "base/Base.h"
 #include "graph/TraverseExecutor.h"
+#include "graph/SpillFile.h"
 
 namespace nebula {
 namespace graph {
@@ -17,6 +18,8 @@ class OrderByExecutor final : public TraverseExecutor {
 public:
     OrderByExecutor(Sentence *sentence, ExecutionContext *ectx);
 
+    ~OrderByExecutor();
+
     const char* name() const override {
         return "OrderByExecutor";
     }
@@ -32,11 +35,25 @@ private:
 
     Status beforeExecute();
 
+    bool less(const cpp2::RowValue &lhs, const cpp2::RowValue &rhs) const;
+
+    // Sort the rows in memory and spill them to a run, when the memory limit is reached
+    Status spillRun();
+
+    // Merge the sorted runs into the result
+    Status mergeRuns();
+
 private:
+    static constexpr size_t kMergeBatchSize = 1024;
+
     OrderBySentence                                            *sentence_{nullptr};
     std::vector<std::string>                                    colNames_;
     std::vector<cpp2::RowValue>                                 rows_;
     std::vector<std::pair<int64_t, OrderFactor::OrderType>>     sortFactors_;
+    std::vector<std::unique_ptr<SpillFile>>                     runs_;
+    std::unique_ptr<RowSetWriter>                               sortedWriter_;
+    // The bytes of rows_ taken from the memory tracker
+    int64_t                                                     charged_{0};
 };
 }  // namespace graph
 }  // namespace nebula
@@ -6,6 +6,7 @@
 
 #include "base/Base.h"
 #include "graph/SetExecutor.h"
+#include <folly/hash/Hash.h>
 
 namespace nebula {
 namespace graph {
@@ -16,6 +17,10 @@ bool RowValue::operator<(const RowValue& rhs) const {
 }
 }
 
+size_t SetExecutor::RowHasher::operator()(folly::StringPiece row) const {
+    return folly::hash::fnv64_buf(row.data(), row.size());
+}
+
 SetExecutor::SetExecutor(Sentence *sentence, ExecutionContext *ectx)
     : TraverseExecutor(ectx, "set") {
     sentence_ = static_cast<SetSentence*>(sentence);
@@ -218,36 +223,32 @@ void SetExecutor::doUnion() {
         return;
     }
 
-    auto ret = leftResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
-        return;
-    }
-    auto leftRows = std::move(ret).value();
-
-    ret = rightResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
+    status = castRight();
+    if (!status.ok()) {
+        doError(std::move(status));
         return;
     }
-    auto rightRows = std::move(ret).value();
-
-    if (!castingMap_.empty()) {
-        auto stat = doCasting(rightRows);
-        if (!stat.ok()) {
-            doError(std::move(stat));
-            return;
-        }
-    }
 
-    leftRows.insert(leftRows.end(),
-                    std::make_move_iterator(rightRows.begin()),
-                    std::make_move_iterator(rightRows.end()));
+    auto rsWriter = std::make_unique<RowSetWriter>(
+            resultSchema_, leftResult_->dataSize() + rightResult_->dataSize());
     if (sentence_->distinct()) {
-        doDistinct(leftRows);
+        std::unordered_set<folly::StringPiece, RowHasher> rows;
+        auto add = [&rows, &rsWriter] (folly::StringPiece row) {
+            if (rows.emplace(row).second) {
+                rsWriter->addAll(row);
+            }
+        };
+        leftResult_->forEachEncodedRow(add);
+        rightResult_->forEachEncodedRow(add);
+    } else {
+        auto add = [&rsWriter] (folly::StringPiece row) {
+            rsWriter->addAll(row);
+        };
+        leftResult_->forEachEncodedRow(add);
+        rightResult_->forEachEncodedRow(add);
     }
 
-    finishExecution(std::move(leftRows));
+    finishExecution(std::move(rsWriter));
     return;
 }
 
@@ -296,11 +297,27 @@ Status SetExecutor::doCasting(std::vector<cpp2::RowValue> &rows) const {
     return Status::OK();
 }
 
+Status SetExecutor::castRight() {
+    if (castingMap_.empty()) {
+        return Status::OK();
+    }
+
+    auto ret = rightResult_->getRows();
+    if (!ret.ok()) {
+        return std::move(ret).status();
+    }
+    auto rows = std::move(ret).value();
+    auto status = doCasting(rows);
+    if (!status.ok()) {
+        return status;
+    }
 
-void SetExecutor::doDistinct(std::vector<cpp2::RowValue> &rows) const {
-    std::sort(rows.begin(), rows.end());
-    auto it = std::unique(rows.begin(), rows.end());
-    rows.erase(it, rows.end());
+    auto result = InterimResult::getInterim(resultSchema_, rows);
+    if (!result.ok()) {
+        return std::move(result).status();
+    }
+    rightResult_ = std::move(result).value();
+    return Status::OK();
 }
 
 void SetExecutor::doIntersect() {
@@ -317,39 +334,49 @@ void SetExecutor::doIntersect() {
         return;
     }
 
-    auto ret = leftResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
-        return;
-    }
-    auto leftRows = std::move(ret).value();
-
-    ret = rightResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
+    status = castRight();
+    if (!status.ok()) {
+        doError(std::move(status));
         return;
     }
-    auto rightRows = std::move(ret).value();
 
-    if (!castingMap_.empty()) {
-        Status stat = doCasting(rightRows);
-        if (!stat.ok()) {
-            doError(std::move(stat));
-            return;
-        }
-    }
-
-    std::vector<cpp2::RowValue> rows;
-    for (auto &lr : leftRows) {
-        for (auto &rr : rightRows) {
-            if (rr == lr) {
-                rows.emplace_back(std::move(rr));
-                break;
+    // A row appears as many times as it does in both sides, in the order of the left.
+    auto rsWriter = std::make_unique<RowSetWriter>(
+            resultSchema_, std::min(leftResult_->dataSize(), rightResult_->dataSize()));
+    if (leftResult_->dataSize() <= rightResult_->dataSize()) {
+        // The times of a left row, and the times it is matched by the right
+        std::unordered_map<folly::StringPiece, std::pair<int64_t, int64_t>, RowHasher> rows;
+        leftResult_->forEachEncodedRow([&rows] (folly::StringPiece row) {
+            rows[row].first++;
+        });
+        rightResult_->forEachEncodedRow([&rows] (folly::StringPiece row) {
+            auto it = rows.find(row);
+            if (it != rows.end() && it->second.second < it->second.first) {
+                it->second.second++;
             }
-        }
+        });
+        leftResult_->forEachEncodedRow([&rows, &rsWriter] (folly::StringPiece row) {
+            auto &matched = rows[row].second;
+            if (matched > 0) {
+                matched--;
+                rsWriter->addAll(row);
+            }
+        });
+    } else {
+        std::unordered_map<folly::StringPiece, int64_t, RowHasher> rows;
+        rightResult_->forEachEncodedRow([&rows] (folly::StringPiece row) {
+            rows[row]++;
+        });
+        leftResult_->forEachEncodedRow([&rows, &rsWriter] (folly::StringPiece row) {
+            auto it = rows.find(row);
+            if (it != rows.end() && it->second > 0) {
+                it->second--;
+                rsWriter->addAll(row);
+            }
+        });
     }
 
-    finishExecution(std::move(rows));
+    finishExecution(std::move(rsWriter));
     return;
 }
 
@@ -373,39 +400,44 @@ void SetExecutor::doMinus() {
         return;
     }
 
-    auto ret = leftResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
-        return;
-    }
-    auto leftRows = std::move(ret).value();
-
-    ret = rightResult_->getRows();
-    if (!ret.ok()) {
-        doError(std::move(ret).status());
+    status = castRight();
+    if (!status.ok()) {
+        doError(std::move(status));
         return;
     }
-    auto rightRows = std::move(ret).value();
 
-    if (!castingMap_.empty()) {
-        Status stat = doCasting(rightRows);
-        if (!stat.ok()) {
-            doError(stat);
-            return;
-        }
-    }
-
-    for (auto &rr : rightRows) {
-        for (auto iter = leftRows.begin(); iter < leftRows.end();) {
-            if (rr == *iter) {
-                iter = leftRows.erase(iter);
-            } else {
-                ++iter;
+    // All the left rows that appear in the right are removed, in the order of the left.
+    auto rsWriter = std::make_unique<RowSetWriter>(resultSchema_, leftResult_->dataSize());
+    if (leftResult_->dataSize() <= rightResult_->dataSize()) {
+        // Whether a left row appears in the right
+        std::unordered_map<folly::StringPiece, bool, RowHasher> rows;
+        leftResult_->forEachEncodedRow([&rows] (folly::StringPiece row) {
+            rows.emplace(row, false);
+        });
+        rightResult_->forEachEncodedRow([&rows] (folly::StringPiece row) {
+            auto it = rows.find(row);
+            if (it != rows.end()) {
+                it->second = true;
             }
-        }
+        });
+        leftResult_->forEachEncodedRow([&rows, &rsWriter] (folly::StringPiece row) {
+            if (!rows[row]) {
+                rsWriter->addAll(row);
+            }
+        });
+    } else {
+        std::unordered_set<folly::StringPiece, RowHasher> rows;
+        rightResult_->forEachEncodedRow([&rows] (folly::StringPiece row) {
+            rows.emplace(row);
+        });
+        leftResult_->forEachEncodedRow([&rows, &rsWriter] (folly::StringPiece row) {
+            if (rows.count(row) == 0) {
+                rsWriter->addAll(row);
+            }
+        });
     }
 
-    finishExecution(std::move(leftRows));
+    finishExecution(std::move(rsWriter));
     return;
 }
 
@@ -443,21 +475,10 @@ void SetExecutor::finishExecution(std::unique_ptr<InterimResult> result) {
     doFinish(Executor::ProcessControl::kNext);
 }
 
-void SetExecutor::finishExecution(std::vector<cpp2::RowValue> rows) {
-    if (onResult_) {
-        auto ret = InterimResult::getInterim(resultSchema_, rows);
-        if (!ret.ok()) {
-            LOG(ERROR) << "Get Interim result failed.";
-            doError(std::move(ret).status());
-            return;
-        }
-        onResult_(std::move(ret).value());
-    } else {
-        resp_ = std::make_unique<cpp2::ExecutionResponse>();
-        resp_->set_column_names(std::move(colNames_));
-        resp_->set_rows(std::move(rows));
-    }
-    doFinish(Executor::ProcessControl::kNext);
+void SetExecutor::finishExecution(std::unique_ptr<RowSetWriter> rsWriter) {
+    auto result = std::make_unique<InterimResult>(std::move(colNames_));
+    result->setInterim(std::move(rsWriter));
+    finishExecution(std::move(result));
 }
 
 void SetExecutor::feedResult(std::unique_ptr<InterimResult> result) {
@@ -32,13 +32,17 @@ public:
     void setupResponse(cpp2::ExecutionResponse &resp) override;
 
 private:
+    struct RowHasher {
+        size_t operator()(folly::StringPiece row) const;
+    };
+
     void setLeft();
 
     void setRight();
 
     void finishExecution(std::unique_ptr<InterimResult> result);
 
-    void finishExecution(std::vector<cpp2::RowValue> leftRows);
+    void finishExecution(std::unique_ptr<RowSetWriter> rsWriter);
 
     void doUnion();
 
@@ -50,7 +54,9 @@ private:
 
     Status doCasting(std::vector<cpp2::RowValue> &rows) const;
 
-    void doDistinct(std::vector<cpp2::RowValue> &rows) const;
+    // Re-encode the right result with the result schema if any column needs casting,
+    // so that the rows of both sides could be compared by their encodings.
+    Status castRight();
 
     void onEmptyInputs();
 
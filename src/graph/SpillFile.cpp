@@ -0,0 +1,132 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "graph/SpillFile.h"
+#include "graph/GraphFlags.h"
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+namespace nebula {
+namespace graph {
+
+static constexpr size_t kSpillBufferSize = 1024 * 1024;
+
+SpillFile::~SpillFile() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+// static
+StatusOr<std::unique_ptr<SpillFile>> SpillFile::create() {
+    auto path = folly::stringPrintf("%s/nebula_spill.XXXXXX", FLAGS_graph_spill_dir.c_str());
+    auto fd = ::mkstemp(&path[0]);
+    if (fd < 0) {
+        return Status::Error("Create spill file `%s' failed: %s", path.c_str(), strerror(errno));
+    }
+    ::unlink(path.c_str());
+    VLOG(2) << "Spill to " << path;
+    return std::unique_ptr<SpillFile>(new SpillFile(fd));
+}
+
+Status SpillFile::write(const cpp2::RowValue &row) {
+    if (reading_) {
+        return Status::Error("Could not write the spill file being read");
+    }
+    std::string data;
+    apache::thrift::CompactSerializer::serialize(row, &data);
+    uint32_t len = data.size();
+    buffer_.append(reinterpret_cast<const char*>(&len), sizeof(len));
+    buffer_.append(data);
+    rows_++;
+    if (buffer_.size() >= kSpillBufferSize) {
+        return flush();
+    }
+    return Status::OK();
+}
+
+Status SpillFile::flush() {
+    size_t written = 0;
+    while (written < buffer_.size()) {
+        auto ret = ::write(fd_, buffer_.data() + written, buffer_.size() - written);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return Status::Error("Write spill file failed: %s", strerror(errno));
+        }
+        written += ret;
+    }
+    buffer_.clear();
+    return Status::OK();
+}
+
+Status SpillFile::rewind() {
+    if (reading_) {
+        // What is left in buffer_ has been read ahead
+        buffer_.clear();
+    } else {
+        auto status = flush();
+        if (!status.ok()) {
+            return status;
+        }
+        reading_ = true;
+    }
+    if (::lseek(fd_, 0, SEEK_SET) < 0) {
+        return Status::Error("Seek spill file failed: %s", strerror(errno));
+    }
+    pos_ = 0;
+    return Status::OK();
+}
+
+StatusOr<bool> SpillFile::fill(size_t size) {
+    if (buffer_.size() - pos_ >= size) {
+        return true;
+    }
+    buffer_.erase(0, pos_);
+    pos_ = 0;
+    auto want = std::max(size, kSpillBufferSize);
+    while (buffer_.size() < size) {
+        auto old = buffer_.size();
+        buffer_.resize(old + want);
+        auto ret = ::read(fd_, &buffer_[old], want);
+        if (ret < 0) {
+            buffer_.resize(old);
+            if (errno == EINTR) {
+                continue;
+            }
+            return Status::Error("Read spill file failed: %s", strerror(errno));
+        }
+        buffer_.resize(old + ret);
+        if (ret == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+StatusOr<bool> SpillFile::read(cpp2::RowValue *row) {
+    auto ret = fill(sizeof(uint32_t));
+    if (!ret.ok() || !ret.value()) {
+        return ret;
+    }
+    uint32_t len;
+    memcpy(&len, buffer_.data() + pos_, sizeof(len));
+    ret = fill(sizeof(len) + len);
+    if (!ret.ok()) {
+        return ret;
+    }
+    if (!ret.value()) {
+        return Status::Error("Spill file is truncated");
+    }
+    folly::StringPiece data(buffer_.data() + pos_ + sizeof(len), len);
+    apache::thrift::CompactSerializer::deserialize(data, *row);
+    pos_ += sizeof(len) + len;
+    return true;
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,65 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef GRAPH_SPILLFILE_H_
+#define GRAPH_SPILLFILE_H_
+
+#include "base/Base.h"
+#include "base/StatusOr.h"
+#include "gen-cpp2/graph_types.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * A temporary file of rows under --graph_spill_dir, used by the executors to put
+ * aside the data over the memory limit. The rows are written first, and then read
+ * back in the same order after rewind().
+ *
+ * The file is unlinked once created, so nothing is left even if graphd crashes.
+ * */
+class SpillFile final {
+public:
+    ~SpillFile();
+
+    static StatusOr<std::unique_ptr<SpillFile>> create();
+
+    Status write(const cpp2::RowValue &row);
+
+    /**
+     * Flush the rows written, and read from the first one.
+     * */
+    Status rewind();
+
+    /**
+     * Read the next row, return false at the end of the file.
+     * */
+    StatusOr<bool> read(cpp2::RowValue *row);
+
+    size_t rows() const {
+        return rows_;
+    }
+
+private:
+    explicit SpillFile(int fd) : fd_(fd) {}
+
+    Status flush();
+
+    // Make sure there are at least size bytes in buffer_ from pos_
+    StatusOr<bool> fill(size_t size);
+
+private:
+    int                 fd_{-1};
+    std::string         buffer_;
+    size_t              pos_{0};
+    size_t              rows_{0};
+    bool                reading_{false};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif  // GRAPH_SPILLFILE_H_
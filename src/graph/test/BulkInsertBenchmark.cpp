@@ -0,0 +1,170 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <folly/Benchmark.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include "parser/GQLParser.h"
+#include "parser/MutateSentences.h"
+#include "dataman/RowWriter.h"
+#include "meta/NebulaSchemaProvider.h"
+#include "graph/BulkInserter.h"
+#include "utils/ConvertTimeType.h"
+
+/**
+ * Compare the work of graphd to turn a batch of edges into encoded rows,
+ * from an `INSERT EDGE' statement and from a bulkInsert request.
+ * The storage is not involved.
+ * */
+
+using nebula::GQLParser;
+using nebula::Getters;
+using nebula::InsertEdgeSentence;
+using nebula::RowWriter;
+using nebula::graph::BulkRowEncoder;
+namespace cpp2 = nebula::graph::cpp2;
+
+static std::shared_ptr<nebula::meta::NebulaSchemaProvider> schema;
+static std::vector<std::string> propNames = {"name", "likeness", "weight", "start"};
+
+static std::string makeStatement(size_t rows) {
+    std::string stmt = "INSERT EDGE like(name, likeness, weight, start) VALUES ";
+    for (auto i = 0UL; i < rows; i++) {
+        if (i != 0) {
+            stmt += ", ";
+        }
+        stmt += folly::stringPrintf("%lu->%lu@%lu:(\"name_%lu\", %lu, %lu.5, %lu)",
+                                    i, i + 1, i, i, i, i, 1577836800 + i);
+    }
+    return stmt;
+}
+
+static std::string makeRequest(size_t rows) {
+    cpp2::BulkInsertRequest req;
+    req.set_is_edge(true);
+    req.set_name("like");
+    req.set_prop_names(propNames);
+    std::vector<cpp2::BulkInsertRow> rowList(rows);
+    for (auto i = 0UL; i < rows; i++) {
+        auto &row = rowList[i];
+        row.set_id(i);
+        row.set_dst(i + 1);
+        row.set_ranking(i);
+        std::vector<cpp2::ColumnValue> values(4);
+        values[0].set_str(folly::stringPrintf("name_%lu", i));
+        values[1].set_integer(i);
+        values[2].set_double_precision(i + 0.5);
+        values[3].set_timestamp(1577836800 + i);
+        row.set_values(std::move(values));
+    }
+    req.set_rows(std::move(rowList));
+    std::string data;
+    apache::thrift::CompactSerializer::serialize(req, &data);
+    return data;
+}
+
+void textPath(size_t iters, size_t rows) {
+    std::string stmt;
+    BENCHMARK_SUSPEND {
+        stmt = makeStatement(rows);
+    }
+    for (auto iter = 0UL; iter < iters; iter++) {
+        GQLParser parser;
+        auto result = parser.parse(stmt);
+        CHECK(result.ok()) << result.status();
+        auto *sentence = static_cast<InsertEdgeSentence*>(result.value()->sentences()[0]);
+        Getters getters;
+        for (auto *row : sentence->rows()) {
+            CHECK(row->srcid()->prepare().ok());
+            auto src = row->srcid()->eval(getters);
+            CHECK(row->dstid()->prepare().ok());
+            auto dst = row->dstid()->eval(getters);
+            folly::doNotOptimizeAway(src);
+            folly::doNotOptimizeAway(dst);
+            RowWriter writer(schema);
+            auto values = row->values();
+            for (auto i = 0UL; i < values.size(); i++) {
+                CHECK(values[i]->prepare().ok());
+                auto value = values[i]->eval(getters);
+                CHECK(value.ok());
+                auto v = std::move(value).value();
+                if (schema->getFieldType(i).type == nebula::cpp2::SupportedType::TIMESTAMP) {
+                    auto timestamp = nebula::ConvertTimeType::toTimestamp(v);
+                    CHECK(timestamp.ok());
+                    v = timestamp.value();
+                }
+                switch (v.which()) {
+                    case nebula::VAR_INT64:
+                        writer << boost::get<int64_t>(v);
+                        break;
+                    case nebula::VAR_DOUBLE:
+                        writer << boost::get<double>(v);
+                        break;
+                    case nebula::VAR_BOOL:
+                        writer << boost::get<bool>(v);
+                        break;
+                    case nebula::VAR_STR:
+                        writer << boost::get<std::string>(v);
+                        break;
+                }
+            }
+            auto props = writer.encode();
+            folly::doNotOptimizeAway(props);
+        }
+    }
+}
+
+void binaryPath(size_t iters, size_t rows) {
+    std::string data;
+    BENCHMARK_SUSPEND {
+        data = makeRequest(rows);
+    }
+    for (auto iter = 0UL; iter < iters; iter++) {
+        cpp2::BulkInsertRequest req;
+        apache::thrift::CompactSerializer::deserialize(data, req);
+        auto encoder = BulkRowEncoder::make(schema, req.get_prop_names());
+        CHECK(encoder.ok()) << encoder.status();
+        for (auto &row : req.get_rows()) {
+            auto props = encoder.value().encode(row.get_values());
+            CHECK(props.ok()) << props.status();
+            folly::doNotOptimizeAway(props);
+        }
+    }
+}
+
+BENCHMARK_NAMED_PARAM(textPath, 100_rows, 100)
+BENCHMARK_RELATIVE_NAMED_PARAM(binaryPath, 100_rows, 100)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(textPath, 1000_rows, 1000)
+BENCHMARK_RELATIVE_NAMED_PARAM(binaryPath, 1000_rows, 1000)
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(textPath, 10000_rows, 10000)
+BENCHMARK_RELATIVE_NAMED_PARAM(binaryPath, 10000_rows, 10000)
+
+int main(int argc, char** argv) {
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    schema = std::make_shared<nebula::meta::NebulaSchemaProvider>(0);
+    nebula::cpp2::ValueType strType;
+    strType.set_type(nebula::cpp2::SupportedType::STRING);
+    schema->addField("name", std::move(strType));
+    nebula::cpp2::ValueType intType;
+    intType.set_type(nebula::cpp2::SupportedType::INT);
+    schema->addField("likeness", std::move(intType));
+    nebula::cpp2::ValueType doubleType;
+    doubleType.set_type(nebula::cpp2::SupportedType::DOUBLE);
+    schema->addField("weight", std::move(doubleType));
+    nebula::cpp2::ValueType timestampType;
+    timestampType.set_type(nebula::cpp2::SupportedType::TIMESTAMP);
+    schema->addField("start", std::move(timestampType));
+
+    folly::runBenchmarks();
+    return 0;
+}
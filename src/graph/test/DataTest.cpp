@@ -970,6 +970,145 @@ TEST_F(DataTest, InsertMultiVersionWithUUIDTest) {
     }
 }
 
+TEST_F(DataTest, BulkInsertTest) {
+    auto makeRow = [] (VertexID id, std::vector<cpp2::ColumnValue> values) {
+        cpp2::BulkInsertRow row;
+        row.set_id(id);
+        row.set_values(std::move(values));
+        return row;
+    };
+    // Insert vertices
+    {
+        std::vector<cpp2::BulkInsertRow> rows;
+        for (auto i = 0; i < 10; i++) {
+            std::vector<cpp2::ColumnValue> values(2);
+            values[0].set_str(folly::stringPrintf("Bulk%d", i));
+            values[1].set_integer(20 + i);
+            rows.emplace_back(makeRow(1000 + i, std::move(values)));
+        }
+        cpp2::BulkInsertRequest req;
+        req.set_is_edge(false);
+        req.set_name("person");
+        req.set_prop_names({"name", "age"});
+        req.set_rows(std::move(rows));
+        cpp2::ExecutionResponse resp;
+        auto code = client_->bulkInsert(req, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::string cmd = "FETCH PROP ON person 1003";
+        code = client_->execute(cmd, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<int64_t, std::string, int64_t>> expected = {
+                {1003, "Bulk3", 23},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // Insert edges, the props in a different order from the schema
+    {
+        std::vector<cpp2::BulkInsertRow> rows;
+        for (auto i = 0; i < 9; i++) {
+            std::vector<cpp2::ColumnValue> values(2);
+            values[0].set_str(folly::stringPrintf("Nick%d", i));
+            values[1].set_integer(80 + i);
+            auto row = makeRow(1000 + i, std::move(values));
+            row.set_dst(1000 + i + 1);
+            rows.emplace_back(std::move(row));
+        }
+        cpp2::BulkInsertRequest req;
+        req.set_space_name("mySpace");
+        req.set_is_edge(true);
+        req.set_name("schoolmate");
+        req.set_prop_names({"nickname", "likeness"});
+        req.set_rows(std::move(rows));
+        cpp2::ExecutionResponse resp;
+        auto code = client_->bulkInsert(req, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::string cmd = "GO FROM 1002 OVER schoolmate "
+                          "YIELD $$.person.name, schoolmate.likeness, schoolmate.nickname";
+        code = client_->execute(cmd, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<std::string, int64_t, std::string>> expected = {
+                {"Bulk3", 82, "Nick2"},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // The default values
+    {
+        cpp2::BulkInsertRow row = makeRow(1000, {});
+        row.set_dst(1009);
+        cpp2::BulkInsertRequest req;
+        req.set_is_edge(true);
+        req.set_name("schoolmateWithDefault");
+        req.set_rows({row});
+        cpp2::ExecutionResponse resp;
+        auto code = client_->bulkInsert(req, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::string cmd = "FETCH PROP ON schoolmateWithDefault 1000->1009";
+        code = client_->execute(cmd, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<int64_t, int64_t, int64_t, int64_t>> expected = {
+                {1000, 1009, 0, 80},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    // Wrong value type
+    {
+        std::vector<cpp2::ColumnValue> values(2);
+        values[0].set_str("Bulk");
+        values[1].set_str("20");
+        cpp2::BulkInsertRequest req;
+        req.set_is_edge(false);
+        req.set_name("person");
+        req.set_prop_names({"name", "age"});
+        req.set_rows({makeRow(1100, std::move(values))});
+        cpp2::ExecutionResponse resp;
+        auto code = client_->bulkInsert(req, resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+    }
+    // Wrong number of values
+    {
+        std::vector<cpp2::ColumnValue> values(1);
+        values[0].set_str("Bulk");
+        cpp2::BulkInsertRequest req;
+        req.set_is_edge(false);
+        req.set_name("person");
+        req.set_prop_names({"name", "age"});
+        req.set_rows({makeRow(1100, std::move(values))});
+        cpp2::ExecutionResponse resp;
+        auto code = client_->bulkInsert(req, resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+    }
+    // Unknown prop
+    {
+        std::vector<cpp2::ColumnValue> values(1);
+        values[0].set_str("Bulk");
+        cpp2::BulkInsertRequest req;
+        req.set_is_edge(false);
+        req.set_name("person");
+        req.set_prop_names({"nickname"});
+        req.set_rows({makeRow(1100, std::move(values))});
+        cpp2::ExecutionResponse resp;
+        auto code = client_->bulkInsert(req, resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+    }
+    // Edge without the destination
+    {
+        std::vector<cpp2::ColumnValue> values(2);
+        values[0].set_integer(1);
+        values[1].set_str("Nick");
+        cpp2::BulkInsertRequest req;
+        req.set_is_edge(true);
+        req.set_name("schoolmate");
+        req.set_prop_names({"likeness", "nickname"});
+        req.set_rows({makeRow(1100, std::move(values))});
+        cpp2::ExecutionResponse resp;
+        auto code = client_->bulkInsert(req, resp);
+        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+    }
+}
+
 TEST_F(DataTest, LookupTest) {
     {
         cpp2::ExecutionResponse resp;
@@ -5,6 +5,7 @@
  */
 
 #include "base/Base.h"
+#include <folly/ScopeGuard.h>
 #include "graph/test/TestEnv.h"
 #include "graph/test/TestBase.h"
 #include "graph/test/TraverseTestBase.h"
@@ -1187,6 +1188,87 @@ TEST_P(GoTest, OnlyIdTwoSteps) {
     }
 }
 
+TEST_P(GoTest, StreamingExpansion) {
+    FLAGS_go_streaming_expansion = true;
+    SCOPE_EXIT {
+        FLAGS_go_streaming_expansion = false;
+    };
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Tony Parker"];
+        auto *fmt = "GO 2 STEPS FROM %ld OVER like YIELD like._dst";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<VertexID>> expected = {
+            {3394245602834314645},
+            {-7579316172763586624},
+            {-7579316172763586624},
+            {5662213458193308137},
+            {5662213458193308137}
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        auto *fmt = "GO 1 TO 3 STEPS FROM %ld OVER like YIELD like._dst as dst";
+        auto query = folly::stringPrintf(fmt, players_["Tim Duncan"].vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<VertexID>> expected = {
+            {players_["Tony Parker"].vid()},
+            {players_["Manu Ginobili"].vid()},
+            {players_["Tim Duncan"].vid()},
+            {players_["Tim Duncan"].vid()},
+            {players_["LaMarcus Aldridge"].vid()},
+            {players_["Manu Ginobili"].vid()},
+            {players_["Tony Parker"].vid()},
+            {players_["Manu Ginobili"].vid()},
+            {players_["Tim Duncan"].vid()},
+            {players_["Tim Duncan"].vid()},
+            {players_["Tony Parker"].vid()},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+}
+
+TEST_P(GoTest, StorageTraverse) {
+    FLAGS_go_storage_traverse = true;
+    SCOPE_EXIT {
+        FLAGS_go_storage_traverse = false;
+    };
+    {
+        cpp2::ExecutionResponse resp;
+        auto &player = players_["Tony Parker"];
+        auto *fmt = "GO 2 STEPS FROM %ld OVER like YIELD like._dst";
+        auto query = folly::stringPrintf(fmt, player.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<VertexID>> expected = {
+            {3394245602834314645},
+            {-7579316172763586624},
+            {-7579316172763586624},
+            {5662213458193308137},
+            {5662213458193308137}
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        auto *fmt = "GO 3 STEPS FROM %ld OVER like YIELD like._dst";
+        auto query = folly::stringPrintf(fmt, players_["Tim Duncan"].vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        // The same as stepping out in graph
+        FLAGS_go_storage_traverse = false;
+        cpp2::ExecutionResponse stepOutResp;
+        code = client_->execute(query, stepOutResp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        auto expected = rowsToTuples<std::tuple<VertexID>>(respToRecords(stepOutResp));
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+}
+
 TEST_P(GoTest, ReverselyTwoStep) {
     {
         cpp2::ExecutionResponse resp;
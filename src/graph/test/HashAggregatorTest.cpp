@@ -0,0 +1,254 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "graph/HashAggregator.h"
+#include "graph/AggregateFunction.h"
+
+namespace nebula {
+namespace graph {
+
+using Kind = HashAggregator::Kind;
+using KeyCol = HashAggregator::KeyCol;
+using AggCol = HashAggregator::AggCol;
+using nebula::cpp2::SupportedType;
+
+// vid, int, double, string, timestamp, bool
+static const std::vector<SupportedType> kTypes = {
+    SupportedType::VID, SupportedType::INT, SupportedType::DOUBLE,
+    SupportedType::STRING, SupportedType::TIMESTAMP, SupportedType::BOOL,
+};
+
+static std::vector<cpp2::RowValue> makeRows(size_t num) {
+    std::vector<cpp2::RowValue> rows;
+    for (auto i = 0UL; i < num; i++) {
+        std::vector<cpp2::ColumnValue> cols(kTypes.size());
+        cols[0].set_id(i % 50);
+        cols[1].set_integer(folly::Random::rand32(200) - 100);
+        cols[2].set_double_precision(folly::Random::randDouble01() * 10);
+        cols[3].set_str(folly::stringPrintf("name_%lu", i % 7));
+        cols[4].set_timestamp(1577836800 + folly::Random::rand32(1000));
+        cols[5].set_bool_val(i % 3 == 0);
+        rows.emplace_back();
+        rows.back().set_columns(std::move(cols));
+    }
+    return rows;
+}
+
+static AggCol agg(Kind kind, int64_t index, size_t key = 0) {
+    AggCol col;
+    col.kind = kind;
+    col.index = index;
+    col.type = index < 0 ? SupportedType::UNKNOWN : kTypes[index];
+    col.key = key;
+    return col;
+}
+
+static KeyCol key(size_t index) {
+    KeyCol col;
+    col.index = index;
+    col.type = kTypes[index];
+    return col;
+}
+
+// Aggregate the rows with AggFun, as GroupByExecutor does without HashAggregator
+static std::vector<cpp2::RowValue> aggregate(const std::vector<cpp2::RowValue> &rows,
+                                             const std::vector<KeyCol> &keys,
+                                             const std::vector<AggCol> &aggs) {
+    static const std::unordered_map<Kind, std::string> names = {
+        {Kind::GROUP, ""},
+        {Kind::COUNT, kCount},
+        {Kind::COUNT_DISTINCT, kCountDist},
+        {Kind::SUM, kSum},
+        {Kind::AVG, kAvg},
+        {Kind::MAX, kMax},
+        {Kind::MIN, kMin},
+    };
+    std::unordered_map<ColVals, std::vector<std::shared_ptr<AggFun>>, ColsHasher> groups;
+    for (auto &row : rows) {
+        ColVals groupVals;
+        for (auto &k : keys) {
+            groupVals.vec.emplace_back(row.columns[k.index]);
+        }
+        auto it = groups.find(groupVals);
+        if (it == groups.end()) {
+            std::vector<std::shared_ptr<AggFun>> funs;
+            for (auto &a : aggs) {
+                funs.emplace_back(funVec[names.at(a.kind)]());
+            }
+            it = groups.emplace(std::move(groupVals), std::move(funs)).first;
+        }
+        for (auto i = 0UL; i < aggs.size(); i++) {
+            auto index = aggs[i].index;
+            if (aggs[i].kind == Kind::GROUP) {
+                index = keys[aggs[i].key].index;
+            }
+            auto val = row.columns[index < 0 ? 0 : index];
+            it->second[i]->apply(val);
+        }
+    }
+    std::vector<cpp2::RowValue> result;
+    for (auto &group : groups) {
+        std::vector<cpp2::ColumnValue> cols;
+        for (auto &fun : group.second) {
+            cols.emplace_back(fun->getResult());
+        }
+        result.emplace_back();
+        result.back().set_columns(std::move(cols));
+    }
+    return result;
+}
+
+static void sortRows(std::vector<cpp2::RowValue> *rows) {
+    std::sort(rows->begin(), rows->end(), [] (const auto &a, const auto &b) {
+        return std::lexicographical_compare(a.columns.begin(), a.columns.end(),
+                                            b.columns.begin(), b.columns.end());
+    });
+}
+
+static void checkSameAsAggFun(const std::vector<KeyCol> &keys, const std::vector<AggCol> &aggs) {
+    for (auto &k : keys) {
+        ASSERT_TRUE(HashAggregator::isSupported(k));
+    }
+    for (auto &a : aggs) {
+        ASSERT_TRUE(HashAggregator::isSupported(a));
+    }
+    // More than a batch
+    auto rows = makeRows(5000);
+    auto expected = aggregate(rows, keys, aggs);
+
+    MemoryTracker tracker;
+    std::vector<cpp2::RowValue> result;
+    {
+        HashAggregator aggregator(keys, aggs, &tracker, [] (auto&, auto) {
+            return Status::Error("Should not spill without a limit");
+        });
+        for (auto &row : rows) {
+            auto copy = row;
+            ASSERT_TRUE(aggregator.add(std::move(copy)).ok());
+        }
+        ASSERT_TRUE(aggregator.finish(&result).ok());
+        EXPECT_EQ(0, tracker.used());
+        EXPECT_LT(0, tracker.peak());
+    }
+
+    sortRows(&expected);
+    sortRows(&result);
+    ASSERT_EQ(expected.size(), result.size());
+    for (auto i = 0UL; i < expected.size(); i++) {
+        ASSERT_EQ(expected[i].columns, result[i].columns) << "Group " << i;
+    }
+}
+
+TEST(HashAggregator, IntKey) {
+    checkSameAsAggFun({key(0)},
+                      {agg(Kind::GROUP, 0, 0), agg(Kind::COUNT, -1), agg(Kind::SUM, 1),
+                       agg(Kind::AVG, 1), agg(Kind::MAX, 2), agg(Kind::MIN, 4),
+                       agg(Kind::COUNT_DISTINCT, 3), agg(Kind::SUM, 2), agg(Kind::AVG, 2),
+                       agg(Kind::SUM, 4), agg(Kind::MAX, 0), agg(Kind::COUNT, 3)});
+    checkSameAsAggFun({key(5)},
+                      {agg(Kind::COUNT, -1), agg(Kind::GROUP, 5, 0),
+                       agg(Kind::COUNT_DISTINCT, 0), agg(Kind::COUNT_DISTINCT, 5),
+                       agg(Kind::MIN, 1)});
+}
+
+TEST(HashAggregator, PackedKey) {
+    checkSameAsAggFun({key(3)},
+                      {agg(Kind::GROUP, 3, 0), agg(Kind::COUNT, -1), agg(Kind::MAX, 1),
+                       agg(Kind::MIN, 2), agg(Kind::COUNT_DISTINCT, 0)});
+    checkSameAsAggFun({key(3), key(5), key(0)},
+                      {agg(Kind::GROUP, 5, 1), agg(Kind::GROUP, 3, 0), agg(Kind::COUNT, -1),
+                       agg(Kind::SUM, 1), agg(Kind::AVG, 2), agg(Kind::GROUP, 0, 2)});
+}
+
+TEST(HashAggregator, Spill) {
+    auto rows = makeRows(3000);
+    // Room for a few groups only
+    MemoryTracker tracker(1000);
+    std::unordered_set<int64_t> spilled;
+    std::vector<cpp2::RowValue> result;
+    auto spillRows = 0UL;
+    {
+        HashAggregator aggregator({key(0)},
+                                  {agg(Kind::GROUP, 0, 0), agg(Kind::COUNT, -1)},
+                                  &tracker,
+                                  [&] (const cpp2::RowValue &row, uint64_t) {
+            spilled.emplace(row.columns[0].get_id());
+            spillRows++;
+            return Status::OK();
+        });
+        for (auto &row : rows) {
+            auto copy = row;
+            ASSERT_TRUE(aggregator.add(std::move(copy)).ok());
+        }
+        ASSERT_TRUE(aggregator.finish(&result).ok());
+    }
+    EXPECT_EQ(0, tracker.used());
+    ASSERT_FALSE(result.empty());
+    ASSERT_FALSE(spilled.empty());
+    // A group is either in memory or spilled, as a whole
+    auto counted = 0UL;
+    for (auto &row : result) {
+        EXPECT_EQ(0, spilled.count(row.columns[0].get_id()));
+        counted += row.columns[1].get_integer();
+    }
+    EXPECT_EQ(50, result.size() + spilled.size());
+    EXPECT_EQ(rows.size(), counted + spillRows);
+}
+
+TEST(HashAggregator, SpillWithMemoryFreed) {
+    auto rows = makeRows(3000);
+    MemoryTracker tracker(1000);
+    // Taken by another executor, which frees it right after the first spill,
+    // in the middle of the batch
+    int64_t held = 1000;
+    tracker.consume(held);
+    std::unordered_set<int64_t> spilled;
+    std::vector<cpp2::RowValue> result;
+    auto spillRows = 0UL;
+    {
+        HashAggregator aggregator({key(0)},
+                                  {agg(Kind::GROUP, 0, 0), agg(Kind::COUNT, -1)},
+                                  &tracker,
+                                  [&] (const cpp2::RowValue &row, uint64_t) {
+            spilled.emplace(row.columns[0].get_id());
+            spillRows++;
+            tracker.release(held);
+            held = 0;
+            return Status::OK();
+        });
+        for (auto &row : rows) {
+            auto copy = row;
+            ASSERT_TRUE(aggregator.add(std::move(copy)).ok());
+        }
+        ASSERT_TRUE(aggregator.finish(&result).ok());
+    }
+    EXPECT_EQ(0, tracker.used());
+    ASSERT_FALSE(result.empty());
+    ASSERT_FALSE(spilled.empty());
+    // The rows of a spilled group are all spilled, even with the memory freed
+    auto counted = 0UL;
+    for (auto &row : result) {
+        EXPECT_EQ(0, spilled.count(row.columns[0].get_id()));
+        counted += row.columns[1].get_integer();
+    }
+    EXPECT_EQ(50, result.size() + spilled.size());
+    EXPECT_EQ(rows.size(), counted + spillRows);
+}
+
+TEST(HashAggregator, NotSupported) {
+    KeyCol doubleKey;
+    doubleKey.index = 2;
+    doubleKey.type = SupportedType::DOUBLE;
+    EXPECT_FALSE(HashAggregator::isSupported(doubleKey));
+    EXPECT_FALSE(HashAggregator::isSupported(agg(Kind::AVG, 0)));
+    EXPECT_FALSE(HashAggregator::isSupported(agg(Kind::SUM, 3)));
+    EXPECT_FALSE(HashAggregator::isSupported(agg(Kind::COUNT_DISTINCT, 2)));
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -125,7 +125,7 @@ TEST_F(IndexTest, TagIndex) {
         cpp2::ExecutionResponse resp;
         std::string query = "REBUILD TAG INDEX single_tag_index";
         auto code = client->execute(query, resp);
-        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
     }
     {
         cpp2::ExecutionResponse resp;
@@ -137,7 +137,7 @@ TEST_F(IndexTest, TagIndex) {
         cpp2::ExecutionResponse resp;
         std::string query = "REBUILD TAG INDEX multi_tag_index";
         auto code = client->execute(query, resp);
-        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
     }
     sleep(FLAGS_heartbeat_interval_secs + 1);
     // Show Tag Index Status
@@ -329,7 +329,7 @@ TEST_F(IndexTest, EdgeIndex) {
         cpp2::ExecutionResponse resp;
         std::string query = "REBUILD EDGE INDEX single_edge_index";
         auto code = client->execute(query, resp);
-        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
     }
     {
         cpp2::ExecutionResponse resp;
@@ -341,7 +341,7 @@ TEST_F(IndexTest, EdgeIndex) {
         cpp2::ExecutionResponse resp;
         std::string query = "REBUILD EDGE INDEX multi_edge_1_index";
         auto code = client->execute(query, resp);
-        ASSERT_EQ(cpp2::ErrorCode::E_EXECUTION_ERROR, code);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
     }
     sleep(FLAGS_heartbeat_interval_secs + 1);
     // Show EDGE Index Status
@@ -236,6 +236,32 @@ TEST_F(LookupTest, VertexConditionScan) {
         auto query = "LOOKUP ON lookup_tag_2 WHERE lookup_tag_2.col2 == 100 "
                      "OR lookup_tag_2.col2 == 200";
         auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<VertexID>> expected = {
+            {220},
+            {221},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    {
+        // Union of the scans of t_index_2 and t_index_4
+        cpp2::ExecutionResponse resp;
+        auto query = "LOOKUP ON lookup_tag_2 WHERE lookup_tag_2.col2 == 100 "
+                     "OR lookup_tag_2.col3 == 300.5 OR lookup_tag_2.col2 == 200";
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<VertexID>> expected = {
+            {220},
+            {221},
+            {222},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    {
+        cpp2::ExecutionResponse resp;
+        auto query = "LOOKUP ON lookup_tag_2 WHERE lookup_tag_2.col2 == 100 "
+                     "XOR lookup_tag_2.col2 == 200";
+        auto code = client_->execute(query, resp);
         ASSERT_EQ(cpp2::ErrorCode::E_SYNTAX_ERROR, code);
     }
     {
@@ -398,7 +424,12 @@ TEST_F(LookupTest, EdgeConditionScan) {
         auto query = "LOOKUP ON lookup_edge_2 WHERE lookup_edge_2.col2 == 100 "
                      "OR lookup_edge_2.col2 == 200";
         auto code = client_->execute(query, resp);
-        ASSERT_EQ(cpp2::ErrorCode::E_SYNTAX_ERROR, code);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+        std::vector<std::tuple<VertexID, VertexID, EdgeRanking>> expected = {
+            {220, 221, 0},
+            {220, 222, 0},
+        };
+        ASSERT_TRUE(verifyResult(resp, expected));
     }
     {
         cpp2::ExecutionResponse resp;
@@ -1032,6 +1063,197 @@ TEST_F(LookupTest, OptimizerWithStringFieldTest) {
     }
 }
 
+// An index of int fields, with the ndv and the histogram of every field
+static std::shared_ptr<nebula::cpp2::IndexItem> indexWithStats(
+        IndexID id,
+        const std::vector<std::tuple<std::string, int64_t, std::vector<double>>> &fields) {
+    auto index = std::make_shared<nebula::cpp2::IndexItem>();
+    index->set_index_id(id);
+    index->set_index_name(folly::stringPrintf("index_%d", id));
+    std::vector<nebula::cpp2::ColumnDef> columns;
+    std::vector<nebula::cpp2::IndexColumnStats> columnsStats;
+    for (const auto &field : fields) {
+        nebula::cpp2::ColumnDef column;
+        column.set_name(std::get<0>(field));
+        column.type.set_type(nebula::cpp2::SupportedType::INT);
+        columns.emplace_back(std::move(column));
+        nebula::cpp2::IndexColumnStats columnStats;
+        columnStats.set_ndv(std::get<1>(field));
+        columnStats.set_histogram(std::get<2>(field));
+        columnsStats.emplace_back(std::move(columnStats));
+    }
+    index->set_fields(std::move(columns));
+    nebula::cpp2::IndexStats stats;
+    stats.set_rows(1000);
+    stats.set_columns(std::move(columnsStats));
+    index->set_stats(std::move(stats));
+    return index;
+}
+
+TEST_F(LookupTest, OptimizerWithStatsTest) {
+    {
+        cpp2::ExecutionResponse resp;
+        auto stmt = "CREATE TAG t1_stats(c1 int, c2 int, c3 int)";
+        auto code = client_->execute(stmt, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+    }
+    sleep(FLAGS_heartbeat_interval_secs + 1);
+
+    auto mc = gEnv->metaClient();
+    auto ectx = std::make_unique<ExecutionContext>(nullptr,
+                                                   gEnv->schemaManager(),
+                                                   nullptr,
+                                                   nullptr,
+                                                   nullptr,
+                                                   nullptr);
+    auto executor = std::make_unique<LookupExecutor>(nullptr, ectx.get());
+    executor->spaceId_ = 1;
+    auto tagID = mc->getTagIDByNameFromCache(1, "t1_stats");
+    ASSERT_TRUE(tagID.ok());
+    executor->tagOrEdge_ = tagID.value();
+    // 1000 rows, c1 has 2 distinct values, c2 and c3 are unique and uniform in [0, 1000]
+    std::vector<double> bounds;
+    for (auto i = 0; i <= 10; i++) {
+        bounds.emplace_back(i * 100);
+    }
+    auto i1 = indexWithStats(1001, {std::make_tuple("c1", 2, std::vector<double>{0, 1}),
+                                    std::make_tuple("c2", 1000, bounds),
+                                    std::make_tuple("c3", 1000, bounds)});
+    auto i2 = indexWithStats(1002, {std::make_tuple("c3", 1000, bounds),
+                                    std::make_tuple("c1", 1000, std::vector<double>{0, 1}),
+                                    std::make_tuple("c2", 1000, bounds)});
+    executor->indexes_ = {i1, i2};
+    {
+        // "LOOKUP on t1_stats WHERE c1 == 1 and c2 > 900 and c3 > 990";
+        // expected i2, scanning 10 rows rather than 50
+        executor->filters_.emplace_back("c1", RelationalExpression::Operator::EQ);
+        executor->filters_.emplace_back("c2", RelationalExpression::Operator::GT);
+        executor->filters_.emplace_back("c3", RelationalExpression::Operator::GT);
+        executor->filterValues_ = {1.0, 900.0, 990.0};
+        ASSERT_TRUE(executor->findOptimalIndex().ok());
+        ASSERT_EQ(1002, executor->index_);
+        executor->filters_.clear();
+        executor->filterValues_.clear();
+    }
+    {
+        // "LOOKUP on t1_stats WHERE c1 == 1 and c2 > 900 and c3 > 500";
+        // expected i1, scanning 50 rows rather than 500
+        executor->filters_.emplace_back("c1", RelationalExpression::Operator::EQ);
+        executor->filters_.emplace_back("c2", RelationalExpression::Operator::GT);
+        executor->filters_.emplace_back("c3", RelationalExpression::Operator::GT);
+        executor->filterValues_ = {1.0, 900.0, 500.0};
+        ASSERT_TRUE(executor->findOptimalIndex().ok());
+        ASSERT_EQ(1001, executor->index_);
+        executor->filters_.clear();
+        executor->filterValues_.clear();
+    }
+    {
+        // Without the stats of i2, the equal condition is preferred; expected i1
+        i2->__isset.stats = false;
+        executor->filters_.emplace_back("c1", RelationalExpression::Operator::EQ);
+        executor->filters_.emplace_back("c2", RelationalExpression::Operator::GT);
+        executor->filters_.emplace_back("c3", RelationalExpression::Operator::GT);
+        executor->filterValues_ = {1.0, 900.0, 990.0};
+        ASSERT_TRUE(executor->findOptimalIndex().ok());
+        ASSERT_EQ(1001, executor->index_);
+        executor->filters_.clear();
+        executor->filterValues_.clear();
+    }
+}
+
+TEST_F(LookupTest, OptimizerMultiIndexTest) {
+    {
+        cpp2::ExecutionResponse resp;
+        auto stmt = "CREATE TAG t1_multi(c1 int, c2 int, c3 int)";
+        auto code = client_->execute(stmt, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+    }
+    sleep(FLAGS_heartbeat_interval_secs + 1);
+
+    auto mc = gEnv->metaClient();
+    auto ectx = std::make_unique<ExecutionContext>(nullptr,
+                                                   gEnv->schemaManager(),
+                                                   nullptr,
+                                                   nullptr,
+                                                   nullptr,
+                                                   nullptr);
+    auto executor = std::make_unique<LookupExecutor>(nullptr, ectx.get());
+    std::string from = "t1_multi";
+    executor->spaceId_ = 1;
+    executor->from_ = &from;
+    auto tagID = mc->getTagIDByNameFromCache(1, from);
+    ASSERT_TRUE(tagID.ok());
+    executor->tagOrEdge_ = tagID.value();
+    // i1 on (c1), i2 on (c2), i3 on (c2, c3)
+    std::vector<double> bounds = {0, 1000};
+    auto i1 = indexWithStats(2001, {std::make_tuple("c1", 1000, bounds)});
+    auto i2 = indexWithStats(2002, {std::make_tuple("c2", 1000, bounds)});
+    auto i3 = indexWithStats(2003, {std::make_tuple("c2", 1000, bounds),
+                                    std::make_tuple("c3", 1000, bounds)});
+    for (auto &index : {i1, i2, i3}) {
+        index->__isset.stats = false;
+    }
+    executor->indexes_ = {i1, i2, i3};
+    auto rel = [&from] (const char *prop, RelationalExpression::Operator op, int64_t v) {
+        auto *aExpr = new AliasPropertyExpression(new std::string(""),
+                                                  new std::string(from),
+                                                  new std::string(prop));
+        return new RelationalExpression(aExpr, op, new PrimaryExpression(v));
+    };
+    {
+        // "LOOKUP on t1_multi WHERE c1 == 1 and c2 == 2 and c3 > 3";
+        // expected the intersection of i3 for c2 and c3, then i1 for c1
+        auto *c1 = rel("c1", RelationalExpression::Operator::EQ, 1);
+        auto *c2 = rel("c2", RelationalExpression::Operator::EQ, 2);
+        auto *c3 = rel("c3", RelationalExpression::Operator::GT, 3);
+        auto *left = new LogicalExpression(c1, LogicalExpression::Operator::AND, c2);
+        LogicalExpression filter(left, LogicalExpression::Operator::AND, c3);
+        ASSERT_TRUE(executor->checkFilter(&filter).ok());
+        ASSERT_TRUE(executor->findOptimalIndex().isIndexNotFound());
+        ASSERT_TRUE(executor->findIndexesToIntersect(&filter).ok());
+        ASSERT_FALSE(executor->isUnion_);
+        ASSERT_EQ(2, executor->contexts_.size());
+        ASSERT_EQ(2003, executor->contexts_[0].get_index_id());
+        ASSERT_EQ(2001, executor->contexts_[1].get_index_id());
+        auto cond = Expression::decode(executor->contexts_[0].get_filter());
+        ASSERT_TRUE(cond.ok());
+        ASSERT_EQ(LogicalExpression(rel("c2", RelationalExpression::Operator::EQ, 2),
+                                    LogicalExpression::Operator::AND,
+                                    rel("c3", RelationalExpression::Operator::GT, 3)).toString(),
+                  cond.value()->toString());
+        executor->filters_.clear();
+        executor->filterValues_.clear();
+        executor->contexts_.clear();
+    }
+    {
+        // "LOOKUP on t1_multi WHERE c1 == 1 or c1 == 5 or c3 > 3";
+        // no index for c3
+        auto *c1 = rel("c1", RelationalExpression::Operator::EQ, 1);
+        auto *c2 = rel("c1", RelationalExpression::Operator::EQ, 5);
+        auto *c3 = rel("c3", RelationalExpression::Operator::GT, 3);
+        auto *left = new LogicalExpression(c1, LogicalExpression::Operator::OR, c2);
+        LogicalExpression filter(left, LogicalExpression::Operator::OR, c3);
+        ASSERT_TRUE(executor->findIndexesToUnion({left, c3}).isIndexNotFound());
+        executor->filters_.clear();
+        executor->filterValues_.clear();
+        executor->contexts_.clear();
+    }
+    {
+        // "LOOKUP on t1_multi WHERE c1 == 1 or c1 == 5 or c2 > 3";
+        // expected the union of i1 for the IN list of c1, and i2 or i3 for c2
+        auto *c1 = rel("c1", RelationalExpression::Operator::EQ, 1);
+        auto *c2 = rel("c1", RelationalExpression::Operator::EQ, 5);
+        auto *c3 = rel("c2", RelationalExpression::Operator::GT, 3);
+        auto *left = new LogicalExpression(c1, LogicalExpression::Operator::OR, c2);
+        LogicalExpression filter(left, LogicalExpression::Operator::OR, c3);
+        ASSERT_TRUE(executor->findIndexesToUnion({left, c3}).ok());
+        ASSERT_TRUE(executor->isUnion_);
+        ASSERT_EQ(2, executor->contexts_.size());
+        ASSERT_EQ(2001, executor->contexts_[0].get_index_id());
+        ASSERT_NE(2001, executor->contexts_[1].get_index_id());
+    }
+}
+
 TEST_F(LookupTest, StringFieldTest) {
     {
         cpp2::ExecutionResponse resp;
@@ -0,0 +1,157 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "graph/MemoryTracker.h"
+#include "graph/SpillFile.h"
+#include "graph/GraphFlags.h"
+#include "graph/GroupByExecutor.h"
+#include "fs/TempDir.h"
+
+namespace nebula {
+namespace graph {
+
+TEST(MemoryTracker, Limit) {
+    MemoryTracker parent(100);
+    {
+        MemoryTracker query(60, &parent);
+        ASSERT_TRUE(query.tryConsume(50));
+        EXPECT_EQ(50, parent.used());
+        // Over the limit of the query
+        ASSERT_FALSE(query.tryConsume(20));
+        EXPECT_EQ(50, query.used());
+        EXPECT_EQ(50, parent.used());
+
+        MemoryTracker other(0, &parent);
+        // Over the limit of the parent
+        ASSERT_FALSE(other.tryConsume(60));
+        ASSERT_TRUE(other.tryConsume(40));
+        EXPECT_EQ(90, parent.used());
+
+        query.release(30);
+        EXPECT_EQ(20, query.used());
+        EXPECT_EQ(50, query.peak());
+        EXPECT_EQ(60, parent.used());
+
+        // Taken whatever the limit
+        query.consume(100);
+        EXPECT_EQ(120, query.used());
+        EXPECT_EQ(160, parent.used());
+    }
+    // All released once the queries finish
+    EXPECT_EQ(0, parent.used());
+    EXPECT_EQ(160, parent.peak());
+}
+
+TEST(MemoryTracker, RowSize) {
+    cpp2::RowValue row;
+    std::vector<cpp2::ColumnValue> cols(2);
+    cols[0].set_integer(1);
+    cols[1].set_str(std::string(1000, 'a'));
+    row.set_columns(std::move(cols));
+    EXPECT_LE(1000 + sizeof(cpp2::RowValue) + 2 * sizeof(cpp2::ColumnValue),
+              MemoryTracker::rowSize(row));
+}
+
+TEST(SpillFile, WriteAndRead) {
+    fs::TempDir dir("/tmp/SpillFileTest.XXXXXX");
+    FLAGS_graph_spill_dir = dir.path();
+    auto ret = SpillFile::create();
+    ASSERT_TRUE(ret.ok());
+    auto file = std::move(ret).value();
+
+    // More than the buffer of the file
+    const int64_t total = 100000;
+    for (int64_t i = 0; i < total; i++) {
+        cpp2::RowValue row;
+        std::vector<cpp2::ColumnValue> cols(2);
+        cols[0].set_integer(i);
+        cols[1].set_str(folly::stringPrintf("string_%ld", i));
+        row.set_columns(std::move(cols));
+        ASSERT_TRUE(file->write(row).ok());
+    }
+    EXPECT_EQ(total, file->rows());
+
+    for (auto round = 0; round < 2; round++) {
+        ASSERT_TRUE(file->rewind().ok());
+        int64_t count = 0;
+        while (true) {
+            cpp2::RowValue row;
+            auto r = file->read(&row);
+            ASSERT_TRUE(r.ok());
+            if (!r.value()) {
+                break;
+            }
+            auto &cols = row.get_columns();
+            ASSERT_EQ(2, cols.size());
+            EXPECT_EQ(count, cols[0].get_integer());
+            EXPECT_EQ(folly::stringPrintf("string_%ld", count), cols[1].get_str());
+            count++;
+        }
+        EXPECT_EQ(total, count);
+    }
+}
+
+TEST(GroupByExecutor, SpillWholeGroups) {
+    fs::TempDir dir("/tmp/GroupBySpillTest.XXXXXX");
+    FLAGS_graph_spill_dir = dir.path();
+    auto ectx = std::make_unique<ExecutionContext>(nullptr,
+                                                   nullptr,
+                                                   nullptr,
+                                                   nullptr,
+                                                   nullptr,
+                                                   nullptr);
+    // GROUP BY $-.id YIELD $-.id, COUNT($-.id)
+    YieldColumn key(new InputPropertyExpression(new std::string("id")));
+    YieldColumn group(new InputPropertyExpression(new std::string("id")));
+    YieldColumn count(new InputPropertyExpression(new std::string("id")));
+    count.setFunction(new std::string(kCount));
+    auto executor = std::make_unique<GroupByExecutor>(nullptr, ectx.get());
+    executor->schemaMap_["id"] = 0;
+    executor->groupCols_ = {&key};
+    executor->yieldCols_ = {&group, &count};
+
+    auto *tracker = ectx->memTracker();
+    tracker->setLimit(1000);
+    std::unordered_map<int64_t, int64_t> expected;
+    GroupByExecutor::GroupData data;
+    GroupByExecutor::Partitions partitions;
+    auto aggregate = [&] (int64_t id) {
+        cpp2::RowValue row;
+        std::vector<cpp2::ColumnValue> cols(1);
+        cols[0].set_integer(id);
+        row.set_columns(std::move(cols));
+        expected[id]++;
+        return executor->aggregate(row, 0, &data, &partitions);
+    };
+    // The tracker is full, all the groups are spilled
+    tracker->consume(1000);
+    for (auto i = 0; i < 100; i++) {
+        ASSERT_TRUE(aggregate(i % 20).ok());
+    }
+    ASSERT_TRUE(data.empty());
+    // Freed by another executor, the rows of the spilled groups still go to disk,
+    // while some of the new groups fit in memory
+    tracker->release(1000);
+    for (auto i = 0; i < 200; i++) {
+        ASSERT_TRUE(aggregate(i % 40).ok());
+    }
+    ASSERT_FALSE(data.empty());
+    executor->outputGroups(&data);
+    ASSERT_TRUE(executor->aggregatePartitions(std::move(partitions), 1).ok());
+
+    std::unordered_map<int64_t, int64_t> result;
+    for (auto &row : executor->rows_) {
+        auto id = row.columns[0].get_integer();
+        // Every group is output once, with all its rows
+        ASSERT_TRUE(result.emplace(id, row.columns[1].get_integer()).second) << id;
+    }
+    EXPECT_EQ(expected, result);
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -453,6 +453,68 @@ TEST_F(SetTest, Intersect) {
     }
 }
 
+TEST_F(SetTest, DuplicateRows) {
+    auto &tim = players_["Tim Duncan"];
+    auto &tony = players_["Tony Parker"];
+    auto &manu = players_["Manu Ginobili"];
+    // The teams of the players Tim likes, with duplicates
+    std::unordered_map<std::string, int64_t> likedTeams;
+    for (auto &like : tim.likes()) {
+        for (auto &serve : players_[std::get<0>(like)].serves()) {
+            likedTeams[std::get<0>(serve)]++;
+        }
+    }
+    {
+        // A row appears as many times as it does in both sides
+        cpp2::ExecutionResponse resp;
+        auto *fmt =
+            "GO FROM %ld OVER serve YIELD $$.team.name"
+            " UNION ALL "
+            "GO FROM %ld OVER serve YIELD $$.team.name"
+            " INTERSECT "
+            "GO FROM %ld OVER like YIELD like._dst as id | "
+            "GO FROM $-.id OVER serve YIELD $$.team.name";
+        auto query = folly::stringPrintf(fmt, tony.vid(), tony.vid(), tim.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::vector<std::tuple<std::string>> expected;
+        for (auto &serve : tony.serves()) {
+            auto times = std::min(2L, likedTeams[std::get<0>(serve)]);
+            for (auto i = 0L; i < times; i++) {
+                expected.emplace_back(std::get<0>(serve));
+            }
+        }
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+    {
+        // All the duplicates of a row are removed
+        cpp2::ExecutionResponse resp;
+        auto *fmt =
+            "GO FROM %ld OVER serve YIELD $$.team.name"
+            " UNION ALL "
+            "GO FROM %ld OVER serve YIELD $$.team.name"
+            " MINUS "
+            "GO FROM %ld OVER serve YIELD $$.team.name";
+        auto query = folly::stringPrintf(fmt, tony.vid(), tony.vid(), manu.vid());
+        auto code = client_->execute(query, resp);
+        ASSERT_EQ(cpp2::ErrorCode::SUCCEEDED, code);
+
+        std::unordered_set<std::string> manuTeams;
+        for (auto &serve : manu.serves()) {
+            manuTeams.emplace(std::get<0>(serve));
+        }
+        std::vector<std::tuple<std::string>> expected;
+        for (auto &serve : tony.serves()) {
+            if (manuTeams.count(std::get<0>(serve)) == 0) {
+                expected.emplace_back(std::get<0>(serve));
+                expected.emplace_back(std::get<0>(serve));
+            }
+        }
+        ASSERT_TRUE(verifyResult(resp, expected));
+    }
+}
+
 TEST_F(SetTest, Mix) {
     {
         cpp2::ExecutionResponse resp;
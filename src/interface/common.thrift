@@ -93,12 +93,31 @@ union SchemaID {
     2: EdgeType      edge_type,
 }
 
+struct IndexColumnStats {
+    // The approximate distinct values of the columns from the first one to this one
+    1: i64                 ndv,
+    // The bounds of the buckets holding the same number of rows, from the min to the max,
+    // only for the numeric columns
+    2: list<double>        histogram,
+}
+
+struct IndexStats {
+    1: i64                          rows,
+    2: list<IndexColumnStats>       columns,
+    // When the stats were collected, in seconds
+    3: i64                          update_time,
+}
+
 struct IndexItem {
     1: IndexID             index_id,
     2: string              index_name,
     3: SchemaID            schema_id
     4: string              schema_name,
     5: list<ColumnDef>     fields,
+    // False while the index is being built or its last build failed
+    6: bool                complete = true,
+    // Collected by the stats job
+    7: optional IndexStats stats,
 }
 
 struct HostAddr {
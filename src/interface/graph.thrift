@@ -119,6 +119,26 @@ struct ExecutionResponse {
 }
 
 
+// One vertex or edge of a bulk insertion, the values are in the order of prop_names
+struct BulkInsertRow {
+    1: common.VertexID id;                      // Vertex id, or the source of the edge
+    2: optional common.VertexID dst;
+    3: optional common.EdgeRanking ranking;
+    4: list<ColumnValue> values;
+}
+
+struct BulkInsertRequest {
+    // Insert into the space of the session if not set
+    1: optional binary space_name;
+    2: bool is_edge;
+    // Name of the tag or the edge
+    3: binary name;
+    4: list<binary> prop_names;
+    5: list<BulkInsertRow> rows;
+    6: bool overwritable = true;
+}
+
+
 struct AuthResponse {
     1: required ErrorCode error_code;
     2: optional i64 session_id;
@@ -132,4 +152,7 @@ service GraphService {
     oneway void signout(1: i64 sessionId)
 
     ExecutionResponse execute(1: i64 sessionId, 2: string stmt)
+
+    // Insert the typed rows directly, without going through the nGQL parser
+    ExecutionResponse bulkInsert(1: i64 sessionId, 2: BulkInsertRequest req)
 }
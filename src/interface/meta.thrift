@@ -187,6 +187,8 @@ struct TaskDesc {
     4: i64              start_time
     5: i64              stop_time
     6: i32              job_id
+    // Set if the task works on a single part
+    7: optional common.PartitionID  part_id
 }
 
 struct AdminJobResult {
@@ -114,6 +114,9 @@ struct AppendLogResponse {
     5: LogID               committed_log_id;
     6: LogID               last_log_id;
     7: TermID              last_log_term;
+    // Bit mask of the log codecs the follower is able to decode, the leader
+    // only compresses the logs with a codec all peers have reported
+    8: optional i32        supported_log_codecs;
 }
 
 struct SendSnapshotRequest {
@@ -135,6 +135,12 @@ struct VertexIndexData {
     2: binary                props,
 }
 
+struct Frontier {
+    // The hops left to go from the vertices, including the one out of them
+    1: i32                   steps,
+    2: list<common.VertexID> vertices,
+}
+
 struct ResponseCommon {
     // Only contains the partition that returns error
     1: required list<ResultCode> failed_codes,
@@ -148,6 +154,8 @@ struct QueryResponse {
     3: optional map<common.EdgeType, common.Schema>(cpp.template = "std::unordered_map")    edge_schema,
     4: optional list<VertexData> vertices,
     5: optional i32 total_edges,
+    // Only set by traverse, the vertices reached but not led by the host
+    6: optional list<Frontier> frontiers,
 }
 
 struct ExecResponse {
@@ -184,6 +192,15 @@ struct GetNeighborsRequest {
     3: list<common.EdgeType> edge_types,
     4: binary filter,
     5: list<PropDef> return_columns,
+    // Return at most `limit` edges of each edge type for one vertex,
+    // the smaller one of it and max_edge_returned_per_vertex takes effect.
+    6: optional i64 limit,
+    // Pick the returned edges of one vertex by reservoir sampling,
+    // rather than the first `limit` ones.
+    7: optional bool random,
+    // Only used by traverse, the hops to go from the vertices. The filter and
+    // return_columns only take effect on the last hop.
+    8: optional i32 steps,
 }
 
 struct VertexPropRequest {
@@ -423,6 +440,18 @@ struct GetUUIDResp {
     2: common.VertexID id,
 }
 
+// Get the ids of a batch of names, the names are grouped by their parts
+struct GetUUIDsReq {
+    1: common.GraphSpaceID space_id,
+    2: map<common.PartitionID, list<string>>(cpp.template = "std::unordered_map") parts,
+}
+
+struct GetUUIDsResp {
+    1: required ResponseCommon result,
+    // name => vertex id, the names in the failed parts are absent
+    2: map<string, common.VertexID>(cpp.template = "std::unordered_map") ids,
+}
+
 struct BlockingSignRequest {
     1: common.GraphSpaceID          space_id,
     2: required EngineSignType      sign,
@@ -445,6 +474,12 @@ struct RebuildIndexRequest {
     4: bool                         is_offline,
 }
 
+// The scan of one index, by the part of the filter on its fields
+struct IndexQueryContext {
+    1: common.IndexID            index_id,
+    2: binary                    filter,
+}
+
 struct LookUpIndexRequest {
     1: common.GraphSpaceID       space_id,
     2: list<common.PartitionID>  parts,
@@ -452,6 +487,10 @@ struct LookUpIndexRequest {
     4: binary                    filter,
     5: list<string>              return_columns,
     6: bool                      is_edge,
+    // If not empty, the indexes of the contexts are scanned instead of index_id,
+    // and the rows hit by all of them are returned, or by any of them if is_union.
+    7: list<IndexQueryContext>   contexts,
+    8: bool                      is_union = false,
 }
 
 struct LookUpIndexResp {
@@ -466,6 +505,11 @@ service StorageService {
 
     QueryStatsResponse boundStats(1: GetNeighborsRequest req)
 
+    // Go `steps` hops from the vertices, the hops out of the vertices led by the
+    // host are expanded locally. Return the rows of the last hop, and the frontiers
+    // which have to be continued on other hosts.
+    QueryResponse traverse(1: GetNeighborsRequest req)
+
     // When return_columns is empty, return all properties
     QueryResponse getProps(1: VertexPropRequest req);
     EdgePropResponse getEdgeProps(1: EdgePropRequest req)
@@ -508,6 +552,7 @@ service StorageService {
     ExecResponse      removeRange(1: RemoveRangeRequest req);
 
     GetUUIDResp getUUID(1: GetUUIDReq req);
+    GetUUIDsResp getUUIDs(1: GetUUIDsReq req);
 
     // Interfaces for edge and vertex index scan
     LookUpIndexResp   lookUpIndex(1: LookUpIndexRequest req);
@@ -0,0 +1,79 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "kvstore/DirtyVertexTracker.h"
+
+namespace nebula {
+namespace kvstore {
+
+// static
+DirtyVertexTracker& DirtyVertexTracker::instance() {
+    static DirtyVertexTracker tracker;
+    return tracker;
+}
+
+int64_t DirtyVertexTracker::start(GraphSpaceID spaceId, PartitionID partId) {
+    std::lock_guard<std::mutex> g(lock_);
+    auto sessionId = ++lastSessionId_;
+    sessions_[std::make_pair(spaceId, partId)].emplace(sessionId,
+                                                       std::unordered_set<VertexID>());
+    sessionsNum_++;
+    return sessionId;
+}
+
+void DirtyVertexTracker::stop(GraphSpaceID spaceId, PartitionID partId, int64_t sessionId) {
+    std::lock_guard<std::mutex> g(lock_);
+    auto it = sessions_.find(std::make_pair(spaceId, partId));
+    if (it == sessions_.end() || it->second.erase(sessionId) == 0) {
+        return;
+    }
+    if (it->second.empty()) {
+        sessions_.erase(it);
+    }
+    sessionsNum_--;
+}
+
+bool DirtyVertexTracker::isTracked(GraphSpaceID spaceId, PartitionID partId) {
+    if (sessionsNum_.load() == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> g(lock_);
+    return sessions_.find(std::make_pair(spaceId, partId)) != sessions_.end();
+}
+
+void DirtyVertexTracker::touch(GraphSpaceID spaceId,
+                               PartitionID partId,
+                               const std::vector<VertexID>& vIds) {
+    if (vIds.empty() || sessionsNum_.load() == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> g(lock_);
+    auto it = sessions_.find(std::make_pair(spaceId, partId));
+    if (it == sessions_.end()) {
+        return;
+    }
+    for (auto& session : it->second) {
+        session.second.insert(vIds.begin(), vIds.end());
+    }
+}
+
+std::unordered_set<VertexID> DirtyVertexTracker::take(GraphSpaceID spaceId,
+                                                      PartitionID partId,
+                                                      int64_t sessionId) {
+    std::unordered_set<VertexID> vIds;
+    std::lock_guard<std::mutex> g(lock_);
+    auto it = sessions_.find(std::make_pair(spaceId, partId));
+    if (it != sessions_.end()) {
+        auto session = it->second.find(sessionId);
+        if (session != it->second.end()) {
+            vIds.swap(session->second);
+        }
+    }
+    return vIds;
+}
+
+}  // namespace kvstore
+}  // namespace nebula
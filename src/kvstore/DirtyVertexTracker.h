@@ -0,0 +1,59 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef KVSTORE_DIRTYVERTEXTRACKER_H_
+#define KVSTORE_DIRTYVERTEXTRACKER_H_
+
+#include "base/Base.h"
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * Collects the vertices whose data (tags or out edges) are committed into a part,
+ * from the moment a tracking session on the part starts. It is used by the online
+ * index building, which has to reconcile the index of the vertices written while
+ * the part is being scanned.
+ *
+ * The parts call touch() after their logs are committed, which costs nothing
+ * but an atomic load when no session is running.
+ * */
+class DirtyVertexTracker final {
+public:
+    static DirtyVertexTracker& instance();
+
+    /**
+     * Start a session on the part, and return its id.
+     * */
+    int64_t start(GraphSpaceID spaceId, PartitionID partId);
+
+    void stop(GraphSpaceID spaceId, PartitionID partId, int64_t sessionId);
+
+    bool isTracked(GraphSpaceID spaceId, PartitionID partId);
+
+    void touch(GraphSpaceID spaceId, PartitionID partId, const std::vector<VertexID>& vIds);
+
+    /**
+     * Return the vertices touched since the last call, and clear them.
+     * */
+    std::unordered_set<VertexID> take(GraphSpaceID spaceId,
+                                      PartitionID partId,
+                                      int64_t sessionId);
+
+private:
+    DirtyVertexTracker() = default;
+
+private:
+    std::atomic<int32_t> sessionsNum_{0};
+    std::mutex lock_;
+    int64_t lastSessionId_ = 0;
+    std::map<std::pair<GraphSpaceID, PartitionID>,
+             std::unordered_map<int64_t, std::unordered_set<VertexID>>> sessions_;
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+#endif  // KVSTORE_DIRTYVERTEXTRACKER_H_
@@ -25,6 +25,16 @@ public:
     virtual folly::StringPiece key() const = 0;
 
     virtual folly::StringPiece val() const = 0;
+
+    /**
+     * Move to the first key not less than the target. The default one just
+     * steps forward, engines supporting seek should override it.
+     * */
+    virtual void seek(folly::StringPiece target) {
+        while (valid() && key() < target) {
+            next();
+        }
+    }
 };
 
 }  // namespace kvstore
@@ -5,6 +5,8 @@
  */
 
 #include "base/Base.h"
+#include <lz4.h>
+#include <zstd.h>
 #include "time/WallClock.h"
 #include "kvstore/LogEncoder.h"
 
@@ -12,6 +14,8 @@ namespace nebula {
 namespace kvstore {
 
 constexpr auto kHeadLen = sizeof(int64_t) + 1 + sizeof(uint32_t);
+constexpr auto kCompressedHeadLen = sizeof(int64_t) + 1 + 1 + sizeof(uint32_t);
+constexpr int32_t kZstdLevel = 1;
 
 std::string encodeKV(const folly::StringPiece& key,
                      const folly::StringPiece& val) {
@@ -243,6 +247,103 @@ int64_t getTimestamp(const folly::StringPiece& command) {
     return *reinterpret_cast<const int64_t*>(command.begin());
 }
 
+LogCodec toLogCodec(const std::string& name) {
+    if (name == "lz4") {
+        return CODEC_LZ4;
+    } else if (name == "zstd") {
+        return CODEC_ZSTD;
+    }
+    return CODEC_NONE;
+}
+
+folly::Optional<std::string> compressLog(LogCodec codec, folly::StringPiece log) {
+    if (log.size() <= sizeof(int64_t) || log.size() > std::numeric_limits<int32_t>::max()) {
+        return folly::none;
+    }
+    size_t bound = 0;
+    switch (codec) {
+        case CODEC_LZ4:
+            bound = LZ4_compressBound(log.size());
+            break;
+        case CODEC_ZSTD:
+            bound = ZSTD_compressBound(log.size());
+            break;
+        default:
+            return folly::none;
+    }
+
+    std::string encoded;
+    encoded.resize(kCompressedHeadLen + bound);
+    char* p = &encoded[0];
+    // Timestamp (8 bytes), keep the one of the original log
+    memcpy(p, log.begin(), sizeof(int64_t));
+    p += sizeof(int64_t);
+    // Log type
+    *p++ = OP_COMPRESSED;
+    // Codec
+    *p++ = codec;
+    // Raw size
+    uint32_t rawSize = log.size();
+    memcpy(p, &rawSize, sizeof(uint32_t));
+    p += sizeof(uint32_t);
+
+    size_t compressedSize = 0;
+    if (codec == CODEC_LZ4) {
+        auto ret = LZ4_compress_default(log.begin(), p, log.size(), bound);
+        if (ret <= 0) {
+            return folly::none;
+        }
+        compressedSize = ret;
+    } else {
+        auto ret = ZSTD_compress(p, bound, log.begin(), log.size(), kZstdLevel);
+        if (ZSTD_isError(ret)) {
+            return folly::none;
+        }
+        compressedSize = ret;
+    }
+
+    if (kCompressedHeadLen + compressedSize >= log.size()) {
+        // Not worth it
+        return folly::none;
+    }
+    encoded.resize(kCompressedHeadLen + compressedSize);
+    return encoded;
+}
+
+folly::Optional<std::string> decompressLog(folly::StringPiece log) {
+    if (log.size() < kCompressedHeadLen || log[sizeof(int64_t)] != OP_COMPRESSED) {
+        return folly::none;
+    }
+    auto* p = log.begin() + sizeof(int64_t) + 1;
+    auto codec = static_cast<LogCodec>(*p++);
+    uint32_t rawSize;
+    memcpy(&rawSize, p, sizeof(uint32_t));
+    p += sizeof(uint32_t);
+    size_t compressedSize = log.size() - kCompressedHeadLen;
+
+    std::string raw;
+    raw.resize(rawSize);
+    switch (codec) {
+        case CODEC_LZ4: {
+            auto ret = LZ4_decompress_safe(p, &raw[0], compressedSize, rawSize);
+            if (ret < 0 || static_cast<uint32_t>(ret) != rawSize) {
+                return folly::none;
+            }
+            break;
+        }
+        case CODEC_ZSTD: {
+            auto ret = ZSTD_decompress(&raw[0], rawSize, p, compressedSize);
+            if (ZSTD_isError(ret) || ret != rawSize) {
+                return folly::none;
+            }
+            break;
+        }
+        default:
+            return folly::none;
+    }
+    return raw;
+}
+
 }  // namespace kvstore
 }  // namespace nebula
 
@@ -7,6 +7,7 @@
 #ifndef KVSTORE_LOGENCODER_H_
 #define KVSTORE_LOGENCODER_H_
 
+#include <folly/Optional.h>
 #include "kvstore/Common.h"
 
 namespace nebula {
@@ -23,8 +24,20 @@ enum LogType : char {
     OP_ADD_PEER       = 0x09,
     OP_REMOVE_PEER    = 0x10,
     OP_BATCH_WRITE    = 0x11,
+    OP_COMPRESSED     = 0x12,
 };
 
+// Codecs which could be used to compress a raft log. Each codec is one bit,
+// so the codecs supported by all peers could be negotiated as a mask.
+enum LogCodec : char {
+    CODEC_NONE        = 0x0,
+    CODEC_LZ4         = 0x1,
+    CODEC_ZSTD        = 0x2,
+};
+
+// All codecs this binary is able to decode
+constexpr int32_t kSupportedLogCodecs = CODEC_LZ4 | CODEC_ZSTD;
+
 enum BatchLogType : char {
     OP_BATCH_PUT            = 0x1,
     OP_BATCH_REMOVE         = 0x2,
@@ -57,6 +70,19 @@ HostAddr decodeHost(LogType type, const folly::StringPiece& encoded);
 
 int64_t getTimestamp(const folly::StringPiece& command);
 
+LogCodec toLogCodec(const std::string& name);
+
+/**
+ * Wrap an encoded log into an OP_COMPRESSED log. The layout is
+ *   timestamp (8 bytes) | OP_COMPRESSED | codec (1 byte) | raw size (4 bytes) | payload
+ * The timestamp of the original log is kept, so getTimestamp() works on both.
+ * Return folly::none when the codec is unknown or the log is not shrunk.
+ */
+folly::Optional<std::string> compressLog(LogCodec codec, folly::StringPiece log);
+
+// Return the original log of an OP_COMPRESSED log, folly::none when it is corrupted
+folly::Optional<std::string> decompressLog(folly::StringPiece log);
+
 
 class BatchHolder {
 public:
@@ -0,0 +1,579 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "kvstore/MemEngine.h"
+#include "base/StatusOr.h"
+#include <folly/String.h>
+#include <folly/ScopeGuard.h>
+#include <rocksdb/sst_file_reader.h>
+#include "fs/FileUtils.h"
+#include "utils/NebulaKeyUtils.h"
+
+DEFINE_int32(memory_engine_skiplist_height, 16,
+             "The initial height of the skip list of the memory engine");
+
+namespace nebula {
+namespace kvstore {
+
+using fs::FileUtils;
+using fs::FileType;
+
+namespace {
+
+static constexpr size_t kSnapshotBufferSize = 4 * 1024 * 1024;
+
+/***************************************
+ *
+ * Implementation of WriteBatch
+ *
+ **************************************/
+class MemWriteBatch : public WriteBatch {
+public:
+    enum class Op : int8_t {
+        PUT,
+        REMOVE,
+        REMOVE_RANGE,
+    };
+
+    ResultCode put(folly::StringPiece key, folly::StringPiece value) override {
+        ops_.emplace_back(Op::PUT, key.str(), value.str());
+        return ResultCode::SUCCEEDED;
+    }
+
+    ResultCode remove(folly::StringPiece key) override {
+        ops_.emplace_back(Op::REMOVE, key.str(), "");
+        return ResultCode::SUCCEEDED;
+    }
+
+    // Remove all keys in the range [start, end)
+    ResultCode removeRange(folly::StringPiece start, folly::StringPiece end) override {
+        ops_.emplace_back(Op::REMOVE_RANGE, start.str(), end.str());
+        return ResultCode::SUCCEEDED;
+    }
+
+    const std::vector<std::tuple<Op, std::string, std::string>>& ops() const {
+        return ops_;
+    }
+
+private:
+    std::vector<std::tuple<Op, std::string, std::string>> ops_;
+};
+
+
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(int fd) : fd_(fd) {}
+
+    ~SnapshotWriter() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    bool append(folly::StringPiece key, folly::StringPiece val) {
+        uint32_t klen = key.size();
+        uint32_t vlen = val.size();
+        buffer_.append(reinterpret_cast<const char*>(&klen), sizeof(klen));
+        buffer_.append(reinterpret_cast<const char*>(&vlen), sizeof(vlen));
+        buffer_.append(key.data(), key.size());
+        buffer_.append(val.data(), val.size());
+        if (buffer_.size() >= kSnapshotBufferSize) {
+            return flush();
+        }
+        return true;
+    }
+
+    bool flush() {
+        size_t written = 0;
+        while (written < buffer_.size()) {
+            auto ret = ::write(fd_, buffer_.data() + written, buffer_.size() - written);
+            if (ret < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                LOG(ERROR) << "Write snapshot failed: " << strerror(errno);
+                return false;
+            }
+            written += ret;
+        }
+        buffer_.clear();
+        return true;
+    }
+
+    bool finish() {
+        if (!flush()) {
+            return false;
+        }
+        if (::fsync(fd_) < 0) {
+            LOG(ERROR) << "Sync snapshot failed: " << strerror(errno);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    int             fd_{-1};
+    std::string     buffer_;
+};
+
+}  // Anonymous namespace
+
+
+MemEngine::MemEngine(GraphSpaceID spaceId, const std::string& dataPath)
+        : KVEngine(spaceId)
+        , dataPath_(folly::stringPrintf("%s/nebula/%d", dataPath.c_str(), spaceId))
+        , list_(MemSkipList::createInstance(FLAGS_memory_engine_skiplist_height)) {
+    auto path = folly::stringPrintf("%s/data", dataPath_.c_str());
+    if (FileUtils::fileType(path.c_str()) == FileType::NOTEXIST) {
+        if (!FileUtils::makeDir(path)) {
+            LOG(FATAL) << "makeDir " << path << " failed";
+        }
+    }
+
+    if (FileUtils::fileType(path.c_str()) != FileType::DIRECTORY) {
+        LOG(FATAL) << path << " is not directory";
+    }
+
+    auto snapshot = snapshotPath();
+    if (FileUtils::exist(snapshot)) {
+        CHECK_EQ(ResultCode::SUCCEEDED, loadSnapshot(snapshot))
+            << "Load the snapshot " << snapshot << " failed";
+    }
+    partsNum_ = allParts().size();
+    LOG(INFO) << "open memory engine on " << path;
+}
+
+
+void MemEngine::stop() {
+    // Nothing is left to replay from the wal on the next start
+    flush();
+}
+
+
+std::unique_ptr<WriteBatch> MemEngine::startBatchWrite() {
+    return std::make_unique<MemWriteBatch>();
+}
+
+
+ResultCode MemEngine::commitBatchWrite(std::unique_ptr<WriteBatch> batch,
+                                       bool disableWAL,
+                                       bool sync) {
+    UNUSED(disableWAL);
+    UNUSED(sync);
+    auto* b = static_cast<MemWriteBatch*>(batch.get());
+    for (auto& op : b->ops()) {
+        switch (std::get<0>(op)) {
+            case MemWriteBatch::Op::PUT:
+                doPut(std::get<1>(op), std::get<2>(op));
+                break;
+            case MemWriteBatch::Op::REMOVE:
+                doRemove(std::get<1>(op));
+                break;
+            case MemWriteBatch::Op::REMOVE_RANGE:
+                doRemoveRange(std::get<1>(op), std::get<2>(op));
+                break;
+        }
+    }
+    return ResultCode::SUCCEEDED;
+}
+
+
+ResultCode MemEngine::get(const std::string& key, std::string* value) {
+    MemSkipList::Accessor accessor(list_);
+    auto it = accessor.find(MemEntry(key));
+    if (it != accessor.end()) {
+        auto val = it->loadVal();
+        if (val != nullptr) {
+            *value = *val;
+            return ResultCode::SUCCEEDED;
+        }
+    }
+    VLOG(3) << "Get: " << key << " Not Found";
+    return ResultCode::ERR_KEY_NOT_FOUND;
+}
+
+
+std::vector<Status> MemEngine::multiGet(const std::vector<std::string>& keys,
+                                        std::vector<std::string>* values) {
+    std::vector<Status> ret;
+    ret.reserve(keys.size());
+    values->resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (get(keys[i], &(*values)[i]) == ResultCode::SUCCEEDED) {
+            ret.emplace_back(Status::OK());
+        } else {
+            ret.emplace_back(Status::KeyNotFound());
+        }
+    }
+    return ret;
+}
+
+
+ResultCode MemEngine::range(const std::string& start,
+                            const std::string& end,
+                            std::unique_ptr<KVIterator>* storageIter) {
+    storageIter->reset(new MemIter(list_, start, [end] (folly::StringPiece key) {
+        return key < end;
+    }));
+    return ResultCode::SUCCEEDED;
+}
+
+
+ResultCode MemEngine::prefix(const std::string& prefix,
+                             std::unique_ptr<KVIterator>* storageIter) {
+    return rangeWithPrefix(prefix, prefix, storageIter);
+}
+
+
+ResultCode MemEngine::rangeWithPrefix(const std::string& start,
+                                      const std::string& prefix,
+                                      std::unique_ptr<KVIterator>* storageIter) {
+    storageIter->reset(new MemIter(list_, start, [prefix] (folly::StringPiece key) {
+        return key.startsWith(prefix);
+    }));
+    return ResultCode::SUCCEEDED;
+}
+
+
+void MemEngine::doPut(folly::StringPiece key, folly::StringPiece value) {
+    MemSkipList::Accessor accessor(list_);
+    auto val = std::make_shared<const std::string>(value.str());
+    auto ret = accessor.insert(MemEntry(key.str(), val));
+    if (!ret.second) {
+        ret.first->storeVal(std::move(val));
+    }
+}
+
+
+void MemEngine::doRemove(folly::StringPiece key) {
+    MemSkipList::Accessor accessor(list_);
+    MemEntry entry(key.str());
+    auto it = accessor.find(entry);
+    if (it == accessor.end()) {
+        return;
+    }
+    // The iterators positioned on it skip the entry from now on
+    it->storeVal(nullptr);
+    accessor.erase(entry);
+}
+
+
+void MemEngine::doRemoveRange(folly::StringPiece start, folly::StringPiece end) {
+    std::vector<std::string> keys;
+    {
+        MemSkipList::Accessor accessor(list_);
+        for (auto it = accessor.lower_bound(MemEntry(start.str()));
+             it != accessor.end() && folly::StringPiece(it->key) < end;
+             ++it) {
+            keys.emplace_back(it->key);
+        }
+    }
+    for (auto& key : keys) {
+        doRemove(key);
+    }
+}
+
+
+ResultCode MemEngine::put(std::string key, std::string value) {
+    doPut(key, value);
+    return ResultCode::SUCCEEDED;
+}
+
+
+ResultCode MemEngine::multiPut(std::vector<KV> keyValues) {
+    for (auto& kv : keyValues) {
+        doPut(kv.first, kv.second);
+    }
+    return ResultCode::SUCCEEDED;
+}
+
+
+ResultCode MemEngine::remove(const std::string& key) {
+    doRemove(key);
+    return ResultCode::SUCCEEDED;
+}
+
+
+ResultCode MemEngine::multiRemove(std::vector<std::string> keys) {
+    for (auto& key : keys) {
+        doRemove(key);
+    }
+    return ResultCode::SUCCEEDED;
+}
+
+
+ResultCode MemEngine::removeRange(const std::string& start,
+                                  const std::string& end) {
+    doRemoveRange(start, end);
+    return ResultCode::SUCCEEDED;
+}
+
+
+void MemEngine::addPart(PartitionID partId) {
+    std::string val;
+    auto key = NebulaKeyUtils::systemPartKey(partId);
+    if (get(key, &val) != ResultCode::SUCCEEDED) {
+        partsNum_++;
+    }
+    doPut(key, "");
+}
+
+
+void MemEngine::removePart(PartitionID partId) {
+    std::string val;
+    auto key = NebulaKeyUtils::systemPartKey(partId);
+    if (get(key, &val) == ResultCode::SUCCEEDED) {
+        doRemove(key);
+        partsNum_--;
+        CHECK_GE(partsNum_, 0);
+    }
+}
+
+
+std::vector<PartitionID> MemEngine::allParts() {
+    std::unique_ptr<KVIterator> iter;
+    static const std::string prefixStr = NebulaKeyUtils::systemPrefix();
+    CHECK_EQ(ResultCode::SUCCEEDED, this->prefix(prefixStr, &iter));
+
+    std::vector<PartitionID> parts;
+    while (iter->valid()) {
+        auto key = iter->key();
+        CHECK_EQ(key.size(), sizeof(PartitionID) + sizeof(NebulaSystemKeyType));
+        PartitionID partId = *reinterpret_cast<const PartitionID*>(key.data());
+        if (!NebulaKeyUtils::isSystemPart(key)) {
+            VLOG(3) << "Skip: " << std::bitset<32>(partId);
+            iter->next();
+            continue;
+        }
+
+        partId = partId >> 8;
+        parts.emplace_back(partId);
+        iter->next();
+    }
+    return parts;
+}
+
+
+int32_t MemEngine::totalPartsNum() {
+    return partsNum_;
+}
+
+
+ResultCode MemEngine::ingest(const std::vector<std::string>& files) {
+    rocksdb::Options options;
+    for (auto& file : files) {
+        rocksdb::SstFileReader reader(options);
+        auto status = reader.Open(file);
+        if (status.ok()) {
+            status = reader.VerifyChecksum();
+        }
+        if (!status.ok()) {
+            LOG(ERROR) << "Ingest " << file << " failed: " << status.ToString();
+            return ResultCode::ERR_IO_ERROR;
+        }
+        std::unique_ptr<rocksdb::Iterator> iter(reader.NewIterator(rocksdb::ReadOptions()));
+        for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+            doPut(folly::StringPiece(iter->key().data(), iter->key().size()),
+                  folly::StringPiece(iter->value().data(), iter->value().size()));
+        }
+        if (!iter->status().ok()) {
+            LOG(ERROR) << "Ingest " << file << " failed: " << iter->status().ToString();
+            return ResultCode::ERR_IO_ERROR;
+        }
+    }
+    return ResultCode::SUCCEEDED;
+}
+
+
+ResultCode MemEngine::setOption(const std::string& configKey,
+                                const std::string& configValue) {
+    LOG(WARNING) << "SetOption is not supported by the memory engine: "
+                 << configKey << ":" << configValue;
+    return ResultCode::ERR_UNSUPPORTED;
+}
+
+
+ResultCode MemEngine::setDBOption(const std::string& configKey,
+                                  const std::string& configValue) {
+    LOG(WARNING) << "SetDBOption is not supported by the memory engine: "
+                 << configKey << ":" << configValue;
+    return ResultCode::ERR_UNSUPPORTED;
+}
+
+
+ResultCode MemEngine::compact() {
+    // Nothing to compact, the removed entries are reclaimed by the skip list
+    return ResultCode::SUCCEEDED;
+}
+
+
+ResultCode MemEngine::flush() {
+    return writeSnapshot(snapshotPath());
+}
+
+
+ResultCode MemEngine::createCheckpoint(const std::string& name) {
+    LOG(INFO) << "Begin checkpoint : " << dataPath_;
+
+    // The same directory structure as the one of RocksEngine
+    auto checkpointPath = folly::stringPrintf("%s/checkpoints/%s/data",
+                                              dataPath_.c_str(), name.c_str());
+    LOG(INFO) << "Target checkpoint path : " << checkpointPath;
+    if (fs::FileUtils::exist(checkpointPath) &&
+        !fs::FileUtils::remove(checkpointPath.data(), true)) {
+            LOG(ERROR) << "Remove exist dir failed of checkpoint : " << checkpointPath;
+            return ResultCode::ERR_IO_ERROR;
+    }
+    if (!FileUtils::makeDir(checkpointPath)) {
+        LOG(ERROR) << "Make dir " << checkpointPath << " failed";
+        return ResultCode::ERR_CHECKPOINT_ERROR;
+    }
+
+    auto code = writeSnapshot(folly::stringPrintf("%s/memory.snapshot", checkpointPath.c_str()));
+    if (code != ResultCode::SUCCEEDED) {
+        return ResultCode::ERR_CHECKPOINT_ERROR;
+    }
+    return ResultCode::SUCCEEDED;
+}
+
+
+std::string MemEngine::snapshotPath() const {
+    return folly::stringPrintf("%s/data/memory.snapshot", dataPath_.c_str());
+}
+
+
+ResultCode MemEngine::writeSnapshot(const std::string& path) {
+    std::lock_guard<std::mutex> g(snapshotLock_);
+    auto tmpPath = folly::stringPrintf("%s.tmp", path.c_str());
+    auto fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        LOG(ERROR) << "Open " << tmpPath << " failed: " << strerror(errno);
+        return ResultCode::ERR_IO_ERROR;
+    }
+    SnapshotWriter writer(fd);
+
+    // The system keys, i.e. the last committed log ids, are taken first. Since the
+    // writes meanwhile are replayed from the wal after the committed log ids, the
+    // data is consistent after the replay, even if the rest is not a point-in-time view.
+    static const std::string systemPrefix = NebulaKeyUtils::systemPrefix();
+    size_t count = 0;
+    {
+        std::unique_ptr<KVIterator> iter;
+        prefix(systemPrefix, &iter);
+        for (; iter->valid(); iter->next()) {
+            if (!writer.append(iter->key(), iter->val())) {
+                return ResultCode::ERR_IO_ERROR;
+            }
+            count++;
+        }
+    }
+    {
+        MemSkipList::Accessor accessor(list_);
+        for (auto it = accessor.begin(); it != accessor.end(); ++it) {
+            if (folly::StringPiece(it->key).startsWith(systemPrefix)) {
+                continue;
+            }
+            auto val = it->loadVal();
+            if (val == nullptr) {
+                continue;
+            }
+            if (!writer.append(it->key, *val)) {
+                return ResultCode::ERR_IO_ERROR;
+            }
+            count++;
+        }
+    }
+    if (!writer.finish()) {
+        return ResultCode::ERR_IO_ERROR;
+    }
+    if (::rename(tmpPath.c_str(), path.c_str()) < 0) {
+        LOG(ERROR) << "Rename " << tmpPath << " failed: " << strerror(errno);
+        return ResultCode::ERR_IO_ERROR;
+    }
+    LOG(INFO) << "Write " << count << " entries into the snapshot " << path;
+    return ResultCode::SUCCEEDED;
+}
+
+
+ResultCode MemEngine::loadSnapshot(const std::string& path) {
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG(ERROR) << "Open " << path << " failed: " << strerror(errno);
+        return ResultCode::ERR_IO_ERROR;
+    }
+    SCOPE_EXIT {
+        ::close(fd);
+    };
+
+    std::string buffer;
+    size_t pos = 0;
+    // Make sure there are at least size bytes from pos, return false at the end of the file
+    auto fill = [&] (size_t size) -> StatusOr<bool> {
+        if (buffer.size() - pos >= size) {
+            return true;
+        }
+        buffer.erase(0, pos);
+        pos = 0;
+        auto want = std::max(size, kSnapshotBufferSize);
+        while (buffer.size() < size) {
+            auto old = buffer.size();
+            buffer.resize(old + want);
+            auto ret = ::read(fd, &buffer[old], want);
+            if (ret < 0) {
+                buffer.resize(old);
+                if (errno == EINTR) {
+                    continue;
+                }
+                return Status::Error("Read %s failed: %s", path.c_str(), strerror(errno));
+            }
+            buffer.resize(old + ret);
+            if (ret == 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    size_t count = 0;
+    static constexpr size_t kHeadSize = 2 * sizeof(uint32_t);
+    while (true) {
+        auto ret = fill(kHeadSize);
+        if (!ret.ok()) {
+            LOG(ERROR) << ret.status();
+            return ResultCode::ERR_IO_ERROR;
+        }
+        if (!ret.value()) {
+            if (buffer.size() == pos) {
+                break;
+            }
+            LOG(ERROR) << "The snapshot " << path << " is truncated";
+            return ResultCode::ERR_CORRUPT_DATA;
+        }
+        uint32_t klen;
+        uint32_t vlen;
+        memcpy(&klen, buffer.data() + pos, sizeof(klen));
+        memcpy(&vlen, buffer.data() + pos + sizeof(klen), sizeof(vlen));
+        ret = fill(kHeadSize + klen + vlen);
+        if (!ret.ok()) {
+            LOG(ERROR) << ret.status();
+            return ResultCode::ERR_IO_ERROR;
+        }
+        if (!ret.value()) {
+            LOG(ERROR) << "The snapshot " << path << " is truncated";
+            return ResultCode::ERR_CORRUPT_DATA;
+        }
+        auto data = buffer.data() + pos + kHeadSize;
+        doPut(folly::StringPiece(data, klen), folly::StringPiece(data + klen, vlen));
+        pos += kHeadSize + klen + vlen;
+        count++;
+    }
+    LOG(INFO) << "Load " << count << " entries from the snapshot " << path;
+    return ResultCode::SUCCEEDED;
+}
+
+}  // namespace kvstore
+}  // namespace nebula
@@ -0,0 +1,242 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef KVSTORE_MEMENGINE_H_
+#define KVSTORE_MEMENGINE_H_
+
+#include "base/Base.h"
+#include <folly/ConcurrentSkipList.h>
+#include "kvstore/KVIterator.h"
+#include "kvstore/KVEngine.h"
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * An entry of the skip list. The key never changes once inserted, while the value
+ * is replaced atomically, so the readers always see either the old or the new one.
+ * */
+struct MemEntry {
+    MemEntry() = default;
+    explicit MemEntry(std::string k, std::shared_ptr<const std::string> v = nullptr)
+        : key(std::move(k)), val(std::move(v)) {}
+
+    MemEntry(const MemEntry& other)
+        : key(other.key), val(other.loadVal()) {}
+
+    MemEntry& operator=(const MemEntry& other) {
+        key = other.key;
+        storeVal(other.loadVal());
+        return *this;
+    }
+
+    std::shared_ptr<const std::string> loadVal() const {
+        return std::atomic_load(&val);
+    }
+
+    void storeVal(std::shared_ptr<const std::string> v) const {
+        std::atomic_store(&val, std::move(v));
+    }
+
+    std::string                                         key;
+    mutable std::shared_ptr<const std::string>          val;
+};
+
+struct MemEntryLess {
+    bool operator()(const MemEntry& a, const MemEntry& b) const {
+        return a.key < b.key;
+    }
+};
+
+using MemSkipList = folly::ConcurrentSkipList<MemEntry, MemEntryLess>;
+
+
+/**
+ * Iterate the entries not less than the start, and while the predicate holds.
+ * The iterator holds an accessor of the skip list, so the entries removed
+ * meanwhile are not reclaimed before it goes away.
+ * */
+class MemIter : public KVIterator {
+public:
+    using Predicate = std::function<bool(folly::StringPiece key)>;
+
+    MemIter(std::shared_ptr<MemSkipList> list, const std::string& start, Predicate pred)
+        : accessor_(std::move(list))
+        , pred_(std::move(pred)) {
+        iter_ = accessor_.lower_bound(MemEntry(start));
+        settle();
+    }
+
+    bool valid() const override {
+        return val_ != nullptr;
+    }
+
+    void next() override {
+        ++iter_;
+        settle();
+    }
+
+    void prev() override {
+        LOG(FATAL) << "The memory engine could only iterate forward";
+    }
+
+    folly::StringPiece key() const override {
+        return iter_->key;
+    }
+
+    folly::StringPiece val() const override {
+        return *val_;
+    }
+
+    void seek(folly::StringPiece target) override {
+        iter_ = accessor_.lower_bound(MemEntry(target.str()));
+        settle();
+    }
+
+private:
+    // Skip the entries being removed, and stop once out of the range
+    void settle() {
+        val_.reset();
+        for (; iter_ != accessor_.end(); ++iter_) {
+            if (!pred_(iter_->key)) {
+                return;
+            }
+            val_ = iter_->loadVal();
+            if (val_ != nullptr) {
+                return;
+            }
+        }
+    }
+
+private:
+    MemSkipList::Accessor                       accessor_;
+    MemSkipList::iterator                       iter_;
+    Predicate                                   pred_;
+    // Hold the current value, in case it is replaced meanwhile
+    std::shared_ptr<const std::string>          val_;
+};
+
+
+/**************************************************************************
+ *
+ * An implementation of KVEngine keeping all data in memory, in a concurrent
+ * skip list. Reads never block on writes.
+ *
+ * The data is made durable by raft: the wal is replayed from the last committed
+ * log id kept in the engine, and flush() dumps the whole engine into a snapshot
+ * file under the data path, which is loaded on start. NebulaStore flushes the
+ * engines before cleaning the wal.
+ *
+ * Writes to the same key are expected to be serialized, which raft does for
+ * each part. A batch is applied in order, but not atomically to the readers.
+ *
+ *************************************************************************/
+class MemEngine : public KVEngine {
+public:
+    MemEngine(GraphSpaceID spaceId, const std::string& dataPath);
+
+    ~MemEngine() {
+        LOG(INFO) << "Release memory engine on " << dataPath_;
+    }
+
+    void stop() override;
+
+    const char* getDataRoot() const override {
+        return dataPath_.c_str();
+    }
+
+    std::unique_ptr<WriteBatch> startBatchWrite() override;
+
+    ResultCode commitBatchWrite(std::unique_ptr<WriteBatch> batch,
+                                bool disableWAL,
+                                bool sync) override;
+
+    /*********************
+     * Data retrieval
+     ********************/
+    ResultCode get(const std::string& key, std::string* value) override;
+
+    std::vector<Status> multiGet(const std::vector<std::string>& keys,
+                                 std::vector<std::string>* values) override;
+
+    ResultCode range(const std::string& start,
+                     const std::string& end,
+                     std::unique_ptr<KVIterator>* iter) override;
+
+    ResultCode prefix(const std::string& prefix,
+                      std::unique_ptr<KVIterator>* iter) override;
+
+    ResultCode rangeWithPrefix(const std::string& start,
+                               const std::string& prefix,
+                               std::unique_ptr<KVIterator>* iter) override;
+
+    /*********************
+     * Data modification
+     ********************/
+    ResultCode put(std::string key, std::string value) override;
+
+    ResultCode multiPut(std::vector<KV> keyValues) override;
+
+    ResultCode remove(const std::string& key) override;
+
+    ResultCode multiRemove(std::vector<std::string> keys) override;
+
+    ResultCode removeRange(const std::string& start,
+                           const std::string& end) override;
+
+    /*********************
+     * Non-data operation
+     ********************/
+    void addPart(PartitionID partId) override;
+
+    void removePart(PartitionID partId) override;
+
+    std::vector<PartitionID> allParts() override;
+
+    int32_t totalPartsNum() override;
+
+    ResultCode ingest(const std::vector<std::string>& files) override;
+
+    ResultCode setOption(const std::string& configKey,
+                         const std::string& configValue) override;
+
+    ResultCode setDBOption(const std::string& configKey,
+                           const std::string& configValue) override;
+
+    ResultCode compact() override;
+
+    ResultCode flush() override;
+
+    /*********************
+     * Checkpoint operation
+     ********************/
+    ResultCode createCheckpoint(const std::string& name) override;
+
+private:
+    void doPut(folly::StringPiece key, folly::StringPiece value);
+
+    void doRemove(folly::StringPiece key);
+
+    void doRemoveRange(folly::StringPiece start, folly::StringPiece end);
+
+    // Dump all the entries into the file
+    ResultCode writeSnapshot(const std::string& path);
+
+    ResultCode loadSnapshot(const std::string& path);
+
+    std::string snapshotPath() const;
+
+private:
+    std::string                         dataPath_;
+    std::shared_ptr<MemSkipList>        list_;
+    std::atomic<int32_t>                partsNum_{0};
+    // Only one snapshot is written at a time
+    std::mutex                          snapshotLock_;
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+#endif  // KVSTORE_MEMENGINE_H_
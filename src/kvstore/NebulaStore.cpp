@@ -12,10 +12,11 @@
 #include "network/NetworkUtils.h"
 #include "fs/FileUtils.h"
 #include "kvstore/RocksEngine.h"
+#include "kvstore/MemEngine.h"
 #include "kvstore/SnapshotManagerImpl.h"
 #include <folly/ScopeGuard.h>
 
-DEFINE_string(engine_type, "rocksdb", "rocksdb, memory...");
+DEFINE_string(engine_type, "rocksdb", "rocksdb, memory");
 DEFINE_int32(custom_filter_interval_secs, 24 * 3600,
              "interval to trigger custom compaction, < 0 means always do default minor compaction");
 DEFINE_int32(num_workers, 4, "Number of worker threads");
@@ -221,6 +222,8 @@ std::unique_ptr<KVEngine> NebulaStore::newEngine(GraphSpaceID spaceId,
                                              path,
                                              options_.mergeOp_,
                                              cfFactory);
+    } else if (FLAGS_engine_type == "memory") {
+        return std::make_unique<MemEngine>(spaceId, path);
     } else {
         LOG(FATAL) << "Unknown engine type " << FLAGS_engine_type;
         return nullptr;
@@ -885,7 +888,8 @@ void NebulaStore::cleanWAL() {
                                  this);
     };
     for (const auto& spaceEntry : spaces_) {
-        if (FLAGS_rocksdb_disable_wal) {
+        // The wal is the only copy of the data not flushed yet
+        if (FLAGS_rocksdb_disable_wal || FLAGS_engine_type == "memory") {
             for (const auto& engine : spaceEntry.second->engines_) {
                 engine->flush();
             }
@@ -6,10 +6,16 @@
 
 #include "kvstore/Part.h"
 #include "kvstore/LogEncoder.h"
+#include "kvstore/DirtyVertexTracker.h"
 #include "utils/NebulaKeyUtils.h"
 #include "kvstore/RocksEngineConfig.h"
 
 DEFINE_int32(cluster_id, 0, "A unique id for each cluster");
+DEFINE_string(raft_log_compression, "none",
+              "Codec to compress the raft log batches, options: none, lz4, zstd. "
+              "It only takes effect when all peers are able to decode it");
+DEFINE_int32(raft_log_compression_min_size, 4096,
+             "The raft log batch smaller than it will not be compressed");
 
 namespace nebula {
 namespace kvstore {
@@ -70,7 +76,7 @@ void Part::asyncPut(folly::StringPiece key, folly::StringPiece value, KVCallback
 
 
 void Part::asyncMultiPut(const std::vector<KV>& keyValues, KVCallback cb) {
-    std::string log = encodeMultiValues(OP_MULTI_PUT, keyValues);
+    std::string log = compressLogIfNeeded(encodeMultiValues(OP_MULTI_PUT, keyValues));
 
     appendAsync(FLAGS_cluster_id, std::move(log))
         .thenValue([this, callback = std::move(cb)] (AppendLogResult res) mutable {
@@ -90,7 +96,7 @@ void Part::asyncRemove(folly::StringPiece key, KVCallback cb) {
 
 
 void Part::asyncMultiRemove(const std::vector<std::string>& keys, KVCallback cb) {
-    std::string log = encodeMultiValues(OP_MULTI_REMOVE, keys);
+    std::string log = compressLogIfNeeded(encodeMultiValues(OP_MULTI_REMOVE, keys));
 
     appendAsync(FLAGS_cluster_id, std::move(log))
         .thenValue([this, callback = std::move(cb)] (AppendLogResult res) mutable {
@@ -118,7 +124,14 @@ void Part::sync(KVCallback cb) {
 }
 
 void Part::asyncAtomicOp(raftex::AtomicOp op, KVCallback cb) {
-    atomicOpAsync(std::move(op)).thenValue(
+    auto compressedOp = [this, op = std::move(op)] () mutable -> folly::Optional<std::string> {
+        auto ret = op();
+        if (!ret.hasValue()) {
+            return ret;
+        }
+        return compressLogIfNeeded(std::move(ret).value());
+    };
+    atomicOpAsync(std::move(compressedOp)).thenValue(
             [this, callback = std::move(cb)] (AppendLogResult res) mutable {
         callback(this->toResultCode(res));
     });
@@ -165,6 +178,25 @@ void Part::asyncRemovePeer(const HostAddr& peer, KVCallback cb) {
 }
 
 
+std::string Part::compressLogIfNeeded(std::string log) {
+    if (FLAGS_raft_log_compression_min_size < 0
+            || log.size() < static_cast<size_t>(FLAGS_raft_log_compression_min_size)) {
+        return log;
+    }
+    auto codec = toLogCodec(FLAGS_raft_log_compression);
+    if (codec == CODEC_NONE || !(negotiatedLogCodecs() & codec)) {
+        return log;
+    }
+    auto compressed = compressLog(codec, log);
+    if (!compressed.hasValue()) {
+        return log;
+    }
+    VLOG(3) << idStr_ << "Compress the log from " << log.size()
+            << " to " << compressed.value().size() << " bytes";
+    return std::move(compressed).value();
+}
+
+
 void Part::setBlocking(bool sign) {
     blocking_ = sign;
 }
@@ -189,6 +221,33 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
     auto batch = engine_->startBatchWrite();
     LogID lastId = -1;
     TermID lastTerm = -1;
+    // The vertices written are collected only when an index is being built online
+    auto& tracker = DirtyVertexTracker::instance();
+    bool tracked = tracker.isTracked(spaceId_, partId_);
+    std::vector<VertexID> dirtyVertices;
+    auto touch = [&] (folly::StringPiece key) {
+        if (tracked
+                && key.size() >= sizeof(PartitionID) + sizeof(VertexID)
+                && NebulaKeyUtils::isDataKey(key)) {
+            dirtyVertices.emplace_back(NebulaKeyUtils::readInt<VertexID>(
+                key.data() + sizeof(PartitionID), sizeof(VertexID)));
+        }
+    };
+    // A removed range could cover many vertices, all the keys committed in it are touched
+    auto touchRange = [&] (folly::StringPiece start, folly::StringPiece end) -> bool {
+        if (!tracked) {
+            return true;
+        }
+        std::unique_ptr<KVIterator> rangeIter;
+        if (engine_->range(start.str(), end.str(), &rangeIter) != ResultCode::SUCCEEDED) {
+            LOG(ERROR) << idStr_ << "Failed to scan the range to remove";
+            return false;
+        }
+        for (; rangeIter->valid(); rangeIter->next()) {
+            touch(rangeIter->key());
+        }
+        return true;
+    };
     while (iter->valid()) {
         lastId = iter->logId();
         lastTerm = iter->logTerm();
@@ -199,11 +258,22 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
             continue;
         }
         DCHECK_GE(log.size(), sizeof(int64_t) + 1 + sizeof(uint32_t));
+        std::string decompressed;
+        if (log[sizeof(int64_t)] == OP_COMPRESSED) {
+            auto raw = decompressLog(log);
+            if (!raw.hasValue()) {
+                LOG(ERROR) << idStr_ << "Failed to decompress the log " << iter->logId();
+                return false;
+            }
+            decompressed = std::move(raw).value();
+            log = decompressed;
+        }
         // Skip the timestamp (type of int64_t)
         switch (log[sizeof(int64_t)]) {
         case OP_PUT: {
             auto pieces = decodeMultiValues(log);
             DCHECK_EQ(2, pieces.size());
+            touch(pieces[0]);
             if (batch->put(pieces[0], pieces[1]) != ResultCode::SUCCEEDED) {
                 LOG(ERROR) << idStr_ << "Failed to call WriteBatch::put()";
                 return false;
@@ -215,6 +285,7 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
             // Make the number of values are an even number
             DCHECK_EQ((kvs.size() + 1) / 2, kvs.size() / 2);
             for (size_t i = 0; i < kvs.size(); i += 2) {
+                touch(kvs[i]);
                 if (batch->put(kvs[i], kvs[i + 1]) != ResultCode::SUCCEEDED) {
                     LOG(ERROR) << idStr_ << "Failed to call WriteBatch::put()";
                     return false;
@@ -224,6 +295,7 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
         }
         case OP_REMOVE: {
             auto key = decodeSingleValue(log);
+            touch(key);
             if (batch->remove(key) != ResultCode::SUCCEEDED) {
                 LOG(ERROR) << idStr_ << "Failed to call WriteBatch::remove()";
                 return false;
@@ -233,6 +305,7 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
         case OP_MULTI_REMOVE: {
             auto keys = decodeMultiValues(log);
             for (auto k : keys) {
+                touch(k);
                 if (batch->remove(k) != ResultCode::SUCCEEDED) {
                     LOG(ERROR) << idStr_ << "Failed to call WriteBatch::remove()";
                     return false;
@@ -243,6 +316,9 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
         case OP_REMOVE_RANGE: {
             auto range = decodeMultiValues(log);
             DCHECK_EQ(2, range.size());
+            if (!touchRange(range[0], range[1])) {
+                return false;
+            }
             if (batch->removeRange(range[0], range[1]) != ResultCode::SUCCEEDED) {
                 LOG(ERROR) << idStr_ << "Failed to call WriteBatch::removeRange()";
                 return false;
@@ -254,10 +330,15 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
             for (auto& op : data) {
                 ResultCode code = ResultCode::SUCCEEDED;
                 if (op.first == BatchLogType::OP_BATCH_PUT) {
+                    touch(op.second.first);
                     code = batch->put(op.second.first, op.second.second);
                 } else if (op.first == BatchLogType::OP_BATCH_REMOVE) {
+                    touch(op.second.first);
                     code = batch->remove(op.second.first);
                 } else if (op.first == BatchLogType::OP_BATCH_REMOVE_RANGE) {
+                    if (!touchRange(op.second.first, op.second.second)) {
+                        return false;
+                    }
                     code = batch->removeRange(op.second.first, op.second.second);
                 }
                 if (code != ResultCode::SUCCEEDED) {
@@ -309,9 +390,14 @@ bool Part::commitLogs(std::unique_ptr<LogIterator> iter) {
             return false;
         }
     }
-    return engine_->commitBatchWrite(std::move(batch),
-                                     FLAGS_rocksdb_disable_wal,
-                                     FLAGS_rocksdb_wal_sync) == ResultCode::SUCCEEDED;
+    if (engine_->commitBatchWrite(std::move(batch),
+                                  FLAGS_rocksdb_disable_wal,
+                                  FLAGS_rocksdb_wal_sync) != ResultCode::SUCCEEDED) {
+        return false;
+    }
+    // Touch them after the commit, so a vertex not touched is visible to the scan
+    tracker.touch(spaceId_, partId_, dirtyVertices);
+    return true;
 }
 
 std::pair<int64_t, int64_t> Part::commitSnapshot(const std::vector<std::string>& rows,
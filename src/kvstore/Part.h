@@ -12,6 +12,7 @@
 #include "raftex/RaftPart.h"
 #include "kvstore/Common.h"
 #include "kvstore/KVEngine.h"
+#include "kvstore/LogEncoder.h"
 #include "kvstore/raftex/SnapshotManager.h"
 #include "kvstore/wal/FileBasedWal.h"
 
@@ -109,6 +110,14 @@ private:
 
     ResultCode putCommitMsg(WriteBatch* batch, LogID committedLogId, TermID committedLogTerm);
 
+    int32_t supportedLogCodecs() const override {
+        return kSupportedLogCodecs;
+    }
+
+    // Compress the encoded log with FLAGS_raft_log_compression if all peers
+    // are able to decode it, otherwise return the log as it is
+    std::string compressLogIfNeeded(std::string log);
+
     void cleanup() override {
         LOG(INFO) << idStr_ << "Clean up all data, just reset the committedLogId!";
         auto batch = engine_->startBatchWrite();
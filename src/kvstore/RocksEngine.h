@@ -46,6 +46,10 @@ public:
         return folly::StringPiece(iter_->value().data(), iter_->value().size());
     }
 
+    void seek(folly::StringPiece target) override {
+        iter_->Seek(rocksdb::Slice(target.begin(), target.size()));
+    }
+
 private:
     std::unique_ptr<rocksdb::Iterator> iter_;
     rocksdb::Slice start_;
@@ -80,6 +84,10 @@ public:
         return folly::StringPiece(iter_->value().data(), iter_->value().size());
     }
 
+    void seek(folly::StringPiece target) override {
+        iter_->Seek(rocksdb::Slice(target.begin(), target.size()));
+    }
+
 protected:
     std::unique_ptr<rocksdb::Iterator> iter_;
     rocksdb::Slice prefix_;
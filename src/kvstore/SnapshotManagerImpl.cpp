@@ -16,38 +16,44 @@ void SnapshotManagerImpl::accessAllRowsInSnapshot(GraphSpaceID spaceId,
                                                   PartitionID partId,
                                                   raftex::SnapshotCallback cb) {
     CHECK_NOTNULL(store_);
-    std::unique_ptr<KVIterator> iter;
-    auto prefix = NebulaKeyUtils::snapshotPrefix(partId);
+    std::vector<std::string> prefixes{NebulaKeyUtils::snapshotPrefix(partId)};
+    if (partId != 0) {
+        // The degree counters are maintained along with the edges in the same part
+        prefixes.emplace_back(NebulaKeyUtils::degreePrefix(partId));
+    }
     std::vector<std::string> data;
     int64_t totalSize = 0;
     int64_t totalCount = 0;
-    auto ret = store_->prefix(spaceId, partId, prefix, &iter);
-    if (ret != ResultCode::SUCCEEDED) {
-        LOG(INFO) << "[spaceId:" << spaceId << ", partId:" << partId << "] access prefix failed"
-                  << ", error code:" << static_cast<int32_t>(ret);
-        cb(data, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
-        return;
-    }
     data.reserve(kReserveNum);
     int32_t batchSize = 0;
-    while (iter && iter->valid()) {
-        if (batchSize >= FLAGS_snapshot_batch_size) {
-            if (cb(data, totalCount, totalSize, raftex::SnapshotStatus::IN_PROGRESS)) {
-                data.clear();
-                batchSize = 0;
-            } else {
-                LOG(INFO) << "[spaceId:" << spaceId << ", partId:" << partId
-                          << "] callback invoked failed";
-                return;
+    for (auto& prefix : prefixes) {
+        std::unique_ptr<KVIterator> iter;
+        auto ret = store_->prefix(spaceId, partId, prefix, &iter);
+        if (ret != ResultCode::SUCCEEDED) {
+            LOG(INFO) << "[spaceId:" << spaceId << ", partId:" << partId << "] access prefix failed"
+                      << ", error code:" << static_cast<int32_t>(ret);
+            cb(data, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
+            return;
+        }
+        while (iter && iter->valid()) {
+            if (batchSize >= FLAGS_snapshot_batch_size) {
+                if (cb(data, totalCount, totalSize, raftex::SnapshotStatus::IN_PROGRESS)) {
+                    data.clear();
+                    batchSize = 0;
+                } else {
+                    LOG(INFO) << "[spaceId:" << spaceId << ", partId:" << partId
+                              << "] callback invoked failed";
+                    return;
+                }
             }
+            auto key = iter->key();
+            auto val = iter->val();
+            data.emplace_back(encodeKV(key, val));
+            batchSize += data.back().size();
+            totalSize += data.back().size();
+            totalCount++;
+            iter->next();
         }
-        auto key = iter->key();
-        auto val = iter->val();
-        data.emplace_back(encodeKV(key, val));
-        batchSize += data.back().size();
-        totalSize += data.back().size();
-        totalCount++;
-        iter->next();
     }
     cb(data, totalCount, totalSize, raftex::SnapshotStatus::DONE);
 }
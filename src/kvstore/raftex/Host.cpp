@@ -202,6 +202,9 @@ void Host::appendLogsInternal(folly::EventBase* eb,
         }
 
         cpp2::AppendLogResponse resp = std::move(t).value();
+        self->logCodecs_ = resp.get_supported_log_codecs() != nullptr
+                         ? *resp.get_supported_log_codecs()
+                         : 0;
         if (FLAGS_trace_raft) {
             LOG(INFO)
                 << self->idStr_ << "AppendLogResponse "
@@ -92,6 +92,11 @@ public:
         return addr_;
     }
 
+    // The log codecs reported by the peer in its last response
+    int32_t logCodecs() const {
+        return logCodecs_.load(std::memory_order_relaxed);
+    }
+
 private:
     cpp2::ErrorCode checkStatus() const;
 
@@ -148,6 +153,8 @@ private:
 
     // CommittedLogId of follower
     LogID followerCommittedLogId_{0};
+
+    std::atomic<int32_t> logCodecs_{0};
 };
 
 }  // namespace raftex
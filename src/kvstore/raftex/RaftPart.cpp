@@ -316,7 +316,7 @@ void RaftPart::start(std::vector<HostAddr>&& peers, bool asLearner) {
     startTimeMs_ = time::WallClock::fastNowInMilliSec();
     // Set up a leader election task
     size_t delayMS = 100 + folly::Random::rand32(900);
-    bgWorkers_->addDelayTask(delayMS, [self = shared_from_this(), startTime = startTimeMs_] {
+    bgWorkers_->addWheelTask(delayMS, [self = shared_from_this(), startTime = startTimeMs_] {
         self->statusPolling(startTime);
     });
 }
@@ -762,6 +762,12 @@ void RaftPart::replicateLogs(folly::EventBase* eb,
 
         hosts = hosts_;
 
+        int32_t codecs = supportedLogCodecs();
+        for (auto& host : hosts) {
+            codecs &= host->logCodecs();
+        }
+        negotiatedLogCodecs_ = codecs;
+
         if (term_ != currTerm) {
             VLOG(2) << idStr_ << "Term has been updated, previous "
                     << currTerm << ", current " << term_;
@@ -1250,7 +1256,7 @@ void RaftPart::statusPolling(int64_t startTime) {
         std::lock_guard<std::mutex> g(raftLock_);
         if (status_ == Status::RUNNING || status_ == Status::WAITING_SNAPSHOT) {
             VLOG(3) << idStr_ << "Schedule new task";
-            bgWorkers_->addDelayTask(
+            bgWorkers_->addWheelTask(
                 delay,
                 [self = shared_from_this(), startTime] {
                     self->statusPolling(startTime);
@@ -1439,6 +1445,7 @@ void RaftPart::processAppendLogRequest(
     resp.set_committed_log_id(committedLogId_);
     resp.set_last_log_id(lastLogId_ < committedLogId_ ? committedLogId_ : lastLogId_);
     resp.set_last_log_term(lastLogTerm_);
+    resp.set_supported_log_codecs(supportedLogCodecs());
 
     // Check status
     if (UNLIKELY(status_ == Status::STOPPED)) {
@@ -213,6 +213,14 @@ public:
 
     bool needToCleanWal();
 
+    /**
+     * Return the log codecs which could be decoded by me and all peers, refreshed
+     * every time the logs (or heartbeat) are replicated.
+     * */
+    int32_t negotiatedLogCodecs() const {
+        return negotiatedLogCodecs_.load(std::memory_order_relaxed);
+    }
+
 protected:
     // Protected constructor to prevent from instantiating directly
     RaftPart(ClusterID clusterId,
@@ -264,6 +272,12 @@ protected:
     // Clean up all data about current part in storage.
     virtual void cleanup() = 0;
 
+    // The bit mask of the log codecs which the inherited classes are able
+    // to decode in commitLogs(), it will be reported to the leader
+    virtual int32_t supportedLogCodecs() const {
+        return 0;
+    }
+
     // Reset the part, clean up all data and WALs.
     void reset();
 
@@ -555,6 +569,8 @@ protected:
     std::atomic<uint64_t> weight_;
 
     bool blocking_{false};
+
+    std::atomic<int32_t> negotiatedLogCodecs_{0};
 };
 
 }  // namespace raftex
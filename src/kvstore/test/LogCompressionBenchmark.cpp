@@ -0,0 +1,99 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <folly/Benchmark.h>
+#include "kvstore/LogEncoder.h"
+#include "utils/NebulaKeyUtils.h"
+#include "dataman/SchemaWriter.h"
+#include "dataman/RowWriter.h"
+
+DEFINE_int32(batch_edges, 512, "Number of edges in one raft log batch");
+
+namespace nebula {
+namespace kvstore {
+
+// Simulate the log batch built by AddEdgesProcessor for a bulk insert job,
+// e.g. INSERT EDGE transfer(amount, currency, channel, created, memo) VALUES ...
+std::string genEdgesLog(int32_t batch) {
+    auto schema = std::make_shared<SchemaWriter>();
+    schema->appendCol("amount", cpp2::SupportedType::DOUBLE)
+           .appendCol("currency", cpp2::SupportedType::STRING)
+           .appendCol("channel", cpp2::SupportedType::STRING)
+           .appendCol("created", cpp2::SupportedType::TIMESTAMP)
+           .appendCol("memo", cpp2::SupportedType::STRING);
+    std::vector<KV> data;
+    data.reserve(batch);
+    for (int32_t i = 0; i < batch; i++) {
+        VertexID src = 100000 + i / 16;
+        VertexID dst = folly::Random::rand64(10000000);
+        auto key = NebulaKeyUtils::edgeKey(1, src, 101, 0, dst, 1551331827);
+        RowWriter writer(schema);
+        writer << folly::Random::randDouble01() * 10000
+               << (i % 2 ? "CNY" : "USD")
+               << (i % 3 ? "mobile" : "web")
+               << 1551331827 + i
+               << folly::stringPrintf("transfer from %ld to %ld", src, dst);
+        data.emplace_back(std::move(key), writer.encode());
+    }
+    return encodeMultiValues(OP_MULTI_PUT, data);
+}
+
+std::string rawLog;
+std::string lz4Log;
+std::string zstdLog;
+
+void prepareLogs() {
+    rawLog = genEdgesLog(FLAGS_batch_edges);
+    lz4Log = compressLog(CODEC_LZ4, rawLog).value();
+    zstdLog = compressLog(CODEC_ZSTD, rawLog).value();
+}
+
+BENCHMARK(compress_lz4, iters) {
+    for (size_t i = 0; i < iters; i++) {
+        auto compressed = compressLog(CODEC_LZ4, rawLog);
+        folly::doNotOptimizeAway(compressed);
+    }
+}
+
+BENCHMARK_RELATIVE(compress_zstd, iters) {
+    for (size_t i = 0; i < iters; i++) {
+        auto compressed = compressLog(CODEC_ZSTD, rawLog);
+        folly::doNotOptimizeAway(compressed);
+    }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(decompress_lz4, iters) {
+    for (size_t i = 0; i < iters; i++) {
+        auto raw = decompressLog(lz4Log);
+        folly::doNotOptimizeAway(raw);
+    }
+}
+
+BENCHMARK_RELATIVE(decompress_zstd, iters) {
+    for (size_t i = 0; i < iters; i++) {
+        auto raw = decompressLog(zstdLog);
+        folly::doNotOptimizeAway(raw);
+    }
+}
+
+}  // namespace kvstore
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    folly::init(&argc, &argv, true);
+    nebula::kvstore::prepareLogs();
+    folly::runBenchmarks();
+    // The bytes written into the WAL and sent in AppendLogRequest for one batch
+    LOG(INFO) << "Batch of " << FLAGS_batch_edges << " edges: raw "
+              << nebula::kvstore::rawLog.size() << " bytes, lz4 "
+              << nebula::kvstore::lz4Log.size() << " bytes, zstd "
+              << nebula::kvstore::zstdLog.size() << " bytes";
+    return 0;
+}
@@ -150,6 +150,43 @@ TEST(LogEncoderTest, BatchTest) {
     ASSERT_EQ(expectd, decoded);
 }
 
+TEST(LogEncoderTest, CompressTest) {
+    std::vector<KV> kvs;
+    for (int i = 0; i < 100; i++) {
+        kvs.emplace_back(folly::stringPrintf("Key%03d", i),
+                         folly::stringPrintf("Repeated_value_%03d_Repeated_value", i % 3));
+    }
+    auto encoded = encodeMultiValues(OP_MULTI_PUT, kvs);
+    for (auto codec : {CODEC_LZ4, CODEC_ZSTD}) {
+        auto compressed = compressLog(codec, encoded);
+        ASSERT_TRUE(compressed.hasValue());
+        ASSERT_LT(compressed.value().size(), encoded.size());
+        ASSERT_EQ(OP_COMPRESSED, compressed.value()[sizeof(int64_t)]);
+        ASSERT_EQ(getTimestamp(encoded), getTimestamp(compressed.value()));
+
+        auto raw = decompressLog(compressed.value());
+        ASSERT_TRUE(raw.hasValue());
+        ASSERT_EQ(encoded, raw.value());
+        auto decoded = decodeMultiValues(raw.value());
+        ASSERT_EQ(200, decoded.size());
+        ASSERT_EQ("Key099", decoded[198].toString());
+
+        // Corrupted payload
+        auto corrupted = compressed.value();
+        corrupted.resize(corrupted.size() - 1);
+        ASSERT_FALSE(decompressLog(corrupted).hasValue());
+    }
+    // Unknown codec, or the log could not be shrunk
+    ASSERT_FALSE(compressLog(CODEC_NONE, encoded).hasValue());
+    ASSERT_FALSE(compressLog(CODEC_LZ4, encodeSingleValue(OP_REMOVE, "key")).hasValue());
+    // Not a compressed log
+    ASSERT_FALSE(decompressLog(encoded).hasValue());
+
+    ASSERT_EQ(CODEC_LZ4, toLogCodec("lz4"));
+    ASSERT_EQ(CODEC_ZSTD, toLogCodec("zstd"));
+    ASSERT_EQ(CODEC_NONE, toLogCodec("none"));
+}
+
 }  // namespace kvstore
 }  // namespace nebula
 
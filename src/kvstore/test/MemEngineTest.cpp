@@ -0,0 +1,301 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include <rocksdb/db.h>
+#include <rocksdb/sst_file_writer.h>
+#include "fs/TempDir.h"
+#include "fs/FileUtils.h"
+#include "kvstore/MemEngine.h"
+
+namespace nebula {
+namespace kvstore {
+
+TEST(MemEngineTest, SimpleTest) {
+    fs::TempDir rootPath("/tmp/memory_engine_SimpleTest.XXXXXX");
+    auto engine = std::make_unique<MemEngine>(0, rootPath.path());
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->put("key", "val"));
+    std::string val;
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->get("key", &val));
+    EXPECT_EQ("val", val);
+    // Overwrite
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->put("key", "val2"));
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->get("key", &val));
+    EXPECT_EQ("val2", val);
+
+    std::vector<std::string> values;
+    auto status = engine->multiGet({"key", "key_not_exist"}, &values);
+    ASSERT_EQ(2, status.size());
+    EXPECT_TRUE(status[0].ok());
+    EXPECT_EQ("val2", values[0]);
+    EXPECT_FALSE(status[1].ok());
+}
+
+
+TEST(MemEngineTest, RangeTest) {
+    fs::TempDir rootPath("/tmp/memory_engine_RangeTest.XXXXXX");
+    auto engine = std::make_unique<MemEngine>(0, rootPath.path());
+    std::vector<KV> data;
+    for (int32_t i = 10; i < 20;  i++) {
+        data.emplace_back(std::string(reinterpret_cast<const char*>(&i), sizeof(int32_t)),
+                          folly::stringPrintf("val_%d", i));
+    }
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->multiPut(std::move(data)));
+
+    auto checkRange = [&](int32_t start,
+                          int32_t end,
+                          int32_t expectedFrom,
+                          int32_t expectedTotal) {
+        std::string s(reinterpret_cast<const char*>(&start), sizeof(int32_t));
+        std::string e(reinterpret_cast<const char*>(&end), sizeof(int32_t));
+        std::unique_ptr<KVIterator> iter;
+        EXPECT_EQ(ResultCode::SUCCEEDED, engine->range(s, e, &iter));
+        int num = 0;
+        while (iter->valid()) {
+            num++;
+            auto key = *reinterpret_cast<const int32_t*>(iter->key().data());
+            auto val = iter->val();
+            EXPECT_EQ(expectedFrom, key);
+            EXPECT_EQ(folly::stringPrintf("val_%d", expectedFrom), val);
+            expectedFrom++;
+            iter->next();
+        }
+        EXPECT_EQ(expectedTotal, num);
+    };
+
+    checkRange(10, 20, 10, 10);
+    checkRange(1, 50, 10, 10);
+    checkRange(15, 18, 15, 3);
+    checkRange(15, 23, 15, 5);
+    checkRange(1, 15, 10, 5);
+}
+
+
+TEST(MemEngineTest, PrefixTest) {
+    fs::TempDir rootPath("/tmp/memory_engine_PrefixTest.XXXXXX");
+    auto engine = std::make_unique<MemEngine>(0, rootPath.path());
+    std::vector<KV> data;
+    for (int32_t i = 0; i < 10;  i++) {
+        data.emplace_back(folly::stringPrintf("a_%d", i),
+                          folly::stringPrintf("val_%d", i));
+    }
+    for (int32_t i = 10; i < 15;  i++) {
+        data.emplace_back(folly::stringPrintf("b_%d", i),
+                          folly::stringPrintf("val_%d", i));
+    }
+    for (int32_t i = 20; i < 40;  i++) {
+        data.emplace_back(folly::stringPrintf("c_%d", i),
+                          folly::stringPrintf("val_%d", i));
+    }
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->multiPut(std::move(data)));
+
+    auto checkPrefix = [&](const std::string& prefix,
+                           int32_t expectedFrom,
+                           int32_t expectedTotal) {
+        std::unique_ptr<KVIterator> iter;
+        EXPECT_EQ(ResultCode::SUCCEEDED, engine->prefix(prefix, &iter));
+        int num = 0;
+        while (iter->valid()) {
+            num++;
+            auto key = iter->key();
+            auto val = iter->val();
+            EXPECT_EQ(folly::stringPrintf("%s_%d", prefix.c_str(), expectedFrom), key);
+            EXPECT_EQ(folly::stringPrintf("val_%d", expectedFrom), val);
+            expectedFrom++;
+            iter->next();
+        }
+        EXPECT_EQ(expectedTotal, num);
+    };
+    checkPrefix("a", 0, 10);
+    checkPrefix("b", 10, 5);
+    checkPrefix("c", 20, 20);
+
+    {
+        std::unique_ptr<KVIterator> iter;
+        EXPECT_EQ(ResultCode::SUCCEEDED, engine->rangeWithPrefix("c_30", "c", &iter));
+        int num = 0;
+        while (iter->valid()) {
+            num++;
+            iter->next();
+        }
+        EXPECT_EQ(10, num);
+    }
+}
+
+
+TEST(MemEngineTest, RemoveTest) {
+    fs::TempDir rootPath("/tmp/memory_engine_RemoveTest.XXXXXX");
+    auto engine = std::make_unique<MemEngine>(0, rootPath.path());
+    for (int32_t i = 0; i < 100; i++) {
+        std::string key(reinterpret_cast<const char*>(&i), sizeof(int32_t));
+        EXPECT_EQ(ResultCode::SUCCEEDED,
+                  engine->put(key, folly::stringPrintf("%d_val", i)));
+    }
+    {
+        int32_t i = 99;
+        std::string key(reinterpret_cast<const char*>(&i), sizeof(int32_t));
+        EXPECT_EQ(ResultCode::SUCCEEDED, engine->remove(key));
+        std::string val;
+        EXPECT_EQ(ResultCode::ERR_KEY_NOT_FOUND, engine->get(key, &val));
+    }
+    {
+        int32_t s = 0, e = 50;
+        EXPECT_EQ(
+            ResultCode::SUCCEEDED,
+            engine->removeRange(
+                std::string(reinterpret_cast<const char*>(&s), sizeof(int32_t)),
+                std::string(reinterpret_cast<const char*>(&e), sizeof(int32_t))));
+    }
+    {
+        int32_t s = 0, e = 100;
+        std::unique_ptr<KVIterator> iter;
+        std::string start(reinterpret_cast<const char*>(&s), sizeof(int32_t));
+        std::string end(reinterpret_cast<const char*>(&e), sizeof(int32_t));
+        EXPECT_EQ(ResultCode::SUCCEEDED, engine->range(start, end, &iter));
+        int num = 0;
+        int expectedFrom = 50;
+        while (iter->valid()) {
+            num++;
+            auto key = *reinterpret_cast<const int32_t*>(iter->key().data());
+            EXPECT_EQ(expectedFrom, key);
+            EXPECT_EQ(folly::stringPrintf("%d_val", expectedFrom), iter->val());
+            expectedFrom++;
+            iter->next();
+        }
+        EXPECT_EQ(49, num);
+    }
+}
+
+
+TEST(MemEngineTest, BatchTest) {
+    fs::TempDir rootPath("/tmp/memory_engine_BatchTest.XXXXXX");
+    auto engine = std::make_unique<MemEngine>(0, rootPath.path());
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->put("key_0", "val"));
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->put("key_5", "val"));
+
+    auto batch = engine->startBatchWrite();
+    EXPECT_EQ(ResultCode::SUCCEEDED, batch->removeRange("key_0", "key_9"));
+    for (int32_t i = 1; i < 4; i++) {
+        EXPECT_EQ(ResultCode::SUCCEEDED,
+                  batch->put(folly::stringPrintf("key_%d", i), folly::stringPrintf("val_%d", i)));
+    }
+    EXPECT_EQ(ResultCode::SUCCEEDED, batch->remove("key_2"));
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->commitBatchWrite(std::move(batch), true, false));
+
+    std::unique_ptr<KVIterator> iter;
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->prefix("key_", &iter));
+    std::vector<std::string> keys;
+    while (iter->valid()) {
+        keys.emplace_back(iter->key().str());
+        iter->next();
+    }
+    std::vector<std::string> expected = {"key_1", "key_3"};
+    EXPECT_EQ(expected, keys);
+}
+
+
+TEST(MemEngineTest, IterateWhileWritingTest) {
+    fs::TempDir rootPath("/tmp/memory_engine_IterateWhileWritingTest.XXXXXX");
+    auto engine = std::make_unique<MemEngine>(0, rootPath.path());
+    for (int32_t i = 0; i < 10; i++) {
+        EXPECT_EQ(ResultCode::SUCCEEDED,
+                  engine->put(folly::stringPrintf("key_%d", i), folly::stringPrintf("val_%d", i)));
+    }
+
+    std::unique_ptr<KVIterator> iter;
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->prefix("key_", &iter));
+    ASSERT_TRUE(iter->valid());
+    EXPECT_EQ("key_0", iter->key());
+    // The value being read is kept even if it is overwritten or removed
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->put("key_0", "new_val"));
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->remove("key_1"));
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->remove("key_0"));
+    EXPECT_EQ("val_0", iter->val());
+
+    std::vector<std::string> keys;
+    for (iter->next(); iter->valid(); iter->next()) {
+        keys.emplace_back(iter->key().str());
+    }
+    EXPECT_EQ(8, keys.size());
+    EXPECT_EQ("key_2", keys.front());
+}
+
+
+TEST(MemEngineTest, SnapshotTest) {
+    fs::TempDir rootPath("/tmp/memory_engine_SnapshotTest.XXXXXX");
+    {
+        auto engine = std::make_unique<MemEngine>(0, rootPath.path());
+        engine->addPart(1);
+        engine->addPart(2);
+        for (int32_t i = 0; i < 1000; i++) {
+            EXPECT_EQ(ResultCode::SUCCEEDED,
+                      engine->put(folly::stringPrintf("key_%d", i),
+                                  std::string(i, 'v')));
+        }
+        EXPECT_EQ(ResultCode::SUCCEEDED, engine->flush());
+        // Not in the snapshot
+        EXPECT_EQ(ResultCode::SUCCEEDED, engine->put("key_not_flushed", "val"));
+        EXPECT_EQ(ResultCode::SUCCEEDED, engine->createCheckpoint("checkpoint"));
+    }
+    {
+        auto engine = std::make_unique<MemEngine>(0, rootPath.path());
+        EXPECT_EQ(2, engine->totalPartsNum());
+        auto parts = engine->allParts();
+        std::sort(parts.begin(), parts.end());
+        EXPECT_EQ((std::vector<PartitionID>{1, 2}), parts);
+        for (int32_t i = 0; i < 1000; i++) {
+            std::string val;
+            EXPECT_EQ(ResultCode::SUCCEEDED,
+                      engine->get(folly::stringPrintf("key_%d", i), &val));
+            EXPECT_EQ(std::string(i, 'v'), val);
+        }
+        std::string val;
+        EXPECT_EQ(ResultCode::ERR_KEY_NOT_FOUND, engine->get("key_not_flushed", &val));
+    }
+    auto checkpoint = folly::stringPrintf("%s/nebula/0/checkpoints/checkpoint/data/"
+                                          "memory.snapshot", rootPath.path());
+    EXPECT_TRUE(fs::FileUtils::exist(checkpoint));
+}
+
+
+TEST(MemEngineTest, IngestTest) {
+    rocksdb::Options options;
+    rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options);
+    fs::TempDir rootPath("/tmp/memory_engine_IngestTest.XXXXXX");
+    auto file = folly::stringPrintf("%s/%s", rootPath.path(), "data.sst");
+    auto status = writer.Open(file);
+    ASSERT_TRUE(status.ok());
+
+    status = writer.Put("key", "value");
+    ASSERT_TRUE(status.ok());
+    status = writer.Put("key_empty", "");
+    ASSERT_TRUE(status.ok());
+    writer.Finish();
+
+    auto engine = std::make_unique<MemEngine>(0, rootPath.path());
+    std::vector<std::string> files = {file};
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->ingest(files));
+
+    std::string result;
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->get("key", &result));
+    EXPECT_EQ("value", result);
+    EXPECT_EQ(ResultCode::SUCCEEDED, engine->get("key_empty", &result));
+    EXPECT_EQ("", result);
+    EXPECT_EQ(ResultCode::ERR_KEY_NOT_FOUND, engine->get("key_not_exist", &result));
+}
+
+}  // namespace kvstore
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}
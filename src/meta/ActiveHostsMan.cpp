@@ -9,25 +9,57 @@
 
 DEFINE_int32(expired_threshold_sec, 10 * 60,
                      "Hosts will be expired in this time if no heartbeat received");
+DEFINE_int32(heartbeat_persist_interval_secs, 60 * 60,
+             "The heartbeat time of a host is persisted at most once in this time, "
+             "the others are only kept in memory of the meta leader");
 
 namespace nebula {
 namespace meta {
 
+// static
+folly::Synchronized<std::unordered_map<HostAddr, HostInfo>>& ActiveHostsMan::hostInfos() {
+    static folly::Synchronized<std::unordered_map<HostAddr, HostInfo>> infos;
+    return infos;
+}
+
 kvstore::ResultCode ActiveHostsMan::updateHostInfo(kvstore::KVStore* kv,
                                                    const HostAddr& hostAddr,
                                                    const HostInfo& info,
                                                    const LeaderParts* leaderParts) {
     CHECK_NOTNULL(kv);
     std::vector<kvstore::KV> data;
-    data.emplace_back(MetaServiceUtils::hostKey(hostAddr.first, hostAddr.second),
-                      HostInfo::encode(info));
+    // The local reads fail on the followers of meta, so only the leader takes it
+    auto hostKey = MetaServiceUtils::hostKey(hostAddr.first, hostAddr.second);
+    std::string val;
+    auto ret = kv->get(kDefaultSpaceId, kDefaultPartId, hostKey, &val);
+    if (ret == kvstore::ResultCode::ERR_KEY_NOT_FOUND) {
+        LOG(INFO) << "Register host " << hostAddr;
+        data.emplace_back(std::move(hostKey), HostInfo::encode(info));
+    } else if (ret != kvstore::ResultCode::SUCCEEDED) {
+        return ret;
+    } else if (info.lastHBTimeInMilliSec_ - HostInfo::decode(val).lastHBTimeInMilliSec_
+                   >= FLAGS_heartbeat_persist_interval_secs * 1000L) {
+        data.emplace_back(std::move(hostKey), HostInfo::encode(info));
+    }
+
     if (leaderParts != nullptr) {
-        data.emplace_back(MetaServiceUtils::leaderKey(hostAddr.first, hostAddr.second),
-                          MetaServiceUtils::leaderVal(*leaderParts));
+        auto leaderKey = MetaServiceUtils::leaderKey(hostAddr.first, hostAddr.second);
+        ret = kv->get(kDefaultSpaceId, kDefaultPartId, leaderKey, &val);
+        if (ret == kvstore::ResultCode::ERR_KEY_NOT_FOUND ||
+                (ret == kvstore::ResultCode::SUCCEEDED &&
+                 MetaServiceUtils::parseLeaderVal(val) != *leaderParts)) {
+            data.emplace_back(std::move(leaderKey), MetaServiceUtils::leaderVal(*leaderParts));
+        } else if (ret != kvstore::ResultCode::SUCCEEDED) {
+            return ret;
+        }
     }
+    hostInfos().wlock()->operator[](hostAddr) = info;
+    if (data.empty()) {
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+
     folly::SharedMutex::WriteHolder wHolder(LockUtils::spaceLock());
     folly::Baton<true, std::atomic> baton;
-    kvstore::ResultCode ret;
     kv->asyncMultiPut(kDefaultSpaceId, kDefaultPartId, std::move(data),
                             [&] (kvstore::ResultCode code) {
         ret = code;
@@ -37,6 +69,16 @@ kvstore::ResultCode ActiveHostsMan::updateHostInfo(kvstore::KVStore* kv,
     return ret;
 }
 
+HostInfo ActiveHostsMan::getHostInfo(const HostAddr& hostAddr, folly::StringPiece persisted) {
+    auto info = HostInfo::decode(persisted);
+    auto infos = hostInfos().rlock();
+    auto it = infos->find(hostAddr);
+    if (it != infos->end() && it->second.lastHBTimeInMilliSec_ > info.lastHBTimeInMilliSec_) {
+        return it->second;
+    }
+    return info;
+}
+
 std::vector<HostAddr> ActiveHostsMan::getActiveHosts(kvstore::KVStore* kv, int32_t expiredTTL) {
     std::vector<HostAddr> hosts;
     const auto& prefix = MetaServiceUtils::hostPrefix();
@@ -49,9 +91,10 @@ std::vector<HostAddr> ActiveHostsMan::getActiveHosts(kvstore::KVStore* kv, int32
     auto now = time::WallClock::fastNowInMilliSec();
     while (iter->valid()) {
         auto host = MetaServiceUtils::parseHostKey(iter->key());
-        HostInfo info = HostInfo::decode(iter->val());
+        HostAddr addr(host.ip, host.port);
+        HostInfo info = getHostInfo(addr, iter->val());
         if (now - info.lastHBTimeInMilliSec_ < threshold) {
-            hosts.emplace_back(host.ip, host.port);
+            hosts.emplace_back(std::move(addr));
         }
         iter->next();
     }
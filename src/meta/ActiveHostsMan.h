@@ -9,6 +9,7 @@
 
 #include "base/Base.h"
 #include <gtest/gtest_prod.h>
+#include <folly/Synchronized.h>
 #include "kvstore/KVStore.h"
 #include "meta/MetaServiceUtils.h"
 
@@ -44,6 +45,13 @@ struct HostInfo {
     }
 };
 
+/**
+ * The heartbeats are kept in memory on the meta leader. Only the registration of
+ * a host, the changes of its leader parts, and its heartbeat time once in
+ * heartbeat_persist_interval_secs are written into the kvstore. After the meta
+ * leader changes, the new leader learns the alive hosts from the next round of
+ * heartbeats.
+ * */
 class ActiveHostsMan final {
 public:
     ~ActiveHostsMan() = default;
@@ -53,12 +61,21 @@ public:
                                               const HostInfo& info,
                                               const LeaderParts* leaderParts = nullptr);
 
+    /**
+     * The last heartbeat of a registered host, the one in memory if any, otherwise
+     * the persisted one.
+     * */
+    static HostInfo getHostInfo(const HostAddr& hostAddr, folly::StringPiece persisted);
+
     static std::vector<HostAddr> getActiveHosts(kvstore::KVStore* kv, int32_t expiredTTL = 0);
 
     static bool isLived(kvstore::KVStore* kv, const HostAddr& host);
 
 protected:
     ActiveHostsMan() = default;
+
+private:
+    static folly::Synchronized<std::unordered_map<HostAddr, HostInfo>>& hostInfos();
 };
 
 class LastUpdateTimeMan final {
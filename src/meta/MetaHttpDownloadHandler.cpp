@@ -15,7 +15,6 @@
 #include "hdfs/HdfsHelper.h"
 #include "http/HttpClient.h"
 #include "process/ProcessUtils.h"
-#include "thread/GenericThreadPool.h"
 #include <proxygen/httpserver/RequestHandler.h>
 #include <proxygen/lib/http/ProxygenErrorEnum.h>
 #include <proxygen/httpserver/ResponseBuilder.h>
@@ -30,14 +29,11 @@ using proxygen::UpgradeProtocol;
 using proxygen::ResponseBuilder;
 
 void MetaHttpDownloadHandler::init(nebula::kvstore::KVStore *kvstore,
-                                   nebula::hdfs::HdfsHelper *helper,
-                                   nebula::thread::GenericThreadPool *pool) {
+                                   nebula::hdfs::HdfsHelper *helper) {
     kvstore_ = kvstore;
     helper_ = helper;
-    pool_ = pool;
     CHECK_NOTNULL(kvstore_);
     CHECK_NOTNULL(helper_);
-    CHECK_NOTNULL(pool_);
 }
 
 void MetaHttpDownloadHandler::onRequest(std::unique_ptr<HTTPMessage> headers) noexcept {
@@ -74,6 +70,7 @@ void MetaHttpDownloadHandler::onRequest(std::unique_ptr<HTTPMessage> headers) no
         return;
     }
     spaceID_ = headers->getIntQueryParam("space");
+    ingest_ = headers->hasQueryParam("ingest") && headers->getQueryParam("ingest") == "true";
     try {
         if (headers->hasQueryParam("tag")) {
             auto& tag = headers->getQueryParam("tag");
@@ -199,7 +196,8 @@ bool MetaHttpDownloadHandler::dispatchSSTFiles() {
         return false;
     }
 
-    std::vector<folly::SemiFuture<bool>> futures;
+    std::vector<std::string> urls;
+    std::vector<folly::SemiFuture<StatusOr<nebula::http::HttpResponse>>> futures;
 
     for (auto &pair : hostPartition) {
         std::string partsStr;
@@ -226,33 +224,25 @@ bool MetaHttpDownloadHandler::dispatchSSTFiles() {
                 hdfsHost_.c_str(), hdfsPort_, hdfsPath_.c_str(),
                 partsStr.c_str(), spaceID_);
         }
-        auto dispatcher = [url] {
-            auto downloadResult = nebula::http::HttpClient::get(url);
-            if (downloadResult.ok() && downloadResult.value() == "SSTFile download successfully") {
-                return true;
-            }
-            LOG(ERROR) << "Download Failed, url: " << url << " error: " << downloadResult.value();
-            return false;
-        };
-        auto future = pool_->addTask(dispatcher);
-        futures.push_back(std::move(future));
+        if (ingest_) {
+            url += "&ingest=true";
+        }
+        futures.emplace_back(nebula::http::HttpClient::instance().asyncGet(url));
+        urls.emplace_back(std::move(url));
     }
 
+    // The requests to all the storages are in flight now
     bool successfully{true};
-    folly::collectAll(std::move(futures)).thenValue(
-        [&](const std::vector<folly::Try<bool>>& tries) {
-            for (const auto& t : tries) {
-                if (t.hasException()) {
-                    LOG(ERROR) << "Download Failed: " << t.exception();
-                    successfully = false;
-                    break;
-                }
-                if (!t.value()) {
-                    successfully = false;
-                    break;
-                }
-            }
-        }).wait();
+    for (auto i = 0UL; i < futures.size(); i++) {
+        auto result = std::move(futures[i]).get();
+        if (!result.ok()) {
+            LOG(ERROR) << "Download Failed, url: " << urls[i] << " error: " << result.status();
+            successfully = false;
+        } else if (result.value().body != "SSTFile download successfully") {
+            LOG(ERROR) << "Download Failed, url: " << urls[i] << " error: " << result.value().body;
+            successfully = false;
+        }
+    }
 
     LOG(INFO) << "Download tasks have finished";
     return successfully;
@@ -11,7 +11,6 @@
 #include "webservice/Common.h"
 #include "kvstore/KVStore.h"
 #include "hdfs/HdfsHelper.h"
-#include "thread/GenericThreadPool.h"
 #include <proxygen/httpserver/RequestHandler.h>
 
 namespace nebula {
@@ -24,8 +23,7 @@ public:
     MetaHttpDownloadHandler() = default;
 
     void init(nebula::kvstore::KVStore *kvstore,
-              nebula::hdfs::HdfsHelper *helper,
-              nebula::thread::GenericThreadPool *pool);
+              nebula::hdfs::HdfsHelper *helper);
 
     void onRequest(std::unique_ptr<proxygen::HTTPMessage> headers) noexcept override;
 
@@ -50,9 +48,10 @@ private:
     GraphSpaceID spaceID_;
     folly::Optional<TagID> tag_;
     folly::Optional<EdgeType> edge_;
+    // Whether the storages ingest every part once downloaded
+    bool ingest_{false};
     nebula::kvstore::KVStore *kvstore_;
     nebula::hdfs::HdfsHelper *helper_;
-    nebula::thread::GenericThreadPool *pool_;
 };
 
 }  // namespace meta
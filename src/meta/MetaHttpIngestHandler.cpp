@@ -11,7 +11,6 @@
 #include "network/NetworkUtils.h"
 #include "http/HttpClient.h"
 #include "process/ProcessUtils.h"
-#include "thread/GenericThreadPool.h"
 #include <proxygen/httpserver/RequestHandler.h>
 #include <proxygen/lib/http/ProxygenErrorEnum.h>
 #include <proxygen/httpserver/ResponseBuilder.h>
@@ -27,12 +26,9 @@ using proxygen::ProxygenError;
 using proxygen::UpgradeProtocol;
 using proxygen::ResponseBuilder;
 
-void MetaHttpIngestHandler::init(nebula::kvstore::KVStore *kvstore,
-                                 nebula::thread::GenericThreadPool *pool) {
+void MetaHttpIngestHandler::init(nebula::kvstore::KVStore *kvstore) {
     kvstore_ = kvstore;
-    pool_ = pool;
     CHECK_NOTNULL(kvstore_);
-    CHECK_NOTNULL(pool_);
 }
 
 void MetaHttpIngestHandler::onRequest(std::unique_ptr<HTTPMessage> headers) noexcept {
@@ -142,7 +138,8 @@ bool MetaHttpIngestHandler::ingestSSTFiles() {
         iter->next();
     }
 
-    std::vector<folly::SemiFuture<bool>> futures;
+    std::vector<std::string> urls;
+    std::vector<folly::SemiFuture<StatusOr<nebula::http::HttpResponse>>> futures;
 
     for (auto &storageIP : storageIPs) {
         std::string url;
@@ -162,33 +159,22 @@ bool MetaHttpIngestHandler::ingestSSTFiles() {
                 storageIP.c_str(), FLAGS_ws_storage_http_port,
                 spaceID_);
         }
-        auto dispatcher = [url] {
-            auto ingestResult = nebula::http::HttpClient::get(url);
-            if (ingestResult.ok() && ingestResult.value() == "SSTFile ingest successfully") {
-                return true;
-            }
-            LOG(ERROR) << "Ingest Failed, url: " << url << " error: " << ingestResult.value();
-            return false;
-        };
-        auto future = pool_->addTask(dispatcher);
-        futures.push_back(std::move(future));
+        futures.emplace_back(nebula::http::HttpClient::instance().asyncGet(url));
+        urls.emplace_back(std::move(url));
     }
 
+    // The requests to all the storages are in flight now
     bool successfully{true};
-    folly::collectAll(std::move(futures)).thenValue(
-        [&](const std::vector<folly::Try<bool>>& tries) {
-            for (const auto& t : tries) {
-                if (t.hasException()) {
-                    LOG(ERROR) << "Ingest Failed: " << t.exception();
-                    successfully = false;
-                    break;
-                }
-                if (!t.value()) {
-                    successfully = false;
-                    break;
-                }
-            }
-        }).wait();
+    for (auto i = 0UL; i < futures.size(); i++) {
+        auto result = std::move(futures[i]).get();
+        if (!result.ok()) {
+            LOG(ERROR) << "Ingest Failed, url: " << urls[i] << " error: " << result.status();
+            successfully = false;
+        } else if (result.value().body != "SSTFile ingest successfully") {
+            LOG(ERROR) << "Ingest Failed, url: " << urls[i] << " error: " << result.value().body;
+            successfully = false;
+        }
+    }
     LOG(INFO) << "Ingest tasks have finished";
     return successfully;
 }
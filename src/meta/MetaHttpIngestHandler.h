@@ -10,7 +10,6 @@
 #include "base/Base.h"
 #include "webservice/Common.h"
 #include "kvstore/KVStore.h"
-#include "thread/GenericThreadPool.h"
 #include <proxygen/httpserver/RequestHandler.h>
 
 namespace nebula {
@@ -22,8 +21,7 @@ class MetaHttpIngestHandler : public proxygen::RequestHandler {
 public:
     MetaHttpIngestHandler() = default;
 
-    void init(nebula::kvstore::KVStore *kvstore,
-              nebula::thread::GenericThreadPool *pool);
+    void init(nebula::kvstore::KVStore *kvstore);
 
     void onRequest(std::unique_ptr<proxygen::HTTPMessage> headers) noexcept override;
 
@@ -45,7 +43,6 @@ private:
     folly::Optional<TagID> tag_;
     folly::Optional<EdgeType> edge_;
     nebula::kvstore::KVStore *kvstore_;
-    nebula::thread::GenericThreadPool *pool_;
 };
 
 }  // namespace meta
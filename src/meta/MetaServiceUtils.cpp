@@ -19,6 +19,7 @@ const std::string kEdgesTable          = "__edges__";          // NOLINT
 const std::string kIndexesTable        = "__indexes__";        // NOLINT
 const std::string kIndexTable          = "__index__";          // NOLINT
 const std::string kIndexStatusTable    = "__index_status__";   // NOLINT
+const std::string kIndexStatsTable     = "__index_stats__";    // NOLINT
 const std::string kUsersTable          = "__users__";          // NOLINT
 const std::string kRolesTable          = "__roles__";          // NOLINT
 const std::string kConfigsTable        = "__configs__";        // NOLINT
@@ -349,6 +350,35 @@ nebula::cpp2::IndexItem MetaServiceUtils::parseIndex(const folly::StringPiece& r
     return item;
 }
 
+std::string MetaServiceUtils::indexStatsKey(GraphSpaceID spaceID, IndexID indexID) {
+    std::string key;
+    key.reserve(kIndexStatsTable.size() + sizeof(GraphSpaceID) + sizeof(IndexID));
+    key.append(kIndexStatsTable.data(), kIndexStatsTable.size());
+    key.append(reinterpret_cast<const char*>(&spaceID), sizeof(GraphSpaceID))
+       .append(reinterpret_cast<const char*>(&indexID), sizeof(IndexID));
+    return key;
+}
+
+std::string MetaServiceUtils::indexStatsVal(const nebula::cpp2::IndexStats& stats) {
+    std::string value;
+    apache::thrift::CompactSerializer::serialize(stats, &value);
+    return value;
+}
+
+std::string MetaServiceUtils::indexStatsPrefix(GraphSpaceID spaceId) {
+    std::string key;
+    key.reserve(kIndexStatsTable.size() + sizeof(GraphSpaceID));
+    key.append(kIndexStatsTable.data(), kIndexStatsTable.size())
+       .append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID));
+    return key;
+}
+
+nebula::cpp2::IndexStats MetaServiceUtils::parseIndexStats(const folly::StringPiece& rawData) {
+    nebula::cpp2::IndexStats stats;
+    apache::thrift::CompactSerializer::deserialize(rawData, stats);
+    return stats;
+}
+
 // This method should replace with JobManager when it ready.
 std::string MetaServiceUtils::rebuildIndexStatus(GraphSpaceID space,
                                                  char type,
@@ -111,6 +111,14 @@ public:
 
     static nebula::cpp2::IndexItem parseIndex(const folly::StringPiece& rawData);
 
+    static std::string indexStatsKey(GraphSpaceID spaceId, IndexID indexID);
+
+    static std::string indexStatsVal(const nebula::cpp2::IndexStats& stats);
+
+    static std::string indexStatsPrefix(GraphSpaceID spaceId);
+
+    static nebula::cpp2::IndexStats parseIndexStats(const folly::StringPiece& rawData);
+
     static std::string rebuildIndexStatus(GraphSpaceID space,
                                           char type,
                                           const std::string& indexName);
@@ -62,11 +62,15 @@ public:
                                   std::string&& statusValue) {
         std::vector<kvstore::KV> status{std::make_pair(std::move(statusKey),
                                                        std::forward<std::string>(statusValue))};
+        return save(kvstore, std::move(status));
+    }
+
+    static bool save(kvstore::KVStore* kvstore, std::vector<kvstore::KV> data) {
         folly::Baton<true, std::atomic> baton;
         auto ret = kvstore::ResultCode::SUCCEEDED;
         kvstore->asyncMultiPut(kDefaultSpaceId,
                                kDefaultPartId,
-                               std::move(status),
+                               std::move(data),
                                [&ret, &baton] (kvstore::ResultCode code) {
                                    if (kvstore::ResultCode::SUCCEEDED != code) {
                                        ret = code;
@@ -228,6 +228,17 @@ protected:
 
     StatusOr<IndexID> getIndexID(GraphSpaceID spaceId, const std::string& indexName);
 
+    /**
+     * An index is incomplete while it is being rebuilt, or its last rebuild failed.
+     * category is 'T' for tag index, 'E' for edge index.
+     */
+    bool isIndexComplete(GraphSpaceID spaceId, char category, const std::string& indexName);
+
+    /**
+     * Attach the stats collected by the last stats job to the index, if any.
+     */
+    void attachIndexStats(GraphSpaceID spaceId, nebula::cpp2::IndexItem& item);
+
     bool checkPassword(const std::string& account, const std::string& password);
 
     kvstore::ResultCode doSyncPut(std::vector<kvstore::KV> data);
@@ -342,6 +342,26 @@ BaseProcessor<RESP>::getIndexID(GraphSpaceID spaceId, const std::string& indexNa
     return Status::IndexNotFound(folly::stringPrintf("Index %s not found", indexName.c_str()));
 }
 
+template<typename RESP>
+bool BaseProcessor<RESP>::isIndexComplete(GraphSpaceID spaceId,
+                                          char category,
+                                          const std::string& indexName) {
+    auto ret = doGet(MetaServiceUtils::rebuildIndexStatus(spaceId, category, indexName));
+    if (!ret.ok()) {
+        // Never rebuilt
+        return true;
+    }
+    return ret.value() == "SUCCEEDED";
+}
+
+template<typename RESP>
+void BaseProcessor<RESP>::attachIndexStats(GraphSpaceID spaceId, nebula::cpp2::IndexItem& item) {
+    auto ret = doGet(MetaServiceUtils::indexStatsKey(spaceId, item.get_index_id()));
+    if (ret.ok()) {
+        item.set_stats(MetaServiceUtils::parseIndexStats(ret.value()));
+    }
+}
+
 template<typename RESP>
 bool BaseProcessor<RESP>::checkPassword(const std::string& account, const std::string& password) {
     auto userKey = MetaServiceUtils::userKey(account);
@@ -46,6 +46,7 @@ void DropTagIndexProcessor::process(const cpp2::DropTagIndexReq& req) {
     }
     keys.emplace_back(MetaServiceUtils::indexIndexKey(spaceID, indexName));
     keys.emplace_back(MetaServiceUtils::indexKey(spaceID, tagIndexID.value()));
+    keys.emplace_back(MetaServiceUtils::indexStatsKey(spaceID, tagIndexID.value()));
 
     LOG(INFO) << "Drop Tag Index " << indexName;
     resp_.set_id(to(tagIndexID.value(), EntryType::INDEX));
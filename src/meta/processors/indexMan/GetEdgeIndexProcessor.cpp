@@ -35,6 +35,8 @@ void GetEdgeIndexProcessor::process(const cpp2::GetEdgeIndexReq& req) {
     }
 
     auto item = MetaServiceUtils::parseIndex(edgeResult.value());
+    item.set_complete(isIndexComplete(spaceID, 'E', indexName));
+    attachIndexStats(spaceID, item);
     handleErrorCode(cpp2::ErrorCode::SUCCEEDED);
     resp_.set_item(std::move(item));
     onFinished();
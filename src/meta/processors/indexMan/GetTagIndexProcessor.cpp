@@ -36,6 +36,8 @@ void GetTagIndexProcessor::process(const cpp2::GetTagIndexReq& req) {
     }
 
     auto item = MetaServiceUtils::parseIndex(tagResult.value());
+    item.set_complete(isIndexComplete(spaceID, 'T', indexName));
+    attachIndexStats(spaceID, item);
     handleErrorCode(cpp2::ErrorCode::SUCCEEDED);
     resp_.set_item(std::move(item));
     onFinished();
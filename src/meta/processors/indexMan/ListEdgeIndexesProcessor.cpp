@@ -29,6 +29,8 @@ void ListEdgeIndexesProcessor::process(const cpp2::ListEdgeIndexesReq& req) {
         auto val = iter->val();
         auto item = MetaServiceUtils::parseIndex(val);
         if (item.get_schema_id().getType() == nebula::cpp2::SchemaID::Type::edge_type) {
+            item.set_complete(isIndexComplete(space, 'E', item.get_index_name()));
+            attachIndexStats(space, item);
             items.emplace_back(std::move(item));
         }
         iter->next();
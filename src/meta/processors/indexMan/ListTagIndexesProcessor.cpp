@@ -29,6 +29,8 @@ void ListTagIndexesProcessor::process(const cpp2::ListTagIndexesReq& req) {
         auto val = iter->val();
         auto item = MetaServiceUtils::parseIndex(val);
         if (item.get_schema_id().getType() == nebula::cpp2::SchemaID::Type::tag_id) {
+            item.set_complete(isIndexComplete(space, 'T', item.get_index_name()));
+            attachIndexStats(space, item);
             items.emplace_back(std::move(item));
         }
         iter->next();
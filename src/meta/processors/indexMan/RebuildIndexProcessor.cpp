@@ -7,6 +7,8 @@
 #include "meta/ActiveHostsMan.h"
 #include "meta/processors/admin/AdminClient.h"
 #include "meta/processors/indexMan/RebuildIndexProcessor.h"
+#include "meta/processors/jobMan/JobManager.h"
+#include "meta/processors/jobMan/TaskDescription.h"
 
 DECLARE_int32(heartbeat_interval_secs);
 
@@ -18,18 +20,22 @@ void RebuildIndexProcessor::processInternal(const cpp2::RebuildIndexReq& req) {
     CHECK_SPACE_ID_AND_RETURN(space);
     const auto &indexName = req.get_index_name();
     auto isOffline = req.get_is_offline();
-    if (!isOffline) {
-        LOG(ERROR) << "Currently not support online rebuild index";
-        resp_.set_code(cpp2::ErrorCode::E_UNSUPPORTED);
+
+    LOG(INFO) << "Rebuild Index Space " << space << ", Index Name " << indexName
+              << (isOffline ? " offline" : " online");
+    auto spaceRet = doGet(MetaServiceUtils::spaceKey(space));
+    if (!spaceRet.ok()) {
+        LOG(ERROR) << "Get space " << space << " failed";
+        resp_.set_code(cpp2::ErrorCode::E_NOT_FOUND);
         onFinished();
         return;
     }
+    auto spaceName = MetaServiceUtils::parseSpace(spaceRet.value()).get_space_name();
 
-    LOG(INFO) << "Rebuild Index Space " << space << ", Index Name " << indexName;
-    const auto& hostPrefix = MetaServiceUtils::leaderPrefix();
-    std::unique_ptr<kvstore::KVIterator> leaderIter;
-    auto leaderRet = kvstore_->prefix(kDefaultSpaceId, kDefaultPartId, hostPrefix, &leaderIter);
-    if (leaderRet != kvstore::ResultCode::SUCCEEDED) {
+    const auto& partPrefix = MetaServiceUtils::partPrefix(space);
+    std::unique_ptr<kvstore::KVIterator> partIter;
+    auto partRet = kvstore_->prefix(kDefaultSpaceId, kDefaultPartId, partPrefix, &partIter);
+    if (partRet != kvstore::ResultCode::SUCCEEDED) {
         LOG(ERROR) << "Get space " << space << "'s part failed";
         resp_.set_code(cpp2::ErrorCode::E_NOT_FOUND);
         onFinished();
@@ -43,72 +49,142 @@ void RebuildIndexProcessor::processInternal(const cpp2::RebuildIndexReq& req) {
         onFinished();
         return;
     }
-
     auto indexID = indexIDResult.value();
-    auto statusKey = MetaServiceUtils::rebuildIndexStatus(space, category_, indexName);
-    if (!MetaCommon::saveRebuildStatus(kvstore_, statusKey, "RUNNING")) {
-        LOG(ERROR) << "Save rebuild status failed";
-        resp_.set_code(cpp2::ErrorCode::E_STORE_FAILURE);
+
+    auto jobId = autoIncrementId();
+    if (!nebula::ok(jobId)) {
+        LOG(ERROR) << "Allocate job id failed";
+        resp_.set_code(nebula::error(jobId));
         onFinished();
         return;
     }
+    auto cmd = category_ == 'T' ? "rebuild tag index" : "rebuild edge index";
+    JobDescription jobDesc(nebula::value(jobId), cmd, {indexName, spaceName});
+    jobDesc.setStatus(cpp2::JobStatus::RUNNING);
 
-    std::vector<folly::Future<Status>> results;
+    auto statusKey = MetaServiceUtils::rebuildIndexStatus(space, category_, indexName);
+    std::vector<kvstore::KV> data;
+    data.emplace_back(statusKey, "RUNNING");
+    data.emplace_back(jobDesc.jobKey(), jobDesc.jobVal());
+
+    // Offline, one task for each replica of each part. Online, the index data goes
+    // through raft, so there is only one task for each part, on its leader.
+    std::vector<TaskDescription> tasks;
     auto activeHosts = ActiveHostsMan::getActiveHosts(kvstore_, FLAGS_heartbeat_interval_secs + 1);
-    while (leaderIter->valid()) {
-        auto host = MetaServiceUtils::parseLeaderKey(leaderIter->key());
-        auto ip = NetworkUtils::intToIPv4(host.get_ip());
-        auto port = host.get_port();
-        auto hostAddrRet = NetworkUtils::toHostAddr(ip, port);
-        if (!hostAddrRet.ok()) {
-            LOG(ERROR) << "Can't cast to host " << ip + ":" << port;
-            resp_.set_code(cpp2::ErrorCode::E_STORE_FAILURE);
-            onFinished();
-            return;
+    auto leaders = isOffline ? std::unordered_map<PartitionID, nebula::cpp2::HostAddr>()
+                             : getLeaders(space);
+    while (partIter->valid()) {
+        auto part = MetaServiceUtils::parsePartKeyPartId(partIter->key());
+        auto hosts = MetaServiceUtils::parsePartVal(partIter->val());
+        if (!isOffline && !hosts.empty()) {
+            auto leader = leaders.find(part);
+            // The first replica is tried if the leader is unknown
+            auto host = leader != leaders.end() ? leader->second : hosts.front();
+            hosts = {std::move(host)};
         }
+        for (auto& host : hosts) {
+            tasks.emplace_back(jobDesc.getJobId(), tasks.size(), host, part);
+            auto& task = tasks.back();
+            if (std::find(activeHosts.begin(), activeHosts.end(),
+                          HostAddr(host.ip, host.port)) == activeHosts.end()) {
+                LOG(ERROR) << "Host " << HostAddr(host.ip, host.port) << " of part "
+                           << part << " is not active";
+                task.setStatus(cpp2::JobStatus::FAILED);
+            }
+            data.emplace_back(task.taskKey(), task.taskVal());
+        }
+        partIter->next();
+    }
 
-        auto hostAddr = hostAddrRet.value();
-        if (std::find(activeHosts.begin(), activeHosts.end(),
-                      HostAddr(host.ip, host.port)) != activeHosts.end()) {
-            auto leaderParts = MetaServiceUtils::parseLeaderVal(leaderIter->val());
-            auto& partIds = leaderParts[space];
-            auto future = caller(hostAddr, space, indexID, std::move(partIds), isOffline);
-            results.emplace_back(std::move(future));
+    // The job is RUNNING as soon as it is saved, register it so that it is not taken
+    // as left behind by RECOVER JOB
+    auto* jobMgr = JobManager::getInstance();
+    jobMgr->addRunningJob(jobDesc.getJobId());
+    if (doSyncPut(std::move(data)) != kvstore::ResultCode::SUCCEEDED) {
+        LOG(ERROR) << "Save rebuild job failed";
+        jobMgr->removeRunningJob(jobDesc.getJobId());
+        resp_.set_code(cpp2::ErrorCode::E_STORE_FAILURE);
+        onFinished();
+        return;
+    }
+
+    std::vector<folly::Future<Status>> results;
+    auto* kvstore = kvstore_;
+    for (auto& task : tasks) {
+        if (task.getStatus() == cpp2::JobStatus::FAILED) {
+            results.emplace_back(folly::makeFuture(Status::Error("Host not active")));
+            continue;
         }
-        leaderIter->next();
+        HostAddr host(task.getHost().get_ip(), task.getHost().get_port());
+        auto future = caller(host, space, indexID, {task.getPart()}, isOffline)
+            .thenValue([kvstore, task = std::move(task)] (Status status) mutable {
+                task.setStatus(status.ok() ? cpp2::JobStatus::FINISHED
+                                           : cpp2::JobStatus::FAILED);
+                MetaCommon::save(kvstore, {std::make_pair(task.taskKey(), task.taskVal())});
+                return status;
+            });
+        results.emplace_back(std::move(future));
     }
 
-    handleRebuildIndexResult(std::move(results), kvstore_, std::move(statusKey));
+    handleRebuildIndexResult(std::move(results), kvstore_, std::move(jobDesc),
+                             std::move(statusKey));
     resp_.set_code(cpp2::ErrorCode::SUCCEEDED);
     onFinished();
 }
 
+std::unordered_map<PartitionID, nebula::cpp2::HostAddr>
+RebuildIndexProcessor::getLeaders(GraphSpaceID space) {
+    std::unordered_map<PartitionID, nebula::cpp2::HostAddr> leaders;
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto ret = kvstore_->prefix(kDefaultSpaceId, kDefaultPartId,
+                                MetaServiceUtils::leaderPrefix(), &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        LOG(ERROR) << "Get leaders failed";
+        return leaders;
+    }
+    while (iter->valid()) {
+        auto host = MetaServiceUtils::parseLeaderKey(iter->key());
+        auto leaderParts = MetaServiceUtils::parseLeaderVal(iter->val());
+        for (auto part : leaderParts[space]) {
+            leaders[part] = host;
+        }
+        iter->next();
+    }
+    return leaders;
+}
+
 void RebuildIndexProcessor::handleRebuildIndexResult(std::vector<folly::Future<Status>> results,
                                                      kvstore::KVStore* kvstore,
+                                                     JobDescription jobDesc,
                                                      std::string statusKey) {
     folly::collectAll(std::move(results))
-        .thenValue([statusKey, kvstore] (const auto& tries) mutable {
+        .thenValue([statusKey, kvstore, jobDesc] (const auto& tries) mutable {
+            bool succeeded = true;
             for (const auto& t : tries) {
                 if (!t.value().ok()) {
-                    LOG(ERROR) << "Build Edge Index Failed";
-                    if (!MetaCommon::saveRebuildStatus(kvstore, statusKey, "FAILED")) {
-                        LOG(ERROR) << "Save rebuild status failed";
-                        return;
-                    }
+                    LOG(ERROR) << "Rebuild index task failed: " << t.value();
+                    succeeded = false;
                 }
             }
-
-            if (!MetaCommon::saveRebuildStatus(kvstore, std::move(statusKey), "SUCCEEDED")) {
+            jobDesc.setStatus(succeeded ? cpp2::JobStatus::FINISHED : cpp2::JobStatus::FAILED);
+            std::vector<kvstore::KV> data;
+            data.emplace_back(jobDesc.jobKey(), jobDesc.jobVal());
+            data.emplace_back(std::move(statusKey), succeeded ? "SUCCEEDED" : "FAILED");
+            if (!MetaCommon::save(kvstore, std::move(data))) {
                 LOG(ERROR) << "Save rebuild status failed";
-                return;
             }
+            JobManager::getInstance()->removeRunningJob(jobDesc.getJobId());
         })
-        .thenError([statusKey, kvstore] (auto &&e) {
+        .thenError([statusKey, kvstore, jobDesc] (auto &&e) mutable {
             LOG(ERROR) << "Exception caught: " << e.what();
-            if (!MetaCommon::saveRebuildStatus(kvstore, std::move(statusKey), "FAILED")) {
+            jobDesc.setStatus(cpp2::JobStatus::FAILED);
+            std::vector<kvstore::KV> data;
+            data.emplace_back(jobDesc.jobKey(), jobDesc.jobVal());
+            data.emplace_back(std::move(statusKey), "FAILED");
+            if (!MetaCommon::save(kvstore, std::move(data))) {
                 LOG(ERROR) << "Save rebuild status failed";
-                return;
             }
+            JobManager::getInstance()->removeRunningJob(jobDesc.getJobId());
         });
 }
 
@@ -8,10 +8,17 @@
 #define META_REBUILDINDEXPROCESSOR_H
 
 #include "meta/processors/BaseProcessor.h"
+#include "meta/processors/jobMan/JobDescription.h"
 
 namespace nebula {
 namespace meta {
 
+/**
+ * Rebuild the index as a job. Offline, it has one task for each replica of each part,
+ * since every replica builds and ingests its index data locally without raft. Online,
+ * it has one task for each part on its leader, which writes the index through raft.
+ * Progress of the parts could be checked by SHOW JOB.
+ * */
 class RebuildIndexProcessor : public BaseProcessor<cpp2::ExecResp> {
 protected:
     void processInternal(const cpp2::RebuildIndexReq& req);
@@ -22,8 +29,17 @@ protected:
                                          std::vector<PartitionID> parts,
                                          bool isOffline) = 0;
 
+    /**
+     * The leader of each part of the space, reported by the heartbeats.
+     * */
+    std::unordered_map<PartitionID, nebula::cpp2::HostAddr> getLeaders(GraphSpaceID space);
+
+    /**
+     * Wait for the tasks of the rebuild job, then mark the job and the index status.
+     * */
     void handleRebuildIndexResult(std::vector<folly::Future<Status>> results,
                                   kvstore::KVStore* kvstore,
+                                  JobDescription jobDesc,
                                   std::string statusKey);
 
     explicit RebuildIndexProcessor(kvstore::KVStore* kvstore,
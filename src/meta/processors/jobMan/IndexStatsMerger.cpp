@@ -0,0 +1,104 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "meta/processors/jobMan/IndexStatsMerger.h"
+#include <folly/json.h>
+#include <folly/String.h>
+
+namespace nebula {
+namespace meta {
+
+// The buckets of the histogram of a numeric column
+static constexpr size_t kHistogramBuckets = 32;
+
+Status IndexStatsMerger::add(const std::string& json) {
+    try {
+        auto stats = folly::parseJson(json);
+        for (const auto& index : stats["indexes"]) {
+            auto& acc = indexes_[index["id"].asInt()];
+            auto rows = index["rows"].asInt();
+            const auto& columns = index["columns"];
+            if (acc.columns.empty()) {
+                acc.columns.resize(columns.size());
+            } else if (acc.columns.size() != columns.size()) {
+                return Status::Error("Columns of index %ld mismatch", index["id"].asInt());
+            }
+            acc.rows += rows;
+            for (auto i = 0UL; i < columns.size(); i++) {
+                auto hll = HyperLogLog::deserialize(folly::unhexlify(columns[i]["hll"].asString()));
+                if (!hll.ok()) {
+                    return hll.status();
+                }
+                acc.columns[i].hll.merge(hll.value());
+
+                const auto& samples = columns[i]["samples"];
+                if (samples.empty()) {
+                    continue;
+                }
+                // Every sample stands for the same number of rows on this host
+                double weight = static_cast<double>(rows) / samples.size();
+                for (const auto& v : samples) {
+                    acc.columns[i].samples.emplace_back(v.asDouble(), weight);
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        return Status::Error("Bad index stats: %s", e.what());
+    }
+    return Status::OK();
+}
+
+std::unordered_map<IndexID, nebula::cpp2::IndexStats>
+IndexStatsMerger::finish(int64_t updateTime) const {
+    std::unordered_map<IndexID, nebula::cpp2::IndexStats> result;
+    for (const auto& index : indexes_) {
+        nebula::cpp2::IndexStats stats;
+        stats.set_rows(index.second.rows);
+        std::vector<nebula::cpp2::IndexColumnStats> columns;
+        for (const auto& acc : index.second.columns) {
+            nebula::cpp2::IndexColumnStats column;
+            column.set_ndv(std::min(acc.hll.estimate(), index.second.rows));
+            column.set_histogram(histogram(acc.samples));
+            columns.emplace_back(std::move(column));
+        }
+        stats.set_columns(std::move(columns));
+        stats.set_update_time(updateTime);
+        result.emplace(index.first, std::move(stats));
+    }
+    return result;
+}
+
+// static
+std::vector<double>
+IndexStatsMerger::histogram(std::vector<std::pair<double, double>> samples) {
+    std::vector<double> bounds;
+    if (samples.empty()) {
+        return bounds;
+    }
+    std::sort(samples.begin(), samples.end());
+    double total = 0;
+    for (const auto& s : samples) {
+        total += s.second;
+    }
+    auto buckets = std::min(kHistogramBuckets, samples.size());
+    bounds.reserve(buckets + 1);
+    bounds.emplace_back(samples.front().first);
+    // The bound of a bucket is the first value reaching its share of the rows
+    double acc = 0;
+    size_t bucket = 1;
+    for (const auto& s : samples) {
+        acc += s.second;
+        while (bucket < buckets && acc >= total * bucket / buckets) {
+            bounds.emplace_back(s.first);
+            bucket++;
+        }
+    }
+    bounds.emplace_back(samples.back().first);
+    return bounds;
+}
+
+}  // namespace meta
+}  // namespace nebula
@@ -0,0 +1,50 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef META_INDEXSTATSMERGER_H_
+#define META_INDEXSTATSMERGER_H_
+
+#include "base/Base.h"
+#include "base/HyperLogLog.h"
+#include "interface/gen-cpp2/common_types.h"
+
+namespace nebula {
+namespace meta {
+
+/**
+ * Merge the index stats collected by every storage host in the stats job,
+ * see storage::IndexStatsCollector.
+ *
+ * The sketches of the distinct values are merged into the ndv of every column prefix,
+ * and the samples, weighted by the rows they stand for, into equi-depth histograms.
+ * */
+class IndexStatsMerger final {
+public:
+    Status add(const std::string& json);
+
+    std::unordered_map<IndexID, nebula::cpp2::IndexStats> finish(int64_t updateTime) const;
+
+private:
+    struct ColumnAcc {
+        HyperLogLog                                 hll;
+        // <value, weight>
+        std::vector<std::pair<double, double>>      samples;
+    };
+
+    struct IndexAcc {
+        int64_t                                     rows{0};
+        std::vector<ColumnAcc>                      columns;
+    };
+
+    static std::vector<double> histogram(std::vector<std::pair<double, double>> samples);
+
+private:
+    std::unordered_map<IndexID, IndexAcc>           indexes_;
+};
+
+}  // namespace meta
+}  // namespace nebula
+#endif  // META_INDEXSTATSMERGER_H_
@@ -6,6 +6,7 @@
 
 #include <boost/stacktrace.hpp>
 #include <gtest/gtest.h>
+#include <folly/executors/InlineExecutor.h>
 #include <folly/futures/Future.h>
 #include <folly/synchronization/Baton.h>
 #include <folly/String.h>
@@ -19,11 +20,11 @@
 #include "meta/processors/jobMan/JobUtils.h"
 #include "meta/processors/jobMan/TaskDescription.h"
 #include "meta/processors/jobMan/JobStatus.h"
+#include "meta/processors/jobMan/IndexStatsMerger.h"
 #include "meta/MetaServiceUtils.h"
 #include "webservice/Common.h"
 #include "common/time/WallClock.h"
 
-DEFINE_int32(dispatch_thread_num, 10, "Number of job dispatch http thread");
 DEFINE_int32(job_check_intervals, 5000, "job intervals in us");
 DEFINE_double(job_expired_secs, 7*24*60*60, "job expired intervals in sec");
 
@@ -47,9 +48,6 @@ bool JobManager::init(nebula::kvstore::KVStore* store) {
         return false;
     }
     kvStore_ = store;
-    pool_ = std::make_unique<nebula::thread::GenericThreadPool>();
-    pool_->start(FLAGS_dispatch_thread_num);
-
     queue_ = std::make_unique<folly::UMPSCQueue<int32_t, true>>();
     bgThread_ = std::make_unique<thread::GenericWorker>();
     CHECK(bgThread_->start());
@@ -72,7 +70,6 @@ void JobManager::shutDown() {
         return;
     }
     status_ = Status::STOPPED;
-    pool_->stop();
     bgThread_->stop();
     bgThread_->wait();
     LOG(INFO) << "JobManager::shutDown() end";
@@ -145,58 +142,65 @@ bool JobManager::runJobInternal(const JobDescription& jobDesc) {
     }
 
     int32_t iJob = jobDesc.getJobId();
-    std::vector<folly::SemiFuture<bool>> futures;
+    std::vector<std::unique_ptr<TaskDescription>> tasks;
+    std::vector<folly::Future<bool>> futures;
+    // The stats op responds with the index stats of the host, instead of "ok"
+    bool isStats = op == "stats";
+    std::vector<std::string> bodies(hosts.size());
     size_t iTask = 0;
     for (auto& host : hosts) {
-        auto dispatcher = [=]() {
-            static const char *tmp = "http://%s:%d/admin?op=%s&space=%s";
-            auto strIP = network::NetworkUtils::intToIPv4(host.get_ip());
-            auto url = folly::stringPrintf(tmp, strIP.c_str(),
-                                           FLAGS_ws_storage_http_port,
-                                           op.c_str(),
-                                           spaceName.c_str());
-            LOG(INFO) << "make admin url: " << url << ", iTask=" << iTask;
-            TaskDescription taskDesc(iJob, iTask, host);
-            save(taskDesc.taskKey(), taskDesc.taskVal());
-
-            auto httpResult = nebula::http::HttpClient::get(url, "-GSs");
-            bool succeed = httpResult.ok() && httpResult.value() == "ok";
-
-            if (succeed) {
-                taskDesc.setStatus(cpp2::JobStatus::FINISHED);
-            } else {
-                LOG(INFO) << "task " << iTask << " failed"
-                          << ", httpResult.ok()=" << httpResult.ok()
-                          << ", httpResult.value()=" << httpResult.value();
-                taskDesc.setStatus(cpp2::JobStatus::FAILED);
-            }
-
-            save(taskDesc.taskKey(), taskDesc.taskVal());
-            return succeed;
-        };
-        ++iTask;
-        auto future = pool_->addTask(dispatcher);
+        static const char *tmp = "http://%s:%d/admin?op=%s&space=%s";
+        auto strIP = network::NetworkUtils::intToIPv4(host.get_ip());
+        auto url = folly::stringPrintf(tmp, strIP.c_str(),
+                                       FLAGS_ws_storage_http_port,
+                                       op.c_str(),
+                                       spaceName.c_str());
+        LOG(INFO) << "make admin url: " << url << ", iTask=" << iTask;
+        tasks.emplace_back(std::make_unique<TaskDescription>(iJob, iTask, host));
+        auto* taskDesc = tasks.back().get();
+        save(taskDesc->taskKey(), taskDesc->taskVal());
+
+        // Only mark the task when the storage responds, it is saved later in this thread
+        auto future = nebula::http::HttpClient::instance().asyncGet(url)
+            .via(&folly::InlineExecutor::instance())
+            .thenValue([taskDesc, iTask, isStats, body = &bodies[iTask]]
+                       (StatusOr<nebula::http::HttpResponse> &&httpResult) {
+                bool succeed = httpResult.ok() && httpResult.value().code == 200 &&
+                               (isStats ? folly::StringPiece(httpResult.value().body)
+                                              .startsWith('{')
+                                        : httpResult.value().body == "ok");
+                if (succeed && isStats) {
+                    *body = std::move(httpResult.value().body);
+                }
+                if (succeed) {
+                    taskDesc->setStatus(cpp2::JobStatus::FINISHED);
+                } else {
+                    LOG(INFO) << "task " << iTask << " failed, httpResult: "
+                              << (httpResult.ok() ? httpResult.value().body
+                                                  : httpResult.status().toString());
+                    taskDesc->setStatus(cpp2::JobStatus::FAILED);
+                }
+                return succeed;
+            });
         futures.push_back(std::move(future));
+        ++iTask;
     }
 
     bool successfully{true};
-    folly::collectAll(std::move(futures))
-        .thenValue([&](const std::vector<folly::Try<bool>>& tries) {
-            for (const auto& t : tries) {
-                if (t.hasException()) {
-                    LOG(ERROR) << "admin Failed: " << t.exception();
-                    successfully = false;
-                    break;
-                }
-                if (!t.value()) {
-                    successfully = false;
-                    break;
-                }
-            }
-        }).thenError([&](auto&& e) {
-            LOG(ERROR) << "admin Failed: " << e.what();
+    auto tries = folly::collectAll(std::move(futures)).get();
+    for (auto i = 0UL; i < tries.size(); i++) {
+        if (tries[i].hasException()) {
+            LOG(ERROR) << "admin Failed: " << tries[i].exception();
+            tasks[i]->setStatus(cpp2::JobStatus::FAILED);
             successfully = false;
-        }).wait();
+        } else if (!tries[i].value()) {
+            successfully = false;
+        }
+        save(tasks[i]->taskKey(), tasks[i]->taskVal());
+    }
+    if (successfully && isStats) {
+        successfully = saveIndexStats(spaceId, bodies);
+    }
     LOG(INFO) << folly::stringPrintf("admin job %d %s, descrtion: %s %s",
                                      iJob,
                                      successfully ? "succeeded" : "failed",
@@ -205,6 +209,27 @@ bool JobManager::runJobInternal(const JobDescription& jobDesc) {
     return successfully;
 }
 
+bool JobManager::saveIndexStats(GraphSpaceID spaceId, const std::vector<std::string>& bodies) {
+    IndexStatsMerger merger;
+    for (const auto& body : bodies) {
+        auto status = merger.add(body);
+        if (!status.ok()) {
+            LOG(ERROR) << "Merge index stats failed: " << status;
+            return false;
+        }
+    }
+    auto now = time::WallClock::fastNowInSec();
+    for (const auto& stats : merger.finish(now)) {
+        auto rc = save(MetaServiceUtils::indexStatsKey(spaceId, stats.first),
+                       MetaServiceUtils::indexStatsVal(stats.second));
+        if (rc != kvstore::ResultCode::SUCCEEDED) {
+            LOG(ERROR) << "Save stats of index " << stats.first << " failed";
+            return false;
+        }
+    }
+    return true;
+}
+
 ResultCode JobManager::addJob(const JobDescription& jobDesc) {
     auto rc = save(jobDesc.jobKey(), jobDesc.jobVal());
     if (rc == nebula::kvstore::SUCCEEDED) {
@@ -320,6 +345,7 @@ ErrorOr<ResultCode, int32_t> JobManager::recoverJob() {
     if (rc != nebula::kvstore::SUCCEEDED) {
         return rc;
     }
+    std::vector<JobDescription> orphanedJobs;
     for (; iter->valid(); iter->next()) {
         if (!JobDescription::isJobKey(iter->key())) {
             continue;
@@ -329,12 +355,84 @@ ErrorOr<ResultCode, int32_t> JobManager::recoverJob() {
             if (optJob->getStatus() == cpp2::JobStatus::QUEUE) {
                 queue_->enqueue(optJob->getJobId());
                 ++recoveredJobNum;
+            } else if (optJob->getStatus() == cpp2::JobStatus::RUNNING
+                    && (optJob->getCmd() == "rebuild tag index"
+                        || optJob->getCmd() == "rebuild edge index")) {
+                std::lock_guard<std::mutex> lk(runningJobsGuard_);
+                if (runningJobs_.count(optJob->getJobId()) == 0) {
+                    orphanedJobs.emplace_back(std::move(optJob).value());
+                }
             }
         }
     }
+    // A rebuild index job is driven by the meta leader which started it, and can't be
+    // resumed by the queue, so it is failed and could be issued again.
+    for (auto& jobDesc : orphanedJobs) {
+        rc = failRebuildIndexJob(jobDesc);
+        if (rc != nebula::kvstore::SUCCEEDED) {
+            return rc;
+        }
+    }
     return recoveredJobNum;
 }
 
+ResultCode JobManager::failRebuildIndexJob(JobDescription& jobDesc) {
+    LOG(INFO) << "Fail the rebuild index job " << jobDesc.getJobId() << " left running";
+    jobDesc.setStatus(cpp2::JobStatus::FAILED);
+    std::vector<kvstore::KV> data;
+    data.emplace_back(jobDesc.jobKey(), jobDesc.jobVal());
+
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto rc = kvStore_->prefix(kDefaultSpaceId, kDefaultPartId,
+                               JobDescription::makeJobKey(jobDesc.getJobId()), &iter);
+    if (rc != nebula::kvstore::SUCCEEDED) {
+        return rc;
+    }
+    for (; iter->valid(); iter->next()) {
+        if (JobDescription::isJobKey(iter->key())) {
+            continue;
+        }
+        TaskDescription task(iter->key(), iter->val());
+        if (task.getStatus() == cpp2::JobStatus::RUNNING) {
+            task.setStatus(cpp2::JobStatus::FAILED);
+            data.emplace_back(task.taskKey(), task.taskVal());
+        }
+    }
+
+    // The paras are the index name and the space name
+    auto paras = jobDesc.getParas();
+    auto spaceId = paras.size() == 2 ? getSpaceId(paras.back()) : -1;
+    if (spaceId != -1) {
+        auto category = jobDesc.getCmd() == "rebuild tag index" ? 'T' : 'E';
+        auto statusKey = MetaServiceUtils::rebuildIndexStatus(spaceId, category, paras.front());
+        std::string val;
+        rc = kvStore_->get(kDefaultSpaceId, kDefaultPartId, statusKey, &val);
+        if (rc == nebula::kvstore::SUCCEEDED && val == "RUNNING") {
+            data.emplace_back(std::move(statusKey), "FAILED");
+        }
+    }
+
+    folly::Baton<true, std::atomic> baton;
+    rc = nebula::kvstore::SUCCEEDED;
+    kvStore_->asyncMultiPut(kDefaultSpaceId, kDefaultPartId, std::move(data),
+        [&] (nebula::kvstore::ResultCode code) {
+        rc = code;
+        baton.post();
+    });
+    baton.wait();
+    return rc;
+}
+
+void JobManager::addRunningJob(int32_t iJob) {
+    std::lock_guard<std::mutex> lk(runningJobsGuard_);
+    runningJobs_.emplace(iJob);
+}
+
+void JobManager::removeRunningJob(int32_t iJob) {
+    std::lock_guard<std::mutex> lk(runningJobsGuard_);
+    runningJobs_.erase(iJob);
+}
+
 ResultCode JobManager::save(const std::string& k, const std::string& v) {
     std::vector<kvstore::KV> data{std::make_pair(k, v)};
     folly::Baton<true, std::atomic> baton;
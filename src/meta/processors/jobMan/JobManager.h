@@ -32,6 +32,7 @@ class JobManager : public nebula::cpp::NonCopyable, public nebula::cpp::NonMovab
     FRIEND_TEST(JobManagerTest, showJobs);
     FRIEND_TEST(JobManagerTest, showJob);
     FRIEND_TEST(JobManagerTest, recoverJob);
+    FRIEND_TEST(JobManagerTest, recoverRebuildIndexJob);
 
 public:
     ~JobManager();
@@ -56,12 +57,24 @@ public:
     ResultCode stopJob(int32_t iJob);
     ErrorOr<ResultCode, int32_t> recoverJob();
 
+    /*
+     * The jobs driven outside of the queue, like rebuilding index, are registered
+     * while they run, so that recoverJob could tell the RUNNING ones left behind
+     * by a previous meta leader.
+     * */
+    void addRunningJob(int32_t iJob);
+    void removeRunningJob(int32_t iJob);
+
 private:
     JobManager() = default;
     void runJobBackground();
     bool runJobInternal(const JobDescription& jobDesc);
     int getSpaceId(const std::string& name);
+    // Merge the index stats collected by the storage hosts, and save them
+    bool saveIndexStats(GraphSpaceID spaceId, const std::vector<std::string>& bodies);
     nebula::kvstore::ResultCode save(const std::string& k, const std::string& v);
+    // Mark a rebuild index job left RUNNING, its tasks and the index status as failed
+    nebula::kvstore::ResultCode failRebuildIndexJob(JobDescription& jobDesc);
 
     static bool isExpiredJob(const cpp2::JobDesc& jobDesc);
     void removeExpiredJobs(const std::vector<std::string>& jobKeys);
@@ -71,7 +84,9 @@ private:
     std::mutex  statusGuard_;
     Status status_{Status::NOT_START};
     nebula::kvstore::KVStore* kvStore_{nullptr};
-    std::unique_ptr<nebula::thread::GenericThreadPool> pool_{nullptr};
+
+    std::mutex runningJobsGuard_;
+    std::unordered_set<int32_t> runningJobs_;
 };
 
 }  // namespace meta
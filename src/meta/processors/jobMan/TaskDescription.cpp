@@ -17,13 +17,15 @@ using Status = cpp2::JobStatus;
 
 TaskDescription::TaskDescription(int32_t iJob,
                                  int32_t iTask,
-                                 const nebula::cpp2::HostAddr& dest)
+                                 const nebula::cpp2::HostAddr& dest,
+                                 PartitionID part)
                                  : iJob_(iJob),
                                    iTask_(iTask),
                                    dest_(dest),
                                    status_(cpp2::JobStatus::RUNNING),
                                    startTime_(std::time(nullptr)),
-                                   stopTime_(0) {}
+                                   stopTime_(0),
+                                   part_(part) {}
 
 
 /*
@@ -33,6 +35,7 @@ TaskDescription::TaskDescription(int32_t iJob,
  * cpp2::JobStatus                 status_;
  * int64_t                         startTime_;
  * int64_t                         stopTime_;
+ * PartitionID                     part_;
  * */
 TaskDescription::TaskDescription(const folly::StringPiece& key,
                                  const folly::StringPiece& val) {
@@ -45,6 +48,7 @@ TaskDescription::TaskDescription(const folly::StringPiece& key,
     status_ = std::get<1>(tupVal);
     startTime_ = std::get<2>(tupVal);
     stopTime_ = std::get<3>(tupVal);
+    part_ = std::get<4>(tupVal);
 }
 
 std::string TaskDescription::taskKey() {
@@ -83,6 +87,9 @@ std::string TaskDescription::taskVal() {
     str.append(reinterpret_cast<const char*>(&status_), sizeof(Status));
     str.append(reinterpret_cast<const char*>(&startTime_), sizeof(startTime_));
     str.append(reinterpret_cast<const char*>(&stopTime_), sizeof(stopTime_));
+    if (part_ != 0) {
+        str.append(reinterpret_cast<const char*>(&part_), sizeof(part_));
+    }
     return str;
 }
 
@@ -91,8 +98,9 @@ std::string TaskDescription::taskVal() {
  * cpp2::JobStatus                 status_;
  * int64_t                         startTime_;
  * int64_t                         stopTime_;
+ * PartitionID                     part_ (optional, not written by old versions)
  * */
-std::tuple<nebula::cpp2::HostAddr, Status, int64_t, int64_t>
+std::tuple<nebula::cpp2::HostAddr, Status, int64_t, int64_t, PartitionID>
 TaskDescription::parseVal(const folly::StringPiece& rawVal) {
     size_t offset = 0;
 
@@ -106,8 +114,14 @@ TaskDescription::parseVal(const folly::StringPiece& rawVal) {
     offset += sizeof(int64_t);
 
     auto tStop = JobUtil::parseFixedVal<int64_t>(rawVal, offset);
+    offset += sizeof(int64_t);
 
-    return std::make_tuple(host, status, tStart, tStop);
+    PartitionID part = 0;
+    if (rawVal.size() >= offset + sizeof(PartitionID)) {
+        part = JobUtil::parseFixedVal<PartitionID>(rawVal, offset);
+    }
+
+    return std::make_tuple(host, status, tStart, tStop, part);
 }
 
 /*
@@ -125,6 +139,9 @@ cpp2::TaskDesc TaskDescription::toTaskDesc() {
     ret.set_status(status_);
     ret.set_start_time(startTime_);
     ret.set_stop_time(stopTime_);
+    if (part_ != 0) {
+        ret.set_part_id(part_);
+    }
     return ret;
 }
 
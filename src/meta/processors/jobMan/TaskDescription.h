@@ -13,6 +13,7 @@
 #include <folly/Range.h>
 #include <gtest/gtest_prod.h>
 
+#include "base/Base.h"
 #include "interface/gen-cpp2/meta_types.h"
 #include "meta/processors/jobMan/JobStatus.h"
 
@@ -38,7 +39,10 @@ class TaskDescription {
     FRIEND_TEST(JobManagerTest, showJob);
 
 public:
-    TaskDescription(int32_t iJob, int32_t iTask, const nebula::cpp2::HostAddr& dest);
+    TaskDescription(int32_t iJob,
+                    int32_t iTask,
+                    const nebula::cpp2::HostAddr& dest,
+                    PartitionID part = 0);
     TaskDescription(const folly::StringPiece& key, const folly::StringPiece& val);
 
     /*
@@ -60,9 +64,10 @@ public:
     /*
      * decode task val from kvstore
      * should be
-     * {host, status, start time, stop time}
+     * {host, status, start time, stop time, part}
+     * part is 0 if the task is not on a single part
      * */
-    static std::tuple<nebula::cpp2::HostAddr, cpp2::JobStatus, int64_t, int64_t>
+    static std::tuple<nebula::cpp2::HostAddr, cpp2::JobStatus, int64_t, int64_t, PartitionID>
     parseVal(const folly::StringPiece& rawVal);
 
     /*
@@ -95,6 +100,12 @@ public:
 
     int32_t getJobId() { return iJob_; }
 
+    const nebula::cpp2::HostAddr& getHost() const { return dest_; }
+
+    cpp2::JobStatus getStatus() const { return status_; }
+
+    PartitionID getPart() const { return part_; }
+
 private:
     int32_t                         iJob_;
     int32_t                         iTask_;
@@ -102,6 +113,7 @@ private:
     cpp2::JobStatus                 status_;
     int64_t                         startTime_;
     int64_t                         stopTime_;
+    PartitionID                     part_;
 };
 
 }  // namespace meta
@@ -50,8 +50,8 @@ Status ListHostsProcessor::allHostsWithStatus() {
     while (iter->valid()) {
         cpp2::HostItem item;
         auto host = MetaServiceUtils::parseHostKey(iter->key());
+        HostInfo info = ActiveHostsMan::getHostInfo(HostAddr(host.ip, host.port), iter->val());
         item.set_hostAddr(std::move(host));
-        HostInfo info = HostInfo::decode(iter->val());
         if (now - info.lastHBTimeInMilliSec_ < FLAGS_removed_threshold_sec * 1000) {
             if (now - info.lastHBTimeInMilliSec_ < FLAGS_expired_threshold_sec * 1000) {
                 item.set_status(cpp2::HostStatus::ONLINE);
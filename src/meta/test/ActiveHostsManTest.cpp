@@ -11,6 +11,7 @@
 #include "meta/test/TestUtils.h"
 
 DECLARE_int32(expired_threshold_sec);
+DECLARE_int32(heartbeat_persist_interval_secs);
 
 namespace nebula {
 namespace meta {
@@ -37,10 +38,14 @@ TEST(ActiveHostsManTest, NormalTest) {
             auto host = MetaServiceUtils::parseHostKey(iter->key());
             HostInfo info = HostInfo::decode(iter->val());
             ASSERT_EQ(HostAddr(0, i), HostAddr(host.ip, host.port));
+            // Only the registration is persisted, the later heartbeats are in memory
+            ASSERT_EQ(HostInfo(now), info);
             if (i == 0) {
-                ASSERT_EQ(HostInfo(now + 2000), info);
+                ASSERT_EQ(HostInfo(now + 2000),
+                          ActiveHostsMan::getHostInfo(HostAddr(0, i), iter->val()));
             } else {
-                ASSERT_EQ(HostInfo(now), info);
+                ASSERT_EQ(HostInfo(now),
+                          ActiveHostsMan::getHostInfo(HostAddr(0, i), iter->val()));
             }
             iter->next();
             i++;
@@ -98,6 +103,42 @@ TEST(ActiveHostsManTest, LeaderTest) {
     ASSERT_EQ(1, ActiveHostsMan::getActiveHosts(kv.get()).size());
 }
 
+TEST(ActiveHostsManTest, PersistTest) {
+    fs::TempDir rootPath("/tmp/ActiveHostsManTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    auto now = time::WallClock::fastNowInMilliSec();
+    auto persisted = [&] (const std::string& key) {
+        std::string val;
+        auto ret = kv->get(kDefaultSpaceId, kDefaultPartId, key, &val);
+        CHECK_EQ(kvstore::ResultCode::SUCCEEDED, ret);
+        return val;
+    };
+    auto hostKey = MetaServiceUtils::hostKey(1, 1);
+    auto leaderKey = MetaServiceUtils::leaderKey(1, 1);
+
+    LeaderParts leaderParts;
+    leaderParts.emplace(1, std::vector<PartitionID>{1, 2});
+    ActiveHostsMan::updateHostInfo(kv.get(), HostAddr(1, 1), HostInfo(now), &leaderParts);
+    ASSERT_EQ(HostInfo(now), HostInfo::decode(persisted(hostKey)));
+    ASSERT_EQ(leaderParts, MetaServiceUtils::parseLeaderVal(persisted(leaderKey)));
+
+    // Nothing changed
+    ActiveHostsMan::updateHostInfo(kv.get(), HostAddr(1, 1), HostInfo(now + 1000), &leaderParts);
+    ASSERT_EQ(HostInfo(now), HostInfo::decode(persisted(hostKey)));
+
+    // The leader parts changed
+    leaderParts[1].emplace_back(3);
+    ActiveHostsMan::updateHostInfo(kv.get(), HostAddr(1, 1), HostInfo(now + 2000), &leaderParts);
+    ASSERT_EQ(HostInfo(now), HostInfo::decode(persisted(hostKey)));
+    ASSERT_EQ(leaderParts, MetaServiceUtils::parseLeaderVal(persisted(leaderKey)));
+
+    // The heartbeat time is persisted once in the interval
+    FLAGS_heartbeat_persist_interval_secs = 2;
+    ActiveHostsMan::updateHostInfo(kv.get(), HostAddr(1, 1), HostInfo(now + 3000));
+    ASSERT_EQ(HostInfo(now + 3000), HostInfo::decode(persisted(hostKey)));
+    FLAGS_heartbeat_persist_interval_secs = 60 * 60;
+}
+
 TEST(LastUpdateTimeManTest, NormalTest) {
     fs::TempDir rootPath("/tmp/LastUpdateTimeManTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
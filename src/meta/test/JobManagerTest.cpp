@@ -8,6 +8,8 @@
 
 #include "base/Base.h"
 #include "meta/ActiveHostsMan.h"
+#include "meta/MetaServiceUtils.h"
+#include "meta/processors/Common.h"
 #include "fs/TempDir.h"
 #include "meta/test/TestUtils.h"
 #include "kvstore/Common.h"
@@ -201,6 +203,40 @@ TEST_F(JobManagerTest, recoverJob) {
     ASSERT_EQ(nebula::value(nJobRecovered), nJob);
 }
 
+TEST_F(JobManagerTest, recoverRebuildIndexJob) {
+    // Job 1 is left running by a previous meta leader, job 2 is still running here
+    auto statusKey = MetaServiceUtils::rebuildIndexStatus(1, 'T', "tag_index");
+    jobMgr->save(statusKey, "RUNNING");
+    for (int32_t iJob = 1; iJob <= 2; iJob++) {
+        JobDescription jd(iJob, "rebuild tag index", {"tag_index", "test_space"});
+        jd.setStatus(Status::RUNNING);
+        jobMgr->save(jd.jobKey(), jd.jobVal());
+        nebula::cpp2::HostAddr host;
+        TaskDescription td(iJob, 0, host, 1);
+        jobMgr->save(td.taskKey(), td.taskVal());
+    }
+    jobMgr->addRunningJob(2);
+
+    auto nJobRecovered = jobMgr->recoverJob();
+    ASSERT_TRUE(nebula::ok(nJobRecovered));
+    ASSERT_EQ(0, nebula::value(nJobRecovered));
+
+    auto job1 = jobMgr->showJob(1);
+    ASSERT_TRUE(nebula::ok(job1));
+    EXPECT_EQ(Status::FAILED, nebula::value(job1).first.get_status());
+    ASSERT_EQ(1, nebula::value(job1).second.size());
+    EXPECT_EQ(Status::FAILED, nebula::value(job1).second[0].get_status());
+    std::string val;
+    ASSERT_EQ(ResultCode::SUCCEEDED, kv_->get(kDefaultSpaceId, kDefaultPartId, statusKey, &val));
+    EXPECT_EQ("FAILED", val);
+
+    auto job2 = jobMgr->showJob(2);
+    ASSERT_TRUE(nebula::ok(job2));
+    EXPECT_EQ(Status::RUNNING, nebula::value(job2).first.get_status());
+    EXPECT_EQ(Status::RUNNING, nebula::value(job2).second[0].get_status());
+    jobMgr->removeRunningJob(2);
+}
+
 TEST(JobDescriptionTest, ctor) {
     std::string type1("compact");
     std::string para1("test");
@@ -350,6 +386,25 @@ TEST(TaskDescriptionTest, ctor2) {
     ASSERT_EQ(td1.stopTime_, td2.stopTime_);
 }
 
+TEST(TaskDescriptionTest, partTask) {
+    int32_t iJob = std::pow(2, 7);
+    auto dest = toHost("192.168.8.5");
+
+    TaskDescription td1(iJob, 0, dest, 3);
+    std::string strKey = td1.taskKey();
+    std::string strVal = td1.taskVal();
+    TaskDescription td2(folly::StringPiece(strKey), folly::StringPiece(strVal));
+    auto desc = td2.toTaskDesc();
+    ASSERT_TRUE(desc.__isset.part_id);
+    ASSERT_EQ(3, desc.part_id);
+
+    // A task not on a single part is encoded the same as before
+    TaskDescription td3(iJob, 1, dest);
+    strVal = td3.taskVal();
+    ASSERT_EQ(0, std::get<4>(TaskDescription::parseVal(folly::StringPiece(strVal))));
+    ASSERT_FALSE(td3.toTaskDesc().__isset.part_id);
+}
+
 }  // namespace meta
 }  // namespace nebula
 
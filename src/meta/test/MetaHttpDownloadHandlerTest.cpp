@@ -51,7 +51,7 @@ public:
 
         router.get("/download-dispatch").handler([this](nebula::web::PathParams&&) {
             auto handler = new meta::MetaHttpDownloadHandler();
-            handler->init(kv_.get(), helper.get(), pool_.get());
+            handler->init(kv_.get(), helper.get());
             return handler;
         });
         router.get("/download").handler([this](nebula::web::PathParams&&) {
@@ -32,15 +32,13 @@ public:
         kv_ = TestUtils::initKV(rootPath_->path());
         TestUtils::createSomeHosts(kv_.get());
         TestUtils::assembleSpace(kv_.get(), 1, 1);
-        pool_ = std::make_unique<nebula::thread::GenericThreadPool>();
-        pool_->start(1);
 
         webSvc_ = std::make_unique<WebService>();
 
         auto& router = webSvc_->router();
         router.get("/ingest-dispatch").handler([this](nebula::web::PathParams&&) {
             auto handler = new meta::MetaHttpIngestHandler();
-            handler->init(kv_.get(), pool_.get());
+            handler->init(kv_.get());
             return handler;
         });
         router.get("/ingest").handler([this](nebula::web::PathParams&&) {
@@ -57,7 +55,6 @@ public:
         kv_.reset();
         rootPath_.reset();
         webSvc_.reset();
-        pool_->stop();
         VLOG(1) << "Web service stopped";
     }
 
@@ -65,7 +62,6 @@ private:
     std::unique_ptr<WebService> webSvc_;
     std::unique_ptr<fs::TempDir> rootPath_;
     std::unique_ptr<kvstore::KVStore> kv_;
-    std::unique_ptr<nebula::thread::GenericThreadPool> pool_;
 };
 
 TEST(MetaHttpIngestHandlerTest, MetaIngestTest) {
@@ -238,4 +238,13 @@ std::string GroupClause::toString() const {
     return groupColumns_->toString();
 }
 
+std::string TruncateClause::toString() const {
+    std::string buf;
+    buf.reserve(64);
+    buf += isSample_ ? "SAMPLE [" : "LIMIT [";
+    buf += folly::join(",", *counts_);
+    buf += "]";
+    return buf;
+}
+
 }   // namespace nebula
@@ -45,6 +45,7 @@ protected:
         kToClause,
         kWhereClause,
         kYieldClause,
+        kTruncateClause,
 
         kMax,
     };
@@ -426,6 +427,31 @@ public:
 private:
     std::unique_ptr<YieldColumns>               groupColumns_;
 };
+
+// LIMIT [n1, n2, ...] or SAMPLE [n1, n2, ...], the count of edges returned
+// for each vertex in every step.
+class TruncateClause final : public Clause {
+public:
+    TruncateClause(std::vector<int32_t> *counts, bool isSample) {
+        counts_.reset(counts);
+        isSample_ = isSample;
+        kind_ = Kind::kTruncateClause;
+    }
+
+    const std::vector<int32_t>& counts() const {
+        return *counts_;
+    }
+
+    bool isSample() const {
+        return isSample_;
+    }
+
+    std::string toString() const;
+
+private:
+    std::unique_ptr<std::vector<int32_t>>       counts_;
+    bool                                        isSample_{false};
+};
 }   // namespace nebula
 #endif  // PARSER_CLAUSES_H_
 
@@ -40,6 +40,10 @@ public:
         yieldClause_.reset(clause);
     }
 
+    void setTruncateClause(TruncateClause *clause) {
+        truncateClause_.reset(clause);
+    }
+
     const StepClause* stepClause() const {
         return stepClause_.get();
     }
@@ -60,6 +64,10 @@ public:
         return yieldClause_.get();
     }
 
+    const TruncateClause* truncateClause() const {
+        return truncateClause_.get();
+    }
+
     std::string toString() const override;
 
 private:
@@ -68,6 +76,7 @@ private:
     std::unique_ptr<OverClause>                 overClause_;
     std::unique_ptr<WhereClause>                whereClause_;
     std::unique_ptr<YieldClause>                yieldClause_;
+    std::unique_ptr<TruncateClause>             truncateClause_;
 };
 
 
@@ -59,6 +59,7 @@ static constexpr size_t MAX_ABS_INTEGER = 9223372036854775808ULL;
     nebula::WhereClause                    *where_clause;
     nebula::WhenClause                     *when_clause;
     nebula::YieldClause                    *yield_clause;
+    nebula::TruncateClause                 *truncate_clause;
     nebula::YieldColumns                   *yield_columns;
     nebula::YieldColumn                    *yield_column;
     nebula::VertexTagList                  *vertex_tag_list;
@@ -120,18 +121,19 @@ static constexpr size_t MAX_ABS_INTEGER = 9223372036854775808ULL;
 %token KW_SHORTEST KW_PATH KW_NOLOOP
 %token KW_IS KW_NULL KW_DEFAULT
 %token KW_SNAPSHOT KW_SNAPSHOTS KW_LOOKUP
-%token KW_JOBS KW_JOB KW_RECOVER KW_FLUSH KW_COMPACT KW_SUBMIT
+%token KW_JOBS KW_JOB KW_RECOVER KW_FLUSH KW_COMPACT KW_SUBMIT KW_STATS
 %token KW_BIDIRECT
 %token KW_USER KW_USERS KW_ACCOUNT
 %token KW_PASSWORD KW_CHANGE KW_ROLE KW_ROLES
 %token KW_GOD KW_ADMIN KW_DBA KW_GUEST KW_GRANT KW_REVOKE KW_ON
 %token KW_CONTAINS
+%token KW_SAMPLE
 
 /* symbols */
 %token L_PAREN R_PAREN L_BRACKET R_BRACKET L_BRACE R_BRACE COMMA
 %token PIPE OR AND XOR LT LE GT GE EQ NE PLUS MINUS MUL DIV MOD NOT NEG ASSIGN
 %token DOT COLON SEMICOLON L_ARROW R_ARROW AT
-%token ID_PROP TYPE_PROP SRC_ID_PROP DST_ID_PROP RANK_PROP INPUT_REF DST_REF SRC_REF
+%token ID_PROP TYPE_PROP SRC_ID_PROP DST_ID_PROP RANK_PROP DEGREE_PROP INPUT_REF DST_REF SRC_REF
 
 /* token type specification */
 %token <boolval> BOOL
@@ -165,6 +167,7 @@ static constexpr size_t MAX_ABS_INTEGER = 9223372036854775808ULL;
 %type <where_clause> where_clause
 %type <when_clause> when_clause
 %type <yield_clause> yield_clause
+%type <truncate_clause> truncate_clause
 %type <yield_columns> yield_columns
 %type <yield_column> yield_column
 %type <vertex_tag_list> vertex_tag_list
@@ -290,6 +293,7 @@ unreserved_keyword
      | KW_OFFLINE            { $$ = new std::string("offline"); }
      | KW_FORCE              { $$ = new std::string("force"); }
      | KW_STATUS             { $$ = new std::string("status"); }
+     | KW_STATS              { $$ = new std::string("stats"); }
      | KW_PART               { $$ = new std::string("part"); }
      | KW_PARTS              { $$ = new std::string("parts"); }
      | KW_DEFAULT            { $$ = new std::string("default"); }
@@ -310,6 +314,7 @@ unreserved_keyword
      | KW_STORAGE            { $$ = new std::string("storage"); }
      | KW_ALL                { $$ = new std::string("all"); }
      | KW_SHORTEST           { $$ = new std::string("shortest"); }
+     | KW_SAMPLE             { $$ = new std::string("sample"); }
      | KW_NOLOOP             { $$ = new std::string("noloop"); }
      | KW_COUNT_DISTINCT     { $$ = new std::string("count_distinct"); }
      | KW_CONTAINS           { $$ = new std::string("contains"); }
@@ -434,6 +439,9 @@ alias_ref_expression
     | name_label DOT RANK_PROP {
         $$ = new EdgeRankExpression($1);
     }
+    | name_label DOT DEGREE_PROP {
+        $$ = new AliasPropertyExpression(new std::string(""), $1, new std::string(_DEGREE));
+    }
     ;
 
 function_call_expression
@@ -583,7 +591,7 @@ expression
     ;
 
 go_sentence
-    : KW_GO step_clause from_clause over_clause where_clause yield_clause {
+    : KW_GO step_clause from_clause over_clause where_clause yield_clause truncate_clause {
         auto go = new GoSentence();
         go->setStepClause($2);
         go->setFromClause($3);
@@ -603,10 +611,21 @@ go_sentence
             $6 = new YieldClause(cols);
         }
         go->setYieldClause($6);
+        go->setTruncateClause($7);
         $$ = go;
     }
     ;
 
+truncate_clause
+    : %empty { $$ = nullptr; }
+    | KW_LIMIT L_BRACKET integer_list R_BRACKET {
+        $$ = new TruncateClause($3, false);
+    }
+    | KW_SAMPLE L_BRACKET integer_list R_BRACKET {
+        $$ = new TruncateClause($3, true);
+    }
+    ;
+
 step_clause
     : %empty { $$ = new StepClause(); }
     | INTEGER KW_STEPS {
@@ -1647,6 +1666,7 @@ admin_sentence
 admin_operation
     : KW_COMPACT { $$ = new std::string("compact"); }
     | KW_FLUSH   { $$ = new std::string("flush"); }
+    | KW_STATS   { $$ = new std::string("stats"); }
     | admin_operation admin_para {
         $$ = new std::string(*$1 + " " + *$2);
     }
@@ -1122,6 +1122,43 @@ TEST(Parser, FetchEdge) {
         auto result = parser.parse(query);
         ASSERT_TRUE(result.ok()) << result.status();
     }
+    {
+        GQLParser parser;
+        std::string query = "GO FROM 12345 OVER transfer "
+                            "WHERE transfer._degree > 10 "
+                            "YIELD transfer._dst, transfer._degree";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+    }
+}
+
+TEST(Parser, GoWithTruncate) {
+    {
+        GQLParser parser;
+        std::string query = "GO 2 STEPS FROM 1 OVER friend LIMIT [100, 10]";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+    }
+    {
+        GQLParser parser;
+        std::string query = "GO 2 STEPS FROM 1 OVER friend WHERE friend.start > 2000 "
+                            "YIELD friend._dst AS id SAMPLE [100, 10] | "
+                            "LIMIT 10";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+    }
+    {
+        GQLParser parser;
+        std::string query = "GO FROM 1 OVER sample YIELD sample._dst AS sample SAMPLE [3]";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+    }
+    {
+        GQLParser parser;
+        std::string query = "GO FROM 1 OVER friend LIMIT 10";
+        auto result = parser.parse(query);
+        ASSERT_FALSE(result.ok());
+    }
 }
 
 TEST(Parser, Lookup) {
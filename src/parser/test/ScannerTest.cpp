@@ -250,6 +250,9 @@ TEST(Scanner, Basic) {
         CHECK_SEMANTIC_TYPE("STATUS", TokenType::KW_STATUS),
         CHECK_SEMANTIC_TYPE("Status", TokenType::KW_STATUS),
         CHECK_SEMANTIC_TYPE("status", TokenType::KW_STATUS),
+        CHECK_SEMANTIC_TYPE("STATS", TokenType::KW_STATS),
+        CHECK_SEMANTIC_TYPE("Stats", TokenType::KW_STATS),
+        CHECK_SEMANTIC_TYPE("stats", TokenType::KW_STATS),
         CHECK_SEMANTIC_TYPE("PARTS", TokenType::KW_PARTS),
         CHECK_SEMANTIC_TYPE("Parts", TokenType::KW_PARTS),
         CHECK_SEMANTIC_TYPE("parts", TokenType::KW_PARTS),
@@ -447,6 +450,9 @@ TEST(Scanner, Basic) {
         CHECK_SEMANTIC_TYPE("CONTAINS", TokenType::KW_CONTAINS),
         CHECK_SEMANTIC_TYPE("Contains", TokenType::KW_CONTAINS),
         CHECK_SEMANTIC_TYPE("contains", TokenType::KW_CONTAINS),
+        CHECK_SEMANTIC_TYPE("SAMPLE", TokenType::KW_SAMPLE),
+        CHECK_SEMANTIC_TYPE("Sample", TokenType::KW_SAMPLE),
+        CHECK_SEMANTIC_TYPE("sample", TokenType::KW_SAMPLE),
         CHECK_SEMANTIC_TYPE("BIT_AND", TokenType::KW_BIT_AND),
         CHECK_SEMANTIC_TYPE("Bit_and", TokenType::KW_BIT_AND),
         CHECK_SEMANTIC_TYPE("bit_and", TokenType::KW_BIT_AND),
@@ -477,6 +483,7 @@ TEST(Scanner, Basic) {
         CHECK_SEMANTIC_TYPE("_src", TokenType::SRC_ID_PROP),
         CHECK_SEMANTIC_TYPE("_dst", TokenType::DST_ID_PROP),
         CHECK_SEMANTIC_TYPE("_rank", TokenType::RANK_PROP),
+        CHECK_SEMANTIC_TYPE("_degree", TokenType::DEGREE_PROP),
 
         CHECK_SEMANTIC_VALUE("TRUE", TokenType::BOOL, true),
         CHECK_SEMANTIC_VALUE("true", TokenType::BOOL, true),
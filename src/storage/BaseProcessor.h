@@ -13,6 +13,7 @@
 #include <folly/futures/Future.h>
 #include "interface/gen-cpp2/storage_types.h"
 #include "kvstore/KVStore.h"
+#include "kvstore/LogEncoder.h"
 #include "meta/SchemaManager.h"
 #include "meta/IndexManager.h"
 #include "dataman/RowSetWriter.h"
@@ -25,6 +26,7 @@
 #include "stats/Stats.h"
 
 DECLARE_bool(enable_multi_versions);
+DECLARE_bool(enable_degree_counter);
 
 namespace nebula {
 namespace storage {
@@ -165,6 +167,26 @@ protected:
     void collectProps(RowReader* reader, const std::vector<PropContext>& props,
                       Collector* collector);
 
+    /**
+     * Get the degree of the vertex on the edgeType, 0 if there is no counter.
+     * */
+    kvstore::ResultCode getDegree(GraphSpaceID spaceId,
+                                  PartitionID partId,
+                                  VertexID vId,
+                                  EdgeType edgeType,
+                                  int64_t* degree);
+
+    /**
+     * Put the new value of the changed degree counters into the batch. It should be
+     * called inside the atomic op, so the counters are read and written along with
+     * the edges in the same raft log.
+     * */
+    kvstore::ResultCode updateDegrees(
+            GraphSpaceID spaceId,
+            PartitionID partId,
+            const std::map<std::pair<VertexID, EdgeType>, int64_t>& deltas,
+            kvstore::BatchHolder* batchHolder);
+
     void handleAsync(GraphSpaceID spaceId, PartitionID partId, kvstore::ResultCode code);
 
 protected:
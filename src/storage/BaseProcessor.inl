@@ -66,9 +66,13 @@ kvstore::ResultCode BaseProcessor<RESP>::doGetFirstRecord(GraphSpaceID spaceId,
     } else {
         std::unique_ptr<kvstore::KVIterator> iter;
         auto ret = kvstore_->prefix(spaceId, partId, key, &iter);
-        if (ret == kvstore::ResultCode::SUCCEEDED && iter && iter->valid()) {
-            *value = iter->val().str();
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            return ret;
         }
+        if (!iter || !iter->valid()) {
+            return kvstore::ResultCode::ERR_KEY_NOT_FOUND;
+        }
+        *value = iter->val().str();
         return ret;
     }
 }
@@ -176,6 +180,63 @@ BaseProcessor<RESP>::collectIndexValues(RowReader* reader,
     return values;
 }
 
+template <typename RESP>
+kvstore::ResultCode BaseProcessor<RESP>::getDegree(GraphSpaceID spaceId,
+                                                   PartitionID partId,
+                                                   VertexID vId,
+                                                   EdgeType edgeType,
+                                                   int64_t* degree) {
+    std::string val;
+    auto ret = kvstore_->get(spaceId,
+                             partId,
+                             NebulaKeyUtils::degreeKey(partId, vId, edgeType),
+                             &val);
+    if (ret == kvstore::ResultCode::ERR_KEY_NOT_FOUND) {
+        *degree = 0;
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        return ret;
+    }
+    if (val.size() != sizeof(int64_t)) {
+        return kvstore::ResultCode::ERR_CORRUPT_DATA;
+    }
+    *degree = *reinterpret_cast<const int64_t*>(val.data());
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+template <typename RESP>
+kvstore::ResultCode BaseProcessor<RESP>::updateDegrees(
+        GraphSpaceID spaceId,
+        PartitionID partId,
+        const std::map<std::pair<VertexID, EdgeType>, int64_t>& deltas,
+        kvstore::BatchHolder* batchHolder) {
+    for (auto& delta : deltas) {
+        if (delta.second == 0) {
+            continue;
+        }
+        auto vId = delta.first.first;
+        auto edgeType = delta.first.second;
+        int64_t degree = 0;
+        auto ret = getDegree(spaceId, partId, vId, edgeType, &degree);
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            return ret;
+        }
+        degree = std::max(0L, degree + delta.second);
+        VLOG(3) << "Update the degree of vertex " << vId << ", edgeType " << edgeType
+                << " to " << degree;
+        auto key = NebulaKeyUtils::degreeKey(partId, vId, edgeType);
+        if (degree == 0) {
+            batchHolder->remove(std::move(key));
+        } else {
+            batchHolder->put(std::move(key),
+                             std::string(reinterpret_cast<const char*>(&degree),
+                                         sizeof(int64_t)));
+        }
+    }
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
 template <typename RESP>
 void BaseProcessor<RESP>::collectProps(RowReader* reader,
                                        const std::vector<PropContext>& props,
@@ -115,6 +115,12 @@ public:
         prop.count_++;
     }
 
+    // Count the edges without reading them, e.g. from the degree counter
+    void collectCount(int64_t num, const PropContext& prop) {
+        std::lock_guard<std::mutex> lg(lock_);
+        prop.count_ += num;
+    }
+
 private:
     std::mutex lock_;
 };
@@ -32,6 +32,8 @@ public:
         DST  = 0x02,
         TYPE = 0x03,
         RANK = 0x04,
+        // The degree of the src vertex on the edge type, read from the degree counter
+        DEGREE = 0x05,
     };
 
     PropContext() = default;
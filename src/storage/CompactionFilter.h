@@ -65,8 +65,7 @@ public:
     bool schemaValid(GraphSpaceID spaceId, const folly::StringPiece& key) const {
         if (NebulaKeyUtils::isVertex(key)) {
             auto tagId = NebulaKeyUtils::getTagId(key);
-            auto ret = schemaMan_->getLatestTagSchemaVersion(spaceId, tagId);
-            if (ret.ok() && ret.value() == -1) {
+            if (tagInfo(spaceId, tagId).dropped) {
                 VLOG(3) << "Space " << spaceId << ", Tag " << tagId << " invalid";
                 return false;
             }
@@ -75,8 +74,7 @@ public:
             if (edgeType < 0) {
                 edgeType = -edgeType;
             }
-            auto ret = schemaMan_->getLatestEdgeSchemaVersion(spaceId, edgeType);
-            if (ret.ok() && ret.value() == -1) {
+            if (edgeInfo(spaceId, edgeType).dropped) {
                 VLOG(3) << "Space " << spaceId << ", EdgeType " << edgeType << " invalid";
                 return false;
             }
@@ -97,60 +95,44 @@ public:
                   const folly::StringPiece& val) const {
         if (NebulaKeyUtils::isVertex(key)) {
             auto tagId = NebulaKeyUtils::getTagId(key);
-            auto schema = this->schemaMan_->getTagSchema(spaceId, tagId);
-            if (!schema) {
+            auto& info = tagInfo(spaceId, tagId);
+            if (info.schema == nullptr) {
                 VLOG(3) << "Space " << spaceId << ", Tag " << tagId << " invalid";
                 return false;
             }
-            auto reader = nebula::RowReader::getTagPropReader(schemaMan_, val, spaceId, tagId);
+            if (!info.hasTTL()) {
+                return true;
+            }
+            auto reader = getReader(info, val, [&] (SchemaVer ver) {
+                return schemaMan_->getTagSchema(spaceId, tagId, ver);
+            });
             if (reader == nullptr) {
                 VLOG(3) << "Remove the bad format vertex";
                 return false;
             }
-            return checkDataTtlValid(schema.get(), reader.get());
+            return checkDataTtlValid(info, reader.get());
         } else if (NebulaKeyUtils::isEdge(key)) {
-            auto edgeType = NebulaKeyUtils::getEdgeType(key);
-            auto schema = this->schemaMan_->getEdgeSchema(spaceId, std::abs(edgeType));
-            if (!schema) {
+            auto edgeType = std::abs(NebulaKeyUtils::getEdgeType(key));
+            auto& info = edgeInfo(spaceId, edgeType);
+            if (info.schema == nullptr) {
                 VLOG(3) << "Space " << spaceId << ", EdgeType " << edgeType << " invalid";
                 return false;
             }
-            auto reader = nebula::RowReader::getEdgePropReader(schemaMan_, val,
-                                                               spaceId, std::abs(edgeType));
+            if (!info.hasTTL()) {
+                return true;
+            }
+            auto reader = getReader(info, val, [&] (SchemaVer ver) {
+                return schemaMan_->getEdgeSchema(spaceId, edgeType, ver);
+            });
             if (reader == nullptr) {
                 VLOG(3) << "Remove the bad format edge!";
                 return false;
             }
-            return checkDataTtlValid(schema.get(), reader.get());
+            return checkDataTtlValid(info, reader.get());
         }
         return true;
     }
 
-    // TODO(panda) Optimize the method in the future
-    bool checkDataTtlValid(const meta::SchemaProviderIf* schema, nebula::RowReader* reader) const {
-        const auto* nschema = dynamic_cast<const meta::NebulaSchemaProvider*>(schema);
-        if (nschema == NULL) {
-            return true;
-        }
-        const auto schemaProp = nschema->getProp();
-        int ttlDuration = 0;
-        if (schemaProp.get_ttl_duration()) {
-            ttlDuration = *schemaProp.get_ttl_duration();
-        }
-        std::string ttlCol;
-        if (schemaProp.get_ttl_col()) {
-            ttlCol = *schemaProp.get_ttl_col();
-        }
-
-        // Only support the specified ttl_col mode
-        // Not specifying or non-positive ttl_duration behaves like ttl_duration = infinity
-        if (ttlCol.empty() ||  ttlDuration <= 0) {
-            return true;
-        }
-
-        return !nebula::storage::checkDataExpiredForTTL(schema, reader, ttlCol, ttlDuration);
-    }
-
     bool filterVersions(const folly::StringPiece& key) const {
         folly::StringPiece keyWithNoVersion = NebulaKeyUtils::keyWithNoVersion(key);
         if (keyWithNoVersion == lastKeyWithNoVersion_) {
@@ -163,22 +145,115 @@ public:
 
     bool indexValid(GraphSpaceID spaceId, const folly::StringPiece& key) const {
         auto indexId = NebulaKeyUtils::getIndexId(key);
+        auto it = indexes_.find(indexId);
+        if (it != indexes_.end()) {
+            return it->second;
+        }
+        bool valid = true;
         auto eRet = this->indexMan_->getEdgeIndex(spaceId, indexId);
-        if (eRet.ok()) {
-            return true;
+        if (!eRet.ok()) {
+            auto tRet = this->indexMan_->getTagIndex(spaceId, indexId);
+            valid = tRet.ok() || !(eRet.status() == Status::IndexNotFound() &&
+                                   tRet.status() == Status::IndexNotFound());
         }
-        auto tRet = this->indexMan_->getTagIndex(spaceId, indexId);
-        if (tRet.ok()) {
-            return true;
+        indexes_.emplace(indexId, valid);
+        return valid;
+    }
+
+private:
+    /**
+     * The schema and TTL of a tag or an edge type. They are looked up once and kept
+     * for the whole compaction job, which runs with a new filter every time.
+     * */
+    struct SchemaInfo {
+        // The latest schema version is -1
+        bool dropped = false;
+        std::shared_ptr<const meta::SchemaProviderIf> schema;
+        std::string ttlCol;
+        int64_t ttlDuration = 0;
+        // The schemas of the versions met in the rows
+        std::unordered_map<SchemaVer, std::shared_ptr<const meta::SchemaProviderIf>> versions;
+
+        // Not specifying or non-positive ttl_duration behaves like ttl_duration = infinity
+        bool hasTTL() const {
+            return !ttlCol.empty() && ttlDuration > 0;
+        }
+    };
+
+    SchemaInfo& tagInfo(GraphSpaceID spaceId, TagID tagId) const {
+        auto it = tags_.find(tagId);
+        if (it != tags_.end()) {
+            return it->second;
+        }
+        auto ver = schemaMan_->getLatestTagSchemaVersion(spaceId, tagId);
+        auto schema = schemaMan_->getTagSchema(spaceId, tagId);
+        return tags_.emplace(tagId, buildInfo(ver, std::move(schema))).first->second;
+    }
+
+    SchemaInfo& edgeInfo(GraphSpaceID spaceId, EdgeType edgeType) const {
+        auto it = edges_.find(edgeType);
+        if (it != edges_.end()) {
+            return it->second;
+        }
+        auto ver = schemaMan_->getLatestEdgeSchemaVersion(spaceId, edgeType);
+        auto schema = schemaMan_->getEdgeSchema(spaceId, edgeType);
+        return edges_.emplace(edgeType, buildInfo(ver, std::move(schema))).first->second;
+    }
+
+    static SchemaInfo buildInfo(const StatusOr<SchemaVer>& ver,
+                                std::shared_ptr<const meta::SchemaProviderIf> schema) {
+        SchemaInfo info;
+        info.dropped = ver.ok() && ver.value() == -1;
+        info.schema = std::move(schema);
+        // Only support the specified ttl_col mode
+        const auto* nschema = dynamic_cast<const meta::NebulaSchemaProvider*>(info.schema.get());
+        if (nschema != nullptr) {
+            const auto schemaProp = nschema->getProp();
+            if (schemaProp.get_ttl_duration()) {
+                info.ttlDuration = *schemaProp.get_ttl_duration();
+            }
+            if (schemaProp.get_ttl_col()) {
+                info.ttlCol = *schemaProp.get_ttl_col();
+            }
         }
-        return !(eRet.status() == Status::IndexNotFound() &&
-                 tRet.status() == Status::IndexNotFound());
+        return info;
+    }
+
+    /**
+     * The reader of the row with the schema of its own version. The ttl column of the
+     * rows in format v2 is read from its slot directly, without decoding the fields before.
+     * */
+    template <class GetSchema>
+    RowReader getReader(SchemaInfo& info,
+                        const folly::StringPiece& val,
+                        GetSchema&& getSchema) const {
+        auto ver = RowReader::getSchemaVer(val);
+        if (ver < 0) {
+            return RowReader::getEmptyRowReader();
+        }
+        auto& versions = info.versions;
+        auto it = versions.find(ver);
+        if (it == versions.end()) {
+            it = versions.emplace(ver, getSchema(ver)).first;
+        }
+        if (it->second == nullptr) {
+            return RowReader::getEmptyRowReader();
+        }
+        return RowReader::getRowReader(val, it->second);
+    }
+
+    bool checkDataTtlValid(const SchemaInfo& info, nebula::RowReader* reader) const {
+        return !nebula::storage::checkDataExpiredForTTL(info.schema.get(), reader,
+                                                        info.ttlCol, info.ttlDuration);
     }
 
 private:
     mutable std::string lastKeyWithNoVersion_;
     meta::SchemaManager* schemaMan_ = nullptr;
     meta::IndexManager* indexMan_ = nullptr;
+    mutable std::unordered_map<TagID, SchemaInfo> tags_;
+    mutable std::unordered_map<EdgeType, SchemaInfo> edges_;
+    mutable std::unordered_map<IndexID, bool> indexes_;
 };
 
 class StorageCompactionFilterFactory final : public kvstore::KVCompactionFilterFactory {
@@ -18,5 +18,17 @@ DEFINE_int32(waiting_new_leader_interval_in_secs, 5,
              "interval between two requests for catching up state");
 DEFINE_int32(rebuild_index_batch_num, 1024,
              "The batch size when rebuild index");
+DEFINE_int32(rebuild_index_sst_entries, 1000000,
+             "The max number of index entries sorted into one sst file when rebuild index");
+DEFINE_int32(rebuild_index_part_concurrency, 4,
+             "The number of parts rebuilding index in parallel");
+DEFINE_int32(rebuild_index_part_rate_limit, 0,
+             "The max index entries per second backfilled by each part when rebuild index "
+             "online, 0 means unlimited");
+DEFINE_int32(cascade_delete_batch_num, 1024,
+             "The number of reverse edges in one request when deleting vertices");
+DEFINE_bool(enable_degree_counter, false,
+            "If true, maintain the degree of each vertex per edge type and direction "
+            "along with the edge writes. It should be enabled before any edge is inserted");
 DEFINE_bool(enable_multi_versions, false, "If true, the insert timestamp will be the wall clock. "
                                           "If false, always has the same timestamp of max");
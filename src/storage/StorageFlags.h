@@ -21,6 +21,16 @@ DECLARE_int32(waiting_new_leader_interval_in_secs);
 
 DECLARE_int32(rebuild_index_batch_num);
 
+DECLARE_int32(rebuild_index_sst_entries);
+
+DECLARE_int32(rebuild_index_part_concurrency);
+
+DECLARE_int32(rebuild_index_part_rate_limit);
+
+DECLARE_int32(cascade_delete_batch_num);
+
 DECLARE_bool(enable_multi_versions);
 
+DECLARE_bool(enable_degree_counter);
+
 #endif  // STORAGE_STORAGEFLAGS_H_
@@ -10,6 +10,7 @@
 #include "storage/StorageServiceHandler.h"
 #include "storage/http/StorageHttpStatsHandler.h"
 #include "storage/http/StorageHttpDownloadHandler.h"
+#include "storage/http/StorageHttpDownloadStatsHandler.h"
 #include "storage/http/StorageHttpIngestHandler.h"
 #include "storage/http/StorageHttpAdminHandler.h"
 #include "kvstore/PartManager.h"
@@ -26,6 +27,7 @@ DEFINE_bool(reuse_port, true, "Whether to turn on the SO_REUSEPORT option");
 DEFINE_int32(num_io_threads, 16, "Number of IO threads");
 DEFINE_int32(num_worker_threads, 32, "Number of workers");
 DEFINE_int32(storage_http_thread_num, 3, "Number of storage daemon's http thread");
+DECLARE_int32(download_thread_num);
 DEFINE_bool(local_config, false, "meta client will not retrieve latest configuration from meta");
 
 namespace nebula {
@@ -72,21 +74,28 @@ bool StorageServer::initWebService() {
     webWorkers_ = std::make_unique<nebula::thread::GenericThreadPool>();
     webWorkers_->start(FLAGS_storage_http_thread_num, "http thread pool");
     LOG(INFO) << "Http Thread Pool started";
+    downloadWorkers_ = std::make_unique<nebula::thread::GenericThreadPool>();
+    downloadWorkers_->start(FLAGS_download_thread_num, "download thread pool");
     webSvc_ = std::make_unique<WebService>();
     auto& router = webSvc_->router();
 
     router.get("/download").handler([this](web::PathParams&&) {
         auto* handler = new storage::StorageHttpDownloadHandler();
-        handler->init(hdfsHelper_.get(), webWorkers_.get(), kvstore_.get(), dataPaths_);
+        handler->init(hdfsHelper_.get(), downloadWorkers_.get(), kvstore_.get(), dataPaths_);
         return handler;
     });
+    router.get("/download_stats").handler([](web::PathParams&&) {
+        return new storage::StorageHttpDownloadStatsHandler();
+    });
     router.get("/ingest").handler([this](web::PathParams&&) {
         auto handler = new nebula::storage::StorageHttpIngestHandler();
         handler->init(kvstore_.get());
         return handler;
     });
     router.get("/admin").handler([this](web::PathParams&&) {
-        return new storage::StorageHttpAdminHandler(schemaMan_.get(), kvstore_.get());
+        return new storage::StorageHttpAdminHandler(schemaMan_.get(),
+                                                    kvstore_.get(),
+                                                    indexMan_.get());
     });
     router.get("/rocksdb_stats").handler([](web::PathParams&&) {
         return new storage::StorageHttpStatsHandler();
@@ -140,10 +149,12 @@ bool StorageServer::start() {
         return false;
     }
 
+    auto storageClient = std::make_shared<StorageClient>(ioThreadPool_, metaClient_.get());
     auto handler = std::make_shared<StorageServiceHandler>(kvstore_.get(),
                                                            schemaMan_.get(),
                                                            indexMan_.get(),
-                                                           metaClient_.get());
+                                                           metaClient_.get(),
+                                                           std::move(storageClient));
     try {
         LOG(INFO) << "The storage deamon start on " << localHost_;
         tfServer_ = std::make_unique<apache::thrift::ThriftServer>();
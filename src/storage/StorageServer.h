@@ -69,6 +69,7 @@ private:
 
     std::unique_ptr<nebula::hdfs::HdfsHelper> hdfsHelper_;
     std::unique_ptr<nebula::thread::GenericThreadPool> webWorkers_;
+    std::unique_ptr<nebula::thread::GenericThreadPool> downloadWorkers_;
     std::unique_ptr<meta::ClientBasedGflagsManager> gFlagsMan_;
     std::unique_ptr<meta::SchemaManager> schemaMan_;
     std::unique_ptr<meta::IndexManager> indexMan_;
@@ -10,7 +10,9 @@
 #include "storage/query/QueryVertexPropsProcessor.h"
 #include "storage/query/QueryEdgePropsProcessor.h"
 #include "storage/query/QueryStatsProcessor.h"
+#include "storage/query/TraverseProcessor.h"
 #include "storage/query/GetUUIDProcessor.h"
+#include "storage/query/GetUUIDsProcessor.h"
 #include "storage/query/ScanEdgeProcessor.h"
 #include "storage/query/ScanVertexProcessor.h"
 #include "storage/mutate/AddVerticesProcessor.h"
@@ -62,6 +64,17 @@ StorageServiceHandler::future_boundStats(const cpp2::GetNeighborsRequest& req) {
     RETURN_FUTURE(processor);
 }
 
+folly::Future<cpp2::QueryResponse>
+StorageServiceHandler::future_traverse(const cpp2::GetNeighborsRequest& req) {
+    auto* processor = TraverseProcessor::instance(kvstore_,
+                                                  schemaMan_,
+                                                  &traverseQpsStat_,
+                                                  readerPool_.get(),
+                                                  storageClient_.get(),
+                                                  &vertexCache_);
+    RETURN_FUTURE(processor);
+}
+
 folly::Future<cpp2::QueryResponse>
 StorageServiceHandler::future_getProps(const cpp2::VertexPropRequest& req) {
     auto* processor = QueryVertexPropsProcessor::instance(kvstore_,
@@ -106,7 +119,9 @@ StorageServiceHandler::future_deleteVertices(const cpp2::DeleteVerticesRequest&
                                                         schemaMan_,
                                                         indexMan_,
                                                         &delVertexQpsStat_,
-                                                        &vertexCache_);
+                                                        &vertexCache_,
+                                                        storageClient_.get(),
+                                                        readerPool_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -213,6 +228,12 @@ StorageServiceHandler::future_getUUID(const cpp2::GetUUIDReq& req) {
     RETURN_FUTURE(processor);
 }
 
+folly::Future<cpp2::GetUUIDsResp>
+StorageServiceHandler::future_getUUIDs(const cpp2::GetUUIDsReq& req) {
+    auto* processor = GetUUIDsProcessor::instance(kvstore_);
+    RETURN_FUTURE(processor);
+}
+
 folly::Future<cpp2::AdminExecResp>
 StorageServiceHandler::future_createCheckpoint(const cpp2::CreateCPRequest& req) {
     auto* processor = CreateCheckpointProcessor::instance(kvstore_);
@@ -235,7 +256,8 @@ folly::Future<cpp2::AdminExecResp>
 StorageServiceHandler::future_rebuildTagIndex(const cpp2::RebuildIndexRequest& req) {
     auto* processor = RebuildTagIndexProcessor::instance(kvstore_,
                                                          schemaMan_,
-                                                         indexMan_);
+                                                         indexMan_,
+                                                         rebuildIndexPool_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -243,7 +265,8 @@ folly::Future<cpp2::AdminExecResp>
 StorageServiceHandler::future_rebuildEdgeIndex(const cpp2::RebuildIndexRequest& req) {
     auto* processor = RebuildEdgeIndexProcessor::instance(kvstore_,
                                                           schemaMan_,
-                                                          indexMan_);
+                                                          indexMan_,
+                                                          rebuildIndexPool_.get());
     RETURN_FUTURE(processor);
 }
 
@@ -15,12 +15,14 @@
 #include "meta/IndexManager.h"
 #include "stats/StatsManager.h"
 #include "storage/CommonUtils.h"
+#include "storage/client/StorageClient.h"
 #include "stats/Stats.h"
 
 DECLARE_int32(vertex_cache_num);
 DECLARE_int32(vertex_cache_bucket_exp);
 DECLARE_int32(reader_handlers);
 DECLARE_string(reader_handlers_type);
+DECLARE_int32(rebuild_index_part_concurrency);
 
 namespace nebula {
 namespace storage {
@@ -32,11 +34,13 @@ public:
     StorageServiceHandler(kvstore::KVStore* kvstore,
                           meta::SchemaManager* schemaMan,
                           meta::IndexManager* indexMan,
-                          meta::MetaClient* client)
+                          meta::MetaClient* client,
+                          std::shared_ptr<StorageClient> storageClient = nullptr)
         : kvstore_(kvstore)
         , schemaMan_(schemaMan)
         , indexMan_(indexMan)
         , metaClient_(client)
+        , storageClient_(std::move(storageClient))
         , vertexCache_(FLAGS_vertex_cache_num, FLAGS_vertex_cache_bucket_exp) {
         if (FLAGS_reader_handlers_type == "io") {
             auto tf = std::make_shared<folly::NamedThreadFactory>("reader-pool");
@@ -52,8 +56,12 @@ public:
             pool->start();
             readerPool_ = std::move(pool);
         }
+        auto rebuildTf = std::make_shared<folly::NamedThreadFactory>("rebuild-index");
+        rebuildIndexPool_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+            FLAGS_rebuild_index_part_concurrency, std::move(rebuildTf));
         getBoundQpsStat_ = stats::Stats("storage", "get_bound");
         boundStatsQpsStat_ = stats::Stats("storage", "bound_stats");
+        traverseQpsStat_ = stats::Stats("storage", "traverse");
         vertexPropsQpsStat_ = stats::Stats("storage", "vertex_props");
         edgePropsQpsStat_ = stats::Stats("storage", "edge_props");
         addVertexQpsStat_ = stats::Stats("storage", "add_vertex");
@@ -75,6 +83,9 @@ public:
     folly::Future<cpp2::QueryStatsResponse>
     future_boundStats(const cpp2::GetNeighborsRequest& req) override;
 
+    folly::Future<cpp2::QueryResponse>
+    future_traverse(const cpp2::GetNeighborsRequest& req) override;
+
     folly::Future<cpp2::QueryResponse>
     future_getProps(const cpp2::VertexPropRequest& req) override;
 
@@ -139,6 +150,9 @@ public:
     folly::Future<cpp2::GetUUIDResp>
     future_getUUID(const cpp2::GetUUIDReq& req) override;
 
+    folly::Future<cpp2::GetUUIDsResp>
+    future_getUUIDs(const cpp2::GetUUIDsReq& req) override;
+
     folly::Future<cpp2::AdminExecResp>
     future_createCheckpoint(const cpp2::CreateCPRequest& req) override;
 
@@ -162,11 +176,16 @@ private:
     meta::SchemaManager* schemaMan_{nullptr};
     meta::IndexManager* indexMan_{nullptr};
     meta::MetaClient* metaClient_{nullptr};
+    // Used to delete the reverse edges on other hosts when deleting vertices
+    std::shared_ptr<StorageClient> storageClient_;
     VertexCache vertexCache_;
     std::shared_ptr<folly::Executor> readerPool_;
+    // Bound the number of parts rebuilding index at the same time
+    std::unique_ptr<folly::CPUThreadPoolExecutor> rebuildIndexPool_;
 
     stats::Stats getBoundQpsStat_;
     stats::Stats boundStatsQpsStat_;
+    stats::Stats traverseQpsStat_;
     stats::Stats vertexPropsQpsStat_;
     stats::Stats edgePropsQpsStat_;
     stats::Stats addVertexQpsStat_;
@@ -4,111 +4,68 @@
  * attached with Common Clause Condition 1.0, found in the LICENSES directory.
  */
 
-#include "kvstore/LogEncoder.h"
-#include "storage/StorageFlags.h"
 #include "storage/admin/RebuildEdgeIndexProcessor.h"
 
 namespace nebula {
 namespace storage {
 
-void RebuildEdgeIndexProcessor::process(const cpp2::RebuildIndexRequest& req) {
-    CHECK_NOTNULL(kvstore_);
-    auto space = req.get_space_id();
-    auto parts = req.get_parts();
-    auto indexID = req.get_index_id();
-    auto itemRet = indexMan_->getEdgeIndex(space, indexID);
-    if (!itemRet.ok()) {
-        cpp2::ResultCode thriftRet;
-        thriftRet.set_code(cpp2::ErrorCode::E_INDEX_NOT_FOUND);
-        codes_.emplace_back(thriftRet);
-        onFinished();
-        return;
-    }
-
-    auto item = itemRet.value();
-    auto edgeType = item->get_schema_id().get_edge_type();
-    LOG(INFO) << "Rebuild Edge Index Space " << space << " Edge Type " << edgeType
-              << " Edge Index " << indexID;
+StatusOr<std::shared_ptr<nebula::cpp2::IndexItem>>
+RebuildEdgeIndexProcessor::getIndex(GraphSpaceID space, IndexID indexId) {
+    return indexMan_->getEdgeIndex(space, indexId);
+}
 
-    for (PartitionID part : parts) {
-        if (req.get_is_offline()) {
-            std::unique_ptr<kvstore::KVIterator> iter;
-            auto prefix = NebulaKeyUtils::prefix(part);
-            auto ret = kvstore_->prefix(space, part, prefix, &iter);
-            if (ret != kvstore::ResultCode::SUCCEEDED) {
-                LOG(ERROR) << "Processing Part " << part << " Failed";
-                this->pushResultCode(to(ret), part);
-                onFinished();
-                return;
+kvstore::ResultCode RebuildEdgeIndexProcessor::buildIndexKeys(GraphSpaceID space,
+                                                              PartitionID part,
+                                                              kvstore::KVIterator* iter,
+                                                              const IndexKeyCallback& cb) {
+    auto edgeType = item_->get_schema_id().get_edge_type();
+    // All tags and edges of a vertex are stored together, so seek to the edges
+    // of each src vertex directly, and then skip the rest keys of the vertex.
+    while (iter->valid()) {
+        auto srcId = NebulaKeyUtils::readInt<VertexID>(iter->key().data() + sizeof(PartitionID),
+                                                       sizeof(VertexID));
+        auto prefix = NebulaKeyUtils::edgePrefix(part, srcId, edgeType);
+        iter->seek(prefix);
+        bool first = true;
+        EdgeRanking lastRank = 0;
+        VertexID lastDstId = 0;
+        for (; iter->valid() && iter->key().startsWith(prefix); iter->next()) {
+            auto key = iter->key();
+            if (!NebulaKeyUtils::isEdge(key)) {
+                continue;
             }
-
-            std::vector<kvstore::KV> data;
-            data.reserve(FLAGS_rebuild_index_batch_num);
-            int32_t batchNum = 0;
-            VertexID currentSrcVertex = -1;
-            VertexID currentDstVertex = -1;
-            while (iter && iter->valid()) {
-                if (batchNum >= FLAGS_rebuild_index_batch_num) {
-                    auto result = doSyncPut(space, part, std::move(data));
-                    if (result != kvstore::ResultCode::SUCCEEDED) {
-                        LOG(ERROR) << "Write Part " << part << " Index Failed";
-                        this->pushResultCode(to(result), part);
-                        onFinished();
-                        return;
-                    }
-                    data.reserve(FLAGS_rebuild_index_batch_num);
-                    batchNum = 0;
-                }
-
-                auto key = iter->key();
-                auto val = iter->val();
-                if (!NebulaKeyUtils::isEdge(key) ||
-                    NebulaKeyUtils::getEdgeType(key) != edgeType) {
-                    iter->next();
-                    continue;
-                }
-
-                auto source = NebulaKeyUtils::getSrcId(key);
-                auto destination = NebulaKeyUtils::getDstId(key);
-                if (currentSrcVertex == source || currentDstVertex == destination) {
-                    iter->next();
-                    continue;
-                } else {
-                    currentSrcVertex = source;
-                    currentDstVertex = destination;
-                }
-                auto ranking = NebulaKeyUtils::getRank(key);
-                auto reader = RowReader::getEdgePropReader(schemaMan_,
-                                                           std::move(val),
-                                                           space,
-                                                           edgeType);
-                if (reader == nullptr) {
-                    iter->next();
-                    continue;
-                }
-                auto values = collectIndexValues(reader.get(), item->get_fields());
-                if (!values.ok()) {
-                    continue;
-                }
-                auto indexKey = NebulaKeyUtils::edgeIndexKey(part, indexID, source,
-                                                             ranking, destination, values.value());
-                data.emplace_back(std::move(indexKey), "");
-                batchNum += 1;
-                iter->next();
+            auto rank = NebulaKeyUtils::getRank(key);
+            auto dstId = NebulaKeyUtils::getDstId(key);
+            // Only the latest version of each edge, which comes first
+            if (!first && rank == lastRank && dstId == lastDstId) {
+                continue;
             }
+            first = false;
+            lastRank = rank;
+            lastDstId = dstId;
 
-            auto result = doSyncPut(space, part, std::move(data));
-            if (result != kvstore::ResultCode::SUCCEEDED) {
-                LOG(ERROR) << "Write Part " << part << " Index Failed";
-                this->pushResultCode(to(result), part);
+            auto reader = RowReader::getEdgePropReader(schemaMan_, iter->val(), space, edgeType);
+            if (reader == nullptr) {
+                continue;
+            }
+            auto values = collectIndexValues(reader.get(), item_->get_fields());
+            if (!values.ok()) {
+                continue;
+            }
+            auto ret = cb(NebulaKeyUtils::edgeIndexKey(part, indexId_, srcId,
+                                                       rank, dstId, values.value()));
+            if (ret != kvstore::ResultCode::SUCCEEDED) {
+                return ret;
             }
-        } else {
-            // TODO darion Support online rebuild index
         }
+        iter->seek(NebulaKeyUtils::vertexRangeEnd(part, srcId));
     }
-    onFinished();
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+VertexID RebuildEdgeIndexProcessor::indexOwner(folly::StringPiece indexKey) {
+    return NebulaKeyUtils::getIndexSrcId(indexKey);
 }
 
 }  // namespace storage
 }  // namespace nebula
-
@@ -7,38 +7,36 @@
 #ifndef STORAGE_ADMIN_REBUILDEDGEINDEXPROCESSOR_H_
 #define STORAGE_ADMIN_REBUILDEDGEINDEXPROCESSOR_H_
 
-#include "kvstore/KVStore.h"
-#include "kvstore/KVIterator.h"
-#include "meta/SchemaManager.h"
-#include "storage/BaseProcessor.h"
+#include "storage/admin/RebuildIndexProcessor.h"
 
 namespace nebula {
 namespace storage {
 
-class RebuildEdgeIndexProcessor : public BaseProcessor<cpp2::AdminExecResp> {
+class RebuildEdgeIndexProcessor : public RebuildIndexProcessor {
 public:
     static RebuildEdgeIndexProcessor* instance(kvstore::KVStore* kvstore,
                                                meta::SchemaManager* schemaMan,
-                                               meta::IndexManager* indexMan) {
-        return new RebuildEdgeIndexProcessor(kvstore, schemaMan, indexMan);
+                                               meta::IndexManager* indexMan,
+                                               folly::Executor* executor = nullptr) {
+        return new RebuildEdgeIndexProcessor(kvstore, schemaMan, indexMan, executor);
     }
 
-    void process(const cpp2::RebuildIndexRequest& req);
-
 private:
     explicit RebuildEdgeIndexProcessor(kvstore::KVStore* kvstore,
                                        meta::SchemaManager* schemaMan,
-                                       meta::IndexManager* indexMan)
-            : BaseProcessor<cpp2::AdminExecResp>(kvstore, schemaMan, nullptr)
-            , indexMan_(indexMan) {}
+                                       meta::IndexManager* indexMan,
+                                       folly::Executor* executor)
+            : RebuildIndexProcessor(kvstore, schemaMan, indexMan, executor) {}
 
-    std::string partitionRebuildIndex(GraphSpaceID space,
-                                      PartitionID part,
-                                      EdgeType edge,
-                                      std::shared_ptr<nebula::cpp2::IndexItem> item);
+    StatusOr<std::shared_ptr<nebula::cpp2::IndexItem>>
+    getIndex(GraphSpaceID space, IndexID indexId) override;
 
-private:
-    meta::IndexManager* indexMan_{nullptr};
+    kvstore::ResultCode buildIndexKeys(GraphSpaceID space,
+                                       PartitionID part,
+                                       kvstore::KVIterator* iter,
+                                       const IndexKeyCallback& cb) override;
+
+    VertexID indexOwner(folly::StringPiece indexKey) override;
 };
 
 }  // namespace storage
@@ -0,0 +1,335 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "storage/admin/RebuildIndexProcessor.h"
+#include <folly/ScopeGuard.h>
+#include <folly/TokenBucket.h>
+#include <rocksdb/sst_file_writer.h>
+#include "fs/FileUtils.h"
+#include "kvstore/DirtyVertexTracker.h"
+#include "kvstore/LogEncoder.h"
+#include "storage/StorageFlags.h"
+
+namespace nebula {
+namespace storage {
+
+void RebuildIndexProcessor::process(const cpp2::RebuildIndexRequest& req) {
+    CHECK_NOTNULL(kvstore_);
+    auto space = req.get_space_id();
+    indexId_ = req.get_index_id();
+    auto itemRet = getIndex(space, indexId_);
+    if (!itemRet.ok()) {
+        cpp2::ResultCode thriftRet;
+        thriftRet.set_code(cpp2::ErrorCode::E_INDEX_NOT_FOUND);
+        codes_.emplace_back(thriftRet);
+        onFinished();
+        return;
+    }
+    item_ = std::move(itemRet).value();
+
+    auto isOffline = req.get_is_offline();
+    auto rebuild = [this, isOffline] (GraphSpaceID spaceId, PartitionID partId) {
+        return isOffline ? rebuildPart(spaceId, partId) : rebuildPartOnline(spaceId, partId);
+    };
+
+    auto parts = req.get_parts();
+    LOG(INFO) << "Rebuild index " << indexId_ << " of space " << space
+              << (isOffline ? " offline, " : " online, ") << parts.size() << " parts";
+    if (executor_ == nullptr) {
+        for (auto part : parts) {
+            auto ret = rebuild(space, part);
+            if (ret != kvstore::ResultCode::SUCCEEDED) {
+                this->pushResultCode(to(ret), part);
+            }
+        }
+        onFinished();
+        return;
+    }
+
+    std::vector<folly::Future<kvstore::ResultCode>> results;
+    results.reserve(parts.size());
+    for (auto part : parts) {
+        results.emplace_back(folly::via(executor_, [rebuild, space, part] () {
+            return rebuild(space, part);
+        }));
+    }
+    folly::collectAll(results).via(executor_).thenTry([this, parts] (auto&& t) {
+        CHECK(!t.hasException());
+        const auto& tries = t.value();
+        for (size_t i = 0; i < tries.size(); i++) {
+            CHECK(!tries[i].hasException());
+            if (tries[i].value() != kvstore::ResultCode::SUCCEEDED) {
+                this->pushResultCode(to(tries[i].value()), parts[i]);
+            }
+        }
+        this->onFinished();
+    });
+}
+
+kvstore::ResultCode RebuildIndexProcessor::rebuildPart(GraphSpaceID space, PartitionID part) {
+    auto partRet = kvstore_->part(space, part);
+    if (!ok(partRet)) {
+        LOG(ERROR) << "Space " << space << " Part " << part << " not found";
+        return error(partRet);
+    }
+    auto* engine = value(partRet)->engine();
+    auto dir = folly::stringPrintf("%s/rebuild_index/%d/%d",
+                                   engine->getDataRoot(), indexId_, part);
+    fs::FileUtils::remove(dir.c_str(), true);
+    if (!fs::FileUtils::makeDir(dir)) {
+        LOG(ERROR) << "Create " << dir << " failed";
+        return kvstore::ResultCode::ERR_IO_ERROR;
+    }
+    SCOPE_EXIT {
+        fs::FileUtils::remove(dir.c_str(), true);
+    };
+
+    auto start = NebulaKeyUtils::prefix(part);
+    auto end = NebulaKeyUtils::dataRangeEnd(part);
+    // Read the engine directly, followers rebuild from their local data as well
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto ret = engine->range(start, end, &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        LOG(ERROR) << "Scan Part " << part << " Failed";
+        return ret;
+    }
+
+    std::vector<std::string> keys;
+    std::vector<std::string> files;
+    auto flush = [&] () {
+        auto file = writeSstFile(dir, files.size(), keys);
+        if (!file.ok()) {
+            LOG(ERROR) << "Part " << part << ": " << file.status();
+            return kvstore::ResultCode::ERR_IO_ERROR;
+        }
+        files.emplace_back(std::move(file).value());
+        return kvstore::ResultCode::SUCCEEDED;
+    };
+    ret = buildIndexKeys(space, part, iter.get(), [&] (std::string key) {
+        keys.emplace_back(std::move(key));
+        if (keys.size() >= static_cast<size_t>(FLAGS_rebuild_index_sst_entries)) {
+            return flush();
+        }
+        return kvstore::ResultCode::SUCCEEDED;
+    });
+    if (ret == kvstore::ResultCode::SUCCEEDED && !keys.empty()) {
+        ret = flush();
+    }
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        return ret;
+    }
+
+    // The files of one part may overlap, so ingest them one by one
+    for (auto& file : files) {
+        ret = engine->ingest({file});
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            LOG(ERROR) << "Ingest " << file << " into Part " << part << " Failed";
+            return ret;
+        }
+    }
+    LOG(INFO) << "Rebuild index " << indexId_ << " of Part " << part
+              << " done, " << files.size() << " sst files ingested";
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+kvstore::ResultCode RebuildIndexProcessor::rebuildPartOnline(GraphSpaceID space,
+                                                             PartitionID part) {
+    auto partRet = kvstore_->part(space, part);
+    if (!ok(partRet)) {
+        LOG(ERROR) << "Space " << space << " Part " << part << " not found";
+        return error(partRet);
+    }
+    if (!value(partRet)->isLeader()) {
+        LOG(ERROR) << "Space " << space << " Part " << part << " is not led by this host";
+        return kvstore::ResultCode::ERR_LEADER_CHANGED;
+    }
+
+    // The index is known by this host already, so the writes from now on maintain it
+    // as well. The vertices written during the backfill are tracked, and reconciled
+    // after it, since the backfill may overwrite their index with a stale one.
+    auto& tracker = kvstore::DirtyVertexTracker::instance();
+    auto sessionId = tracker.start(space, part);
+    SCOPE_EXIT {
+        tracker.stop(space, part, sessionId);
+    };
+    // The logs committed after this empty one are all tracked
+    auto ret = doSyncPut(space, part, {});
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        LOG(ERROR) << "Start tracking Part " << part << " failed";
+        return ret;
+    }
+
+    ret = backfill(space, part);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        LOG(ERROR) << "Backfill index " << indexId_ << " of Part " << part << " failed";
+        return ret;
+    }
+    auto dirty = tracker.take(space, part, sessionId);
+    auto dirtyNum = dirty.size();
+    ret = catchUp(space, part, std::move(dirty));
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        LOG(ERROR) << "Catch up index " << indexId_ << " of Part " << part << " failed";
+        return ret;
+    }
+    LOG(INFO) << "Rebuild index " << indexId_ << " of Part " << part << " online done, "
+              << dirtyNum << " vertices written during the backfill reconciled";
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+kvstore::ResultCode RebuildIndexProcessor::backfill(GraphSpaceID space, PartitionID part) {
+    auto start = NebulaKeyUtils::prefix(part);
+    auto end = NebulaKeyUtils::dataRangeEnd(part);
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto ret = kvstore_->range(space, part, start, end, &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        LOG(ERROR) << "Scan Part " << part << " Failed";
+        return ret;
+    }
+
+    auto batchNum = static_cast<size_t>(std::max(1, FLAGS_rebuild_index_batch_num));
+    folly::DynamicTokenBucket bucket;
+    std::vector<kvstore::KV> data;
+    data.reserve(batchNum);
+    auto flush = [&] () {
+        if (FLAGS_rebuild_index_part_rate_limit > 0) {
+            double rate = FLAGS_rebuild_index_part_rate_limit;
+            bucket.consumeWithBorrowAndWait(data.size(), rate,
+                                            std::max(rate, static_cast<double>(data.size())));
+        }
+        auto code = doSyncPut(space, part, std::move(data));
+        data.clear();
+        return code;
+    };
+    ret = buildIndexKeys(space, part, iter.get(), [&] (std::string key) {
+        data.emplace_back(std::move(key), "");
+        if (data.size() >= batchNum) {
+            return flush();
+        }
+        return kvstore::ResultCode::SUCCEEDED;
+    });
+    if (ret == kvstore::ResultCode::SUCCEEDED && !data.empty()) {
+        ret = flush();
+    }
+    return ret;
+}
+
+kvstore::ResultCode RebuildIndexProcessor::catchUp(GraphSpaceID space,
+                                                   PartitionID part,
+                                                   std::unordered_set<VertexID> vIds) {
+    if (vIds.empty()) {
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+    // The current index entries of the vertices, some of them may be stale
+    std::unordered_map<VertexID, std::vector<std::string>> indexKeys;
+    auto prefix = NebulaKeyUtils::indexPrefix(part, indexId_);
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto ret = kvstore_->prefix(space, part, prefix, &iter);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        LOG(ERROR) << "Scan index " << indexId_ << " of Part " << part << " Failed";
+        return ret;
+    }
+    for (; iter->valid(); iter->next()) {
+        auto vId = indexOwner(iter->key());
+        if (vIds.count(vId) != 0) {
+            indexKeys[vId].emplace_back(iter->key().str());
+        }
+    }
+
+    auto batchNum = static_cast<size_t>(std::max(1, FLAGS_rebuild_index_batch_num));
+    std::vector<VertexID> batch;
+    batch.reserve(batchNum);
+    for (auto vId : vIds) {
+        batch.emplace_back(vId);
+        if (batch.size() >= batchNum) {
+            ret = reconcile(space, part, batch, indexKeys);
+            if (ret != kvstore::ResultCode::SUCCEEDED) {
+                return ret;
+            }
+            batch.clear();
+        }
+    }
+    if (!batch.empty()) {
+        ret = reconcile(space, part, batch, indexKeys);
+    }
+    return ret;
+}
+
+kvstore::ResultCode RebuildIndexProcessor::reconcile(
+        GraphSpaceID space,
+        PartitionID part,
+        const std::vector<VertexID>& vIds,
+        const std::unordered_map<VertexID, std::vector<std::string>>& indexKeys) {
+    folly::Baton<true, std::atomic> baton;
+    auto ret = kvstore::ResultCode::SUCCEEDED;
+    // Read the latest data and fix the index in one atomic op, so that no write
+    // of the vertices could get in between.
+    kvstore_->asyncAtomicOp(space, part, [&] () -> folly::Optional<std::string> {
+        kvstore::BatchHolder batchHolder;
+        for (auto vId : vIds) {
+            auto start = NebulaKeyUtils::vertexPrefix(part, vId);
+            auto end = NebulaKeyUtils::vertexRangeEnd(part, vId);
+            std::unique_ptr<kvstore::KVIterator> iter;
+            if (kvstore_->range(space, part, start, end, &iter)
+                    != kvstore::ResultCode::SUCCEEDED) {
+                return folly::none;
+            }
+            std::unordered_set<std::string> expected;
+            auto code = buildIndexKeys(space, part, iter.get(), [&] (std::string key) {
+                expected.emplace(std::move(key));
+                return kvstore::ResultCode::SUCCEEDED;
+            });
+            if (code != kvstore::ResultCode::SUCCEEDED) {
+                return folly::none;
+            }
+            auto it = indexKeys.find(vId);
+            if (it != indexKeys.end()) {
+                for (auto& key : it->second) {
+                    if (expected.count(key) == 0) {
+                        batchHolder.remove(std::string(key));
+                    }
+                }
+            }
+            for (auto& key : expected) {
+                batchHolder.put(std::string(key), "");
+            }
+        }
+        return encodeBatchValue(batchHolder.getBatch());
+    }, [&] (kvstore::ResultCode code) {
+        ret = code;
+        baton.post();
+    });
+    baton.wait();
+    return ret;
+}
+
+StatusOr<std::string> RebuildIndexProcessor::writeSstFile(const std::string& dir,
+                                                          int32_t seq,
+                                                          std::vector<std::string>& keys) {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    auto path = folly::stringPrintf("%s/%d.sst", dir.c_str(), seq);
+    rocksdb::Options options;
+    rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options);
+    auto s = writer.Open(path);
+    if (!s.ok()) {
+        return Status::Error("Open sst '%s' failed: %s", path.c_str(), s.ToString().c_str());
+    }
+    for (auto& key : keys) {
+        s = writer.Put(key, "");
+        if (!s.ok()) {
+            return Status::Error("Put failed: %s", s.ToString().c_str());
+        }
+    }
+    s = writer.Finish();
+    if (!s.ok()) {
+        return Status::Error("Finish sst '%s' failed: %s", path.c_str(), s.ToString().c_str());
+    }
+    keys.clear();
+    return path;
+}
+
+}  // namespace storage
+}  // namespace nebula
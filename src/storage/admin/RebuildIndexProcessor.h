@@ -0,0 +1,108 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_ADMIN_REBUILDINDEXPROCESSOR_H_
+#define STORAGE_ADMIN_REBUILDINDEXPROCESSOR_H_
+
+#include "kvstore/KVStore.h"
+#include "kvstore/KVIterator.h"
+#include "meta/SchemaManager.h"
+#include "meta/IndexManager.h"
+#include "storage/BaseProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Rebuild an index of the parts in request. The parts are rebuilt in parallel on
+ * the executor (one by one if there is none).
+ *
+ * Offline, each part is scanned locally, its index entries are sorted into sst files
+ * and ingested into the engine of the part, so nothing goes through raft and every
+ * replica must rebuild the part by itself.
+ *
+ * Online, the leader of the part backfills the index through raft while the writes
+ * go on, and maintain the index by themselves. Then the vertices written during the
+ * backfill are reconciled with atomic ops.
+ * */
+class RebuildIndexProcessor : public BaseProcessor<cpp2::AdminExecResp> {
+public:
+    void process(const cpp2::RebuildIndexRequest& req);
+
+protected:
+    using IndexKeyCallback = std::function<kvstore::ResultCode(std::string)>;
+
+    explicit RebuildIndexProcessor(kvstore::KVStore* kvstore,
+                                   meta::SchemaManager* schemaMan,
+                                   meta::IndexManager* indexMan,
+                                   folly::Executor* executor)
+            : BaseProcessor<cpp2::AdminExecResp>(kvstore, schemaMan, nullptr)
+            , indexMan_(indexMan)
+            , executor_(executor) {}
+
+    virtual StatusOr<std::shared_ptr<nebula::cpp2::IndexItem>>
+    getIndex(GraphSpaceID space, IndexID indexId) = 0;
+
+    /**
+     * Seek through the data of the part, and call cb with every index key built.
+     * */
+    virtual kvstore::ResultCode buildIndexKeys(GraphSpaceID space,
+                                               PartitionID part,
+                                               kvstore::KVIterator* iter,
+                                               const IndexKeyCallback& cb) = 0;
+
+    /**
+     * The vertex (src vertex for edge) which the index key points to.
+     * */
+    virtual VertexID indexOwner(folly::StringPiece indexKey) = 0;
+
+protected:
+    meta::IndexManager* indexMan_{nullptr};
+    std::shared_ptr<nebula::cpp2::IndexItem> item_;
+    IndexID indexId_ = -1;
+
+private:
+    kvstore::ResultCode rebuildPart(GraphSpaceID space, PartitionID part);
+
+    kvstore::ResultCode rebuildPartOnline(GraphSpaceID space, PartitionID part);
+
+    /**
+     * Scan the part and put the index entries in batches, throttled by
+     * rebuild_index_part_rate_limit.
+     * */
+    kvstore::ResultCode backfill(GraphSpaceID space, PartitionID part);
+
+    /**
+     * Reconcile the index of the vertices written since the tracking started.
+     * */
+    kvstore::ResultCode catchUp(GraphSpaceID space,
+                                PartitionID part,
+                                std::unordered_set<VertexID> vIds);
+
+    /**
+     * Rebuild the index entries of the vertices from their latest data, and remove
+     * the ones in indexKeys not rebuilt.
+     * */
+    kvstore::ResultCode reconcile(
+        GraphSpaceID space,
+        PartitionID part,
+        const std::vector<VertexID>& vIds,
+        const std::unordered_map<VertexID, std::vector<std::string>>& indexKeys);
+
+    /**
+     * Sort the keys and write them into a new sst file under dir.
+     * */
+    StatusOr<std::string> writeSstFile(const std::string& dir,
+                                       int32_t seq,
+                                       std::vector<std::string>& keys);
+
+private:
+    folly::Executor* executor_{nullptr};
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_ADMIN_REBUILDINDEXPROCESSOR_H_
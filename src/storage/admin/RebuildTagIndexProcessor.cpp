@@ -4,108 +4,52 @@
  * attached with Common Clause Condition 1.0, found in the LICENSES directory.
  */
 
-#include "kvstore/LogEncoder.h"
-#include "storage/StorageFlags.h"
 #include "storage/admin/RebuildTagIndexProcessor.h"
 
 namespace nebula {
 namespace storage {
 
-void RebuildTagIndexProcessor::process(const cpp2::RebuildIndexRequest& req) {
-    CHECK_NOTNULL(kvstore_);
-    auto space = req.get_space_id();
-    auto parts = req.get_parts();
-    auto indexID = req.get_index_id();
-    auto isOffline = req.get_is_offline();
-    auto itemRet = indexMan_->getTagIndex(space, indexID);
-    if (!itemRet.ok()) {
-        cpp2::ResultCode thriftRet;
-        thriftRet.set_code(cpp2::ErrorCode::E_INDEX_NOT_FOUND);
-        codes_.emplace_back(thriftRet);
-        onFinished();
-        return;
-    }
-
-    auto item = itemRet.value();
-    auto tagID = item->get_schema_id().get_tag_id();
-    LOG(INFO) << "Rebuild Tag Index Space " << space << " Tag ID " << tagID
-              << " Tag Index " << indexID;
-    for (PartitionID part : parts) {
-        if (isOffline) {
-            std::unique_ptr<kvstore::KVIterator> iter;
-            auto prefix = NebulaKeyUtils::prefix(part);
-            auto ret = kvstore_->prefix(space, part, prefix, &iter);
-            if (ret != kvstore::ResultCode::SUCCEEDED) {
-                LOG(ERROR) << "Processing Part " << part << " Failed";
-                this->pushResultCode(to(ret), part);
-                onFinished();
-                return;
-            }
+StatusOr<std::shared_ptr<nebula::cpp2::IndexItem>>
+RebuildTagIndexProcessor::getIndex(GraphSpaceID space, IndexID indexId) {
+    return indexMan_->getTagIndex(space, indexId);
+}
 
-            std::vector<kvstore::KV> data;
-            data.reserve(FLAGS_rebuild_index_batch_num);
-            int32_t batchNum = 0;
-            VertexID currentVertex = -1;
-            while (iter && iter->valid()) {
-                if (batchNum >= FLAGS_rebuild_index_batch_num) {
-                    auto result = doSyncPut(space, part, std::move(data));
-                    if (result != kvstore::ResultCode::SUCCEEDED) {
-                        LOG(ERROR) << "Write Part " << part << " Index Failed";
-                        this->pushResultCode(to(result), part);
-                        onFinished();
-                        return;
+kvstore::ResultCode RebuildTagIndexProcessor::buildIndexKeys(GraphSpaceID space,
+                                                             PartitionID part,
+                                                             kvstore::KVIterator* iter,
+                                                             const IndexKeyCallback& cb) {
+    auto tagId = item_->get_schema_id().get_tag_id();
+    // All tags and edges of a vertex are stored together, so seek to the tag of
+    // each vertex directly, and then skip the rest keys of the vertex.
+    while (iter->valid()) {
+        auto vId = NebulaKeyUtils::readInt<VertexID>(iter->key().data() + sizeof(PartitionID),
+                                                     sizeof(VertexID));
+        auto prefix = NebulaKeyUtils::vertexPrefix(part, vId, tagId);
+        iter->seek(prefix);
+        if (iter->valid() &&
+            iter->key().startsWith(prefix) &&
+            NebulaKeyUtils::isVertex(iter->key())) {
+            // Only the latest version, which comes first
+            auto reader = RowReader::getTagPropReader(schemaMan_, iter->val(), space, tagId);
+            if (reader != nullptr) {
+                auto values = collectIndexValues(reader.get(), item_->get_fields());
+                if (values.ok()) {
+                    auto ret = cb(NebulaKeyUtils::vertexIndexKey(part, indexId_,
+                                                                 vId, values.value()));
+                    if (ret != kvstore::ResultCode::SUCCEEDED) {
+                        return ret;
                     }
-
-                    data.reserve(FLAGS_rebuild_index_batch_num);
-                    batchNum = 0;
-                }
-
-                auto key = iter->key();
-                auto val = iter->val();
-                if (!NebulaKeyUtils::isVertex(key) ||
-                    NebulaKeyUtils::getTagId(key) != tagID) {
-                    iter->next();
-                    continue;
-                }
-
-                auto vertex = NebulaKeyUtils::getVertexId(key);
-                if (currentVertex == vertex) {
-                    iter->next();
-                    continue;
-                } else {
-                    currentVertex = vertex;
-                }
-                auto reader = RowReader::getTagPropReader(schemaMan_,
-                                                          std::move(val),
-                                                          space,
-                                                          tagID);
-                if (reader == nullptr) {
-                    iter->next();
-                    continue;
                 }
-                auto values = collectIndexValues(reader.get(), item->get_fields());
-                if (!values.ok()) {
-                    continue;
-                }
-                auto indexKey = NebulaKeyUtils::vertexIndexKey(part, indexID,
-                                                               vertex, values.value());
-                data.emplace_back(std::move(indexKey), "");
-                batchNum += 1;
-                iter->next();
-            }
-
-            auto result = doSyncPut(space, part, std::move(data));
-            if (result != kvstore::ResultCode::SUCCEEDED) {
-                LOG(ERROR) << "Write Part " << part << " Index Failed";
-                this->pushResultCode(to(result), part);
             }
-        } else {
-            // TODO darion Support online rebuild index
         }
+        iter->seek(NebulaKeyUtils::vertexRangeEnd(part, vId));
     }
-    onFinished();
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+VertexID RebuildTagIndexProcessor::indexOwner(folly::StringPiece indexKey) {
+    return NebulaKeyUtils::getIndexVertexID(indexKey);
 }
 
 }  // namespace storage
 }  // namespace nebula
-
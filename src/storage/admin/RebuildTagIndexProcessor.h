@@ -7,38 +7,36 @@
 #ifndef STORAGE_ADMIN_REBUILDTAGINDEXPROCESSOR_H_
 #define STORAGE_ADMIN_REBUILDTAGINDEXPROCESSOR_H_
 
-#include "kvstore/KVStore.h"
-#include "kvstore/KVIterator.h"
-#include "meta/SchemaManager.h"
-#include "storage/BaseProcessor.h"
+#include "storage/admin/RebuildIndexProcessor.h"
 
 namespace nebula {
 namespace storage {
 
-class RebuildTagIndexProcessor : public BaseProcessor<cpp2::AdminExecResp> {
+class RebuildTagIndexProcessor : public RebuildIndexProcessor {
 public:
     static RebuildTagIndexProcessor* instance(kvstore::KVStore* kvstore,
                                               meta::SchemaManager* schemaMan,
-                                              meta::IndexManager* indexMan) {
-        return new RebuildTagIndexProcessor(kvstore, schemaMan, indexMan);
+                                              meta::IndexManager* indexMan,
+                                              folly::Executor* executor = nullptr) {
+        return new RebuildTagIndexProcessor(kvstore, schemaMan, indexMan, executor);
     }
 
-    void process(const cpp2::RebuildIndexRequest& req);
-
 private:
     explicit RebuildTagIndexProcessor(kvstore::KVStore* kvstore,
                                       meta::SchemaManager* schemaMan,
-                                      meta::IndexManager* indexMan)
-            : BaseProcessor<cpp2::AdminExecResp>(kvstore, schemaMan, nullptr)
-            , indexMan_(indexMan) {}
+                                      meta::IndexManager* indexMan,
+                                      folly::Executor* executor)
+            : RebuildIndexProcessor(kvstore, schemaMan, indexMan, executor) {}
 
-    std::string partitionRebuildIndex(GraphSpaceID space,
-                                      PartitionID part,
-                                      TagID tag,
-                                      std::shared_ptr<nebula::cpp2::IndexItem> item);
+    StatusOr<std::shared_ptr<nebula::cpp2::IndexItem>>
+    getIndex(GraphSpaceID space, IndexID indexId) override;
 
-private:
-    meta::IndexManager* indexMan_{nullptr};
+    kvstore::ResultCode buildIndexKeys(GraphSpaceID space,
+                                       PartitionID part,
+                                       kvstore::KVIterator* iter,
+                                       const IndexKeyCallback& cb) override;
+
+    VertexID indexOwner(folly::StringPiece indexKey) override;
 };
 
 }  // namespace storage
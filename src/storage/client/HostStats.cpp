@@ -0,0 +1,95 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "storage/client/HostStats.h"
+
+namespace nebula {
+namespace storage {
+
+// The weight of the latest latency in the moving average, in 1/8
+static constexpr int64_t kLatencyWeight = 1;
+
+// static
+HostStats& HostStats::instance() {
+    static HostStats stats;
+    return stats;
+}
+
+std::shared_ptr<HostStats::Entry> HostStats::entry(const HostAddr& host) {
+    {
+        auto hosts = hosts_.rlock();
+        auto it = hosts->find(host);
+        if (it != hosts->end()) {
+            return it->second;
+        }
+    }
+    auto hosts = hosts_.wlock();
+    auto& e = (*hosts)[host];
+    if (e == nullptr) {
+        e = std::make_shared<Entry>();
+    }
+    return e;
+}
+
+void HostStats::start(const HostAddr& host) {
+    auto e = entry(host);
+    e->inflight++;
+    e->requests++;
+}
+
+void HostStats::finish(const HostAddr& host, int64_t latencyUs, bool succeeded) {
+    auto e = entry(host);
+    e->inflight--;
+    if (!succeeded) {
+        e->failures++;
+    }
+    auto old = e->latencyUs.load();
+    int64_t avg;
+    do {
+        avg = old == 0 ? latencyUs : (old * (8 - kLatencyWeight) + latencyUs * kLatencyWeight) / 8;
+    } while (!e->latencyUs.compare_exchange_weak(old, avg));
+}
+
+void HostStats::hedge(const HostAddr& host) {
+    entry(host)->hedges++;
+}
+
+void HostStats::timeout(const HostAddr& host) {
+    entry(host)->timeouts++;
+}
+
+int64_t HostStats::load(const HostAddr& host) const {
+    auto hosts = hosts_.rlock();
+    auto it = hosts->find(host);
+    if (it == hosts->end()) {
+        return 0;
+    }
+    auto& e = it->second;
+    return e->latencyUs.load() * (e->inflight.load() + 1);
+}
+
+std::vector<HostStats::Snapshot> HostStats::snapshot() const {
+    std::vector<Snapshot> result;
+    auto hosts = hosts_.rlock();
+    for (auto& h : *hosts) {
+        auto& e = h.second;
+        result.emplace_back(Snapshot{h.first,
+                                     e->inflight.load(),
+                                     e->latencyUs.load(),
+                                     e->requests.load(),
+                                     e->failures.load(),
+                                     e->hedges.load(),
+                                     e->timeouts.load()});
+    }
+    return result;
+}
+
+void HostStats::clear() {
+    hosts_.wlock()->clear();
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,74 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_CLIENT_HOSTSTATS_H_
+#define STORAGE_CLIENT_HOSTSTATS_H_
+
+#include "base/Base.h"
+#include <folly/Synchronized.h>
+
+namespace nebula {
+namespace storage {
+
+/**
+ * The load of every storage host seen by the storage clients in the process, i.e.
+ * the requests in flight and the moving average of the latency. It is used to pick
+ * the replica to read from, and exported by the graphd web service.
+ * */
+class HostStats final {
+public:
+    struct Snapshot {
+        HostAddr host;
+        int64_t inflight;
+        int64_t latencyUs;
+        int64_t requests;
+        int64_t failures;
+        int64_t hedges;
+        int64_t timeouts;
+    };
+
+    static HostStats& instance();
+
+    void start(const HostAddr& host);
+
+    // The failed requests count too, a host which times out is surely slow
+    void finish(const HostAddr& host, int64_t latencyUs, bool succeeded);
+
+    // A request to the host is re-issued to another replica
+    void hedge(const HostAddr& host);
+
+    // A request to the host is given up, and the partial result is returned
+    void timeout(const HostAddr& host);
+
+    /**
+     * The expected latency of one more request to the host, the less the better.
+     * It is 0 for the host never requested.
+     * */
+    int64_t load(const HostAddr& host) const;
+
+    std::vector<Snapshot> snapshot() const;
+
+    void clear();
+
+private:
+    struct Entry {
+        std::atomic<int64_t> inflight{0};
+        std::atomic<int64_t> latencyUs{0};
+        std::atomic<int64_t> requests{0};
+        std::atomic<int64_t> failures{0};
+        std::atomic<int64_t> hedges{0};
+        std::atomic<int64_t> timeouts{0};
+    };
+
+    std::shared_ptr<Entry> entry(const HostAddr& host);
+
+private:
+    folly::Synchronized<std::unordered_map<HostAddr, std::shared_ptr<Entry>>> hosts_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_CLIENT_HOSTSTATS_H_
@@ -0,0 +1,221 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_CLIENT_REQUESTCOALESCER_H_
+#define STORAGE_CLIENT_REQUESTCOALESCER_H_
+
+#include "base/Base.h"
+#include <folly/futures/Future.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include "gen-cpp2/storage_types.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Merge the concurrent requests to the same host into one, if all their fields but
+ * the parts are the same. A merged request is sent once it has maxVertices vertices,
+ * or the window since its first request has passed. The vertex ids are deduplicated,
+ * and every request gets the part of the merged response about its own vertices.
+ *
+ * It works for the requests of parts => vertex ids, which are answered by a
+ * QueryResponse, i.e. getBound and getProps.
+ * */
+template <class Request>
+class RequestCoalescer final {
+public:
+    using Response = cpp2::QueryResponse;
+    using SendFunc = std::function<folly::Future<Response>(const HostAddr&, const Request&)>;
+
+    RequestCoalescer(SendFunc send, int32_t windowUs, size_t maxVertices)
+        : send_(std::move(send))
+        , window_(windowUs)
+        , maxVertices_(std::max<size_t>(1, maxVertices)) {
+        flusher_ = std::thread([this] () { loop(); });
+    }
+
+    ~RequestCoalescer() {
+        decltype(batches_) batches;
+        {
+            std::lock_guard<std::mutex> g(lock_);
+            stopped_ = true;
+            batches.swap(batches_);
+        }
+        cond_.notify_one();
+        flusher_.join();
+        for (auto& batch : batches) {
+            for (auto& waiter : batch.second->waiters) {
+                waiter.promise.setException(std::runtime_error("Storage client stopped"));
+            }
+        }
+    }
+
+    folly::Future<Response> submit(const HostAddr& host, const Request& req) {
+        Waiter waiter;
+        waiter.parts = req.get_parts();
+        auto future = waiter.promise.getFuture();
+
+        auto key = std::make_pair(host, compatibleKey(req));
+        std::shared_ptr<Batch> full;
+        {
+            std::lock_guard<std::mutex> g(lock_);
+            auto it = batches_.find(key);
+            if (it == batches_.end()) {
+                auto batch = std::make_shared<Batch>();
+                batch->host = host;
+                batch->req = req;
+                batch->req.parts.clear();
+                batch->deadline = std::chrono::steady_clock::now() + window_;
+                it = batches_.emplace(key, std::move(batch)).first;
+                cond_.notify_one();
+            }
+            auto& batch = it->second;
+            for (auto& part : waiter.parts) {
+                auto& vIds = batch->req.parts[part.first];
+                for (auto vId : part.second) {
+                    if (batch->vIds.emplace(vId).second) {
+                        vIds.emplace_back(vId);
+                    }
+                }
+            }
+            batch->waiters.emplace_back(std::move(waiter));
+            if (batch->vIds.size() >= maxVertices_) {
+                full = std::move(batch);
+                batches_.erase(it);
+            }
+        }
+        if (full != nullptr) {
+            flush(std::move(full));
+        }
+        return future;
+    }
+
+private:
+    struct Waiter {
+        folly::Promise<Response> promise;
+        std::unordered_map<PartitionID, std::vector<VertexID>> parts;
+    };
+
+    struct Batch {
+        HostAddr host;
+        Request req;
+        std::unordered_set<VertexID> vIds;
+        std::vector<Waiter> waiters;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    // All fields but the parts
+    static std::string compatibleKey(const Request& req) {
+        auto copy = req;
+        copy.parts.clear();
+        std::string key;
+        apache::thrift::CompactSerializer::serialize(copy, &key);
+        return key;
+    }
+
+    void loop() {
+        std::unique_lock<std::mutex> l(lock_);
+        while (!stopped_) {
+            if (batches_.empty()) {
+                cond_.wait(l);
+                continue;
+            }
+            auto now = std::chrono::steady_clock::now();
+            auto next = std::chrono::steady_clock::time_point::max();
+            std::vector<std::shared_ptr<Batch>> due;
+            for (auto it = batches_.begin(); it != batches_.end();) {
+                if (it->second->deadline <= now) {
+                    due.emplace_back(std::move(it->second));
+                    it = batches_.erase(it);
+                } else {
+                    next = std::min(next, it->second->deadline);
+                    ++it;
+                }
+            }
+            if (due.empty()) {
+                cond_.wait_until(l, next);
+                continue;
+            }
+            l.unlock();
+            for (auto& batch : due) {
+                flush(std::move(batch));
+            }
+            l.lock();
+        }
+    }
+
+    void flush(std::shared_ptr<Batch> batch) {
+        VLOG(3) << "Send " << batch->waiters.size() << " requests of "
+                << batch->vIds.size() << " vertices to " << batch->host << " in one";
+        send_(batch->host, batch->req).thenTry([batch] (folly::Try<Response>&& t) {
+            for (auto& waiter : batch->waiters) {
+                if (t.hasException()) {
+                    waiter.promise.setException(t.exception());
+                } else {
+                    waiter.promise.setValue(split(t.value(), waiter.parts));
+                }
+            }
+        });
+    }
+
+    // The response about the vertices in parts
+    static Response split(const Response& resp,
+                          const std::unordered_map<PartitionID, std::vector<VertexID>>& parts) {
+        Response result;
+        cpp2::ResponseCommon common;
+        common.set_latency_in_us(resp.get_result().get_latency_in_us());
+        std::vector<cpp2::ResultCode> failedCodes;
+        for (auto& code : resp.get_result().get_failed_codes()) {
+            if (parts.count(code.get_part_id()) != 0) {
+                failedCodes.emplace_back(code);
+            }
+        }
+        common.set_failed_codes(std::move(failedCodes));
+        result.set_result(std::move(common));
+        if (resp.__isset.vertex_schema) {
+            result.set_vertex_schema(resp.vertex_schema);
+        }
+        if (resp.__isset.edge_schema) {
+            result.set_edge_schema(resp.edge_schema);
+        }
+        if (resp.__isset.vertices) {
+            std::unordered_set<VertexID> vIds;
+            for (auto& part : parts) {
+                vIds.insert(part.second.begin(), part.second.end());
+            }
+            std::vector<cpp2::VertexData> vertices;
+            int32_t totalEdges = 0;
+            for (auto& vertex : resp.vertices) {
+                if (vIds.count(vertex.get_vertex_id()) == 0) {
+                    continue;
+                }
+                for (auto& edata : vertex.get_edge_data()) {
+                    totalEdges += edata.get_edges().size();
+                }
+                vertices.emplace_back(vertex);
+            }
+            result.set_vertices(std::move(vertices));
+            if (resp.__isset.total_edges) {
+                result.set_total_edges(totalEdges);
+            }
+        }
+        return result;
+    }
+
+private:
+    SendFunc send_;
+    std::chrono::microseconds window_;
+    size_t maxVertices_;
+    std::mutex lock_;
+    std::condition_variable cond_;
+    std::map<std::pair<HostAddr, std::string>, std::shared_ptr<Batch>> batches_;
+    bool stopped_{false};
+    std::thread flusher_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_CLIENT_REQUESTCOALESCER_H_
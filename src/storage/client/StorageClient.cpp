@@ -8,6 +8,20 @@
 #include "storage/client/StorageClient.h"
 
 DEFINE_int32(storage_client_timeout_ms, 60 * 1000, "storage client timeout");
+DEFINE_int32(storage_client_coalesce_window_us, 0,
+             "Merge the concurrent getNeighbors and getVertexProps requests to the same "
+             "storage host within the window into one, 0 means disabled");
+DEFINE_int32(storage_client_coalesce_max_vertices, 1024,
+             "A merged request is sent at once when it has so many vertices");
+DEFINE_bool(storage_client_read_from_followers, false,
+            "Send the reads to the replica with the least load rather than the leader, "
+            "which requires storaged to run with --check_leader=false");
+DEFINE_int32(storage_client_hedge_delay_ms, 0,
+             "Re-issue a read to another replica if no response comes in so long, "
+             "which requires storage_client_read_from_followers, 0 means disabled");
+DEFINE_int32(storage_client_read_deadline_ms, 0,
+             "Return the partial result of a read if some hosts give no response in so long, "
+             "the parts on them are failed, 0 means disabled");
 
 namespace nebula {
 namespace storage {
@@ -20,6 +34,30 @@ StorageClient::StorageClient(std::shared_ptr<folly::IOThreadPoolExecutor> thread
     clientsMan_
         = std::make_unique<thrift::ThriftClientManager<storage::cpp2::StorageServiceAsyncClient>>();
     stats_ = std::make_unique<stats::Stats>(serviceName, "storageClient");
+    if (FLAGS_storage_client_coalesce_window_us > 0) {
+        boundCoalescer_ = std::make_unique<RequestCoalescer<cpp2::GetNeighborsRequest>>(
+            [this] (const HostAddr& host, const cpp2::GetNeighborsRequest& req) {
+                auto* evb = ioThreadPool_->getEventBase();
+                return folly::via(evb, [this, evb, host, req] () {
+                    auto client = clientsMan_->client(host, evb, false,
+                                                      FLAGS_storage_client_timeout_ms);
+                    return client->future_getBound(req);
+                });
+            },
+            FLAGS_storage_client_coalesce_window_us,
+            FLAGS_storage_client_coalesce_max_vertices);
+        propsCoalescer_ = std::make_unique<RequestCoalescer<cpp2::VertexPropRequest>>(
+            [this] (const HostAddr& host, const cpp2::VertexPropRequest& req) {
+                auto* evb = ioThreadPool_->getEventBase();
+                return folly::via(evb, [this, evb, host, req] () {
+                    auto client = clientsMan_->client(host, evb, false,
+                                                      FLAGS_storage_client_timeout_ms);
+                    return client->future_getProps(req);
+                });
+            },
+            FLAGS_storage_client_coalesce_window_us,
+            FLAGS_storage_client_coalesce_max_vertices);
+    }
 }
 
 
@@ -31,6 +69,68 @@ StorageClient::~StorageClient() {
 }
 
 
+const HostAddr StorageClient::readHost(const PartMeta& partMeta) const {
+    auto host = this->leader(partMeta);
+    if (!FLAGS_storage_client_read_from_followers) {
+        return host;
+    }
+    auto& stats = HostStats::instance();
+    auto minLoad = stats.load(host);
+    for (auto& peer : partMeta.peers_) {
+        auto load = stats.load(peer);
+        if (load < minLoad) {
+            host = peer;
+            minLoad = load;
+        }
+    }
+    return host;
+}
+
+
+StatusOr<HostAddr> StorageClient::hedgeHost(GraphSpaceID spaceId,
+                                            const HostAddr& host,
+                                            const std::vector<PartitionID>& parts) const {
+    if (!FLAGS_storage_client_read_from_followers || parts.empty()) {
+        return Status::Error("No replica to hedge to");
+    }
+    // The replicas of all the parts
+    std::vector<HostAddr> candidates;
+    for (auto i = 0U; i < parts.size(); i++) {
+        auto metaStatus = getPartMeta(spaceId, parts[i]);
+        if (!metaStatus.ok()) {
+            return metaStatus.status();
+        }
+        auto peers = std::move(metaStatus).value().peers_;
+        if (i == 0) {
+            candidates = std::move(peers);
+            continue;
+        }
+        auto it = std::remove_if(candidates.begin(), candidates.end(),
+                                 [&peers] (const HostAddr& h) {
+            return std::find(peers.begin(), peers.end(), h) == peers.end();
+        });
+        candidates.erase(it, candidates.end());
+    }
+    auto& stats = HostStats::instance();
+    HostAddr best(0, 0);
+    int64_t minLoad = std::numeric_limits<int64_t>::max();
+    for (auto& candidate : candidates) {
+        if (candidate == host) {
+            continue;
+        }
+        auto load = stats.load(candidate);
+        if (load < minLoad) {
+            best = candidate;
+            minLoad = load;
+        }
+    }
+    if (best == HostAddr(0, 0)) {
+        return Status::Error("No replica to hedge to");
+    }
+    return best;
+}
+
+
 folly::SemiFuture<StorageRpcResponse<cpp2::ExecResponse>> StorageClient::addVertices(
         GraphSpaceID space,
         std::vector<cpp2::Vertex> vertices,
@@ -107,8 +207,10 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getNei
         const std::vector<EdgeType> &edgeTypes,
         std::string filter,
         std::vector<cpp2::PropDef> returnCols,
+        int64_t limit,
+        bool random,
         folly::EventBase* evb) {
-    auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; });
+    auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; }, true);
 
     if (!status.ok()) {
         return folly::makeFuture<StorageRpcResponse<cpp2::QueryResponse>>(
@@ -126,6 +228,10 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getNei
         req.set_edge_types(edgeTypes);
         req.set_filter(filter);
         req.set_return_columns(returnCols);
+        if (limit >= 0) {
+            req.set_limit(limit);
+            req.set_random(random);
+        }
     }
 
     return collectResponse(
@@ -135,9 +241,68 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getNei
         [](const std::pair<const PartitionID,
                            std::vector<VertexID>>& p) {
             return p.first;
+        },
+        boundCoalescer_.get(),
+        true);
+}
+
+
+folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::traverse(
+        GraphSpaceID space,
+        const std::vector<VertexID> &vertices,
+        const std::vector<EdgeType> &edgeTypes,
+        std::string filter,
+        std::vector<cpp2::PropDef> returnCols,
+        int32_t steps,
+        folly::EventBase* evb) {
+    auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; });
+
+    if (!status.ok()) {
+        return folly::makeFuture<StorageRpcResponse<cpp2::QueryResponse>>(
+            std::runtime_error(status.status().toString()));
+    }
+
+    auto& clusters = status.value();
+
+    std::unordered_map<HostAddr, cpp2::GetNeighborsRequest> requests;
+    for (auto& c : clusters) {
+        auto& host = c.first;
+        auto& req = requests[host];
+        req.set_space_id(space);
+        req.set_parts(std::move(c.second));
+        req.set_edge_types(edgeTypes);
+        req.set_filter(filter);
+        req.set_return_columns(returnCols);
+        req.set_steps(steps);
+    }
+
+    return collectResponse(
+        evb, std::move(requests),
+        [](cpp2::StorageServiceAsyncClient* client, const cpp2::GetNeighborsRequest& r) {
+            return client->future_traverse(r); },
+        [](const std::pair<const PartitionID,
+                           std::vector<VertexID>>& p) {
+            return p.first;
         });
 }
 
+StatusOr<std::unordered_map<HostAddr, std::vector<VertexID>>> StorageClient::groupByHost(
+        GraphSpaceID space,
+        const std::vector<VertexID> &vertices) const {
+    auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; });
+    if (!status.ok()) {
+        return status.status();
+    }
+    std::unordered_map<HostAddr, std::vector<VertexID>> hosts;
+    for (auto& c : status.value()) {
+        auto& ids = hosts[c.first];
+        for (auto& part : c.second) {
+            ids.insert(ids.end(), part.second.begin(), part.second.end());
+        }
+    }
+    return hosts;
+}
+
 
 folly::SemiFuture<StorageRpcResponse<cpp2::QueryStatsResponse>> StorageClient::neighborStats(
         GraphSpaceID space,
@@ -146,7 +311,7 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryStatsResponse>> StorageClient::n
         std::string filter,
         std::vector<cpp2::PropDef> returnCols,
         folly::EventBase* evb) {
-    auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; });
+    auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; }, true);
 
     if (!status.ok()) {
         return folly::makeFuture<StorageRpcResponse<cpp2::QueryStatsResponse>>(
@@ -173,7 +338,9 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryStatsResponse>> StorageClient::n
         [](const std::pair<const PartitionID,
                            std::vector<VertexID>>& p) {
             return p.first;
-        });
+        },
+        nullptr,
+        true);
 }
 
 
@@ -182,7 +349,7 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getVer
         std::vector<VertexID> vertices,
         std::vector<cpp2::PropDef> returnCols,
         folly::EventBase* evb) {
-    auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; });
+    auto status = clusterIdsToHosts(space, vertices, [](const VertexID& v) { return v; }, true);
 
     if (!status.ok()) {
         return folly::makeFuture<StorageRpcResponse<cpp2::QueryResponse>>(
@@ -207,7 +374,9 @@ folly::SemiFuture<StorageRpcResponse<cpp2::QueryResponse>> StorageClient::getVer
         [](const std::pair<const PartitionID,
                            std::vector<VertexID>>& p) {
             return p.first;
-        });
+        },
+        propsCoalescer_.get(),
+        true);
 }
 
 
@@ -217,7 +386,7 @@ folly::SemiFuture<StorageRpcResponse<cpp2::EdgePropResponse>> StorageClient::get
         std::vector<cpp2::PropDef> returnCols,
         folly::EventBase* evb) {
     auto status =
-        clusterIdsToHosts(space, edges, [](const cpp2::EdgeKey& v) { return v.get_src(); });
+        clusterIdsToHosts(space, edges, [](const cpp2::EdgeKey& v) { return v.get_src(); }, true);
 
     if (!status.ok()) {
         return folly::makeFuture<StorageRpcResponse<cpp2::EdgePropResponse>>(
@@ -245,7 +414,9 @@ folly::SemiFuture<StorageRpcResponse<cpp2::EdgePropResponse>> StorageClient::get
             return client->future_getEdgeProps(r); },
         [](const std::pair<const PartitionID, std::vector<cpp2::EdgeKey>>& p) {
             return p.first;
-        });
+        },
+        nullptr,
+        true);
 }
 
 folly::SemiFuture<StorageRpcResponse<cpp2::ExecResponse>> StorageClient::deleteEdges(
@@ -436,6 +607,37 @@ folly::Future<StatusOr<cpp2::GetUUIDResp>> StorageClient::getUUID(
     });
 }
 
+folly::SemiFuture<StorageRpcResponse<cpp2::GetUUIDsResp>> StorageClient::getUUIDs(
+        GraphSpaceID space,
+        std::vector<std::string> names,
+        folly::EventBase* evb) {
+    // The same part as getUUID
+    auto status = clusterIdsToHosts(space, std::move(names), [] (const std::string& name) {
+        return std::hash<std::string>()(name);
+    });
+    if (!status.ok()) {
+        return folly::makeFuture<StorageRpcResponse<cpp2::GetUUIDsResp>>(
+            std::runtime_error(status.status().toString()));
+    }
+
+    auto& clusters = status.value();
+    std::unordered_map<HostAddr, cpp2::GetUUIDsReq> requests;
+    for (auto& c : clusters) {
+        auto& req = requests[c.first];
+        req.set_space_id(space);
+        req.set_parts(std::move(c.second));
+    }
+
+    return collectResponse(
+        evb, std::move(requests),
+        [] (cpp2::StorageServiceAsyncClient* client,
+            const cpp2::GetUUIDsReq& r) {
+            return client->future_getUUIDs(r); },
+        [] (const std::pair<const PartitionID, std::vector<std::string>>& p) {
+            return p.first;
+        });
+}
+
 StatusOr<PartitionID> StorageClient::partId(GraphSpaceID spaceId, int64_t id) const {
     auto status = partsNum(spaceId);
     if (!status.ok()) {
@@ -519,6 +721,8 @@ StorageClient::lookUpIndex(GraphSpaceID space,
                            std::string filter,
                            std::vector<std::string> returnCols,
                            bool isEdge,
+                           std::vector<storage::cpp2::IndexQueryContext> contexts,
+                           bool isUnion,
                            folly::EventBase *evb) {
     auto status = getHostParts(space);
     if (!status.ok()) {
@@ -536,6 +740,8 @@ StorageClient::lookUpIndex(GraphSpaceID space,
         req.set_filter(filter);
         req.set_return_columns(returnCols);
         req.set_is_edge(isEdge);
+        req.set_contexts(contexts);
+        req.set_is_union(isUnion);
     }
     return collectResponse(evb, std::move(requests),
                            [](cpp2::StorageServiceAsyncClient* client,
@@ -14,6 +14,8 @@
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include "gen-cpp2/StorageServiceAsyncClient.h"
 #include "meta/client/MetaClient.h"
+#include "storage/client/HostStats.h"
+#include "storage/client/RequestCoalescer.h"
 #include "thrift/ThriftClientManager.h"
 #include "stats/Stats.h"
 
@@ -121,14 +123,36 @@ public:
         bool overwritable,
         folly::EventBase* evb = nullptr);
 
+    // At most `limit` edges of each edge type are returned for one vertex,
+    // they are picked by sampling if `random' is true. No limit when it's negative.
     folly::SemiFuture<StorageRpcResponse<storage::cpp2::QueryResponse>> getNeighbors(
         GraphSpaceID space,
         const std::vector<VertexID> &vertices,
         const std::vector<EdgeType> &edgeTypes,
         std::string filter,
         std::vector<storage::cpp2::PropDef> returnCols,
+        int64_t limit = -1,
+        bool random = false,
         folly::EventBase* evb = nullptr);
 
+    // Go `steps` hops from the vertices, the hops out of the vertices co-located with
+    // their source are expanded on storage. The rows of the last hop are returned, along
+    // with the frontiers which are left to the caller.
+    folly::SemiFuture<StorageRpcResponse<storage::cpp2::QueryResponse>> traverse(
+        GraphSpaceID space,
+        const std::vector<VertexID> &vertices,
+        const std::vector<EdgeType> &edgeTypes,
+        std::string filter,
+        std::vector<storage::cpp2::PropDef> returnCols,
+        int32_t steps,
+        folly::EventBase* evb = nullptr);
+
+    // Group the vertices by the leader of their parts, so that the caller could send
+    // and handle the request of each host on its own.
+    StatusOr<std::unordered_map<HostAddr, std::vector<VertexID>>> groupByHost(
+        GraphSpaceID space,
+        const std::vector<VertexID> &vertices) const;
+
     folly::SemiFuture<StorageRpcResponse<storage::cpp2::QueryStatsResponse>> neighborStats(
         GraphSpaceID space,
         std::vector<VertexID> vertices,
@@ -182,12 +206,22 @@ public:
         const std::string& name,
         folly::EventBase* evb = nullptr);
 
+    /**
+     * Get the ids of the names, in one request per host.
+     * */
+    folly::SemiFuture<StorageRpcResponse<cpp2::GetUUIDsResp>> getUUIDs(
+        GraphSpaceID space,
+        std::vector<std::string> names,
+        folly::EventBase* evb = nullptr);
+
     folly::SemiFuture<StorageRpcResponse<storage::cpp2::LookUpIndexResp>> lookUpIndex(
         GraphSpaceID space,
         IndexID indexId,
         std::string filter,
         std::vector<std::string> returnCols,
         bool isEdge,
+        std::vector<storage::cpp2::IndexQueryContext> contexts = {},
+        bool isUnion = false,
         folly::EventBase *evb = nullptr);
 
 protected:
@@ -227,19 +261,34 @@ protected:
         }
     }
 
+    // The read replica of the part, it is the one with the least load when the followers
+    // could serve the reads, otherwise the leader.
+    const HostAddr readHost(const PartMeta& partMeta) const;
+
+    // The replica of all the parts, other than the host, to re-issue a slow read to
+    StatusOr<HostAddr> hedgeHost(GraphSpaceID spaceId,
+                                 const HostAddr& host,
+                                 const std::vector<PartitionID>& parts) const;
+
+    // The requests are merged with the concurrent ones by the coalescer if given.
+    // A read to a slow host is re-issued to another replica, or given up with the
+    // partial result returned, as configured.
     template<class Request,
              class RemoteFunc,
              class GetPartIDFunc,
              class Response =
                 typename std::result_of<
                     RemoteFunc(storage::cpp2::StorageServiceAsyncClient*, const Request&)
-                >::type::value_type
+                >::type::value_type,
+             class Coalescer = std::nullptr_t
             >
     folly::SemiFuture<StorageRpcResponse<Response>> collectResponse(
         folly::EventBase* evb,
         std::unordered_map<HostAddr, Request> requests,
         RemoteFunc&& remoteFunc,
-        GetPartIDFunc getPartIDFunc);
+        GetPartIDFunc getPartIDFunc,
+        Coalescer coalescer = nullptr,
+        bool read = false);
 
     template<class Request,
              class RemoteFunc,
@@ -257,13 +306,14 @@ protected:
     // The method returns a map
     //  host_addr (A host, but in most case, the leader will be chosen)
     //      => (partition -> [ids that belong to the shard])
+    // The hosts are chosen by readHost() for the reads.
     template<class Container, class GetIdFunc>
     StatusOr<std::unordered_map<HostAddr,
                        std::unordered_map<PartitionID,
                                           std::vector<typename Container::value_type>
                                          >
                       >>
-    clusterIdsToHosts(GraphSpaceID spaceId, Container ids, GetIdFunc f) const {
+    clusterIdsToHosts(GraphSpaceID spaceId, Container ids, GetIdFunc f, bool read = false) const {
         std::unordered_map<HostAddr,
                            std::unordered_map<PartitionID,
                                               std::vector<typename Container::value_type>
@@ -283,8 +333,8 @@ protected:
 
             auto partMeta = metaStatus.value();
             CHECK_GT(partMeta.peers_.size(), 0U);
-            const auto leader = this->leader(partMeta);
-            clusters[leader][part].emplace_back(std::move(id));
+            const auto host = read ? readHost(partMeta) : this->leader(partMeta);
+            clusters[host][part].emplace_back(std::move(id));
         }
         return clusters;
     }
@@ -348,6 +398,9 @@ private:
     mutable std::atomic_bool loadLeaderBefore_{false};
     mutable std::atomic_bool isLoadingLeader_{false};
     std::unique_ptr<stats::Stats> stats_;
+    // Only created when storage_client_coalesce_window_us is positive
+    std::unique_ptr<RequestCoalescer<storage::cpp2::GetNeighborsRequest>> boundCoalescer_;
+    std::unique_ptr<RequestCoalescer<storage::cpp2::VertexPropRequest>> propsCoalescer_;
 };
 }   // namespace storage
 }   // namespace nebula
@@ -10,6 +10,8 @@
 #include <folly/Try.h>
 
 DECLARE_int32(storage_client_timeout_ms);
+DECLARE_int32(storage_client_hedge_delay_ms);
+DECLARE_int32(storage_client_read_deadline_ms);
 
 namespace nebula {
 namespace storage {
@@ -48,6 +50,25 @@ public:
         return it->second;
     }
 
+    // Give up the ongoing requests and return their hosts, nothing if all processed
+    std::vector<HostAddr> expire() {
+        std::lock_guard<std::mutex> g(lock_);
+        std::vector<HostAddr> hosts;
+        if (fulfilled_) {
+            return hosts;
+        }
+        fulfilled_ = true;
+        for (auto& req : ongoingRequests_) {
+            hosts.emplace_back(req.first);
+        }
+        return hosts;
+    }
+
+    bool fulfilled() {
+        std::lock_guard<std::mutex> g(lock_);
+        return fulfilled_;
+    }
+
     // Return true if processed all responses
     bool removeRequest(HostAddr host) {
         std::lock_guard<std::mutex> g(lock_);
@@ -72,15 +93,76 @@ private:
     bool fulfilled_{false};
 };
 
+template<class Request, class RemoteFunc>
+auto sendRequest(std::nullptr_t,
+                 const HostAddr&,
+                 cpp2::StorageServiceAsyncClient* client,
+                 const Request& req,
+                 RemoteFunc& remoteFunc) {
+    return remoteFunc(client, req);
+}
+
+template<class Request, class RemoteFunc>
+auto sendRequest(RequestCoalescer<Request>* coalescer,
+                 const HostAddr& host,
+                 cpp2::StorageServiceAsyncClient* client,
+                 const Request& req,
+                 RemoteFunc& remoteFunc) {
+    if (coalescer != nullptr) {
+        return coalescer->submit(host, req);
+    }
+    return remoteFunc(client, req);
+}
+
+// Send the request to the host, and re-issue it to the backup if no response comes
+// in storage_client_hedge_delay_ms. The first succeeded response is taken.
+// It should be called in the thread of evb, where send() calls back as well.
+template<class Response, class SendFunc>
+folly::Future<Response> sendHedged(folly::EventBase* evb,
+                                   SendFunc send,
+                                   const HostAddr& host,
+                                   const HostAddr& backup) {
+    if (backup == HostAddr(0, 0)) {
+        return send(host);
+    }
+    struct State {
+        folly::Promise<Response> promise;
+        bool done{false};
+        int32_t pending{1};
+    };
+    auto state = std::make_shared<State>();
+    auto onResult = [state] (folly::Try<Response>&& t) {
+        state->pending--;
+        if (state->done || (t.hasException() && state->pending > 0)) {
+            return;
+        }
+        state->done = true;
+        state->promise.setTry(std::move(t));
+    };
+    send(host).thenTry(onResult);
+    evb->runAfterDelay([state, send, host, backup, onResult] () mutable {
+        if (state->done) {
+            return;
+        }
+        VLOG(2) << "Request to " << host << " is slow, send it to " << backup;
+        HostStats::instance().hedge(host);
+        state->pending++;
+        send(backup).thenTry(onResult);
+    }, FLAGS_storage_client_hedge_delay_ms);
+    return state->promise.getFuture();
+}
+
 }  // Anonymous namespace
 
 
-template<class Request, class RemoteFunc, class GetPartIDFunc, class Response>
+template<class Request, class RemoteFunc, class GetPartIDFunc, class Response, class Coalescer>
 folly::SemiFuture<StorageRpcResponse<Response>> StorageClient::collectResponse(
         folly::EventBase* evb,
         std::unordered_map<HostAddr, Request> requests,
         RemoteFunc&& remoteFunc,
-        GetPartIDFunc getPartIDFunc) {
+        GetPartIDFunc getPartIDFunc,
+        Coalescer coalescer,
+        bool read) {
     auto context = std::make_shared<ResponseContext<Request, RemoteFunc, Response>>(
         requests.size(), std::move(remoteFunc));
 
@@ -93,6 +175,17 @@ folly::SemiFuture<StorageRpcResponse<Response>> StorageClient::collectResponse(
     for (auto& req : requests) {
         auto& host = req.first;
         auto spaceId = req.second.get_space_id();
+        HostAddr backup(0, 0);
+        if (read && FLAGS_storage_client_hedge_delay_ms > 0) {
+            std::vector<PartitionID> parts;
+            for (auto& part : req.second.parts) {
+                parts.emplace_back(getPartIDFunc(part));
+            }
+            auto ret = hedgeHost(spaceId, host, parts);
+            if (ret.ok()) {
+                backup = ret.value();
+            }
+        }
         auto res = context->insertRequest(host, std::move(req.second));
         DCHECK(res.second);
         // Invoke the remote method
@@ -103,11 +196,29 @@ folly::SemiFuture<StorageRpcResponse<Response>> StorageClient::collectResponse(
                          spaceId,
                          res,
                          duration,
-                         getPartIDFunc] () mutable {
-            auto client = clientsMan_->client(host, evb, false, FLAGS_storage_client_timeout_ms);
+                         getPartIDFunc,
+                         coalescer,
+                         backup] () mutable {
             // Result is a pair of <Request&, bool>
             auto start = time::WallClock::fastNowInMicroSec();
-            context->serverMethod(client.get(), *res.first)
+            auto send = [this, evb, context, host, res, coalescer] (const HostAddr& to) {
+                auto client = clientsMan_->client(to, evb, false, FLAGS_storage_client_timeout_ms);
+                HostStats::instance().start(to);
+                auto begin = time::WallClock::fastNowInMicroSec();
+                // The re-issued request is not merged with others
+                return sendRequest(to == host ? coalescer : nullptr,
+                                   to,
+                                   client.get(),
+                                   *res.first,
+                                   context->serverMethod)
+                    .via(evb).thenTry([to, begin] (folly::Try<Response>&& t) {
+                        HostStats::instance().finish(to,
+                                                     time::WallClock::fastNowInMicroSec() - begin,
+                                                     !t.hasException());
+                        return folly::makeFuture<Response>(std::move(t));
+                    });
+            };
+            sendHedged<Response>(evb, std::move(send), host, backup)
             // Future process code will be executed on the IO thread
             // Since all requests are sent using the same eventbase, all then-callback
             // will be executed on the same IO thread
@@ -118,6 +229,10 @@ folly::SemiFuture<StorageRpcResponse<Response>> StorageClient::collectResponse(
                             duration,
                             getPartIDFunc,
                             start] (folly::Try<Response>&& val) {
+                if (context->fulfilled()) {
+                    // The host has been given up, and the result returned without it
+                    return;
+                }
                 auto& r = context->findRequest(host);
                 if (val.hasException()) {
                     LOG(ERROR) << "Request to " << host << " failed: " << val.exception().what();
@@ -189,6 +304,29 @@ folly::SemiFuture<StorageRpcResponse<Response>> StorageClient::collectResponse(
         stats::Stats::addStatsValue(stats_.get(),
                                     context->resp.succeeded(),
                                     duration.elapsedInUSec());
+    } else if (read && FLAGS_storage_client_read_deadline_ms > 0) {
+        folly::via(evb, [this, evb, context, duration, getPartIDFunc] () {
+            evb->runAfterDelay([this, context, duration, getPartIDFunc] () {
+                auto hosts = context->expire();
+                if (hosts.empty()) {
+                    return;
+                }
+                for (auto& host : hosts) {
+                    LOG(WARNING) << "No response from " << host << " in "
+                                 << FLAGS_storage_client_read_deadline_ms
+                                 << "ms, return the partial result";
+                    HostStats::instance().timeout(host);
+                    for (auto& part : context->findRequest(host).parts) {
+                        context->resp.failedParts().emplace(
+                            getPartIDFunc(part),
+                            storage::cpp2::ErrorCode::E_RPC_FAILURE);
+                    }
+                    context->resp.markFailure();
+                }
+                stats::Stats::addStatsValue(stats_.get(), false, duration.elapsedInUSec());
+                context->promise.setValue(std::move(context->resp));
+            }, FLAGS_storage_client_read_deadline_ms);
+        });
     }
 
     return context->promise.getSemiFuture();
@@ -214,9 +352,11 @@ folly::Future<StatusOr<Response>> StorageClient::getResponse(
         auto spaceId = request.second.get_space_id();
         auto partId = request.second.get_part_id();
         LOG(INFO) << "Send request to storage " << host;
+        HostStats::instance().start(host);
         remoteFunc(client.get(), std::move(request.second)).via(evb)
              .then([spaceId, partId, p = std::move(pro),
-                    duration, this] (folly::Try<Response>&& t) mutable {
+                    duration, host, this] (folly::Try<Response>&& t) mutable {
+            HostStats::instance().finish(host, duration.elapsedInUSec(), !t.hasException());
             // exception occurred during RPC
             if (t.hasException()) {
                 stats::Stats::addStatsValue(stats_.get(), false, duration.elapsedInUSec());
@@ -0,0 +1,290 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "storage/http/SstFileDownloader.h"
+#include "fs/FileUtils.h"
+#include "hdfs/LocalFsHelper.h"
+#include "time/WallClock.h"
+
+DEFINE_int64(download_chunk_size, 64L * 1024 * 1024,
+             "Download the files larger than it in chunks of this size in parallel, "
+             "if the source supports, 0 to download the files as a whole");
+DEFINE_bool(download_verify_checksum, true,
+            "Verify the checksum of the downloaded files, if the source provides");
+
+namespace nebula {
+namespace storage {
+
+using fs::FileUtils;
+
+DownloadProgress& DownloadProgress::get() {
+    static DownloadProgress progress;
+    return progress;
+}
+
+void DownloadProgress::start(GraphSpaceID spaceId, int64_t numParts) {
+    space = spaceId;
+    succeeded = false;
+    startMs = time::WallClock::fastNowInMilliSec();
+    finishMs = 0;
+    parts = numParts;
+    downloadedParts = 0;
+    ingestedParts = 0;
+    failedParts = 0;
+    files = 0;
+    downloadedFiles = 0;
+    bytes = 0;
+    downloadedBytes = 0;
+    running = true;
+}
+
+void DownloadProgress::finish(bool ok) {
+    finishMs = time::WallClock::fastNowInMilliSec();
+    succeeded = ok;
+    running = false;
+}
+
+int64_t DownloadProgress::elapsedMs() const {
+    if (startMs == 0) {
+        return 0;
+    }
+    return (running ? time::WallClock::fastNowInMilliSec() : finishMs.load()) - startMs;
+}
+
+SstFileDownloader::SstFileDownloader(hdfs::HdfsHelper* helper,
+                                     thread::GenericThreadPool* pool,
+                                     std::string hdfsHost,
+                                     int32_t hdfsPort)
+        : helper_(helper)
+        , pool_(pool)
+        , hdfsHost_(std::move(hdfsHost))
+        , hdfsPort_(hdfsPort) {
+    CHECK_NOTNULL(helper_);
+    CHECK_NOTNULL(pool_);
+}
+
+bool SstFileDownloader::download(GraphSpaceID space,
+                                 std::vector<Part> parts,
+                                 OnPartDownloaded onDownloaded) {
+    auto& progress = DownloadProgress::get();
+    progress.start(space, parts.size());
+    onDownloaded_ = std::move(onDownloaded);
+
+    bool successfully{true};
+    std::vector<folly::SemiFuture<bool>> futures;
+    for (auto& part : parts) {
+        parts_.emplace_back(std::make_unique<PartState>());
+        auto* state = parts_.back().get();
+        state->part = std::move(part);
+        if (!listPart(state, &futures)) {
+            successfully = false;
+            break;
+        }
+    }
+
+    // Wait for the tasks put already, even if some part failed
+    folly::collectAll(futures).thenValue([&](const std::vector<folly::Try<bool>>& tries) {
+        for (const auto& t : tries) {
+            if (t.hasException()) {
+                LOG(ERROR) << "Download Failed: " << t.exception();
+                successfully = false;
+            } else if (!t.value()) {
+                successfully = false;
+            }
+        }
+    }).wait();
+
+    progress.finish(successfully);
+    LOG(INFO) << "Download tasks have finished, " << progress.downloadedFiles << " files, "
+              << progress.downloadedBytes << " bytes in " << progress.elapsedMs() << " ms";
+    return successfully;
+}
+
+bool SstFileDownloader::listPart(PartState* state,
+                                 std::vector<folly::SemiFuture<bool>>* futures) {
+    auto& part = state->part;
+    auto listResult = helper_->listFiles(hdfsHost_, hdfsPort_, part.hdfsPath);
+    if (!listResult.ok()) {
+        if (listResult.status().isNotSupported()) {
+            futures->emplace_back(pool_->addTask([this, state] {
+                return copyPart(state);
+            }));
+            return true;
+        }
+        LOG(ERROR) << "List files failed, path " << part.hdfsPath << ": "
+                   << listResult.status();
+        return fail(state);
+    }
+
+    auto partDir = FileUtils::joinPath(part.localPath, folly::to<std::string>(part.id));
+    if (!FileUtils::makeDir(partDir)) {
+        LOG(ERROR) << "Create directory failed: " << partDir;
+        return fail(state);
+    }
+    auto hdfsFiles = std::move(listResult).value();
+    if (hdfsFiles.empty()) {
+        LOG(INFO) << "No files in " << part.hdfsPath;
+        return finishPart(state);
+    }
+
+    auto& progress = DownloadProgress::get();
+    int64_t chunkSize = FLAGS_download_chunk_size;
+    auto ranged = helper_->supportRangeCopy() && chunkSize > 0;
+    state->filesLeft = hdfsFiles.size();
+    for (auto& hdfsFile : hdfsFiles) {
+        files_.emplace_back(std::make_unique<File>());
+        auto* file = files_.back().get();
+        file->part = state;
+        file->hdfsPath = folly::stringPrintf("%s/%s",
+                                             part.hdfsPath.c_str(), hdfsFile.name.c_str());
+        file->localPath = FileUtils::joinPath(partDir, hdfsFile.name);
+        file->tmpPath = file->localPath + ".downloading";
+        file->size = hdfsFile.size;
+        progress.files++;
+        progress.bytes += file->size;
+
+        if (!ranged) {
+            file->chunksLeft = 1;
+            futures->emplace_back(pool_->addTask([this, file] {
+                return copyFile(file);
+            }));
+            continue;
+        }
+
+        // The chunks are written to their positions in the file created beforehand
+        auto fd = ::open(file->tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || ::ftruncate(fd, file->size) != 0) {
+            LOG(ERROR) << "Create file failed: " << file->tmpPath << ", " << ::strerror(errno);
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            return fail(state);
+        }
+        ::close(fd);
+        auto chunks = std::max<int64_t>(1, (file->size + chunkSize - 1) / chunkSize);
+        file->chunksLeft = chunks;
+        for (int64_t i = 0; i < chunks; i++) {
+            auto offset = i * chunkSize;
+            auto length = std::min(chunkSize, file->size - offset);
+            futures->emplace_back(pool_->addTask([this, file, offset, length] {
+                return copyChunk(file, offset, length);
+            }));
+        }
+    }
+    return true;
+}
+
+bool SstFileDownloader::copyPart(PartState* state) {
+    auto& part = state->part;
+    auto result = helper_->copyToLocal(hdfsHost_, hdfsPort_, part.hdfsPath, part.localPath);
+    if (!result.ok()) {
+        LOG(ERROR) << "Run Hdfs CopyToLocal failed. " << result.status();
+        return fail(state);
+    }
+    if (!result.value().empty()) {
+        LOG(ERROR) << "Run Hdfs CopyToLocal failed. " << result.value();
+        return fail(state);
+    }
+    return finishPart(state);
+}
+
+bool SstFileDownloader::copyChunk(File* file, int64_t offset, int64_t length) {
+    if (file->part->failed) {
+        return false;
+    }
+    auto status = helper_->copyRangeToLocal(hdfsHost_, hdfsPort_, file->hdfsPath,
+                                            offset, length, file->tmpPath);
+    if (!status.ok()) {
+        LOG(ERROR) << "Download " << file->hdfsPath << " at " << offset << " failed: "
+                   << status;
+        return fail(file->part);
+    }
+    DownloadProgress::get().downloadedBytes += length;
+    if (--file->chunksLeft > 0) {
+        return true;
+    }
+    return finishFile(file);
+}
+
+bool SstFileDownloader::copyFile(File* file) {
+    if (file->part->failed) {
+        return false;
+    }
+    FileUtils::remove(file->tmpPath.c_str());
+    auto result = helper_->copyToLocal(hdfsHost_, hdfsPort_, file->hdfsPath, file->tmpPath);
+    if (!result.ok() || !result.value().empty()) {
+        LOG(ERROR) << "Run Hdfs CopyToLocal failed. "
+                   << (result.ok() ? result.value() : result.status().toString());
+        return fail(file->part);
+    }
+    DownloadProgress::get().downloadedBytes += file->size;
+    file->chunksLeft = 0;
+    return finishFile(file);
+}
+
+bool SstFileDownloader::finishFile(File* file) {
+    auto size = static_cast<int64_t>(FileUtils::fileSize(file->tmpPath.c_str()));
+    if (size != file->size) {
+        LOG(ERROR) << "Size of " << file->tmpPath << " is " << size
+                   << ", expected " << file->size;
+        return fail(file->part);
+    }
+
+    if (FLAGS_download_verify_checksum) {
+        auto expected = helper_->checksum(hdfsHost_, hdfsPort_, file->hdfsPath);
+        if (expected.ok()) {
+            auto actual = hdfs::LocalFsHelper::fileChecksum(file->tmpPath);
+            if (!actual.ok() || actual.value() != expected.value()) {
+                LOG(ERROR) << "Checksum of " << file->tmpPath << " mismatch, expected "
+                           << expected.value();
+                return fail(file->part);
+            }
+        } else if (!expected.status().isNotSupported()) {
+            LOG(ERROR) << "Get checksum of " << file->hdfsPath << " failed: "
+                       << expected.status();
+            return fail(file->part);
+        }
+    }
+
+    if (!FileUtils::rename(file->tmpPath, file->localPath)) {
+        LOG(ERROR) << "Rename " << file->tmpPath << " failed";
+        return fail(file->part);
+    }
+    DownloadProgress::get().downloadedFiles++;
+    if (--file->part->filesLeft > 0) {
+        return true;
+    }
+    return finishPart(file->part);
+}
+
+bool SstFileDownloader::finishPart(PartState* state) {
+    if (state->failed) {
+        return false;
+    }
+    auto& progress = DownloadProgress::get();
+    progress.downloadedParts++;
+    if (onDownloaded_ == nullptr) {
+        return true;
+    }
+    auto& part = state->part;
+    auto dir = FileUtils::joinPath(part.localPath, folly::to<std::string>(part.id));
+    if (!onDownloaded_(part.id, dir)) {
+        LOG(ERROR) << "Handle the downloaded part " << part.id << " failed";
+        return fail(state);
+    }
+    progress.ingestedParts++;
+    return true;
+}
+
+bool SstFileDownloader::fail(PartState* state) {
+    if (!state->failed.exchange(true)) {
+        DownloadProgress::get().failedParts++;
+    }
+    return false;
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,124 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_HTTP_SSTFILEDOWNLOADER_H_
+#define STORAGE_HTTP_SSTFILEDOWNLOADER_H_
+
+#include "base/Base.h"
+#include "hdfs/HdfsHelper.h"
+#include "thread/GenericThreadPool.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * The progress of the latest download of the storaged, shown by /download_stats.
+ * */
+struct DownloadProgress {
+    std::atomic<GraphSpaceID>   space{0};
+    std::atomic<bool>           running{false};
+    std::atomic<bool>           succeeded{false};
+    std::atomic<int64_t>        startMs{0};
+    std::atomic<int64_t>        finishMs{0};
+    std::atomic<int64_t>        parts{0};
+    std::atomic<int64_t>        downloadedParts{0};
+    std::atomic<int64_t>        ingestedParts{0};
+    std::atomic<int64_t>        failedParts{0};
+    std::atomic<int64_t>        files{0};
+    std::atomic<int64_t>        downloadedFiles{0};
+    std::atomic<int64_t>        bytes{0};
+    std::atomic<int64_t>        downloadedBytes{0};
+
+    static DownloadProgress& get();
+
+    void start(GraphSpaceID spaceId, int64_t numParts);
+
+    void finish(bool ok);
+
+    int64_t elapsedMs() const;
+};
+
+/**
+ * Download the SST files of the parts from HDFS, and hand over every part
+ * as soon as all of its files are downloaded, e.g. to ingest it.
+ *
+ * The files of all the parts are listed first. If the source supports range copy,
+ * the files larger than --download_chunk_size are split into chunks. The chunks
+ * and the files of all the parts are downloaded in parallel by the pool.
+ *
+ * A file is downloaded under a temporary name, and renamed after its size and
+ * checksum are verified, so no partial SST file would be seen by ingest.
+ * If the source could not list the files, the directory of a part is copied as a whole.
+ * */
+class SstFileDownloader final {
+public:
+    struct Part {
+        PartitionID     id;
+        // The directory of the part on HDFS
+        std::string     hdfsPath;
+        // The local directory to download the directory of the part into
+        std::string     localPath;
+    };
+
+    // Called in the pool with the local directory of a part, once its files are downloaded
+    using OnPartDownloaded = std::function<bool(PartitionID part, const std::string& dir)>;
+
+    SstFileDownloader(hdfs::HdfsHelper* helper,
+                      thread::GenericThreadPool* pool,
+                      std::string hdfsHost,
+                      int32_t hdfsPort);
+
+    // Returns true if all the parts are downloaded and handed over successfully
+    bool download(GraphSpaceID space, std::vector<Part> parts, OnPartDownloaded onDownloaded);
+
+private:
+    struct PartState {
+        Part                    part;
+        std::atomic<int64_t>    filesLeft{0};
+        std::atomic<bool>       failed{false};
+    };
+
+    struct File {
+        PartState              *part;
+        std::string             hdfsPath;
+        std::string             localPath;
+        // Downloaded into first
+        std::string             tmpPath;
+        int64_t                 size;
+        std::atomic<int64_t>    chunksLeft{0};
+    };
+
+    // List the files of the part, and put the tasks to download them into futures
+    bool listPart(PartState* state, std::vector<folly::SemiFuture<bool>>* futures);
+
+    bool copyPart(PartState* state);
+
+    bool copyChunk(File* file, int64_t offset, int64_t length);
+
+    bool copyFile(File* file);
+
+    // Verify the downloaded file and rename it
+    bool finishFile(File* file);
+
+    bool finishPart(PartState* state);
+
+    bool fail(PartState* state);
+
+private:
+    hdfs::HdfsHelper                           *helper_{nullptr};
+    thread::GenericThreadPool                  *pool_{nullptr};
+    std::string                                 hdfsHost_;
+    int32_t                                     hdfsPort_;
+    OnPartDownloaded                            onDownloaded_;
+
+    std::vector<std::unique_ptr<PartState>>     parts_;
+    std::vector<std::unique_ptr<File>>          files_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_HTTP_SSTFILEDOWNLOADER_H_
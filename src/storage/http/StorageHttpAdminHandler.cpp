@@ -7,6 +7,8 @@
 #include "storage/http/StorageHttpAdminHandler.h"
 #include "webservice/Common.h"
 #include "process/ProcessUtils.h"
+#include "storage/index/IndexStatsCollector.h"
+#include <folly/json.h>
 #include <proxygen/httpserver/RequestHandler.h>
 #include <proxygen/lib/http/ProxygenErrorEnum.h>
 #include <proxygen/httpserver/ResponseBuilder.h>
@@ -66,6 +68,18 @@ void StorageHttpAdminHandler::onRequest(std::unique_ptr<HTTPMessage> headers) no
             err_ = HttpCode::SUCCEEDED;
             return;
         }
+    } else if (*op == "stats") {
+        // The stats of the indexes on the leader parts, merged by the stats job of meta
+        auto stats = IndexStatsCollector(kv_, indexMan_).collect(spaceId);
+        if (!stats.ok()) {
+            resp_ = folly::stringPrintf("Collect stats failed! error=%s",
+                                        stats.status().toString().c_str());
+            err_ = HttpCode::SUCCEEDED;
+            return;
+        }
+        resp_ = folly::toJson(stats.value());
+        err_ = HttpCode::SUCCEEDED;
+        return;
     } else {
         resp_ = folly::stringPrintf("Unknown operation %s", op->c_str());
         err_ = HttpCode::SUCCEEDED;
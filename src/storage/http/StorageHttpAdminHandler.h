@@ -10,6 +10,7 @@
 #include "base/Base.h"
 #include "webservice/Common.h"
 #include "kvstore/KVStore.h"
+#include "meta/IndexManager.h"
 #include "proxygen/httpserver/RequestHandler.h"
 
 namespace nebula {
@@ -19,9 +20,12 @@ using nebula::HttpCode;
 
 class StorageHttpAdminHandler : public proxygen::RequestHandler {
 public:
-    StorageHttpAdminHandler(meta::SchemaManager* schemaMan, kvstore::KVStore* kv)
+    StorageHttpAdminHandler(meta::SchemaManager* schemaMan,
+                            kvstore::KVStore* kv,
+                            meta::IndexManager* indexMan = nullptr)
         : schemaMan_(schemaMan)
-        , kv_(kv) {}
+        , kv_(kv)
+        , indexMan_(indexMan) {}
 
     void onRequest(std::unique_ptr<proxygen::HTTPMessage> headers) noexcept override;
 
@@ -41,6 +45,7 @@ private:
     std::string resp_;
     meta::SchemaManager* schemaMan_ = nullptr;
     kvstore::KVStore*    kv_ = nullptr;
+    meta::IndexManager*  indexMan_ = nullptr;
 };
 
 }  // namespace storage
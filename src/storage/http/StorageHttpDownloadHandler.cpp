@@ -11,12 +11,13 @@
 #include "hdfs/HdfsHelper.h"
 #include "kvstore/Part.h"
 #include "thread/GenericThreadPool.h"
+#include "storage/http/SstFileDownloader.h"
 #include <proxygen/httpserver/RequestHandler.h>
 #include <proxygen/lib/http/ProxygenErrorEnum.h>
 #include <proxygen/httpserver/ResponseBuilder.h>
 #include <mutex>
 
-DEFINE_int32(download_thread_num, 3, "download thread number");
+DEFINE_int32(download_thread_num, 3, "Number of threads to download the SST files");
 
 namespace nebula {
 namespace storage {
@@ -71,6 +72,7 @@ void StorageHttpDownloadHandler::onRequest(std::unique_ptr<HTTPMessage> headers)
         return;
     }
     spaceID_ = headers->getIntQueryParam("space");
+    ingest_ = headers->hasQueryParam("ingest") && headers->getQueryParam("ingest") == "true";
     auto partitions = headers->getQueryParam("parts");
     folly::split(",", partitions, parts_, true);
     if (parts_.empty()) {
@@ -180,7 +182,7 @@ void StorageHttpDownloadHandler::onError(ProxygenError error) noexcept {
 }
 
 bool StorageHttpDownloadHandler::downloadSSTFiles() {
-    std::vector<folly::SemiFuture<bool>> futures;
+    std::vector<SstFileDownloader::Part> parts;
     for (auto& part : parts_) {
         PartitionID partId;
         try {
@@ -218,36 +220,39 @@ bool StorageHttpDownloadHandler::downloadSSTFiles() {
             localPath = folly::stringPrintf(
                 "%s/download/general", partDataRoot);
         }
-        auto downloader = [this, hdfsPartPath, localPath] {
-            auto resultStatus = this->helper_->copyToLocal(
-                hdfsHost_, hdfsPort_, hdfsPartPath, localPath);
-            if (!resultStatus.ok()) {
-                LOG(ERROR) << "Run Hdfs CopyToLocal failed. "
-                           << resultStatus.status().toString();
+        SstFileDownloader::Part p;
+        p.id = partId;
+        p.hdfsPath = std::move(hdfsPartPath);
+        p.localPath = std::move(localPath);
+        parts.emplace_back(std::move(p));
+    }
+
+    SstFileDownloader::OnPartDownloaded onDownloaded;
+    if (ingest_) {
+        // Ingest a part right after its files are downloaded, rather than waiting for
+        // the whole space. The files are moved into the engine by ingest.
+        onDownloaded = [this] (PartitionID partId, const std::string& dir) {
+            auto files = fs::FileUtils::listAllFilesInDir(dir.c_str(), true, "*.sst");
+            if (files.empty()) {
+                return true;
+            }
+            auto partResult = kvstore_->part(spaceID_, partId);
+            if (!ok(partResult)) {
+                LOG(ERROR) << "Can't found space: " << spaceID_ << ", part: " << partId;
+                return false;
+            }
+            auto code = value(partResult)->engine()->ingest(files);
+            if (code != kvstore::ResultCode::SUCCEEDED) {
+                LOG(ERROR) << "Ingest failed: part[" << partId << "], code[" << code << "]";
                 return false;
             }
-            auto result = std::move(resultStatus).value();
-            return result.empty();
+            LOG(INFO) << "Ingest success: part[" << partId << "], dir[" << dir << "]";
+            return true;
         };
-        auto future = pool_->addTask(downloader);
-        futures.push_back(std::move(future));
     }
-    bool successfully{true};
-    folly::collectAll(futures).thenValue([&](const std::vector<folly::Try<bool>>& tries) {
-        for (const auto& t : tries) {
-            if (t.hasException()) {
-                LOG(ERROR) << "Download Failed: " << t.exception();
-                successfully = false;
-                break;
-            }
-            if (!t.value()) {
-                successfully = false;
-                break;
-            }
-        }
-    }).wait();
-    LOG(INFO) << "Download tasks have finished";
-    return successfully;
+
+    SstFileDownloader downloader(helper_, pool_, hdfsHost_, hdfsPort_);
+    return downloader.download(spaceID_, std::move(parts), std::move(onDownloaded));
 }
 
 }  // namespace storage
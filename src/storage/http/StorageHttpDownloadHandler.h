@@ -52,6 +52,8 @@ private:
     int32_t hdfsPort_;
     std::string hdfsPath_;
     std::vector<std::string> parts_;
+    // Whether to ingest every part once downloaded
+    bool ingest_{false};
     nebula::hdfs::HdfsHelper *helper_;
     nebula::thread::GenericThreadPool *pool_;
     nebula::kvstore::KVStore *kvstore_;
@@ -0,0 +1,54 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "storage/http/StorageHttpDownloadStatsHandler.h"
+#include "storage/http/SstFileDownloader.h"
+#include <proxygen/lib/http/ProxygenErrorEnum.h>
+
+namespace nebula {
+namespace storage {
+
+using proxygen::ProxygenError;
+
+void StorageHttpDownloadStatsHandler::onError(ProxygenError err) noexcept {
+    LOG(ERROR) << "Web service StorageHttpDownloadStatsHandler got error: "
+               << proxygen::getErrorString(err);
+    delete this;
+}
+
+folly::dynamic StorageHttpDownloadStatsHandler::getStats() const {
+    auto& progress = DownloadProgress::get();
+    auto elapsedMs = progress.elapsedMs();
+    int64_t downloadedBytes = progress.downloadedBytes;
+    std::vector<std::pair<std::string, int64_t>> vals = {
+        {"download.space", progress.space},
+        {"download.running", progress.running},
+        {"download.succeeded", progress.succeeded},
+        {"download.elapsed_ms", elapsedMs},
+        {"download.parts", progress.parts},
+        {"download.downloaded_parts", progress.downloadedParts},
+        {"download.ingested_parts", progress.ingestedParts},
+        {"download.failed_parts", progress.failedParts},
+        {"download.files", progress.files},
+        {"download.downloaded_files", progress.downloadedFiles},
+        {"download.bytes", progress.bytes},
+        {"download.downloaded_bytes", downloadedBytes},
+        {"download.bytes_per_sec", elapsedMs > 0 ? downloadedBytes * 1000 / elapsedMs : 0},
+    };
+
+    auto stats = folly::dynamic::array();
+    for (auto& val : vals) {
+        if (statNames_.empty() ||
+                std::find(statNames_.begin(), statNames_.end(), val.first) != statNames_.end()) {
+            addOneStat(stats, val.first, val.second);
+        }
+    }
+    return stats;
+}
+
+}  // namespace storage
+}  // namespace nebula
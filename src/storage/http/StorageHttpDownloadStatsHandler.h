@@ -0,0 +1,26 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_HTTP_STORAGEHTTPDOWNLOADSTATSHANDLER_H_
+#define STORAGE_HTTP_STORAGEHTTPDOWNLOADSTATSHANDLER_H_
+
+#include "base/Base.h"
+#include "webservice/GetStatsHandler.h"
+
+namespace nebula {
+namespace storage {
+
+// Show the progress and the throughput of the latest download
+class StorageHttpDownloadStatsHandler : public nebula::GetStatsHandler {
+public:
+    StorageHttpDownloadStatsHandler() = default;
+    void onError(proxygen::ProxygenError err) noexcept override;
+    folly::dynamic getStats() const override;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_HTTP_STORAGEHTTPDOWNLOADSTATSHANDLER_H_
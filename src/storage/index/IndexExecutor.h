@@ -48,7 +48,11 @@ protected:
      **/
     cpp2::ErrorCode buildExecutionPlan(const std::string& filter);
 
-    std::pair<std::string, std::string> makeScanPair(PartitionID partId, IndexID indexId);
+    /**
+     * Details Make the [begin, end) pairs to scan, one per combination of the IN lists hit.
+     **/
+    std::vector<std::pair<std::string, std::string>>
+    makeScanPairs(PartitionID partId, IndexID indexId);
 
     std::pair<std::string, std::string>
     normalizeScanPair(const nebula::cpp2::ColumnDef& field, const ScanBound& item);
@@ -58,11 +62,43 @@ protected:
      **/
     kvstore::ResultCode executeExecutionPlan(PartitionID part);
 
+    /**
+     * Details Switch to the index of the next context in the request,
+     *         which must be on the same tag or edge as the previous one.
+     **/
+    cpp2::ErrorCode switchIndex(IndexID indexId);
+
+    // The index keys hit in a part, by the vertex or the edge at the tail of the key
+    using IndexHits = std::unordered_map<std::string, std::string>;
+
+    /**
+     * Details Scan the current index in the part, and merge the keys hit into hits :
+     *         all of them for the first index or for a union,
+     *         only the ones hit before for an intersection.
+     *         The hits of a union over all the parts are bounded by
+     *         max_rows_returned_per_lookup.
+     **/
+    kvstore::ResultCode collectHits(PartitionID part, bool first, bool isUnion, IndexHits* hits);
+
+    kvstore::ResultCode getDataRows(PartitionID part, const IndexHits& hits);
+
+    /**
+     * Details Whether max_rows_returned_per_lookup rows have been fetched.
+     **/
+    bool rowsFull() const;
+
 private:
     cpp2::ErrorCode checkIndex(IndexID indexId);
 
     cpp2::ErrorCode checkReturnColumns(const std::vector<std::string> &cols);
 
+    /**
+     * Details Scan the current index in the part, for at most limit keys.
+     **/
+    kvstore::ResultCode scanIndex(PartitionID part,
+                                  int64_t limit,
+                                  std::vector<std::string>* keys);
+
     kvstore::ResultCode getDataRow(PartitionID partId,
                                    const folly::StringPiece& key);
 
@@ -94,6 +130,7 @@ protected:
 
 private:
     int                                                rowNum_{0};
+    int64_t                                            hitNum_{0};
     int32_t                                            tagOrEdge_;
     int32_t                                            vColNum_{0};
     std::vector<PropContext>                           props_;
@@ -20,7 +20,8 @@ cpp2::ErrorCode IndexExecutor<RESP>::prepareRequest(const cpp2::LookUpIndexReque
     /**
      * step 1 , check index meta , and collect index variable-length type of columns.
      */
-    auto ret = checkIndex(req.get_index_id());
+    const auto& contexts = req.get_contexts();
+    auto ret = checkIndex(contexts.empty() ? req.get_index_id() : contexts[0].get_index_id());
     if (ret != cpp2::ErrorCode::SUCCEEDED) {
         return ret;
     }
@@ -43,6 +44,23 @@ cpp2::ErrorCode IndexExecutor<RESP>::buildExecutionPlan(const std::string& filte
     return ret;
 }
 
+template <typename RESP>
+cpp2::ErrorCode IndexExecutor<RESP>::switchIndex(IndexID indexId) {
+    auto tagOrEdge = tagOrEdge_;
+    resetPolicy();
+    vColNum_ = 0;
+    indexCols_.clear();
+    auto ret = checkIndex(indexId);
+    if (ret != cpp2::ErrorCode::SUCCEEDED) {
+        return ret;
+    }
+    if (tagOrEdge_ != tagOrEdge) {
+        VLOG(1) << "Index " << indexId << " is not on " << tagOrEdge;
+        return cpp2::ErrorCode::E_INVALID_FILTER;
+    }
+    return ret;
+}
+
 template <typename RESP>
 cpp2::ErrorCode IndexExecutor<RESP>::checkIndex(IndexID indexId) {
     StatusOr<std::shared_ptr<nebula::cpp2::IndexItem>> index;
@@ -119,51 +137,82 @@ cpp2::ErrorCode IndexExecutor<RESP>::checkReturnColumns(const std::vector<std::s
 
 // TODO (sky) : String range scan was disabled graph layer. it is not support in storage layer.
 template <typename RESP>
-std::pair<std::string, std::string>
-IndexExecutor<RESP>::makeScanPair(PartitionID partId, IndexID indexId) {
-    std::string beginStr = NebulaKeyUtils::indexPrefix(partId, indexId);
-    std::string endStr = NebulaKeyUtils::indexPrefix(partId, indexId);
+std::vector<std::pair<std::string, std::string>>
+IndexExecutor<RESP>::makeScanPairs(PartitionID partId, IndexID indexId) {
+    struct Scan {
+        std::string          begin;
+        std::string          end;
+        std::vector<int32_t> colsLen;
+    };
+    std::vector<Scan> scans(1);
+    scans[0].begin = NebulaKeyUtils::indexPrefix(partId, indexId);
+    scans[0].end = scans[0].begin;
     const auto& fields = index_->get_fields();
-    std::vector<int32_t> colsLen;
     for (const auto& field : fields) {
+        std::vector<ScanBound> items;
         auto item = scanItems_.find(field.get_name());
-        if (item == scanItems_.end()) {
-            break;
-        }
-        // here need check the value type, maybe different data types appear.
-        // for example:
-        // index (c1 double)
-        // where c1 > abs(1) , FunctionCallExpression->eval(abs(1))
-        // should be cast type from int to double.
-        bool suc = true;
-        if (item->second.beginBound_.rel_ != RelationType::kNull) {
-            suc = NebulaKeyUtils::checkAndCastVariant(field.get_type().type,
-                                                      item->second.beginBound_.val_);
-        }
-        if (suc == true && item->second.endBound_.rel_ != RelationType::kNull) {
-            suc = NebulaKeyUtils::checkAndCastVariant(field.get_type().type,
-                                                      item->second.endBound_.val_);
-        }
-        if (!suc) {
-            VLOG(1) << "Unknown VariantType";
-            return {};
+        if (item != scanItems_.end()) {
+            items.emplace_back(item->second);
+        } else {
+            auto list = scanLists_.find(field.get_name());
+            if (list == scanLists_.end()) {
+                break;
+            }
+            for (const auto& v : list->second) {
+                items.emplace_back(Bound(RelationType::kEQRel, v), Bound(RelationType::kEQRel, v));
+            }
         }
-        auto pair = normalizeScanPair(field, (*item).second);
-        if (field.get_type().type == nebula::cpp2::SupportedType::STRING) {
-            if (pair.first != pair.second) {
+        std::vector<Scan> next;
+        next.reserve(scans.size() * items.size());
+        for (auto& bound : items) {
+            // here need check the value type, maybe different data types appear.
+            // for example:
+            // index (c1 double)
+            // where c1 > abs(1) , FunctionCallExpression->eval(abs(1))
+            // should be cast type from int to double.
+            bool suc = true;
+            if (bound.beginBound_.rel_ != RelationType::kNull) {
+                suc = NebulaKeyUtils::checkAndCastVariant(field.get_type().type,
+                                                          bound.beginBound_.val_);
+            }
+            if (suc == true && bound.endBound_.rel_ != RelationType::kNull) {
+                suc = NebulaKeyUtils::checkAndCastVariant(field.get_type().type,
+                                                          bound.endBound_.val_);
+            }
+            if (!suc) {
+                VLOG(1) << "Unknown VariantType";
+                return {};
+            }
+            auto pair = normalizeScanPair(field, bound);
+            bool isString = field.get_type().type == nebula::cpp2::SupportedType::STRING;
+            if (isString && pair.first != pair.second) {
                 VLOG(1) << "String type field does not allow range scan : " << field.get_name();
                 return {};
             }
-            colsLen.emplace_back(pair.first.size());
+            for (const auto& scan : scans) {
+                Scan s = scan;
+                s.begin.append(pair.first);
+                s.end.append(pair.second);
+                if (isString) {
+                    s.colsLen.emplace_back(pair.first.size());
+                }
+                next.emplace_back(std::move(s));
+            }
         }
-        beginStr.append(pair.first);
-        endStr.append(pair.second);
+        scans = std::move(next);
     }
-    for (auto len : colsLen) {
-        beginStr.append(reinterpret_cast<const char*>(&len), sizeof(int32_t));
-        endStr.append(reinterpret_cast<const char*>(&len), sizeof(int32_t));
+    std::vector<std::pair<std::string, std::string>> pairs;
+    for (auto& scan : scans) {
+        for (auto len : scan.colsLen) {
+            scan.begin.append(reinterpret_cast<const char*>(&len), sizeof(int32_t));
+            scan.end.append(reinterpret_cast<const char*>(&len), sizeof(int32_t));
+        }
+        pairs.emplace_back(std::move(scan.begin), std::move(scan.end));
     }
-    return std::make_pair(beginStr, endStr);
+    // The values of an IN list might be the same after casted, such as 1 and 1.0
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    return pairs;
 }
 
 template <typename RESP>
@@ -210,38 +259,117 @@ IndexExecutor<RESP>::normalizeScanPair(const nebula::cpp2::ColumnDef& field,
 
 template <typename RESP>
 kvstore::ResultCode IndexExecutor<RESP>::executeExecutionPlan(PartitionID part) {
-    std::unique_ptr<kvstore::KVIterator> iter;
     std::vector<std::string> keys;
-    auto pair = makeScanPair(part, index_->get_index_id());
-    if (pair.first.empty() || pair.second.empty()) {
+    auto ret = scanIndex(part, FLAGS_max_rows_returned_per_lookup - rowNum_, &keys);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        return ret;
+    }
+    for (auto& item : keys) {
+        ret = getDataRow(part, item);
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            return ret;
+        }
+    }
+    return ret;
+}
+
+template <typename RESP>
+kvstore::ResultCode IndexExecutor<RESP>::scanIndex(PartitionID part,
+                                                   int64_t limit,
+                                                   std::vector<std::string>* keys) {
+    auto pairs = makeScanPairs(part, index_->get_index_id());
+    if (pairs.empty()) {
         return kvstore::ResultCode::ERR_KEY_NOT_FOUND;
     }
-    auto ret = (pair.first == pair.second)
-               ? this->doPrefix(spaceId_, part, pair.first, &iter)
-               : this->doRange(spaceId_, part, pair.first, pair.second, &iter);
-    if (ret != nebula::kvstore::SUCCEEDED) {
+    for (const auto& pair : pairs) {
+        if (static_cast<int64_t>(keys->size()) >= limit) {
+            break;
+        }
+        std::unique_ptr<kvstore::KVIterator> iter;
+        auto ret = (pair.first == pair.second)
+                   ? this->doPrefix(spaceId_, part, pair.first, &iter)
+                   : this->doRange(spaceId_, part, pair.first, pair.second, &iter);
+        if (ret != nebula::kvstore::SUCCEEDED) {
+            return ret;
+        }
+        while (iter->valid() &&
+               static_cast<int64_t>(keys->size()) < limit) {
+            auto key = iter->key();
+            /**
+             * Need to filter result with expression if is not accurate scan.
+             */
+            if (requiredFilter_ && !conditionsCheck(key)) {
+                iter->next();
+                continue;
+            }
+            keys->emplace_back(key);
+            iter->next();
+        }
+    }
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+template <typename RESP>
+kvstore::ResultCode IndexExecutor<RESP>::collectHits(PartitionID part,
+                                                     bool first,
+                                                     bool isUnion,
+                                                     IndexHits* hits) {
+    // No row of a union is fetched before all the hits are collected, so its hits are
+    // bounded instead of the rows. An intersection is bounded by the rows fetched after
+    // its hits are intersected, the first index adds hits and the later ones filter them.
+    auto adding = first || isUnion;
+    auto limit = isUnion ? FLAGS_max_rows_returned_per_lookup - hitNum_
+                         : std::numeric_limits<int64_t>::max();
+    if (limit <= 0) {
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+    std::vector<std::string> keys;
+    auto ret = scanIndex(part, limit, &keys);
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
         return ret;
     }
-    while (iter->valid() &&
-           rowNum_ < FLAGS_max_rows_returned_per_lookup) {
-        auto key = iter->key();
-        /**
-         * Need to filter result with expression if is not accurate scan.
-         */
-        if (requiredFilter_ && !conditionsCheck(key)) {
-            iter->next();
-            continue;
+    auto tailLen = (!isEdgeIndex_) ? sizeof(VertexID) :
+                                     sizeof(VertexID) * 2 + sizeof(EdgeRanking);
+    if (adding) {
+        for (auto& key : keys) {
+            auto id = key.substr(key.size() - tailLen);
+            if (hits->emplace(std::move(id), std::move(key)).second) {
+                ++hitNum_;
+            }
         }
-        keys.emplace_back(key);
-        iter->next();
+        return ret;
     }
-    for (auto& item : keys) {
-        ret = getDataRow(part, item);
+    std::unordered_set<std::string> ids;
+    for (const auto& key : keys) {
+        ids.emplace(key.substr(key.size() - tailLen));
+    }
+    for (auto it = hits->begin(); it != hits->end();) {
+        if (ids.find(it->first) == ids.end()) {
+            it = hits->erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return ret;
+}
+
+template <typename RESP>
+bool IndexExecutor<RESP>::rowsFull() const {
+    return rowNum_ >= FLAGS_max_rows_returned_per_lookup;
+}
+
+template <typename RESP>
+kvstore::ResultCode IndexExecutor<RESP>::getDataRows(PartitionID part, const IndexHits& hits) {
+    for (const auto& hit : hits) {
+        if (rowNum_ >= FLAGS_max_rows_returned_per_lookup) {
+            break;
+        }
+        auto ret = getDataRow(part, hit.second);
         if (ret != kvstore::ResultCode::SUCCEEDED) {
             return ret;
         }
     }
-    return ret;
+    return kvstore::ResultCode::SUCCEEDED;
 }
 
 template<typename RESP>
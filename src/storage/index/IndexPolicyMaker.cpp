@@ -76,7 +76,14 @@ bool IndexPolicyMaker::buildPolicy() {
          */
         auto it = scanItems_.find(col.get_name());
         if (it == scanItems_.end()) {
-            break;
+            // A field hit by an IN list only is scanned as equivalent, value by value.
+            auto in = inLists_.find(col.get_name());
+            if (in == inLists_.end()) {
+                break;
+            }
+            scanLists_[col.get_name()] = std::move(in->second);
+            inLists_.erase(in);
+            continue;
         } else if (it->second.beginBound_.rel_ != RelationType::kEQRel){
             // Stop build policy when last operator is range scan,
             // And other fields will use expression filtering.
@@ -85,12 +92,22 @@ bool IndexPolicyMaker::buildPolicy() {
     }
     // re-check operatorList_.
     // if operatorList_ is not empty, that means there are still fields to filter
-    if (!requiredFilter_ && operatorList_.size() > 0) {
+    if (!requiredFilter_ && (operatorList_.size() > 0 || !inLists_.empty())) {
         requiredFilter_ = true;
     }
     return true;
 }
 
+void IndexPolicyMaker::resetPolicy() {
+    exp_.reset();
+    index_.reset();
+    requiredFilter_ = false;
+    operatorList_.clear();
+    scanItems_.clear();
+    inLists_.clear();
+    scanLists_.clear();
+}
+
 cpp2::ErrorCode IndexPolicyMaker::traversalExpression(const Expression *expr) {
     cpp2::ErrorCode code = cpp2::ErrorCode::SUCCEEDED;
     Getters getters;
@@ -107,13 +124,31 @@ cpp2::ErrorCode IndexPolicyMaker::traversalExpression(const Expression *expr) {
     };
     switch (expr->kind()) {
         case nebula::Expression::kLogical : {
-            // OR logical expression is not allowed in graph layer.
-            // Make sure all logical expression is 'AND' at here.
+            // The only OR logical expression allowed by graph layer is an IN list,
+            // the other logical expressions are all 'AND' at here.
             auto* lExpr = dynamic_cast<const LogicalExpression*>(expr);
+            if (lExpr->op() == LogicalExpression::OR) {
+                std::string prop;
+                std::vector<VariantType> values;
+                code = collectInList(lExpr, &prop, &values);
+                if (code != cpp2::ErrorCode::SUCCEEDED) {
+                    return code;
+                }
+                if (inLists_.find(prop) != inLists_.end()) {
+                    // The other IN lists on the field are left to the expression filtering.
+                    requiredFilter_ = true;
+                } else {
+                    inLists_[prop] = std::move(values);
+                }
+                break;
+            }
             auto* left = lExpr->left();
-            traversalExpression(left);
+            code = traversalExpression(left);
+            if (code != cpp2::ErrorCode::SUCCEEDED) {
+                return code;
+            }
             auto* right = lExpr->right();
-            traversalExpression(right);
+            code = traversalExpression(right);
             break;
         }
         case nebula::Expression::kRelational : {
@@ -154,6 +189,59 @@ cpp2::ErrorCode IndexPolicyMaker::traversalExpression(const Expression *expr) {
     return code;
 }
 
+cpp2::ErrorCode IndexPolicyMaker::collectInList(const Expression *expr,
+                                                std::string *prop,
+                                                std::vector<VariantType> *values) {
+    if (expr->kind() == nebula::Expression::kLogical) {
+        auto* lExpr = dynamic_cast<const LogicalExpression*>(expr);
+        if (lExpr->op() != LogicalExpression::OR) {
+            VLOG(1) << "Not an IN list : " << expr->toString();
+            return cpp2::ErrorCode::E_INVALID_FILTER;
+        }
+        auto code = collectInList(lExpr->left(), prop, values);
+        if (code != cpp2::ErrorCode::SUCCEEDED) {
+            return code;
+        }
+        return collectInList(lExpr->right(), prop, values);
+    }
+    if (expr->kind() != nebula::Expression::kRelational) {
+        VLOG(1) << "Not an IN list : " << expr->toString();
+        return cpp2::ErrorCode::E_INVALID_FILTER;
+    }
+    auto* rExpr = dynamic_cast<const RelationalExpression*>(expr);
+    auto* left = rExpr->left();
+    auto* right = rExpr->right();
+    if (left->kind() != nebula::Expression::kAliasProp) {
+        std::swap(left, right);
+    }
+    if (rExpr->op() != RelationalExpression::Operator::EQ ||
+        left->kind() != nebula::Expression::kAliasProp) {
+        VLOG(1) << "Not an IN list : " << expr->toString();
+        return cpp2::ErrorCode::E_INVALID_FILTER;
+    }
+    const auto& name = *dynamic_cast<const AliasPropertyExpression*>(left)->prop();
+    if (!prop->empty() && *prop != name) {
+        VLOG(1) << "IN list on different fields : " << *prop << ", " << name;
+        return cpp2::ErrorCode::E_INVALID_FILTER;
+    }
+    *prop = name;
+    Getters getters;
+    getters.getAliasProp = [](const std::string&,
+                              const std::string&) -> OptVariantType {
+        return OptVariantType(Status::Error("Alias expression cannot be evaluated"));
+    };
+    auto value = right->eval(getters);
+    if (!value.ok()) {
+        VLOG(1) << "Can't evaluate the expression " << right->toString();
+        return cpp2::ErrorCode::E_INVALID_FILTER;
+    }
+    auto v = std::move(value).value();
+    if (std::find(values->begin(), values->end(), v) == values->end()) {
+        values->emplace_back(std::move(v));
+    }
+    return cpp2::ErrorCode::SUCCEEDED;
+}
+
 bool IndexPolicyMaker::exprEval(Getters &getters) {
     if (exp_ != nullptr) {
         auto value = exp_->eval(getters);
@@ -84,6 +84,11 @@ protected:
      **/
     bool buildPolicy();
 
+    /**
+     * Details Clear the policy built, before preparing the policy of another index.
+     **/
+    void resetPolicy();
+
     /**
      * Details Evaluate filter conditions.
      */
@@ -100,6 +105,15 @@ private:
 
     cpp2::ErrorCode traversalExpression(const Expression *expr);
 
+    /**
+     * Details Collect the values of an OR of equalities on the same field, for example :
+     *         c1 == 1 || c1 == 2 || c1 == 3
+     *         which is scanned as an IN list, one equivalent scan per value.
+     */
+    cpp2::ErrorCode collectInList(const Expression *expr,
+                                  std::string *prop,
+                                  std::vector<VariantType> *values);
+
     RelationalExpression::Operator reversalRelationalExprOP(RelationalExpression::Operator op);
 
     bool writeScanItem(const std::string& prop, const OperatorItem& item);
@@ -114,6 +128,10 @@ protected:
     std::vector<OperatorItem>                operatorList_;
     // map<field_name, scan_item>
     std::map<std::string, ScanBound>         scanItems_;
+    // map<field_name, values>, the IN lists of the filter
+    std::map<std::string, std::vector<VariantType>> inLists_;
+    // The IN lists used by the scan, the fields of which are not in scanItems_
+    std::map<std::string, std::vector<VariantType>> scanLists_;
 };
 }  // namespace storage
 }  // namespace nebula
@@ -0,0 +1,175 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "storage/index/IndexStatsCollector.h"
+#include "base/HyperLogLog.h"
+#include "utils/NebulaKeyUtils.h"
+#include <folly/Random.h>
+#include <folly/String.h>
+
+namespace nebula {
+namespace storage {
+
+using nebula::cpp2::SupportedType;
+
+// The values sampled of a numeric column on every host
+static constexpr size_t kSampleSize = 512;
+
+namespace {
+
+bool isNumeric(SupportedType type) {
+    return type == SupportedType::INT || type == SupportedType::TIMESTAMP ||
+           type == SupportedType::DOUBLE || type == SupportedType::FLOAT;
+}
+
+// Split the values of the index key, see NebulaKeyUtils::vertexIndexKey
+bool splitValues(folly::StringPiece key,
+                 const std::vector<nebula::cpp2::ColumnDef>& cols,
+                 size_t strCols,
+                 size_t tailLen,
+                 std::vector<folly::StringPiece>* vals) {
+    size_t offset = sizeof(PartitionID) + sizeof(IndexID);
+    if (key.size() < offset + strCols * sizeof(int32_t) + tailLen) {
+        return false;
+    }
+    auto lenOffset = key.size() - strCols * sizeof(int32_t) - tailLen;
+    vals->clear();
+    for (const auto& col : cols) {
+        size_t len = 0;
+        switch (col.get_type().get_type()) {
+            case SupportedType::BOOL:
+                len = sizeof(bool);
+                break;
+            case SupportedType::TIMESTAMP:
+            case SupportedType::INT:
+                len = sizeof(int64_t);
+                break;
+            case SupportedType::FLOAT:
+            case SupportedType::DOUBLE:
+                len = sizeof(double);
+                break;
+            case SupportedType::STRING:
+                len = *reinterpret_cast<const int32_t*>(key.data() + lenOffset);
+                lenOffset += sizeof(int32_t);
+                break;
+            default:
+                break;
+        }
+        if (offset + len > key.size()) {
+            return false;
+        }
+        vals->emplace_back(key.subpiece(offset, len));
+        offset += len;
+    }
+    return true;
+}
+
+double toDouble(folly::StringPiece raw, SupportedType type) {
+    if (type == SupportedType::INT || type == SupportedType::TIMESTAMP) {
+        return NebulaKeyUtils::decodeInt64(raw);
+    }
+    // decodeDouble changes the bytes in place
+    auto copy = raw.str();
+    return NebulaKeyUtils::decodeDouble(copy);
+}
+
+}  // namespace
+
+StatusOr<folly::dynamic> IndexStatsCollector::collect(GraphSpaceID spaceId) {
+    if (kv_ == nullptr || indexMan_ == nullptr) {
+        return Status::Error("Index manager not ready");
+    }
+    std::unordered_map<GraphSpaceID, std::vector<PartitionID>> leaders;
+    kv_->allLeader(leaders);
+    const auto& parts = leaders[spaceId];
+
+    auto indexes = folly::dynamic::array();
+    for (auto isEdge : {false, true}) {
+        auto items = isEdge ? indexMan_->getEdgeIndexes(spaceId)
+                            : indexMan_->getTagIndexes(spaceId);
+        if (!items.ok()) {
+            return items.status();
+        }
+        for (const auto& item : items.value()) {
+            auto stats = collectIndex(spaceId, parts, *item, isEdge);
+            if (!stats.ok()) {
+                return stats.status();
+            }
+            indexes.push_back(std::move(stats).value());
+        }
+    }
+    return folly::dynamic::object("indexes", std::move(indexes));
+}
+
+StatusOr<folly::dynamic> IndexStatsCollector::collectIndex(GraphSpaceID spaceId,
+                                                           const std::vector<PartitionID>& parts,
+                                                           const nebula::cpp2::IndexItem& index,
+                                                           bool isEdge) {
+    const auto& cols = index.get_fields();
+    size_t strCols = std::count_if(cols.begin(), cols.end(), [] (const auto& col) {
+        return col.get_type().get_type() == SupportedType::STRING;
+    });
+    auto tailLen = isEdge ? sizeof(VertexID) * 2 + sizeof(EdgeRanking) : sizeof(VertexID);
+
+    int64_t rows = 0;
+    std::vector<HyperLogLog> hlls(cols.size());
+    std::vector<std::vector<double>> samples(cols.size());
+    std::vector<folly::StringPiece> vals;
+    std::string prefixVals;
+    for (auto partId : parts) {
+        auto prefix = NebulaKeyUtils::indexPrefix(partId, index.get_index_id());
+        std::unique_ptr<kvstore::KVIterator> iter;
+        auto ret = kv_->prefix(spaceId, partId, prefix, &iter);
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            return Status::Error("Scan index %d of part %d failed, error %d",
+                                 index.get_index_id(), partId, static_cast<int32_t>(ret));
+        }
+        for (; iter->valid(); iter->next()) {
+            if (!splitValues(iter->key(), cols, strCols, tailLen, &vals)) {
+                continue;
+            }
+            rows++;
+            prefixVals.clear();
+            for (auto i = 0UL; i < cols.size(); i++) {
+                // Keep the lengths, so that the prefixes of different values never collide
+                auto len = static_cast<int32_t>(vals[i].size());
+                prefixVals.append(reinterpret_cast<const char*>(&len), sizeof(int32_t));
+                prefixVals.append(vals[i].data(), vals[i].size());
+                hlls[i].add(prefixVals);
+
+                auto type = cols[i].get_type().get_type();
+                if (!isNumeric(type)) {
+                    continue;
+                }
+                // Reservoir sampling
+                if (samples[i].size() < kSampleSize) {
+                    samples[i].emplace_back(toDouble(vals[i], type));
+                } else {
+                    auto pos = folly::Random::rand64(rows);
+                    if (pos < kSampleSize) {
+                        samples[i][pos] = toDouble(vals[i], type);
+                    }
+                }
+            }
+        }
+    }
+
+    auto columns = folly::dynamic::array();
+    for (auto i = 0UL; i < cols.size(); i++) {
+        auto sampled = folly::dynamic::array();
+        for (auto v : samples[i]) {
+            sampled.push_back(v);
+        }
+        columns.push_back(folly::dynamic::object("hll", folly::hexlify(hlls[i].serialize()))
+                                                ("samples", std::move(sampled)));
+    }
+    return folly::dynamic::object("id", index.get_index_id())
+                                 ("rows", rows)
+                                 ("columns", std::move(columns));
+}
+
+}  // namespace storage
+}  // namespace nebula
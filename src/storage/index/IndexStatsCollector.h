@@ -0,0 +1,48 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_INDEX_INDEXSTATSCOLLECTOR_H_
+#define STORAGE_INDEX_INDEXSTATSCOLLECTOR_H_
+
+#include "base/Base.h"
+#include "base/StatusOr.h"
+#include "kvstore/KVStore.h"
+#include "meta/IndexManager.h"
+#include <folly/dynamic.h>
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Scan the indexes of a space on the leader parts of this host, to collect:
+ *   the number of rows,
+ *   for every column, a HyperLogLog sketch of the values from the first column to it,
+ *   for every numeric column, a uniform sample of the values.
+ * The result is merged with those of the other hosts by the stats job of meta, e.g.
+ *   {"indexes": [{"id": 1, "rows": 100, "columns": [{"hll": "0a00..", "samples": [1.0]}]}]}
+ * */
+class IndexStatsCollector final {
+public:
+    IndexStatsCollector(kvstore::KVStore* kv, meta::IndexManager* indexMan)
+        : kv_(kv)
+        , indexMan_(indexMan) {}
+
+    StatusOr<folly::dynamic> collect(GraphSpaceID spaceId);
+
+private:
+    StatusOr<folly::dynamic> collectIndex(GraphSpaceID spaceId,
+                                          const std::vector<PartitionID>& parts,
+                                          const nebula::cpp2::IndexItem& index,
+                                          bool isEdge);
+
+private:
+    kvstore::KVStore*       kv_ = nullptr;
+    meta::IndexManager*     indexMan_ = nullptr;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_INDEX_INDEXSTATSCOLLECTOR_H_
@@ -20,6 +20,11 @@ void LookUpIndexProcessor::process(const cpp2::LookUpIndexRequest& req) {
         return;
     }
 
+    if (!req.get_contexts().empty()) {
+        processContexts(req);
+        return;
+    }
+
     /**
      * step 2 : build execution plan
      */
@@ -36,15 +41,7 @@ void LookUpIndexProcessor::process(const cpp2::LookUpIndexRequest& req) {
     for (auto partId : req.get_parts()) {
         auto code = executeExecutionPlan(partId);
         if (code != kvstore::ResultCode::SUCCEEDED) {
-            LOG(ERROR) << "Execute Execution Plan! ret = " << static_cast<int32_t>(code)
-                       << ", spaceId = " << spaceId_
-                       << ", partId =  " << partId;
-            if (code == kvstore::ResultCode::ERR_LEADER_CHANGED) {
-                this->handleLeaderChanged(spaceId_, partId);
-            } else {
-                this->pushResultCode(this->to(code), partId);
-            }
-            this->onFinished();
+            onPartFailed(code, partId);
             return;
         }
     }
@@ -52,6 +49,95 @@ void LookUpIndexProcessor::process(const cpp2::LookUpIndexRequest& req) {
     /**
      * step 4 : collect result.
      */
+    collectResult();
+}
+
+void LookUpIndexProcessor::processContexts(const cpp2::LookUpIndexRequest& req) {
+    const auto& contexts = req.get_contexts();
+    const auto& parts = req.get_parts();
+    // Switch to the index of the i-th context if needed, and build its plan
+    auto prepare = [&] (size_t i, bool switching) {
+        auto ret = cpp2::ErrorCode::SUCCEEDED;
+        if (switching) {
+            ret = switchIndex(contexts[i].get_index_id());
+        }
+        if (ret == cpp2::ErrorCode::SUCCEEDED) {
+            ret = buildExecutionPlan(contexts[i].get_filter());
+        }
+        if (ret != cpp2::ErrorCode::SUCCEEDED) {
+            LOG(ERROR) << "Build Execution Plan Failed, index "
+                       << contexts[i].get_index_id();
+            putResultCodes(ret, parts);
+            return false;
+        }
+        return true;
+    };
+
+    if (req.get_is_union()) {
+        std::unordered_map<PartitionID, IndexHits> hits;
+        for (auto i = 0UL; i < contexts.size(); i++) {
+            if (!prepare(i, i > 0)) {
+                return;
+            }
+            for (auto partId : parts) {
+                auto code = collectHits(partId, i == 0, true, &hits[partId]);
+                if (code != kvstore::ResultCode::SUCCEEDED) {
+                    onPartFailed(code, partId);
+                    return;
+                }
+            }
+        }
+        for (auto partId : parts) {
+            auto code = getDataRows(partId, hits[partId]);
+            if (code != kvstore::ResultCode::SUCCEEDED) {
+                onPartFailed(code, partId);
+                return;
+            }
+        }
+        collectResult();
+        return;
+    }
+
+    // An intersection is done part by part, so only the hits of one part are held,
+    // and the rows are bounded after the hits are intersected.
+    for (auto p = 0UL; p < parts.size() && !rowsFull(); p++) {
+        auto partId = parts[p];
+        IndexHits partHits;
+        for (auto i = 0UL; i < contexts.size(); i++) {
+            if (i > 0 && partHits.empty()) {
+                break;
+            }
+            if (!prepare(i, i > 0 || p > 0)) {
+                return;
+            }
+            auto code = collectHits(partId, i == 0, false, &partHits);
+            if (code != kvstore::ResultCode::SUCCEEDED) {
+                onPartFailed(code, partId);
+                return;
+            }
+        }
+        auto code = getDataRows(partId, partHits);
+        if (code != kvstore::ResultCode::SUCCEEDED) {
+            onPartFailed(code, partId);
+            return;
+        }
+    }
+    collectResult();
+}
+
+void LookUpIndexProcessor::onPartFailed(kvstore::ResultCode code, PartitionID partId) {
+    LOG(ERROR) << "Execute Execution Plan! ret = " << static_cast<int32_t>(code)
+               << ", spaceId = " << spaceId_
+               << ", partId =  " << partId;
+    if (code == kvstore::ResultCode::ERR_LEADER_CHANGED) {
+        this->handleLeaderChanged(spaceId_, partId);
+    } else {
+        this->pushResultCode(this->to(code), partId);
+    }
+    this->onFinished();
+}
+
+void LookUpIndexProcessor::collectResult() {
     if (schema_ != nullptr) {
         decltype(resp_.schema) s;
         decltype(resp_.schema.columns) cols;
@@ -25,6 +25,16 @@ public:
     void process(const cpp2::LookUpIndexRequest& req);
 
 private:
+    /**
+     * Scan the indexes of the contexts one after another, and keep the rows
+     * hit by all of them, or by any of them for a union, part by part.
+     */
+    void processContexts(const cpp2::LookUpIndexRequest& req);
+
+    void onPartFailed(kvstore::ResultCode code, PartitionID partId);
+
+    void collectResult();
+
     explicit LookUpIndexProcessor(kvstore::KVStore* kvstore,
                                   meta::SchemaManager* schemaMan,
                                   meta::IndexManager* indexMan,
@@ -25,7 +25,9 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
         indexes_ = std::move(iRet).value();
     }
     CHECK_NOTNULL(kvstore_);
-    if (indexes_.empty()) {
+    // The atomic op is needed when there are indexes or degree counters to maintain,
+    // because they depend on whether the edge exists before.
+    if (indexes_.empty() && !FLAGS_enable_degree_counter) {
         std::for_each(req.parts.begin(), req.parts.end(), [&](auto& partEdges) {
             auto partId = partEdges.first;
             std::vector<kvstore::KV> data;
@@ -55,8 +57,8 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
     }
 }
 
-std::string AddEdgesProcessor::addEdges(int64_t version, PartitionID partId,
-                                        const std::vector<cpp2::Edge>& edges) {
+folly::Optional<std::string> AddEdgesProcessor::addEdges(int64_t version, PartitionID partId,
+                                                         const std::vector<cpp2::Edge>& edges) {
     std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
 
     /*
@@ -85,26 +87,41 @@ std::string AddEdgesProcessor::addEdges(int64_t version, PartitionID partId,
         auto key = NebulaKeyUtils::edgeKey(partId, srcId, type, rank, dstId, version);
         newEdges[key] = std::move(prop);
     });
+    std::map<std::pair<VertexID, EdgeType>, int64_t> degrees;
     for (auto& e : newEdges) {
-        std::string val;
+        folly::Optional<std::string> val;
         RowReader nReader = RowReader::getEmptyRowReader();
         auto edgeType = NebulaKeyUtils::getEdgeType(e.first);
+        auto indexed = std::any_of(indexes_.begin(), indexes_.end(), [edgeType](auto& index) {
+            return edgeType == index->get_schema_id().get_edge_type();
+        });
+        if (FLAGS_enable_degree_counter || indexed) {
+            auto ret = findObsoleteIndex(partId, e.first);
+            if (ok(ret)) {
+                val = value(std::move(ret));
+            } else if (error(ret) != kvstore::ResultCode::ERR_KEY_NOT_FOUND) {
+                // Neither the index nor the degree could be maintained without knowing it
+                LOG(WARNING) << "Get the edge failed, part " << partId
+                             << ", ret " << static_cast<int32_t>(error(ret));
+                return folly::none;
+            } else if (FLAGS_enable_degree_counter) {
+                // Only a new edge changes the degree, overwriting one does not.
+                degrees[std::make_pair(NebulaKeyUtils::getSrcId(e.first), edgeType)]++;
+            }
+        }
         for (auto& index : indexes_) {
             if (edgeType == index->get_schema_id().get_edge_type()) {
                 /*
                  * step 1 , Delete old version index if exists.
                  */
-                if (val.empty()) {
-                    val = findObsoleteIndex(partId, e.first);
-                }
-                if (!val.empty()) {
+                if (val.hasValue()) {
                     auto reader = RowReader::getEdgePropReader(this->schemaMan_,
-                                                               val,
+                                                               val.value(),
                                                                spaceId_,
                                                                edgeType);
                     if (reader == nullptr) {
                         LOG(WARNING) << "Bad format row";
-                        return "";
+                        return folly::none;
                     }
                     auto oi = indexKey(partId, reader.get(), e.first, index);
                     if (!oi.empty()) {
@@ -121,7 +138,7 @@ std::string AddEdgesProcessor::addEdges(int64_t version, PartitionID partId,
                                                            edgeType);
                     if (nReader == nullptr) {
                         LOG(WARNING) << "Bad format row";
-                        return "";
+                        return folly::none;
                     }
                 }
                 auto ni = indexKey(partId, nReader.get(), e.first, index);
@@ -138,11 +155,19 @@ std::string AddEdgesProcessor::addEdges(int64_t version, PartitionID partId,
         batchHolder->put(std::move(key), std::move(prop));
     }
 
+    if (!degrees.empty()) {
+        auto ret = updateDegrees(spaceId_, partId, degrees, batchHolder.get());
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            LOG(WARNING) << "Update degree failed, part " << partId
+                         << ", ret " << static_cast<int32_t>(ret);
+            return folly::none;
+        }
+    }
     return encodeBatchValue(batchHolder->getBatch());
 }
 
-std::string AddEdgesProcessor::findObsoleteIndex(PartitionID partId,
-                                                 const folly::StringPiece& rawKey) {
+ErrorOr<kvstore::ResultCode, std::string>
+AddEdgesProcessor::findObsoleteIndex(PartitionID partId, const folly::StringPiece& rawKey) {
     auto prefix = NebulaKeyUtils::edgePrefix(partId,
                                              NebulaKeyUtils::getSrcId(rawKey),
                                              NebulaKeyUtils::getEdgeType(rawKey),
@@ -150,10 +175,10 @@ std::string AddEdgesProcessor::findObsoleteIndex(PartitionID partId,
                                              NebulaKeyUtils::getDstId(rawKey));
     std::string value;
     auto ret = doGetFirstRecord(spaceId_, partId, prefix, &value);
-    if (ret == kvstore::ResultCode::SUCCEEDED) {
-        return value;
+    if (ret != kvstore::ResultCode::SUCCEEDED) {
+        return ret;
     }
-    return "";
+    return value;
 }
 
 std::string AddEdgesProcessor::indexKey(PartitionID partId,
@@ -8,6 +8,7 @@
 #define STORAGE_MUTATE_ADDEDGESPROCESSOR_H_
 
 #include "base/Base.h"
+#include "base/ErrorOr.h"
 #include "storage/BaseProcessor.h"
 #include "kvstore/LogEncoder.h"
 #include "storage/StorageFlags.h"
@@ -34,11 +35,12 @@ private:
             : BaseProcessor<cpp2::ExecResponse>(kvstore, schemaMan, stats)
             , indexMan_(indexMan) {}
 
-    std::string addEdges(int64_t version, PartitionID partId,
-                         const std::vector<cpp2::Edge>& edges);
+    folly::Optional<std::string> addEdges(int64_t version, PartitionID partId,
+                                          const std::vector<cpp2::Edge>& edges);
 
-    std::string findObsoleteIndex(PartitionID partId,
-                                  const folly::StringPiece& rawKey);
+    // The row of the edge before, or ERR_KEY_NOT_FOUND if the edge is new
+    ErrorOr<kvstore::ResultCode, std::string> findObsoleteIndex(PartitionID partId,
+                                                                const folly::StringPiece& rawKey);
 
     std::string indexKey(PartitionID partId,
                          RowReader* reader,
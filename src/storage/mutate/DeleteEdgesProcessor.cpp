@@ -20,7 +20,7 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
         indexes_ = std::move(iRet).value();
     }
 
-    if (indexes_.empty()) {
+    if (indexes_.empty() && !FLAGS_enable_degree_counter) {
         if (FLAGS_enable_multi_versions) {
             std::for_each(req.parts.begin(), req.parts.end(), [this](const auto &partEdges) {
                 this->callingNum_ += partEdges.second.size();
@@ -82,6 +82,9 @@ DeleteEdgesProcessor::deleteEdges(GraphSpaceID spaceId,
                                   PartitionID partId,
                                   const std::vector<cpp2::EdgeKey>& edges) {
     std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
+    std::map<std::pair<VertexID, EdgeType>, int64_t> degrees;
+    // The same edge may appear more than once in the request
+    std::unordered_set<std::string> deleted;
     for (auto& edge : edges) {
         auto type = edge.edge_type;
         auto srcId = edge.src;
@@ -101,6 +104,9 @@ DeleteEdgesProcessor::deleteEdges(GraphSpaceID spaceId,
              * just get the latest version edge for index.
              */
             if (isLatestVE) {
+                if (FLAGS_enable_degree_counter && deleted.emplace(prefix).second) {
+                    degrees[std::make_pair(srcId, type)]--;
+                }
                 RowReader reader = RowReader::getEmptyRowReader();
                 for (auto& index : indexes_) {
                     auto indexId = index->get_index_id();
@@ -135,6 +141,14 @@ DeleteEdgesProcessor::deleteEdges(GraphSpaceID spaceId,
             iter->next();
         }
     }
+    if (!degrees.empty()) {
+        auto ret = updateDegrees(spaceId, partId, degrees, batchHolder.get());
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            LOG(WARNING) << "Update degree failed, part " << partId
+                         << ", ret " << static_cast<int32_t>(ret);
+            return folly::none;
+        }
+    }
     return encodeBatchValue(batchHolder->getBatch());
 }
 }  // namespace storage
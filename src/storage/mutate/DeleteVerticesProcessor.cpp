@@ -6,6 +6,7 @@
 
 #include "storage/mutate/DeleteVerticesProcessor.h"
 #include "utils/NebulaKeyUtils.h"
+#include "storage/StorageFlags.h"
 
 DECLARE_bool(enable_vertex_cache);
 
@@ -13,69 +14,154 @@ namespace nebula {
 namespace storage {
 
 void DeleteVerticesProcessor::process(const cpp2::DeleteVerticesRequest& req) {
-    auto spaceId = req.get_space_id();
-    const auto& partVertices = req.get_parts();
-    auto iRet = indexMan_->getTagIndexes(spaceId);
-    if (iRet.ok()) {
-        indexes_ = std::move(iRet).value();
+    if (client_ != nullptr) {
+        CHECK_NOTNULL(executor_);
+    }
+    spaceId_ = req.get_space_id();
+    parts_ = req.get_parts();
+    auto tagRet = indexMan_->getTagIndexes(spaceId_);
+    if (tagRet.ok()) {
+        tagIndexes_ = std::move(tagRet).value();
+    }
+    auto edgeRet = indexMan_->getEdgeIndexes(spaceId_);
+    if (edgeRet.ok()) {
+        edgeIndexes_ = std::move(edgeRet).value();
     }
 
-    if (indexes_.empty()) {
-        std::for_each(partVertices.begin(), partVertices.end(), [this](auto& pv) {
-            this->callingNum_ += pv.second.size();
-        });
+    // The reverse edges whose other end is deleted in the same request
+    // will be removed by the range remove of that vertex.
+    std::unordered_set<VertexID> deleted;
+    for (auto& pv : parts_) {
+        deleted.insert(pv.second.begin(), pv.second.end());
+    }
+    for (auto& pv : parts_) {
+        auto ret = scanVertices(pv.first, pv.second, deleted);
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            VLOG(3) << "Error! ret = " << static_cast<int32_t>(ret)
+                    << ", spaceId " << spaceId_;
+            this->handleErrorCode(ret, spaceId_, pv.first);
+            this->onFinished();
+            return;
+        }
+    }
+
+    if (reverseEdges_.empty()) {
+        deleteLocalVertices();
+        return;
+    }
 
-        std::vector<std::string> keys;
-        keys.reserve(32);
-        for (auto pv = partVertices.begin(); pv != partVertices.end(); pv++) {
-            auto part = pv->first;
-            const auto& vertices = pv->second;
-            for (auto v = vertices.begin(); v != vertices.end(); v++) {
-                auto prefix = NebulaKeyUtils::vertexPrefix(part, *v);
-                std::unique_ptr<kvstore::KVIterator> iter;
-                auto ret = this->kvstore_->prefix(spaceId, part, prefix, &iter);
-                if (ret != kvstore::ResultCode::SUCCEEDED) {
-                    VLOG(3) << "Error! ret = " << static_cast<int32_t>(ret)
-                            << ", spaceID " << spaceId;
-                    this->handleErrorCode(ret, spaceId, part);
-                    this->onFinished();
-                    return;
+    VLOG(1) << "Delete " << reverseEdges_.size() << " reverse edges in space " << spaceId_;
+    deleteReverseEdges(0).thenValue([this] (cpp2::ErrorCode code) {
+        if (code != cpp2::ErrorCode::SUCCEEDED) {
+            // Nothing of the local vertices has been deleted, so the request
+            // could be retried as a whole.
+            for (auto& pv : parts_) {
+                this->pushResultCode(code, pv.first);
+            }
+            this->onFinished();
+            return;
+        }
+        deleteLocalVertices();
+    });
+}
+
+kvstore::ResultCode
+DeleteVerticesProcessor::scanVertices(PartitionID partId,
+                                      const std::vector<VertexID>& vertices,
+                                      const std::unordered_set<VertexID>& deleted) {
+    bool evictCache = FLAGS_enable_vertex_cache && vertexCache_ != nullptr;
+    if (!evictCache && client_ == nullptr) {
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+    for (auto& vertex : vertices) {
+        auto prefix = NebulaKeyUtils::vertexPrefix(partId, vertex);
+        std::unique_ptr<kvstore::KVIterator> iter;
+        auto ret = this->kvstore_->prefix(spaceId_, partId, prefix, &iter);
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            return ret;
+        }
+        // The versions of the same tag or edge are adjacent, only the first one is used.
+        TagID lastTagId = -1;
+        EdgeType lastType = 0;
+        EdgeRanking lastRank = 0;
+        VertexID lastDst = 0;
+        for (; iter->valid(); iter->next()) {
+            auto key = iter->key();
+            if (NebulaKeyUtils::isVertex(key)) {
+                auto tagId = NebulaKeyUtils::getTagId(key);
+                if (evictCache && tagId != lastTagId) {
+                    VLOG(3) << "Evict vertex cache for VID " << vertex << ", TagID " << tagId;
+                    vertexCache_->evict(std::make_pair(vertex, tagId));
+                    lastTagId = tagId;
+                }
+            } else if (client_ != nullptr && NebulaKeyUtils::isEdge(key)) {
+                auto type = NebulaKeyUtils::getEdgeType(key);
+                auto rank = NebulaKeyUtils::getRank(key);
+                auto dst = NebulaKeyUtils::getDstId(key);
+                if (type == lastType && rank == lastRank && dst == lastDst) {
+                    continue;
                 }
-                keys.clear();
-                while (iter->valid()) {
-                    auto key = iter->key();
-                    if (NebulaKeyUtils::isVertex(key)) {
-                        auto tag = NebulaKeyUtils::getTagId(key);
-                        // Evict vertices from cache
-                        if (FLAGS_enable_vertex_cache && vertexCache_ != nullptr) {
-                            VLOG(3) << "Evict vertex cache for VID " << *v << ", TagID " << tag;
-                            vertexCache_->evict(std::make_pair(*v, tag));
-                        }
-                        keys.emplace_back(key.str());
-                    }
-                    iter->next();
+                lastType = type;
+                lastRank = rank;
+                lastDst = dst;
+                if (deleted.count(dst) > 0) {
+                    continue;
                 }
-                doRemove(spaceId, part, keys);
+                cpp2::EdgeKey edgeKey;
+                edgeKey.set_src(dst);
+                edgeKey.set_edge_type(-type);
+                edgeKey.set_ranking(rank);
+                edgeKey.set_dst(vertex);
+                reverseEdges_.emplace_back(std::move(edgeKey));
             }
         }
-    } else {
-        callingNum_ = req.parts.size();
-        std::for_each(req.parts.begin(), req.parts.end(), [spaceId, this](auto &pv) {
-            auto partId = pv.first;
-            auto atomic = [spaceId,
-                           partId,
-                           v = std::move(pv.second),
-                           this]() -> folly::Optional<std::string> {
-                return deleteVertices(spaceId, partId, v);
-            };
-
-            auto callback = [spaceId, partId, this](kvstore::ResultCode code) {
-                VLOG(3) << "partId:" << partId << ", code:" << static_cast<int32_t>(code);
-                handleAsync(spaceId, partId, code);
-            };
-            this->kvstore_->asyncAtomicOp(spaceId, partId, atomic, callback);
-        });
     }
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+folly::Future<cpp2::ErrorCode> DeleteVerticesProcessor::deleteReverseEdges(size_t offset) {
+    if (offset >= reverseEdges_.size()) {
+        return folly::makeFuture(cpp2::ErrorCode::SUCCEEDED);
+    }
+    auto end = std::min(offset + static_cast<size_t>(FLAGS_cascade_delete_batch_num),
+                        reverseEdges_.size());
+    std::vector<cpp2::EdgeKey> edges(reverseEdges_.begin() + offset,
+                                     reverseEdges_.begin() + end);
+    return client_->deleteEdges(spaceId_, std::move(edges))
+        .via(executor_)
+        .then([this, end] (folly::Try<StorageRpcResponse<cpp2::ExecResponse>>&& t) {
+            if (t.hasException()) {
+                LOG(ERROR) << "Delete reverse edges failed: " << t.exception().what();
+                return folly::makeFuture(cpp2::ErrorCode::E_RPC_FAILURE);
+            }
+            auto& resp = t.value();
+            if (!resp.succeeded()) {
+                LOG(ERROR) << "Delete reverse edges partially failed, completeness "
+                           << resp.completeness() << "%";
+                auto& failedParts = resp.failedParts();
+                return folly::makeFuture(failedParts.empty()
+                                         ? cpp2::ErrorCode::E_RPC_FAILURE
+                                         : failedParts.begin()->second);
+            }
+            return deleteReverseEdges(end);
+        });
+}
+
+void DeleteVerticesProcessor::deleteLocalVertices() {
+    callingNum_ = parts_.size();
+    std::for_each(parts_.begin(), parts_.end(), [this](auto& pv) {
+        auto partId = pv.first;
+        const auto& vertices = pv.second;
+        auto atomic = [partId, &vertices, this]() -> folly::Optional<std::string> {
+            return deleteVertices(spaceId_, partId, vertices);
+        };
+
+        auto callback = [partId, this](kvstore::ResultCode code) {
+            VLOG(3) << "partId:" << partId << ", code:" << static_cast<int32_t>(code);
+            handleAsync(spaceId_, partId, code);
+        };
+        this->kvstore_->asyncAtomicOp(spaceId_, partId, atomic, callback);
+    });
 }
 
 folly::Optional<std::string>
@@ -84,73 +170,100 @@ DeleteVerticesProcessor::deleteVertices(GraphSpaceID spaceId,
                                         const std::vector<VertexID>& vertices) {
     std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
     for (auto& vertex : vertices) {
-        auto prefix = NebulaKeyUtils::vertexPrefix(partId, vertex);
-        std::unique_ptr<kvstore::KVIterator> iter;
-        auto ret = this->kvstore_->prefix(spaceId, partId, prefix, &iter);
-        if (ret != kvstore::ResultCode::SUCCEEDED) {
-            VLOG(3) << "Error! ret = " << static_cast<int32_t>(ret)
-                    << ", spaceId " << spaceId;
-            return folly::none;
-        }
-        TagID latestVVId = -1;
-        while (iter->valid()) {
-            auto key = iter->key();
-            if (!NebulaKeyUtils::isVertex(key)) {
-                iter->next();
+        // Index depends on the latest version of the tag, which is the first one.
+        for (auto& index : tagIndexes_) {
+            auto tagId = index->get_schema_id().get_tag_id();
+            auto prefix = NebulaKeyUtils::vertexPrefix(partId, vertex, tagId);
+            std::unique_ptr<kvstore::KVIterator> iter;
+            auto ret = this->kvstore_->prefix(spaceId, partId, prefix, &iter);
+            if (ret != kvstore::ResultCode::SUCCEEDED) {
+                VLOG(3) << "Error! ret = " << static_cast<int32_t>(ret)
+                        << ", spaceId " << spaceId;
+                return folly::none;
+            }
+            if (!iter->valid()) {
                 continue;
             }
-            auto tagId = NebulaKeyUtils::getTagId(key);
-            if (FLAGS_enable_vertex_cache && vertexCache_ != nullptr) {
-                VLOG(3) << "Evict vertex cache for vertex ID " << vertex << ", tagId " << tagId;
-                vertexCache_->evict(std::make_pair(vertex, tagId));
+            auto reader = RowReader::getTagPropReader(this->schemaMan_,
+                                                      iter->val(),
+                                                      spaceId,
+                                                      tagId);
+            if (reader == nullptr) {
+                LOG(WARNING) << "Bad format row";
+                return folly::none;
+            }
+            auto values = collectIndexValues(reader.get(), index->get_fields());
+            if (!values.ok()) {
+                continue;
             }
+            auto indexKey = NebulaKeyUtils::vertexIndexKey(partId,
+                                                           index->get_index_id(),
+                                                           vertex,
+                                                           values.value());
+            batchHolder->remove(std::move(indexKey));
+        }
 
-            /**
-            * example ,the prefix result as below :
-            *     V1_tag1_version3
-            *     V1_tag1_version2
-             *     V1_tag1_version1
-             *     V1_tag2_version3
-             *     V1_tag2_version2
-             *     V1_tag2_version1
-             *     V1_tag3_version3
-             *     V1_tag3_version2
-             *     V1_tag3_version1
-             * Because index depends on latest version of tag.
-             * So only V1_tag1_version3, V1_tag2_version3 and V1_tag3_version3 are needed,
-             * Using newlyVertexId to identify if it is the latest version
-             */
-            if (latestVVId != tagId) {
-                RowReader reader = RowReader::getEmptyRowReader();
-                for (auto& index : indexes_) {
-                    auto indexId = index->get_index_id();
-                    if (index->get_schema_id().get_tag_id() == tagId) {
-                        if (reader == nullptr) {
-                            reader = RowReader::getTagPropReader(this->schemaMan_,
-                                                                 iter->val(),
-                                                                 spaceId,
-                                                                 tagId);
-                            if (reader == nullptr) {
-                                LOG(WARNING) << "Bad format row";
-                                return folly::none;
-                            }
-                        }
-                        const auto& cols = index->get_fields();
-                        auto values = collectIndexValues(reader.get(), cols);
-                        if (!values.ok()) {
-                            continue;
-                        }
-                        auto indexKey = NebulaKeyUtils::vertexIndexKey(partId,
-                                                                       indexId,
-                                                                       vertex,
-                                                                       values.value());
-                        batchHolder->remove(std::move(indexKey));
-                    }
+        // Only the out-edges are indexed, the indexes of the in-edges are
+        // removed together with the reverse edges on the other parts.
+        for (auto& index : edgeIndexes_) {
+            auto type = index->get_schema_id().get_edge_type();
+            auto prefix = NebulaKeyUtils::edgePrefix(partId, vertex, type);
+            std::unique_ptr<kvstore::KVIterator> iter;
+            auto ret = this->kvstore_->prefix(spaceId, partId, prefix, &iter);
+            if (ret != kvstore::ResultCode::SUCCEEDED) {
+                VLOG(3) << "Error! ret = " << static_cast<int32_t>(ret)
+                        << ", spaceId " << spaceId;
+                return folly::none;
+            }
+            bool first = true;
+            EdgeRanking lastRank = 0;
+            VertexID lastDst = 0;
+            for (; iter->valid(); iter->next()) {
+                auto key = iter->key();
+                auto rank = NebulaKeyUtils::getRank(key);
+                auto dst = NebulaKeyUtils::getDstId(key);
+                if (!first && rank == lastRank && dst == lastDst) {
+                    continue;
+                }
+                first = false;
+                lastRank = rank;
+                lastDst = dst;
+                auto reader = RowReader::getEdgePropReader(this->schemaMan_,
+                                                           iter->val(),
+                                                           spaceId,
+                                                           type);
+                if (reader == nullptr) {
+                    LOG(WARNING) << "Bad format row!";
+                    return folly::none;
                 }
-                latestVVId = tagId;
+                auto values = collectIndexValues(reader.get(), index->get_fields());
+                if (!values.ok()) {
+                    continue;
+                }
+                auto indexKey = NebulaKeyUtils::edgeIndexKey(partId,
+                                                             index->get_index_id(),
+                                                             vertex,
+                                                             rank,
+                                                             dst,
+                                                             values.value());
+                batchHolder->remove(std::move(indexKey));
+            }
+        }
+
+        // All tags and edges of the vertex, no matter how many, in one range.
+        batchHolder->rangeRemove(NebulaKeyUtils::vertexPrefix(partId, vertex),
+                                 NebulaKeyUtils::vertexRangeEnd(partId, vertex));
+
+        if (FLAGS_enable_degree_counter) {
+            std::unique_ptr<kvstore::KVIterator> iter;
+            auto prefix = NebulaKeyUtils::degreePrefix(partId, vertex);
+            auto ret = kvstore_->prefix(spaceId, partId, prefix, &iter);
+            if (ret != kvstore::ResultCode::SUCCEEDED) {
+                return folly::none;
+            }
+            for (; iter->valid(); iter->next()) {
+                batchHolder->remove(iter->key().str());
             }
-            batchHolder->remove(key.str());
-            iter->next();
         }
     }
     return encodeBatchValue(batchHolder->getBatch());
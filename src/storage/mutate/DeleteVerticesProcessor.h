@@ -10,18 +10,36 @@
 #include "base/Base.h"
 #include "kvstore/LogEncoder.h"
 #include "storage/BaseProcessor.h"
+#include "storage/client/StorageClient.h"
 
 namespace nebula {
 namespace storage {
 
+/**
+ * Delete the vertices together with all their edges.
+ *
+ * Step 1: Scan every vertex to evict the vertex cache, and collect the reverse
+ *         edges which are stored on the parts of the other end.
+ * Step 2: Delete the reverse edges through StorageClient, in batches of
+ *         FLAGS_cascade_delete_batch_num edges. Their indexes are cleaned up by
+ *         the DeleteEdgesProcessor of the owner parts.
+ * Step 3: Delete the tags and edges of each vertex with a single range remove,
+ *         together with the indexes of the tags and out-edges, in one raft log per part.
+ *
+ * If no StorageClient is provided, step 2 is skipped and only the data in the
+ * local parts will be deleted.
+ * */
 class DeleteVerticesProcessor : public BaseProcessor<cpp2::ExecResponse> {
 public:
     static DeleteVerticesProcessor* instance(kvstore::KVStore* kvstore,
                                              meta::SchemaManager* schemaMan,
                                              meta::IndexManager* indexMan,
                                              stats::Stats* stats,
-                                             VertexCache* cache = nullptr) {
-        return new DeleteVerticesProcessor(kvstore, schemaMan, indexMan, stats, cache);
+                                             VertexCache* cache = nullptr,
+                                             StorageClient* client = nullptr,
+                                             folly::Executor* executor = nullptr) {
+        return new DeleteVerticesProcessor(kvstore, schemaMan, indexMan, stats,
+                                           cache, client, executor);
     }
 
     void process(const cpp2::DeleteVerticesRequest& req);
@@ -31,10 +49,23 @@ private:
                                      meta::SchemaManager* schemaMan,
                                      meta::IndexManager* indexMan,
                                      stats::Stats* stats,
-                                     VertexCache* cache)
+                                     VertexCache* cache,
+                                     StorageClient* client,
+                                     folly::Executor* executor)
             : BaseProcessor<cpp2::ExecResponse>(kvstore, schemaMan, stats)
             , indexMan_(indexMan)
-            , vertexCache_(cache) {}
+            , vertexCache_(cache)
+            , client_(client)
+            , executor_(executor) {}
+
+    // Evict the vertex cache, and collect the reverse edges if client_ is provided.
+    kvstore::ResultCode scanVertices(PartitionID partId,
+                                     const std::vector<VertexID>& vertices,
+                                     const std::unordered_set<VertexID>& deleted);
+
+    folly::Future<cpp2::ErrorCode> deleteReverseEdges(size_t offset);
+
+    void deleteLocalVertices();
 
     folly::Optional<std::string>
     deleteVertices(GraphSpaceID spaceId,
@@ -44,7 +75,13 @@ private:
 private:
     meta::IndexManager*                                   indexMan_{nullptr};
     VertexCache*                                          vertexCache_{nullptr};
-    std::vector<std::shared_ptr<nebula::cpp2::IndexItem>> indexes_;
+    StorageClient*                                        client_{nullptr};
+    folly::Executor*                                      executor_{nullptr};
+    GraphSpaceID                                          spaceId_;
+    std::unordered_map<PartitionID, std::vector<VertexID>> parts_;
+    std::vector<cpp2::EdgeKey>                            reverseEdges_;
+    std::vector<std::shared_ptr<nebula::cpp2::IndexItem>> tagIndexes_;
+    std::vector<std::shared_ptr<nebula::cpp2::IndexItem>> edgeIndexes_;
 };
 
 
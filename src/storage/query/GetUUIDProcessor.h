@@ -22,9 +22,20 @@ public:
         return new GetUUIDProcessor(kvstore);
     }
 
-    void process(const cpp2::GetUUIDReq& req) {
+    /**
+     * The new vertex id of the name, the high 32 bits are from the hash of the name,
+     * and the low 32 bits from the current time.
+     * */
+    static VertexID newVertexId(const std::string& name) {
         constexpr size_t hashMask = 0xFFFFFFFF00000000;
         constexpr size_t timeMask = 0x00000000FFFFFFFF;
+        MurmurHash2 hashFunc;
+        auto hashValue = hashFunc(name);
+        auto now = time::WallClock::fastNowInSec();
+        return (hashValue & hashMask) | (now & timeMask);
+    }
+
+    void process(const cpp2::GetUUIDReq& req) {
         CHECK_NOTNULL(kvstore_);
         auto spaceId = req.get_space_id();
         auto partId = req.get_part_id();
@@ -36,10 +47,7 @@ public:
         // try to get the corresponding vertex id
         if (ret != kvstore::ResultCode::SUCCEEDED) {
             // need to generate new vertex id of this uuid
-            MurmurHash2 hashFunc;
-            auto hashValue = hashFunc(name);
-            auto now = time::WallClock::fastNowInSec();
-            vId = (hashValue & hashMask) | (now & timeMask);
+            vId = newVertexId(name);
             val.append(reinterpret_cast<char*>(&vId), sizeof(VertexID));
             std::vector<kvstore::KV> data;
             data.emplace_back(std::move(key), std::move(val));
@@ -0,0 +1,89 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_QUERY_GETUUIDSPROCESSOR_H_
+#define STORAGE_QUERY_GETUUIDSPROCESSOR_H_
+
+#include "base/Base.h"
+#include "storage/BaseProcessor.h"
+#include "storage/query/GetUUIDProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Get the vertex ids of a batch of names. The ids of the new names in a part are
+ * written in one raft log, rather than one log per name.
+ * */
+class GetUUIDsProcessor : public BaseProcessor<cpp2::GetUUIDsResp> {
+public:
+    static GetUUIDsProcessor* instance(kvstore::KVStore* kvstore) {
+        return new GetUUIDsProcessor(kvstore);
+    }
+
+    void process(const cpp2::GetUUIDsReq& req) {
+        CHECK_NOTNULL(kvstore_);
+        auto spaceId = req.get_space_id();
+        callingNum_ = req.get_parts().size();
+        if (callingNum_ == 0) {
+            onFinished();
+            return;
+        }
+
+        for (auto& part : req.get_parts()) {
+            auto partId = part.first;
+            std::unordered_map<std::string, VertexID> ids;
+            std::vector<kvstore::KV> data;
+            for (auto& name : part.second) {
+                if (ids.count(name) != 0) {
+                    continue;
+                }
+                auto key = NebulaKeyUtils::uuidKey(partId, name.c_str());
+                std::string val;
+                auto ret = kvstore_->get(spaceId, partId, key, &val);
+                VertexID vId;
+                if (ret == kvstore::ResultCode::SUCCEEDED) {
+                    CHECK_EQ(val.size(), sizeof(VertexID));
+                    vId = *reinterpret_cast<const VertexID*>(val.c_str());
+                } else {
+                    // need to generate new vertex id of this uuid
+                    vId = GetUUIDProcessor::newVertexId(name);
+                    val.assign(reinterpret_cast<char*>(&vId), sizeof(VertexID));
+                    data.emplace_back(std::move(key), std::move(val));
+                }
+                ids.emplace(name, vId);
+            }
+
+            if (data.empty()) {
+                addIds(std::move(ids));
+                handleAsync(spaceId, partId, kvstore::ResultCode::SUCCEEDED);
+                continue;
+            }
+            kvstore_->asyncMultiPut(spaceId, partId, std::move(data),
+                                    [spaceId, partId, ids = std::move(ids), this]
+                                    (kvstore::ResultCode code) mutable {
+                if (code == kvstore::ResultCode::SUCCEEDED) {
+                    addIds(std::move(ids));
+                }
+                handleAsync(spaceId, partId, code);
+            });
+        }
+    }
+
+private:
+    explicit GetUUIDsProcessor(kvstore::KVStore* kvstore)
+            : BaseProcessor<cpp2::GetUUIDsResp>(kvstore, nullptr) {}
+
+    void addIds(std::unordered_map<std::string, VertexID> ids) {
+        std::lock_guard<std::mutex> g(lock_);
+        resp_.ids.insert(ids.begin(), ids.end());
+    }
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_QUERY_GETUUIDSPROCESSOR_H_
@@ -23,7 +23,8 @@ const std::unordered_map<std::string, PropContext::PropInKeyType> kPropsInKey_ =
     {"_src", PropContext::PropInKeyType::SRC},
     {"_dst", PropContext::PropInKeyType::DST},
     {"_type", PropContext::PropInKeyType::TYPE},
-    {"_rank", PropContext::PropInKeyType::RANK}
+    {"_rank", PropContext::PropInKeyType::RANK},
+    {"_degree", PropContext::PropInKeyType::DEGREE}
 };
 
 using EdgeProcessor = std::function<void(RowReader reader, folly::StringPiece key)>;
@@ -52,6 +53,16 @@ protected:
         , executor_(executor)
         , vertexCache_(cache) {}
 
+    /**
+     * Set up the limits and build the contexts from the request.
+     * */
+    cpp2::ErrorCode prepare(const cpp2::GetNeighborsRequest& req);
+
+    /**
+     * Push the result codes of the failed parts in the results of buckets.
+     * */
+    void handleBucketResults(const std::vector<folly::Try<std::vector<OneVertexResp>>>& results);
+
     /**
      * Check whether current operation on the data is valid or not.
      * */
@@ -115,6 +126,15 @@ protected:
 
     std::vector<Bucket> genBuckets(const cpp2::GetNeighborsRequest& req);
 
+    /**
+     * Balance the buckets by the scan cost of each vertex estimated from the degree
+     * counters, so the vertices with huge number of edges are spread across handlers.
+     * */
+    std::vector<Bucket> genBucketsByCost(const cpp2::GetNeighborsRequest& req,
+                                         int32_t bucketsNum);
+
+    int64_t scanCost(PartitionID partId, VertexID vId);
+
     folly::Future<std::vector<OneVertexResp>> asyncProcessBucket(
         BucketIdx bucketIdx, Bucket bucket);
 
@@ -151,6 +171,10 @@ protected:
     std::unordered_map<EdgeType, std::pair<std::string, int64_t>> edgeTTLInfo_;
 
     std::unordered_map<TagID, std::pair<std::string, int64_t>> tagTTLInfo_;
+
+    // The max edges returned for one vertex on each edge type in this request
+    int64_t edgeLimit_ = std::numeric_limits<int64_t>::max();
+    bool sampling_ = false;
 };
 
 }  // namespace storage
@@ -6,6 +6,7 @@
 #include "storage/query/QueryBaseProcessor.h"
 #include "utils/NebulaKeyUtils.h"
 #include <algorithm>
+#include <queue>
 #include "dataman/RowReader.h"
 #include "dataman/RowWriter.h"
 #include "meta/NebulaSchemaProvider.h"
@@ -115,6 +116,11 @@ cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkAndBuildContexts(const REQ&
 
                 auto it = kPropsInKey_.find(col.name);
                 if (it != kPropsInKey_.end()) {
+                    if (it->second == PropContext::PropInKeyType::DEGREE &&
+                        !FLAGS_enable_degree_counter) {
+                        VLOG(1) << "The degree counter is disabled";
+                        return cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
+                    }
                     prop.pikType_ = it->second;
                     if (prop.pikType_ == PropContext::PropInKeyType::SRC ||
                         prop.pikType_ == PropContext::PropInKeyType::DST) {
@@ -300,6 +306,9 @@ bool QueryBaseProcessor<REQ, RESP>::checkExp(const Expression* exp) {
             }
 
             const auto* propName = edgeExp->prop();
+            if (*propName == _DEGREE) {
+                return FLAGS_enable_degree_counter;
+            }
             auto field = schema->field(*propName);
             if (field == nullptr) {
                 VLOG(1) << "Can't find related prop " << *propName << " on edge "
@@ -352,6 +361,19 @@ void QueryBaseProcessor<REQ, RESP>::collectProps(RowReader* reader,
                 case PropContext::PropInKeyType::RANK:
                     collector->collectInt64(NebulaKeyUtils::getRank(key), prop);
                     continue;
+                case PropContext::PropInKeyType::DEGREE: {
+                    int64_t degree = 0;
+                    auto ret = this->getDegree(spaceId_,
+                                               NebulaKeyUtils::getPart(key),
+                                               NebulaKeyUtils::getSrcId(key),
+                                               NebulaKeyUtils::getEdgeType(key),
+                                               &degree);
+                    if (ret != kvstore::ResultCode::SUCCEEDED) {
+                        LOG(ERROR) << "Get degree failed, ret " << static_cast<int32_t>(ret);
+                    }
+                    collector->collectInt64(degree, prop);
+                    continue;
+                }
             }
         }
         if (reader != nullptr) {
@@ -492,15 +514,14 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
     EdgeRanking lastRank  = -1;
     VertexID    lastDstId = 0;
     bool        firstLoop = true;
-    int         cnt = 0;
+    int64_t     cnt = 0;
     bool onlyStructure = onlyStructures_[edgeType];
     Getters getters;
 
     auto schema = this->schemaMan_->getEdgeSchema(spaceId_, std::abs(edgeType));
     auto retTTL = getEdgeTTLInfo(edgeType);
     for (; iter->valid(); iter->next()) {
-        if (!FLAGS_enable_reservoir_sampling
-                && !(cnt < FLAGS_max_edge_returned_per_vertex)) {
+        if (!sampling_ && !(cnt < edgeLimit_)) {
             break;
         }
         auto key = iter->key();
@@ -555,6 +576,17 @@ kvstore::ResultCode QueryBaseProcessor<REQ, RESP>::collectEdgeProps(
                         return NebulaKeyUtils::getRank(key);
                     } else if (prop == _TYPE) {
                         return static_cast<int64_t>(NebulaKeyUtils::getEdgeType(key));
+                    } else if (prop == _DEGREE) {
+                        int64_t degree = 0;
+                        auto ret = this->getDegree(spaceId_,
+                                                   NebulaKeyUtils::getPart(key),
+                                                   NebulaKeyUtils::getSrcId(key),
+                                                   NebulaKeyUtils::getEdgeType(key),
+                                                   &degree);
+                        if (ret != kvstore::ResultCode::SUCCEEDED) {
+                            return Status::Error("Get degree failed");
+                        }
+                        return degree;
                     }
 
                     auto res = RowReader::getPropByName(reader.get(), prop);
@@ -647,6 +679,9 @@ std::vector<Bucket> QueryBaseProcessor<REQ, RESP>::genBuckets(
     auto bucketsNum = getBucketsNum(verticesNum,
                                     FLAGS_min_vertices_per_bucket,
                                     FLAGS_max_handlers_per_req);
+    if (FLAGS_enable_degree_counter && bucketsNum > 1) {
+        return genBucketsByCost(req, bucketsNum);
+    }
     buckets.resize(bucketsNum);
     auto vNumPerBucket = verticesNum / bucketsNum;
     auto leftVertices = verticesNum % bucketsNum;
@@ -666,6 +701,53 @@ std::vector<Bucket> QueryBaseProcessor<REQ, RESP>::genBuckets(
     return buckets;
 }
 
+template<typename REQ, typename RESP>
+std::vector<Bucket> QueryBaseProcessor<REQ, RESP>::genBucketsByCost(
+                                                    const cpp2::GetNeighborsRequest& req,
+                                                    int32_t bucketsNum) {
+    // cost, partId, vId
+    std::vector<std::tuple<int64_t, PartitionID, VertexID>> costs;
+    for (auto& pv : req.get_parts()) {
+        for (auto& vId : pv.second) {
+            costs.emplace_back(scanCost(pv.first, vId), pv.first, vId);
+        }
+    }
+    // Longest processing time first: always put the most expensive vertex left into
+    // the cheapest bucket, so a hub vertex gets a handler of its own.
+    std::stable_sort(costs.begin(), costs.end(), [] (const auto& l, const auto& r) {
+        return std::get<0>(l) > std::get<0>(r);
+    });
+    using BucketCost = std::pair<int64_t, BucketIdx>;
+    std::priority_queue<BucketCost, std::vector<BucketCost>, std::greater<BucketCost>> heap;
+    for (int32_t i = 0; i < bucketsNum; i++) {
+        heap.emplace(0, i);
+    }
+    std::vector<Bucket> buckets(bucketsNum);
+    for (auto& c : costs) {
+        auto cheapest = heap.top();
+        heap.pop();
+        buckets[cheapest.second].vertices_.emplace_back(std::get<1>(c), std::get<2>(c));
+        heap.emplace(cheapest.first + std::get<0>(c), cheapest.second);
+    }
+    return buckets;
+}
+
+template<typename REQ, typename RESP>
+int64_t QueryBaseProcessor<REQ, RESP>::scanCost(PartitionID partId, VertexID vId) {
+    // One for the tags
+    int64_t cost = 1;
+    for (auto& ec : edgeContexts_) {
+        int64_t degree = 0;
+        auto ret = this->getDegree(spaceId_, partId, vId, ec.first, &degree);
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            continue;
+        }
+        // The scan stops at the limit unless sampling, which has to go through all edges
+        cost += sampling_ ? degree : std::min(degree, edgeLimit_);
+    }
+    return cost;
+}
+
 template<typename REQ, typename RESP>
 void QueryBaseProcessor<REQ, RESP>::buildTTLInfoAndRespSchema() {
     if (!this->tagContexts_.empty()) {
@@ -797,8 +879,7 @@ void QueryBaseProcessor<REQ, RESP>::buildTTLInfoAndRespSchema() {
 }
 
 template<typename REQ, typename RESP>
-void QueryBaseProcessor<REQ, RESP>::process(const cpp2::GetNeighborsRequest& req) {
-    CHECK_NOTNULL(executor_);
+cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::prepare(const cpp2::GetNeighborsRequest& req) {
     spaceId_ = req.get_space_id();
     int32_t returnColumnsNum = req.get_return_columns().size();
     VLOG(1) << "Total edge types " << req.edge_types.size()
@@ -807,12 +888,48 @@ void QueryBaseProcessor<REQ, RESP>::process(const cpp2::GetNeighborsRequest& req
             << (returnColumnsNum > 0 ? req.get_return_columns()[0].name : "");
     VLOG(3) << "Receive request, spaceId " << spaceId_ << ", return cols " << returnColumnsNum;
     tagContexts_.reserve(returnColumnsNum);
+    edgeLimit_ = FLAGS_max_edge_returned_per_vertex;
+    if (req.__isset.limit && req.limit >= 0) {
+        edgeLimit_ = std::min(edgeLimit_, req.limit);
+    }
+    // Sampling without a limit is just returning all the edges
+    sampling_ = (FLAGS_enable_reservoir_sampling || (req.__isset.random && req.random))
+                && edgeLimit_ < std::numeric_limits<int32_t>::max();
 
     if (req.__isset.edge_types) {
         initEdgeContext(req.edge_types);
     }
 
-    auto retCode = checkAndBuildContexts(req);
+    return checkAndBuildContexts(req);
+}
+
+template<typename REQ, typename RESP>
+void QueryBaseProcessor<REQ, RESP>::handleBucketResults(
+        const std::vector<folly::Try<std::vector<OneVertexResp>>>& results) {
+    std::unordered_set<PartitionID> failedParts;
+    for (auto& bucketTry : results) {
+        CHECK(!bucketTry.hasException());
+        for (auto& r : bucketTry.value()) {
+            auto& partId = std::get<0>(r);
+            auto& ret = std::get<2>(r);
+            if (ret != kvstore::ResultCode::SUCCEEDED
+                  && failedParts.find(partId) == failedParts.end()) {
+                failedParts.emplace(partId);
+                if (ret == kvstore::ResultCode::ERR_LEADER_CHANGED) {
+                    this->handleLeaderChanged(spaceId_, partId);
+                } else {
+                    this->pushResultCode(this->to(ret), partId);
+                }
+            }
+        }
+    }
+}
+
+template<typename REQ, typename RESP>
+void QueryBaseProcessor<REQ, RESP>::process(const cpp2::GetNeighborsRequest& req) {
+    CHECK_NOTNULL(executor_);
+    int32_t returnColumnsNum = req.get_return_columns().size();
+    auto retCode = prepare(req);
     if (retCode != cpp2::ErrorCode::SUCCEEDED) {
         for (auto& p : req.get_parts()) {
             this->pushResultCode(retCode, p.first);
@@ -832,23 +949,7 @@ void QueryBaseProcessor<REQ, RESP>::process(const cpp2::GetNeighborsRequest& req
                      this,
                      returnColumnsNum] (auto&& t) mutable {
         CHECK(!t.hasException());
-        std::unordered_set<PartitionID> failedParts;
-        for (auto& bucketTry : t.value()) {
-            CHECK(!bucketTry.hasException());
-            for (auto& r : bucketTry.value()) {
-                auto& partId = std::get<0>(r);
-                auto& ret = std::get<2>(r);
-                if (ret != kvstore::ResultCode::SUCCEEDED
-                      && failedParts.find(partId) == failedParts.end()) {
-                    failedParts.emplace(partId);
-                    if (ret == kvstore::ResultCode::ERR_LEADER_CHANGED) {
-                        this->handleLeaderChanged(spaceId_, partId);
-                    } else {
-                        this->pushResultCode(this->to(ret), partId);
-                    }
-                }
-            }
-        }
+        this->handleBucketResults(t.value());
         this->onProcessFinished(returnColumnsNum);
         this->onFinished();
     });
@@ -92,7 +92,7 @@ kvstore::ResultCode QueryBoundProcessor::processEdgeSampling(const PartitionID p
         const std::vector<PropContext>* /* props needed */>;
     auto sampler = std::make_unique<
                     nebula::algorithm::ReservoirSampling<Sample>
-                   >(FLAGS_max_edge_returned_per_vertex);
+                   >(edgeLimit_);
 
     for (const auto& ec : edgeContexts_) {
         auto edgeType = ec.first;
@@ -210,7 +210,7 @@ kvstore::ResultCode QueryBoundProcessor::processVertex(
     }
 
     kvstore::ResultCode ret;
-    if (FLAGS_enable_reservoir_sampling) {
+    if (sampling_) {
         ret = processEdgeSampling(partId, vId, fcontext, vResp);
     } else {
         ret = processEdge(partId, vId, fcontext, vResp);
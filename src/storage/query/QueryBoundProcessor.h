@@ -18,6 +18,7 @@ namespace storage {
 class QueryBoundProcessor
     : public QueryBaseProcessor<cpp2::GetNeighborsRequest, cpp2::QueryResponse> {
     FRIEND_TEST(QueryBoundTest,  GenBucketsTest);
+    FRIEND_TEST(QueryBoundTest,  GenBucketsByCostTest);
 
 public:
     static QueryBoundProcessor* instance(kvstore::KVStore* kvstore,
@@ -8,6 +8,7 @@
 #include "time/Duration.h"
 #include "dataman/RowReader.h"
 #include "dataman/RowWriter.h"
+#include "storage/StorageFlags.h"
 
 
 namespace nebula {
@@ -66,6 +67,21 @@ void QueryStatsProcessor::calcResult(std::vector<PropContext>&& props) {
 }
 
 
+bool QueryStatsProcessor::countByDegree(EdgeType edgeType,
+                                        const std::vector<PropContext>& props) {
+    // The counter knows nothing about the filter and the expired edges
+    if (!FLAGS_enable_degree_counter || exp_ != nullptr
+            || getEdgeTTLInfo(edgeType).hasValue()) {
+        return false;
+    }
+    return std::all_of(props.begin(), props.end(), [] (const auto& prop) {
+        return prop.prop_.stat == cpp2::StatType::COUNT
+            && prop.pikType_ != PropContext::PropInKeyType::SRC
+            && prop.pikType_ != PropContext::PropInKeyType::DST;
+    });
+}
+
+
 kvstore::ResultCode QueryStatsProcessor::processVertex(
     BucketIdx bucketIdx, PartitionID partId, VertexID vId) {
     UNUSED(bucketIdx);
@@ -86,6 +102,17 @@ kvstore::ResultCode QueryStatsProcessor::processVertex(
         auto edgeType = ec.first;
         auto& props = ec.second;
         if (!props.empty()) {
+            if (countByDegree(edgeType, props)) {
+                int64_t degree = 0;
+                auto ret = this->getDegree(spaceId_, partId, vId, edgeType, &degree);
+                if (ret != kvstore::ResultCode::SUCCEEDED) {
+                    return ret;
+                }
+                for (auto& prop : props) {
+                    collector_.collectCount(degree, prop);
+                }
+                continue;
+            }
             auto r = this->collectEdgeProps(partId, vId, edgeType, &fcontext,
                                             [&, this](RowReader reader,
                                                       folly::StringPiece key) {
@@ -44,6 +44,9 @@ private:
 
     void calcResult(std::vector<PropContext>&& props);
 
+    // Whether the stats of the edgeType could be answered by the degree counter
+    bool countByDegree(EdgeType edgeType, const std::vector<PropContext>& props);
+
 private:
     StatsCollector collector_;
 };
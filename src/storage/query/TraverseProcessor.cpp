@@ -0,0 +1,171 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "storage/query/TraverseProcessor.h"
+#include "utils/NebulaKeyUtils.h"
+
+namespace nebula {
+namespace storage {
+
+void TraverseProcessor::process(const cpp2::GetNeighborsRequest& req) {
+    CHECK_NOTNULL(executor_);
+    returnColumnsNum_ = req.get_return_columns().size();
+    steps_ = req.__isset.steps ? std::max(1, req.steps) : 1;
+    auto retCode = prepare(req);
+    if (retCode != cpp2::ErrorCode::SUCCEEDED) {
+        for (auto& p : req.get_parts()) {
+            this->pushResultCode(retCode, p.first);
+        }
+        this->onFinished();
+        return;
+    }
+    edgeTypes_ = req.get_edge_types();
+    if (client_ != nullptr) {
+        auto status = client_->partsNum(spaceId_);
+        if (status.ok()) {
+            partsNum_ = status.value();
+        } else {
+            LOG(WARNING) << "Get parts number of space " << spaceId_
+                         << " failed, no hop would be expanded locally: " << status.status();
+        }
+    }
+    if (steps_ > 1) {
+        lastHopExp_ = std::move(exp_);
+    }
+    processHop(req.get_parts());
+}
+
+void TraverseProcessor::processHop(std::unordered_map<PartitionID, std::vector<VertexID>> parts) {
+    cpp2::GetNeighborsRequest hopReq;
+    hopReq.set_parts(std::move(parts));
+    auto buckets = genBuckets(hopReq);
+    beforeProcess(buckets);
+    std::vector<folly::Future<std::vector<OneVertexResp>>> results;
+    for (unsigned i = 0; i < buckets.size(); i++) {
+        results.emplace_back(asyncProcessBucket(i, std::move(buckets[i])));
+    }
+    folly::collectAll(results).via(executor_).thenTry([this] (auto&& t) mutable {
+        CHECK(!t.hasException());
+        this->handleBucketResults(t.value());
+        if (hop_ == steps_) {
+            onTraverseFinished();
+            return;
+        }
+        auto next = nextHop();
+        hop_++;
+        if (hop_ == steps_) {
+            exp_ = std::move(lastHopExp_);
+        }
+        if (next.empty()) {
+            onTraverseFinished();
+            return;
+        }
+        processHop(std::move(next));
+    });
+}
+
+std::unordered_map<PartitionID, std::vector<VertexID>> TraverseProcessor::nextHop() {
+    std::unordered_map<PartitionID, std::vector<VertexID>> next;
+    visited_.clear();
+    for (auto& dstIds : bucketDstIds_) {
+        for (auto dstId : dstIds) {
+            if (partsNum_ > 0) {
+                PartitionID partId = ID_HASH(dstId, partsNum_);
+                if (isLocal(partId)) {
+                    if (visited_.emplace(dstId).second) {
+                        next[partId].emplace_back(dstId);
+                    }
+                    continue;
+                }
+            }
+            frontiers_[steps_ - hop_].emplace(dstId);
+        }
+    }
+    bucketDstIds_.clear();
+    return next;
+}
+
+bool TraverseProcessor::isLocal(PartitionID partId) {
+    auto it = localParts_.find(partId);
+    if (it != localParts_.end()) {
+        return it->second;
+    }
+    bool local = false;
+    auto part = kvstore_->part(spaceId_, partId);
+    if (ok(part)) {
+        local = value(part)->isLeader();
+    }
+    localParts_.emplace(partId, local);
+    return local;
+}
+
+void TraverseProcessor::beforeProcess(const std::vector<Bucket>& buckets) {
+    if (hop_ == steps_) {
+        QueryBoundProcessor::beforeProcess(buckets);
+        return;
+    }
+    bucketDstIds_.resize(buckets.size());
+}
+
+kvstore::ResultCode TraverseProcessor::processVertex(
+    BucketIdx bucketIdx, PartitionID partId, VertexID vId) {
+    if (hop_ == steps_) {
+        return QueryBoundProcessor::processVertex(bucketIdx, partId, vId);
+    }
+    return collectDstIds(bucketIdx, partId, vId);
+}
+
+kvstore::ResultCode TraverseProcessor::collectDstIds(BucketIdx bucketIdx,
+                                                     PartitionID partId,
+                                                     VertexID vId) {
+    FilterContext fcontext;
+    auto& dstIds = bucketDstIds_[bucketIdx];
+    if (!sampling_) {
+        for (auto edgeType : edgeTypes_) {
+            auto ret = collectEdgeProps(partId, vId, edgeType, &fcontext,
+                                        [&] (RowReader, folly::StringPiece key) {
+                                            dstIds.emplace_back(NebulaKeyUtils::getDstId(key));
+                                        });
+            if (ret != kvstore::ResultCode::SUCCEEDED) {
+                return ret;
+            }
+        }
+        return kvstore::ResultCode::SUCCEEDED;
+    }
+
+    nebula::algorithm::ReservoirSampling<VertexID> sampler(edgeLimit_);
+    for (auto edgeType : edgeTypes_) {
+        auto ret = collectEdgeProps(partId, vId, edgeType, &fcontext,
+                                    [&] (RowReader, folly::StringPiece key) {
+                                        sampler.sampling(NebulaKeyUtils::getDstId(key));
+                                    });
+        if (ret != kvstore::ResultCode::SUCCEEDED) {
+            return ret;
+        }
+    }
+    auto samples = std::move(sampler).samples();
+    dstIds.insert(dstIds.end(), samples.begin(), samples.end());
+    return kvstore::ResultCode::SUCCEEDED;
+}
+
+void TraverseProcessor::onTraverseFinished() {
+    onProcessFinished(returnColumnsNum_);
+    if (!frontiers_.empty()) {
+        std::vector<cpp2::Frontier> frontiers;
+        frontiers.reserve(frontiers_.size());
+        for (auto& f : frontiers_) {
+            cpp2::Frontier frontier;
+            frontier.set_steps(f.first);
+            frontier.set_vertices(std::vector<VertexID>(f.second.begin(), f.second.end()));
+            frontiers.emplace_back(std::move(frontier));
+        }
+        resp_.set_frontiers(std::move(frontiers));
+    }
+    this->onFinished();
+}
+
+}  // namespace storage
+}  // namespace nebula
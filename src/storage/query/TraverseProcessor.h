@@ -0,0 +1,88 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef STORAGE_QUERY_TRAVERSEPROCESSOR_H_
+#define STORAGE_QUERY_TRAVERSEPROCESSOR_H_
+
+#include "base/Base.h"
+#include "storage/query/QueryBoundProcessor.h"
+#include "storage/client/StorageClient.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Go `steps` hops from the vertices in request. The hops out of the vertices whose
+ * parts are led by this host are expanded locally, the others are returned as the
+ * frontiers to be continued by the caller. Only the last hop is filtered and returns
+ * the props, the same as what getBound does.
+ * */
+class TraverseProcessor : public QueryBoundProcessor {
+public:
+    static TraverseProcessor* instance(kvstore::KVStore* kvstore,
+                                       meta::SchemaManager* schemaMan,
+                                       stats::Stats* stats,
+                                       folly::Executor* executor,
+                                       StorageClient* client,
+                                       VertexCache* cache = nullptr) {
+        return new TraverseProcessor(kvstore, schemaMan, stats, executor, client, cache);
+    }
+
+    void process(const cpp2::GetNeighborsRequest& req);
+
+private:
+    explicit TraverseProcessor(kvstore::KVStore* kvstore,
+                               meta::SchemaManager* schemaMan,
+                               stats::Stats* stats,
+                               folly::Executor* executor,
+                               StorageClient* client,
+                               VertexCache* cache)
+        : QueryBoundProcessor(kvstore, schemaMan, stats, executor, cache)
+        , client_(client) {}
+
+    void beforeProcess(const std::vector<Bucket>& buckets) override;
+
+    kvstore::ResultCode processVertex(
+        BucketIdx bucketIdx, PartitionID partId, VertexID vId) override;
+
+    /**
+     * Expand the vertices of the current hop, and go on with the next hop.
+     * */
+    void processHop(std::unordered_map<PartitionID, std::vector<VertexID>> parts);
+
+    /**
+     * Split the dst ids of the current hop into the vertices expanded locally
+     * in the next hop, and the frontier returned.
+     * */
+    std::unordered_map<PartitionID, std::vector<VertexID>> nextHop();
+
+    kvstore::ResultCode collectDstIds(BucketIdx bucketIdx, PartitionID partId, VertexID vId);
+
+    bool isLocal(PartitionID partId);
+
+    void onTraverseFinished();
+
+private:
+    StorageClient* client_{nullptr};
+    std::vector<EdgeType> edgeTypes_;
+    int32_t returnColumnsNum_ = 0;
+    int32_t steps_ = 1;
+    int32_t hop_ = 1;
+    // 0 means we have no idea where the dst ids are, all of them go to the frontiers
+    int32_t partsNum_ = 0;
+    // The filter only works on the last hop
+    std::unique_ptr<Expression> lastHopExp_;
+    std::vector<std::vector<VertexID>> bucketDstIds_;
+    std::unordered_map<PartitionID, bool> localParts_;
+    // The vertices expanded locally, in the current hop
+    std::unordered_set<VertexID> visited_;
+    // steps left => vertices
+    std::map<int32_t, std::unordered_set<VertexID>> frontiers_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_QUERY_TRAVERSEPROCESSOR_H_
@@ -415,6 +415,36 @@ TEST(NebulaCompactionFilterTest, TTLFilterDataNotExpiredTest) {
     }
 }
 
+TEST(NebulaCompactionFilterTest, TTLFilterRowFormatV2Test) {
+    auto schemaMan = TestUtils::mockSchemaWithTTLMan();
+    StorageCompactionFilter filter(schemaMan.get(), nullptr);
+    auto encode = [&] (int64_t ts) {
+        RowWriter writer(schemaMan->getTagSchema(0, 3001), RowFormat::V2);
+        for (int64_t numInt = 0; numInt < 3; numInt++) {
+            writer << numInt + ts;
+        }
+        for (auto numString = 3; numString < 6; numString++) {
+            writer << folly::stringPrintf("string_col_%d", numString);
+        }
+        return writer.encode();
+    };
+    // "2019-1-1 0:0:0" always expires, and "2100-1-1 0:0:0" never does
+    auto expired = encode(1546272000);
+    auto notExpired = encode(4102416000);
+    EXPECT_EQ(RowFormat::V2, RowReader::getRowReader(expired,
+                                                     schemaMan->getTagSchema(0, 3001))->format());
+
+    auto key1 = NebulaKeyUtils::vertexKey(0, 1, 3001, 0);
+    auto key2 = NebulaKeyUtils::vertexKey(0, 2, 3001, 0);
+    EXPECT_TRUE(filter.filter(0, key1, expired));
+    EXPECT_FALSE(filter.filter(0, key2, notExpired));
+
+    // The rows of the tags without ttl are kept without decoding
+    auto noTTLSchemaMan = TestUtils::mockSchemaMan();
+    StorageCompactionFilter noTTLFilter(noTTLSchemaMan.get(), nullptr);
+    EXPECT_FALSE(noTTLFilter.filter(0, key1, expired));
+}
+
 TEST(NebulaCompactionFilterTest, DropIndexTest) {
     fs::TempDir rootPath("/tmp/DropIndexTest.XXXXXX");
     GraphSpaceID spaceId = 0;
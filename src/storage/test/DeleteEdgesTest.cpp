@@ -351,6 +351,89 @@ TEST(DeleteEdgesTest, SingleVersionWithoutIndex) {
     }
 }
 
+static void testDegreeCounter(bool multiVersions) {
+    FLAGS_enable_multi_versions = multiVersions;
+    FLAGS_enable_degree_counter = true;
+    fs::TempDir rootPath("/tmp/DeleteEdgesTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
+    auto schemaMan = TestUtils::mockSchemaMan();
+    auto indexMan = std::make_unique<AdHocIndexManager>();
+    EdgeType edgeType = 101;
+    auto checkDegree = [&] (int64_t expected) {
+        for (PartitionID partId = 1; partId <= 3; partId++) {
+            for (VertexID srcId = 10 * partId; srcId < 10 * (partId + 1); srcId++) {
+                std::string val;
+                auto ret = kv->get(0, partId,
+                                   NebulaKeyUtils::degreeKey(partId, srcId, edgeType), &val);
+                if (expected == 0) {
+                    EXPECT_EQ(kvstore::ResultCode::ERR_KEY_NOT_FOUND, ret);
+                    continue;
+                }
+                ASSERT_EQ(kvstore::ResultCode::SUCCEEDED, ret);
+                ASSERT_EQ(sizeof(int64_t), val.size());
+                EXPECT_EQ(expected, *reinterpret_cast<const int64_t*>(val.data()));
+            }
+        }
+    };
+    // Add the same edges twice, overwriting an edge should not change the degree
+    for (int32_t i = 0; i < 2; i++) {
+        auto* processor = AddEdgesProcessor::instance(kv.get(),
+                                                      schemaMan.get(),
+                                                      indexMan.get(),
+                                                      nullptr);
+        cpp2::AddEdgesRequest req;
+        req.space_id = 0;
+        req.overwritable = true;
+        for (PartitionID partId = 1; partId <= 3; partId++) {
+            auto edges = TestUtils::setupEdges(partId, partId * 10, 10 * (partId + 1));
+            req.parts.emplace(partId, std::move(edges));
+        }
+
+        auto fut = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(fut).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        checkDegree(1);
+    }
+
+    // Delete edges, each edge is passed twice in the request
+    {
+        auto* processor = DeleteEdgesProcessor::instance(kv.get(), schemaMan.get(), indexMan.get());
+        cpp2::DeleteEdgesRequest req;
+        req.set_space_id(0);
+        for (PartitionID partId = 1; partId <= 3; partId++) {
+            std::vector<cpp2::EdgeKey> keys;
+            for (VertexID srcId = partId * 10; srcId < 10 * (partId + 1); srcId++) {
+                cpp2::EdgeKey key;
+                key.set_src(srcId);
+                key.set_edge_type(edgeType);
+                key.set_ranking(srcId * 100 + 3);
+                key.set_dst(srcId * 100 + 2);
+                keys.emplace_back(key);
+                keys.emplace_back(std::move(key));
+            }
+            req.parts.emplace(partId, std::move(keys));
+        }
+
+        auto fut = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(fut).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        checkDegree(0);
+    }
+    FLAGS_enable_degree_counter = false;
+}
+
+TEST(DeleteEdgesTest, DegreeCounterTest) {
+    testDegreeCounter(false);
+}
+
+TEST(DeleteEdgesTest, MultiVersionDegreeCounterTest) {
+    // An edge is new when there is no version of it
+    testDegreeCounter(true);
+    FLAGS_enable_multi_versions = false;
+}
+
 }  // namespace storage
 }  // namespace nebula
 
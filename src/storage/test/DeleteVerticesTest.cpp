@@ -181,19 +181,18 @@ TEST(DeleteVerticesTest, DeleteVerticesIfThereAreEdgesWithIndex) {
     for (PartitionID partId = 0; partId < 3; partId++) {
         for (VertexID vertexId = 10 * partId; vertexId < 10 * (partId + 1); vertexId++) {
             {
+                // vertex prefix with only part and vId will get tags and edges
                 auto prefix = NebulaKeyUtils::vertexPrefix(partId, vertexId);
                 std::unique_ptr<kvstore::KVIterator> iter;
                 EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, kv->prefix(0, partId, prefix, &iter));
-                // vertex prefix with only part and vId will get tags and edges
-                CHECK(iter->valid());
-                CHECK(!NebulaKeyUtils::isVertex(iter->key()));
+                CHECK(!iter->valid());
             }
             {
                 EdgeType edgeType = 101;
                 auto prefix = NebulaKeyUtils::edgePrefix(partId, vertexId, edgeType);
                 std::unique_ptr<kvstore::KVIterator> iter;
                 EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, kv->prefix(0, partId, prefix, &iter));
-                CHECK(iter->valid());
+                CHECK(!iter->valid());
             }
         }
     }
@@ -288,19 +287,18 @@ TEST(DeleteVerticesTest, DeleteVerticesIfThereAreEdgesWithoutIndex) {
     for (PartitionID partId = 0; partId < 3; partId++) {
         for (VertexID vertexId = 10 * partId; vertexId < 10 * (partId + 1); vertexId++) {
             {
+                // vertex prefix with only part and vId will get tags and edges
                 auto prefix = NebulaKeyUtils::vertexPrefix(partId, vertexId);
                 std::unique_ptr<kvstore::KVIterator> iter;
                 EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, kv->prefix(0, partId, prefix, &iter));
-                // vertex prefix with only part and vId will get tags and edges
-                CHECK(iter->valid());
-                CHECK(!NebulaKeyUtils::isVertex(iter->key()));
+                CHECK(!iter->valid());
             }
             {
                 EdgeType edgeType = 101;
                 auto prefix = NebulaKeyUtils::edgePrefix(partId, vertexId, edgeType);
                 std::unique_ptr<kvstore::KVIterator> iter;
                 EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, kv->prefix(0, partId, prefix, &iter));
-                CHECK(iter->valid());
+                CHECK(!iter->valid());
             }
         }
     }
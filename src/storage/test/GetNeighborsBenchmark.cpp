@@ -19,6 +19,8 @@
 
 DEFINE_int64(max_rank, 1000, "max rank of each edge");
 DEFINE_double(filter_ratio, 0.1, "ratio of data would pass filter");
+// Run with --engine_type=memory to benchmark the memory engine
+DECLARE_string(engine_type);
 
 std::unique_ptr<nebula::kvstore::KVStore> gKV;
 std::unique_ptr<nebula::storage::AdHocSchemaManager> gSchemaMan;
@@ -380,6 +382,7 @@ BENCHMARK_RELATIVE(TenVertexFiveProperty, iters) {
 int main(int argc, char** argv) {
     folly::init(&argc, &argv, true);
     nebula::fs::TempDir rootPath("/tmp/QueryBoundBenchmarkTest.XXXXXX");
+    LOG(INFO) << "Benchmark on the " << FLAGS_engine_type << " engine";
     nebula::storage::setUp(rootPath.path());
     folly::runBenchmarks();
     gKV.reset();
@@ -0,0 +1,61 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "fs/TempDir.h"
+#include "storage/test/TestUtils.h"
+#include "storage/query/GetUUIDsProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+cpp2::GetUUIDsResp getUUIDs(kvstore::KVStore* kv,
+                            std::unordered_map<PartitionID, std::vector<std::string>> parts) {
+    auto* processor = GetUUIDsProcessor::instance(kv);
+    cpp2::GetUUIDsReq req;
+    req.set_space_id(0);
+    req.set_parts(std::move(parts));
+    auto fut = processor->getFuture();
+    processor->process(req);
+    return std::move(fut).get();
+}
+
+TEST(GetUUIDsTest, SimpleTest) {
+    fs::TempDir rootPath("/tmp/GetUUIDsTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+
+    LOG(INFO) << "Get the ids of the new names, the duplicated names are resolved once";
+    auto resp = getUUIDs(kv.get(), {{0, {"a", "b", "a"}}, {1, {"c"}}});
+    EXPECT_EQ(0, resp.result.failed_codes.size());
+    ASSERT_EQ(3, resp.ids.size());
+    auto ids = resp.ids;
+
+    LOG(INFO) << "The ids are kept, and the same ones are returned later";
+    resp = getUUIDs(kv.get(), {{0, {"b", "a"}}, {1, {"c", "d"}}});
+    EXPECT_EQ(0, resp.result.failed_codes.size());
+    ASSERT_EQ(4, resp.ids.size());
+    for (auto& name : {"a", "b", "c"}) {
+        EXPECT_EQ(ids[name], resp.ids[name]);
+    }
+
+    LOG(INFO) << "Check data in kv store...";
+    std::string val;
+    auto key = NebulaKeyUtils::uuidKey(1, "d");
+    ASSERT_EQ(kvstore::ResultCode::SUCCEEDED, kv->get(0, 1, key, &val));
+    EXPECT_EQ(resp.ids["d"], *reinterpret_cast<const VertexID*>(val.data()));
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,74 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "storage/client/HostStats.h"
+
+namespace nebula {
+namespace storage {
+
+TEST(HostStatsTest, LoadTest) {
+    auto& stats = HostStats::instance();
+    stats.clear();
+    HostAddr fast(0, 1);
+    HostAddr slow(0, 2);
+    HostAddr unknown(0, 3);
+
+    stats.start(fast);
+    stats.finish(fast, 100, true);
+    stats.start(slow);
+    stats.finish(slow, 1000, true);
+    EXPECT_EQ(100, stats.load(fast));
+    EXPECT_EQ(1000, stats.load(slow));
+    // Never requested, so worth a try
+    EXPECT_EQ(0, stats.load(unknown));
+
+    // The moving average
+    stats.start(fast);
+    stats.finish(fast, 900, true);
+    EXPECT_EQ(200, stats.load(fast));
+
+    // The requests in flight
+    for (auto i = 0; i < 9; i++) {
+        stats.start(fast);
+    }
+    EXPECT_EQ(2000, stats.load(fast));
+    EXPECT_LT(stats.load(slow), stats.load(fast));
+}
+
+TEST(HostStatsTest, SnapshotTest) {
+    auto& stats = HostStats::instance();
+    stats.clear();
+    HostAddr host(0, 1);
+    stats.start(host);
+    stats.finish(host, 100, true);
+    stats.start(host);
+    stats.finish(host, 100, false);
+    stats.start(host);
+    stats.hedge(host);
+    stats.timeout(host);
+
+    auto snapshot = stats.snapshot();
+    ASSERT_EQ(1, snapshot.size());
+    EXPECT_EQ(host, snapshot[0].host);
+    EXPECT_EQ(1, snapshot[0].inflight);
+    EXPECT_EQ(100, snapshot[0].latencyUs);
+    EXPECT_EQ(3, snapshot[0].requests);
+    EXPECT_EQ(1, snapshot[0].failures);
+    EXPECT_EQ(1, snapshot[0].hedges);
+    EXPECT_EQ(1, snapshot[0].timeouts);
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+    return RUN_ALL_TESTS();
+}
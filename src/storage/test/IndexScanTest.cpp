@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 #include <rocksdb/db.h>
 #include <limits>
+#include <folly/ScopeGuard.h>
 #include "fs/TempDir.h"
 #include "storage/test/TestUtils.h"
 #include "storage/index/LookUpIndexProcessor.h"
@@ -16,6 +17,7 @@
 #include "dataman/RowReader.h"
 
 DECLARE_uint32(raft_heartbeat_interval_secs);
+DECLARE_int32(max_rows_returned_per_lookup);
 
 namespace nebula {
 namespace storage {
@@ -1588,6 +1590,192 @@ TEST(IndexScanTest, VertexDoubleTest) {
     }
 }
 
+/**
+ * Tag 3001 has col_0 = vId % 5 indexed by index 1, and col_1 = vId % 3 indexed by index 2,
+ * for the vertices 0 to 29.
+ */
+static cpp2::LookUpIndexResp execLookupMultiIndex(const std::string& filter,
+                                                  std::vector<cpp2::IndexQueryContext> contexts,
+                                                  bool isUnion = false) {
+    fs::TempDir rootPath("/tmp/execLookupMultiIndex.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    GraphSpaceID spaceId = 0;
+    TagID tagId = 3001;
+    auto* sm = new AdHocSchemaManager();
+    sm->addTagSchema(spaceId, tagId, genTagSchemaProvider(tagId, 2, 0));
+    std::unique_ptr<meta::SchemaManager> schemaMan(sm);
+    auto* im = new AdHocIndexManager();
+    for (auto i = 0; i < 2; i++) {
+        nebula::cpp2::ColumnDef column;
+        column.name = folly::stringPrintf("tag_%d_col_%d", tagId, i);
+        column.type.type = nebula::cpp2::SupportedType::INT;
+        std::vector<nebula::cpp2::ColumnDef> cols;
+        cols.emplace_back(std::move(column));
+        im->addTagIndex(spaceId, i + 1, tagId, std::move(cols));
+    }
+    std::unique_ptr<meta::IndexManager> indexMan(im);
+    for (auto partId = 0; partId < 3; partId++) {
+        std::vector<kvstore::KV> data;
+        for (VertexID vId = partId * 10; vId < (partId + 1) * 10; vId++) {
+            std::vector<int64_t> vals = {vId % 5, vId % 3};
+            RowWriter writer;
+            writer << vals[0] << vals[1];
+            for (auto i = 0; i < 2; i++) {
+                IndexValues values;
+                values.emplace_back(nebula::cpp2::SupportedType::INT,
+                                    NebulaKeyUtils::encodeInt64(vals[i]));
+                data.emplace_back(NebulaKeyUtils::vertexIndexKey(partId, i + 1, vId, values), "");
+            }
+            data.emplace_back(NebulaKeyUtils::vertexKey(partId, vId, tagId, 0), writer.encode());
+        }
+        folly::Baton<true, std::atomic> baton;
+        kv->asyncMultiPut(
+                0, partId, std::move(data),
+                [&](kvstore::ResultCode code) {
+                    EXPECT_EQ(code, kvstore::ResultCode::SUCCEEDED);
+                    baton.post();
+                });
+        baton.wait();
+    }
+    auto *processor = LookUpIndexProcessor::instance(kv.get(),
+                                                     schemaMan.get(),
+                                                     indexMan.get(),
+                                                     nullptr);
+    cpp2::LookUpIndexRequest req;
+    std::vector<int32_t> parts = {0, 1, 2};
+    std::vector<std::string> cols = {"tag_3001_col_0", "tag_3001_col_1"};
+    req.set_space_id(spaceId);
+    req.set_parts(std::move(parts));
+    req.set_index_id(1);
+    req.set_return_columns(cols);
+    req.set_filter(filter);
+    req.set_is_edge(false);
+    req.set_contexts(std::move(contexts));
+    req.set_is_union(isUnion);
+    auto f = processor->getFuture();
+    processor->process(req);
+    return std::move(f).get();
+}
+
+// tag_3001_col_<col> == values[0] || tag_3001_col_<col> == values[1] ...
+static std::string inListFilter(int32_t col, const std::vector<int64_t>& values) {
+    std::unique_ptr<Expression> exp;
+    for (auto v : values) {
+        auto* ape = new AliasPropertyExpression(new std::string(""),
+                                                new std::string("3001"),
+                                                new std::string(folly::stringPrintf(
+                                                    "tag_3001_col_%d", col)));
+        auto* eq = new RelationalExpression(ape,
+                                            RelationalExpression::Operator::EQ,
+                                            new PrimaryExpression(v));
+        if (exp == nullptr) {
+            exp.reset(eq);
+        } else {
+            exp = std::make_unique<LogicalExpression>(exp.release(), LogicalExpression::OR, eq);
+        }
+    }
+    return Expression::encode(exp.get());
+}
+
+static cpp2::IndexQueryContext indexContext(IndexID indexId, const std::string& filter) {
+    cpp2::IndexQueryContext context;
+    context.set_index_id(indexId);
+    context.set_filter(filter);
+    return context;
+}
+
+static std::set<VertexID> vertexIds(const cpp2::LookUpIndexResp& resp) {
+    std::set<VertexID> ids;
+    for (const auto& row : *resp.get_vertices()) {
+        // Every row is returned once, even if hit by several indexes
+        EXPECT_TRUE(ids.emplace(row.get_vertex_id()).second);
+        EXPECT_FALSE(row.get_props().empty());
+    }
+    return ids;
+}
+
+TEST(IndexScanTest, MultiIndexScanTest) {
+    {
+        LOG(INFO) << "IN list : col_0 == 1 || col_0 == 3 || col_0 == 1";
+        auto resp = execLookupMultiIndex(inListFilter(0, {1, 3, 1}), {});
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        std::set<VertexID> expected = {1, 3, 6, 8, 11, 13, 16, 18, 21, 23, 26, 28};
+        EXPECT_EQ(expected, vertexIds(resp));
+    }
+    {
+        LOG(INFO) << "Intersection : col_0 == 1 on index 1, col_1 == 2 on index 2";
+        std::vector<cpp2::IndexQueryContext> contexts = {
+            indexContext(1, inListFilter(0, {1})),
+            indexContext(2, inListFilter(1, {2})),
+        };
+        auto resp = execLookupMultiIndex("", std::move(contexts));
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        std::set<VertexID> expected = {11, 26};
+        EXPECT_EQ(expected, vertexIds(resp));
+    }
+    {
+        LOG(INFO) << "Union : col_0 == 1 on index 1, col_1 == 2 on index 2";
+        std::vector<cpp2::IndexQueryContext> contexts = {
+            indexContext(1, inListFilter(0, {1})),
+            indexContext(2, inListFilter(1, {2})),
+        };
+        auto resp = execLookupMultiIndex("", std::move(contexts), true);
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        std::set<VertexID> expected = {1, 2, 5, 6, 8, 11, 14, 16, 17, 20, 21, 23, 26, 29};
+        EXPECT_EQ(expected, vertexIds(resp));
+    }
+    {
+        LOG(INFO) << "Union of IN lists : col_0 IN (2, 4) on index 1, col_1 IN (0) on index 2";
+        std::vector<cpp2::IndexQueryContext> contexts = {
+            indexContext(1, inListFilter(0, {2, 4})),
+            indexContext(2, inListFilter(1, {0})),
+        };
+        auto resp = execLookupMultiIndex("", std::move(contexts), true);
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        std::set<VertexID> expected;
+        for (VertexID vId = 0; vId < 30; vId++) {
+            if (vId % 5 == 2 || vId % 5 == 4 || vId % 3 == 0) {
+                expected.emplace(vId);
+            }
+        }
+        EXPECT_EQ(expected, vertexIds(resp));
+    }
+    {
+        LOG(INFO) << "Bounded by max_rows_returned_per_lookup";
+        auto oldMaxRows = FLAGS_max_rows_returned_per_lookup;
+        FLAGS_max_rows_returned_per_lookup = 5;
+        SCOPE_EXIT {
+            FLAGS_max_rows_returned_per_lookup = oldMaxRows;
+        };
+        std::vector<cpp2::IndexQueryContext> contexts = {
+            indexContext(1, inListFilter(0, {1})),
+            indexContext(2, inListFilter(1, {2})),
+        };
+        auto resp = execLookupMultiIndex("", contexts, true);
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        auto unionIds = vertexIds(resp);
+        std::set<VertexID> expected = {1, 2, 5, 6, 8, 11, 14, 16, 17, 20, 21, 23, 26, 29};
+        EXPECT_EQ(5, unionIds.size());
+        EXPECT_TRUE(std::includes(expected.begin(), expected.end(),
+                                  unionIds.begin(), unionIds.end()));
+
+        // The first index hits more than 5, the rows are bounded after the intersection
+        resp = execLookupMultiIndex("", std::move(contexts));
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        expected = {11, 26};
+        EXPECT_EQ(expected, vertexIds(resp));
+
+        // The intersection stops at 5 rows
+        contexts = {
+            indexContext(1, inListFilter(0, {1, 2, 3})),
+            indexContext(2, inListFilter(1, {0, 1, 2})),
+        };
+        resp = execLookupMultiIndex("", std::move(contexts));
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_EQ(5, vertexIds(resp).size());
+    }
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -8,6 +8,7 @@
 #include "utils/NebulaKeyUtils.h"
 #include <gtest/gtest.h>
 #include <rocksdb/db.h>
+#include <folly/ScopeGuard.h>
 #include "fs/TempDir.h"
 #include "kvstore/RocksEngineConfig.h"
 #include "storage/test/TestUtils.h"
@@ -19,6 +20,8 @@
 #include "storage/mutate/UpdateEdgeProcessor.h"
 #include "storage/admin/RebuildTagIndexProcessor.h"
 #include "storage/admin/RebuildEdgeIndexProcessor.h"
+#include "kvstore/DirtyVertexTracker.h"
+#include "storage/StorageFlags.h"
 
 namespace nebula {
 namespace storage {
@@ -609,9 +612,17 @@ TEST(IndexTest, RebulidEdgeIndexWithOfflineTest) {
         req.set_index_id(101 + 100);
         req.is_offline = true;
 
+        // Rebuild the parts in parallel, and each part into several sst files
+        auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+        auto oldSstEntries = FLAGS_rebuild_index_sst_entries;
+        FLAGS_rebuild_index_sst_entries = 3;
+        SCOPE_EXIT {
+            FLAGS_rebuild_index_sst_entries = oldSstEntries;
+        };
         auto* processor = RebuildEdgeIndexProcessor::instance(kv.get(),
                                                               schemaMan.get(),
-                                                              indexMan.get());
+                                                              indexMan.get(),
+                                                              executor.get());
         auto fut = processor->getFuture();
         processor->process(req);
         auto resp = std::move(fut).get();
@@ -631,6 +642,169 @@ TEST(IndexTest, RebulidEdgeIndexWithOfflineTest) {
     }
 }
 
+TEST(IndexTest, RebulidTagIndexWithOnlineTest) {
+    fs::TempDir rootPath("/tmp/RebulidTagIndexWithOnlineTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    auto schemaMan = TestUtils::mockSchemaMan();
+    auto indexMan = TestUtils::mockIndexMan();
+    auto addVertices = [&] (PartitionID partId, std::vector<cpp2::Vertex> vertices) {
+        cpp2::AddVerticesRequest req;
+        req.space_id = 0;
+        req.overwritable = true;
+        req.parts.emplace(partId, std::move(vertices));
+        auto* processor = AddVerticesProcessor::instance(kv.get(),
+                                                         schemaMan.get(),
+                                                         indexMan.get(),
+                                                         nullptr);
+        auto fut = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(fut).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+    };
+    // The index entries of the part, grouped by the vertex
+    auto scanIndex = [&] (PartitionID partId) {
+        std::unordered_map<VertexID, std::vector<std::string>> entries;
+        auto prefix = NebulaKeyUtils::indexPrefix(partId, 4001);
+        std::unique_ptr<kvstore::KVIterator> iter;
+        EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, kv->prefix(0, partId, prefix, &iter));
+        for (; iter->valid(); iter->next()) {
+            auto key = iter->key();
+            auto vId = NebulaKeyUtils::readInt<VertexID>(
+                key.data() + key.size() - sizeof(VertexID), sizeof(VertexID));
+            entries[vId].emplace_back(key.str());
+        }
+        return entries;
+    };
+    for (auto partId = 1; partId <= 3; partId++) {
+        addVertices(partId, TestUtils::setupVertices(partId,
+                                                     partId * 10,
+                                                     10 * (partId + 1),
+                                                     3001,
+                                                     3010));
+        // The writes maintain the index already, drop it so that only the rebuild
+        // could bring it back
+        folly::Baton<true, std::atomic> baton;
+        kv->asyncRemoveRange(0, partId,
+                             NebulaKeyUtils::indexPrefix(partId, 4001),
+                             NebulaKeyUtils::indexPrefix(partId, 4002),
+                             [&] (kvstore::ResultCode code) {
+            EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, code);
+            baton.post();
+        });
+        baton.wait();
+        EXPECT_TRUE(scanIndex(partId).empty());
+    }
+    {
+        std::vector<PartitionID> parts{1, 2, 3};
+        cpp2::RebuildIndexRequest req;
+        req.set_space_id(0);
+        req.set_parts(std::move(parts));
+        req.set_index_id(3001 + 1000);
+        req.set_is_offline(false);
+
+        // Backfill one entry per batch, 5 per second after the first 5, so that the
+        // backfill of each part lasts for about one second
+        auto oldBatchNum = FLAGS_rebuild_index_batch_num;
+        auto oldRateLimit = FLAGS_rebuild_index_part_rate_limit;
+        FLAGS_rebuild_index_batch_num = 1;
+        FLAGS_rebuild_index_part_rate_limit = 5;
+        SCOPE_EXIT {
+            FLAGS_rebuild_index_batch_num = oldBatchNum;
+            FLAGS_rebuild_index_part_rate_limit = oldRateLimit;
+        };
+        auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+        auto* processor = RebuildTagIndexProcessor::instance(kv.get(),
+                                                             schemaMan.get(),
+                                                             indexMan.get(),
+                                                             executor.get());
+        auto fut = processor->getFuture();
+        processor->process(req);
+
+        // Once the backfill of part 1 has started, overwrite a vertex it has not
+        // reached yet, and add a new one. The backfill reads a snapshot, so it puts
+        // the stale entry of vertex 19 after the write, which the catch-up removes.
+        while (scanIndex(1).empty()) {
+            usleep(10000);
+        }
+        std::vector<cpp2::Vertex> vertices;
+        for (auto pair : {std::make_pair(19, 9), std::make_pair(100, 1)}) {
+            cpp2::Tag tag;
+            tag.set_tag_id(3001);
+            tag.set_props(TestUtils::encodeValue(pair.second, pair.first, 3001));
+            std::vector<cpp2::Tag> tags;
+            tags.emplace_back(std::move(tag));
+            cpp2::Vertex vertex;
+            vertex.set_id(pair.first);
+            vertex.set_tags(std::move(tags));
+            vertices.emplace_back(std::move(vertex));
+        }
+        addVertices(1, std::move(vertices));
+
+        auto resp = std::move(fut).get();
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+    }
+    for (auto partId = 1; partId <= 3; partId++) {
+        auto entries = scanIndex(partId);
+        EXPECT_EQ(partId == 1 ? 11 : 10, entries.size());
+        // Every vertex is indexed exactly once
+        for (auto& entry : entries) {
+            EXPECT_EQ(1, entry.second.size()) << "vertex " << entry.first;
+        }
+    }
+    // The vertices written during the backfill are indexed by their latest props
+    auto entries = scanIndex(1);
+    ASSERT_EQ(1, entries[19].size());
+    EXPECT_NE(std::string::npos, entries[19][0].find("col_3_9_19_3001"));
+    ASSERT_EQ(1, entries[100].size());
+    EXPECT_NE(std::string::npos, entries[100][0].find("col_3_1_100_3001"));
+}
+
+TEST(IndexTest, DirtyVertexTrackerTest) {
+    fs::TempDir rootPath("/tmp/DirtyVertexTrackerTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    auto& tracker = kvstore::DirtyVertexTracker::instance();
+    auto put = [&] (PartitionID partId, std::string key) {
+        folly::Baton<true, std::atomic> baton;
+        std::vector<kvstore::KV> data;
+        data.emplace_back(std::move(key), "");
+        kv->asyncMultiPut(0, partId, std::move(data), [&] (kvstore::ResultCode code) {
+            EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, code);
+            baton.post();
+        });
+        baton.wait();
+    };
+    // Not tracked
+    put(1, NebulaKeyUtils::vertexKey(1, 10, 3001, 0));
+    EXPECT_FALSE(tracker.isTracked(0, 1));
+
+    auto sessionId = tracker.start(0, 1);
+    EXPECT_TRUE(tracker.isTracked(0, 1));
+    EXPECT_FALSE(tracker.isTracked(0, 2));
+    put(1, NebulaKeyUtils::vertexKey(1, 11, 3001, 0));
+    put(1, NebulaKeyUtils::edgeKey(1, 12, 101, 0, 20, 0));
+    put(2, NebulaKeyUtils::vertexKey(2, 13, 3001, 0));
+    // Index keys are not data
+    put(1, NebulaKeyUtils::vertexIndexKey(1, 4001, 14, {}));
+    auto dirty = tracker.take(0, 1, sessionId);
+    EXPECT_EQ((std::unordered_set<VertexID>{11, 12}), dirty);
+    EXPECT_TRUE(tracker.take(0, 1, sessionId).empty());
+
+    // Every vertex with data in a removed range is touched
+    folly::Baton<true, std::atomic> baton;
+    kv->asyncRemoveRange(0, 1, NebulaKeyUtils::prefix(1), NebulaKeyUtils::dataRangeEnd(1),
+                         [&] (kvstore::ResultCode code) {
+        EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, code);
+        baton.post();
+    });
+    baton.wait();
+    EXPECT_EQ((std::unordered_set<VertexID>{10, 11, 12}), tracker.take(0, 1, sessionId));
+
+    tracker.stop(0, 1, sessionId);
+    EXPECT_FALSE(tracker.isTracked(0, 1));
+    put(1, NebulaKeyUtils::vertexKey(1, 15, 3001, 0));
+    EXPECT_TRUE(tracker.take(0, 1, sessionId).empty());
+}
+
 TEST(IndexTest, VertexBloomFilterTest) {
     // vertex bloom filter should be used when enable_multi_versions is false
     FLAGS_enable_rocksdb_statistics = true;
@@ -23,6 +23,8 @@ DEFINE_int32(req_parts, 3, "parts requested");
 DEFINE_int32(vrpp, 100, "vertices requested per part");
 DEFINE_int32(handler_num, 10, "The Executor's handler number");
 DECLARE_int32(max_handlers_per_req);
+// Run with --engine_type=memory to benchmark the memory engine
+DECLARE_string(engine_type);
 
 std::unique_ptr<nebula::kvstore::KVStore> gKV;
 std::unique_ptr<nebula::storage::AdHocSchemaManager> schema;
@@ -155,6 +157,7 @@ BENCHMARK(query_bound_10, iters) {
 int main(int argc, char** argv) {
     folly::init(&argc, &argv, true);
     nebula::fs::TempDir rootPath("/tmp/QueryBoundBenchmarkTest.XXXXXX");
+    LOG(INFO) << "Benchmark on the " << FLAGS_engine_type << " engine";
     nebula::storage::setUp(rootPath.path());
     folly::runBenchmarks();
     gKV.reset();
@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 #include <rocksdb/db.h>
 #include <limits>
+#include <folly/ScopeGuard.h>
 #include "fs/TempDir.h"
 #include "storage/test/TestUtils.h"
 #include "storage/query/QueryBoundProcessor.h"
@@ -692,6 +693,104 @@ TEST(QueryBoundTest, SamplingTest) {
     FLAGS_enable_reservoir_sampling = false;
 }
 
+TEST(QueryBoundTest, LimitInRequestTest) {
+    fs::TempDir rootPath("/tmp/QueryBoundTest.XXXXXX");
+    LOG(INFO) << "Prepare meta...";
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+
+    auto schemaMan = TestUtils::mockSchemaMan();
+    mockData(kv.get());
+    {
+        cpp2::GetNeighborsRequest req;
+        std::vector<EdgeType> et = {101};
+        buildRequest(req, et);
+        req.set_limit(3);
+
+        auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+        auto* processor = QueryBoundProcessor::instance(kv.get(), schemaMan.get(),
+                                                        nullptr, executor.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+
+        LOG(INFO) << "Check the results...";
+        checkResponse(resp, 30, 12, 10001, 3);
+    }
+    {
+        cpp2::GetNeighborsRequest req;
+        std::vector<EdgeType> et = {101, -101};
+        buildRequest(req, et);
+        req.set_limit(4);
+        req.set_random(true);
+
+        auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+        auto* processor = QueryBoundProcessor::instance(kv.get(), schemaMan.get(),
+                                                        nullptr, executor.get());
+        auto f = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(f).get();
+
+        LOG(INFO) << "Check the results...";
+        checkSamplingResponse(resp, 30, 12, 10001, 10007, 20001, 20005, 4);
+    }
+}
+
+TEST(QueryBoundTest, GenBucketsByCostTest) {
+    auto oldDegreeCounter = FLAGS_enable_degree_counter;
+    auto oldMaxHandlers = FLAGS_max_handlers_per_req;
+    auto oldMinVertices = FLAGS_min_vertices_per_bucket;
+    SCOPE_EXIT {
+        FLAGS_enable_degree_counter = oldDegreeCounter;
+        FLAGS_max_handlers_per_req = oldMaxHandlers;
+        FLAGS_min_vertices_per_bucket = oldMinVertices;
+    };
+    FLAGS_enable_degree_counter = true;
+    FLAGS_max_handlers_per_req = 10;
+    FLAGS_min_vertices_per_bucket = 3;
+    fs::TempDir rootPath("/tmp/QueryBoundTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    // Vertex 0 and 10 are supernodes, the others have 7 edges.
+    for (PartitionID partId = 0; partId < 3; partId++) {
+        std::vector<kvstore::KV> data;
+        for (VertexID vId = partId * 10; vId < (partId + 1) * 10; vId++) {
+            int64_t degree = vId % 10 == 0 && vId < 20 ? 100000 : 7;
+            data.emplace_back(NebulaKeyUtils::degreeKey(partId, vId, 101),
+                              std::string(reinterpret_cast<const char*>(&degree),
+                                          sizeof(int64_t)));
+        }
+        folly::Baton<true, std::atomic> baton;
+        kv->asyncMultiPut(0, partId, std::move(data), [&](kvstore::ResultCode code) {
+            EXPECT_EQ(code, kvstore::ResultCode::SUCCEEDED);
+            baton.post();
+        });
+        baton.wait();
+    }
+
+    cpp2::GetNeighborsRequest req;
+    std::vector<EdgeType> et = {101};
+    buildRequest(req, et);
+    QueryBoundProcessor pro(kv.get(), nullptr, nullptr, nullptr, nullptr);
+    pro.spaceId_ = 0;
+    pro.initEdgeContext(et);
+    auto buckets = pro.genBuckets(req);
+    ASSERT_EQ(10, buckets.size());
+    size_t total = 0;
+    for (auto& bucket : buckets) {
+        total += bucket.vertices_.size();
+        bool hasHub = std::any_of(bucket.vertices_.begin(), bucket.vertices_.end(),
+                                  [] (const auto& pv) {
+                                      return pv.second == 0 || pv.second == 10;
+                                  });
+        if (hasHub) {
+            // A supernode takes a handler on its own
+            ASSERT_EQ(1, bucket.vertices_.size());
+        } else {
+            ASSERT_GE(4, bucket.vertices_.size());
+        }
+    }
+    ASSERT_EQ(30, total);
+}
+
 TEST(QueryBoundTest, TTLTest) {
     fs::TempDir rootPath("/tmp/QueryEdgePropsTest.XXXXXX");
     std::unique_ptr<kvstore::KVStore> kv(TestUtils::initKV(rootPath.path()));
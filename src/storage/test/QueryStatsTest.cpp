@@ -140,6 +140,59 @@ TEST(QueryStatsTest, StatsSimpleTest) {
     checkResponse(resp);
 }
 
+TEST(QueryStatsTest, CountByDegreeTest) {
+    FLAGS_enable_degree_counter = true;
+    fs::TempDir rootPath("/tmp/QueryStatsTest.XXXXXX");
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path());
+    auto schemaMan = TestUtils::mockSchemaMan();
+    // Only the counters are written, so the count must come from them without scanning.
+    for (int32_t partId = 0; partId < 3; partId++) {
+        std::vector<kvstore::KV> data;
+        for (int32_t vertexId = partId * 10; vertexId < (partId + 1) * 10; vertexId++) {
+            int64_t degree = 7;
+            data.emplace_back(NebulaKeyUtils::degreeKey(partId, vertexId, 101),
+                              std::string(reinterpret_cast<const char*>(&degree),
+                                          sizeof(int64_t)));
+        }
+        folly::Baton<true, std::atomic> baton;
+        kv->asyncMultiPut(0, partId, std::move(data), [&](kvstore::ResultCode code) {
+            EXPECT_EQ(code, kvstore::ResultCode::SUCCEEDED);
+            baton.post();
+        });
+        baton.wait();
+    }
+
+    cpp2::GetNeighborsRequest req;
+    req.set_space_id(0);
+    decltype(req.parts) tmpIds;
+    for (auto partId = 0; partId < 3; partId++) {
+        for (auto vertexId =  partId * 10; vertexId < (partId + 1) * 10; vertexId++) {
+            tmpIds[partId].emplace_back(vertexId);
+        }
+    }
+    req.set_parts(std::move(tmpIds));
+    std::vector<EdgeType> et = {101};
+    req.set_edge_types(et);
+    decltype(req.return_columns) tmpColumns;
+    tmpColumns.emplace_back(TestUtils::edgePropDef("col_0", cpp2::StatType::COUNT, 101));
+    req.set_return_columns(std::move(tmpColumns));
+
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+    auto* processor = QueryStatsProcessor::instance(kv.get(), schemaMan.get(), nullptr,
+                                                    executor.get());
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+    EXPECT_EQ(0, resp.result.failed_codes.size());
+
+    auto provider = std::make_shared<ResultSchemaProvider>(resp.schema);
+    auto reader = RowReader::getRowReader(resp.data, provider);
+    int64_t count;
+    EXPECT_EQ(ResultType::SUCCEEDED, reader->getInt<int64_t>(0, count));
+    EXPECT_EQ(210, count);
+    FLAGS_enable_degree_counter = false;
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -0,0 +1,149 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include "storage/client/RequestCoalescer.h"
+
+namespace nebula {
+namespace storage {
+
+namespace {
+
+// Answer every vertex in request, and fail part 2
+folly::Future<cpp2::QueryResponse> answer(const cpp2::VertexPropRequest& req) {
+    cpp2::QueryResponse resp;
+    cpp2::ResponseCommon common;
+    std::vector<cpp2::ResultCode> failedCodes;
+    std::vector<cpp2::VertexData> vertices;
+    for (auto& part : req.get_parts()) {
+        if (part.first == 2) {
+            cpp2::ResultCode code;
+            code.set_code(cpp2::ErrorCode::E_LEADER_CHANGED);
+            code.set_part_id(2);
+            failedCodes.emplace_back(std::move(code));
+            continue;
+        }
+        for (auto vId : part.second) {
+            cpp2::VertexData vertex;
+            vertex.set_vertex_id(vId);
+            vertices.emplace_back(std::move(vertex));
+        }
+    }
+    common.set_failed_codes(std::move(failedCodes));
+    common.set_latency_in_us(100);
+    resp.set_result(std::move(common));
+    resp.set_vertices(std::move(vertices));
+    return folly::makeFuture(std::move(resp));
+}
+
+cpp2::VertexPropRequest request(std::unordered_map<PartitionID, std::vector<VertexID>> parts,
+                                const std::string& col = "col") {
+    cpp2::VertexPropRequest req;
+    req.set_space_id(1);
+    req.set_parts(std::move(parts));
+    cpp2::PropDef prop;
+    prop.set_name(col);
+    req.set_return_columns({prop});
+    return req;
+}
+
+std::set<VertexID> vertexIds(const cpp2::QueryResponse& resp) {
+    std::set<VertexID> vIds;
+    for (auto& vertex : *resp.get_vertices()) {
+        vIds.emplace(vertex.get_vertex_id());
+    }
+    return vIds;
+}
+
+}  // namespace
+
+TEST(RequestCoalescerTest, MergeAndSplitTest) {
+    std::mutex lock;
+    std::vector<std::pair<HostAddr, cpp2::VertexPropRequest>> sent;
+    RequestCoalescer<cpp2::VertexPropRequest> coalescer(
+        [&] (const HostAddr& host, const cpp2::VertexPropRequest& req) {
+            std::lock_guard<std::mutex> g(lock);
+            sent.emplace_back(host, req);
+            return answer(req);
+        }, 10000, 100);
+
+    HostAddr host(0, 0);
+    auto f1 = coalescer.submit(host, request({{1, {1, 2}}}));
+    auto f2 = coalescer.submit(host, request({{1, {2, 3}}, {2, {4}}}));
+    // Different return columns, or another host, could not be merged
+    auto f3 = coalescer.submit(host, request({{1, {1}}}, "other"));
+    auto f4 = coalescer.submit(HostAddr(1, 1), request({{1, {5}}}));
+
+    auto r1 = std::move(f1).get();
+    auto r2 = std::move(f2).get();
+    auto r3 = std::move(f3).get();
+    auto r4 = std::move(f4).get();
+    ASSERT_EQ(3, sent.size());
+    for (auto& s : sent) {
+        if (s.first == host && s.second.get_return_columns()[0].get_name() == "col") {
+            auto& parts = s.second.get_parts();
+            ASSERT_EQ(2, parts.size());
+            EXPECT_EQ((std::vector<VertexID>{1, 2, 3}), parts.at(1));
+            EXPECT_EQ((std::vector<VertexID>{4}), parts.at(2));
+        }
+    }
+
+    EXPECT_EQ((std::set<VertexID>{1, 2}), vertexIds(r1));
+    EXPECT_TRUE(r1.get_result().get_failed_codes().empty());
+    EXPECT_EQ(100, r1.get_result().get_latency_in_us());
+
+    EXPECT_EQ((std::set<VertexID>{2, 3}), vertexIds(r2));
+    ASSERT_EQ(1, r2.get_result().get_failed_codes().size());
+    EXPECT_EQ(2, r2.get_result().get_failed_codes()[0].get_part_id());
+
+    EXPECT_EQ((std::set<VertexID>{1}), vertexIds(r3));
+    EXPECT_EQ((std::set<VertexID>{5}), vertexIds(r4));
+}
+
+TEST(RequestCoalescerTest, MaxVerticesTest) {
+    std::atomic<int32_t> sent{0};
+    // The window is long enough, so only the full batch is sent
+    RequestCoalescer<cpp2::VertexPropRequest> coalescer(
+        [&] (const HostAddr&, const cpp2::VertexPropRequest& req) {
+            sent++;
+            return answer(req);
+        }, 60 * 1000 * 1000, 3);
+
+    HostAddr host(0, 0);
+    auto f1 = coalescer.submit(host, request({{1, {1, 2}}}));
+    EXPECT_EQ(0, sent);
+    auto f2 = coalescer.submit(host, request({{1, {2}}}));
+    EXPECT_EQ(0, sent);
+    auto f3 = coalescer.submit(host, request({{1, {3}}}));
+    EXPECT_EQ(1, sent);
+    EXPECT_EQ((std::set<VertexID>{1, 2}), vertexIds(std::move(f1).get()));
+    EXPECT_EQ((std::set<VertexID>{2}), vertexIds(std::move(f2).get()));
+    EXPECT_EQ((std::set<VertexID>{3}), vertexIds(std::move(f3).get()));
+}
+
+TEST(RequestCoalescerTest, FailureTest) {
+    RequestCoalescer<cpp2::VertexPropRequest> coalescer(
+        [] (const HostAddr&, const cpp2::VertexPropRequest&) {
+            return folly::makeFuture<cpp2::QueryResponse>(std::runtime_error("RPC failed"));
+        }, 1000, 100);
+
+    HostAddr host(0, 0);
+    auto f1 = coalescer.submit(host, request({{1, {1}}}));
+    auto f2 = coalescer.submit(host, request({{1, {2}}}));
+    EXPECT_THROW(std::move(f1).get(), std::runtime_error);
+    EXPECT_THROW(std::move(f2).get(), std::runtime_error);
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+    return RUN_ALL_TESTS();
+}
@@ -14,6 +14,7 @@
 #include "dataman/RowWriter.h"
 #include "dataman/RowSetReader.h"
 #include "network/NetworkUtils.h"
+#include "utils/NebulaKeyUtils.h"
 
 DECLARE_string(meta_server_addrs);
 DECLARE_int32(heartbeat_interval_secs);
@@ -285,6 +286,42 @@ TEST(StorageClientTest, VerticesInterfacesTest) {
         }
     }
 
+    // Delete vertices along with the reverse edges on other parts
+    {
+        std::vector<storage::cpp2::Edge> edges;
+        std::vector<VertexID> vertices;
+        for (int64_t srcId = 10; srcId < 20; srcId++) {
+            for (auto edgeType : {101, -101}) {
+                cpp2::Edge edge;
+                decltype(edge.key) edgeKey;
+                edgeKey.set_src(edgeType > 0 ? srcId : srcId * 100 + 2);
+                edgeKey.set_edge_type(edgeType);
+                edgeKey.set_dst(edgeType > 0 ? srcId * 100 + 2 : srcId);
+                edgeKey.set_ranking(srcId * 100 + 3);
+                edge.set_key(std::move(edgeKey));
+                edge.set_props(TestUtils::setupEncode(10, 20));
+                edges.emplace_back(std::move(edge));
+            }
+            vertices.emplace_back(srcId);
+        }
+        auto af = client->addEdges(spaceId, std::move(edges), true);
+        ASSERT_TRUE(std::move(af).get().succeeded());
+
+        auto f = client->deleteVertices(spaceId, vertices);
+        auto resp = std::move(f).get();
+        ASSERT_TRUE(resp.succeeded());
+
+        for (int64_t srcId = 10; srcId < 20; srcId++) {
+            VertexID dstId = srcId * 100 + 2;
+            PartitionID partId = dstId % 10 + 1;
+            auto prefix = NebulaKeyUtils::edgePrefix(partId, dstId, -101);
+            std::unique_ptr<kvstore::KVIterator> iter;
+            ASSERT_EQ(kvstore::ResultCode::SUCCEEDED,
+                      sc->kvStore_->prefix(spaceId, partId, prefix, &iter));
+            EXPECT_FALSE(iter->valid());
+        }
+    }
+
     {
         // get not existed uuid
         std::vector<VertexID> vIds;
@@ -13,6 +13,8 @@
 #include "storage/http/StorageHttpAdminHandler.h"
 #include "storage/test/TestUtils.h"
 #include "fs/TempDir.h"
+#include "base/HyperLogLog.h"
+#include "utils/NebulaKeyUtils.h"
 
 namespace nebula {
 namespace storage {
@@ -28,12 +30,15 @@ public:
         rootPath_ = std::make_unique<fs::TempDir>("/tmp/StorageHttpAdminHandler.XXXXXX");
         kv_ = TestUtils::initKV(rootPath_->path());
         schemaMan_ = TestUtils::mockSchemaMan();
+        indexMan_ = TestUtils::mockIndexMan();
 
         VLOG(1) << "Starting web service...";
         webSvc_ = std::make_unique<WebService>();
         auto& router = webSvc_->router();
         router.get("/admin").handler([this](nebula::web::PathParams&&) {
-            return new storage::StorageHttpAdminHandler(schemaMan_.get(), kv_.get());
+            return new storage::StorageHttpAdminHandler(schemaMan_.get(),
+                                                        kv_.get(),
+                                                        indexMan_.get());
         });
         auto status = webSvc_->start();
         ASSERT_TRUE(status.ok()) << status;
@@ -41,19 +46,27 @@ public:
 
     void TearDown() override {
         webSvc_.reset();
+        indexMan_.reset();
         schemaMan_.reset();
         kv_.reset();
         rootPath_.reset();
         VLOG(1) << "Web service stopped";
     }
 
+    kvstore::KVStore* kv() {
+        return kv_.get();
+    }
+
 protected:
     std::unique_ptr<WebService> webSvc_;
     std::unique_ptr<kvstore::KVStore> kv_;
     std::unique_ptr<fs::TempDir> rootPath_;
     std::unique_ptr<meta::SchemaManager> schemaMan_;
+    std::unique_ptr<meta::IndexManager> indexMan_;
 };
 
+static StorageHttpAdminHandlerTestEnv* gEnv = nullptr;
+
 
 TEST(StoragehHttpAdminHandlerTest, AdminTest) {
     {
@@ -106,6 +119,62 @@ TEST(StoragehHttpAdminHandlerTest, AdminTest) {
     }
 }
 
+TEST(StoragehHttpAdminHandlerTest, StatsTest) {
+    // 100 vertices in the index of tag 3001, with 10 distinct values of the first column
+    for (PartitionID partId = 0; partId < 6; partId++) {
+        std::vector<kvstore::KV> data;
+        for (VertexID vId = 0; vId < 100; vId++) {
+            if (vId % 6 != partId) {
+                continue;
+            }
+            IndexValues values;
+            values.emplace_back(nebula::cpp2::SupportedType::INT,
+                                NebulaKeyUtils::encodeInt64(vId % 10));
+            values.emplace_back(nebula::cpp2::SupportedType::INT,
+                                NebulaKeyUtils::encodeInt64(vId));
+            values.emplace_back(nebula::cpp2::SupportedType::INT,
+                                NebulaKeyUtils::encodeInt64(0));
+            for (auto i = 0; i < 3; i++) {
+                values.emplace_back(nebula::cpp2::SupportedType::STRING, "str");
+            }
+            data.emplace_back(NebulaKeyUtils::vertexIndexKey(partId, 4001, vId, values), "");
+        }
+        folly::Baton<true, std::atomic> baton;
+        gEnv->kv()->asyncMultiPut(0, partId, std::move(data), [&](kvstore::ResultCode code) {
+            EXPECT_EQ(kvstore::ResultCode::SUCCEEDED, code);
+            baton.post();
+        });
+        baton.wait();
+    }
+
+    auto url = "/admin?space=0&op=stats";
+    auto request = folly::stringPrintf("http://%s:%d%s", FLAGS_ws_ip.c_str(),
+                                       FLAGS_ws_http_port, url);
+    auto resp = http::HttpClient::get(request);
+    ASSERT_TRUE(resp.ok());
+    auto json = folly::parseJson(resp.value());
+    bool found = false;
+    for (auto& index : json["indexes"]) {
+        if (index["id"].asInt() != 4001) {
+            EXPECT_EQ(0, index["rows"].asInt());
+            continue;
+        }
+        found = true;
+        EXPECT_EQ(100, index["rows"].asInt());
+        auto& columns = index["columns"];
+        ASSERT_EQ(6, columns.size());
+        std::vector<int64_t> expected = {10, 100, 100, 100, 100, 100};
+        for (auto i = 0UL; i < columns.size(); i++) {
+            auto hll = HyperLogLog::deserialize(folly::unhexlify(columns[i]["hll"].asString()));
+            ASSERT_TRUE(hll.ok());
+            EXPECT_NEAR(expected[i], hll.value().estimate(), expected[i] * 0.1);
+            // Only the numeric columns are sampled
+            EXPECT_EQ(i < 3 ? 100 : 0, columns[i]["samples"].size());
+        }
+    }
+    EXPECT_TRUE(found);
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -115,7 +184,8 @@ int main(int argc, char** argv) {
     folly::init(&argc, &argv, true);
     google::SetStderrLogging(google::INFO);
 
-    ::testing::AddGlobalTestEnvironment(new nebula::storage::StorageHttpAdminHandlerTestEnv());
+    nebula::storage::gEnv = new nebula::storage::StorageHttpAdminHandlerTestEnv();
+    ::testing::AddGlobalTestEnvironment(nebula::storage::gEnv);
 
     return RUN_ALL_TESTS();
 }
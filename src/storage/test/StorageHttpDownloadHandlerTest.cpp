@@ -10,16 +10,22 @@
 #include "webservice/Router.h"
 #include "webservice/WebService.h"
 #include "storage/http/StorageHttpDownloadHandler.h"
+#include "storage/http/StorageHttpDownloadStatsHandler.h"
 #include "storage/test/MockHdfsHelper.h"
 #include "storage/test/TestUtils.h"
+#include "hdfs/LocalFsHelper.h"
 #include "fs/TempDir.h"
+#include <folly/FileUtil.h>
+#include <rocksdb/sst_file_writer.h>
 
 DECLARE_string(meta_server_addrs);
+DECLARE_int64(download_chunk_size);
 
 namespace nebula {
 namespace storage {
 
 std::unique_ptr<hdfs::HdfsHelper> helper = std::make_unique<storage::MockHdfsOKHelper>();
+kvstore::KVStore* kvstore = nullptr;
 
 class StorageHttpDownloadHandlerTestEnv : public ::testing::Environment {
 public:
@@ -29,6 +35,7 @@ public:
 
         rootPath_ = std::make_unique<fs::TempDir>("/tmp/StorageHttpDownloadHandler.XXXXXX");
         kv_ = TestUtils::initKV(rootPath_->path());
+        kvstore = kv_.get();
 
         pool_ = std::make_unique<nebula::thread::GenericThreadPool>();
         pool_->start(1);
@@ -42,11 +49,15 @@ public:
             handler->init(helper.get(), pool_.get(), kv_.get(), paths);
             return handler;
         });
+        router.get("/download_stats").handler([](nebula::web::PathParams&&) {
+            return new storage::StorageHttpDownloadStatsHandler();
+        });
         auto status = webSvc_->start();
         ASSERT_TRUE(status.ok()) << status;
     }
 
     void TearDown() override {
+        kvstore = nullptr;
         kv_.reset();
         rootPath_.reset();
         webSvc_.reset();
@@ -113,6 +124,72 @@ TEST(StorageHttpDownloadHandlerTest, StorageDownloadTest) {
     }
 }
 
+TEST(StorageHttpDownloadHandlerTest, DownloadInChunksAndIngest) {
+    // The local file system stands in for HDFS, with the files of part 1 and 2
+    fs::TempDir source("/tmp/StorageHttpDownloadSource.XXXXXX");
+    for (PartitionID partId = 1; partId <= 2; partId++) {
+        auto partPath = folly::stringPrintf("%s/%d", source.path(), partId);
+        ASSERT_TRUE(fs::FileUtils::makeDir(partPath));
+        rocksdb::SstFileWriter writer{rocksdb::EnvOptions(), rocksdb::Options()};
+        auto status = writer.Open(folly::stringPrintf("%s/data.sst", partPath.c_str()));
+        ASSERT_EQ(rocksdb::Status::OK(), status);
+        for (auto i = 0; i < 100; i++) {
+            status = writer.Put(folly::stringPrintf("key_%d_%03d", partId, i),
+                                folly::stringPrintf("val_%d_%03d", partId, i));
+            ASSERT_EQ(rocksdb::Status::OK(), status);
+        }
+        ASSERT_EQ(rocksdb::Status::OK(), writer.Finish());
+    }
+
+    // Many chunks for every file
+    FLAGS_download_chunk_size = 256;
+    helper = std::make_unique<hdfs::LocalFsHelper>();
+    {
+        auto url = folly::stringPrintf(
+            "/download?host=127.0.0.1&port=0&path=%s&parts=1,2&space=0&edge=2&ingest=true",
+            source.path());
+        auto request = folly::stringPrintf("http://%s:%d%s", FLAGS_ws_ip.c_str(),
+                                           FLAGS_ws_http_port, url.c_str());
+        auto resp = http::HttpClient::get(request);
+        ASSERT_TRUE(resp.ok());
+        ASSERT_EQ("SSTFile download successfully", resp.value());
+    }
+    // Ingested without an extra ingest request
+    for (PartitionID partId = 1; partId <= 2; partId++) {
+        auto partResult = kvstore->part(0, partId);
+        ASSERT_TRUE(ok(partResult));
+        auto* engine = value(partResult)->engine();
+        for (auto i = 0; i < 100; i++) {
+            std::string value;
+            auto code = engine->get(folly::stringPrintf("key_%d_%03d", partId, i), &value);
+            ASSERT_EQ(kvstore::ResultCode::SUCCEEDED, code);
+            ASSERT_EQ(folly::stringPrintf("val_%d_%03d", partId, i), value);
+        }
+    }
+    {
+        auto url = "/download_stats?stats=download.ingested_parts,download.failed_parts";
+        auto request = folly::stringPrintf("http://%s:%d%s", FLAGS_ws_ip.c_str(),
+                                           FLAGS_ws_http_port, url);
+        auto resp = http::HttpClient::get(request);
+        ASSERT_TRUE(resp.ok());
+        ASSERT_EQ("download.ingested_parts=2\ndownload.failed_parts=0\n", resp.value());
+    }
+    {
+        // Part 3 is a file rather than a directory, which fails the download
+        auto partPath = folly::stringPrintf("%s/3", source.path());
+        ASSERT_TRUE(folly::writeFile(std::string("not a directory"), partPath.c_str()));
+        auto url = folly::stringPrintf(
+            "/download?host=127.0.0.1&port=0&path=%s&parts=3&space=0&edge=3",
+            source.path());
+        auto request = folly::stringPrintf("http://%s:%d%s", FLAGS_ws_ip.c_str(),
+                                           FLAGS_ws_http_port, url.c_str());
+        auto resp = http::HttpClient::get(request);
+        ASSERT_TRUE(resp.ok());
+        ASSERT_EQ("SSTFile download failed", resp.value());
+    }
+    helper = std::make_unique<storage::MockHdfsOKHelper>();
+}
+
 }  // namespace storage
 }  // namespace nebula
 
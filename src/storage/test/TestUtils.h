@@ -462,8 +462,14 @@ public:
         }
 
 
+        std::shared_ptr<StorageClient> storageClient;
+        if (mClient != nullptr) {
+            auto ioPool = std::make_shared<folly::IOThreadPoolExecutor>(1);
+            storageClient = std::make_shared<StorageClient>(ioPool, mClient);
+        }
         auto handler = std::make_shared<nebula::storage::StorageServiceHandler>(
-            sc->kvStore_.get(), sc->schemaMan_.get(), sc->indexMan_.get(), mClient);
+            sc->kvStore_.get(), sc->schemaMan_.get(), sc->indexMan_.get(), mClient,
+            std::move(storageClient));
         sc->mockCommon("storage", port, handler);
         auto ptr = dynamic_cast<kvstore::MetaServerBasedPartManager*>(
             sc->kvStore_->partManager());
@@ -0,0 +1,155 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "utils/NebulaKeyUtils.h"
+#include <gtest/gtest.h>
+#include <rocksdb/db.h>
+#include <folly/synchronization/Baton.h>
+#include "fs/TempDir.h"
+#include "storage/test/TestUtils.h"
+#include "storage/query/TraverseProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+constexpr int32_t kPartsNum = 6;
+
+class TraverseStorageClient : public StorageClient {
+public:
+    explicit TraverseStorageClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool)
+        : StorageClient(ioThreadPool, nullptr) {}
+
+    StatusOr<int32_t> partsNum(GraphSpaceID) const override {
+        return kPartsNum;
+    }
+};
+
+// Each vertex in [1, maxVId] has two out-edges, to vId + 1 and vId + 2.
+void mockData(kvstore::KVStore* kv, VertexID maxVId) {
+    for (VertexID vId = 1; vId <= maxVId; vId++) {
+        PartitionID partId = ID_HASH(vId, kPartsNum);
+        std::vector<kvstore::KV> data;
+        for (auto dstId : {vId + 1, vId + 2}) {
+            auto key = NebulaKeyUtils::edgeKey(partId, vId, 101, 0, dstId, 0);
+            data.emplace_back(std::move(key), "");
+        }
+        folly::Baton<true, std::atomic> baton;
+        kv->asyncMultiPut(0, partId, std::move(data), [&](kvstore::ResultCode code) {
+            EXPECT_EQ(code, kvstore::ResultCode::SUCCEEDED);
+            baton.post();
+        });
+        baton.wait();
+    }
+}
+
+cpp2::GetNeighborsRequest buildRequest(VertexID start, int32_t steps) {
+    cpp2::GetNeighborsRequest req;
+    req.set_space_id(0);
+    decltype(req.parts) parts;
+    parts[ID_HASH(start, kPartsNum)].emplace_back(start);
+    req.set_parts(std::move(parts));
+    req.set_edge_types({101});
+    decltype(req.return_columns) cols;
+    cols.emplace_back(TestUtils::edgePropDef("_dst", 101));
+    req.set_return_columns(std::move(cols));
+    req.set_steps(steps);
+    return req;
+}
+
+cpp2::QueryResponse traverse(kvstore::KVStore* kv,
+                             meta::SchemaManager* schemaMan,
+                             StorageClient* client,
+                             const cpp2::GetNeighborsRequest& req) {
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(3);
+    auto* processor = TraverseProcessor::instance(kv, schemaMan, nullptr, executor.get(), client);
+    auto f = processor->getFuture();
+    processor->process(req);
+    return std::move(f).get();
+}
+
+std::map<VertexID, std::set<VertexID>> toEdges(const cpp2::QueryResponse& resp) {
+    std::map<VertexID, std::set<VertexID>> edges;
+    for (auto& vdata : resp.vertices) {
+        for (auto& edata : vdata.get_edge_data()) {
+            for (auto& edge : edata.get_edges()) {
+                edges[vdata.get_vertex_id()].emplace(edge.get_dst());
+            }
+        }
+    }
+    return edges;
+}
+
+TEST(TraverseTest, AllPartsLocalTest) {
+    fs::TempDir rootPath("/tmp/TraverseTest.XXXXXX");
+    // Parts [0, 6] on this host
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path(), kPartsNum + 1);
+    auto schemaMan = TestUtils::mockSchemaMan();
+    mockData(kv.get(), 20);
+    auto ioPool = std::make_shared<folly::IOThreadPoolExecutor>(1);
+    TraverseStorageClient client(ioPool);
+
+    {
+        LOG(INFO) << "Three steps from 1, all hops are expanded locally";
+        auto resp = traverse(kv.get(), schemaMan.get(), &client, buildRequest(1, 3));
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_FALSE(resp.__isset.frontiers);
+        std::map<VertexID, std::set<VertexID>> expected = {
+            {3, {4, 5}},
+            {4, {5, 6}},
+            {5, {6, 7}},
+        };
+        EXPECT_EQ(expected, toEdges(resp));
+    }
+    {
+        LOG(INFO) << "One step is the same as getBound";
+        auto resp = traverse(kv.get(), schemaMan.get(), &client, buildRequest(1, 1));
+        EXPECT_EQ(0, resp.result.failed_codes.size());
+        EXPECT_FALSE(resp.__isset.frontiers);
+        std::map<VertexID, std::set<VertexID>> expected = {
+            {1, {2, 3}},
+        };
+        EXPECT_EQ(expected, toEdges(resp));
+    }
+}
+
+TEST(TraverseTest, FrontierTest) {
+    fs::TempDir rootPath("/tmp/TraverseTest.XXXXXX");
+    // Only parts [0, 3] on this host, the vertices of part 4, 5, 6 are left to the caller
+    std::unique_ptr<kvstore::KVStore> kv = TestUtils::initKV(rootPath.path(), 4);
+    auto schemaMan = TestUtils::mockSchemaMan();
+    // 1 => part 2, 2 => part 3, 3 => part 4, 4 => part 5
+    mockData(kv.get(), 2);
+    auto ioPool = std::make_shared<folly::IOThreadPoolExecutor>(1);
+    TraverseStorageClient client(ioPool);
+
+    auto resp = traverse(kv.get(), schemaMan.get(), &client, buildRequest(1, 3));
+    EXPECT_EQ(0, resp.result.failed_codes.size());
+    EXPECT_TRUE(toEdges(resp).empty());
+    ASSERT_TRUE(resp.__isset.frontiers);
+    std::map<int32_t, std::set<VertexID>> frontiers;
+    for (auto& frontier : resp.frontiers) {
+        frontiers[frontier.get_steps()].insert(frontier.get_vertices().begin(),
+                                               frontier.get_vertices().end());
+    }
+    // 3 is reached in the first hop, and the second one
+    std::map<int32_t, std::set<VertexID>> expected = {
+        {2, {3}},
+        {1, {3, 4}},
+    };
+    EXPECT_EQ(expected, frontiers);
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+    return RUN_ALL_TESTS();
+}
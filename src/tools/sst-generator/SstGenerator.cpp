@@ -0,0 +1,720 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "SstGenerator.h"
+#include <rocksdb/sst_file_writer.h>
+#include "fs/FileUtils.h"
+#include "time/Duration.h"
+#include "utils/ConvertTimeType.h"
+
+DEFINE_string(space, "", "The space name.");
+DEFINE_string(meta_server, "127.0.0.1:45500", "Meta servers' address.");
+DEFINE_string(tag, "", "The tag name of the vertices in the input.");
+DEFINE_string(edge, "", "The edge name of the edges in the input.");
+DEFINE_string(input, "", "A list of csv files seperated by comma.");
+DEFINE_string(delimiter, ",", "The delimiter of the csv fields.");
+DEFINE_bool(skip_header, false, "Whether the first line of each file is a header.");
+DEFINE_bool(with_ranking, false, "Whether the third field of an edge line is the ranking.");
+DEFINE_string(output, "./sst", "The root directory of the generated sst files.");
+DEFINE_string(tmp_dir, "/tmp/nebula_sst_generator", "Directory to spill the sorted runs.");
+DEFINE_int32(threads, 8, "Number of threads to encode, sort and merge.");
+DEFINE_int64(sort_buffer_mb, 256, "Memory used by each thread before spilling a sorted run.");
+DEFINE_int64(max_sst_file_mb, 1024, "The sst file will be rolled over when reaching it.");
+
+namespace nebula {
+namespace storage {
+
+namespace {
+
+// A sorted run file is a sequence of <key size, key, value size, value>
+void appendRecord(std::string& buf, folly::StringPiece key, folly::StringPiece val) {
+    uint32_t ksize = key.size();
+    uint32_t vsize = val.size();
+    buf.append(reinterpret_cast<const char*>(&ksize), sizeof(uint32_t))
+       .append(key.data(), key.size())
+       .append(reinterpret_cast<const char*>(&vsize), sizeof(uint32_t))
+       .append(val.data(), val.size());
+}
+
+class RunReader final {
+public:
+    explicit RunReader(const std::string& path) : path_(path) {
+        fp_ = fopen(path.c_str(), "rb");
+    }
+
+    ~RunReader() {
+        if (fp_ != nullptr) {
+            fclose(fp_);
+        }
+    }
+
+    bool ok() const {
+        return fp_ != nullptr;
+    }
+
+    // Return false when reaching the end or the run is broken
+    bool next() {
+        uint32_t size;
+        if (fread(&size, sizeof(uint32_t), 1, fp_) != 1) {
+            return false;
+        }
+        key_.resize(size);
+        if (size > 0 && fread(&key_[0], size, 1, fp_) != 1) {
+            LOG(ERROR) << "Broken run " << path_;
+            return false;
+        }
+        if (fread(&size, sizeof(uint32_t), 1, fp_) != 1) {
+            LOG(ERROR) << "Broken run " << path_;
+            return false;
+        }
+        val_.resize(size);
+        if (size > 0 && fread(&val_[0], size, 1, fp_) != 1) {
+            LOG(ERROR) << "Broken run " << path_;
+            return false;
+        }
+        return true;
+    }
+
+    const std::string& key() const {
+        return key_;
+    }
+
+    const std::string& val() const {
+        return val_;
+    }
+
+private:
+    std::string path_;
+    FILE* fp_{nullptr};
+    std::string key_;
+    std::string val_;
+};
+
+// Sort the kvs and write them into a run. The sort is stable, so when a key appears
+// more than once, the last one in kvs wins and the others are dropped.
+Status writeRun(const std::string& path, std::vector<std::pair<std::string, std::string>>& kvs) {
+    std::stable_sort(kvs.begin(), kvs.end(), [] (const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (fp == nullptr) {
+        return Status::Error("Open '%s' failed.", path.c_str());
+    }
+    std::string buf;
+    buf.reserve(4 * 1024 * 1024);
+    bool succeeded = true;
+    for (size_t i = 0; i < kvs.size(); i++) {
+        if (i + 1 < kvs.size() && kvs[i + 1].first == kvs[i].first) {
+            continue;
+        }
+        appendRecord(buf, kvs[i].first, kvs[i].second);
+        if (buf.size() >= 4 * 1024 * 1024) {
+            succeeded = fwrite(buf.data(), buf.size(), 1, fp) == 1;
+            buf.clear();
+            if (!succeeded) {
+                break;
+            }
+        }
+    }
+    if (succeeded && !buf.empty()) {
+        succeeded = fwrite(buf.data(), buf.size(), 1, fp) == 1;
+    }
+    fclose(fp);
+    if (!succeeded) {
+        return Status::Error("Write '%s' failed.", path.c_str());
+    }
+    VLOG(1) << "Spilled " << kvs.size() << " keys into " << path;
+    return Status::OK();
+}
+
+// Merge the sorted runs and call put on every distinct key in order. The names of
+// the runs are in the input order, when a key appears in more than one run, the one
+// from the latest run wins.
+Status mergeSorted(std::vector<std::string> runs,
+                   std::function<Status(const std::string&, const std::string&)> put) {
+    std::sort(runs.begin(), runs.end());
+    std::vector<std::unique_ptr<RunReader>> readers;
+    // min heap of <key, reader index>, the latest run goes first for the same key
+    using Item = std::pair<folly::StringPiece, size_t>;
+    auto cmp = [] (const Item& a, const Item& b) {
+        auto c = a.first.compare(b.first);
+        return c > 0 || (c == 0 && a.second < b.second);
+    };
+    std::priority_queue<Item, std::vector<Item>, decltype(cmp)> heap(cmp);
+    for (auto& run : runs) {
+        auto reader = std::make_unique<RunReader>(run);
+        if (!reader->ok()) {
+            return Status::Error("Open '%s' failed.", run.c_str());
+        }
+        if (reader->next()) {
+            heap.emplace(reader->key(), readers.size());
+        }
+        readers.emplace_back(std::move(reader));
+    }
+
+    bool first = true;
+    std::string lastKey;
+    while (!heap.empty()) {
+        auto idx = heap.top().second;
+        heap.pop();
+        auto& reader = readers[idx];
+        if (first || reader->key() != lastKey) {
+            auto status = put(reader->key(), reader->val());
+            if (!status.ok()) {
+                return status;
+            }
+            lastKey = reader->key();
+            first = false;
+        }
+        if (reader->next()) {
+            heap.emplace(reader->key(), idx);
+        }
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+
+Status SstGenerator::init() {
+    auto status = initMeta();
+    if (!status.ok()) {
+        return status;
+    }
+    status = initSchema();
+    if (!status.ok()) {
+        return status;
+    }
+    return initDirs();
+}
+
+
+Status SstGenerator::initMeta() {
+    auto addrs = network::NetworkUtils::toHosts(FLAGS_meta_server);
+    if (!addrs.ok()) {
+        return addrs.status();
+    }
+
+    auto ioExecutor = std::make_shared<folly::IOThreadPoolExecutor>(1);
+    meta::MetaClientOptions options;
+    options.skipConfig_ = true;
+    metaClient_ = std::make_unique<meta::MetaClient>(ioExecutor,
+                                                     std::move(addrs.value()),
+                                                     options);
+    if (!metaClient_->waitForMetadReady(1)) {
+        return Status::Error("Meta is not ready: '%s'.", FLAGS_meta_server.c_str());
+    }
+    schemaMan_ = std::make_unique<meta::ServerBasedSchemaManager>();
+    schemaMan_->init(metaClient_.get());
+    indexMan_ = std::make_unique<meta::ServerBasedIndexManager>();
+    indexMan_->init(metaClient_.get());
+    return Status::OK();
+}
+
+
+Status SstGenerator::initSchema() {
+    if (FLAGS_space.empty()) {
+        return Status::Error("Space is not given.");
+    }
+    auto space = schemaMan_->toGraphSpaceID(FLAGS_space);
+    if (!space.ok()) {
+        return Status::Error("Space '%s' not found in meta server.", FLAGS_space.c_str());
+    }
+    spaceId_ = space.value();
+
+    auto partNum = metaClient_->partsNum(spaceId_);
+    if (!partNum.ok()) {
+        return Status::Error("Get partition number from '%s' failed.", FLAGS_space.c_str());
+    }
+    partNum_ = partNum.value();
+
+    if (FLAGS_tag.empty() == FLAGS_edge.empty()) {
+        return Status::Error("Exactly one of tag and edge should be given.");
+    }
+    isEdge_ = !FLAGS_edge.empty();
+    if (isEdge_) {
+        auto edgeType = schemaMan_->toEdgeType(spaceId_, FLAGS_edge);
+        if (!edgeType.ok()) {
+            return Status::Error("Edge '%s' not found in meta.", FLAGS_edge.c_str());
+        }
+        schemaId_ = edgeType.value();
+        schema_ = schemaMan_->getEdgeSchema(spaceId_, schemaId_);
+        auto iRet = indexMan_->getEdgeIndexes(spaceId_);
+        if (iRet.ok()) {
+            for (auto& index : iRet.value()) {
+                if (index->get_schema_id().get_edge_type() == schemaId_) {
+                    indexes_.emplace_back(index);
+                }
+            }
+        }
+    } else {
+        auto tagId = schemaMan_->toTagID(spaceId_, FLAGS_tag);
+        if (!tagId.ok()) {
+            return Status::Error("Tag '%s' not found in meta.", FLAGS_tag.c_str());
+        }
+        schemaId_ = tagId.value();
+        schema_ = schemaMan_->getTagSchema(spaceId_, schemaId_);
+        auto iRet = indexMan_->getTagIndexes(spaceId_);
+        if (iRet.ok()) {
+            for (auto& index : iRet.value()) {
+                if (index->get_schema_id().get_tag_id() == schemaId_) {
+                    indexes_.emplace_back(index);
+                }
+            }
+        }
+    }
+    if (schema_ == nullptr) {
+        return Status::Error("Schema of '%s' not found.",
+                             isEdge_ ? FLAGS_edge.c_str() : FLAGS_tag.c_str());
+    }
+    LOG(INFO) << "Space " << spaceId_ << ", parts " << partNum_
+              << ", schema " << schemaId_ << ", indexes " << indexes_.size();
+    return Status::OK();
+}
+
+
+Status SstGenerator::initDirs() {
+    if (FLAGS_threads <= 0 || FLAGS_sort_buffer_mb <= 0 || FLAGS_max_sst_file_mb <= 0) {
+        return Status::Error("threads, sort_buffer_mb and max_sst_file_mb should be positive.");
+    }
+    if (fs::FileUtils::exist(FLAGS_output)) {
+        return Status::Error("Output '%s' already exists.", FLAGS_output.c_str());
+    }
+    fs::FileUtils::remove(FLAGS_tmp_dir.c_str(), true);
+    for (PartitionID partId = 1; partId <= partNum_; partId++) {
+        if (!fs::FileUtils::makeDir(runDir(partId))) {
+            return Status::Error("Create dir '%s' failed.", runDir(partId).c_str());
+        }
+    }
+    return Status::OK();
+}
+
+
+std::string SstGenerator::runDir(PartitionID partId) const {
+    return folly::stringPrintf("%s/%d", FLAGS_tmp_dir.c_str(), partId);
+}
+
+
+Status SstGenerator::run() {
+    time::Duration dur;
+    auto status = generateRuns();
+    if (!status.ok()) {
+        return status;
+    }
+    LOG(INFO) << "Encoded " << lines_ << " lines into " << keys_ << " keys, skipped "
+              << badLines_ << " bad lines, cost " << dur.elapsedInSec() << "s";
+
+    status = mergeRuns();
+    if (!status.ok()) {
+        return status;
+    }
+    fs::FileUtils::remove(FLAGS_tmp_dir.c_str(), true);
+    LOG(INFO) << "Generated sst files under " << FLAGS_output
+              << ", total cost " << dur.elapsedInSec() << "s";
+    return Status::OK();
+}
+
+
+std::vector<SstGenerator::Chunk> SstGenerator::splitInput() {
+    std::vector<std::string> files;
+    folly::split(',', FLAGS_input, files, true);
+    std::vector<Chunk> chunks;
+    for (auto& file : files) {
+        auto size = fs::FileUtils::fileSize(file.c_str());
+        // Every thread handles at least one chunk of each file
+        size_t chunkSize = std::max<size_t>(size / FLAGS_threads + 1, 1024 * 1024);
+        for (size_t begin = 0; begin < size; begin += chunkSize) {
+            chunks.emplace_back(Chunk{file, begin, std::min(begin + chunkSize, size)});
+        }
+    }
+    return chunks;
+}
+
+
+Status SstGenerator::generateRuns() {
+    auto chunks = splitInput();
+    if (chunks.empty()) {
+        return Status::Error("No input in '%s'.", FLAGS_input.c_str());
+    }
+
+    std::atomic<size_t> next{0};
+    std::vector<Status> results(FLAGS_threads, Status::OK());
+    std::vector<std::thread> threads;
+    threads.reserve(FLAGS_threads);
+    for (int32_t worker = 0; worker < FLAGS_threads; worker++) {
+        threads.emplace_back([this, worker, &chunks, &next, &results] {
+            size_t idx;
+            while ((idx = next.fetch_add(1)) < chunks.size()) {
+                auto status = processChunk(idx, chunks[idx]);
+                if (!status.ok()) {
+                    results[worker] = std::move(status);
+                    return;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (auto& status : results) {
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
+
+Status SstGenerator::processChunk(size_t chunkIdx, const Chunk& chunk) {
+    std::ifstream in(chunk.file);
+    if (!in.is_open()) {
+        return Status::Error("Open '%s' failed.", chunk.file.c_str());
+    }
+    std::string line;
+    if (chunk.begin > 0) {
+        // The line crossing the boundary belongs to the previous chunk
+        in.seekg(chunk.begin - 1);
+        std::getline(in, line);
+    } else if (FLAGS_skip_header) {
+        std::getline(in, line);
+    }
+
+    RunBuffer buffer;
+    const size_t bufferLimit = FLAGS_sort_buffer_mb * 1024 * 1024;
+    while (static_cast<size_t>(in.tellg()) < chunk.end && std::getline(in, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        ++lines_;
+        auto status = encodeLine(line, buffer);
+        if (!status.ok()) {
+            ++badLines_;
+            LOG_EVERY_N(WARNING, 1000) << "Skip bad line \"" << line << "\": " << status;
+            continue;
+        }
+        if (buffer.bytes >= bufferLimit) {
+            status = spill(chunkIdx, buffer);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+    }
+    return spill(chunkIdx, buffer);
+}
+
+
+Status SstGenerator::encodeLine(folly::StringPiece line, RunBuffer& buffer) {
+    std::vector<folly::StringPiece> fields;
+    folly::split(FLAGS_delimiter, line, fields);
+    size_t offset = isEdge_ ? (FLAGS_with_ranking ? 3 : 2) : 1;
+    if (fields.size() != offset + schema_->getNumFields()) {
+        return Status::Error("Expect %lu fields, got %lu",
+                             offset + schema_->getNumFields(), fields.size());
+    }
+
+    VertexID src, dst = 0;
+    EdgeRanking rank = 0;
+    RowWriter writer(schema_);
+    try {
+        src = folly::to<VertexID>(fields[0]);
+        if (isEdge_) {
+            dst = folly::to<VertexID>(fields[1]);
+            if (FLAGS_with_ranking) {
+                rank = folly::to<EdgeRanking>(fields[2]);
+            }
+        }
+        for (size_t i = 0; i < schema_->getNumFields(); i++) {
+            auto status = writeField(writer, schema_->getFieldType(i), fields[offset + i]);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+    } catch (const std::exception& e) {
+        return Status::Error("Parse error: %s", e.what());
+    }
+    auto row = writer.encode();
+
+    auto emplace = [&buffer, this] (PartitionID partId, std::string key, std::string val) {
+        buffer.bytes += key.size() + val.size();
+        buffer.data[partId].emplace_back(std::move(key), std::move(val));
+        ++keys_;
+    };
+
+    // The keys are generated the same way as AddVerticesProcessor/AddEdgesProcessor,
+    // multi versions are not supported by bulk load, so the version is always 0.
+    // The index keys are built in mergePart from the rows which are kept.
+    auto srcPart = ID_HASH(src, partNum_);
+    if (isEdge_) {
+        auto dstPart = ID_HASH(dst, partNum_);
+        emplace(dstPart, NebulaKeyUtils::edgeKey(dstPart, dst, -schemaId_, rank, src, 0), row);
+        emplace(srcPart, NebulaKeyUtils::edgeKey(srcPart, src, schemaId_, rank, dst, 0),
+                std::move(row));
+    } else {
+        emplace(srcPart, NebulaKeyUtils::vertexKey(srcPart, src, schemaId_, 0), std::move(row));
+    }
+    return Status::OK();
+}
+
+
+Status SstGenerator::writeField(RowWriter& writer,
+                                const nebula::cpp2::ValueType& type,
+                                folly::StringPiece field) {
+    switch (type.get_type()) {
+        case nebula::cpp2::SupportedType::BOOL:
+            writer << folly::to<bool>(field);
+            break;
+        case nebula::cpp2::SupportedType::INT:
+            writer << folly::to<int64_t>(field);
+            break;
+        case nebula::cpp2::SupportedType::VID:
+            writer << folly::to<VertexID>(field);
+            break;
+        case nebula::cpp2::SupportedType::FLOAT:
+            writer << folly::to<float>(field);
+            break;
+        case nebula::cpp2::SupportedType::DOUBLE:
+            writer << folly::to<double>(field);
+            break;
+        case nebula::cpp2::SupportedType::STRING:
+            writer << field;
+            break;
+        case nebula::cpp2::SupportedType::TIMESTAMP: {
+            // Either seconds since epoch or "yyyy-mm-dd hh:mm:ss"
+            VariantType value;
+            if (!field.empty() && std::all_of(field.begin(), field.end(), ::isdigit)) {
+                value = folly::to<int64_t>(field);
+            } else {
+                value = field.str();
+            }
+            auto timestamp = ConvertTimeType::toTimestamp(value);
+            if (!timestamp.ok()) {
+                return timestamp.status();
+            }
+            writer << timestamp.value();
+            break;
+        }
+        default:
+            return Status::Error("Unsupported type %d", static_cast<int32_t>(type.get_type()));
+    }
+    return Status::OK();
+}
+
+
+StatusOr<IndexValues>
+SstGenerator::collectIndexValues(RowReader* reader,
+                                 const std::vector<nebula::cpp2::ColumnDef>& cols) {
+    IndexValues values;
+    for (auto& col : cols) {
+        auto res = RowReader::getPropByName(reader, col.get_name());
+        if (!ok(res)) {
+            return Status::Error("Bad value for prop: %s", col.get_name().c_str());
+        }
+        auto val = NebulaKeyUtils::encodeVariant(value(std::move(res)));
+        values.emplace_back(col.get_type().get_type(), std::move(val));
+    }
+    return values;
+}
+
+
+Status SstGenerator::encodeIndexes(PartitionID partId,
+                                   folly::StringPiece key,
+                                   folly::StringPiece row,
+                                   KVs& kvs) {
+    VertexID src, dst = 0;
+    EdgeRanking rank = 0;
+    if (NebulaKeyUtils::isVertex(key)) {
+        src = NebulaKeyUtils::getVertexId(key);
+    } else if (NebulaKeyUtils::isEdge(key) && NebulaKeyUtils::getEdgeType(key) > 0) {
+        src = NebulaKeyUtils::getSrcId(key);
+        rank = NebulaKeyUtils::getRank(key);
+        dst = NebulaKeyUtils::getDstId(key);
+    } else {
+        // The reversed edge has no index
+        return Status::OK();
+    }
+    auto reader = RowReader::getRowReader(row, schema_);
+    if (reader == nullptr) {
+        return Status::Error("Bad format row");
+    }
+    for (auto& index : indexes_) {
+        auto values = collectIndexValues(reader.get(), index->get_fields());
+        if (!values.ok()) {
+            return values.status();
+        }
+        auto indexKey = isEdge_
+            ? NebulaKeyUtils::edgeIndexKey(partId, index->get_index_id(),
+                                           src, rank, dst, values.value())
+            : NebulaKeyUtils::vertexIndexKey(partId, index->get_index_id(),
+                                             src, values.value());
+        kvs.emplace_back(std::move(indexKey), "");
+    }
+    return Status::OK();
+}
+
+
+Status SstGenerator::spill(size_t chunkIdx, RunBuffer& buffer) {
+    for (auto& part : buffer.data) {
+        auto& kvs = part.second;
+        if (kvs.empty()) {
+            continue;
+        }
+        // The runs are named in the input order, which decides the winner of duplicate keys
+        auto path = folly::stringPrintf("%s/run-%010lu-%06d",
+                                        runDir(part.first).c_str(), chunkIdx, buffer.seq);
+        auto status = writeRun(path, kvs);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    buffer.data.clear();
+    buffer.bytes = 0;
+    buffer.seq++;
+    return Status::OK();
+}
+
+
+Status SstGenerator::mergeRuns() {
+    std::atomic<PartitionID> next{1};
+    std::vector<Status> results(FLAGS_threads, Status::OK());
+    std::vector<std::thread> threads;
+    threads.reserve(FLAGS_threads);
+    for (int32_t i = 0; i < FLAGS_threads; i++) {
+        threads.emplace_back([this, i, &next, &results] {
+            PartitionID partId;
+            while ((partId = next.fetch_add(1)) <= partNum_) {
+                auto status = mergePart(partId);
+                if (!status.ok()) {
+                    results[i] = std::move(status);
+                    return;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (auto& status : results) {
+        if (!status.ok()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
+
+Status SstGenerator::mergePart(PartitionID partId) {
+    auto runs = fs::FileUtils::listAllFilesInDir(runDir(partId).c_str(), true, "run-*");
+    if (runs.empty()) {
+        return Status::OK();
+    }
+
+    auto partDir = folly::stringPrintf("%s/%d", FLAGS_output.c_str(), partId);
+    if (!fs::FileUtils::makeDir(partDir)) {
+        return Status::Error("Create dir '%s' failed.", partDir.c_str());
+    }
+    const size_t maxFileSize = FLAGS_max_sst_file_mb * 1024 * 1024;
+    rocksdb::Options options;
+    std::unique_ptr<rocksdb::SstFileWriter> writer;
+    int32_t fileSeq = 0;
+    size_t fileSize = 0;
+    int64_t count = 0;
+
+    auto finishFile = [&writer] () -> Status {
+        if (writer != nullptr) {
+            auto s = writer->Finish();
+            writer.reset();
+            if (!s.ok()) {
+                return Status::Error("Finish sst failed: %s", s.ToString().c_str());
+            }
+        }
+        return Status::OK();
+    };
+
+    auto put = [&] (const std::string& key, const std::string& val) -> Status {
+        if (writer == nullptr || fileSize >= maxFileSize) {
+            auto status = finishFile();
+            if (!status.ok()) {
+                return status;
+            }
+            writer = std::make_unique<rocksdb::SstFileWriter>(rocksdb::EnvOptions(), options);
+            auto path = folly::stringPrintf("%s/%s-%d-%d.sst",
+                                            partDir.c_str(),
+                                            isEdge_ ? FLAGS_edge.c_str() : FLAGS_tag.c_str(),
+                                            partId, fileSeq++);
+            auto s = writer->Open(path);
+            if (!s.ok()) {
+                return Status::Error("Open sst '%s' failed: %s",
+                                     path.c_str(), s.ToString().c_str());
+            }
+            fileSize = 0;
+        }
+        auto s = writer->Put(key, val);
+        if (!s.ok()) {
+            return Status::Error("Put failed: %s", s.ToString().c_str());
+        }
+        fileSize += key.size() + val.size();
+        count++;
+        return Status::OK();
+    };
+
+    // Duplicate keys are possible when the same vertex/edge appears more than once
+    // in the input, only the last one is kept, and the index keys are built from it.
+    // The index keys are sorted after all the data keys of the part, so they are
+    // spilled into their own runs and merged after the data.
+    const size_t bufferLimit = FLAGS_sort_buffer_mb * 1024 * 1024;
+    KVs indexKVs;
+    size_t indexBytes = 0;
+    int32_t indexSeq = 0;
+    auto spillIndexes = [&] () -> Status {
+        if (indexKVs.empty()) {
+            return Status::OK();
+        }
+        auto path = folly::stringPrintf("%s/index-%06d", runDir(partId).c_str(), indexSeq++);
+        auto status = writeRun(path, indexKVs);
+        indexKVs.clear();
+        indexBytes = 0;
+        return status;
+    };
+
+    auto status = mergeSorted(std::move(runs), [&] (const std::string& key,
+                                                    const std::string& val) -> Status {
+        auto ret = put(key, val);
+        if (!ret.ok() || indexes_.empty()) {
+            return ret;
+        }
+        auto begin = indexKVs.size();
+        ret = encodeIndexes(partId, key, val, indexKVs);
+        if (!ret.ok()) {
+            return ret;
+        }
+        for (auto i = begin; i < indexKVs.size(); i++) {
+            indexBytes += indexKVs[i].first.size();
+        }
+        return indexBytes >= bufferLimit ? spillIndexes() : Status::OK();
+    });
+    if (status.ok()) {
+        status = spillIndexes();
+    }
+    if (status.ok() && indexSeq > 0) {
+        auto indexRuns = fs::FileUtils::listAllFilesInDir(runDir(partId).c_str(),
+                                                          true, "index-*");
+        status = mergeSorted(std::move(indexRuns), put);
+    }
+    if (!status.ok()) {
+        return status;
+    }
+    status = finishFile();
+    if (!status.ok()) {
+        return status;
+    }
+    LOG(INFO) << "Part " << partId << ": merged into "
+              << fileSeq << " sst files, " << count << " keys";
+    return Status::OK();
+}
+
+}  // namespace storage
+}  // namespace nebula
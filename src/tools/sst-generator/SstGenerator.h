@@ -0,0 +1,132 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef TOOLS_SSTGENERATOR_H_
+#define TOOLS_SSTGENERATOR_H_
+
+#include "base/Base.h"
+#include "base/Status.h"
+#include "base/StatusOr.h"
+#include "meta/client/MetaClient.h"
+#include "meta/ServerBasedSchemaManager.h"
+#include "meta/ServerBasedIndexManager.h"
+#include "dataman/RowWriter.h"
+#include "dataman/RowReader.h"
+#include "utils/NebulaKeyUtils.h"
+#include <gtest/gtest_prod.h>
+
+DECLARE_string(space);
+DECLARE_string(meta_server);
+DECLARE_string(tag);
+DECLARE_string(edge);
+DECLARE_string(input);
+DECLARE_string(delimiter);
+DECLARE_bool(skip_header);
+DECLARE_bool(with_ranking);
+DECLARE_string(output);
+DECLARE_string(tmp_dir);
+DECLARE_int32(threads);
+DECLARE_int64(sort_buffer_mb);
+DECLARE_int64(max_sst_file_mb);
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Generate the sst files for offline bulk load from csv files, using the same
+ * key and row encoding as storaged.
+ *
+ * Step 1: The input files are split into chunks by offset, the workers encode
+ *         the lines of each chunk into data and index key/values, and buffer them
+ *         per partition. When the buffer is full, each partition is sorted and
+ *         spilled into a run file under tmp_dir.
+ * Step 2: The runs of every partition are merged in parallel, the result is
+ *         written into sst files under output/<partId>/, which could be loaded by
+ *         DOWNLOAD and INGEST. When a key appears more than once, the last one in
+ *         the input wins, and the index keys are built from the rows that are kept.
+ * */
+class SstGenerator final {
+    FRIEND_TEST(SstGeneratorTest, TagTest);
+    FRIEND_TEST(SstGeneratorTest, EdgeTest);
+
+public:
+    SstGenerator() = default;
+
+    ~SstGenerator() = default;
+
+    Status init();
+
+    Status run();
+
+private:
+    using KVs = std::vector<std::pair<std::string, std::string>>;
+
+    struct RunBuffer {
+        std::unordered_map<PartitionID, KVs> data;
+        size_t bytes{0};
+        int32_t seq{0};
+    };
+
+    struct Chunk {
+        std::string file;
+        size_t begin;
+        size_t end;
+    };
+
+    Status initMeta();
+
+    Status initSchema();
+
+    Status initDirs();
+
+    std::vector<Chunk> splitInput();
+
+    Status generateRuns();
+
+    Status processChunk(size_t chunkIdx, const Chunk& chunk);
+
+    Status encodeLine(folly::StringPiece line, RunBuffer& buffer);
+
+    Status writeField(RowWriter& writer,
+                      const nebula::cpp2::ValueType& type,
+                      folly::StringPiece field);
+
+    StatusOr<IndexValues> collectIndexValues(RowReader* reader,
+                                             const std::vector<nebula::cpp2::ColumnDef>& cols);
+
+    Status encodeIndexes(PartitionID partId,
+                         folly::StringPiece key,
+                         folly::StringPiece row,
+                         KVs& kvs);
+
+    Status spill(size_t chunkIdx, RunBuffer& buffer);
+
+    Status mergeRuns();
+
+    Status mergePart(PartitionID partId);
+
+    std::string runDir(PartitionID partId) const;
+
+private:
+    std::unique_ptr<meta::MetaClient>                       metaClient_;
+    std::unique_ptr<meta::ServerBasedSchemaManager>         schemaMan_;
+    std::unique_ptr<meta::ServerBasedIndexManager>          indexMan_;
+    GraphSpaceID                                            spaceId_;
+    int32_t                                                 partNum_;
+    bool                                                    isEdge_{false};
+    // TagID or EdgeType
+    int32_t                                                 schemaId_;
+    std::shared_ptr<const meta::SchemaProviderIf>           schema_;
+    std::vector<std::shared_ptr<nebula::cpp2::IndexItem>>   indexes_;
+
+    std::atomic<int64_t>                                    lines_{0};
+    std::atomic<int64_t>                                    badLines_{0};
+    std::atomic<int64_t>                                    keys_{0};
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // TOOLS_SSTGENERATOR_H_
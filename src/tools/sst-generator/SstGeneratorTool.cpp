@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include "SstGenerator.h"
+
+void printHelp() {
+    fprintf(stderr,
+           R"(  ./sst_generator --space=<space name> --tag=<tag name> | --edge=<edge name>
+                   --input=<csv files>
+
+required:
+       --space=<space name>
+         The space name which the data will be loaded into.
+
+       --tag=<tag name> | --edge=<edge name>
+         Exactly one of them must be given.
+         A vertex line is: vid,prop1,prop2,...
+         An edge line is: src,dst[,ranking],prop1,prop2,...
+         The props must be in the order of the schema.
+
+       --input=<csv files>
+         A list of csv files seperated by comma.
+
+optional:
+       --meta_server=<ip:port,...>
+         A list of meta severs' ip:port seperated by comma.
+         Default: 127.0.0.1:45500
+
+       --delimiter=<delimiter>
+         Default: ,
+
+       --skip_header=<true|false>
+         Default: false
+
+       --with_ranking=<true|false>
+         Whether the edge lines contain the ranking.
+         Default: false
+
+       --output=<output directory>
+         The sst files are written into <output>/<partId>/, which could be
+         put onto hdfs and loaded by DOWNLOAD and INGEST.
+         Default: ./sst
+
+       --tmp_dir=<directory>
+         Directory to spill the sorted runs.
+         Default: /tmp/nebula_sst_generator
+
+       --threads=<N>
+         Default: 8
+
+       --sort_buffer_mb=<N>
+         Default: 256
+
+       --max_sst_file_mb=<N>
+         Default: 1024
+
+
+)");
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        printHelp();
+        return EXIT_FAILURE;
+    } else {
+        folly::init(&argc, &argv, true);
+    }
+
+    nebula::storage::SstGenerator generator;
+    auto status = generator.init();
+    if (!status.ok()) {
+        std::cerr << "Error: " << status << "\n\n";
+        return EXIT_FAILURE;
+    }
+    status = generator.run();
+    if (!status.ok()) {
+        std::cerr << "Error: " << status << "\n\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,218 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "base/Base.h"
+#include <gtest/gtest.h>
+#include <rocksdb/sst_file_reader.h>
+#include "fs/TempDir.h"
+#include "fs/FileUtils.h"
+#include "meta/NebulaSchemaProvider.h"
+#include "tools/sst-generator/SstGenerator.h"
+
+namespace nebula {
+namespace storage {
+
+using KVs = std::vector<std::pair<std::string, std::string>>;
+
+struct Row {
+    VertexID vId;
+    int64_t c0;
+    std::string c1;
+};
+
+std::shared_ptr<meta::NebulaSchemaProvider> genSchema() {
+    auto schema = std::make_shared<meta::NebulaSchemaProvider>(0);
+    nebula::cpp2::ValueType intType;
+    intType.set_type(nebula::cpp2::SupportedType::INT);
+    schema->addField("c0", std::move(intType));
+    nebula::cpp2::ValueType strType;
+    strType.set_type(nebula::cpp2::SupportedType::STRING);
+    schema->addField("c1", std::move(strType));
+    return schema;
+}
+
+// An index on c0
+std::shared_ptr<nebula::cpp2::IndexItem> genIndex(IndexID indexId) {
+    nebula::cpp2::ColumnDef col;
+    col.set_name("c0");
+    col.type.set_type(nebula::cpp2::SupportedType::INT);
+    std::vector<nebula::cpp2::ColumnDef> cols{col};
+    nebula::cpp2::IndexItem item;
+    item.set_index_id(indexId);
+    item.set_fields(std::move(cols));
+    return std::make_shared<nebula::cpp2::IndexItem>(std::move(item));
+}
+
+IndexValues indexValues(int64_t c0) {
+    IndexValues values;
+    values.emplace_back(nebula::cpp2::SupportedType::INT, NebulaKeyUtils::encodeVariant(c0));
+    return values;
+}
+
+// Read all the kvs of a part in the order of the sst files
+KVs readPart(PartitionID partId) {
+    auto dir = folly::stringPrintf("%s/%d", FLAGS_output.c_str(), partId);
+    auto files = fs::FileUtils::listAllFilesInDir(dir.c_str(), true, "*.sst");
+    std::sort(files.begin(), files.end());
+    KVs kvs;
+    rocksdb::Options options;
+    for (auto& file : files) {
+        rocksdb::SstFileReader reader(options);
+        CHECK(reader.Open(file).ok());
+        std::unique_ptr<rocksdb::Iterator> iter(reader.NewIterator(rocksdb::ReadOptions()));
+        for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+            kvs.emplace_back(iter->key().ToString(), iter->value().ToString());
+        }
+    }
+    return kvs;
+}
+
+void checkRow(std::shared_ptr<const meta::SchemaProviderIf> schema,
+              const std::string& row,
+              int64_t c0,
+              const std::string& c1) {
+    auto reader = RowReader::getRowReader(row, schema);
+    ASSERT_NE(nullptr, reader);
+    int64_t v0;
+    EXPECT_EQ(ResultType::SUCCEEDED, reader->getInt("c0", v0));
+    EXPECT_EQ(c0, v0);
+    folly::StringPiece v1;
+    EXPECT_EQ(ResultType::SUCCEEDED, reader->getString("c1", v1));
+    EXPECT_EQ(c1, v1.str());
+}
+
+TEST(SstGeneratorTest, TagTest) {
+    fs::TempDir rootPath("/tmp/SstGeneratorTagTest.XXXXXX");
+    FLAGS_tmp_dir = folly::stringPrintf("%s/tmp", rootPath.path());
+    FLAGS_output = folly::stringPrintf("%s/output", rootPath.path());
+    FLAGS_tag = "tag";
+
+    SstGenerator generator;
+    generator.partNum_ = 1;
+    generator.isEdge_ = false;
+    generator.schemaId_ = 1;
+    generator.schema_ = genSchema();
+    generator.indexes_.emplace_back(genIndex(7));
+    ASSERT_TRUE(generator.initDirs().ok());
+
+    // Encode the lines of a chunk, every inner vector is spilled into one run
+    auto encode = [&] (size_t chunkIdx, SstGenerator::RunBuffer& buffer,
+                       const std::vector<std::string>& lines) {
+        for (auto& line : lines) {
+            ASSERT_TRUE(generator.encodeLine(line, buffer).ok());
+        }
+        ASSERT_TRUE(generator.spill(chunkIdx, buffer).ok());
+    };
+    SstGenerator::RunBuffer chunk0, chunk1, chunk2, chunk10;
+    // Vertex 1 appears twice in the same run
+    encode(0, chunk0, {"1,10,a", "2,20,b", "1,11,c"});
+    encode(1, chunk1, {"2,21,d", "3,30,e"});
+    // This run is written after chunk 1, but it is before chunk 1 in the input
+    encode(0, chunk0, {"2,22,f"});
+    // Chunk 10 is after chunk 2 in the input, although "10" < "2" as a string
+    encode(10, chunk10, {"5,51,g"});
+    encode(2, chunk2, {"5,50,h"});
+    ASSERT_TRUE(generator.mergePart(1).ok());
+
+    auto kvs = readPart(1);
+    ASSERT_EQ(8, kvs.size());
+    for (size_t i = 1; i < kvs.size(); i++) {
+        EXPECT_LT(kvs[i - 1].first, kvs[i].first);
+    }
+
+    // The last one in the input wins
+    std::vector<Row> expected = {
+        {1, 11, "c"}, {2, 21, "d"}, {3, 30, "e"}, {5, 51, "g"}
+    };
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(NebulaKeyUtils::vertexKey(1, expected[i].vId, 1, 0), kvs[i].first);
+        checkRow(generator.schema_, kvs[i].second, expected[i].c0, expected[i].c1);
+    }
+
+    // Only the index keys of the rows kept are written, after all the data keys
+    std::set<std::string> indexKeys;
+    for (auto& row : expected) {
+        indexKeys.emplace(NebulaKeyUtils::vertexIndexKey(1, 7, row.vId, indexValues(row.c0)));
+    }
+    std::set<std::string> actual;
+    for (size_t i = expected.size(); i < kvs.size(); i++) {
+        EXPECT_TRUE(NebulaKeyUtils::isIndexKey(kvs[i].first));
+        EXPECT_EQ("", kvs[i].second);
+        actual.emplace(kvs[i].first);
+    }
+    EXPECT_EQ(indexKeys, actual);
+}
+
+TEST(SstGeneratorTest, EdgeTest) {
+    fs::TempDir rootPath("/tmp/SstGeneratorEdgeTest.XXXXXX");
+    FLAGS_tmp_dir = folly::stringPrintf("%s/tmp", rootPath.path());
+    FLAGS_output = folly::stringPrintf("%s/output", rootPath.path());
+    FLAGS_edge = "edge";
+    FLAGS_with_ranking = true;
+
+    SstGenerator generator;
+    generator.partNum_ = 1;
+    generator.isEdge_ = true;
+    generator.schemaId_ = 3;
+    generator.schema_ = genSchema();
+    generator.indexes_.emplace_back(genIndex(8));
+    ASSERT_TRUE(generator.initDirs().ok());
+
+    SstGenerator::RunBuffer chunk0, chunk1;
+    ASSERT_TRUE(generator.encodeLine("1,2,0,10,a", chunk0).ok());
+    ASSERT_TRUE(generator.encodeLine("1,2,1,20,b", chunk0).ok());
+    ASSERT_TRUE(generator.spill(0, chunk0).ok());
+    ASSERT_TRUE(generator.encodeLine("1,2,0,11,c", chunk1).ok());
+    ASSERT_TRUE(generator.spill(1, chunk1).ok());
+    ASSERT_TRUE(generator.mergePart(1).ok());
+    FLAGS_with_ranking = false;
+
+    // Two out-edges, two in-edges and the index keys of the out-edges
+    auto kvs = readPart(1);
+    ASSERT_EQ(6, kvs.size());
+    std::map<std::string, std::string> data;
+    std::set<std::string> indexKeys;
+    for (size_t i = 0; i < kvs.size(); i++) {
+        if (i > 0) {
+            EXPECT_LT(kvs[i - 1].first, kvs[i].first);
+        }
+        if (NebulaKeyUtils::isIndexKey(kvs[i].first)) {
+            indexKeys.emplace(kvs[i].first);
+        } else {
+            // The data keys go first
+            EXPECT_TRUE(indexKeys.empty());
+            data.emplace(kvs[i].first, kvs[i].second);
+        }
+    }
+    ASSERT_EQ(4, data.size());
+    for (auto edgeType : {3, -3}) {
+        VertexID src = edgeType > 0 ? 1 : 2;
+        VertexID dst = edgeType > 0 ? 2 : 1;
+        auto it = data.find(NebulaKeyUtils::edgeKey(1, src, edgeType, 0, dst, 0));
+        ASSERT_NE(data.end(), it);
+        checkRow(generator.schema_, it->second, 11, "c");
+        it = data.find(NebulaKeyUtils::edgeKey(1, src, edgeType, 1, dst, 0));
+        ASSERT_NE(data.end(), it);
+        checkRow(generator.schema_, it->second, 20, "b");
+    }
+    std::set<std::string> expected = {
+        NebulaKeyUtils::edgeIndexKey(1, 8, 1, 0, 2, indexValues(11)),
+        NebulaKeyUtils::edgeIndexKey(1, 8, 1, 1, 2, indexValues(20)),
+    };
+    EXPECT_EQ(expected, indexKeys);
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    folly::init(&argc, &argv, true);
+    google::SetStderrLogging(google::INFO);
+
+    return RUN_ALL_TESTS();
+}